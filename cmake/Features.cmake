@@ -13,6 +13,7 @@ set(NLINK_FEATURES
     tatit
     mpsystem
     spsystem
+    threading
 )
 
 # Feature source collection
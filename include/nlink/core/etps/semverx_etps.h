@@ -214,12 +214,32 @@ int etps_load_project_components(etps_context_t* ctx, const char* project_path);
 
 /**
  * Export ETPS events to JSON for CI/CD integration
+ * The document holds etps_version, event_count and the events array, in
+ * that order.
  * @param ctx ETPS context
  * @param output_path Output file path
  * @return 0 on success, -1 on failure
  */
 int etps_export_events_json(etps_context_t* ctx, const char* output_path);
 
+/**
+ * Flush recorded events to JSON on the shared thread pool
+ * Hands the recorded events to a pool task and clears the buffer, so
+ * emitters never wait on file I/O. Output has the etps_export_events_json
+ * layout; later flushes to the same path append to its events array, in
+ * flush order, and event_count is padded with spaces so it can be updated.
+ * @param ctx ETPS context
+ * @param output_path Output file path
+ * @return 0 if the flush was queued or written, -1 on failure
+ */
+int etps_flush_events_async(etps_context_t* ctx, const char* output_path);
+
+/**
+ * Wait for every queued flush to be written
+ * Called by etps_shutdown.
+ */
+void etps_flush_wait(void);
+
 // =============================================================================
 // Utility Functions
 // =============================================================================
@@ -7,6 +7,8 @@
 
 #include "nlink/core/minimizer/nexus_minimizer.h"
 #include "nlink/core/minimizer/okpala_automaton.h"
+#include "nlink/core/threading/thread_pool.h"
+#include <stdlib.h>
 #include <sys/stat.h>
 #include <time.h>
 
@@ -193,6 +195,80 @@
      return NEXUS_SUCCESS;
  }
  
+ // One component of a batch minimization
+ typedef struct MinimizeJob {
+     NexusContext* ctx;
+     const char* component_path;
+     NexusMinimizerConfig config;
+     NexusMinimizationMetrics* metrics;
+     NexusResult result;
+ } MinimizeJob;
+ 
+ // Pool task: minimize one component of a batch
+ static void minimize_job_run(void* arg) {
+     MinimizeJob* job = (MinimizeJob*)arg;
+     job->result = nexus_minimize_component(job->ctx, job->component_path, job->config, job->metrics);
+ }
+ 
+ // Minimize several independent components on the shared thread pool
+ NexusResult nexus_minimize_components(
+     NexusContext* ctx,
+     const char* const* component_paths,
+     size_t count,
+     NexusMinimizerConfig config,
+     NexusMinimizationMetrics* metrics,
+     NexusResult* results
+ ) {
+     if (!ctx || (!component_paths && count > 0)) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+     
+     MinimizeJob* jobs = (MinimizeJob*)calloc(count ? count : 1, sizeof(MinimizeJob));
+     if (!jobs) {
+         return NEXUS_OUT_OF_MEMORY;
+     }
+     
+     // A single component, or no pool, runs on the calling thread
+     nlink_thread_pool_t* pool = count > 1 ? nlink_thread_pool_shared() : NULL;
+     nlink_task_group_t group;
+     nlink_task_group_init(&group);
+     
+     for (size_t i = 0; i < count; i++) {
+         jobs[i].ctx = ctx;
+         jobs[i].component_path = component_paths[i];
+         jobs[i].config = config;
+         jobs[i].metrics = metrics ? &metrics[i] : NULL;
+         jobs[i].result = NEXUS_INVALID_PARAMETER;
+         
+         if (!pool) {
+             minimize_job_run(&jobs[i]);
+         } else {
+             nlink_thread_pool_submit(pool, minimize_job_run, &jobs[i], &group);
+         }
+     }
+     
+     if (pool) {
+         nlink_thread_pool_wait(pool, &group);
+     }
+     
+     // Report the first failure in path order, independent of completion order
+     NexusResult result = NEXUS_SUCCESS;
+     for (size_t i = 0; i < count; i++) {
+         if (results) {
+             results[i] = jobs[i].result;
+         }
+         if (result == NEXUS_SUCCESS && jobs[i].result != NEXUS_SUCCESS) {
+             result = jobs[i].result;
+         }
+     }
+     
+     nexus_log(ctx, NEXUS_LOG_INFO, "Minimized %zu components on %zu workers",
+              count, pool ? nlink_thread_pool_worker_count(pool) : (size_t)1);
+     
+     free(jobs);
+     return result;
+ }
+ 
  // Print minimization metrics
  void nexus_print_minimization_metrics(const NexusMinimizationMetrics* metrics) {
      if (!metrics) {
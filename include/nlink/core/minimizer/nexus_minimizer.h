@@ -126,6 +126,31 @@
      NexusMinimizerConfig config,
      NexusMinimizationMetrics* metrics
  );
+
+ /**
+  * @brief Minimize several independent components in parallel
+  * 
+  * Each component is minimized as by nexus_minimize_component(), one task
+  * per component on the shared thread pool. The calling thread takes part
+  * in the work until every component is done.
+  * 
+  * @param ctx The NexusLink context
+  * @param component_paths Paths to the component files
+  * @param count Number of components
+  * @param config Minimization configuration, applied to every component
+  * @param metrics Optional array of count metrics, one per component (can be NULL)
+  * @param results Optional array of count result codes, one per component (can be NULL)
+  * @return NexusResult NEXUS_SUCCESS if every component was minimized,
+  *         otherwise the failure of the first failing component in path order
+  */
+ NexusResult nexus_minimize_components(
+     NexusContext* ctx,
+     const char* const* component_paths,
+     size_t count,
+     NexusMinimizerConfig config,
+     NexusMinimizationMetrics* metrics,
+     NexusResult* results
+ );
  /**
   * @brief Clean up the minimizer subsystem
   * 
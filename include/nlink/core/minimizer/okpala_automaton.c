@@ -1,261 +1,331 @@
-// okpala_automaton.c - Automaton minimization implementation for NexusLink
+// okpala_automaton.c - Automaton construction for NexusLink
 // Author: Nnamdi Michael Okpala
 
 #include "nlink/core/minimizer/okpala_automaton.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define INDEX_INITIAL_SLOTS 16
+#define ARRAY_INITIAL_CAPACITY 4
+
+// Hash lookup of state IDs and symbols; slots hold index + 1, 0 when empty
+struct OkpalaIndex {
+    size_t* state_slots;
+    size_t state_mask;
+    size_t* symbol_slots;
+    size_t symbol_mask;
+    size_t state_capacity;
+    size_t final_state_capacity;
+    size_t alphabet_capacity;
+};
+
+typedef const char* (*key_at_fn)(const OkpalaAutomaton* automaton, size_t index);
+
+static const char* state_key(const OkpalaAutomaton* automaton, size_t index) {
+    return automaton->states[index].id;
+}
+
+static const char* symbol_key(const OkpalaAutomaton* automaton, size_t index) {
+    return automaton->alphabet[index];
+}
+
+// FNV-1a
+static size_t hash_string(const char* key) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (const unsigned char* p = (const unsigned char*)key; *p; p++) {
+        hash ^= *p;
+        hash *= 0x100000001b3ull;
+    }
+    return (size_t)(hash ^ (hash >> 32));
+}
+
+// Slot holding key, or the empty slot where it belongs
+static size_t* index_slot(const OkpalaAutomaton* automaton, size_t* slots, size_t mask,
+                          const char* key, key_at_fn key_at) {
+    size_t i = hash_string(key) & mask;
+    while (slots[i] != 0 && strcmp(key_at(automaton, slots[i] - 1), key) != 0) {
+        i = (i + 1) & mask;
+    }
+    return &slots[i];
+}
+
+// Make room for entry number count, doubling the table at half load
+static bool index_reserve(const OkpalaAutomaton* automaton, size_t** slots, size_t* mask,
+                          size_t count, key_at_fn key_at) {
+    if (*slots != NULL && (count + 1) * 2 <= *mask + 1) {
+        return true;
+    }
+
+    size_t size = *slots != NULL ? (*mask + 1) * 2 : INDEX_INITIAL_SLOTS;
+    size_t* grown = (size_t*)calloc(size, sizeof(size_t));
+    if (!grown) {
+        return false;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        *index_slot(automaton, grown, size - 1, key_at(automaton, i), key_at) = i + 1;
+    }
+
+    free(*slots);
+    *slots = grown;
+    *mask = size - 1;
+    return true;
+}
+
+// Grow the states array; pointers into the old array are moved over to the new one
+static bool grow_states(OkpalaAutomaton* automaton) {
+    size_t capacity = automaton->index->state_capacity;
+    capacity = capacity ? capacity * 2 : ARRAY_INITIAL_CAPACITY;
+
+    OkpalaState* old_states = automaton->states;
+    OkpalaState* states = (OkpalaState*)malloc(capacity * sizeof(OkpalaState));
+    if (!states) {
+        return false;
+    }
+
+    if (old_states) {
+        memcpy(states, old_states, automaton->state_count * sizeof(OkpalaState));
+
+        automaton->initial_state = states + (automaton->initial_state - old_states);
+        for (size_t i = 0; i < automaton->final_state_count; i++) {
+            automaton->final_states[i] = states + (automaton->final_states[i] - old_states);
+        }
+        for (size_t i = 0; i < automaton->state_count; i++) {
+            OkpalaState* state = &states[i];
+            for (size_t j = 0; j < state->transition_count; j++) {
+                state->transitions[j] = states + (state->transitions[j] - old_states);
+            }
+        }
+    }
+
+    free(old_states);
+    automaton->states = states;
+    automaton->index->state_capacity = capacity;
+    return true;
+}
+
+// Find or add a symbol in the alphabet
+static NexusResult intern_symbol(OkpalaAutomaton* automaton, const char* symbol, size_t* symbol_id) {
+    struct OkpalaIndex* index = automaton->index;
+
+    if (!index_reserve(automaton, &index->symbol_slots, &index->symbol_mask,
+                       automaton->alphabet_size, symbol_key)) {
+        return NEXUS_ERROR_OUT_OF_MEMORY;
+    }
+
+    size_t* slot = index_slot(automaton, index->symbol_slots, index->symbol_mask, symbol, symbol_key);
+    if (*slot != 0) {
+        *symbol_id = *slot - 1;
+        return NEXUS_SUCCESS;
+    }
+
+    if (automaton->alphabet_size == index->alphabet_capacity) {
+        size_t capacity = index->alphabet_capacity ? index->alphabet_capacity * 2 : ARRAY_INITIAL_CAPACITY;
+        char** alphabet = (char**)realloc(automaton->alphabet, capacity * sizeof(char*));
+        if (!alphabet) {
+            return NEXUS_ERROR_OUT_OF_MEMORY;
+        }
+        automaton->alphabet = alphabet;
+        index->alphabet_capacity = capacity;
+    }
+
+    char* copy = strdup(symbol);
+    if (!copy) {
+        return NEXUS_ERROR_OUT_OF_MEMORY;
+    }
+
+    *symbol_id = automaton->alphabet_size;
+    automaton->alphabet[automaton->alphabet_size++] = copy;
+    *slot = *symbol_id + 1;
+    return NEXUS_SUCCESS;
+}
 
 // Create a new automaton
 OkpalaAutomaton* okpala_automaton_create(void) {
-    OkpalaAutomaton* automaton = (OkpalaAutomaton*)malloc(sizeof(OkpalaAutomaton));
-    automaton->states = NULL;
-    automaton->state_count = 0;
-    automaton->initial_state = NULL;
-    automaton->final_states = NULL;
-    automaton->final_state_count = 0;
+    nexus_automaton_initialize();
+
+    OkpalaAutomaton* automaton = (OkpalaAutomaton*)calloc(1, sizeof(OkpalaAutomaton));
+    if (!automaton) {
+        return NULL;
+    }
+
+    automaton->index = (struct OkpalaIndex*)calloc(1, sizeof(struct OkpalaIndex));
+    if (!automaton->index) {
+        free(automaton);
+        return NULL;
+    }
+
     return automaton;
 }
 
 // Find a state by ID
-static OkpalaState* find_state(OkpalaAutomaton* automaton, const char* id) {
-    for (size_t i = 0; i < automaton->state_count; i++) {
-        if (strcmp(automaton->states[i].id, id) == 0) {
-            return &automaton->states[i];
-        }
+size_t okpala_automaton_find_state(const OkpalaAutomaton* automaton, const char* id) {
+    if (!automaton || !id || !automaton->index->state_slots) {
+        return OKPALA_NO_STATE;
     }
-    return NULL;
+
+    size_t slot = *index_slot(automaton, automaton->index->state_slots,
+                              automaton->index->state_mask, id, state_key);
+    return slot != 0 ? slot - 1 : OKPALA_NO_STATE;
 }
 
 // Add a state to the automaton
-NexusResult okpala_automaton_add_state(OkpalaAutomaton* automaton, 
+NexusResult okpala_automaton_add_state(OkpalaAutomaton* automaton,
                                      const char* id, bool is_final) {
     if (!automaton || !id) {
         return NEXUS_ERROR_INVALID_ARGUMENT;
     }
-    
+
     // Check if state already exists
-    if (find_state(automaton, id)) {
+    if (okpala_automaton_find_state(automaton, id) != OKPALA_NO_STATE) {
         return NEXUS_ERROR_INVALID_ARGUMENT;
     }
-    
-    // Allocate or resize states array
-    automaton->states = (OkpalaState*)realloc(automaton->states, 
-                                          (automaton->state_count + 1) * sizeof(OkpalaState));
-    if (!automaton->states) {
+
+    // Reserve everything first so a failure leaves the automaton unchanged
+    struct OkpalaIndex* index = automaton->index;
+    if (!index_reserve(automaton, &index->state_slots, &index->state_mask,
+                       automaton->state_count, state_key)) {
+        return NEXUS_ERROR_OUT_OF_MEMORY;
+    }
+    if (automaton->state_count == index->state_capacity && !grow_states(automaton)) {
+        return NEXUS_ERROR_OUT_OF_MEMORY;
+    }
+    if (is_final && automaton->final_state_count == index->final_state_capacity) {
+        size_t capacity = index->final_state_capacity ? index->final_state_capacity * 2 : ARRAY_INITIAL_CAPACITY;
+        OkpalaState** final_states = (OkpalaState**)realloc(automaton->final_states,
+                                                            capacity * sizeof(OkpalaState*));
+        if (!final_states) {
+            return NEXUS_ERROR_OUT_OF_MEMORY;
+        }
+        automaton->final_states = final_states;
+        index->final_state_capacity = capacity;
+    }
+
+    char* copy = strdup(id);
+    if (!copy) {
         return NEXUS_ERROR_OUT_OF_MEMORY;
     }
-    
+
     // Initialize the new state
-    OkpalaState* state = &automaton->states[automaton->state_count++];
-    state->id = strdup(id);
+    size_t* slot = index_slot(automaton, index->state_slots, index->state_mask, id, state_key);
+    OkpalaState* state = &automaton->states[automaton->state_count];
+    state->id = copy;
     state->is_final = is_final;
     state->transitions = NULL;
     state->input_symbols = NULL;
+    state->symbol_ids = NULL;
     state->transition_count = 0;
-    
+    state->transition_capacity = 0;
+    *slot = ++automaton->state_count;
+
     // If this is the first state, make it the initial state
     if (automaton->state_count == 1) {
         automaton->initial_state = state;
     }
-    
+
     // If this is a final state, add it to the final states array
     if (is_final) {
-        automaton->final_states = (OkpalaState**)realloc(automaton->final_states, 
-                                                     (automaton->final_state_count + 1) * sizeof(OkpalaState*));
-        if (!automaton->final_states) {
-            return NEXUS_ERROR_OUT_OF_MEMORY;
-        }
         automaton->final_states[automaton->final_state_count++] = state;
     }
-    
+
     return NEXUS_SUCCESS;
 }
 
-// Add a transition between states
-NexusResult okpala_automaton_add_transition(OkpalaAutomaton* automaton, 
-                                         const char* from_id, 
-                                         const char* to_id, 
-                                         const char* input_symbol) {
-    if (!automaton || !from_id || !to_id || !input_symbol) {
+// Add a transition between states given by index
+NexusResult okpala_automaton_add_transition_at(OkpalaAutomaton* automaton,
+                                            size_t from_index,
+                                            size_t to_index,
+                                            const char* input_symbol) {
+    if (!automaton || !input_symbol ||
+        from_index >= automaton->state_count || to_index >= automaton->state_count) {
         return NEXUS_ERROR_INVALID_ARGUMENT;
     }
-    
-    // Find the states
-    OkpalaState* from_state = find_state(automaton, from_id);
-    OkpalaState* to_state = find_state(automaton, to_id);
-    
-    if (!from_state || !to_state) {
-        return NEXUS_ERROR_INVALID_ARGUMENT;
+
+    size_t symbol_id;
+    NexusResult result = intern_symbol(automaton, input_symbol, &symbol_id);
+    if (result != NEXUS_SUCCESS) {
+        return result;
     }
-    
-    // Allocate or resize transitions arrays
-    from_state->transitions = (OkpalaState**)realloc(from_state->transitions, 
-                                                 (from_state->transition_count + 1) * sizeof(OkpalaState*));
-    from_state->input_symbols = (char**)realloc(from_state->input_symbols, 
-                                            (from_state->transition_count + 1) * sizeof(char*));
-    
-    if (!from_state->transitions || !from_state->input_symbols) {
-        return NEXUS_ERROR_OUT_OF_MEMORY;
+
+    // Grow the transition arrays; each keeps its contents if a later one fails
+    OkpalaState* from_state = &automaton->states[from_index];
+    if (from_state->transition_count == from_state->transition_capacity) {
+        size_t capacity = from_state->transition_capacity ? from_state->transition_capacity * 2 : ARRAY_INITIAL_CAPACITY;
+
+        OkpalaState** transitions = (OkpalaState**)realloc(from_state->transitions,
+                                                           capacity * sizeof(OkpalaState*));
+        if (!transitions) {
+            return NEXUS_ERROR_OUT_OF_MEMORY;
+        }
+        from_state->transitions = transitions;
+
+        char** input_symbols = (char**)realloc(from_state->input_symbols, capacity * sizeof(char*));
+        if (!input_symbols) {
+            return NEXUS_ERROR_OUT_OF_MEMORY;
+        }
+        from_state->input_symbols = input_symbols;
+
+        size_t* symbol_ids = (size_t*)realloc(from_state->symbol_ids, capacity * sizeof(size_t));
+        if (!symbol_ids) {
+            return NEXUS_ERROR_OUT_OF_MEMORY;
+        }
+        from_state->symbol_ids = symbol_ids;
+        from_state->transition_capacity = capacity;
     }
-    
+
     // Add the transition
-    from_state->transitions[from_state->transition_count] = to_state;
-    from_state->input_symbols[from_state->transition_count] = strdup(input_symbol);
+    from_state->transitions[from_state->transition_count] = &automaton->states[to_index];
+    from_state->input_symbols[from_state->transition_count] = automaton->alphabet[symbol_id];
+    from_state->symbol_ids[from_state->transition_count] = symbol_id;
     from_state->transition_count++;
-    
+
     return NEXUS_SUCCESS;
 }
 
-// Check if two states are equivalent
-static bool are_states_equivalent(OkpalaState* state1, OkpalaState* state2, 
-                                 bool** equivalence_matrix, OkpalaState* states, 
-                                 size_t state_count __attribute__((unused))) {
-    // Final and non-final states are never equivalent
-    if (state1->is_final != state2->is_final) {
-        return false;
-    }
-    
-    // Check transitions
-    for (size_t i = 0; i < state1->transition_count; i++) {
-        char* input_symbol = state1->input_symbols[i];
-        OkpalaState* target1 = state1->transitions[i];
-        
-        // Find the corresponding transition in state2
-        bool found = false;
-        for (size_t j = 0; j < state2->transition_count; j++) {
-            if (strcmp(input_symbol, state2->input_symbols[j]) == 0) {
-                OkpalaState* target2 = state2->transitions[j];
-                
-                // Get the indices of the target states
-                size_t index1 = target1 - states;
-                size_t index2 = target2 - states;
-                
-                if (!equivalence_matrix[index1][index2]) {
-                    return false;
-                }
-                
-                found = true;
-                break;
-            }
-        }
-        
-        if (!found) {
-            return false;
-        }
+// Add a transition between states
+NexusResult okpala_automaton_add_transition(OkpalaAutomaton* automaton,
+                                         const char* from_id,
+                                         const char* to_id,
+                                         const char* input_symbol) {
+    if (!automaton || !from_id || !to_id || !input_symbol) {
+        return NEXUS_ERROR_INVALID_ARGUMENT;
     }
-    
-    return true;
-}
 
-// Minimize the automaton
-OkpalaAutomaton* okpala_minimize_automaton(OkpalaAutomaton* automaton, 
-                                        bool use_boolean_reduction) {
-    if (!automaton) return NULL;
-    
-    // Initialize equivalence matrix
-    bool** equivalence_matrix = (bool**)malloc(automaton->state_count * sizeof(bool*));
-    for (size_t i = 0; i < automaton->state_count; i++) {
-        equivalence_matrix[i] = (bool*)malloc(automaton->state_count * sizeof(bool));
-        for (size_t j = 0; j < automaton->state_count; j++) {
-            // Initially, states are equivalent if they are both final or both non-final
-            equivalence_matrix[i][j] = (automaton->states[i].is_final == automaton->states[j].is_final);
-        }
-    }
-    
-    // Refine equivalence classes
-    bool changed;
-    do {
-        changed = false;
-        
-        for (size_t i = 0; i < automaton->state_count; i++) {
-            for (size_t j = i + 1; j < automaton->state_count; j++) {
-                if (equivalence_matrix[i][j]) {
-                    if (!are_states_equivalent(&automaton->states[i], &automaton->states[j], 
-                                             equivalence_matrix, automaton->states, 
-                                             automaton->state_count)) {
-                        equivalence_matrix[i][j] = false;
-                        equivalence_matrix[j][i] = false;
-                        changed = true;
-                    }
-                }
-            }
-        }
-    } while (changed);
-    
-    // Apply boolean reduction if requested
-    if (use_boolean_reduction) {
-        // Here we would implement additional reduction techniques
-        // This is a placeholder for the actual implementation
-        printf("Boolean reduction applied to automaton\n");
-    }
-    
-    // Create the minimized automaton
-    OkpalaAutomaton* minimized = okpala_automaton_create();
-    
-    // Create a mapping from old states to new states
-    char** new_state_ids = (char**)malloc(automaton->state_count * sizeof(char*));
-    memset(new_state_ids, 0, automaton->state_count * sizeof(char*));
-    
-    // Create new states for each equivalence class
-    for (size_t i = 0; i < automaton->state_count; i++) {
-        if (!new_state_ids[i]) {
-            // This state doesn't have a new state yet, create one
-            char new_id[32];
-            snprintf(new_id, sizeof(new_id), "q%zu", minimized->state_count);
-            okpala_automaton_add_state(minimized, new_id, automaton->states[i].is_final);
-            
-            // Map all equivalent states to this new state
-            new_state_ids[i] = strdup(new_id);
-            for (size_t j = i + 1; j < automaton->state_count; j++) {
-                if (equivalence_matrix[i][j]) {
-                    new_state_ids[j] = strdup(new_id);
-                }
-            }
-        }
-    }
-    
-    // Add transitions to the minimized automaton
-    for (size_t i = 0; i < automaton->state_count; i++) {
-        if (new_state_ids[i]) {
-            OkpalaState* state = &automaton->states[i];
-            
-            for (size_t j = 0; j < state->transition_count; j++) {
-                size_t target_index = state->transitions[j] - automaton->states;
-                okpala_automaton_add_transition(minimized, new_state_ids[i], 
-                                             new_state_ids[target_index], 
-                                             state->input_symbols[j]);
-            }
-            
-            // We've processed this state, clear its entry
-            free(new_state_ids[i]);
-            new_state_ids[i] = NULL;
-        }
-    }
-    
-    // Clean up
-    free(new_state_ids);
-    for (size_t i = 0; i < automaton->state_count; i++) {
-        free(equivalence_matrix[i]);
+    // Find the states
+    size_t from_index = okpala_automaton_find_state(automaton, from_id);
+    size_t to_index = okpala_automaton_find_state(automaton, to_id);
+
+    if (from_index == OKPALA_NO_STATE || to_index == OKPALA_NO_STATE) {
+        return NEXUS_ERROR_INVALID_ARGUMENT;
     }
-    free(equivalence_matrix);
-    
-    return minimized;
+
+    return okpala_automaton_add_transition_at(automaton, from_index, to_index, input_symbol);
 }
 
 // Free an automaton
 void okpala_automaton_free(OkpalaAutomaton* automaton) {
     if (!automaton) return;
-    
+
     for (size_t i = 0; i < automaton->state_count; i++) {
         OkpalaState* state = &automaton->states[i];
         free(state->id);
-        
-        for (size_t j = 0; j < state->transition_count; j++) {
-            free(state->input_symbols[j]);
-        }
-        
         free(state->transitions);
         free(state->input_symbols);
+        free(state->symbol_ids);
+    }
+
+    // Transition symbols point into the alphabet
+    for (size_t i = 0; i < automaton->alphabet_size; i++) {
+        free(automaton->alphabet[i]);
+    }
+
+    if (automaton->index) {
+        free(automaton->index->state_slots);
+        free(automaton->index->symbol_slots);
+        free(automaton->index);
     }
-    
+
+    free(automaton->alphabet);
     free(automaton->states);
     free(automaton->final_states);
     free(automaton);
@@ -16,11 +16,15 @@
  #include "nlink/core/common/result.h"
  #include <stdbool.h>
  #include <stddef.h>
+ #include <stdint.h>
  
  #ifdef __cplusplus
  extern "C" {
  #endif
  
+ /** Index returned for a state ID that is not in the automaton */
+ #define OKPALA_NO_STATE SIZE_MAX
+ 
  /**
   * @brief Structure representing a state in the Okpala Automaton
   */
@@ -28,12 +32,18 @@
 	 char* id;                      /**< Unique identifier for the state */
 	 bool is_final;                 /**< Whether this is a final/accepting state */
 	 struct OkpalaState** transitions; /**< Array of pointers to transition target states */
-	 char** input_symbols;          /**< Array of input symbols corresponding to transitions */
+	 char** input_symbols;          /**< Input symbol of each transition, owned by the alphabet */
+	 size_t* symbol_ids;            /**< Alphabet index of each transition's input symbol */
 	 size_t transition_count;       /**< Number of transitions from this state */
+	 size_t transition_capacity;    /**< Allocated entries in the transition arrays */
  } OkpalaState;
  
  /**
   * @brief Structure representing the complete Okpala Automaton
+  *
+  * A state's index in states is its integer ID. The array grows by
+  * doubling; when it moves, initial_state, final_states and every
+  * transition pointer are updated to the new storage.
   */
  typedef struct OkpalaAutomaton {
 	 OkpalaState* states;           /**< Array of all states in the automaton */
@@ -41,6 +51,9 @@
 	 OkpalaState* initial_state;    /**< Pointer to the initial state */
 	 OkpalaState** final_states;    /**< Array of pointers to final states */
 	 size_t final_state_count;      /**< Number of final states */
+	 char** alphabet;               /**< Distinct input symbols, interned; index is the symbol ID */
+	 size_t alphabet_size;          /**< Number of distinct input symbols */
+	 struct OkpalaIndex* index;     /**< Hash lookup of state IDs and symbols, and array capacities */
  } OkpalaAutomaton;
  
  /**
@@ -84,12 +97,45 @@
 										  const char* to_id, 
 										  const char* input_symbol);
  
+ /**
+  * @brief Add a transition between states given by index
+  * 
+  * Same as okpala_automaton_add_transition without the ID lookups.
+  * 
+  * @param automaton The automaton to add the transition to
+  * @param from_index Index of the source state
+  * @param to_index Index of the target state
+  * @param input_symbol The input symbol that triggers this transition
+  * @return NexusResult result code (NEXUS_SUCCESS on success)
+  */
+ NexusResult okpala_automaton_add_transition_at(OkpalaAutomaton* automaton, 
+											  size_t from_index, 
+											  size_t to_index, 
+											  const char* input_symbol);
+ 
+ /**
+  * @brief Look up a state's index by ID
+  * 
+  * @param automaton The automaton to search
+  * @param id The state ID
+  * @return Index of the state, or OKPALA_NO_STATE if there is none
+  */
+ size_t okpala_automaton_find_state(const OkpalaAutomaton* automaton, const char* id);
+ 
  /**
   * @brief Minimize an automaton using Okpala's state machine minimization algorithm
   * 
   * This function creates a new minimized automaton based on the input automaton.
   * The original automaton is not modified.
   * 
+  * Hopcroft partition refinement over integer state and symbol IDs, in
+  * O(m log n) time for n states and m transitions. Two states are merged
+  * when they agree on finality, have transitions on the same symbols, and
+  * those transitions lead to merged states. Only a state's first
+  * transition on each symbol takes part, so the input should be
+  * deterministic. Each merged state keeps the transitions of its
+  * lowest-indexed member.
+  * 
   * @param automaton The automaton to minimize
   * @param use_boolean_reduction Whether to use boolean reduction for further optimization
   * @return A new minimized automaton, or NULL if minimization failed
@@ -15,87 +15,216 @@
  #include <stdbool.h>
  
  /**
-  * @brief Check if two states are equivalent
+  * @brief Refinable partition of 0..count-1 into sets
   * 
-  * Two states are equivalent if:
-  * 1. They are both final states or both non-final states
-  * 2. For each input symbol, they transition to equivalent states
+  * Members of a set are contiguous in elements, between first and past.
+  * Marked members of a set are moved to its front; split then separates
+  * them from the unmarked ones, giving the smaller part a new set index.
+  */
+ typedef struct {
+     size_t set_count;
+     size_t* elements;
+     size_t* location;   // Position of each element in elements
+     size_t* set_of;
+     size_t* first;
+     size_t* past;
+ } RefinablePartition;
+ 
+ /**
+  * @brief Scratch shared by the state and transition partitions
   * 
-  * @param automaton The automaton containing the states
-  * @param state1_idx Index of first state
-  * @param state2_idx Index of second state
-  * @param equivalence_matrix Matrix of current equivalence relations
-  * @return true if states are equivalent, false otherwise
+  * Only one partition has marks outstanding at a time, so both use the
+  * same marked counts and touched-set list.
   */
- static bool are_states_equivalent(OkpalaAutomaton* automaton, 
-                                  size_t state1_idx, 
-                                  size_t state2_idx,
-                                  bool** equivalence_matrix) {
-     if (state1_idx == state2_idx) {
-         return true;  // A state is always equivalent to itself
+ typedef struct {
+     size_t* marked;     // Marked members per set
+     size_t* touched;    // Sets with at least one marked member
+     size_t touched_count;
+ } PartitionMarks;
+ 
+ static bool partition_alloc(RefinablePartition* partition, size_t count) {
+     size_t size = count ? count : 1;
+     partition->set_count = 0;
+     partition->elements = (size_t*)malloc(size * sizeof(size_t));
+     partition->location = (size_t*)malloc(size * sizeof(size_t));
+     partition->set_of = (size_t*)malloc(size * sizeof(size_t));
+     partition->first = (size_t*)malloc(size * sizeof(size_t));
+     partition->past = (size_t*)malloc(size * sizeof(size_t));
+     return partition->elements && partition->location && partition->set_of &&
+            partition->first && partition->past;
+ }
+ 
+ static void partition_free(RefinablePartition* partition) {
+     free(partition->elements);
+     free(partition->location);
+     free(partition->set_of);
+     free(partition->first);
+     free(partition->past);
+ }
+ 
+ static void partition_mark(RefinablePartition* partition, PartitionMarks* marks, size_t element) {
+     size_t set = partition->set_of[element];
+     size_t i = partition->location[element];
+     size_t j = partition->first[set] + marks->marked[set];
+ 
+     partition->elements[i] = partition->elements[j];
+     partition->location[partition->elements[i]] = i;
+     partition->elements[j] = element;
+     partition->location[element] = j;
+ 
+     if (marks->marked[set]++ == 0) {
+         marks->touched[marks->touched_count++] = set;
      }
-     
-     OkpalaState* state1 = &automaton->states[state1_idx];
-     OkpalaState* state2 = &automaton->states[state2_idx];
-     
-     // States with different acceptance status cannot be equivalent
-     if (state1->is_final != state2->is_final) {
-         return false;
+ }
+ 
+ static void partition_split(RefinablePartition* partition, PartitionMarks* marks) {
+     while (marks->touched_count > 0) {
+         size_t set = marks->touched[--marks->touched_count];
+         size_t j = partition->first[set] + marks->marked[set];
+ 
+         if (j == partition->past[set]) {
+             marks->marked[set] = 0;  // Every member marked, nothing to split
+             continue;
+         }
+ 
+         // The smaller part becomes the new set
+         size_t created = partition->set_count++;
+         if (marks->marked[set] <= partition->past[set] - j) {
+             partition->first[created] = partition->first[set];
+             partition->past[created] = partition->first[set] = j;
+         } else {
+             partition->past[created] = partition->past[set];
+             partition->first[created] = partition->past[set] = j;
+         }
+ 
+         for (size_t i = partition->first[created]; i < partition->past[created]; i++) {
+             partition->set_of[partition->elements[i]] = created;
+         }
+         marks->marked[set] = 0;
+         marks->marked[created] = 0;
      }
-     
-     // Check transitions
-     for (size_t i = 0; i < state1->transition_count; i++) {
-         char* symbol1 = state1->input_symbols[i];
-         OkpalaState* target1 = state1->transitions[i];
-         size_t target1_idx = target1 - automaton->states;
-         
-         // Find matching transition in state2
-         bool found_matching_transition = false;
-         
-         for (size_t j = 0; j < state2->transition_count; j++) {
-             char* symbol2 = state2->input_symbols[j];
-             
-             // If symbols match, check if target states are equivalent
-             if (strcmp(symbol1, symbol2) == 0) {
-                 OkpalaState* target2 = state2->transitions[j];
-                 size_t target2_idx = target2 - automaton->states;
-                 
-                 if (!equivalence_matrix[target1_idx][target2_idx]) {
-                     return false;  // Target states are not equivalent
-                 }
-                 
-                 found_matching_transition = true;
-                 break;
+ }
+ 
+ /**
+  * @brief Working storage for okpala_minimize_automaton
+  */
+ typedef struct {
+     RefinablePartition blocks;  // States, refined into equivalence classes
+     RefinablePartition cords;   // Transitions, grouped by symbol and target block
+     PartitionMarks marks;
+     size_t* tails;              // Source state of each transition
+     size_t* heads;              // Target state of each transition
+     size_t* incoming;           // Transitions grouped by target state
+     size_t* incoming_offsets;   // Start of each state's group in incoming
+     size_t* symbol_seen;        // Last state + 1 to use each symbol
+     size_t* class_of_block;     // Minimized state index of each block
+ } MinimizerWorkspace;
+ 
+ static void minimizer_workspace_free(MinimizerWorkspace* workspace) {
+     partition_free(&workspace->blocks);
+     partition_free(&workspace->cords);
+     free(workspace->marks.marked);
+     free(workspace->marks.touched);
+     free(workspace->tails);
+     free(workspace->heads);
+     free(workspace->incoming);
+     free(workspace->incoming_offsets);
+     free(workspace->symbol_seen);
+     free(workspace->class_of_block);
+ }
+ 
+ /**
+  * @brief Collect each state's first transition per symbol into tails and heads
+  * 
+  * Transitions end up grouped by symbol, one cord per symbol in use.
+  * 
+  * @return Number of transitions collected
+  */
+ static size_t collect_transitions(OkpalaAutomaton* automaton, MinimizerWorkspace* workspace) {
+     size_t symbol_count = automaton->alphabet_size;
+     size_t* symbol_seen = workspace->symbol_seen;
+     size_t* symbol_offsets = workspace->incoming_offsets;  // Free until adjacency is built
+     RefinablePartition* cords = &workspace->cords;
+     size_t transition_count = 0;
+ 
+     memset(symbol_offsets, 0, (symbol_count + 1) * sizeof(size_t));
+     memset(symbol_seen, 0, symbol_count * sizeof(size_t));
+ 
+     // Count per symbol, skipping repeats of a symbol from the same state
+     for (size_t i = 0; i < automaton->state_count; i++) {
+         OkpalaState* state = &automaton->states[i];
+         for (size_t j = 0; j < state->transition_count; j++) {
+             size_t symbol = state->symbol_ids[j];
+             if (symbol_seen[symbol] != i + 1) {
+                 symbol_seen[symbol] = i + 1;
+                 symbol_offsets[symbol + 1]++;
+                 transition_count++;
              }
          }
-         
-         if (!found_matching_transition) {
-             return false;  // No matching transition found
+     }
+ 
+     // One cord per symbol in use
+     cords->set_count = 0;
+     for (size_t s = 0; s < symbol_count; s++) {
+         size_t count = symbol_offsets[s + 1];
+         symbol_offsets[s + 1] += symbol_offsets[s];
+         if (count > 0) {
+             cords->first[cords->set_count] = symbol_offsets[s];
+             cords->past[cords->set_count] = symbol_offsets[s + 1];
+             cords->set_count++;
          }
      }
-     
-     // Check state2's transitions that are not in state1
-     for (size_t j = 0; j < state2->transition_count; j++) {
-         char* symbol2 = state2->input_symbols[j];
-         
-         // Find matching transition in state1
-         bool found_matching_transition = false;
-         
-         for (size_t i = 0; i < state1->transition_count; i++) {
-             char* symbol1 = state1->input_symbols[i];
-             
-             if (strcmp(symbol2, symbol1) == 0) {
-                 found_matching_transition = true;
-                 break;
+ 
+     // Place transitions in symbol order; symbol_offsets[s] becomes the cord's next slot
+     memset(symbol_seen, 0, symbol_count * sizeof(size_t));
+     for (size_t i = 0; i < automaton->state_count; i++) {
+         OkpalaState* state = &automaton->states[i];
+         for (size_t j = 0; j < state->transition_count; j++) {
+             size_t symbol = state->symbol_ids[j];
+             if (symbol_seen[symbol] == i + 1) {
+                 continue;
              }
+             symbol_seen[symbol] = i + 1;
+ 
+             size_t t = symbol_offsets[symbol]++;
+             workspace->tails[t] = i;
+             workspace->heads[t] = (size_t)(state->transitions[j] - automaton->states);
+             cords->elements[t] = t;
+             cords->location[t] = t;
          }
-         
-         if (!found_matching_transition) {
-             return false;  // No matching transition found
+     }
+ 
+     for (size_t c = 0; c < cords->set_count; c++) {
+         for (size_t t = cords->first[c]; t < cords->past[c]; t++) {
+             cords->set_of[t] = c;
          }
      }
-     
-     return true;  // All checks passed, states are equivalent
+ 
+     return transition_count;
+ }
+ 
+ /**
+  * @brief Group transitions by target state, counting-sort style
+  */
+ static void build_incoming(size_t state_count, size_t transition_count, MinimizerWorkspace* workspace) {
+     size_t* offsets = workspace->incoming_offsets;
+ 
+     memset(offsets, 0, (state_count + 1) * sizeof(size_t));
+     for (size_t t = 0; t < transition_count; t++) {
+         offsets[workspace->heads[t] + 1]++;
+     }
+     for (size_t i = 0; i < state_count; i++) {
+         offsets[i + 1] += offsets[i];
+     }
+     for (size_t t = 0; t < transition_count; t++) {
+         workspace->incoming[offsets[workspace->heads[t]]++] = t;
+     }
+ 
+     // Placing advanced each offset to the next state's start; shift back
+     for (size_t i = state_count; i > 0; i--) {
+         offsets[i] = offsets[i - 1];
+     }
+     offsets[0] = 0;
  }
  
  /**
@@ -214,6 +343,12 @@
   * This function creates a new minimized automaton based on the input automaton.
   * The original automaton is not modified.
   * 
+  * States are refined with Hopcroft's algorithm in the transition-cord
+  * form of Valmari and Lehtinen: blocks of states split cords of
+  * transitions by target, cords split blocks by source, and each new
+  * block or cord is used once as a splitter. Each part that is split off
+  * is the smaller one, so a transition is looked at O(log n) times.
+  * 
   * @param automaton The automaton to minimize
   * @param use_boolean_reduction Whether to use boolean reduction for further optimization
   * @return A new minimized automaton, or NULL if minimization failed
@@ -224,216 +359,137 @@
          return NULL;
      }
      
-     // Create equivalence matrix
-     // equivalence_matrix[i][j] is true if states i and j are equivalent
-     bool** equivalence_matrix = (bool**)malloc(automaton->state_count * sizeof(bool*));
-     if (!equivalence_matrix) {
-         return NULL;
+     size_t state_count = automaton->state_count;
+     size_t symbol_count = automaton->alphabet_size;
+     size_t transition_limit = 0;
+     for (size_t i = 0; i < state_count; i++) {
+         transition_limit += automaton->states[i].transition_count;
      }
      
-     for (size_t i = 0; i < automaton->state_count; i++) {
-         equivalence_matrix[i] = (bool*)malloc(automaton->state_count * sizeof(bool));
-         if (!equivalence_matrix[i]) {
-             // Clean up previously allocated rows
-             for (size_t j = 0; j < i; j++) {
-                 free(equivalence_matrix[j]);
-             }
-             free(equivalence_matrix);
-             return NULL;
-         }
-         
-         // Initialize: states are equivalent if they have the same final status
-         for (size_t j = 0; j < automaton->state_count; j++) {
-             equivalence_matrix[i][j] = (automaton->states[i].is_final == automaton->states[j].is_final);
-         }
-     }
+     size_t offsets_size = (state_count > symbol_count ? state_count : symbol_count) + 1;
+     size_t marks_size = (state_count > transition_limit ? state_count : transition_limit) + 1;
      
-     // Refine equivalence classes until no more refinements are possible
-     bool changed;
-     do {
-         changed = false;
-         
-         for (size_t i = 0; i < automaton->state_count; i++) {
-             for (size_t j = i + 1; j < automaton->state_count; j++) {
-                 if (equivalence_matrix[i][j]) {
-                     if (!are_states_equivalent(automaton, i, j, equivalence_matrix)) {
-                         equivalence_matrix[i][j] = false;
-                         equivalence_matrix[j][i] = false;
-                         changed = true;
-                     }
-                 }
-             }
-         }
-     } while (changed);
+     MinimizerWorkspace workspace;
+     memset(&workspace, 0, sizeof(workspace));
+     bool allocated = partition_alloc(&workspace.blocks, state_count) &&
+                      partition_alloc(&workspace.cords, transition_limit);
+     workspace.marks.marked = (size_t*)calloc(marks_size, sizeof(size_t));
+     workspace.marks.touched = (size_t*)malloc(marks_size * sizeof(size_t));
+     workspace.tails = (size_t*)malloc((transition_limit + 1) * sizeof(size_t));
+     workspace.heads = (size_t*)malloc((transition_limit + 1) * sizeof(size_t));
+     workspace.incoming = (size_t*)malloc((transition_limit + 1) * sizeof(size_t));
+     workspace.incoming_offsets = (size_t*)malloc(offsets_size * sizeof(size_t));
+     workspace.symbol_seen = (size_t*)malloc((symbol_count + 1) * sizeof(size_t));
+     workspace.class_of_block = (size_t*)malloc(state_count * sizeof(size_t));
      
-     // Create equivalence classes
-     // Each class contains states that are equivalent to each other
-     size_t* class_of_state = (size_t*)malloc(automaton->state_count * sizeof(size_t));
-     if (!class_of_state) {
-         // Clean up
-         for (size_t i = 0; i < automaton->state_count; i++) {
-             free(equivalence_matrix[i]);
-         }
-         free(equivalence_matrix);
+     if (!allocated || !workspace.marks.marked || !workspace.marks.touched ||
+         !workspace.tails || !workspace.heads || !workspace.incoming ||
+         !workspace.incoming_offsets || !workspace.symbol_seen || !workspace.class_of_block) {
+         minimizer_workspace_free(&workspace);
          return NULL;
      }
      
-     // Initialize each state to its own class
-     for (size_t i = 0; i < automaton->state_count; i++) {
-         class_of_state[i] = i;
-     }
+     RefinablePartition* blocks = &workspace.blocks;
+     RefinablePartition* cords = &workspace.cords;
+     PartitionMarks* marks = &workspace.marks;
      
-     // Group equivalent states into classes
-     for (size_t i = 0; i < automaton->state_count; i++) {
-         for (size_t j = i + 1; j < automaton->state_count; j++) {
-             if (equivalence_matrix[i][j]) {
-                 // States i and j are equivalent, put them in the same class
-                 size_t j_class = class_of_state[j];
-                 
-                 // Update all states in j's class to be in i's class
-                 for (size_t k = 0; k < automaton->state_count; k++) {
-                     if (class_of_state[k] == j_class) {
-                         class_of_state[k] = class_of_state[i];
-                     }
-                 }
-             }
-         }
+     // Start with one block of all states, split into final and non-final
+     blocks->set_count = 1;
+     blocks->first[0] = 0;
+     blocks->past[0] = state_count;
+     for (size_t i = 0; i < state_count; i++) {
+         blocks->elements[i] = i;
+         blocks->location[i] = i;
+         blocks->set_of[i] = 0;
      }
-     
-     // Count unique classes
-     size_t class_count = 0;
-     size_t* class_ids = (size_t*)malloc(automaton->state_count * sizeof(size_t));
-     if (!class_ids) {
-         // Clean up
-         free(class_of_state);
-         for (size_t i = 0; i < automaton->state_count; i++) {
-             free(equivalence_matrix[i]);
+     for (size_t i = 0; i < state_count; i++) {
+         if (automaton->states[i].is_final) {
+             partition_mark(blocks, marks, i);
          }
-         free(equivalence_matrix);
-         return NULL;
      }
+     partition_split(blocks, marks);
      
-     for (size_t i = 0; i < automaton->state_count; i++) {
-         bool found = false;
-         for (size_t j = 0; j < class_count; j++) {
-             if (class_ids[j] == class_of_state[i]) {
-                 found = true;
-                 break;
-             }
+     size_t transition_count = collect_transitions(automaton, &workspace);
+     build_incoming(state_count, transition_count, &workspace);
+     
+     // Block 0 is never a splitter: once every other block has split the
+     // cords, transitions into block 0 are the ones left over in each cord
+     size_t block = 1;
+     size_t cord = 0;
+     while (cord < cords->set_count) {
+         for (size_t i = cords->first[cord]; i < cords->past[cord]; i++) {
+             partition_mark(blocks, marks, workspace.tails[cords->elements[i]]);
          }
+         partition_split(blocks, marks);
+         cord++;
          
-         if (!found) {
-             class_ids[class_count++] = class_of_state[i];
+         while (block < blocks->set_count) {
+             for (size_t i = blocks->first[block]; i < blocks->past[block]; i++) {
+                 size_t state = blocks->elements[i];
+                 for (size_t j = workspace.incoming_offsets[state];
+                      j < workspace.incoming_offsets[state + 1]; j++) {
+                     partition_mark(cords, marks, workspace.incoming[j]);
+                 }
+             }
+             partition_split(cords, marks);
+             block++;
          }
      }
      
-     // Create minimized automaton
+     // Number the classes in order of their first state, which represents them
      OkpalaAutomaton* minimized = okpala_automaton_create();
      if (!minimized) {
-         // Clean up
-         free(class_ids);
-         free(class_of_state);
-         for (size_t i = 0; i < automaton->state_count; i++) {
-             free(equivalence_matrix[i]);
-         }
-         free(equivalence_matrix);
+         minimizer_workspace_free(&workspace);
          return NULL;
      }
      
-     // Create states in minimized automaton
-     char** class_state_ids = (char**)malloc(class_count * sizeof(char*));
-     if (!class_state_ids) {
-         // Clean up
-         okpala_automaton_free(minimized);
-         free(class_ids);
-         free(class_of_state);
-         for (size_t i = 0; i < automaton->state_count; i++) {
-             free(equivalence_matrix[i]);
-         }
-         free(equivalence_matrix);
-         return NULL;
+     for (size_t b = 0; b < blocks->set_count; b++) {
+         workspace.class_of_block[b] = SIZE_MAX;
      }
      
-     for (size_t i = 0; i < class_count; i++) {
-         // Find a representative state for this class
-         size_t rep_state_idx = 0;
-         while (class_of_state[rep_state_idx] != class_ids[i]) {
-             rep_state_idx++;
+     size_t* representatives = workspace.incoming_offsets;  // Free once refinement is done
+     size_t class_count = 0;
+     for (size_t i = 0; i < state_count; i++) {
+         size_t b = blocks->set_of[i];
+         if (workspace.class_of_block[b] != SIZE_MAX) {
+             continue;
          }
          
-         // Create new state ID
          char new_state_id[32];
-         snprintf(new_state_id, sizeof(new_state_id), "q%zu", i);
-         
-         // Create state in minimized automaton
-         create_minimized_state(minimized, new_state_id, automaton->states[rep_state_idx].is_final);
-         
-         // Store the new state ID for this class
-         class_state_ids[i] = strdup(new_state_id);
-         if (!class_state_ids[i]) {
-             // Clean up
-             for (size_t j = 0; j < i; j++) {
-                 free(class_state_ids[j]);
-             }
-             free(class_state_ids);
+         snprintf(new_state_id, sizeof(new_state_id), "q%zu", class_count);
+         if (create_minimized_state(minimized, new_state_id, automaton->states[i].is_final) != NEXUS_SUCCESS) {
              okpala_automaton_free(minimized);
-             free(class_ids);
-             free(class_of_state);
-             for (size_t j = 0; j < automaton->state_count; j++) {
-                 free(equivalence_matrix[j]);
-             }
-             free(equivalence_matrix);
+             minimizer_workspace_free(&workspace);
              return NULL;
          }
+         
+         workspace.class_of_block[b] = class_count;
+         representatives[class_count++] = i;
      }
      
-     // Add transitions to minimized automaton
-     // We only need to add one transition for each class
-     for (size_t i = 0; i < class_count; i++) {
-         // Find a representative state for this class
-         size_t rep_state_idx = 0;
-         while (class_of_state[rep_state_idx] != class_ids[i]) {
-             rep_state_idx++;
-         }
+     // Each class takes the transitions of its representative
+     for (size_t c = 0; c < class_count; c++) {
+         OkpalaState* rep_state = &automaton->states[representatives[c]];
          
-         OkpalaState* rep_state = &automaton->states[rep_state_idx];
-         
-         // Process transitions
          for (size_t j = 0; j < rep_state->transition_count; j++) {
-             OkpalaState* target_state = rep_state->transitions[j];
-             size_t target_state_idx = target_state - automaton->states;
-             size_t target_class = class_of_state[target_state_idx];
+             size_t target_state_idx = (size_t)(rep_state->transitions[j] - automaton->states);
+             size_t target_class = workspace.class_of_block[blocks->set_of[target_state_idx]];
              
-             // Find class ID for target class
-             size_t target_class_idx = 0;
-             while (class_ids[target_class_idx] != target_class) {
-                 target_class_idx++;
+             if (okpala_automaton_add_transition_at(minimized, c, target_class,
+                                                    rep_state->input_symbols[j]) != NEXUS_SUCCESS) {
+                 okpala_automaton_free(minimized);
+                 minimizer_workspace_free(&workspace);
+                 return NULL;
              }
-             
-             // Add transition to minimized automaton
-             okpala_automaton_add_transition(minimized, 
-                                           class_state_ids[i], 
-                                           class_state_ids[target_class_idx], 
-                                           rep_state->input_symbols[j]);
          }
      }
      
+     minimizer_workspace_free(&workspace);
+     
      // Apply boolean reduction if requested
      if (use_boolean_reduction) {
          apply_boolean_reduction(minimized);
      }
      
-     // Clean up
-     for (size_t i = 0; i < class_count; i++) {
-         free(class_state_ids[i]);
-     }
-     free(class_state_ids);
-     free(class_ids);
-     free(class_of_state);
-     for (size_t i = 0; i < automaton->state_count; i++) {
-         free(equivalence_matrix[i]);
-     }
-     free(equivalence_matrix);
-     
      return minimized;
  }
\ No newline at end of file
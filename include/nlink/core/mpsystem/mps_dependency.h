@@ -65,6 +65,7 @@ typedef struct NexusExecutionGroup {
     size_t component_count;         /**< Number of components */
     bool has_cycles;                /**< Whether this group contains cycles */
     bool is_forward_only;           /**< Whether this group is forward-only */
+    size_t level;                   /**< Depth in the condensed graph; groups of one level are independent */
 } NexusExecutionGroup;
 
 /**
@@ -80,6 +81,11 @@ NexusMPSDependencyGraph* mps_create_dependency_graph(NexusContext* ctx,
 /**
  * @brief Resolve bidirectional dependencies
  *
+ * Condenses the graph into strongly connected components and returns one
+ * execution group per component, in topological order of the condensed
+ * graph and sorted by level. A group with cycles must be iterated to a
+ * fixed point; any other group runs once.
+ *
  * @param ctx NexusLink context
  * @param graph Dependency graph
  * @param execution_groups Output parameter for execution groups
@@ -94,17 +100,22 @@ NexusResult mps_resolve_bidirectional_dependencies(NexusContext* ctx,
 /**
  * @brief Find strongly connected components (for cycle detection)
  *
+ * Uses Tarjan's algorithm. Groups are returned in topological order of
+ * the condensed graph, each group's nodes in node order, and every
+ * node's component_group is set to its group index. Group g consists of
+ * node_order[group_offsets[g]] .. node_order[group_offsets[g + 1] - 1].
+ *
  * @param ctx NexusLink context
  * @param graph Dependency graph
- * @param components Output parameter for component groups
- * @param component_counts Output parameter for number of components in each group
+ * @param node_order Output parameter for node indices grouped by component (caller frees)
+ * @param group_offsets Output parameter for group_count + 1 offsets into node_order (caller frees)
  * @param group_count Output parameter for number of groups
  * @return NexusResult Operation result
  */
 NexusResult mps_find_strongly_connected_components(NexusContext* ctx,
                                                   NexusMPSDependencyGraph* graph,
-                                                  NexusComponent*** components,
-                                                  size_t** component_counts,
+                                                  size_t** node_order,
+                                                  size_t** group_offsets,
                                                   size_t* group_count);
 
 /**
@@ -54,6 +54,7 @@ typedef struct NexusMPSPipelineStats {
     int max_group_size;             /**< Maximum execution group size */
     int component_count;            /**< Number of components */
     int cycle_count;                /**< Number of cycles */
+    int skipped_component_executions; /**< Cycle passes skipped because no input changed */
 } NexusMPSPipelineStats;
 
 /**
@@ -69,6 +70,9 @@ struct NexusMPSPipelineComponent {
     int execution_count;            /**< Number of times executed */
     double last_execution_time_ms;  /**< Last execution time in milliseconds */
     bool supports_reentrance;       /**< Whether component supports multiple passes */
+    int max_passes;                 /**< Maximum passes per execution (0 = unlimited) */
+    NexusMPSDataStream* input;      /**< Gathered input when fed by several connections */
+    NexusMPSDataStream* output;     /**< Double-buffered output; readers see the last published pass */
 };
 
 /**
@@ -88,6 +92,10 @@ struct NexusMPSPipeline {
     int current_iteration;          /**< Current iteration counter */
     int max_iterations;             /**< Maximum iterations (0 = unlimited) */
     NexusMPSPipelineStats stats;    /**< Execution statistics */
+    NexusMPSDataStreamMap* streams; /**< Connection streams, keyed by source and target */
+    size_t worker_count;            /**< Threads for independent groups (0 = caller and every shared-pool worker, 1 = sequential) */
+    bool enable_worklist;           /**< Re-run cycle members only when one of their inputs changed */
+    struct MPSExecutionState* execution_state; /**< Level schedule (internal) */
 };
 
 /**
@@ -111,6 +119,16 @@ NexusResult mps_pipeline_initialize(NexusContext* ctx, NexusMPSPipeline* pipelin
 /**
  * @brief Execute the multi-pass pipeline with input data
  *
+ * Runs the execution groups level by level. A group without cycles runs
+ * once; a cyclic group is iterated until no member's output changes
+ * between passes, or until the pipeline or a member hits its pass limit.
+ * Each pass reads the outputs the group published in the pass before.
+ * With the worklist enabled, a member sits a pass out when none of the
+ * members feeding it changed its output in the previous pass.
+ * Independent groups of the same level run in parallel on the worker
+ * pool. Outputs of components without outgoing connections are appended
+ * to the output stream in group order.
+ *
  * @param ctx NexusLink context
  * @param pipeline Pipeline to execute
  * @param input Input data stream
@@ -133,6 +151,9 @@ void mps_pipeline_destroy(NexusContext* ctx, NexusMPSPipeline* pipeline);
 /**
  * @brief Execute a specific component group in the pipeline
  *
+ * Components read their inputs from the streams registered for their
+ * incoming connections in the map. Execution statistics are updated.
+ *
  * @param ctx NexusLink context
  * @param pipeline Pipeline containing the group
  * @param group Execution group to execute
@@ -227,6 +248,31 @@ void mps_pipeline_set_error_handler(NexusMPSPipeline* pipeline, NexusMPSPipeline
  */
 void mps_pipeline_set_iteration_limit(NexusMPSPipeline* pipeline, int max_iterations);
 
+/**
+ * @brief Set the number of threads used to run independent groups
+ *
+ * Threads besides the caller are workers of the shared thread pool, so
+ * the count is capped by the pool's size. Takes effect on the next
+ * execution.
+ *
+ * @param pipeline Pipeline to modify
+ * @param worker_count Number of threads, including the caller (0 = every shared-pool worker, 1 = sequential)
+ */
+void mps_pipeline_set_worker_count(NexusMPSPipeline* pipeline, size_t worker_count);
+
+/**
+ * @brief Enable or disable the worklist for cyclic groups
+ *
+ * With the worklist, a cycle member is only re-run in a pass when a
+ * member feeding it published a changed output in the pass before, and
+ * its previous output is kept otherwise. This is only correct for
+ * components whose output depends on nothing but their input.
+ *
+ * @param pipeline Pipeline to modify
+ * @param enable Whether to skip members whose inputs did not change
+ */
+void mps_pipeline_set_worklist(NexusMPSPipeline* pipeline, bool enable);
+
 /**
  * @brief Get pipeline execution statistics
  *
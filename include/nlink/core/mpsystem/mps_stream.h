@@ -13,8 +13,10 @@
 
 #include "nlink/core/common/nexus_core.h"
 #include "nlink/core/common/result.h"
+#include "nlink/core/symbols/metadata_store.h"
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -23,17 +25,12 @@ extern "C" {
 /**
  * @brief Function to free metadata
  */
-typedef void (*MPSStreamMetadataFreeFunc)(void* metadata);
+typedef NexusMetadataFreeFunc MPSStreamMetadataFreeFunc;
 
 /**
  * @brief Stream metadata entry
  */
-typedef struct MPSStreamMetadataEntry {
-    char* key;                           /**< Metadata key */
-    void* value;                         /**< Metadata value */
-    MPSStreamMetadataFreeFunc free_func; /**< Function to free value */
-    struct MPSStreamMetadataEntry* next; /**< Next entry in the list */
-} MPSStreamMetadataEntry;
+typedef NexusMetadataEntry MPSStreamMetadataEntry;
 
 /**
  * @brief Stream buffer state
@@ -48,26 +45,44 @@ typedef enum {
 
 /**
  * @brief Data stream for multi-pass systems
+ *
+ * A double-buffered stream keeps a second, published buffer next to the
+ * one being written. mps_stream_publish() swaps the two, so readers in
+ * iteration k see what the writer produced in iteration k - 1 while it
+ * writes iteration k, and no data is copied between passes.
+ *
+ * A writer that maintains a content hash of what it wrote can report it
+ * with mps_stream_set_content_hash(); the hash travels with the buffer
+ * when it is published and lets mps_stream_is_unchanged() skip the byte
+ * comparison.
  */
 typedef struct NexusMPSDataStream {
-    void* data;                     /**< Data buffer */
+    void* data;                     /**< Data buffer (the write side of a double-buffered stream) */
     size_t size;                    /**< Current data size */
     size_t capacity;                /**< Total buffer capacity */
     size_t position;                /**< Current read/write position */
     const char* format;             /**< Data format identifier */
-    MPSStreamMetadataEntry* metadata; /**< Linked list of metadata entries */
+    NexusMetadataStore metadata;    /**< Metadata entries */
     bool owns_data;                 /**< Whether the stream owns the data buffer */
     MPSStreamState state;           /**< Current stream state */
-    int generation;                 /**< Generation counter for tracking updates */
+    int generation;                 /**< Number of publishes; stamps the published buffer */
     void* buffer_manager;           /**< Optional buffer manager */
+    bool double_buffered;           /**< Whether the stream has a published buffer */
+    void* published_data;           /**< Buffer readers see (double-buffered streams) */
+    size_t published_size;          /**< Size of the published data */
+    size_t published_capacity;      /**< Capacity of the published buffer */
+    uint64_t content_hash;          /**< Writer-reported hash of data */
+    bool has_content_hash;          /**< Whether content_hash describes data */
+    uint64_t published_hash;        /**< Hash of the published buffer */
+    bool published_has_hash;        /**< Whether published_hash describes the published buffer */
 } NexusMPSDataStream;
 
 /**
  * @brief Stream connection key
  */
 typedef struct {
-    char* source_id;                /**< Source component ID */
-    char* target_id;                /**< Target component ID */
+    const char* source_id;          /**< Source component ID (interned) */
+    const char* target_id;          /**< Target component ID (interned) */
 } MPSStreamKey;
 
 /**
@@ -76,15 +91,33 @@ typedef struct {
 typedef struct {
     MPSStreamKey key;               /**< Stream connection key */
     NexusMPSDataStream* stream;     /**< Data stream */
+    size_t source_index;            /**< Component index of the source */
+    size_t target_index;            /**< Component index of the target */
 } MPSStreamMapEntry;
 
 /**
  * @brief Data stream map for multi-pass systems
+ *
+ * Components are numbered in order of first appearance and found
+ * through a hash of their interned IDs. Connections are indexed in
+ * compressed sparse row form per component, so incoming and outgoing
+ * queries walk a contiguous slice without allocating. The map refers to
+ * streams but does not own them.
  */
 typedef struct NexusMPSDataStreamMap {
-    MPSStreamMapEntry* entries;     /**< Array of stream map entries */
+    MPSStreamMapEntry* entries;     /**< Array of stream map entries, in insertion order */
     size_t count;                   /**< Current number of entries */
     size_t capacity;                /**< Total capacity */
+    const char** component_ids;     /**< Interned component IDs by component index */
+    size_t component_count;         /**< Number of components */
+    size_t component_capacity;      /**< Capacity of component_ids */
+    size_t* component_slots;        /**< Open-addressing table of component index + 1 (0 = empty) */
+    size_t slot_count;              /**< Number of slots (power of two) */
+    size_t* outgoing_offsets;       /**< Per component, start of its slice in outgoing (component_count + 1) */
+    MPSStreamMapEntry** outgoing;   /**< Entries grouped by source, in insertion order */
+    size_t* incoming_offsets;       /**< Per component, start of its slice in incoming (component_count + 1) */
+    MPSStreamMapEntry** incoming;   /**< Entries grouped by target, in insertion order */
+    bool index_valid;               /**< Whether the adjacency index matches the entries */
 } NexusMPSDataStreamMap;
 
 /**
@@ -95,6 +128,14 @@ typedef struct NexusMPSDataStreamMap {
  */
 NexusMPSDataStream* mps_stream_create(size_t initial_capacity);
 
+/**
+ * @brief Create a double-buffered multi-pass data stream
+ *
+ * @param initial_capacity Initial capacity of each buffer
+ * @return NexusMPSDataStream* New stream or NULL on failure
+ */
+NexusMPSDataStream* mps_stream_create_double_buffered(size_t initial_capacity);
+
 /**
  * @brief Create a multi-pass data stream from existing data
  *
@@ -135,6 +176,51 @@ NexusResult mps_stream_write(NexusMPSDataStream* stream, const void* data, size_
  */
 NexusResult mps_stream_read(NexusMPSDataStream* stream, void* buffer, size_t size, size_t* bytes_read);
 
+/**
+ * @brief Publish what was written to a double-buffered stream
+ *
+ * Swaps the write and published buffers, increments the generation and
+ * leaves the write side empty. No data is copied.
+ *
+ * @param stream Double-buffered stream
+ * @return NexusResult Operation result
+ */
+NexusResult mps_stream_publish(NexusMPSDataStream* stream);
+
+/**
+ * @brief Get a read-only view of what readers should see
+ *
+ * For a double-buffered stream this is the published buffer; otherwise
+ * it is the stream's data. The view borrows the buffer and stays valid
+ * until the stream is published again, resized or destroyed.
+ *
+ * @param stream Stream to view (may be NULL for an empty view)
+ * @param view Receives the view, positioned at the start
+ */
+void mps_stream_view_published(const NexusMPSDataStream* stream, NexusMPSDataStream* view);
+
+/**
+ * @brief Check whether the write side holds the same bytes as the published buffer
+ *
+ * Used to detect a fixed point before publishing. When both buffers carry
+ * a reported content hash, the hashes are compared instead of the bytes.
+ *
+ * @param stream Double-buffered stream
+ * @return bool True if publishing would not change what readers see
+ */
+bool mps_stream_is_unchanged(const NexusMPSDataStream* stream);
+
+/**
+ * @brief Report the content hash of what was written
+ *
+ * The hash is dropped by the next write or clear, so it must be set after
+ * the data is complete. Equal hashes are taken to mean equal contents.
+ *
+ * @param stream Stream whose write side the hash describes
+ * @param hash 64-bit content hash
+ */
+void mps_stream_set_content_hash(NexusMPSDataStream* stream, uint64_t hash);
+
 /**
  * @brief Create a stream map for multi-pass systems
  *
@@ -163,21 +249,68 @@ NexusResult mps_stream_map_add(NexusMPSDataStreamMap* map,
  * @param map Stream map to get from
  * @param source_id Source component ID
  * @param target_id Target component ID
- * @return NexusMPSDataStream* Found stream or NULL if not found
+ * @return NexusMPSDataStream* Found stream, or NULL if not found or the
+ *         index is stale
  */
 NexusMPSDataStream* mps_stream_map_get(const NexusMPSDataStreamMap* map,
                                       const char* source_id,
                                       const char* target_id);
 
+/**
+ * @brief Rebuild the adjacency index after entries were added
+ *
+ * Call this after the last addition. Queries never modify the map, so
+ * they are safe from several threads, but until the index is rebuilt
+ * they find no connections.
+ *
+ * @param map Stream map to index
+ * @return NexusResult Operation result
+ */
+NexusResult mps_stream_map_build_index(NexusMPSDataStreamMap* map);
+
+/**
+ * @brief Get the component index of a component ID
+ *
+ * @param map Stream map to search
+ * @param component_id Component ID (interned or not)
+ * @return size_t Component index, or map->component_count if unknown
+ */
+size_t mps_stream_map_component_index(const NexusMPSDataStreamMap* map, const char* component_id);
+
+/**
+ * @brief Get the connections leaving a component, without allocating
+ *
+ * @param map Stream map with a built index
+ * @param component_index Component index from mps_stream_map_component_index()
+ * @param entries Receives the first entry pointer of the slice
+ * @return size_t Number of entries, 0 while the index is stale
+ */
+size_t mps_stream_map_outgoing(const NexusMPSDataStreamMap* map,
+                               size_t component_index,
+                               MPSStreamMapEntry* const** entries);
+
+/**
+ * @brief Get the connections entering a component, without allocating
+ *
+ * @param map Stream map with a built index
+ * @param component_index Component index from mps_stream_map_component_index()
+ * @param entries Receives the first entry pointer of the slice
+ * @return size_t Number of entries, 0 while the index is stale
+ */
+size_t mps_stream_map_incoming(const NexusMPSDataStreamMap* map,
+                               size_t component_index,
+                               MPSStreamMapEntry* const** entries);
+
 /**
  * @brief Get all streams for a component (as source)
  *
  * @param map Stream map to get from
  * @param source_id Source component ID
- * @param streams Output parameter for streams
- * @param target_ids Output parameter for target component IDs
+ * @param streams Output parameter for streams (array allocated for the caller)
+ * @param target_ids Output parameter for interned target component IDs
  * @param count Output parameter for number of streams
- * @return NexusResult Operation result
+ * @return NexusResult Operation result; NEXUS_INVALID_OPERATION while the
+ *         index is stale
  */
 NexusResult mps_stream_map_get_outgoing(const NexusMPSDataStreamMap* map,
                                        const char* source_id,
@@ -190,10 +323,11 @@ NexusResult mps_stream_map_get_outgoing(const NexusMPSDataStreamMap* map,
  *
  * @param map Stream map to get from
  * @param target_id Target component ID
- * @param streams Output parameter for streams
- * @param source_ids Output parameter for source component IDs
+ * @param streams Output parameter for streams (array allocated for the caller)
+ * @param source_ids Output parameter for interned source component IDs
  * @param count Output parameter for number of streams
- * @return NexusResult Operation result
+ * @return NexusResult Operation result; NEXUS_INVALID_OPERATION while the
+ *         index is stale
  */
 NexusResult mps_stream_map_get_incoming(const NexusMPSDataStreamMap* map,
                                        const char* target_id,
@@ -232,6 +366,15 @@ NexusMPSDataStream* mps_stream_clone(const NexusMPSDataStream* stream);
  */
 void* mps_stream_get_metadata(const NexusMPSDataStream* stream, const char* key);
 
+/**
+ * @brief Get stream metadata by an interned key
+ *
+ * @param stream Stream to get metadata from
+ * @param interned_key Key returned by nexus_intern()
+ * @return void* Metadata value or NULL if not found
+ */
+void* mps_stream_get_metadata_interned(const NexusMPSDataStream* stream, const char* interned_key);
+
 /**
  * @brief Set stream metadata
  *
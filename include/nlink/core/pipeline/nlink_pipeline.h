@@ -12,8 +12,11 @@
  #define NLINK_PIPELINE_H
  
  #include <stdbool.h>
+ #include <stddef.h>
+ #include <stdint.h>
  #include "nlink/core/common/nexus_core.h"
  #include "nlink/core/common/result.h"
+ #include "nlink/core/pipeline/pipeline_arena.h"
  
  #ifdef __cplusplus
  extern "C" {
@@ -31,6 +34,64 @@
  * @brief Pipeline stage function prototype
  */
 typedef NexusResult (*NlinkPipelineStageFunc)(void* input, void* output, void* user_data);
+
+/**
+ * @brief Size-aware pipeline stage function prototype
+ *
+ * The stage reads input_size bytes from input and writes at most
+ * output_capacity bytes to output, storing the number written in
+ * *output_size. If the result does not fit, the stage stores the size it
+ * needs in *output_size and returns NEXUS_PARTIAL_SUCCESS; the pipeline
+ * then grows the buffer and runs the stage again.
+ */
+typedef NexusResult (*NlinkPipelineSizedStageFunc)(const void* input, size_t input_size,
+                                                   void* output, size_t output_capacity,
+                                                   size_t* output_size, void* user_data);
+
+/**
+ * @brief Output size declaration for a size-aware stage
+ *
+ * Returns an upper bound on the output produced for input_size bytes of
+ * input. The bound only sizes the first attempt; a stage that needs more
+ * can still ask for it.
+ */
+typedef size_t (*NlinkPipelineStageSizeFunc)(size_t input_size, void* user_data);
+
+/** Dirty ranges a stage can report before they are merged into one */
+#define NLINK_STAGE_MAX_DIRTY_RANGES 16
+
+/**
+ * @brief Byte range changed by a stage
+ */
+typedef struct NlinkDirtyRange {
+    size_t offset;                  /**< First changed byte */
+    size_t length;                  /**< Number of bytes */
+} NlinkDirtyRange;
+
+/**
+ * @brief Changes reported by a change-tracking stage
+ *
+ * A stage marks the ranges whose bytes it changed, or reports the 64-bit
+ * content hash of the data after it ran (typically a rolling hash it
+ * updates as it writes), or both. Reporting nothing means the stage left
+ * the data as it was.
+ */
+typedef struct NlinkStageChanges {
+    NlinkDirtyRange ranges[NLINK_STAGE_MAX_DIRTY_RANGES]; /**< Changed ranges */
+    size_t range_count;             /**< Number of ranges */
+    bool has_hash;                  /**< Whether hash was reported */
+    uint64_t hash;                  /**< Content hash of the data after the stage */
+} NlinkStageChanges;
+
+/**
+ * @brief Change-tracking pipeline stage function prototype
+ *
+ * The stage edits size bytes of data in place and reports what it
+ * changed through changes. Its output has the size of its input.
+ */
+typedef NexusResult (*NlinkPipelineTrackedStageFunc)(void* data, size_t size,
+                                                     NlinkStageChanges* changes,
+                                                     void* user_data);
  
  /**
   * @brief Pipeline configuration
@@ -41,6 +102,9 @@ typedef NexusResult (*NlinkPipelineStageFunc)(void* input, void* output, void* u
      bool enable_caching;          /**< Enable result caching between stages */
      unsigned max_iterations;      /**< Maximum iterations for multi-pass mode */
      const char* schema_path;      /**< Path to pipeline schema definition */
+     size_t stage_buffer_size;     /**< Bytes read and written by stages that declare no sizes */
+     size_t arena_block_size;      /**< First block size of the per-pipeline arena */
+     bool enable_worklist;         /**< Multi-pass: skip tracked stages whose input did not change */
  } NlinkPipelineConfig;
  
 /**
@@ -48,11 +112,28 @@ typedef NexusResult (*NlinkPipelineStageFunc)(void* input, void* output, void* u
  */
 typedef struct NlinkPipelineStage {
     char* name;                     /**< Stage name */
-    NlinkPipelineStageFunc func;    /**< Stage function */
+    NlinkPipelineStageFunc func;    /**< Stage function, NULL for size-aware stages */
+    NlinkPipelineSizedStageFunc sized_func; /**< Size-aware stage function */
+    NlinkPipelineStageSizeFunc size_func;   /**< Output size declaration, may be NULL */
+    NlinkPipelineTrackedStageFunc tracked_func; /**< Change-tracking stage function */
     void* user_data;                /**< User data for stage function */
     struct NlinkPipelineStage* next; /**< Next stage in the pipeline */
+    
+    /* Statistics for last execution */
+    unsigned last_runs;             /**< Times the stage ran */
+    unsigned last_skipped;          /**< Re-runs skipped because its input did not change */
+    uint64_t ran_at_change;         /**< Change counter when the stage last ran (worklist) */
 } NlinkPipelineStage;
 
+/**
+ * @brief Per-stage statistics for the last execution
+ */
+typedef struct NlinkPipelineStageStats {
+    const char* name;               /**< Stage name */
+    unsigned runs;                  /**< Times the stage ran */
+    unsigned skipped;               /**< Re-runs skipped because its input did not change */
+} NlinkPipelineStageStats;
+
 /**
  * @brief Pipeline implementation
  */
@@ -64,9 +145,16 @@ struct NlinkPipeline {
     unsigned stage_count;           /**< Number of stages */
     NexusContext* ctx;              /**< NexusLink context */
     
+    /* Execution buffers, kept across executions */
+    NlinkArena arena;               /**< Intermediate stage buffers, reset per execution */
+    void* pass_buffers[2];          /**< Multi-pass ping-pong state buffers */
+    size_t pass_capacity[2];        /**< Capacities of pass_buffers */
+    
     /* Statistics for last execution */
     unsigned last_iterations;       /**< Number of iterations in last execution */
     double last_execution_time_ms;  /**< Execution time in milliseconds */
+    size_t last_output_size;        /**< Size of the last execution's output */
+    size_t last_dirty_bytes;        /**< Bytes reported changed by tracked stages */
     bool is_optimized;              /**< Whether the pipeline has been optimized */
 };
 
@@ -103,9 +191,72 @@ struct NlinkPipeline {
                                      NlinkPipelineStageFunc func,
                                      void* user_data);
  
+ /**
+  * @brief Add a size-aware stage to the pipeline
+  * 
+  * @param pipeline Target pipeline
+  * @param name Stage name
+  * @param func Stage function
+  * @param size_func Output size declaration, or NULL to start from the
+  *        larger of the input size and config.stage_buffer_size
+  * @param user_data User data passed to both functions
+  * @return NexusResult Result code
+  */
+ NexusResult nlink_pipeline_add_sized_stage(NlinkPipeline* pipeline,
+                                           const char* name,
+                                           NlinkPipelineSizedStageFunc func,
+                                           NlinkPipelineStageSizeFunc size_func,
+                                           void* user_data);
+ 
+ /**
+  * @brief Add a change-tracking stage to the pipeline
+  * 
+  * When every stage of a multi-pass pipeline tracks its changes, the
+  * stages edit one state buffer in place and convergence is detected from
+  * the reported changes instead of comparing buffers: an iteration in
+  * which no stage changed anything is a fixed point. With
+  * config.enable_worklist set, a stage is also skipped when nothing
+  * changed since it last ran, which assumes its output depends only on
+  * its input. In any other pipeline the stage runs on a copy of its input.
+  * 
+  * @param pipeline Target pipeline
+  * @param name Stage name
+  * @param func Stage function
+  * @param user_data User data passed to the stage function
+  * @return NexusResult Result code
+  */
+ NexusResult nlink_pipeline_add_tracked_stage(NlinkPipeline* pipeline,
+                                             const char* name,
+                                             NlinkPipelineTrackedStageFunc func,
+                                             void* user_data);
+ 
+ /**
+  * @brief Mark a byte range as changed
+  * 
+  * Adjacent and overlapping ranges are merged. Past
+  * NLINK_STAGE_MAX_DIRTY_RANGES ranges, the last one grows to cover the
+  * new range.
+  * 
+  * @param changes Changes passed to the stage
+  * @param offset First changed byte
+  * @param length Number of changed bytes
+  */
+ void nlink_stage_changes_mark(NlinkStageChanges* changes, size_t offset, size_t length);
+ 
+ /**
+  * @brief Report the content hash of the data after the stage
+  * 
+  * @param changes Changes passed to the stage
+  * @param hash 64-bit content hash
+  */
+ void nlink_stage_changes_set_hash(NlinkStageChanges* changes, uint64_t hash);
+ 
  /**
   * @brief Execute the pipeline with the given input and output
   * 
+  * Both buffers are config.stage_buffer_size bytes long. Use
+  * nlink_pipeline_execute_sized() for payloads of any other size.
+  * 
   * @param pipeline Pipeline to execute
   * @param input Input data
   * @param output Output data
@@ -113,6 +264,28 @@ struct NlinkPipeline {
   */
  NexusResult nlink_pipeline_execute(NlinkPipeline* pipeline, void* input, void* output);
  
+ /**
+  * @brief Execute the pipeline over a sized payload
+  * 
+  * Intermediate buffers come from the pipeline's arena, which is reset
+  * at the start of every execution, so repeated executions of the same
+  * workload do not allocate. If the result is larger than
+  * output_capacity, *output_size receives the required size and
+  * NEXUS_PARTIAL_SUCCESS is returned with output untouched.
+  * 
+  * @param pipeline Pipeline to execute
+  * @param input Input data
+  * @param input_size Size of the input in bytes
+  * @param output Output buffer
+  * @param output_capacity Size of the output buffer in bytes
+  * @param output_size Receives the size of the output (can be NULL)
+  * @return NexusResult Result code
+  */
+ NexusResult nlink_pipeline_execute_sized(NlinkPipeline* pipeline,
+                                         const void* input, size_t input_size,
+                                         void* output, size_t output_capacity,
+                                         size_t* output_size);
+ 
  /**
   * @brief Get the actual mode used by the pipeline
   * 
@@ -127,11 +300,15 @@ struct NlinkPipeline {
   * @param pipeline Pipeline to query
   * @param iterations Pointer to store iteration count (can be NULL)
   * @param execution_time_ms Pointer to store execution time in milliseconds (can be NULL)
+  * @param stage_stats Array receiving per-stage statistics in stage order (can be NULL)
+  * @param stage_stats_count Number of entries in stage_stats
   * @return NexusResult Result code
   */
  NexusResult nlink_pipeline_get_stats(const NlinkPipeline* pipeline, 
                                      unsigned* iterations,
-                                     double* execution_time_ms);
+                                     double* execution_time_ms,
+                                     NlinkPipelineStageStats* stage_stats,
+                                     size_t stage_stats_count);
  
  /**
   * @brief Destroy a pipeline and free its resources
@@ -151,4 +328,4 @@ struct NlinkPipeline {
  }
  #endif
  
- #endif /* NLINK_PIPELINE_H */
\ No newline at end of file
+ #endif /* NLINK_PIPELINE_H */
\ No newline at end of file
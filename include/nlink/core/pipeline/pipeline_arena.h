@@ -0,0 +1,108 @@
+/**
+ * @file pipeline_arena.h
+ * @brief Bump arena for per-execution pipeline buffers
+ *
+ * Allocations are carved from the current block by bumping an offset and
+ * are released all at once by nlink_arena_reset(). A reset that finds more
+ * than one block replaces them with a single block covering the high-water
+ * mark, so an arena that is reset between executions of the same workload
+ * stops allocating after the first run.
+ *
+ * Copyright © 2025 OBINexus Computing
+ */
+
+#ifndef NLINK_PIPELINE_ARENA_H
+#define NLINK_PIPELINE_ARENA_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Alignment of every arena allocation */
+#define NLINK_ARENA_ALIGNMENT 16
+
+/** Default size of the first arena block */
+#define NLINK_ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+
+/**
+ * @brief Arena block
+ */
+typedef struct NlinkArenaBlock {
+    struct NlinkArenaBlock* prev;   /**< Previously filled block */
+    size_t capacity;                /**< Usable bytes in data */
+    size_t used;                    /**< Bytes handed out */
+    unsigned char* data;            /**< Aligned start of the usable bytes */
+} NlinkArenaBlock;
+
+/**
+ * @brief Bump arena
+ *
+ * A zero-initialized arena is empty and valid; it uses
+ * NLINK_ARENA_DEFAULT_BLOCK_SIZE as its block size.
+ */
+typedef struct NlinkArena {
+    NlinkArenaBlock* current;       /**< Block allocations are carved from */
+    size_t block_size;              /**< Minimum size of a new block */
+    size_t used;                    /**< Bytes handed out since the last reset */
+    size_t high_water;              /**< Largest used seen at a reset */
+    size_t block_allocations;       /**< Number of blocks ever malloc'd */
+} NlinkArena;
+
+/**
+ * @brief Initialize an empty arena
+ *
+ * @param arena Arena to initialize
+ * @param block_size Minimum block size, 0 for the default
+ */
+void nlink_arena_init(NlinkArena* arena, size_t block_size);
+
+/**
+ * @brief Allocate from the arena
+ *
+ * The memory is aligned to NLINK_ARENA_ALIGNMENT, uninitialized, and valid
+ * until the next reset.
+ *
+ * @param arena Arena to allocate from
+ * @param size Number of bytes
+ * @return void* Allocated memory or NULL if out of memory
+ */
+void* nlink_arena_alloc(NlinkArena* arena, size_t size);
+
+/**
+ * @brief Grow the most recent allocation
+ *
+ * Extends ptr in place when it is the last allocation and its block has
+ * room; otherwise allocates a new region and copies the first old_size
+ * bytes. The old region stays reserved until the next reset.
+ *
+ * @param arena Arena ptr was allocated from
+ * @param ptr Allocation to grow, or NULL
+ * @param old_size Current size of ptr
+ * @param new_size Requested size
+ * @return void* Grown allocation or NULL if out of memory
+ */
+void* nlink_arena_grow(NlinkArena* arena, void* ptr, size_t old_size, size_t new_size);
+
+/**
+ * @brief Release every allocation
+ *
+ * Keeps one block large enough for the high-water mark.
+ *
+ * @param arena Arena to reset
+ */
+void nlink_arena_reset(NlinkArena* arena);
+
+/**
+ * @brief Free all blocks
+ *
+ * @param arena Arena to destroy; it is left empty and valid
+ */
+void nlink_arena_destroy(NlinkArena* arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NLINK_PIPELINE_ARENA_H */
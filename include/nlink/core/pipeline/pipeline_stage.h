@@ -9,7 +9,9 @@
 
 #include "nlink/core/common/nexus_core.h"
 #include "nlink/core/common/nexus_result.h"
+#include "nlink/core/pipeline/pipeline_arena.h"
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -32,23 +34,147 @@ typedef struct {
     NexusResult (*execute)(NexusContext* ctx, NexusBuffer* buffer, void* internal_state);
 } StatefulStage;
 
+/**
+ * @brief One step of a stage chain: a plain or a stateful stage
+ */
+typedef struct {
+    PipelineStage stage;            /**< Plain stage, or NULL for a stateful one */
+    NexusResult (*execute)(NexusContext* ctx, NexusBuffer* buffer, void* internal_state);
+    void* internal_state;           /**< State passed to execute */
+} StageChainEntry;
+
+/**
+ * @brief Flat sequence of stages
+ *
+ * Composing or folding chains copies their entries into one contiguous
+ * array, so a chain built from any tree of compositions runs as a single
+ * loop without recursion or per-hop indirection. A chain has no global
+ * state; chains can be built concurrently from different threads.
+ *
+ * The entries live on the heap, in storage supplied by the caller, or in
+ * an arena. Caller storage never grows; heap and arena chains grow as
+ * needed.
+ */
+typedef struct {
+    StageChainEntry* entries;       /**< Stages in execution order */
+    size_t count;                   /**< Number of stages */
+    size_t capacity;                /**< Capacity of entries */
+    NlinkArena* arena;              /**< Arena entries come from, or NULL */
+    bool owns_entries;              /**< Whether entries is heap memory the chain frees */
+} StageChain;
+
+/**
+ * @brief Initialize an empty chain
+ *
+ * @param chain Chain to initialize
+ * @param storage Caller-owned entries, or NULL to allocate on the heap
+ * @param capacity Number of entries in storage
+ */
+void stage_chain_init(StageChain* chain, StageChainEntry* storage, size_t capacity);
+
+/**
+ * @brief Initialize an empty chain whose entries come from an arena
+ *
+ * The chain is valid until the arena is reset.
+ *
+ * @param chain Chain to initialize
+ * @param arena Arena to allocate entries from
+ */
+void stage_chain_init_arena(StageChain* chain, NlinkArena* arena);
+
+/**
+ * @brief Append a stage
+ *
+ * @param chain Chain to extend
+ * @param stage Stage to append
+ * @return NexusResult Result of the operation
+ */
+NexusResult stage_chain_push(StageChain* chain, PipelineStage stage);
+
+/**
+ * @brief Append a stateful stage
+ *
+ * The chain refers to the stage's state but does not own it.
+ *
+ * @param chain Chain to extend
+ * @param stage Stateful stage to append
+ * @return NexusResult Result of the operation
+ */
+NexusResult stage_chain_push_stateful(StageChain* chain, const StatefulStage* stage);
+
+/**
+ * @brief Append every stage of another chain
+ *
+ * @param chain Chain to extend
+ * @param other Chain to copy from (may be chain itself)
+ * @return NexusResult Result of the operation
+ */
+NexusResult stage_chain_append(StageChain* chain, const StageChain* other);
+
 /**
  * @brief Compose two pipeline stages
  *
+ * Appends a, then b.
+ *
+ * @param chain Chain receiving the stages
  * @param a First stage
  * @param b Second stage
- * @return PipelineStage Composed stage
+ * @return NexusResult Result of the operation
  */
-PipelineStage compose(PipelineStage a, PipelineStage b);
+NexusResult compose(StageChain* chain, PipelineStage a, PipelineStage b);
 
 /**
  * @brief Fold multiple pipeline stages into one
  *
+ * Appends the stages in order.
+ *
+ * @param chain Chain receiving the stages
  * @param stages Array of stages
  * @param count Number of stages
- * @return PipelineStage Combined stage
+ * @return NexusResult Result of the operation
+ */
+NexusResult fold(StageChain* chain, PipelineStage* stages, size_t count);
+
+/**
+ * @brief Compose two chains into a flat one
+ *
+ * @param chain Chain receiving the stages of a, then those of b
+ * @param a First chain
+ * @param b Second chain
+ * @return NexusResult Result of the operation
+ */
+NexusResult stage_chain_compose(StageChain* chain, const StageChain* a, const StageChain* b);
+
+/**
+ * @brief Fold several chains into a flat one
+ *
+ * @param chain Chain receiving the stages of every chain in order
+ * @param chains Chains to fold
+ * @param count Number of chains
+ * @return NexusResult Result of the operation
+ */
+NexusResult stage_chain_fold(StageChain* chain, const StageChain* chains, size_t count);
+
+/**
+ * @brief Run every stage of a chain on a buffer
+ *
+ * Stops at the first stage that does not succeed and returns its result.
+ *
+ * @param chain Chain to run
+ * @param ctx Context for execution
+ * @param buffer Buffer containing input/output data
+ * @return NexusResult Result of the last stage run
+ */
+NexusResult stage_chain_execute(const StageChain* chain, NexusContext* ctx, NexusBuffer* buffer);
+
+/**
+ * @brief Free a chain's heap entries
+ *
+ * Caller storage and arena memory are left alone. The chain is left empty.
+ *
+ * @param chain Chain to destroy
  */
-PipelineStage fold(PipelineStage* stages, size_t count);
+void stage_chain_destroy(StageChain* chain);
 
 /**
  * @brief Create a stateful stage
@@ -91,4 +217,4 @@ void free_stateful_stage(
 }
 #endif
 
-#endif /* NLINK_PIPELINE_STAGE_H */
\ No newline at end of file
+#endif /* NLINK_PIPELINE_STAGE_H */
\ No newline at end of file
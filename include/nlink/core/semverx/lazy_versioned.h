@@ -24,7 +24,41 @@ typedef struct {
 	time_t unload_timeout_sec;
 } NexusVersionedLazyConfig;
 
+// Defined in lazy_versioned.c; the component loader sets nexus_handle_registry
 extern NexusVersionedLazyConfig nexus_versioned_lazy_config;
 extern NexusHandleRegistry* nexus_handle_registry;
 
+// Per-component usage record. Holds an atomic last-used timestamp and a
+// live reference count, so resolvers update it without taking any lock.
+// Records are owned by the idle tracker and stay valid until
+// nexus_component_usage_cleanup(). Register a component before adding its
+// symbols: versioned_symbol_table_add() binds each symbol to its record,
+// and versioned resolution touches and pins it.
+typedef struct NexusComponentUsage NexusComponentUsage;
+
+// Create (or reactivate) the usage record for a loaded component library
+NexusComponentUsage* nexus_component_usage_register(const char* component_id, void* handle);
+
+// Find the usage record of a component, or NULL if it was never registered
+NexusComponentUsage* nexus_component_usage_find(const char* component_id);
+
+// Record a use of the component now. Lock-free.
+void nexus_component_usage_touch(NexusComponentUsage* usage);
+
+// Pin the component while its symbols are in use; fails once the
+// component is being unloaded. Lock-free.
+bool nexus_component_usage_acquire(NexusComponentUsage* usage);
+
+// Drop a pin taken with nexus_component_usage_acquire()
+void nexus_component_usage_release(NexusComponentUsage* usage);
+
+// Number of live pins on a component
+long nexus_component_usage_live_refs(const NexusComponentUsage* usage);
+
+// Whether the component is loaded and not being unloaded
+bool nexus_component_usage_active(const NexusComponentUsage* usage);
+
+// Free every usage record and the idle queue
+void nexus_component_usage_cleanup(void);
+
 #endif // NLINK_CORE_VERSIONING_LAZY_VERSIONED_H
@@ -19,30 +19,6 @@
  extern "C" {
  #endif
  
- /**
-  * @brief Configuration for versioned lazy loading
-  */
- typedef struct {
-     bool auto_unload;                  /**< Whether to automatically unload unused libraries */
-     time_t unload_timeout_sec;         /**< Timeout in seconds for unloading unused libraries */
-     bool track_usage;                  /**< Whether to track usage of symbols */
- } NexusVersionedLazyConfig;
- 
- /**
-  * @brief Get the versioned lazy loading configuration
-  * 
-  * @return Pointer to the configuration structure
-  */
- NexusVersionedLazyConfig* nexus_versioned_lazy_config(void);
- 
- /**
-  * @brief Handle registry for dynamically loaded components
-  * 
-  * @param ctx The NexusLink context
-  * @return NexusResult Result code
-  */
- NexusResult nexus_handle_registry(NexusContext* ctx);
- 
  /**
   * @brief Command implementation for stats command
   * 
@@ -2,6 +2,7 @@
 #define NEXUS_VERSION_H
 
 #include "nlink/core/common/types.h"
+#include "nlink/core/semverx/semver.h"
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -90,6 +91,27 @@ NexusVersionConstraint* nexus_version_constraint_parse(const char* constraint_st
  */
 bool nexus_version_satisfies(const NexusVersion* version, const NexusVersionConstraint* constraint);
 
+/**
+ * @brief Pack a version into its 64-bit integer form
+ * 
+ * @param version Version to pack
+ * @param packed Receives the packed version, ordered like nexus_version_compare()
+ *               (wildcard versions pack to 0)
+ * @return bool True if the packing is exact; packed keys of versions that
+ *              did not pack exactly must not be compared
+ */
+bool nexus_version_pack(const NexusVersion* version, SemVerPacked* packed);
+
+/**
+ * @brief Compile a constraint into packed version ranges
+ * 
+ * @param constraint Constraint to compile
+ * @param compiled Receives the compiled ranges; compiled->exact is false
+ *                 if the bound did not pack exactly
+ * @return bool True on success, false if the constraint is invalid
+ */
+bool nexus_version_constraint_compile(const NexusVersionConstraint* constraint, SemVerConstraint* compiled);
+
 /**
  * @brief Check if a version string satisfies a constraint string
  * 
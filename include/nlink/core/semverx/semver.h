@@ -31,7 +31,17 @@ SemVer* semver_parse(const char* version_str);
 // Returns: -1 if a < b, 0 if a == b, 1 if a > b
 int semver_compare(const SemVer* a, const SemVer* b);
 
+// Compare prerelease strings by SemVer precedence: dot-separated
+// identifiers left to right, numeric ones by value and below alphanumeric
+// ones, and a shorter list of equal identifiers first (alpha < alpha.1)
+// Returns: -1 if a < b, 0 if a == b, 1 if a > b
+int semver_prerelease_compare(const char* a, const char* b);
+
 // Check if a version satisfies a constraint
+// Compiles the constraint on the stack and falls back to a full-precision
+// comparison when the version or the constraint does not pack exactly;
+// callers that check the same constraint repeatedly should keep a
+// SemVerConstraint instead.
 // Examples of constraints:
 //   - "1.2.3"    : Exact match
 //   - ">1.2.3"   : Greater than
@@ -46,4 +56,65 @@ bool semver_satisfies(const char* version, const char* constraint);
 // Free a semantic version structure
 void semver_free(SemVer* ver);
 
+// Packed version: 16 bits each of major, minor, patch and a prerelease
+// ordinal, so packed versions order the same way as the versions they
+// encode and can be compared as plain integers.
+typedef uint64_t SemVerPacked;
+
+#define SEMVER_PACKED_MAX UINT64_MAX
+
+// Prerelease ordinal of a release version; prereleases always sort below it
+#define SEMVER_RELEASE_ORDINAL 0xFFFF
+
+// Maximum number of "||" alternatives in a compiled constraint; a
+// constraint with more is compiled with exact set to false
+#define SEMVER_MAX_RANGES 4
+
+// Inclusive range of packed versions
+typedef struct {
+    SemVerPacked min;
+    SemVerPacked max;
+} SemVerRange;
+
+// Compiled constraint: a version satisfies it if it lies in any of the ranges.
+// A constraint with no ranges matches nothing. When exact is false a bound
+// did not pack exactly and the ranges are only an approximation; check
+// such constraints with semver_satisfies.
+typedef struct {
+    uint32_t count;
+    bool exact;
+    SemVerRange ranges[SEMVER_MAX_RANGES];
+} SemVerConstraint;
+
+// Pack version components. Components are clamped to 0..65535. The
+// prerelease ordinal ranks the tag by its first letter (so alpha < beta < rc)
+// and then by its first numeric identifier (alpha.2 < alpha.10). Packing is
+// exact only for components up to 65535 and for a prerelease that is a
+// single number below 2047 or one of alpha, beta, dev, pre and rc,
+// optionally followed by such a number; *exact (if not NULL) says whether
+// it was.
+SemVerPacked semver_pack_parts(long major, long minor, long patch, const char* prerelease, bool* exact);
+
+// Parse a version string straight into its packed form without allocating.
+// Missing minor/patch components default to 0; "*" and "latest" pack to 0.
+// Returns false if the string is not a version or does not pack exactly,
+// in which case packed keys must not be compared.
+bool semver_pack(const char* version, SemVerPacked* packed);
+
+// Compile a constraint string (same syntax as semver_satisfies) into packed
+// ranges. Space-separated comparators are intersected (">=1.2.0 <2.0.0") and
+// "||" separates alternatives. Returns false on a syntax error.
+bool semver_constraint_compile(const char* constraint, SemVerConstraint* compiled);
+
+// Check a packed version against a compiled constraint; one unsigned
+// comparison per range, no allocation
+static inline bool semver_constraint_matches(const SemVerConstraint* compiled, SemVerPacked version) {
+    bool match = false;
+    for (uint32_t i = 0; i < compiled->count; i++) {
+        match |= (version - compiled->ranges[i].min) <=
+                 (compiled->ranges[i].max - compiled->ranges[i].min);
+    }
+    return match;
+}
+
 #endif // NEXUS_SEMVER_H
\ No newline at end of file
@@ -27,10 +27,17 @@ typedef struct NexusPipelineComponentConfig {
     const char* version_constraint;    /**< Version constraint */
     void* component_config;            /**< Component-specific configuration */
     bool optional;                     /**< Whether this component is optional */
+    const char** dependencies;         /**< IDs of components whose output this one consumes */
+    size_t dependency_count;           /**< Number of dependencies */
 } NexusPipelineComponentConfig;
 
 /**
  * @brief Pipeline configuration structure
+ *
+ * When no component declares dependencies, each component depends on the
+ * one before it. Once any component declares them, the declared edges form
+ * the whole graph and components without dependencies read the pipeline
+ * input.
  */
 typedef struct NexusPipelineConfig {
     const char* pipeline_id;                                /**< Pipeline identifier */
@@ -51,6 +51,34 @@ typedef struct NexusMissingDependency {
     bool is_optional;                    /**< Whether the dependency is optional */
 } NexusMissingDependency;
 
+/**
+ * @brief Execution schedule derived from a dependency graph
+ *
+ * Nodes are indices into the component order the schedule was built for.
+ * Edges are stored in compressed form: the dependencies of node i are
+ * dependencies[dependency_offsets[i] .. dependency_offsets[i + 1]), and
+ * likewise for dependents. A node is ready once all of its dependencies
+ * have completed, so its dependency count doubles as the initial ready
+ * count for a scheduler.
+ *
+ * Nodes are also grouped into level sets: roots are level 0 and every
+ * other node sits one level above its deepest dependency. Nodes in the
+ * same level never depend on each other, and level_count is the length
+ * of the critical path in components.
+ */
+typedef struct NexusDependencySchedule {
+    size_t node_count;                   /**< Number of nodes */
+    size_t* dependency_offsets;          /**< node_count + 1 offsets into dependencies */
+    size_t* dependencies;                /**< Dependency node indices, in declaration order */
+    size_t* dependent_offsets;           /**< node_count + 1 offsets into dependents */
+    size_t* dependents;                  /**< Dependent node indices, in ascending order */
+    size_t* levels;                      /**< Level of each node */
+    size_t* level_offsets;               /**< level_count + 1 offsets into level_nodes */
+    size_t* level_nodes;                 /**< Nodes grouped by level, ascending within a level */
+    size_t level_count;                  /**< Number of levels (critical path length) */
+    size_t max_level_width;              /**< Number of nodes in the widest level */
+} NexusDependencySchedule;
+
 /**
  * @brief Create a dependency graph from component metadata
  *
@@ -89,6 +117,40 @@ NexusResult sps_check_missing_dependencies(NexusContext* ctx,
                                           NexusMissingDependency** missing_deps,
                                           size_t* missing_count);
 
+/**
+ * @brief Build an execution schedule from a dependency graph
+ *
+ * Dependencies on components missing from the order are ignored; report
+ * them with sps_check_missing_dependencies().
+ *
+ * @param ctx NexusLink context
+ * @param graph Dependency graph
+ * @param order Component IDs that schedule nodes index, or NULL for graph node order
+ * @param order_count Number of IDs in order (ignored when order is NULL)
+ * @param schedule Output parameter for the new schedule
+ * @return NexusResult NEXUS_DEPENDENCY_CYCLE if the graph has a cycle
+ */
+NexusResult sps_build_dependency_schedule(NexusContext* ctx,
+                                         NexusDependencyGraph* graph,
+                                         const char** order,
+                                         size_t order_count,
+                                         NexusDependencySchedule** schedule);
+
+/**
+ * @brief Create a schedule in which each node depends on the one before it
+ *
+ * @param node_count Number of nodes
+ * @return NexusDependencySchedule* New schedule or NULL on failure
+ */
+NexusDependencySchedule* sps_create_sequential_schedule(size_t node_count);
+
+/**
+ * @brief Free an execution schedule
+ *
+ * @param schedule Schedule to free
+ */
+void sps_free_dependency_schedule(NexusDependencySchedule* schedule);
+
 /**
  * @brief Free dependency graph resources
  *
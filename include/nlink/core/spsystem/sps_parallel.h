@@ -0,0 +1,123 @@
+/**
+ * @file sps_parallel.h
+ * @brief Dependency-parallel execution for single-pass systems
+ *
+ * Runs the components of one input concurrently wherever the pipeline's
+ * dependency schedule allows it. Each component is submitted to a thread
+ * pool as soon as its last dependency completes; workers keep the
+ * components they make ready on their own deque and steal from each
+ * other when they run dry.
+ *
+ * Data follows the declared edges: a component with no dependencies reads
+ * the pipeline input, one with a single dependency reads that
+ * dependency's output, and one with several reads their outputs
+ * concatenated in declaration order. The outputs of the components
+ * nothing depends on are concatenated, in pipeline order, into the
+ * pipeline output. The result is the same for any number of workers.
+ *
+ * Copyright © 2025 OBINexus Computing
+ */
+
+#ifndef NLINK_SPS_PARALLEL_H
+#define NLINK_SPS_PARALLEL_H
+
+#include "nlink/core/common/nexus_core.h"
+#include "nlink/core/common/result.h"
+#include "nlink/spsystem/sps_pipeline.h"
+#include "nlink/spsystem/sps_stream.h"
+#include "nlink/core/threading/thread_pool.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief A pipeline bound to a thread pool (opaque)
+ */
+typedef struct NexusParallelExecution NexusParallelExecution;
+
+/**
+ * @brief Parallelism report for the last execution
+ *
+ * total_work_ms / critical_path_ms bounds the speedup any number of
+ * workers could reach on this input; compare it with the measured
+ * speedup to tell a narrow graph from an under-used pool.
+ */
+typedef struct NexusParallelStats {
+    size_t component_count;        /**< Components in the schedule */
+    size_t level_count;            /**< Critical path length in components */
+    size_t max_level_width;        /**< Components in the widest level */
+    size_t worker_count;           /**< Workers in the pool */
+    double total_work_ms;          /**< Sum of component execution times */
+    double critical_path_ms;       /**< Longest dependency chain by measured time */
+    double parallelism;            /**< total_work_ms / critical_path_ms */
+    double wall_ms;                /**< Elapsed time of the execution */
+    size_t steals;                 /**< Tasks stolen in the pool during the execution */
+} NexusParallelStats;
+
+/**
+ * @brief Bind a pipeline to a thread pool
+ *
+ * Initializes the pipeline if needed. With a worker count of 0 the
+ * components run on the shared pool (nlink_thread_pool_shared()), sized
+ * by the threading configuration; otherwise the execution starts a
+ * private pool with that many workers, capped at the widest level. On
+ * the shared pool, steal counts include other users' tasks.
+ *
+ * The pipeline must not be executed or modified by other means until the
+ * execution is destroyed. Component processing functions and the
+ * pipeline error handler are called from the pool's threads,
+ * concurrently for independent components.
+ *
+ * @param ctx NexusLink context
+ * @param pipeline Pipeline to run
+ * @param worker_count Workers of a private pool, or 0 to use the shared pool
+ * @return NexusParallelExecution* New execution or NULL on failure
+ */
+NexusParallelExecution* sps_parallel_start(NexusContext* ctx,
+                                          NexusPipeline* pipeline,
+                                          size_t worker_count);
+
+/**
+ * @brief Run one input through the pipeline
+ *
+ * Blocks until every component has run. A stream read by several
+ * components is handed to each as a read-only view of its data without
+ * its metadata. When a component fails and the pipeline does not allow
+ * partial processing, components that have not started yet are skipped.
+ * Failures reach the pipeline's error handler on the calling thread, in
+ * pipeline order, once every component has finished.
+ * Must not be called concurrently on the same execution.
+ *
+ * @param execution Running execution
+ * @param input Input data stream
+ * @param output Output data stream
+ * @return NexusResult The first component failure, if any
+ */
+NexusResult sps_parallel_execute(NexusParallelExecution* execution,
+                                NexusDataStream* input,
+                                NexusDataStream* output);
+
+/**
+ * @brief Get the parallelism report for the last execution
+ *
+ * @param execution Execution
+ * @param stats Receives the report
+ * @return NexusResult Operation result
+ */
+NexusResult sps_parallel_get_stats(const NexusParallelExecution* execution,
+                                  NexusParallelStats* stats);
+
+/**
+ * @brief Free the execution and stop its private pool, if any
+ *
+ * @param execution Execution to destroy
+ */
+void sps_parallel_destroy(NexusParallelExecution* execution);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NLINK_SPS_PARALLEL_H */
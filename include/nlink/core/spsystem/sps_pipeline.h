@@ -14,6 +14,7 @@
 #include "nlink/core/common/nexus_core.h"
 #include "nlink/core/common/result.h"
 #include "nlink/spsystem/sps_config.h"
+#include "nlink/spsystem/sps_dependency.h"
 #include "nlink/spsystem/sps_stream.h"
 #include <stdbool.h>
 
@@ -34,6 +35,17 @@ typedef NexusResult (*NexusProcessFunc)(NexusPipelineComponent* component,
                                        NexusDataStream* input,
                                        NexusDataStream* output);
 
+/**
+ * @brief Batched component processing function
+ *
+ * Processes @p count input/output stream pairs in one call; inputs[i] is
+ * processed into outputs[i].
+ */
+typedef NexusResult (*NexusProcessBatchFunc)(NexusPipelineComponent* component,
+                                            NexusDataStream** inputs,
+                                            NexusDataStream** outputs,
+                                            size_t count);
+
 /**
  * @brief Pipeline error handler
  */
@@ -49,10 +61,12 @@ struct NexusPipelineComponent {
     const char* component_id;            /**< Component identifier */
     NexusComponent* component;           /**< Loaded component */
     NexusProcessFunc process_func;       /**< Processing function */
+    NexusProcessBatchFunc process_batch_func; /**< Batched processing function (optional) */
     void* component_state;               /**< Component-specific state */
     NexusResult last_result;             /**< Last execution result */
     bool is_initialized;                 /**< Whether component is initialized */
     double last_execution_time_ms;       /**< Last execution time in milliseconds */
+    bool process_in_place;               /**< Receives one stream as both input and output */
 };
 
 /**
@@ -66,6 +80,10 @@ struct NexusPipeline {
     bool is_initialized;                 /**< Whether pipeline is initialized */
     NexusPipelineErrorHandler error_handler; /**< Error handler function */
     void* user_data;                     /**< User-defined data */
+    NexusDataStream** stream_ring[2];    /**< Reusable intermediate streams per input, ping-ponged between stages */
+    size_t stream_ring_size;             /**< Number of streams in each ring slot */
+    char* stream_format;                 /**< Format of the first intermediate stream */
+    NexusDependencySchedule* schedule;   /**< Dependency edges between components, indexed like components */
 };
 
 /**
@@ -89,6 +107,10 @@ NexusResult sps_pipeline_initialize(NexusContext* ctx, NexusPipeline* pipeline);
 /**
  * @brief Execute the pipeline with input data
  *
+ * Components run one after another in dependency order, each reading the
+ * previous one's output. To follow declared fan-out and fan-in edges and
+ * run independent components concurrently, use sps_parallel_execute().
+ *
  * @param ctx NexusLink context
  * @param pipeline Pipeline to execute
  * @param input Input data stream
@@ -100,6 +122,27 @@ NexusResult sps_pipeline_execute(NexusContext* ctx,
                                 NexusDataStream* input, 
                                 NexusDataStream* output);
 
+/**
+ * @brief Execute the pipeline over a batch of inputs
+ *
+ * Each component processes the whole batch before the next component
+ * runs, through its batched processing function when it exports one
+ * ("<component_id>_process_batch") and its per-item function otherwise.
+ * inputs[i] is processed into outputs[i].
+ *
+ * @param ctx NexusLink context
+ * @param pipeline Pipeline to execute
+ * @param inputs Input data streams
+ * @param outputs Output data streams
+ * @param count Number of input/output pairs
+ * @return NexusResult Operation result (the first failure, if any)
+ */
+NexusResult sps_pipeline_execute_batch(NexusContext* ctx, 
+                                      NexusPipeline* pipeline, 
+                                      NexusDataStream** inputs, 
+                                      NexusDataStream** outputs,
+                                      size_t count);
+
 /**
  * @brief Clean up pipeline resources
  *
@@ -120,6 +163,9 @@ NexusPipelineComponent* sps_pipeline_get_component(NexusPipeline* pipeline, cons
 /**
  * @brief Add a component to the pipeline dynamically
  *
+ * Adding or removing components replaces the pipeline's schedule with a
+ * sequential one in component order.
+ *
  * @param ctx NexusLink context
  * @param pipeline Pipeline to modify
  * @param component_id Component ID to add
@@ -143,6 +189,22 @@ NexusResult sps_pipeline_remove_component(NexusContext* ctx,
                                          NexusPipeline* pipeline, 
                                          const char* component_id);
 
+/**
+ * @brief Mark a component as processing in place
+ *
+ * An in-place component is handed the same stream as input and output and
+ * edits it directly (or leaves it untouched, for pass-through stages), so
+ * its data is forwarded to the next component without a copy.
+ *
+ * @param pipeline Pipeline to modify
+ * @param component_id Component ID
+ * @param in_place Whether the component processes in place
+ * @return NexusResult Operation result
+ */
+NexusResult sps_pipeline_set_component_in_place(NexusPipeline* pipeline,
+                                               const char* component_id,
+                                               bool in_place);
+
 /**
  * @brief Set pipeline-level error handler
  *
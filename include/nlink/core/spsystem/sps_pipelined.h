@@ -0,0 +1,164 @@
+/**
+ * @file sps_pipelined.h
+ * @brief Pipelined multi-threaded execution for single-pass systems
+ *
+ * Runs every component of a pipeline on its own worker thread so that
+ * consecutive inputs overlap: while component N processes item k,
+ * component N+1 processes item k-1. Stages are connected by bounded
+ * single-producer/single-consumer queues of stream handles; a full queue
+ * blocks the stage feeding it, and completed items come out in
+ * submission order.
+ *
+ * Copyright © 2025 OBINexus Computing
+ */
+
+#ifndef NLINK_SPS_PIPELINED_H
+#define NLINK_SPS_PIPELINED_H
+
+#include "nlink/core/common/nexus_core.h"
+#include "nlink/core/common/result.h"
+#include "nlink/spsystem/sps_pipeline.h"
+#include "nlink/spsystem/sps_stream.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Default capacity of each inter-stage queue
+ */
+#define SPS_PIPELINED_DEFAULT_QUEUE_CAPACITY 16
+
+/**
+ * @brief A running pipelined execution (opaque)
+ */
+typedef struct NexusPipelinedExecution NexusPipelinedExecution;
+
+/**
+ * @brief Per-stage statistics for tuning queue capacity and stage balance
+ */
+typedef struct NexusPipelinedStageStats {
+    const char* component_id;      /**< Component run by the stage */
+    size_t items_processed;        /**< Items the stage has finished */
+    size_t queue_depth;            /**< Items currently waiting in the stage's input queue */
+    size_t max_queue_depth;        /**< Highest input queue depth seen */
+    size_t queue_capacity;         /**< Capacity of the stage's input queue */
+    double busy_ms;                /**< Time spent processing items */
+    double input_stall_ms;         /**< Time spent waiting for input (stage starved) */
+    double output_stall_ms;        /**< Time spent waiting on a full output queue (back-pressure) */
+} NexusPipelinedStageStats;
+
+/**
+ * @brief Start workers for a pipeline
+ *
+ * Initializes the pipeline if needed and starts one worker per loaded
+ * component. The pipeline must not be executed or modified by other
+ * means until the execution is destroyed. Component processing functions
+ * and the pipeline error handler are called from the worker threads.
+ *
+ * @param ctx NexusLink context
+ * @param pipeline Pipeline to run
+ * @param queue_capacity Capacity of each inter-stage queue (0 for the default)
+ * @return NexusPipelinedExecution* New execution or NULL on failure
+ */
+NexusPipelinedExecution* sps_pipelined_start(NexusContext* ctx,
+                                            NexusPipeline* pipeline,
+                                            size_t queue_capacity);
+
+/**
+ * @brief Submit an input for processing
+ *
+ * Blocks while the first stage's queue is full. Both streams belong to
+ * the pipeline until they are returned by sps_pipelined_next(). Must be
+ * called from a single producer thread.
+ *
+ * @param execution Running execution
+ * @param input Input data stream
+ * @param output Output data stream
+ * @return NexusResult Operation result
+ */
+NexusResult sps_pipelined_submit(NexusPipelinedExecution* execution,
+                                NexusDataStream* input,
+                                NexusDataStream* output);
+
+/**
+ * @brief Wait for the next completed item, in submission order
+ *
+ * Must be called from a single consumer thread, which may differ from
+ * the producer. Keep draining results while submitting: a producer
+ * blocked on a full pipeline only makes progress when items are taken.
+ *
+ * @param execution Running execution
+ * @param input Receives the item's input stream (may be NULL)
+ * @param output Receives the item's output stream (may be NULL)
+ * @param item_result Receives the item's first component failure, or NEXUS_SUCCESS (may be NULL)
+ * @return NexusResult NEXUS_SUCCESS, or NEXUS_NOT_FOUND once finished and drained
+ */
+NexusResult sps_pipelined_next(NexusPipelinedExecution* execution,
+                              NexusDataStream** input,
+                              NexusDataStream** output,
+                              NexusResult* item_result);
+
+/**
+ * @brief Run a set of inputs through the pipeline from the calling thread
+ *
+ * Submits the inputs and collects their results, alternating between the
+ * two so the pipeline never stalls on the caller.
+ *
+ * @param execution Running execution
+ * @param inputs Input data streams
+ * @param outputs Output data streams
+ * @param count Number of input/output pairs
+ * @return NexusResult The first item failure, if any
+ */
+NexusResult sps_pipelined_execute(NexusPipelinedExecution* execution,
+                                 NexusDataStream** inputs,
+                                 NexusDataStream** outputs,
+                                 size_t count);
+
+/**
+ * @brief Signal that no more inputs will be submitted
+ *
+ * Workers exit once the items already submitted have passed through.
+ *
+ * @param execution Running execution
+ */
+void sps_pipelined_finish(NexusPipelinedExecution* execution);
+
+/**
+ * @brief Get the number of stages (loaded components)
+ *
+ * @param execution Running execution
+ * @return size_t Number of stages
+ */
+size_t sps_pipelined_get_stage_count(const NexusPipelinedExecution* execution);
+
+/**
+ * @brief Get statistics for a stage
+ *
+ * Can be called while the execution is running.
+ *
+ * @param execution Running execution
+ * @param stage Stage index, in pipeline order
+ * @param stats Receives the statistics
+ * @return NexusResult Operation result
+ */
+NexusResult sps_pipelined_get_stage_stats(const NexusPipelinedExecution* execution,
+                                         size_t stage,
+                                         NexusPipelinedStageStats* stats);
+
+/**
+ * @brief Stop the workers and free the execution
+ *
+ * Items still in flight are finished and discarded.
+ *
+ * @param execution Execution to destroy
+ */
+void sps_pipelined_destroy(NexusPipelinedExecution* execution);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NLINK_SPS_PIPELINED_H */
@@ -13,6 +13,7 @@
 
 #include "nlink/core/common/nexus_core.h"
 #include "nlink/core/common/result.h"
+#include "nlink/core/symbols/metadata_store.h"
 #include <stddef.h>
 #include <stdbool.h>
 
@@ -23,20 +24,44 @@ extern "C" {
 /**
  * @brief Function to free metadata
  */
-typedef void (*StreamMetadataFreeFunc)(void* metadata);
+typedef NexusMetadataFreeFunc StreamMetadataFreeFunc;
 
 /**
  * @brief Stream metadata entry
  */
-typedef struct StreamMetadataEntry {
-    char* key;                      /**< Metadata key */
-    void* value;                    /**< Metadata value */
-    StreamMetadataFreeFunc free_func; /**< Function to free value */
-    struct StreamMetadataEntry* next; /**< Next entry in the list */
-} StreamMetadataEntry;
+typedef NexusMetadataEntry StreamMetadataEntry;
+
+/**
+ * @brief Storage behind a data stream
+ */
+typedef enum NexusStreamBacking {
+    NEXUS_STREAM_CONTIGUOUS = 0,    /**< One malloc'd buffer */
+    NEXUS_STREAM_CHUNKED,           /**< List of fixed chunks, appends never move bytes */
+    NEXUS_STREAM_MAPPED             /**< Read-only memory mapping of a file */
+} NexusStreamBacking;
+
+/**
+ * @brief One contiguous piece of a stream's payload
+ */
+typedef struct NexusStreamSegment {
+    const void* base;               /**< First byte of the segment */
+    size_t length;                  /**< Segment length in bytes */
+} NexusStreamSegment;
+
+/** Chunk list of a chunked stream (opaque) */
+typedef struct NexusStreamChunks NexusStreamChunks;
+
+/** Shared file mapping of a mapped stream (opaque) */
+typedef struct NexusStreamMapping NexusStreamMapping;
 
 /**
  * @brief Data stream for passing data between components
+ *
+ * @c data is valid whenever the payload is contiguous: always for
+ * contiguous and mapped streams, and for chunked streams holding at most
+ * one chunk. Otherwise it is NULL; use sps_stream_read(),
+ * sps_stream_get_segments() or sps_stream_flatten(). The bytes of a
+ * mapped stream are read-only until the stream is first written.
  */
 typedef struct NexusDataStream {
     void* data;                     /**< Data buffer */
@@ -44,8 +69,11 @@ typedef struct NexusDataStream {
     size_t capacity;                /**< Total buffer capacity */
     size_t position;                /**< Current read/write position */
     const char* format;             /**< Data format identifier */
-    StreamMetadataEntry* metadata;  /**< Linked list of metadata entries */
+    NexusMetadataStore metadata;    /**< Metadata entries */
     bool owns_data;                 /**< Whether the stream owns the data buffer */
+    NexusStreamBacking backing;     /**< Storage kind */
+    NexusStreamChunks* chunks;      /**< Chunk list (chunked streams) */
+    NexusStreamMapping* mapping;    /**< Shared file mapping (mapped streams) */
 } NexusDataStream;
 
 /**
@@ -66,9 +94,37 @@ NexusDataStream* sps_stream_create(size_t initial_capacity);
  */
 NexusDataStream* sps_stream_create_from_data(const void* data, size_t size, const char* format);
 
+/**
+ * @brief Create a chunked data stream
+ *
+ * Writes append to a list of chunks instead of reallocating one buffer,
+ * so bytes already written never move. Clones share chunks and copy a
+ * chunk only when one side overwrites it.
+ *
+ * @param chunk_size Minimum chunk size, 0 for the default
+ * @return NexusDataStream* New stream or NULL on failure
+ */
+NexusDataStream* sps_stream_create_chunked(size_t chunk_size);
+
+/**
+ * @brief Create a data stream backed by a read-only mapping of a file
+ *
+ * The file is not copied. Clones share the mapping; the first write to a
+ * stream copies its bytes into a private buffer.
+ *
+ * @param path File to map
+ * @param format Data format identifier
+ * @param result Optional output for the failure reason
+ * @return NexusDataStream* New stream or NULL on failure
+ */
+NexusDataStream* sps_stream_create_from_file(const char* path, const char* format, NexusResult* result);
+
 /**
  * @brief Resize a data stream
  *
+ * A chunked stream reserves the extra space in a new tail chunk. A mapped
+ * stream is first copied into a private buffer.
+ *
  * @param stream Stream to resize
  * @param new_capacity New buffer capacity
  * @return NexusResult Operation result
@@ -96,6 +152,45 @@ NexusResult sps_stream_write(NexusDataStream* stream, const void* data, size_t s
  */
 NexusResult sps_stream_read(NexusDataStream* stream, void* buffer, size_t size, size_t* bytes_read);
 
+/**
+ * @brief List the contiguous pieces of a stream's payload
+ *
+ * Suitable for scatter-gather I/O. The segments stay valid until the
+ * stream is next modified.
+ *
+ * @param stream Stream to inspect
+ * @param segments Output array, may be NULL to count only
+ * @param max_segments Capacity of the output array
+ * @return size_t Number of segments in the stream
+ */
+size_t sps_stream_get_segments(const NexusDataStream* stream,
+                              NexusStreamSegment* segments,
+                              size_t max_segments);
+
+/**
+ * @brief Make a stream's payload contiguous
+ *
+ * Coalesces the chunks of a chunked stream into one, which copies the
+ * payload once. Free for the other backings and for chunked streams that
+ * are already contiguous.
+ *
+ * @param stream Stream to flatten
+ * @return NexusResult Operation result
+ */
+NexusResult sps_stream_flatten(NexusDataStream* stream);
+
+/**
+ * @brief Replace a stream's data with a copy of another stream's data
+ *
+ * Works for any pair of backings. The position of @p dst is rewound;
+ * format and metadata are left alone.
+ *
+ * @param dst Stream to overwrite
+ * @param src Stream to copy from
+ * @return NexusResult Operation result
+ */
+NexusResult sps_stream_copy_data(NexusDataStream* dst, const NexusDataStream* src);
+
 /**
  * @brief Get stream metadata
  *
@@ -105,6 +200,18 @@ NexusResult sps_stream_read(NexusDataStream* stream, void* buffer, size_t size,
  */
 void* sps_stream_get_metadata(const NexusDataStream* stream, const char* key);
 
+/**
+ * @brief Get stream metadata by an interned key
+ *
+ * Skips the intern lookup of sps_stream_get_metadata(); for keys queried
+ * on every message, intern them once with nexus_intern().
+ *
+ * @param stream Stream to get metadata from
+ * @param interned_key Key returned by nexus_intern()
+ * @return void* Metadata value or NULL if not found
+ */
+void* sps_stream_get_metadata_interned(const NexusDataStream* stream, const char* interned_key);
+
 /**
  * @brief Set stream metadata
  *
@@ -123,6 +230,16 @@ NexusResult sps_stream_set_metadata(NexusDataStream* stream, const char* key, vo
  */
 void sps_stream_clear(NexusDataStream* stream);
 
+/**
+ * @brief Prepare a stream for reuse
+ *
+ * Clears the data and drops all metadata but keeps the buffer, so a
+ * recycled stream can be written again without allocating.
+ *
+ * @param stream Stream to recycle
+ */
+void sps_stream_recycle(NexusDataStream* stream);
+
 /**
  * @brief Reset a stream to initial state
  *
@@ -140,6 +257,10 @@ void sps_stream_destroy(NexusDataStream* stream);
 /**
  * @brief Clone a stream
  *
+ * Contiguous streams are deep-copied. Chunked and mapped clones share the
+ * payload with the original and copy on write. Metadata values are shared
+ * by reference and stay owned by the original.
+ *
  * @param stream Stream to clone
  * @return NexusDataStream* Cloned stream or NULL on failure
  */
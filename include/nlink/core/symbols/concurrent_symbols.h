@@ -0,0 +1,135 @@
+/**
+ * @file concurrent_symbols.h
+ * @brief Concurrent (RCU-style) mode for the NexusLink symbol registry
+ *
+ * In concurrent mode each symbol table publishes an immutable snapshot
+ * that readers access without locks. Writers (nexus_symbol_table_add and
+ * nexus_symbol_table_remove) serialize on a per-table mutex, build a new
+ * snapshot and publish it atomically; superseded snapshots are reclaimed
+ * once no reader can still observe them (epoch-based reclamation).
+ * Reference counts are kept in per-thread stripes so concurrent resolves
+ * of the same symbol do not contend on a single cache line.
+ *
+ * Copyright © 2025 OBINexus Computing
+ */
+
+ #ifndef NLINK_SYMBOLS_CONCURRENT_SYMBOLS_H
+ #define NLINK_SYMBOLS_CONCURRENT_SYMBOLS_H
+
+ #include "nlink/core/symbols/nexus_symbols.h"
+
+ #ifdef __cplusplus
+ extern "C" {
+ #endif
+
+ /** Number of reference-count stripes per symbol */
+ #define NEXUS_SYMBOL_REF_STRIPES 16
+
+ /**
+  * @brief Switch a registry to concurrent mode
+  *
+  * Must be called before the registry is shared between threads. Existing
+  * symbols and their reference counts are carried over.
+  *
+  * @param registry The symbol registry
+  * @return NexusResult The result of the operation
+  */
+ NexusResult nexus_symbol_registry_enable_concurrent(NexusSymbolRegistry* registry);
+
+ /**
+  * @brief Switch a single symbol table to concurrent mode
+  *
+  * @param table The table to convert
+  * @return NexusResult The result of the operation
+  */
+ NexusResult nexus_symbol_table_enable_concurrent(NexusSymbolTable* table);
+
+ /**
+  * @brief Return a table to single-threaded mode
+  *
+  * Folds striped counts back into ref_count and frees every snapshot.
+  * No reader may be using the table. Called by nexus_symbol_table_cleanup().
+  *
+  * @param table The table to convert
+  */
+ void nexus_symbol_table_disable_concurrent(NexusSymbolTable* table);
+
+ /**
+  * @brief Begin a batch of writes to a concurrent table
+  *
+  * Adds and removes inside a batch are published as one snapshot by the
+  * matching nexus_symbol_table_end_update(). Batches may nest. No-op for
+  * tables that are not in concurrent mode.
+  *
+  * @param table The table being updated
+  */
+ void nexus_symbol_table_begin_update(NexusSymbolTable* table);
+
+ /**
+  * @brief End a batch of writes and publish the resulting snapshot
+  *
+  * @param table The table being updated
+  */
+ void nexus_symbol_table_end_update(NexusSymbolTable* table);
+
+ /**
+  * @brief Give a newly added symbol its striped counters
+  *
+  * Writer hook for nexus_symbol_table_add(); must be called between
+  * begin_update and end_update. Marks the table for publication.
+  *
+  * @param table The table the symbol was added to
+  * @param symbol The new symbol
+  * @return NexusResult The result of the operation
+  */
+ NexusResult nexus_symbol_table_attach_counters(NexusSymbolTable* table, NexusSymbol* symbol);
+
+ /**
+  * @brief Mark a concurrent table for publication at the end of the update
+  *
+  * Writer hook for nexus_symbol_table_remove().
+  *
+  * @param table The modified table
+  */
+ void nexus_symbol_table_mark_changed(NexusSymbolTable* table);
+
+ /**
+  * @brief Enter a read-side critical section
+  *
+  * Symbols returned by nexus_symbol_table_find_published() stay valid until
+  * the matching nexus_symbol_read_unlock(). Sections may nest.
+  */
+ void nexus_symbol_read_lock(void);
+
+ /**
+  * @brief Leave a read-side critical section
+  */
+ void nexus_symbol_read_unlock(void);
+
+ /**
+  * @brief Find a symbol in the currently published snapshot of a table
+  *
+  * Lock-free. Must be called inside nexus_symbol_read_lock()/unlock().
+  *
+  * @param table A table in concurrent mode
+  * @param name The name of the symbol to find
+  * @param hash nexus_intern_hash(name)
+  * @return NexusSymbol* The found symbol, or NULL if not found
+  */
+ NexusSymbol* nexus_symbol_table_find_published(NexusSymbolTable* table, const char* name, uint64_t hash);
+
+ /**
+  * @brief Record one use of a symbol
+  *
+  * Uses the calling thread's counter stripe in concurrent mode, so it is
+  * safe to call from any number of threads.
+  *
+  * @param symbol The symbol that was resolved
+  */
+ void nexus_symbol_ref_acquire(NexusSymbol* symbol);
+
+ #ifdef __cplusplus
+ }
+ #endif
+
+ #endif /* NLINK_SYMBOLS_CONCURRENT_SYMBOLS_H */
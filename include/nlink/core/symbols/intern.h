@@ -0,0 +1,69 @@
+/**
+ * @file intern.h
+ * @brief String interning for NexusLink symbol names
+ *
+ * Interned strings are stored once per process and never move, so two
+ * interned strings are equal if and only if their pointers are equal.
+ * Each interned string carries its precomputed 64-bit hash.
+ *
+ * Copyright © 2025 OBINexus Computing
+ */
+
+ #ifndef NLINK_SYMBOLS_INTERN_H
+ #define NLINK_SYMBOLS_INTERN_H
+
+ #include <stddef.h>
+ #include <stdint.h>
+
+ #ifdef __cplusplus
+ extern "C" {
+ #endif
+
+ /**
+  * @brief Hash a string with the interning hash function (FNV-1a, 64-bit)
+  *
+  * @param str NUL-terminated string
+  * @return uint64_t Hash value (never 0)
+  */
+ uint64_t nexus_intern_hash(const char* str);
+
+ /**
+  * @brief Intern a string, inserting it into the pool if needed
+  *
+  * Thread-safe. The returned pointer stays valid until nexus_intern_cleanup().
+  *
+  * @param str String to intern
+  * @return const char* Canonical interned pointer, or NULL on failure
+  */
+ const char* nexus_intern(const char* str);
+
+ /**
+  * @brief Look up an already interned string without inserting it
+  *
+  * Lock-free; safe to call concurrently with nexus_intern().
+  *
+  * @param str String to look up
+  * @return const char* Canonical interned pointer, or NULL if never interned
+  */
+ const char* nexus_intern_lookup(const char* str);
+
+ /**
+  * @brief Get the precomputed hash of an interned string
+  *
+  * @param interned Pointer previously returned by nexus_intern()
+  * @return uint64_t Hash value, identical to nexus_intern_hash(interned)
+  */
+ uint64_t nexus_intern_hash_of(const char* interned);
+
+ /**
+  * @brief Release every interned string
+  *
+  * Invalidates all pointers returned by nexus_intern(). Only call at shutdown.
+  */
+ void nexus_intern_cleanup(void);
+
+ #ifdef __cplusplus
+ }
+ #endif
+
+ #endif /* NLINK_SYMBOLS_INTERN_H */
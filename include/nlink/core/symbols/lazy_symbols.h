@@ -0,0 +1,89 @@
+/**
+ * @file lazy_symbols.h
+ * @brief dlopen-backed lazy binding for the NexusLink symbol registry
+ *
+ * A lazy symbol is registered with the address of a small stub instead of
+ * its real address, so the providing component is not mapped until the
+ * symbol is first called. On that first call the stub dlopens the
+ * component, looks the symbol up, patches the registry entry to the real
+ * address and forwards the call with the caller's arguments intact.
+ * Later resolves return the real address directly; callers that kept the
+ * stub address pay a single indirect jump.
+ *
+ * Stubs are implemented for x86-64. On other targets lazy symbols are
+ * bound when they are added.
+ *
+ * Copyright © 2025 OBINexus Computing
+ */
+
+ #ifndef NLINK_SYMBOLS_LAZY_SYMBOLS_H
+ #define NLINK_SYMBOLS_LAZY_SYMBOLS_H
+
+ #include "nlink/core/symbols/nexus_symbols.h"
+
+ #ifdef __cplusplus
+ extern "C" {
+ #endif
+
+ /** Maximum number of lazy symbols per process */
+ #define NEXUS_LAZY_MAX_STUBS 8192
+
+ /**
+  * @brief Add a function symbol that is bound on first call
+  *
+  * The symbol's address is a stub until the first call through it. Stubs
+  * forward integer, pointer and SSE register arguments; functions taking
+  * 256-bit vector arguments must not be registered lazily.
+  *
+  * @param table The table to add the symbol to
+  * @param name The name the symbol is registered (and resolved) under
+  * @param library_symbol The symbol name inside the library, or NULL to use @p name
+  * @param component_id The ID of the component that provides the symbol
+  * @param library_path Path of the shared object to dlopen on first call
+  * @return NexusResult The result of the operation
+  */
+ NexusResult nexus_symbol_table_add_lazy(NexusSymbolTable* table,
+                                         const char* name,
+                                         const char* library_symbol,
+                                         const char* component_id,
+                                         const char* library_path);
+
+ /**
+  * @brief Check whether an address is an unbound lazy stub
+  *
+  * @param address An address returned by symbol resolution
+  * @return bool True if calling @p address will trigger binding
+  */
+ bool nexus_lazy_is_unbound_stub(const void* address);
+
+ /**
+  * @brief Get lazy binding statistics (any output may be NULL)
+  *
+  * @param stubs Number of lazy symbols registered
+  * @param bound Number of lazy symbols bound so far
+  * @param libraries Number of component libraries loaded by lazy binding
+  */
+ void nexus_lazy_get_stats(size_t* stubs, size_t* bound, size_t* libraries);
+
+ /**
+  * @brief Stop patching a table that is being cleaned up
+  *
+  * Stubs registered in the table keep working but no longer update it.
+  * Called by nexus_symbol_table_cleanup().
+  *
+  * @param table The table being cleaned up
+  */
+ void nexus_lazy_detach_table(NexusSymbolTable* table);
+
+ /**
+  * @brief Unload every library loaded by lazy binding and free all stubs
+  *
+  * No stub or bound address may be called afterwards.
+  */
+ void nexus_lazy_cleanup(void);
+
+ #ifdef __cplusplus
+ }
+ #endif
+
+ #endif /* NLINK_SYMBOLS_LAZY_SYMBOLS_H */
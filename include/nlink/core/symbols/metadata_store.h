@@ -0,0 +1,145 @@
+/**
+ * @file metadata_store.h
+ * @brief Key/value metadata keyed by interned strings
+ *
+ * Backs the metadata of SPS and MPS data streams. The first
+ * NEXUS_METADATA_INLINE entries live inside the store itself, so small
+ * stores never allocate; past that the entries spill into one growable
+ * array indexed by an open-addressing table on the intern hash. Keys are
+ * interned, so lookups compare pointers rather than strings.
+ *
+ * Copyright © 2025 OBINexus Computing
+ */
+
+ #ifndef NLINK_SYMBOLS_METADATA_STORE_H
+ #define NLINK_SYMBOLS_METADATA_STORE_H
+
+ #include "nlink/core/common/result.h"
+ #include <stddef.h>
+ #include <stdint.h>
+
+ #ifdef __cplusplus
+ extern "C" {
+ #endif
+
+ /** Number of entries stored inline before the store spills */
+ #define NEXUS_METADATA_INLINE 8
+
+ /**
+  * @brief Function to free a metadata value
+  */
+ typedef void (*NexusMetadataFreeFunc)(void* value);
+
+ /**
+  * @brief Metadata entry
+  */
+ typedef struct NexusMetadataEntry {
+     const char* key;                   /**< Interned key */
+     void* value;                       /**< Metadata value */
+     NexusMetadataFreeFunc free_func;   /**< Frees the value, NULL if borrowed */
+ } NexusMetadataEntry;
+
+ /**
+  * @brief Metadata store
+  *
+  * Entries are kept in insertion order: the inline ones first, then the
+  * spilled ones. A zero-initialized store is empty and valid.
+  */
+ typedef struct NexusMetadataStore {
+     size_t count;                                          /**< Number of entries */
+     NexusMetadataEntry inline_entries[NEXUS_METADATA_INLINE]; /**< First entries */
+     NexusMetadataEntry* spill;                             /**< Entries past the inline ones */
+     size_t spill_capacity;                                 /**< Capacity of spill */
+     uint32_t* index;                                       /**< Hash slots holding entry index + 1 */
+     size_t index_slots;                                    /**< Slot count, a power of two */
+ } NexusMetadataStore;
+
+ /**
+  * @brief Initialize an empty store
+  *
+  * @param store Store to initialize
+  */
+ void nexus_metadata_init(NexusMetadataStore* store);
+
+ /**
+  * @brief Get the entry at a position in insertion order
+  *
+  * @param store Store to read
+  * @param position Position, below store->count
+  * @return NexusMetadataEntry* The entry
+  */
+ static inline NexusMetadataEntry* nexus_metadata_entry_at(const NexusMetadataStore* store, size_t position) {
+     return position < NEXUS_METADATA_INLINE
+         ? (NexusMetadataEntry*)&store->inline_entries[position]
+         : &store->spill[position - NEXUS_METADATA_INLINE];
+ }
+
+ /**
+  * @brief Look up a value by an interned key
+  *
+  * @param store Store to search
+  * @param interned_key Key returned by nexus_intern()
+  * @return void* Value or NULL if not found
+  */
+ void* nexus_metadata_get_interned(const NexusMetadataStore* store, const char* interned_key);
+
+ /**
+  * @brief Look up a value by key
+  *
+  * Keys that were never interned cannot be present, so this never
+  * inserts into the intern pool.
+  *
+  * @param store Store to search
+  * @param key Key
+  * @return void* Value or NULL if not found
+  */
+ void* nexus_metadata_get(const NexusMetadataStore* store, const char* key);
+
+ /**
+  * @brief Set a value, replacing and freeing any previous one
+  *
+  * @param store Store to modify
+  * @param key Key, interned on insertion
+  * @param value Value
+  * @param free_func Function to free the value, or NULL
+  * @return NexusResult Operation result
+  */
+ NexusResult nexus_metadata_set(NexusMetadataStore* store,
+                               const char* key,
+                               void* value,
+                               NexusMetadataFreeFunc free_func);
+
+ /**
+  * @brief Copy every entry of one store into an empty store
+  *
+  * Values are shared by reference and stay owned by @p src: the copies
+  * are borrowed and never freed by @p dst. At most two allocations are
+  * made, whatever the entry count.
+  *
+  * @param dst Empty store to fill
+  * @param src Store to copy
+  * @return NexusResult Operation result
+  */
+ NexusResult nexus_metadata_copy(NexusMetadataStore* dst, const NexusMetadataStore* src);
+
+ /**
+  * @brief Remove every entry, freeing owned values
+  *
+  * Spilled storage is kept for reuse.
+  *
+  * @param store Store to clear
+  */
+ void nexus_metadata_clear(NexusMetadataStore* store);
+
+ /**
+  * @brief Remove every entry and release all storage
+  *
+  * @param store Store to destroy
+  */
+ void nexus_metadata_destroy(NexusMetadataStore* store);
+
+ #ifdef __cplusplus
+ }
+ #endif
+
+ #endif /* NLINK_SYMBOLS_METADATA_STORE_H */
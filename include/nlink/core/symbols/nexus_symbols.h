@@ -13,6 +13,8 @@
  
  #include "nlink/core/common/result.h"
     #include "nlink/core/common/types.h"
+ #include "nlink/core/symbols/registry.h"
+ #include "nlink/core/symbols/intern.h"
     
  #include <stddef.h>
  #include <stdbool.h>
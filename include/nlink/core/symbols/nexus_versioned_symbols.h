@@ -8,12 +8,18 @@
  
 #include "nlink/core/common//types.h"
 #include "nlink/core/common//result.h"
+#include "nlink/core/semverx/semver.h"
 #include <stddef.h>
    #include <stdlib.h>
    #include <string.h>
    #include <stdio.h>
    #include <stdbool.h>
+   #include <stdint.h>
    #include <time.h>
+   #include <pthread.h>
+
+// Usage record of a lazily loaded component (see nlink/core/semverx/lazy_versioned.h)
+struct NexusComponentUsage;
 
 // Symbol types (compatible with original nexus_symbols.h)
 typedef enum {
@@ -27,18 +33,38 @@ typedef enum {
 typedef struct {
     char* name;           // Symbol name
     char* version;        // Symbol version (semantic versioning)
+    SemVerPacked packed_version;  // Version packed at registration, used for matching
+    bool packed_exact;    // packed_version is exact; otherwise match with semver_satisfies()
     void* address;        // Memory address
     VersionedSymbolType type;  // Symbol type
     char* component_id;   // Component that provides this symbol
     int priority;         // Resolution priority (higher wins)
     int ref_count;        // Reference counting for usage tracking
+    struct NexusComponentUsage* usage;  // Usage record of the providing component, NULL if not lazily loaded
 } VersionedSymbol;
 
+// Indices of the entries one component provides or imports in a table
+typedef struct {
+    const char* component_id;  // Interned component ID (NULL marks an empty slot)
+    size_t* entries;           // Indices into the table's symbols
+    size_t count;              // Number of indices
+    size_t capacity;           // Allocated capacity for indices
+} VersionedComponentEntries;
+
 // Symbol table with version support
 typedef struct {
     VersionedSymbol* symbols;  // Array of versioned symbols
-    size_t size;               // Current number of symbols
+    size_t size;               // Number of entries, including dropped ones (name NULL) not yet compacted
     size_t capacity;           // Allocated capacity
+    uint64_t generation;       // Bumped whenever the table contents change
+    pthread_mutex_t* lock;     // Lock of the owning registry, NULL for a standalone table
+    
+    // Per-component entry lists, open-addressed by interned component ID,
+    // so a component's entries are dropped without walking the table
+    VersionedComponentEntries* components;  // Slot array, allocated on first add
+    size_t component_capacity;              // Number of slots (power of two)
+    size_t component_count;                 // Occupied slots
+    size_t dropped;                         // Dropped entries awaiting compaction
 } VersionedSymbolTable;
 
 // Component dependency relationship
@@ -46,9 +72,29 @@ typedef struct {
     char* from_id;         // Dependent component
     char* to_id;           // Dependency component
     char* version_req;     // Version requirement
+    SemVerConstraint constraint;  // version_req compiled when the dependency is added
     bool optional;         // Whether dependency is optional
 } ComponentDependency;
 
+// Cached outcome of one (name, constraint, requesting component) resolution
+typedef struct {
+    const char* name;          // Interned symbol name (NULL marks an empty slot)
+    const char* constraint;    // Interned version constraint, NULL for any version
+    const char* component;     // Interned requesting component
+    uint64_t key_hash;         // Combined hash of the three keys
+    uint64_t generation;       // Registry generation the entry was computed at
+    VersionedSymbol* symbol;   // Resolved symbol, NULL for a cached failure
+} VersionedResolutionEntry;
+
+// Resolution cache; an entry is only valid while the registry generation
+// it was computed at is current, so registry changes invalidate it wholesale
+typedef struct {
+    VersionedResolutionEntry* entries;  // Slot array, allocated on first use
+    size_t capacity;                    // Number of slots (power of two)
+    uint64_t hits;                      // Resolutions answered from the cache
+    uint64_t misses;                    // Resolutions that ran the full search
+} VersionedResolutionCache;
+
 // Context-aware symbol registry
 typedef struct {
     VersionedSymbolTable global;     // Global symbols (always available)
@@ -59,6 +105,14 @@ typedef struct {
     ComponentDependency* dependencies;  // Array of component dependencies
     size_t deps_count;                  // Number of dependencies
     size_t deps_capacity;               // Allocated capacity for dependencies
+    uint64_t deps_generation;           // Bumped whenever a dependency is added
+    
+    // Memoized resolutions
+    VersionedResolutionCache cache;
+    
+    // Held by resolution, by additions to the tables and dependencies, and
+    // by the lazy unloader while it drops symbols
+    pthread_mutex_t lock;
 } VersionedSymbolRegistry;
 
 // Initialize a versioned symbol table
@@ -67,7 +121,7 @@ void versioned_symbol_table_init(VersionedSymbolTable* table, size_t initial_cap
 // Create a new versioned symbol registry
 VersionedSymbolRegistry* nexus_versioned_registry_create(void);
 
-// Add a symbol to a versioned table
+// Add a symbol to a versioned table; takes the table's registry lock
 void versioned_symbol_table_add(VersionedSymbolTable* table, 
                                const char* name, 
                                const char* version,
@@ -76,6 +130,12 @@ void versioned_symbol_table_add(VersionedSymbolTable* table,
                                const char* component_id,
                                int priority);
 
+// Drop every entry a component provides or imports from the global,
+// imported and exported tables; takes the registry lock. Costs time in
+// proportion to the component's own entries, amortized.
+void nexus_versioned_registry_drop_component(VersionedSymbolRegistry* registry,
+                                            const char* component_id);
+
 // Find all symbols with a given name in a table
 // Returns the number of matching symbols
 // The caller is responsible for freeing the results array (but not the symbols themselves)
@@ -83,7 +143,7 @@ size_t versioned_symbol_table_find_all(VersionedSymbolTable* table,
                                       const char* name,
                                       VersionedSymbol*** results);
 
-// Add a component dependency relationship
+// Add a component dependency relationship; takes the registry lock
 void nexus_add_component_dependency(VersionedSymbolRegistry* registry,
                                    const char* component_id,
                                    const char* depends_on_id,
@@ -106,11 +166,38 @@ bool nexus_is_direct_dependency(VersionedSymbolRegistry* registry,
 // This is the key function that handles the diamond dependency problem
 // If version_constraint is NULL, any version is accepted
 // The requesting_component is used for context-aware resolution
+// Nothing keeps a lazily loaded provider loaded once this returns; use
+// nexus_resolve_versioned_symbol_pinned() to hold on to the address
 void* nexus_resolve_versioned_symbol(VersionedSymbolRegistry* registry,
                                     const char* name,
                                     const char* version_constraint,
                                     const char* requesting_component);
 
+// Same as above, but pins the providing component so the lazy unloader
+// keeps it loaded. *pin receives the pin (NULL when the provider is not
+// lazily loaded or nothing was resolved); pass it to
+// nexus_versioned_symbol_release() once the address is no longer used.
+void* nexus_resolve_versioned_symbol_pinned(VersionedSymbolRegistry* registry,
+                                           const char* name,
+                                           const char* version_constraint,
+                                           const char* requesting_component,
+                                           struct NexusComponentUsage** pin);
+
+// Drop a pin taken by nexus_resolve_versioned_symbol_pinned(); NULL is ignored
+void nexus_versioned_symbol_release(struct NexusComponentUsage* pin);
+
+// Current registry generation; changes whenever the exported or global
+// table, or the dependency list, changes
+uint64_t nexus_versioned_registry_generation(const VersionedSymbolRegistry* registry);
+
+// Get resolution cache hit/miss counters (either output may be NULL)
+void nexus_versioned_cache_get_stats(const VersionedSymbolRegistry* registry,
+                                    uint64_t* hits,
+                                    uint64_t* misses);
+
+// Drop every cached resolution and reset the counters
+void nexus_versioned_cache_clear(VersionedSymbolRegistry* registry);
+
 // Same as above but with additional type safety
 void* nexus_resolve_versioned_symbol_typed(VersionedSymbolRegistry* registry,
                                           const char* name,
@@ -14,6 +14,7 @@
  #include "nlink/core/common//types.h"
  #include "nlink/core/common//result.h"
  #include <stddef.h>
+ #include <stdint.h>
     #include <stdlib.h>
     #include <string.h>
     #include <stdio.h>
@@ -30,22 +31,31 @@
   * This structure represents a symbol in the NexusLink system.
   */
  struct NexusSymbol {
-     char* name;              /**< Symbol name */
+     const char* name;        /**< Interned symbol name (owned by the intern pool) */
      void* address;           /**< Memory address of the symbol */
      NexusSymbolType type;    /**< Symbol type */
-     char* component_id;      /**< ID of the component that provides this symbol */
+     const char* component_id; /**< Interned ID of the component that provides this symbol */
      int ref_count;           /**< Reference count for usage tracking */
+     uint64_t hash;           /**< Precomputed hash of name */
+     struct NexusSymbolRefCounter* ref_counters; /**< Striped counters in concurrent mode, else NULL */
  };
  
  /**
   * @brief Symbol table structure
   * 
   * This structure represents a table of symbols in the NexusLink system.
+  * Symbols are stored densely in @c symbols; @c index is an open-addressing
+  * (linear probing) hash index over them, kept at a load factor of at most 1/2.
+  * Each index slot packs the upper 32 bits of the symbol hash with the
+  * symbol position plus one, so 0 marks an empty slot.
   */
  struct NexusSymbolTable {
      NexusSymbol* symbols;    /**< Array of symbols */
      size_t capacity;         /**< Capacity of the symbols array */
      size_t size;             /**< Number of symbols in the table */
+     uint64_t* index;         /**< Hash index slots */
+     size_t index_capacity;   /**< Number of index slots (power of two) */
+     struct NexusSymbolTableSync* sync; /**< Concurrent-mode state, NULL when single-threaded */
  };
  
  /**
@@ -99,6 +109,18 @@
   */
  NexusSymbol* nexus_symbol_table_find(NexusSymbolTable* table, const char* name);
  
+ /**
+  * @brief Find a symbol using a precomputed name hash
+  * 
+  * Lets callers that probe several tables for the same name hash it once.
+  * 
+  * @param table The table to search
+  * @param name The name of the symbol to find
+  * @param hash nexus_intern_hash(name)
+  * @return NexusSymbol* The found symbol, or NULL if not found
+  */
+ NexusSymbol* nexus_symbol_table_find_hashed(NexusSymbolTable* table, const char* name, uint64_t hash);
+ 
  /**
   * @brief Resolve a symbol using the three-tier registry
   * 
@@ -117,6 +139,16 @@
   */
  NexusResult nexus_symbol_table_remove(NexusSymbolTable* table, const char* name);
  
+ /**
+  * @brief Get the usage count of a symbol
+  * 
+  * Sums the striped counters for symbols in a concurrent table.
+  * 
+  * @param symbol The symbol to query
+  * @return int The number of times the symbol has been resolved
+  */
+ int nexus_symbol_get_ref_count(const NexusSymbol* symbol);
+ 
  /**
   * @brief Count used symbols in a symbol table
   * 
@@ -12,6 +12,8 @@
 
 #include <stddef.h>
 #include <stdbool.h>
+#include "nlink/core/threading/thread_pool.h"
+#include "nlink/core/pipeline/pipeline_arena.h"
 
 /**
  * Function pointer types for abstract operations
@@ -21,6 +23,47 @@ typedef bool (*nlink_filter_fn)(void* item, void* context);
 typedef void* (*nlink_fold_fn)(void* accumulator, void* item, void* context);
 typedef int (*nlink_compare_fn)(void* a, void* b, void* context);
 
+/**
+ * Range function for nlink_parallel_for: processes items [begin, end) as chunk number chunk
+ */
+typedef void (*nlink_range_fn)(size_t chunk, size_t begin, size_t end, void* context);
+
+/** Inputs shorter than this run serially unless the configuration says otherwise */
+#define NLINK_PARALLEL_DEFAULT_CUTOFF 16384
+
+/**
+ * Parallel execution configuration
+ *
+ * A zero-initialized configuration, like a NULL one, runs on the shared
+ * pool with the default cutoff and chunking and allocates output with
+ * malloc.
+ */
+typedef struct nlink_parallel_config {
+    nlink_thread_pool_t* pool;     // Pool to run chunks on; NULL for the shared pool
+    size_t serial_cutoff;          // Inputs below this many items run serially; 0 for the default
+    size_t chunk_size;             // Items per chunk; 0 to split by the pool's worker count
+    NlinkArena* arena;             // Allocates output and scratch when set, instead of malloc
+} nlink_parallel_config;
+
+/**
+ * Fused map, filter and fold
+ *
+ * Each item is mapped, tested and folded in one pass, so no intermediate
+ * array is built. In parallel every chunk folds from identity and the
+ * chunk results are combined in chunk order into the initial value, so
+ * fold_fn and combine_fn must be associative with identity as their
+ * neutral element, and an accumulator updated in place must not be
+ * shared through identity.
+ */
+typedef struct nlink_fused_ops {
+    nlink_map_fn map_fn;           // Applied first; NULL passes items through
+    nlink_filter_fn filter_fn;     // Tests the mapped item; NULL keeps every item
+    nlink_fold_fn fold_fn;         // Folds each kept item into the accumulator
+    nlink_fold_fn combine_fn;      // Folds a chunk accumulator into the result; NULL stays serial
+    void* identity;                // Starting accumulator of every chunk
+    void* context;                 // Passed to every function
+} nlink_fused_ops;
+
 /**
  * @brief Map a function over an array of items
  *
@@ -140,6 +183,107 @@ bool nlink_all(void** items, size_t count, nlink_filter_fn predicate, void* cont
  */
 void** nlink_clone_array(void** items, size_t count);
 
+/**
+ * @brief Number of chunks nlink_parallel_for splits count items into
+ *
+ * Returns 1 when the work would run serially: below the serial cutoff,
+ * or when no pool is available.
+ *
+ * @param count Number of items
+ * @param config Parallel configuration, or NULL for the defaults
+ * @return size_t Chunk count, at least 1
+ */
+size_t nlink_parallel_chunk_count(size_t count, const nlink_parallel_config* config);
+
+/**
+ * @brief Run a range function over [0, count) in chunks
+ *
+ * Splits the range into the chunks nlink_parallel_chunk_count reports:
+ * contiguous, in order, and differing in size by at most one item.
+ * Chunks run as pool tasks, the calling thread included, and the call
+ * returns once all have finished. A single chunk runs directly on the
+ * calling thread.
+ *
+ * @param count Number of items
+ * @param fn Range function
+ * @param context Passed to fn
+ * @param config Parallel configuration, or NULL for the defaults
+ * @return size_t Number of chunks run
+ */
+size_t nlink_parallel_for(size_t count, nlink_range_fn fn, void* context,
+                          const nlink_parallel_config* config);
+
+/**
+ * @brief Map in parallel into a caller buffer or arena
+ *
+ * Same results as nlink_map. Output comes from, in order of preference,
+ * the output argument, which may be items itself, the configured arena
+ * or malloc; only the malloc'd case is the caller's to free.
+ *
+ * @param items Array of input items
+ * @param count Number of items
+ * @param map_func Function to apply to each item
+ * @param context Optional context passed to the mapping function
+ * @param output Receives count results, or NULL to allocate
+ * @param config Parallel configuration, or NULL for the defaults
+ * @return Array of mapped results, or NULL if any item failed to map;
+ *         a caller buffer is then left partly written
+ */
+void** nlink_map_parallel(void** items, size_t count, nlink_map_fn map_func,
+                          void* context, void** output, const nlink_parallel_config* config);
+
+/**
+ * @brief Filter in parallel into a caller buffer or arena
+ *
+ * Keeps matching items in input order. Each chunk compacts its matches
+ * and the chunks are then moved into place by a prefix sum of their
+ * counts, so the predicate runs once per item. Output is chosen as for
+ * nlink_map_parallel, needs room for count items and may be items
+ * itself.
+ *
+ * @param items Array of input items
+ * @param count Number of items
+ * @param filter_func Predicate function
+ * @param context Optional context passed to the predicate
+ * @param output Receives the matches, or NULL to allocate
+ * @param result_size Pointer to receive the number of matches
+ * @param config Parallel configuration, or NULL for the defaults
+ * @return Array of matching items, or NULL on failure
+ */
+void** nlink_filter_parallel(void** items, size_t count, nlink_filter_fn filter_func,
+                             void* context, void** output, size_t* result_size,
+                             const nlink_parallel_config* config);
+
+/**
+ * @brief Sort in parallel
+ *
+ * Sorts each chunk with nlink_sort's comparison and merges the sorted
+ * runs pairwise, each round's merges running as pool tasks. Scratch
+ * space comes from the configured arena or malloc.
+ *
+ * @param items Array of items to sort (modified in place)
+ * @param count Number of items
+ * @param compare Comparison function
+ * @param context Optional context passed to the comparison function
+ * @param config Parallel configuration, or NULL for the defaults
+ * @return false if scratch space cannot be allocated; items are then unchanged
+ */
+bool nlink_sort_parallel(void** items, size_t count, nlink_compare_fn compare,
+                         void* context, const nlink_parallel_config* config);
+
+/**
+ * @brief Map, filter and fold in one pass
+ *
+ * @param items Array of input items
+ * @param count Number of items
+ * @param initial Initial accumulator value
+ * @param ops Fused operations; fold_fn is required
+ * @param config Parallel configuration, or NULL for the defaults
+ * @return Final accumulator value
+ */
+void* nlink_map_filter_fold(void** items, size_t count, void* initial,
+                            const nlink_fused_ops* ops, const nlink_parallel_config* config);
+
 /**
  * Abstraction macros for common operations
  */
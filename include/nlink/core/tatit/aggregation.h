@@ -20,6 +20,9 @@
 typedef void* (*nlink_aggregator_fn)(void** items, size_t count, void* context);
 typedef void* (*nlink_combiner_fn)(void* a, void* b, void* context);
 typedef void* (*nlink_initializer_fn)(void* context);
+typedef void* (*nlink_key_fn)(void* item, void* context);
+typedef size_t (*nlink_key_hash_fn)(const void* key, void* context);
+typedef bool (*nlink_key_equal_fn)(const void* a, const void* b, void* context);
 
 /**
  * Aggregation result structure
@@ -35,6 +38,29 @@ typedef struct nlink_aggregation_result {
     void* custom;          // Custom aggregation result
 } nlink_aggregation_result;
 
+/**
+ * Summary statistics of a numeric column
+ */
+typedef struct nlink_column_summary {
+    size_t count;          // Number of values
+    double min;            // Smallest value
+    double max;            // Largest value
+    double sum;            // Compensated sum
+    double mean;           // Arithmetic mean
+    double variance;       // Population variance, or sample variance if requested
+} nlink_column_summary;
+
+/**
+ * Column summary options
+ */
+typedef struct nlink_column_summary_config {
+    const double* percentiles;     // Percentiles to compute, each in [0, 100], or NULL
+    double* percentile_values;     // Receives one value per requested percentile
+    size_t percentile_count;       // Number of requested percentiles
+    bool sample_variance;          // Divide by count - 1 instead of count
+    size_t parallel_threshold;     // Minimum values per pool task; 0 for the default, SIZE_MAX to stay serial
+} nlink_column_summary_config;
+
 /**
  * Aggregation operation type
  */
@@ -61,6 +87,38 @@ typedef struct nlink_aggregation_config {
     void* context;                        // Context for custom functions
 } nlink_aggregation_config;
 
+/**
+ * Group-by configuration
+ *
+ * Keys are compared by pointer unless hash_fn and equal_fn are set; keys
+ * that are equal must hash equally. With more than one partition, the
+ * key, hash and equality functions run concurrently on pool threads and
+ * must be thread-safe.
+ */
+typedef struct nlink_group_by_config {
+    nlink_key_fn key_fn;            // Function to extract key from item
+    nlink_key_hash_fn hash_fn;      // Key hash, or NULL to hash the key pointer
+    nlink_key_equal_fn equal_fn;    // Key equality, or NULL for pointer equality
+    void* context;                  // Context for key, hash and equality functions
+    size_t expected_groups;         // Table sizing hint, or 0
+    size_t partitions;              // Shards grouped in parallel; 0 or 1 for serial
+} nlink_group_by_config;
+
+/**
+ * Grouped items in compressed (CSR) form
+ *
+ * Groups appear in the order their first item appears in the input, and
+ * items keep their input order within a group. Group g holds
+ * items[offsets[g]] up to but excluding items[offsets[g + 1]].
+ */
+typedef struct nlink_grouping {
+    void** items;          // Items ordered by group
+    size_t* offsets;       // group_count + 1 offsets into items
+    void** keys;           // Key of each group (first item's key)
+    size_t item_count;     // Number of items
+    size_t group_count;    // Number of groups
+} nlink_grouping;
+
 /**
  * @brief Create a new aggregation configuration
  *
@@ -135,17 +193,45 @@ void nlink_aggregation_result_free(nlink_aggregation_result* result);
 /**
  * @brief Group items by a key function
  *
+ * Keys are compared by pointer. Groups are returned in order of first
+ * appearance. Prefer nlink_group_by_keys, which returns the groups in a
+ * single compact result.
+ *
  * @param items Array of items to group
  * @param count Number of items
  * @param key_fn Function to extract key from item
  * @param context Context for key function
  * @param num_groups Pointer to receive number of groups
- * @return Array of groups, each group is NULL-terminated
+ * @return NULL-terminated array of groups, each group is NULL-terminated
  */
 void*** nlink_group_by(void** items, size_t count, 
                       void* (*key_fn)(void* item, void* context),
                       void* context, size_t* num_groups);
 
+/**
+ * @brief Group items by key into a compact result
+ *
+ * Builds a hash table of groups that grows as needed, so the number of
+ * distinct keys is unbounded. With config->partitions above 1, the input
+ * is split into that many contiguous shards, each grouped into its own
+ * table on the shared thread pool; the tables are then merged in shard
+ * order, so the result is the same as a serial run.
+ *
+ * @param items Array of items to group
+ * @param count Number of items
+ * @param config Group-by configuration
+ * @return Grouping, or NULL on invalid arguments or allocation failure
+ */
+nlink_grouping* nlink_group_by_keys(void** items, size_t count,
+                                    const nlink_group_by_config* config);
+
+/**
+ * @brief Free a grouping
+ *
+ * @param grouping Grouping to free
+ */
+void nlink_grouping_free(nlink_grouping* grouping);
+
 /**
  * @brief Combine multiple arrays into one
  *
@@ -165,6 +251,47 @@ void** nlink_combine_arrays(void*** arrays, size_t array_count, size_t* result_c
  */
 nlink_aggregation_result* nlink_numerical_summary(void** values, size_t count);
 
+/**
+ * @brief Summarize a column of doubles
+ *
+ * Computes min, max, sum, mean and variance in one pass over the values,
+ * using SIMD kernels where available and compensated (Kahan) sums for
+ * the sum and the sum of squares. Variance is computed about the first
+ * value, so large offsets do not cancel. Columns above twice the
+ * parallel threshold are split across the shared thread pool. Requested
+ * percentiles are interpolated linearly between the closest ranks and
+ * need a temporary copy of the column. Results are unspecified if the
+ * column contains NaN.
+ *
+ * @param values Column values
+ * @param count Number of values
+ * @param config Summary options, or NULL for no percentiles
+ * @param summary Receives the statistics
+ * @return false on invalid arguments or allocation failure
+ */
+bool nlink_summarize_column_f64(const double* values, size_t count,
+                                const nlink_column_summary_config* config,
+                                nlink_column_summary* summary);
+
+/**
+ * @brief Summarize a column of floats
+ *
+ * As nlink_summarize_column_f64; values are widened to double.
+ */
+bool nlink_summarize_column_f32(const float* values, size_t count,
+                                const nlink_column_summary_config* config,
+                                nlink_column_summary* summary);
+
+/**
+ * @brief Summarize a column of 64-bit integers
+ *
+ * As nlink_summarize_column_f64; values are converted to double, so
+ * magnitudes above 2^53 are rounded.
+ */
+bool nlink_summarize_column_i64(const int64_t* values, size_t count,
+                                const nlink_column_summary_config* config,
+                                nlink_column_summary* summary);
+
 /**
  * Macro for simple aggregation operations
  */
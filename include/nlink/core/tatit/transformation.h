@@ -13,6 +13,7 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include "nlink/core/tatit/abstraction.h"
 
 /**
  * Function pointer types for transformations
@@ -21,6 +22,14 @@ typedef void* (*nlink_transformer_fn)(void* data, void* context);
 typedef bool (*nlink_condition_fn)(void* data, void* context);
 typedef void* (*nlink_factory_fn)(void* context);
 
+/**
+ * Normalization mode
+ */
+typedef enum nlink_normalize_mode {
+    NLINK_NORMALIZE_MIN_MAX,      // Map [min, max] onto the target range
+    NLINK_NORMALIZE_Z_SCORE       // Subtract the mean, divide by the standard deviation
+} nlink_normalize_mode;
+
 /**
  * Transformation configuration
  */
@@ -119,6 +128,27 @@ void* nlink_transform_if(void* data, nlink_condition_fn condition_fn,
 void** nlink_transform_array(void** items, size_t count, 
                             nlink_transform_config* config);
 
+/**
+ * @brief Transform an array of values in parallel
+ *
+ * Applies the configuration as nlink_transform_array does, over chunks
+ * run on a thread pool; inputs below the serial cutoff run on the
+ * calling thread. Output comes from the output argument, the configured
+ * arena or malloc, in that order, and must not overlap items. Unlike
+ * nlink_transform_array, an aborted transform returns NULL rather than
+ * the input array.
+ *
+ * @param items Array of items to transform
+ * @param count Number of items
+ * @param config Transformation configuration
+ * @param output Receives count transformed items, or NULL to allocate
+ * @param parallel Parallel configuration, or NULL for the defaults
+ * @return Array of transformed items, or NULL on failure or abort
+ */
+void** nlink_transform_array_parallel(void** items, size_t count,
+                                      nlink_transform_config* config, void** output,
+                                      const nlink_parallel_config* parallel);
+
 /**
  * @brief Transform multiple values with different transformations
  *
@@ -147,6 +177,9 @@ double nlink_normalize(double value, double min, double max,
 /**
  * @brief Normalize an array of double values
  *
+ * Allocates the result; use nlink_normalize_into to normalize in place
+ * or into a caller buffer.
+ *
  * @param values Array of values to normalize
  * @param count Number of values
  * @param target_min Target minimum (default 0.0)
@@ -156,6 +189,49 @@ double nlink_normalize(double value, double min, double max,
 double* nlink_normalize_array(double* values, size_t count, 
                              double target_min, double target_max);
 
+/**
+ * @brief Normalize double values into a caller buffer
+ *
+ * One pass finds the statistics (min and max, or mean and standard
+ * deviation for z-scores) and a second applies a single multiply-add per
+ * value; both use SIMD kernels where available. In min/max mode equal
+ * target bounds select [0, 1] and a constant input maps to the middle of
+ * the target range; in z-score mode the target range is ignored and a
+ * constant input maps to 0. NaN values are skipped when finding the
+ * min/max range and stay NaN in the output, except in a constant input,
+ * whose every entry maps to the constant's target.
+ *
+ * @param values Values to normalize
+ * @param output Receives count normalized values; may be values itself
+ * @param count Number of values
+ * @param mode Normalization mode
+ * @param target_min Target minimum (min/max mode)
+ * @param target_max Target maximum (min/max mode)
+ * @return false if values or output is NULL or count is 0
+ */
+bool nlink_normalize_into(const double* values, double* output, size_t count,
+                          nlink_normalize_mode mode, double target_min, double target_max);
+
+/**
+ * @brief Normalize each column of a row-major matrix
+ *
+ * Normalizes every column independently, as nlink_normalize_into would,
+ * in two passes over the rows, e.g. a batch of feature vectors stored
+ * one sample per row. Columns follow the same NaN and constant-input
+ * rules and use the same compensated z-score sums.
+ *
+ * @param data rows x columns values, row-major
+ * @param output Receives the normalized matrix; may be data itself
+ * @param rows Number of rows
+ * @param columns Number of columns
+ * @param mode Normalization mode
+ * @param target_min Target minimum (min/max mode)
+ * @param target_max Target maximum (min/max mode)
+ * @return false on invalid arguments or allocation failure
+ */
+bool nlink_normalize_matrix(const double* data, double* output, size_t rows, size_t columns,
+                            nlink_normalize_mode mode, double target_min, double target_max);
+
 /**
  * @brief Apply a sequence of transformations
  *
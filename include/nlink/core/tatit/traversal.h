@@ -21,6 +21,8 @@ typedef void* (*nlink_visitor_fn)(void* node, void* context);
 typedef void* (*nlink_node_getter_fn)(void* node, size_t index, void* context);
 typedef size_t (*nlink_child_count_fn)(void* node, void* context);
 typedef bool (*nlink_traversal_control_fn)(void* node, void* context);
+typedef size_t (*nlink_node_id_fn)(void* node, void* context);
+typedef bool (*nlink_traversal_emit_fn)(void* node, void* result, void* context);
 
 /**
  * Traversal order enumeration
@@ -45,6 +47,43 @@ typedef struct nlink_traversal_config {
     bool collect_results;                 // Whether to collect visitor results
 } nlink_traversal_config;
 
+/**
+ * Outcome of a streaming traversal
+ */
+typedef enum nlink_traversal_status {
+    NLINK_TRAVERSAL_COMPLETE,     // Every reachable node was visited
+    NLINK_TRAVERSAL_STOPPED,      // The emit callback returned false
+    NLINK_TRAVERSAL_FAILED        // Invalid arguments or out of memory
+} nlink_traversal_status;
+
+/**
+ * Pending node of a traversal, with the next child to descend into
+ */
+typedef struct nlink_traversal_frame {
+    void* node;
+    size_t next_child;
+} nlink_traversal_frame;
+
+/**
+ * Traversal workspace
+ *
+ * The explicit stack or queue of a streaming traversal. Its memory is
+ * kept between traversals, so a caller walking many trees with one
+ * workspace allocates only until the largest frontier fits. Zero-
+ * initialize it or call nlink_traversal_workspace_init() before use.
+ */
+typedef struct nlink_traversal_workspace {
+    nlink_traversal_frame* frames;  // Stack or queue storage
+    size_t head;                    // First queued frame (level order only)
+    size_t count;                   // One past the last frame in use
+    size_t capacity;                // Frames allocated
+} nlink_traversal_workspace;
+
+/**
+ * Node-to-position map of a traversal result (opaque)
+ */
+typedef struct nlink_traversal_index nlink_traversal_index;
+
 /**
  * Traversal result structure
  */
@@ -53,6 +92,7 @@ typedef struct nlink_traversal_result {
     void** results;   // Array of visitor results
     size_t count;     // Number of visited nodes
     size_t capacity;  // Capacity of result arrays
+    nlink_traversal_index* index;  // First position of each node, for O(1) lookups; may be built lazily
 } nlink_traversal_result;
 
 /**
@@ -111,6 +151,49 @@ void nlink_traversal_config_free(nlink_traversal_config* config);
  */
 nlink_traversal_result* nlink_traverse_tree(void* root, nlink_traversal_config* config);
 
+/**
+ * @brief Initialize a traversal workspace
+ *
+ * @param workspace Workspace to initialize
+ * @param capacity Frames to reserve up front, or 0 to allocate on first use
+ * @return true if the reservation succeeded
+ */
+bool nlink_traversal_workspace_init(nlink_traversal_workspace* workspace, size_t capacity);
+
+/**
+ * @brief Release a traversal workspace's memory
+ *
+ * The workspace can be used again afterwards.
+ *
+ * @param workspace Workspace to release
+ */
+void nlink_traversal_workspace_free(nlink_traversal_workspace* workspace);
+
+/**
+ * @brief Traverse a tree and stream visitor results instead of collecting them
+ *
+ * Visits nodes in the same order as nlink_traverse_tree, honouring
+ * should_traverse, but keeps no result arrays: each visitor result is
+ * passed to emit as soon as it is produced. Returning false from emit
+ * ends the traversal. The tree is walked with the workspace's explicit
+ * stack or queue, so depth is limited by memory rather than the call
+ * stack. collect_results is ignored.
+ *
+ * @param root Root node of the tree
+ * @param config Traversal configuration
+ * @param workspace Workspace to use, or NULL to use a temporary one
+ * @param emit Receives each node and its visitor result, or NULL
+ * @param emit_context Context passed to emit
+ * @return Whether the traversal completed, was stopped, or failed
+ */
+nlink_traversal_status nlink_traverse_tree_stream(
+    void* root,
+    const nlink_traversal_config* config,
+    nlink_traversal_workspace* workspace,
+    nlink_traversal_emit_fn emit,
+    void* emit_context
+);
+
 /**
  * @brief Free traversal result
  *
@@ -194,9 +277,63 @@ nlink_traversal_result* nlink_traverse_graph_bfs(
     void* context
 );
 
+/**
+ * @brief Depth-first graph traversal for nodes with dense integer IDs
+ *
+ * Same visiting order as nlink_traverse_graph_dfs, but visited nodes are
+ * tracked in a bitset indexed by get_id instead of a hash set. Use it
+ * when nodes already carry an index, e.g. their position in a node array.
+ *
+ * @param start Starting node
+ * @param get_adjacents Function to get adjacent nodes
+ * @param get_adjacent_count Function to get adjacent node count
+ * @param visitor Visitor function
+ * @param get_id Function returning a node's ID, below id_count and unique per node
+ * @param id_count Number of possible IDs
+ * @param context Context for traversal functions
+ * @return Traversal result structure, or NULL if an ID is out of range
+ */
+nlink_traversal_result* nlink_traverse_graph_dfs_dense(
+    void* start,
+    nlink_node_getter_fn get_adjacents,
+    nlink_child_count_fn get_adjacent_count,
+    nlink_visitor_fn visitor,
+    nlink_node_id_fn get_id,
+    size_t id_count,
+    void* context
+);
+
+/**
+ * @brief Breadth-first graph traversal for nodes with dense integer IDs
+ *
+ * Same visiting order as nlink_traverse_graph_bfs, with visited nodes
+ * tracked in a bitset indexed by get_id.
+ *
+ * @param start Starting node
+ * @param get_adjacents Function to get adjacent nodes
+ * @param get_adjacent_count Function to get adjacent node count
+ * @param visitor Visitor function
+ * @param get_id Function returning a node's ID, below id_count and unique per node
+ * @param id_count Number of possible IDs
+ * @param context Context for traversal functions
+ * @return Traversal result structure, or NULL if an ID is out of range
+ */
+nlink_traversal_result* nlink_traverse_graph_bfs_dense(
+    void* start,
+    nlink_node_getter_fn get_adjacents,
+    nlink_child_count_fn get_adjacent_count,
+    nlink_visitor_fn visitor,
+    nlink_node_id_fn get_id,
+    size_t id_count,
+    void* context
+);
+
 /**
  * @brief Check if a traversal has visited a specific node
  *
+ * Constant time: looks the node up in the result's index. For tree
+ * traversals the first lookup builds the index, in O(count).
+ *
  * @param result Traversal result
  * @param node Node to check
  * @return true if node was visited, false otherwise
@@ -206,6 +343,9 @@ bool nlink_traversal_visited(nlink_traversal_result* result, void* node);
 /**
  * @brief Get the result of visiting a specific node
  *
+ * Constant time. If the node was visited more than once, returns the
+ * result of the first visit.
+ *
  * @param result Traversal result
  * @param node Node to get result for
  * @return Result of visiting the node, or NULL if not found
@@ -0,0 +1,202 @@
+/**
+ * @file thread_pool.h
+ * @brief Work-stealing thread pool driven by nlink_thread_pool_config_t
+ *
+ * Each worker owns a Chase-Lev deque. Tasks submitted from a worker go to
+ * the bottom of its own deque and are popped LIFO, so a task's children
+ * tend to run on the thread that made them while their data is still in
+ * cache; idle workers steal the oldest tasks from the top of other
+ * deques. Tasks submitted from other threads go through a shared queue of
+ * queue_depth entries. A worker that finds no work spins for
+ * idle_timeout and then parks until new work arrives.
+ *
+ * Callers track completion with task groups. Waiting on a group runs
+ * queued tasks on the waiting thread instead of blocking it, so tasks may
+ * themselves submit subtasks and wait for them.
+ *
+ * Copyright © 2025 OBINexus Computing
+ */
+
+#ifndef NLINK_THREADING_THREAD_POOL_H
+#define NLINK_THREADING_THREAD_POOL_H
+
+#include "nlink/core/semverx/core/types.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief A thread pool (opaque)
+ */
+typedef struct nlink_thread_pool nlink_thread_pool_t;
+
+/**
+ * @brief Task entry point
+ */
+typedef void (*nlink_task_fn)(void* arg);
+
+/**
+ * @brief Set of tasks a caller waits for together
+ *
+ * Initialize with nlink_task_group_init() before the first submission. A
+ * group can be reused once a wait on it has returned.
+ */
+typedef struct nlink_task_group {
+    atomic_size_t pending;          /**< Submitted tasks not yet finished */
+} nlink_task_group_t;
+
+/**
+ * @brief Pool counters
+ *
+ * Counters accumulate over the pool's lifetime; subtract two snapshots to
+ * measure an interval.
+ */
+typedef struct nlink_thread_pool_stats {
+    uint32_t worker_count;          /**< Worker threads */
+    uint64_t tasks_submitted;       /**< Tasks accepted by submit */
+    uint64_t tasks_executed;        /**< Tasks run by workers or waiting threads */
+    uint64_t tasks_inline;          /**< Tasks run by the submitter because the shared queue was full */
+    uint64_t steals;                /**< Tasks taken from another worker's deque */
+    uint64_t parks;                 /**< Times a worker went to sleep after idle_timeout */
+    uint32_t pinned_workers;        /**< Workers bound to a CPU */
+} nlink_thread_pool_stats_t;
+
+/**
+ * @brief Default pool configuration
+ *
+ * One worker per online CPU, a 1024-entry shared queue, the system
+ * default stack size, work stealing on, no pinning and a 50 microsecond
+ * idle spin.
+ *
+ * @return nlink_thread_pool_config_t Default configuration
+ */
+nlink_thread_pool_config_t nlink_thread_pool_default_config(void);
+
+/**
+ * @brief Create a pool and start its workers
+ *
+ * A worker_count of 0 starts one worker per online CPU. queue_depth sizes
+ * the shared submission queue and the initial capacity of each worker
+ * deque; worker deques grow as needed. A stack_size_kb of 0 keeps the
+ * system default. With enable_thread_affinity, worker i is pinned to
+ * online CPU i modulo the CPU count where the platform supports it.
+ * Without enable_work_stealing, workers only run tasks from their own
+ * deque and the shared queue.
+ *
+ * @param config Pool configuration, or NULL for the defaults
+ * @return nlink_thread_pool_t* New pool or NULL on failure
+ */
+nlink_thread_pool_t* nlink_thread_pool_create(const nlink_thread_pool_config_t* config);
+
+/**
+ * @brief Initialize a task group
+ *
+ * @param group Group to initialize
+ */
+void nlink_task_group_init(nlink_task_group_t* group);
+
+/**
+ * @brief Queue a task
+ *
+ * From a worker of this pool the task goes onto that worker's deque.
+ * From any other thread it goes onto the shared queue; if the shared
+ * queue is full, or a task record cannot be allocated, the task runs on
+ * the calling thread before submit returns.
+ *
+ * @param pool Pool to run the task on
+ * @param fn Task entry point
+ * @param arg Argument passed to fn
+ * @param group Group the task belongs to, or NULL
+ * @return bool False if pool or fn is NULL
+ */
+bool nlink_thread_pool_submit(nlink_thread_pool_t* pool,
+                              nlink_task_fn fn,
+                              void* arg,
+                              nlink_task_group_t* group);
+
+/**
+ * @brief Wait until every task of a group has finished
+ *
+ * The calling thread runs queued tasks of the pool, from any group, while
+ * it waits.
+ *
+ * @param pool Pool the group's tasks were submitted to
+ * @param group Group to wait for
+ */
+void nlink_thread_pool_wait(nlink_thread_pool_t* pool, nlink_task_group_t* group);
+
+/**
+ * @brief Number of worker threads
+ *
+ * @param pool Pool
+ * @return size_t Worker count, 0 for NULL
+ */
+size_t nlink_thread_pool_worker_count(const nlink_thread_pool_t* pool);
+
+/**
+ * @brief Read the pool counters
+ *
+ * @param pool Pool
+ * @param stats Receives the counters
+ * @return bool False if pool or stats is NULL
+ */
+bool nlink_thread_pool_get_stats(const nlink_thread_pool_t* pool, nlink_thread_pool_stats_t* stats);
+
+/**
+ * @brief Run the remaining tasks, stop the workers and free the pool
+ *
+ * No task may be submitted concurrently with or after the destroy.
+ *
+ * @param pool Pool to destroy
+ */
+void nlink_thread_pool_destroy(nlink_thread_pool_t* pool);
+
+/**
+ * @brief Create the process-wide pool from a configuration
+ *
+ * Call once at startup, e.g. with the thread_pool section of the package
+ * configuration, before anything uses the shared pool.
+ *
+ * @param config Pool configuration, or NULL for the defaults
+ * @return bool False if the shared pool already exists or creation failed
+ */
+bool nlink_thread_pool_shared_init(const nlink_thread_pool_config_t* config);
+
+/**
+ * @brief The process-wide pool used by pipelines, minimization and telemetry
+ *
+ * Created with the default configuration on first use unless
+ * nlink_thread_pool_shared_init() ran first.
+ *
+ * @return nlink_thread_pool_t* Shared pool or NULL if it cannot be created
+ */
+nlink_thread_pool_t* nlink_thread_pool_shared(void);
+
+/**
+ * @brief The process-wide pool if it exists, without creating it
+ *
+ * For callers that only wait on work they submitted earlier: a pool that
+ * was shut down ran that work before it went away.
+ *
+ * @return nlink_thread_pool_t* Shared pool or NULL if there is none
+ */
+nlink_thread_pool_t* nlink_thread_pool_shared_current(void);
+
+/**
+ * @brief Destroy the process-wide pool
+ *
+ * Nothing may use the shared pool concurrently. A later call to
+ * nlink_thread_pool_shared() creates a new one.
+ */
+void nlink_thread_pool_shared_shutdown(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NLINK_THREADING_THREAD_POOL_H */
@@ -0,0 +1,233 @@
+/**
+ * @file lazy_binding_spec.c
+ * @brief Lazy Symbol Binding Performance Specifications
+ *
+ * Builds a component shared object, copies it into 200 component
+ * libraries and compares registering them eagerly (dlopen + dlsym up
+ * front) with registering them as lazy symbols. Reports registration
+ * time and RSS growth for both, then checks first-call binding and the
+ * cost of calls through a bound stub.
+ */
+
+#include "../spec_runner.c"
+#include "nlink/core/symbols/lazy_symbols.h"
+#include <dlfcn.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#define BENCH_COMPONENTS 200
+#define BENCH_CALLED_COMPONENTS 10
+#define BENCH_CALLS 10000000
+
+typedef int (*bench_entry_fn)(int);
+typedef long (*bench_mix_fn)(long, long, long, long, long, long, long, double);
+
+// Each component touches 256 KiB of static state when it is loaded
+static const char* bench_component_source =
+    "static volatile char component_state[256 * 1024] = { 1 };\n"
+    "__attribute__((constructor)) static void component_init(void) {\n"
+    "    for (unsigned long i = 0; i < sizeof(component_state); i += 4096) component_state[i]++;\n"
+    "}\n"
+    "int component_entry(int x) { return x * 2 + component_state[0]; }\n"
+    "long component_mix(long a, long b, long c, long d, long e, long f, long g, double h) {\n"
+    "    return a + b * 2 + c * 3 + d * 4 + e * 5 + f * 6 + g * 7 + (long)(h * 100.0);\n"
+    "}\n";
+
+static char bench_dir[] = "/tmp/nlink_lazy_spec_XXXXXX";
+
+static size_t bench_rss_kb(void) {
+    size_t pages = 0, resident = 0;
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (statm) {
+        if (fscanf(statm, "%zu %zu", &pages, &resident) != 2) {
+            resident = 0;
+        }
+        fclose(statm);
+    }
+    return resident * (size_t)sysconf(_SC_PAGESIZE) / 1024;
+}
+
+static bool bench_copy_file(const char* from, const char* to) {
+    FILE* in = fopen(from, "rb");
+    FILE* out = fopen(to, "wb");
+    bool ok = in && out;
+    char buffer[65536];
+    size_t n;
+    while (ok && (n = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+        ok = fwrite(buffer, 1, n, out) == n;
+    }
+    if (in) fclose(in);
+    if (out) fclose(out);
+    return ok;
+}
+
+static void bench_library_path(char* path, size_t size, const char* kind, int index) {
+    snprintf(path, size, "%s/%s_%03d.so", bench_dir, kind, index);
+}
+
+static bool bench_build_components(void) {
+    if (!mkdtemp(bench_dir)) {
+        return false;
+    }
+
+    char source[256], library[256], command[1024];
+    snprintf(source, sizeof(source), "%s/component.c", bench_dir);
+    snprintf(library, sizeof(library), "%s/component.so", bench_dir);
+
+    FILE* file = fopen(source, "w");
+    if (!file) {
+        return false;
+    }
+    fputs(bench_component_source, file);
+    fclose(file);
+
+    const char* cc = getenv("CC") ? getenv("CC") : "cc";
+    snprintf(command, sizeof(command), "%s -shared -fPIC -O2 -o %s %s", cc, library, source);
+    if (system(command) != 0) {
+        return false;
+    }
+
+    // Distinct paths so every component is a separate mapping
+    char path[256];
+    for (int i = 0; i < BENCH_COMPONENTS; i++) {
+        bench_library_path(path, sizeof(path), "eager", i);
+        if (!bench_copy_file(library, path)) return false;
+        bench_library_path(path, sizeof(path), "lazy", i);
+        if (!bench_copy_file(library, path)) return false;
+    }
+    return true;
+}
+
+static void bench_remove_components(void) {
+    char path[256];
+    for (int i = 0; i < BENCH_COMPONENTS; i++) {
+        bench_library_path(path, sizeof(path), "eager", i);
+        unlink(path);
+        bench_library_path(path, sizeof(path), "lazy", i);
+        unlink(path);
+    }
+    snprintf(path, sizeof(path), "%s/component.c", bench_dir);
+    unlink(path);
+    snprintf(path, sizeof(path), "%s/component.so", bench_dir);
+    unlink(path);
+    rmdir(bench_dir);
+}
+
+spec_result_t spec_lazy_binding_200_components(void) {
+    SPEC_ASSERT(bench_build_components(), "Building component libraries failed (is CC available?)");
+
+    NexusSymbolRegistry* registry = nexus_init_symbol_registry();
+    SPEC_ASSERT(registry != NULL, "Registry creation failed");
+
+    char name[64], component[64], path[256];
+    void* handles[BENCH_COMPONENTS];
+
+    // Eager: every component is mapped and initialized at startup
+    size_t rss_before = bench_rss_kb();
+    double start = spec_now_ms();
+    for (int i = 0; i < BENCH_COMPONENTS; i++) {
+        bench_library_path(path, sizeof(path), "eager", i);
+        handles[i] = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+        SPEC_ASSERT(handles[i] != NULL, "dlopen of eager component failed");
+
+        snprintf(name, sizeof(name), "eager_%d_entry", i);
+        snprintf(component, sizeof(component), "eager_component_%d", i);
+        SPEC_EXPECT_EQ(nexus_symbol_table_add(&registry->exported, name,
+                                              dlsym(handles[i], "component_entry"),
+                                              NEXUS_SYMBOL_FUNCTION, component), NEXUS_SUCCESS);
+    }
+    double eager_ms = spec_now_ms() - start;
+    size_t eager_rss = bench_rss_kb() - rss_before;
+
+    // Lazy: only stubs are registered
+    rss_before = bench_rss_kb();
+    start = spec_now_ms();
+    for (int i = 0; i < BENCH_COMPONENTS; i++) {
+        bench_library_path(path, sizeof(path), "lazy", i);
+        snprintf(name, sizeof(name), "lazy_%d_entry", i);
+        snprintf(component, sizeof(component), "lazy_component_%d", i);
+        SPEC_EXPECT_EQ(nexus_symbol_table_add_lazy(&registry->exported, name, "component_entry",
+                                                   component, path), NEXUS_SUCCESS);
+    }
+    double lazy_ms = spec_now_ms() - start;
+    size_t lazy_rss = bench_rss_kb() - rss_before;
+
+    printf("\n      eager: %7.2f ms, +%6zu KiB RSS for %d components\n", eager_ms, eager_rss, BENCH_COMPONENTS);
+    printf("      lazy:  %7.2f ms, +%6zu KiB RSS for %d components\n", lazy_ms, lazy_rss, BENCH_COMPONENTS);
+
+    size_t libraries = 0;
+    nexus_lazy_get_stats(NULL, NULL, &libraries);
+    SPEC_EXPECT_EQ(libraries, 0);
+
+    // First call through the stub loads just that component
+    bench_entry_fn stub = NULL;
+    for (int i = 0; i < BENCH_CALLED_COMPONENTS; i++) {
+        snprintf(name, sizeof(name), "lazy_%d_entry", i);
+        bench_entry_fn fn = (bench_entry_fn)nexus_resolve_symbol(registry, name);
+        SPEC_ASSERT(nexus_lazy_is_unbound_stub((void*)fn), "Lazy symbol resolved before first call");
+        SPEC_EXPECT_EQ(fn(21), 44);
+
+        // The registry now hands out the real address
+        bench_entry_fn bound = (bench_entry_fn)nexus_resolve_symbol(registry, name);
+        SPEC_ASSERT(bound != fn, "Registry entry was not patched");
+        SPEC_ASSERT(!nexus_lazy_is_unbound_stub((void*)bound), "Patched address is still a stub");
+        SPEC_EXPECT_EQ(bound(5), 12);
+        if (i == 0) {
+            stub = fn;
+        }
+    }
+    nexus_lazy_get_stats(NULL, NULL, &libraries);
+    SPEC_EXPECT_EQ(libraries, BENCH_CALLED_COMPONENTS);
+
+    // Arguments in every register class and on the stack survive binding
+    bench_library_path(path, sizeof(path), "lazy", BENCH_COMPONENTS - 1);
+    SPEC_EXPECT_EQ(nexus_symbol_table_add_lazy(&registry->exported, "lazy_mix", "component_mix",
+                                               "lazy_mix_component", path), NEXUS_SUCCESS);
+    bench_mix_fn mix = (bench_mix_fn)nexus_resolve_symbol(registry, "lazy_mix");
+    SPEC_EXPECT_EQ(mix(1, 2, 3, 4, 5, 6, 7, 0.5), 1 + 4 + 9 + 16 + 25 + 36 + 49 + 50);
+
+    // Calls through a bound stub cost one extra indirect jump
+    bench_entry_fn direct = (bench_entry_fn)nexus_resolve_symbol(registry, "lazy_0_entry");
+    bench_entry_fn volatile target = direct;
+    long sum = 0;
+    start = spec_now_ms();
+    for (int i = 0; i < BENCH_CALLS; i++) {
+        sum += target(i & 0xFF);
+    }
+    double direct_ms = spec_now_ms() - start;
+
+    target = stub;
+    start = spec_now_ms();
+    for (int i = 0; i < BENCH_CALLS; i++) {
+        sum -= target(i & 0xFF);
+    }
+    double stub_ms = spec_now_ms() - start;
+
+    printf("      %d calls: direct %.2f ms, through bound stub %.2f ms\n      ",
+           BENCH_CALLS, direct_ms, stub_ms);
+    SPEC_EXPECT_EQ(sum, 0);
+
+    nexus_cleanup_symbol_registry(registry);
+    nexus_lazy_cleanup();
+    for (int i = 0; i < BENCH_COMPONENTS; i++) {
+        dlclose(handles[i]);
+    }
+    bench_remove_components();
+    return SPEC_PASS;
+}
+
+int main() {
+    etps_init();
+
+    spec_suite_t* suite = spec_suite_create("Lazy_Binding_Performance_Specs");
+
+    spec_add_test(suite, "Startup and RSS for 200 components, eager vs lazy", spec_lazy_binding_200_components);
+
+    int result = spec_suite_run(suite);
+
+    spec_suite_destroy(suite);
+    nexus_intern_cleanup();
+    etps_shutdown();
+
+    return result;
+}
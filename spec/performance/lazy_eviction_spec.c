@@ -0,0 +1,243 @@
+/**
+ * @file lazy_eviction_spec.c
+ * @brief Lazy Versioned Unloading Performance Specifications
+ *
+ * Registers a lazily loaded component, resolves one of its symbols and
+ * lets it go idle. A pinned component must survive the unloader; once
+ * unpinned and idle past the timeout its symbols are dropped, resolution
+ * falls back to the global table, and after the component is loaded
+ * again the same name resolves to the new address. A second spec holds a
+ * pin from nexus_resolve_versioned_symbol_pinned() across the unloader.
+ * The last two check that an evicted component's global and imported
+ * entries go with its exported ones and stay gone after a reload, and
+ * that dropping many components keeps the survivors resolvable.
+ */
+
+#include "../spec_runner.c"
+#include "nlink/core/semverx/lazy_versioned.h"
+#include <stdint.h>
+#include <unistd.h>
+
+static NexusHandleRegistry spec_handles = { NULL, NULL, NULL, 0, PTHREAD_MUTEX_INITIALIZER };
+
+// Idle deadlines have one-second resolution
+#define IDLE_WAIT_SEC 2
+
+spec_result_t spec_lazy_eviction_resolve_again(void) {
+    VersionedSymbolRegistry* registry = nexus_versioned_registry_create();
+    SPEC_ASSERT(registry != NULL, "Registry creation failed");
+
+    void* loaded = (void*)(uintptr_t)0x100;
+    void* reloaded = (void*)(uintptr_t)0x200;
+    void* fallback = (void*)(uintptr_t)0x900;
+
+    // Unload as soon as a component has been idle for a full second
+    nexus_versioned_lazy_config.auto_unload = true;
+    nexus_versioned_lazy_config.unload_timeout_sec = 0;
+    nexus_handle_registry = &spec_handles;
+
+    NexusComponentUsage* usage = nexus_component_usage_register("lib_lazy", NULL);
+    SPEC_ASSERT(usage != NULL, "Usage registration failed");
+    versioned_symbol_table_add(&registry->exported, "render", "1.2.0", loaded, VSYMBOL_FUNCTION, "lib_lazy", 0);
+    versioned_symbol_table_add(&registry->global, "render", "1.0.0", fallback, VSYMBOL_FUNCTION, "core", 0);
+    SPEC_ASSERT(registry->exported.symbols[0].usage == usage, "Symbol not bound to its usage record");
+    SPEC_ASSERT(registry->global.symbols[0].usage == NULL, "Static component got a usage record");
+
+    // Resolution touches the component and drops its pin again
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "render", "^1.0.0", "app") == loaded,
+                "Initial resolution");
+    SPEC_EXPECT_EQ(nexus_component_usage_live_refs(usage), (long)0);
+
+    // A pinned component outlives its idle deadline
+    SPEC_ASSERT(nexus_component_usage_acquire(usage), "Pin refused");
+    sleep(IDLE_WAIT_SEC);
+    nexus_check_unused_versioned_libraries(registry);
+    SPEC_ASSERT(nexus_component_usage_active(usage), "Pinned component unloaded");
+    SPEC_EXPECT_EQ(registry->exported.size, (size_t)1);
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "render", "^1.0.0", "app") == loaded,
+                "Pinned symbol not resolved");
+    nexus_component_usage_release(usage);
+
+    // Unpinned and idle: the symbol goes and the cached resolution with it
+    uint64_t generation = nexus_versioned_registry_generation(registry);
+    sleep(IDLE_WAIT_SEC);
+    nexus_check_unused_versioned_libraries(registry);
+    SPEC_ASSERT(!nexus_component_usage_active(usage), "Idle component not unloaded");
+    SPEC_EXPECT_EQ(registry->exported.size, (size_t)0);
+    SPEC_ASSERT(nexus_versioned_registry_generation(registry) != generation, "Unload kept the generation");
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "render", "^1.0.0", "app") == fallback,
+                "Unloaded symbol still resolved");
+
+    // Loading the component again brings the symbol back
+    SPEC_ASSERT(nexus_component_usage_register("lib_lazy", NULL) == usage, "Usage record not reused");
+    versioned_symbol_table_add(&registry->exported, "render", "1.2.0", reloaded, VSYMBOL_FUNCTION, "lib_lazy", 0);
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "render", "^1.0.0", "app") == reloaded,
+                "Reloaded symbol not resolved");
+    SPEC_ASSERT(nexus_component_usage_active(usage), "Reloaded component inactive");
+
+    nexus_versioned_registry_free(registry);
+    nexus_component_usage_cleanup();
+    nexus_handle_registry = NULL;
+    return SPEC_PASS;
+}
+
+spec_result_t spec_lazy_eviction_pinned_resolution(void) {
+    VersionedSymbolRegistry* registry = nexus_versioned_registry_create();
+    SPEC_ASSERT(registry != NULL, "Registry creation failed");
+
+    void* loaded = (void*)(uintptr_t)0x100;
+
+    nexus_versioned_lazy_config.auto_unload = true;
+    nexus_versioned_lazy_config.unload_timeout_sec = 0;
+    nexus_handle_registry = &spec_handles;
+
+    NexusComponentUsage* usage = nexus_component_usage_register("lib_pinned", NULL);
+    SPEC_ASSERT(usage != NULL, "Usage registration failed");
+    versioned_symbol_table_add(&registry->exported, "draw", "2.0.0", loaded, VSYMBOL_FUNCTION, "lib_pinned", 0);
+
+    // The caller holds the pin until it is done with the address
+    NexusComponentUsage* pin = NULL;
+    SPEC_ASSERT(nexus_resolve_versioned_symbol_pinned(registry, "draw", "^2.0.0", "app", &pin) == loaded,
+                "Pinned resolution");
+    SPEC_ASSERT(pin == usage, "Pin is not the provider's usage record");
+    SPEC_EXPECT_EQ(nexus_component_usage_live_refs(usage), (long)1);
+
+    sleep(IDLE_WAIT_SEC);
+    nexus_check_unused_versioned_libraries(registry);
+    SPEC_ASSERT(nexus_component_usage_active(usage), "Pinned provider unloaded");
+    SPEC_EXPECT_EQ(registry->exported.size, (size_t)1);
+
+    // Once released, the provider can go idle and unload
+    nexus_versioned_symbol_release(pin);
+    SPEC_EXPECT_EQ(nexus_component_usage_live_refs(usage), (long)0);
+    sleep(IDLE_WAIT_SEC);
+    nexus_check_unused_versioned_libraries(registry);
+    SPEC_ASSERT(!nexus_component_usage_active(usage), "Released provider not unloaded");
+
+    // Nothing resolved, nothing pinned
+    pin = usage;
+    SPEC_ASSERT(nexus_resolve_versioned_symbol_pinned(registry, "draw", "^2.0.0", "app", &pin) == NULL,
+                "Unloaded symbol resolved");
+    SPEC_ASSERT(pin == NULL, "Failed resolution returned a pin");
+
+    nexus_versioned_registry_free(registry);
+    nexus_component_usage_cleanup();
+    nexus_handle_registry = NULL;
+    return SPEC_PASS;
+}
+
+spec_result_t spec_lazy_eviction_every_table(void) {
+    VersionedSymbolRegistry* registry = nexus_versioned_registry_create();
+    SPEC_ASSERT(registry != NULL, "Registry creation failed");
+
+    void* draw = (void*)(uintptr_t)0x100;
+    void* blit = (void*)(uintptr_t)0x200;
+    void* fmt = (void*)(uintptr_t)0x300;
+    VersionedSymbol** found = NULL;
+
+    nexus_versioned_lazy_config.auto_unload = true;
+    nexus_versioned_lazy_config.unload_timeout_sec = 0;
+    nexus_handle_registry = &spec_handles;
+
+    NexusComponentUsage* usage = nexus_component_usage_register("lib_gfx", NULL);
+    SPEC_ASSERT(usage != NULL, "Usage registration failed");
+    versioned_symbol_table_add(&registry->exported, "draw", "1.0.0", draw, VSYMBOL_FUNCTION, "lib_gfx", 0);
+    versioned_symbol_table_add(&registry->global, "blit", "1.0.0", blit, VSYMBOL_FUNCTION, "lib_gfx", 0);
+    versioned_symbol_table_add(&registry->exported, "fmt", "1.0.0", fmt, VSYMBOL_FUNCTION, "lib_text", 0);
+
+    // One import provided by the component, one it requested
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "draw", NULL, "app") == draw, "Provided import");
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "fmt", NULL, "lib_gfx") == fmt, "Requested import");
+    SPEC_EXPECT_EQ(registry->imported.size, (size_t)2);
+
+    sleep(IDLE_WAIT_SEC);
+    nexus_check_unused_versioned_libraries(registry);
+    SPEC_ASSERT(!nexus_component_usage_active(usage), "Idle component not unloaded");
+    SPEC_EXPECT_EQ(versioned_symbol_table_find_all(&registry->exported, "draw", &found), (size_t)0);
+    SPEC_EXPECT_EQ(versioned_symbol_table_find_all(&registry->global, "blit", &found), (size_t)0);
+    SPEC_EXPECT_EQ(versioned_symbol_table_find_all(&registry->imported, "draw", &found), (size_t)0);
+    SPEC_EXPECT_EQ(versioned_symbol_table_find_all(&registry->imported, "fmt", &found), (size_t)0);
+    SPEC_EXPECT_EQ(versioned_symbol_table_find_all(&registry->exported, "fmt", &found), (size_t)1);
+    free(found);
+
+    // Reloading reactivates the usage record, not the dropped entries
+    SPEC_ASSERT(nexus_component_usage_register("lib_gfx", NULL) == usage, "Usage record not reused");
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "blit", NULL, "app") == NULL,
+                "Global entry of the unloaded component resolved after reload");
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "draw", NULL, "app") == NULL,
+                "Exported entry of the unloaded component resolved after reload");
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "fmt", NULL, "app") == fmt,
+                "Other component's symbol lost");
+
+    nexus_versioned_registry_free(registry);
+    nexus_component_usage_cleanup();
+    nexus_handle_registry = NULL;
+    return SPEC_PASS;
+}
+
+#define DROP_COMPONENTS 256
+#define DROP_SYMBOLS_EACH 4
+
+spec_result_t spec_lazy_eviction_drop_many(void) {
+    VersionedSymbolRegistry* registry = nexus_versioned_registry_create();
+    SPEC_ASSERT(registry != NULL, "Registry creation failed");
+
+    char name[64], component[64];
+    for (int c = 0; c < DROP_COMPONENTS; c++) {
+        snprintf(component, sizeof(component), "lib_%d", c);
+        for (int s = 0; s < DROP_SYMBOLS_EACH; s++) {
+            snprintf(name, sizeof(name), "sym_%d_%d", c, s);
+            versioned_symbol_table_add(&registry->exported, name, "1.0.0",
+                                       (void*)(uintptr_t)(c * DROP_SYMBOLS_EACH + s + 1),
+                                       VSYMBOL_FUNCTION, component, 0);
+        }
+    }
+
+    // Drop three components in four; the table compacts along the way
+    for (int c = 0; c < DROP_COMPONENTS; c++) {
+        if (c % 4 != 0) {
+            snprintf(component, sizeof(component), "lib_%d", c);
+            nexus_versioned_registry_drop_component(registry, component);
+        }
+    }
+    SPEC_ASSERT(registry->exported.size < (size_t)(DROP_COMPONENTS * DROP_SYMBOLS_EACH / 2),
+                "Dropped entries never compacted");
+
+    // Survivors resolve to their own addresses, dropped names to nothing
+    for (int c = 0; c < DROP_COMPONENTS; c++) {
+        for (int s = 0; s < DROP_SYMBOLS_EACH; s++) {
+            snprintf(name, sizeof(name), "sym_%d_%d", c, s);
+            void* expected = c % 4 == 0 ? (void*)(uintptr_t)(c * DROP_SYMBOLS_EACH + s + 1) : NULL;
+            SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, name, NULL, "app") == expected,
+                        "Wrong resolution after drops");
+        }
+    }
+
+    // Lists renumbered by compaction still drop the right entries
+    nexus_versioned_registry_drop_component(registry, "lib_0");
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "sym_0_0", NULL, "app") == NULL,
+                "Entry survived a drop after compaction");
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "sym_4_0", NULL, "app") ==
+                (void*)(uintptr_t)(4 * DROP_SYMBOLS_EACH + 1), "Wrong entry dropped after compaction");
+
+    nexus_versioned_registry_free(registry);
+    return SPEC_PASS;
+}
+
+int main() {
+    etps_init();
+
+    spec_suite_t* suite = spec_suite_create("Lazy_Eviction_Performance_Specs");
+
+    spec_add_test(suite, "Evicted symbols resolve again after a reload", spec_lazy_eviction_resolve_again);
+    spec_add_test(suite, "A pinned resolution keeps its provider loaded", spec_lazy_eviction_pinned_resolution);
+    spec_add_test(suite, "Eviction drops the component from every table", spec_lazy_eviction_every_table);
+    spec_add_test(suite, "Dropping many components keeps the rest resolvable", spec_lazy_eviction_drop_many);
+
+    int result = spec_suite_run(suite);
+
+    spec_suite_destroy(suite);
+    etps_shutdown();
+
+    return result;
+}
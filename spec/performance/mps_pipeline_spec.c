@@ -0,0 +1,284 @@
+/**
+ * @file mps_pipeline_spec.c
+ * @brief Multi-Pass Pipeline Engine Performance Specifications
+ *
+ * Runs in-process components through the multi-pass engine. A feedback
+ * loop must iterate to the same fixed point with and without the
+ * worklist, and the worklist must save executions. An optional component
+ * that cannot be loaded is passed through instead of failing the run.
+ * Wide levels run on the shared thread pool, and the worker count can
+ * change between executions: one worker keeps every group on the calling
+ * thread, more spread a wide level over at most that many threads.
+ */
+
+#include "../spec_runner.c"
+#include "nlink/mpsystem/mps_pipeline.h"
+#include "nlink/mpsystem/mps_stream.h"
+#include "nlink/core/threading/thread_pool.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#define BENCH_FIXED_POINT 5
+#define BENCH_WIDE_GROUPS 4
+#define BENCH_GROUP_SLEEP_US 20000
+
+static uint8_t bench_read_byte(const NexusMPSDataStream* input) {
+    return input->size > 0 ? ((const uint8_t*)input->data)[0] : 0;
+}
+
+// Steps its input towards BENCH_FIXED_POINT
+static NexusResult bench_step(NexusMPSPipelineComponent* component,
+                              NexusMPSDataStream* input,
+                              NexusMPSDataStream* output) {
+    (void)component;
+    uint8_t value = bench_read_byte(input);
+    if (value < BENCH_FIXED_POINT) {
+        value++;
+    }
+    return mps_stream_write(output, &value, 1);
+}
+
+// Forwards its input, reporting a hash so the unchanged check is cheap
+static NexusResult bench_copy(NexusMPSPipelineComponent* component,
+                              NexusMPSDataStream* input,
+                              NexusMPSDataStream* output) {
+    (void)component;
+    uint8_t value = bench_read_byte(input);
+    NexusResult result = mps_stream_write(output, &value, 1);
+    mps_stream_set_content_hash(output, value * 31u + 7u);
+    return result;
+}
+
+static NexusResult bench_increment(NexusMPSPipelineComponent* component,
+                                   NexusMPSDataStream* input,
+                                   NexusMPSDataStream* output) {
+    (void)component;
+    uint8_t value = (uint8_t)(bench_read_byte(input) + 1);
+    return mps_stream_write(output, &value, 1);
+}
+
+// Threads that ran each group of the wide level
+static pthread_t bench_group_threads[BENCH_WIDE_GROUPS];
+
+static NexusResult bench_record_thread(NexusMPSPipelineComponent* component,
+                                       NexusMPSDataStream* input,
+                                       NexusMPSDataStream* output) {
+    (void)input;
+    int group = component->component_id[1] - '0';
+    bench_group_threads[group] = pthread_self();
+    usleep(BENCH_GROUP_SLEEP_US);
+    uint8_t value = (uint8_t)group;
+    return mps_stream_write(output, &value, 1);
+}
+
+static size_t bench_distinct_threads(void) {
+    size_t distinct = 0;
+    for (size_t i = 0; i < BENCH_WIDE_GROUPS; i++) {
+        bool seen = false;
+        for (size_t j = 0; j < i; j++) {
+            seen = seen || pthread_equal(bench_group_threads[i], bench_group_threads[j]);
+        }
+        distinct += seen ? 0 : 1;
+    }
+    return distinct;
+}
+
+static bool bench_all_on(pthread_t thread) {
+    for (size_t i = 0; i < BENCH_WIDE_GROUPS; i++) {
+        if (!pthread_equal(bench_group_threads[i], thread)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+spec_result_t spec_mps_pipeline_fixed_point(void) {
+    NexusConfig context_config = {0};
+    context_config.log_level = NEXUS_LOG_ERROR;
+    NexusContext* ctx = nexus_create_context(&context_config);
+    SPEC_ASSERT(ctx != NULL, "Context creation failed");
+
+    // a -> b -> c -> a, with a second loop back through d
+    NexusMPSComponentConfig a = { .component_id = "a", .supports_reentrance = true };
+    NexusMPSComponentConfig b = { .component_id = "b", .supports_reentrance = true };
+    NexusMPSComponentConfig c = { .component_id = "c", .supports_reentrance = true };
+    NexusMPSComponentConfig d = { .component_id = "d", .supports_reentrance = true };
+    NexusMPSComponentConfig* components[] = { &a, &b, &c, &d };
+    NexusComponentConnection ab = { "a", "b", NEXUS_DIRECTION_FORWARD, "binary", false };
+    NexusComponentConnection bc = { "b", "c", NEXUS_DIRECTION_FORWARD, "binary", false };
+    NexusComponentConnection ca = { "c", "a", NEXUS_DIRECTION_FORWARD, "binary", false };
+    NexusComponentConnection cd = { "c", "d", NEXUS_DIRECTION_FORWARD, "binary", false };
+    NexusComponentConnection da = { "d", "a", NEXUS_DIRECTION_FORWARD, "binary", false };
+    NexusComponentConnection* connections[] = { &ab, &bc, &ca, &cd, &da };
+    NexusMPSConfig config = {
+        .pipeline_id = "mps_fixed_point",
+        .components = components,
+        .component_count = 4,
+        .connections = connections,
+        .connection_count = 5,
+        .allow_cycles = true,
+        .max_iteration_count = 50,
+    };
+
+    int executions[2];
+    double elapsed[2];
+    for (int worklist = 0; worklist < 2; worklist++) {
+        NexusMPSPipeline* pipeline = mps_pipeline_create(ctx, &config);
+        SPEC_ASSERT(pipeline != NULL, "Pipeline creation failed");
+        pipeline->components[0]->process_func = bench_step;
+        for (size_t i = 1; i < pipeline->component_count; i++) {
+            pipeline->components[i]->process_func = bench_copy;
+        }
+        mps_pipeline_set_worklist(pipeline, worklist != 0);
+
+        double start = spec_now_ms();
+        SPEC_EXPECT_EQ(mps_pipeline_execute(ctx, pipeline, NULL, NULL), NEXUS_SUCCESS);
+        elapsed[worklist] = spec_now_ms() - start;
+
+        // Every member settles on the fixed point
+        for (size_t i = 0; i < pipeline->component_count; i++) {
+            NexusMPSDataStream view;
+            mps_stream_view_published(pipeline->components[i]->output, &view);
+            SPEC_EXPECT_EQ(view.size, (size_t)1);
+            SPEC_EXPECT_EQ(bench_read_byte(&view), BENCH_FIXED_POINT);
+        }
+
+        NexusMPSPipelineStats stats;
+        mps_pipeline_get_stats(pipeline, &stats);
+        SPEC_EXPECT_EQ(stats.cycle_count, 1);
+        SPEC_ASSERT(stats.total_iterations < 50, "Cycle did not converge");
+        SPEC_ASSERT(worklist || stats.skipped_component_executions == 0, "Skipped without a worklist");
+        executions[worklist] = stats.total_component_executions;
+        mps_pipeline_destroy(ctx, pipeline);
+    }
+
+    SPEC_ASSERT(executions[1] < executions[0], "Worklist saved no executions");
+    printf("\n      Fixed point: %d executions in %.3f ms, %d with the worklist in %.3f ms\n      ",
+           executions[0], elapsed[0], executions[1], elapsed[1]);
+
+    nexus_destroy_context(ctx);
+    return SPEC_PASS;
+}
+
+spec_result_t spec_mps_pipeline_optional_unloaded(void) {
+    NexusConfig context_config = {0};
+    context_config.log_level = NEXUS_LOG_ERROR;
+    NexusContext* ctx = nexus_create_context(&context_config);
+    SPEC_ASSERT(ctx != NULL, "Context creation failed");
+
+    // The middle component has no library; being optional, it is skipped
+    NexusMPSComponentConfig first = { .component_id = "first" };
+    NexusMPSComponentConfig missing = { .component_id = "missing", .optional = true };
+    NexusMPSComponentConfig last = { .component_id = "last" };
+    NexusMPSComponentConfig* components[] = { &first, &missing, &last };
+    NexusComponentConnection to_missing = { "first", "missing", NEXUS_DIRECTION_FORWARD, "binary", false };
+    NexusComponentConnection to_last = { "missing", "last", NEXUS_DIRECTION_FORWARD, "binary", false };
+    NexusComponentConnection* connections[] = { &to_missing, &to_last };
+    NexusMPSConfig config = {
+        .pipeline_id = "mps_optional",
+        .components = components,
+        .component_count = 3,
+        .connections = connections,
+        .connection_count = 2,
+    };
+
+    NexusMPSPipeline* pipeline = mps_pipeline_create(ctx, &config);
+    SPEC_ASSERT(pipeline != NULL, "Pipeline creation failed");
+    pipeline->components[0]->process_func = bench_increment;
+    pipeline->components[2]->process_func = bench_increment;
+
+    NexusMPSDataStream* input = mps_stream_create(0);
+    NexusMPSDataStream* output = mps_stream_create(0);
+    SPEC_ASSERT(input && output, "Stream creation failed");
+    uint8_t value = 40;
+    SPEC_EXPECT_EQ(mps_stream_write(input, &value, 1), NEXUS_SUCCESS);
+
+    SPEC_EXPECT_EQ(mps_pipeline_execute(ctx, pipeline, input, output), NEXUS_SUCCESS);
+    SPEC_ASSERT(!pipeline->components[1]->is_initialized, "Unloaded component initialized");
+    SPEC_EXPECT_EQ(output->size, (size_t)1);
+    SPEC_EXPECT_EQ(bench_read_byte(output), 42);
+
+    // A second run takes the same path
+    mps_stream_clear(output);
+    SPEC_EXPECT_EQ(mps_pipeline_execute(ctx, pipeline, input, output), NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(bench_read_byte(output), 42);
+
+    mps_stream_destroy(input);
+    mps_stream_destroy(output);
+    mps_pipeline_destroy(ctx, pipeline);
+    nexus_destroy_context(ctx);
+    return SPEC_PASS;
+}
+
+spec_result_t spec_mps_pipeline_worker_resize(void) {
+    NexusConfig context_config = {0};
+    context_config.log_level = NEXUS_LOG_ERROR;
+    NexusContext* ctx = nexus_create_context(&context_config);
+    SPEC_ASSERT(ctx != NULL, "Context creation failed");
+
+    // Four unconnected components: one level of four groups
+    NexusMPSComponentConfig w0 = { .component_id = "w0" };
+    NexusMPSComponentConfig w1 = { .component_id = "w1" };
+    NexusMPSComponentConfig w2 = { .component_id = "w2" };
+    NexusMPSComponentConfig w3 = { .component_id = "w3" };
+    NexusMPSComponentConfig* components[] = { &w0, &w1, &w2, &w3 };
+    NexusMPSConfig config = {
+        .pipeline_id = "mps_workers",
+        .components = components,
+        .component_count = BENCH_WIDE_GROUPS,
+    };
+
+    NexusMPSPipeline* pipeline = mps_pipeline_create(ctx, &config);
+    SPEC_ASSERT(pipeline != NULL, "Pipeline creation failed");
+    for (size_t i = 0; i < pipeline->component_count; i++) {
+        pipeline->components[i]->process_func = bench_record_thread;
+    }
+
+    static const size_t worker_counts[] = { BENCH_WIDE_GROUPS, 1, 2, 1 };
+    for (size_t run = 0; run < sizeof(worker_counts) / sizeof(worker_counts[0]); run++) {
+        size_t workers = worker_counts[run];
+        mps_pipeline_set_worker_count(pipeline, workers);
+
+        double start = spec_now_ms();
+        SPEC_EXPECT_EQ(mps_pipeline_execute(ctx, pipeline, NULL, NULL), NEXUS_SUCCESS);
+        double elapsed = spec_now_ms() - start;
+
+        size_t distinct = bench_distinct_threads();
+        printf("\n      %zu worker(s): %zu thread(s) ran the level in %.2f ms",
+               workers, distinct, elapsed);
+        if (workers == 1) {
+            SPEC_ASSERT(bench_all_on(pthread_self()), "Sequential run left the calling thread");
+        } else {
+            SPEC_ASSERT(distinct > 1, "Level did not spread over the workers");
+            SPEC_ASSERT(distinct <= workers, "More threads than workers");
+        }
+    }
+    printf("\n      ");
+
+    mps_pipeline_destroy(ctx, pipeline);
+    nexus_destroy_context(ctx);
+    return SPEC_PASS;
+}
+
+int main() {
+    // Enough shared workers for the widest level, whatever the CPU count
+    nlink_thread_pool_config_t pool_config = nlink_thread_pool_default_config();
+    pool_config.worker_count = BENCH_WIDE_GROUPS;
+    nlink_thread_pool_shared_init(&pool_config);
+    etps_init();
+
+    spec_suite_t* suite = spec_suite_create("MPS_Pipeline_Performance_Specs");
+
+    spec_add_test(suite, "Feedback loops iterate to their fixed point", spec_mps_pipeline_fixed_point);
+    spec_add_test(suite, "Unloaded optional components are passed through", spec_mps_pipeline_optional_unloaded);
+    spec_add_test(suite, "Worker count bounds the threads of a wide level", spec_mps_pipeline_worker_resize);
+
+    int result = spec_suite_run(suite);
+
+    spec_suite_destroy(suite);
+    etps_shutdown();
+    nlink_thread_pool_shared_shutdown();
+
+    return result;
+}
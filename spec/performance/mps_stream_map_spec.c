@@ -0,0 +1,202 @@
+/**
+ * @file mps_stream_map_spec.c
+ * @brief Multi-Pass Stream Map Performance Specifications
+ *
+ * Connects three components with double-buffered outputs, including a
+ * feedback edge, and queries the map before and after the outputs are
+ * published. The buffer swap must not disturb the index: every query
+ * returns the same streams and peer IDs in insertion order, and readers
+ * see the published pass while the writer fills the next one. Adding a
+ * connection after the swap rebuilds the index on the next query. The
+ * last spec times the allocation-free slice queries.
+ */
+
+#include "../spec_runner.c"
+#include "nlink/mpsystem/mps_stream.h"
+#include "nlink/core/symbols/intern.h"
+#include <stdint.h>
+
+#define BENCH_QUERY_COUNT 1000000
+
+// Whether the published side of a stream holds a single byte equal to value
+static bool bench_published_is(const NexusMPSDataStream* stream, uint8_t value) {
+    NexusMPSDataStream view;
+    mps_stream_view_published(stream, &view);
+    return view.size == 1 && ((const uint8_t*)view.data)[0] == value;
+}
+
+// Check a get_outgoing/get_incoming result against the expected streams and peers
+static bool bench_edges_are(NexusMPSDataStream** streams, char** peers, size_t count,
+                            NexusMPSDataStream* const* expected_streams,
+                            const char* const* expected_peers, size_t expected_count) {
+    if (count != expected_count) {
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (streams[i] != expected_streams[i] || peers[i] != nexus_intern(expected_peers[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+spec_result_t spec_mps_stream_map_after_swap(void) {
+    NexusMPSDataStream* a = mps_stream_create_double_buffered(0);
+    NexusMPSDataStream* b = mps_stream_create_double_buffered(0);
+    NexusMPSDataStream* c = mps_stream_create_double_buffered(0);
+    NexusMPSDataStreamMap* map = mps_stream_map_create(2);
+    SPEC_ASSERT(a && b && c && map, "Creation failed");
+
+    // Each edge carries its source's output; c feeds back into a
+    SPEC_EXPECT_EQ(mps_stream_map_add(map, "a", "b", a), NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(mps_stream_map_add(map, "a", "c", a), NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(mps_stream_map_add(map, "b", "c", b), NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(mps_stream_map_add(map, "c", "a", c), NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(mps_stream_map_build_index(map), NEXUS_SUCCESS);
+
+    NexusMPSDataStream** streams = NULL;
+    char** peers = NULL;
+    size_t count = 0;
+
+    // Two passes: write, publish, then query the map while the next pass is written
+    for (uint8_t pass = 1; pass <= 2; pass++) {
+        uint8_t values[3] = { pass, (uint8_t)(pass + 10), (uint8_t)(pass + 20) };
+        SPEC_EXPECT_EQ(mps_stream_write(a, &values[0], 1), NEXUS_SUCCESS);
+        SPEC_EXPECT_EQ(mps_stream_write(b, &values[1], 1), NEXUS_SUCCESS);
+        SPEC_EXPECT_EQ(mps_stream_write(c, &values[2], 1), NEXUS_SUCCESS);
+        SPEC_EXPECT_EQ(mps_stream_publish(a), NEXUS_SUCCESS);
+        SPEC_EXPECT_EQ(mps_stream_publish(b), NEXUS_SUCCESS);
+        SPEC_EXPECT_EQ(mps_stream_publish(c), NEXUS_SUCCESS);
+        SPEC_EXPECT_EQ(a->generation, (int)pass);
+
+        // The write side starts the next pass without touching what readers see
+        uint8_t scratch = 0xFF;
+        SPEC_EXPECT_EQ(mps_stream_write(a, &scratch, 1), NEXUS_SUCCESS);
+
+        NexusMPSDataStream* a_out[] = { a, a };
+        const char* a_targets[] = { "b", "c" };
+        SPEC_EXPECT_EQ(mps_stream_map_get_outgoing(map, "a", &streams, &peers, &count), NEXUS_SUCCESS);
+        SPEC_ASSERT(bench_edges_are(streams, peers, count, a_out, a_targets, 2), "Outgoing edges of a");
+        free(streams);
+        free(peers);
+
+        NexusMPSDataStream* c_in[] = { a, b };
+        const char* c_sources[] = { "a", "b" };
+        SPEC_EXPECT_EQ(mps_stream_map_get_incoming(map, "c", &streams, &peers, &count), NEXUS_SUCCESS);
+        SPEC_ASSERT(bench_edges_are(streams, peers, count, c_in, c_sources, 2), "Incoming edges of c");
+        SPEC_ASSERT(bench_published_is(streams[0], values[0]), "Reader of a saw the write side");
+        SPEC_ASSERT(bench_published_is(streams[1], values[1]), "Reader of b saw the wrong pass");
+        free(streams);
+        free(peers);
+
+        NexusMPSDataStream* a_in[] = { c };
+        const char* a_sources[] = { "c" };
+        SPEC_EXPECT_EQ(mps_stream_map_get_incoming(map, "a", &streams, &peers, &count), NEXUS_SUCCESS);
+        SPEC_ASSERT(bench_edges_are(streams, peers, count, a_in, a_sources, 1), "Feedback edge into a");
+        SPEC_ASSERT(bench_published_is(streams[0], values[2]), "Feedback reader saw the wrong pass");
+        free(streams);
+        free(peers);
+
+        mps_stream_clear(a);
+    }
+
+    // IDs that are not the interned pointers find the same component
+    char id_copy[] = "b";
+    SPEC_EXPECT_EQ(mps_stream_map_get_outgoing(map, id_copy, &streams, NULL, &count), NEXUS_SUCCESS);
+    SPEC_ASSERT(count == 1 && streams[0] == b, "Lookup by an uninterned ID");
+    free(streams);
+
+    // A connection added after the swap shows up once the index is rebuilt;
+    // until then queries find nothing instead of rebuilding it themselves
+    SPEC_EXPECT_EQ(mps_stream_map_add(map, "b", "a", b), NEXUS_SUCCESS);
+    MPSStreamMapEntry* const* entries = NULL;
+    SPEC_EXPECT_EQ(mps_stream_map_outgoing(map, mps_stream_map_component_index(map, "b"), &entries), (size_t)0);
+    SPEC_ASSERT(mps_stream_map_get(map, "a", "b") == NULL, "Stale index answered a lookup");
+    SPEC_EXPECT_EQ(mps_stream_map_get_outgoing(map, "b", &streams, &peers, &count), NEXUS_INVALID_OPERATION);
+    SPEC_EXPECT_EQ(mps_stream_map_build_index(map), NEXUS_SUCCESS);
+    NexusMPSDataStream* b_out[] = { b, b };
+    const char* b_targets[] = { "c", "a" };
+    SPEC_EXPECT_EQ(mps_stream_map_get_outgoing(map, "b", &streams, &peers, &count), NEXUS_SUCCESS);
+    SPEC_ASSERT(bench_edges_are(streams, peers, count, b_out, b_targets, 2), "Outgoing edges after an add");
+    free(streams);
+    free(peers);
+
+    NexusMPSDataStream* a_in[] = { c, b };
+    const char* a_sources[] = { "c", "b" };
+    SPEC_EXPECT_EQ(mps_stream_map_get_incoming(map, "a", &streams, &peers, &count), NEXUS_SUCCESS);
+    SPEC_ASSERT(bench_edges_are(streams, peers, count, a_in, a_sources, 2), "Incoming edges after an add");
+    free(streams);
+    free(peers);
+
+    // An unknown component has no connections
+    SPEC_EXPECT_EQ(mps_stream_map_get_incoming(map, "missing", &streams, &peers, &count), NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(count, (size_t)0);
+    free(streams);
+    free(peers);
+
+    mps_stream_map_destroy(map);
+    mps_stream_destroy(a);
+    mps_stream_destroy(b);
+    mps_stream_destroy(c);
+    return SPEC_PASS;
+}
+
+spec_result_t spec_mps_stream_map_query_timing(void) {
+    NexusMPSDataStream* streams[8];
+    NexusMPSDataStreamMap* map = mps_stream_map_create(8);
+    SPEC_ASSERT(map != NULL, "Map creation failed");
+
+    // A ring of eight components, each also feeding the one after next
+    char ids[8][8];
+    for (int i = 0; i < 8; i++) {
+        snprintf(ids[i], sizeof(ids[i]), "comp_%d", i);
+        streams[i] = mps_stream_create_double_buffered(0);
+        SPEC_ASSERT(streams[i] != NULL, "Stream creation failed");
+    }
+    for (int i = 0; i < 8; i++) {
+        SPEC_EXPECT_EQ(mps_stream_map_add(map, ids[i], ids[(i + 1) % 8], streams[i]), NEXUS_SUCCESS);
+        SPEC_EXPECT_EQ(mps_stream_map_add(map, ids[i], ids[(i + 2) % 8], streams[i]), NEXUS_SUCCESS);
+    }
+    SPEC_EXPECT_EQ(mps_stream_map_build_index(map), NEXUS_SUCCESS);
+
+    size_t indices[8];
+    for (int i = 0; i < 8; i++) {
+        indices[i] = mps_stream_map_component_index(map, ids[i]);
+        SPEC_ASSERT(indices[i] < map->component_count, "Component not indexed");
+    }
+
+    size_t edges = 0;
+    double start = spec_now_ms();
+    for (size_t q = 0; q < BENCH_QUERY_COUNT; q++) {
+        MPSStreamMapEntry* const* entries = NULL;
+        edges += mps_stream_map_incoming(map, indices[q % 8], &entries);
+        edges += mps_stream_map_outgoing(map, indices[q % 8], &entries);
+    }
+    double elapsed = spec_now_ms() - start;
+
+    SPEC_EXPECT_EQ(edges, (size_t)(4 * BENCH_QUERY_COUNT));
+    printf("\n      %d incoming + outgoing queries: %.2f ms (%.1f ns each)\n      ",
+           BENCH_QUERY_COUNT, elapsed, elapsed * 1e6 / BENCH_QUERY_COUNT);
+
+    mps_stream_map_destroy(map);
+    for (int i = 0; i < 8; i++) {
+        mps_stream_destroy(streams[i]);
+    }
+    return SPEC_PASS;
+}
+
+int main() {
+    etps_init();
+
+    spec_suite_t* suite = spec_suite_create("MPS_Stream_Map_Performance_Specs");
+
+    spec_add_test(suite, "Edges survive the double-buffer swap", spec_mps_stream_map_after_swap);
+    spec_add_test(suite, "1M slice queries", spec_mps_stream_map_query_timing);
+
+    int result = spec_suite_run(suite);
+
+    spec_suite_destroy(suite);
+    etps_shutdown();
+
+    return result;
+}
@@ -0,0 +1,149 @@
+/**
+ * @file okpala_minimizer_spec.c
+ * @brief Okpala Automaton Minimizer Performance Specifications
+ *
+ * Builds DFAs of 1k to 1M states over {a, b} that fold onto 40
+ * residue classes, with a: i -> i + 1 and b: i -> 3i + 1 mod n and every
+ * 40th state final, then times construction by string ID and Hopcroft
+ * minimization. The minimized automaton must have exactly 40 states and
+ * be its own minimization. A second spec checks that pointers into the
+ * states array survive growth while states and transitions interleave.
+ */
+
+#include "../spec_runner.c"
+#include "nlink/core/minimizer/okpala_automaton.h"
+#include <math.h>
+
+#define BENCH_CLASSES 40
+#define BENCH_GROWTH_STATES 5000
+
+static const size_t bench_sizes[] = { 1000, 10000, 100000, 1000000 };
+
+static OkpalaAutomaton* bench_residue_automaton(size_t states) {
+    OkpalaAutomaton* automaton = okpala_automaton_create();
+    if (automaton == NULL) {
+        return NULL;
+    }
+
+    char id[32];
+    for (size_t i = 0; i < states; i++) {
+        snprintf(id, sizeof(id), "s%zu", i);
+        if (okpala_automaton_add_state(automaton, id, i % BENCH_CLASSES == 0) != NEXUS_SUCCESS) {
+            okpala_automaton_free(automaton);
+            return NULL;
+        }
+    }
+
+    char to[32];
+    for (size_t i = 0; i < states; i++) {
+        snprintf(id, sizeof(id), "s%zu", i);
+        snprintf(to, sizeof(to), "s%zu", (i + 1) % states);
+        if (okpala_automaton_add_transition(automaton, id, to, "a") != NEXUS_SUCCESS) {
+            okpala_automaton_free(automaton);
+            return NULL;
+        }
+        snprintf(to, sizeof(to), "s%zu", (3 * i + 1) % states);
+        if (okpala_automaton_add_transition(automaton, id, to, "b") != NEXUS_SUCCESS) {
+            okpala_automaton_free(automaton);
+            return NULL;
+        }
+    }
+
+    return automaton;
+}
+
+spec_result_t spec_okpala_minimizer_scaling(void) {
+    printf("\n      %10s %12s %14s %18s\n", "states", "build (ms)", "minimize (ms)", "ns per m log2 n");
+
+    for (size_t s = 0; s < sizeof(bench_sizes) / sizeof(bench_sizes[0]); s++) {
+        size_t states = bench_sizes[s];
+
+        double start = spec_now_ms();
+        OkpalaAutomaton* automaton = bench_residue_automaton(states);
+        double build_ms = spec_now_ms() - start;
+        SPEC_ASSERT(automaton != NULL, "Automaton construction failed");
+        SPEC_EXPECT_EQ(automaton->alphabet_size, (size_t)2);
+
+        start = spec_now_ms();
+        OkpalaAutomaton* minimized = okpala_minimize_automaton(automaton, false);
+        double minimize_ms = spec_now_ms() - start;
+        SPEC_ASSERT(minimized != NULL, "Minimization failed");
+        SPEC_EXPECT_EQ(minimized->state_count, (size_t)BENCH_CLASSES);
+        SPEC_ASSERT(minimized->initial_state->is_final, "Initial class should be final");
+
+        // Class k holds the states with residue k, numbered by first state
+        for (size_t k = 0; k < BENCH_CLASSES; k++) {
+            OkpalaState* state = &minimized->states[k];
+            SPEC_EXPECT_EQ(state->transition_count, (size_t)2);
+            SPEC_EXPECT_EQ((size_t)(state->transitions[0] - minimized->states), (k + 1) % BENCH_CLASSES);
+            SPEC_EXPECT_EQ((size_t)(state->transitions[1] - minimized->states), (3 * k + 1) % BENCH_CLASSES);
+        }
+
+        OkpalaAutomaton* again = okpala_minimize_automaton(minimized, false);
+        SPEC_ASSERT(again != NULL, "Second minimization failed");
+        SPEC_EXPECT_EQ(again->state_count, (size_t)BENCH_CLASSES);
+
+        double work = 2.0 * states * log2((double)states);
+        printf("      %10zu %12.2f %14.2f %18.2f\n", states, build_ms, minimize_ms, minimize_ms * 1e6 / work);
+
+        okpala_automaton_free(again);
+        okpala_automaton_free(minimized);
+        okpala_automaton_free(automaton);
+    }
+
+    printf("      ");
+    return SPEC_PASS;
+}
+
+spec_result_t spec_okpala_automaton_growth(void) {
+    OkpalaAutomaton* automaton = okpala_automaton_create();
+    SPEC_ASSERT(automaton != NULL, "Automaton creation failed");
+
+    // Each new state links back to the previous one, so every growth of
+    // the states array has live transition pointers to move
+    char id[32], previous[32];
+    for (size_t i = 0; i < BENCH_GROWTH_STATES; i++) {
+        snprintf(id, sizeof(id), "g%zu", i);
+        SPEC_ASSERT(okpala_automaton_add_state(automaton, id, i % 2 == 1) == NEXUS_SUCCESS, "Add state failed");
+        if (i > 0) {
+            SPEC_ASSERT(okpala_automaton_add_transition(automaton, id, previous, "back") == NEXUS_SUCCESS,
+                        "Add transition failed");
+        }
+        memcpy(previous, id, sizeof(id));
+    }
+
+    SPEC_ASSERT(okpala_automaton_add_state(automaton, "g0", false) != NEXUS_SUCCESS, "Duplicate ID accepted");
+    SPEC_ASSERT(okpala_automaton_add_transition(automaton, "g0", "missing", "back") != NEXUS_SUCCESS,
+                "Transition to a missing state accepted");
+    SPEC_EXPECT_EQ(okpala_automaton_find_state(automaton, "missing"), (size_t)OKPALA_NO_STATE);
+    SPEC_EXPECT_EQ(okpala_automaton_find_state(automaton, "g4321"), (size_t)4321);
+
+    SPEC_ASSERT(automaton->initial_state == &automaton->states[0], "Initial state pointer is stale");
+    SPEC_EXPECT_EQ(automaton->final_state_count, (size_t)(BENCH_GROWTH_STATES / 2));
+    for (size_t i = 0; i < automaton->final_state_count; i++) {
+        SPEC_ASSERT(automaton->final_states[i] == &automaton->states[2 * i + 1], "Final state pointer is stale");
+    }
+    for (size_t i = 1; i < BENCH_GROWTH_STATES; i++) {
+        SPEC_ASSERT(automaton->states[i].transitions[0] == &automaton->states[i - 1], "Transition pointer is stale");
+        SPEC_ASSERT(automaton->states[i].input_symbols[0] == automaton->alphabet[0], "Symbol is not interned");
+    }
+
+    okpala_automaton_free(automaton);
+    return SPEC_PASS;
+}
+
+int main() {
+    etps_init();
+
+    spec_suite_t* suite = spec_suite_create("Okpala_Minimizer_Performance_Specs");
+
+    spec_add_test(suite, "Hopcroft minimization from 1k to 1M states", spec_okpala_minimizer_scaling);
+    spec_add_test(suite, "State pointers across array growth", spec_okpala_automaton_growth);
+
+    int result = spec_suite_run(suite);
+
+    spec_suite_destroy(suite);
+    etps_shutdown();
+
+    return result;
+}
@@ -0,0 +1,230 @@
+/**
+ * @file pipeline_stage_spec.c
+ * @brief Stage Chain Composition Performance Specifications
+ *
+ * Builds stage chains with compose() and fold() in caller-owned storage
+ * and in an arena, nests them with stage_chain_compose() and
+ * stage_chain_fold(), and checks that every chain runs its stages once
+ * each, in composition order. Caller storage must refuse to grow without
+ * touching what it holds, and a failing stage must stop its chain. The
+ * last spec times a deeply nested composition, which runs as one flat
+ * array walk.
+ */
+
+#include "../spec_runner.c"
+#include "nlink/core/pipeline/pipeline_stage.h"
+#include "nlink/core/common/nexus_error.h"
+
+#define TRACE_CAPACITY 256
+#define BENCH_NESTING 6
+#define BENCH_RUNS 100000
+
+// Stage IDs in the order stages ran
+static int stage_trace[TRACE_CAPACITY];
+static size_t stage_trace_count;
+
+static void trace_stage(int id) {
+    if (stage_trace_count < TRACE_CAPACITY) {
+        stage_trace[stage_trace_count] = id;
+    }
+    stage_trace_count++;
+}
+
+static NexusResult stage_one(NexusContext* ctx, NexusBuffer* buffer) {
+    (void)ctx;
+    (void)buffer;
+    trace_stage(1);
+    return nexus_success(NULL, NULL);
+}
+
+static NexusResult stage_two(NexusContext* ctx, NexusBuffer* buffer) {
+    (void)ctx;
+    (void)buffer;
+    trace_stage(2);
+    return nexus_success(NULL, NULL);
+}
+
+static NexusResult stage_three(NexusContext* ctx, NexusBuffer* buffer) {
+    (void)ctx;
+    (void)buffer;
+    trace_stage(3);
+    return nexus_success(NULL, NULL);
+}
+
+static NexusResult stage_fail(NexusContext* ctx, NexusBuffer* buffer) {
+    (void)ctx;
+    (void)buffer;
+    trace_stage(-1);
+    nexus_error* error = nexus_error_create(NEXUS_ERROR_INVALID_ARGUMENT, "Stage failed",
+                                            __FILE__, __LINE__);
+    return nexus_error_result(error, NULL);
+}
+
+// Stateful stage: traces the ID it was created with
+static NexusResult stage_stateful(NexusContext* ctx, NexusBuffer* buffer, void* state) {
+    (void)ctx;
+    (void)buffer;
+    trace_stage(*(const int*)state);
+    return nexus_success(NULL, NULL);
+}
+
+// Run a chain and check it traced exactly the expected IDs
+static bool chain_runs_as(const StageChain* chain, const int* expected, size_t count) {
+    NexusBuffer buffer;
+    memset(&buffer, 0, sizeof(buffer));
+    stage_trace_count = 0;
+
+    NexusResult result = stage_chain_execute(chain, NULL, &buffer);
+    if (result.status != NEXUS_STATUS_SUCCESS) {
+        nexus_result_free(&result);
+        return false;
+    }
+    return stage_trace_count == count && memcmp(stage_trace, expected, count * sizeof(int)) == 0;
+}
+
+spec_result_t spec_stage_chain_caller_owned(void) {
+    StageChainEntry storage[5];
+    StageChain chain;
+    stage_chain_init(&chain, storage, 5);
+
+    PipelineStage stages[] = { stage_three, stage_two, stage_one };
+    SPEC_EXPECT_EQ(compose(&chain, stage_one, stage_two).status, NEXUS_STATUS_SUCCESS);
+    SPEC_EXPECT_EQ(fold(&chain, stages, 3).status, NEXUS_STATUS_SUCCESS);
+    SPEC_ASSERT(chain.entries == storage, "Caller storage was replaced");
+
+    static const int expected[] = { 1, 2, 3, 2, 1 };
+    SPEC_ASSERT(chain_runs_as(&chain, expected, 5), "Caller-owned chain ran the wrong stages");
+
+    // Full storage refuses more stages and keeps what it holds
+    NexusResult result = compose(&chain, stage_one, stage_two);
+    SPEC_ASSERT(result.status != NEXUS_STATUS_SUCCESS, "Full caller storage grew");
+    nexus_result_free(&result);
+    result = fold(&chain, stages, 1);
+    SPEC_ASSERT(result.status != NEXUS_STATUS_SUCCESS, "Full caller storage grew");
+    nexus_result_free(&result);
+    SPEC_EXPECT_EQ(chain.count, (size_t)5);
+    SPEC_ASSERT(chain_runs_as(&chain, expected, 5), "Refused stages changed the chain");
+
+    // A failing stage stops the chain
+    StageChainEntry failing_storage[3];
+    StageChain failing;
+    stage_chain_init(&failing, failing_storage, 3);
+    PipelineStage failing_stages[] = { stage_one, stage_fail, stage_two };
+    SPEC_EXPECT_EQ(fold(&failing, failing_stages, 3).status, NEXUS_STATUS_SUCCESS);
+    stage_trace_count = 0;
+    result = stage_chain_execute(&failing, NULL, NULL);
+    SPEC_ASSERT(result.status != NEXUS_STATUS_SUCCESS, "Failure not reported");
+    nexus_result_free(&result);
+    SPEC_EXPECT_EQ(stage_trace_count, (size_t)2);
+
+    // Destroying caller storage only empties the chain
+    stage_chain_destroy(&chain);
+    SPEC_EXPECT_EQ(chain.count, (size_t)0);
+    SPEC_ASSERT(chain.entries == storage, "Caller storage was released");
+    return SPEC_PASS;
+}
+
+spec_result_t spec_stage_chain_arena_owned(void) {
+    NlinkArena arena;
+    nlink_arena_init(&arena, 0);
+
+    int state = 7;
+    StatefulStage stateful = create_stateful_stage(stage_stateful, &state);
+
+    // Two parts: (1 2 7) in the arena, (3 1) in caller storage
+    StageChain first;
+    stage_chain_init_arena(&first, &arena);
+    SPEC_EXPECT_EQ(compose(&first, stage_one, stage_two).status, NEXUS_STATUS_SUCCESS);
+    SPEC_EXPECT_EQ(stage_chain_push_stateful(&first, &stateful).status, NEXUS_STATUS_SUCCESS);
+
+    StageChainEntry storage[2];
+    StageChain second;
+    stage_chain_init(&second, storage, 2);
+    PipelineStage stages[] = { stage_three, stage_one };
+    SPEC_EXPECT_EQ(fold(&second, stages, 2).status, NEXUS_STATUS_SUCCESS);
+
+    // Folding and composing flatten into one arena chain
+    StageChain flat;
+    stage_chain_init_arena(&flat, &arena);
+    StageChain parts[] = { first, second };
+    SPEC_EXPECT_EQ(stage_chain_fold(&flat, parts, 2).status, NEXUS_STATUS_SUCCESS);
+    static const int folded[] = { 1, 2, 7, 3, 1 };
+    SPEC_ASSERT(chain_runs_as(&flat, folded, 5), "Folded arena chain ran the wrong stages");
+
+    // Composing a chain with itself reads both operands before writing
+    SPEC_EXPECT_EQ(stage_chain_compose(&flat, &flat, &second).status, NEXUS_STATUS_SUCCESS);
+    static const int composed[] = { 1, 2, 7, 3, 1, 1, 2, 7, 3, 1, 3, 1 };
+    SPEC_ASSERT(chain_runs_as(&flat, composed, 12), "Self-composed arena chain ran the wrong stages");
+
+    // Arena chains grow past their first allocation
+    for (int i = 0; i < 3; i++) {
+        SPEC_EXPECT_EQ(stage_chain_append(&flat, &flat).status, NEXUS_STATUS_SUCCESS);
+    }
+    SPEC_EXPECT_EQ(flat.count, (size_t)96);
+    NexusBuffer buffer;
+    memset(&buffer, 0, sizeof(buffer));
+    stage_trace_count = 0;
+    SPEC_EXPECT_EQ(stage_chain_execute(&flat, NULL, &buffer).status, NEXUS_STATUS_SUCCESS);
+    SPEC_EXPECT_EQ(stage_trace_count, (size_t)96);
+    for (size_t i = 0; i < 96; i++) {
+        SPEC_ASSERT(stage_trace[i] == composed[i % 12], "Grown arena chain ran the wrong stages");
+    }
+
+    // The arena owns the entries; destroying the chains leaves them to it
+    stage_chain_destroy(&flat);
+    stage_chain_destroy(&first);
+    SPEC_EXPECT_EQ(flat.count, (size_t)0);
+    nlink_arena_destroy(&arena);
+    return SPEC_PASS;
+}
+
+spec_result_t spec_stage_chain_nested_timing(void) {
+    // Every level composes the level below with itself, into a fresh chain
+    StageChain levels[BENCH_NESTING + 1];
+    stage_chain_init(&levels[0], NULL, 0);
+    SPEC_EXPECT_EQ(compose(&levels[0], stage_one, stage_two).status, NEXUS_STATUS_SUCCESS);
+    for (int level = 1; level <= BENCH_NESTING; level++) {
+        stage_chain_init(&levels[level], NULL, 0);
+        SPEC_EXPECT_EQ(stage_chain_compose(&levels[level], &levels[level - 1], &levels[level - 1]).status,
+                       NEXUS_STATUS_SUCCESS);
+        stage_chain_destroy(&levels[level - 1]);
+    }
+    StageChain chain = levels[BENCH_NESTING];
+    size_t stages = (size_t)2 << BENCH_NESTING;
+    SPEC_EXPECT_EQ(chain.count, stages);
+
+    NexusBuffer buffer;
+    memset(&buffer, 0, sizeof(buffer));
+    double start = spec_now_ms();
+    for (int run = 0; run < BENCH_RUNS; run++) {
+        stage_trace_count = 0;
+        NexusResult result = stage_chain_execute(&chain, NULL, &buffer);
+        SPEC_ASSERT(result.status == NEXUS_STATUS_SUCCESS, "Nested chain failed");
+    }
+    double elapsed = spec_now_ms() - start;
+    SPEC_EXPECT_EQ(stage_trace_count, stages);
+
+    printf("\n      %d runs of %zu stages: %.2f ms (%.1f ns per stage)\n      ",
+           BENCH_RUNS, stages, elapsed, elapsed * 1e6 / ((double)BENCH_RUNS * stages));
+
+    stage_chain_destroy(&chain);
+    SPEC_ASSERT(chain.entries == NULL, "Heap entries not released");
+    return SPEC_PASS;
+}
+
+int main() {
+    etps_init();
+
+    spec_suite_t* suite = spec_suite_create("Stage_Chain_Performance_Specs");
+
+    spec_add_test(suite, "compose and fold into caller-owned storage", spec_stage_chain_caller_owned);
+    spec_add_test(suite, "compose and fold into arena-owned chains", spec_stage_chain_arena_owned);
+    spec_add_test(suite, "100K runs of a nested composition", spec_stage_chain_nested_timing);
+
+    int result = spec_suite_run(suite);
+
+    spec_suite_destroy(suite);
+    etps_shutdown();
+
+    return result;
+}
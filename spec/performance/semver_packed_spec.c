@@ -0,0 +1,213 @@
+/**
+ * @file semver_packed_spec.c
+ * @brief Packed SemVer Matching Performance Specifications
+ *
+ * Packed version keys are only compared when the packing is exact. These
+ * specs cover the versions that do not pack exactly (components above
+ * 65535, prereleases beyond one known tag and number, strings that are
+ * not versions) and check that semver_satisfies() and versioned symbol
+ * resolution both give the answer semver_compare() implies. A grid of
+ * versions and constraints checks the packed and full-precision paths
+ * against each other, and the last spec times the two paths.
+ */
+
+#include "../spec_runner.c"
+#include "nlink/core/semverx/semver.h"
+#include "nlink/core/symbols/nexus_versioned_symbols.h"
+#include <stdint.h>
+
+#define BENCH_MATCH_COUNT 1000000
+
+static const char* const grid_versions[] = {
+    "0.0.0", "0.1.0", "1.0.0", "1.2.3", "1.2.4", "2.0.0", "65535.0.0", "65536.0.0", "65537.0.0",
+    "1.65536.0", "1.0.0-alpha", "1.0.0-alpha.1", "1.0.0-alpha.1.x", "1.0.0-alpha.2",
+    "1.0.0-alpha.10", "1.0.0-alpha.beta", "1.0.0-beta", "1.0.0-beta.11", "1.0.0-rc.1",
+    "1.0.0-0", "1.0.0-7", "1.0.0-Alpha", "1.0.0-x.y", "1.0.0-alpha.3000", "1.2.3-rc.1",
+};
+
+static const char* const grid_ops[] = { "", "=", ">", ">=", "<", "<=", "^", "~" };
+
+// What semver_satisfies() must return for "<op><bound>", from semver_compare()
+static bool reference_satisfies(const char* version, const char* op, const char* bound) {
+    SemVer* a = semver_parse(version);
+    SemVer* b = semver_parse(bound);
+    int cmp = semver_compare(a, b);
+    bool same_major = a->major == b->major;
+    bool same_minor = same_major && a->minor == b->minor;
+    semver_free(a);
+    semver_free(b);
+
+    if (op[0] == 0 || strcmp(op, "=") == 0) return cmp == 0;
+    if (strcmp(op, ">") == 0) return cmp > 0;
+    if (strcmp(op, ">=") == 0) return cmp >= 0;
+    if (strcmp(op, "<") == 0) return cmp < 0;
+    if (strcmp(op, "<=") == 0) return cmp <= 0;
+    if (strcmp(op, "^") == 0) return cmp >= 0 && same_major;
+    return cmp >= 0 && same_minor;
+}
+
+spec_result_t spec_semver_packed_wide_components(void) {
+    SemVerPacked packed;
+    SPEC_ASSERT(semver_pack("65535.65535.65535", &packed), "Largest exact version did not pack");
+    SPEC_ASSERT(!semver_pack("65536.0.0", &packed), "Clamped component reported as exact");
+
+    SPEC_ASSERT(semver_satisfies("65536.0.0", "=65536.0.0"), "Wide version does not equal itself");
+    SPEC_ASSERT(!semver_satisfies("65537.0.0", "=65536.0.0"), "Wide versions clamped together");
+    SPEC_ASSERT(semver_satisfies("65537.0.0", ">65536.0.0"), "Wide versions clamped together");
+    SPEC_ASSERT(!semver_satisfies("65536.0.0", ">65536.0.0"), "Version greater than itself");
+    SPEC_ASSERT(semver_satisfies("65536.0.0", ">65535.0.0"), "Wide version not above 65535");
+    SPEC_ASSERT(!semver_satisfies("1.65537.0", "~1.65536.0"), "Wide minor clamped into the tilde range");
+    SPEC_ASSERT(!semver_satisfies("99999999999999999999.0.0", "*"), "Overflowing component accepted");
+
+    return SPEC_PASS;
+}
+
+spec_result_t spec_semver_packed_prerelease(void) {
+    SemVerPacked packed;
+    SPEC_ASSERT(semver_pack("1.0.0-alpha.1", &packed), "Tag and number did not pack");
+    SPEC_ASSERT(semver_pack("1.0.0-7", &packed), "Numeric prerelease did not pack");
+    SPEC_ASSERT(!semver_pack("1.0.0-alpha.1.x", &packed), "Third identifier reported as exact");
+    SPEC_ASSERT(!semver_pack("1.0.0-alpha.beta", &packed), "Alphanumeric second identifier reported as exact");
+    SPEC_ASSERT(!semver_pack("1.0.0-Alpha", &packed), "Unknown tag reported as exact");
+
+    // Identifiers past the first number are not lost
+    SPEC_ASSERT(!semver_satisfies("1.0.0-alpha.1.x", "=1.0.0-alpha.1"), "alpha.1.x packed onto alpha.1");
+    SPEC_ASSERT(semver_satisfies("1.0.0-alpha.1.x", ">1.0.0-alpha.1"), "alpha.1.x not above alpha.1");
+    SPEC_ASSERT(semver_satisfies("1.0.0-alpha.1", "<1.0.0-alpha.1.x"), "alpha.1 not below alpha.1.x");
+
+    // Numeric identifiers compare by value, below alphanumeric ones
+    SPEC_ASSERT(semver_satisfies("1.0.0-alpha.10", ">1.0.0-alpha.2"), "alpha.10 not above alpha.2");
+    SPEC_ASSERT(semver_satisfies("1.0.0-alpha.beta", ">1.0.0-alpha.10"), "Numeric identifier above a word");
+    SPEC_ASSERT(semver_satisfies("1.0.0-alpha.3000", ">1.0.0-alpha.2047"), "Wide number clamped");
+    SPEC_ASSERT(semver_satisfies("1.0.0-Alpha", "<1.0.0-alpha"), "Tags not compared in ASCII order");
+    SPEC_ASSERT(semver_prerelease_compare("alpha.02", "alpha.2") == 0, "Leading zero changed the order");
+    SPEC_ASSERT(semver_prerelease_compare("alpha", "alpha.1") < 0, "Prefix not first");
+
+    return SPEC_PASS;
+}
+
+spec_result_t spec_semver_packed_unparseable(void) {
+    SemVerPacked packed;
+    SPEC_ASSERT(!semver_pack("banana", &packed), "Non-version packed");
+    SPEC_ASSERT(!semver_satisfies("banana", "*"), "Non-version satisfied *");
+    SPEC_ASSERT(!semver_satisfies("banana", "<2.0.0"), "Non-version satisfied <2.0.0");
+
+    VersionedSymbolRegistry* registry = nexus_versioned_registry_create();
+    SPEC_ASSERT(registry != NULL, "Registry creation failed");
+
+    void* broken = (void*)(uintptr_t)0x100;
+    void* wide = (void*)(uintptr_t)0x200;
+    void* tagged = (void*)(uintptr_t)0x300;
+    versioned_symbol_table_add(&registry->exported, "parse", "banana", broken, VSYMBOL_FUNCTION, "lib_a", 0);
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "parse", "*", "app") == NULL,
+                "Non-version resolved for *");
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "parse", "<2.0.0", "app") == NULL,
+                "Non-version resolved for <2.0.0");
+
+    // Inexact keys must not leak into resolution either
+    versioned_symbol_table_add(&registry->exported, "wide", "65537.0.0", wide, VSYMBOL_FUNCTION, "lib_a", 0);
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "wide", "=65536.0.0", "app") == NULL,
+                "Clamped version resolved");
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "wide", ">65536.0.0", "app") == wide,
+                "Wide version not resolved");
+
+    versioned_symbol_table_add(&registry->exported, "tagged", "1.0.0-alpha.1.x", tagged,
+                               VSYMBOL_FUNCTION, "lib_b", 0);
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "tagged", "=1.0.0-alpha.1", "app") == NULL,
+                "alpha.1.x resolved for =alpha.1");
+
+    // Dependency constraints take the same fallback
+    nexus_add_component_dependency(registry, "app", "lib_b", "<1.0.0-alpha.1", false);
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "tagged", NULL, "app") == NULL,
+                "Dependency constraint ignored");
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "tagged", NULL, "tool") == tagged,
+                "Unconstrained resolution failed");
+
+    nexus_versioned_registry_free(registry);
+    return SPEC_PASS;
+}
+
+spec_result_t spec_semver_packed_many_alternatives(void) {
+    const char* constraint = "1.0.0 || 2.0.0 || 3.0.0 || 4.0.0 || 5.0.0 || ^6.1.0";
+
+    // Alternatives past SEMVER_MAX_RANGES leave the compiled form inexact
+    SemVerConstraint compiled;
+    SPEC_ASSERT(semver_constraint_compile(constraint, &compiled), "Constraint did not compile");
+    SPEC_ASSERT(!compiled.exact, "Truncated constraint reported as exact");
+    SPEC_ASSERT(compiled.count == SEMVER_MAX_RANGES, "Ranges not kept up to the limit");
+
+    SPEC_ASSERT(semver_satisfies("1.0.0", constraint), "First alternative not matched");
+    SPEC_ASSERT(semver_satisfies("5.0.0", constraint), "Fifth alternative not matched");
+    SPEC_ASSERT(semver_satisfies("6.2.0", constraint), "Last alternative not matched");
+    SPEC_ASSERT(!semver_satisfies("6.0.0", constraint), "Version outside every alternative matched");
+    return SPEC_PASS;
+}
+
+spec_result_t spec_semver_packed_agreement(void) {
+    size_t versions = sizeof(grid_versions) / sizeof(grid_versions[0]);
+    size_t ops = sizeof(grid_ops) / sizeof(grid_ops[0]);
+    size_t checked = 0, disagreements = 0;
+    char constraint[64];
+
+    for (size_t b = 0; b < versions; b++) {
+        for (size_t o = 0; o < ops; o++) {
+            snprintf(constraint, sizeof(constraint), "%s%s", grid_ops[o], grid_versions[b]);
+            for (size_t v = 0; v < versions; v++) {
+                bool expected = reference_satisfies(grid_versions[v], grid_ops[o], grid_versions[b]);
+                if (semver_satisfies(grid_versions[v], constraint) != expected) {
+                    if (disagreements++ < 5) {
+                        printf("\n      %s against %s: expected %d", grid_versions[v], constraint, expected);
+                    }
+                }
+                checked++;
+            }
+        }
+    }
+
+    printf("\n      %zu version/constraint pairs checked\n      ", checked);
+    SPEC_EXPECT_EQ(disagreements, (size_t)0);
+    return SPEC_PASS;
+}
+
+spec_result_t spec_semver_packed_timing(void) {
+    size_t matched = 0;
+
+    double start = spec_now_ms();
+    for (size_t i = 0; i < BENCH_MATCH_COUNT; i++) {
+        matched += semver_satisfies("1.4.2-rc.3", "^1.2.0") ? 1 : 0;
+    }
+    double packed_ms = spec_now_ms() - start;
+
+    start = spec_now_ms();
+    for (size_t i = 0; i < BENCH_MATCH_COUNT; i++) {
+        matched += semver_satisfies("1.4.2-rc.3.hotfix", "^1.2.0") ? 1 : 0;
+    }
+    double exact_ms = spec_now_ms() - start;
+
+    SPEC_EXPECT_EQ(matched, (size_t)(2 * BENCH_MATCH_COUNT));
+
+    printf("\n      %d matches: packed %.2f ms (%.1f ns each), full precision %.2f ms (%.1f ns each)\n      ",
+           BENCH_MATCH_COUNT, packed_ms, packed_ms * 1e6 / BENCH_MATCH_COUNT,
+           exact_ms, exact_ms * 1e6 / BENCH_MATCH_COUNT);
+    return SPEC_PASS;
+}
+
+int main() {
+    etps_init();
+
+    spec_suite_t* suite = spec_suite_create("SemVer_Packed_Performance_Specs");
+
+    spec_add_test(suite, "Components above 65535 are not clamped together", spec_semver_packed_wide_components);
+    spec_add_test(suite, "Prereleases compare by every identifier", spec_semver_packed_prerelease);
+    spec_add_test(suite, "Strings that are not versions match nothing", spec_semver_packed_unparseable);
+    spec_add_test(suite, "Constraints past the range limit fall back", spec_semver_packed_many_alternatives);
+    spec_add_test(suite, "Packed and full-precision paths agree", spec_semver_packed_agreement);
+    spec_add_test(suite, "1M matches on each path", spec_semver_packed_timing);
+
+    int result = spec_suite_run(suite);
+
+    spec_suite_destroy(suite);
+    etps_shutdown();
+
+    return result;
+}
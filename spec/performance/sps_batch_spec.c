@@ -0,0 +1,292 @@
+/**
+ * @file sps_batch_spec.c
+ * @brief Batched Single-Pass Pipeline Performance Specifications
+ *
+ * Runs a four-stage pipeline over the same set of small inputs one at a
+ * time and in batches of 16 and 256, and reports throughput for each.
+ * Every stage translates its input through its own 32 KiB table, so
+ * running a stage over a whole batch keeps that table in cache. The
+ * per-item fallback is measured at the largest batch size as well. A
+ * second spec runs chunked inputs through single and batched execution,
+ * which must flatten them before the first stage reads them.
+ */
+
+#include "../spec_runner.c"
+#include "nlink/spsystem/sps_pipeline.h"
+#include "nlink/spsystem/sps_stream.h"
+#include <stdint.h>
+
+#define BENCH_STAGES 4
+#define BENCH_ITEMS 4096
+#define BENCH_ITEM_SIZE 256
+#define BENCH_ROUNDS 8
+#define BENCH_TABLE_BITS 14
+#define BENCH_MAX_BATCH 256
+
+static uint16_t bench_tables[BENCH_STAGES][1u << BENCH_TABLE_BITS];
+static const char* bench_stage_ids[BENCH_STAGES] = { "stage_0", "stage_1", "stage_2", "stage_3" };
+
+static NexusResult bench_stage_process(NexusPipelineComponent* component,
+                                       NexusDataStream* input,
+                                       NexusDataStream* output) {
+    const uint16_t* table = bench_tables[component->component_id[6] - '0'];
+    size_t bytes = (input->size - input->position) & ~(size_t)1;
+
+    if (output->capacity < bytes) {
+        NexusResult result = sps_stream_resize(output, bytes);
+        if (result != NEXUS_SUCCESS) {
+            return result;
+        }
+    }
+
+    const uint16_t* in = (const uint16_t*)((const char*)input->data + input->position);
+    uint16_t* out = (uint16_t*)output->data;
+    for (size_t i = 0; i < bytes / 2; i++) {
+        uint32_t index = ((uint32_t)in[i] << 1 | (i & 1)) & ((1u << BENCH_TABLE_BITS) - 1);
+        out[i] = (uint16_t)(in[i] ^ table[index]);
+    }
+
+    input->position += bytes;
+    output->size = bytes;
+    output->position = 0;
+    return NEXUS_SUCCESS;
+}
+
+static NexusResult bench_stage_process_batch(NexusPipelineComponent* component,
+                                             NexusDataStream** inputs,
+                                             NexusDataStream** outputs,
+                                             size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        NexusResult result = bench_stage_process(component, inputs[i], outputs[i]);
+        if (result != NEXUS_SUCCESS) {
+            return result;
+        }
+    }
+    return NEXUS_SUCCESS;
+}
+
+// Stands in for a loaded component library; stages run in-process
+static int bench_component_placeholder;
+
+static NexusPipeline* bench_pipeline_create(NexusContext* ctx, NexusPipelineConfig* config, bool batched) {
+    NexusPipeline* pipeline = sps_pipeline_create(ctx, config);
+    if (!pipeline) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < pipeline->component_count; i++) {
+        NexusPipelineComponent* component = pipeline->components[i];
+        component->component = (NexusComponent*)&bench_component_placeholder;
+        component->process_func = bench_stage_process;
+        component->process_batch_func = batched ? bench_stage_process_batch : NULL;
+        component->is_initialized = true;
+    }
+    pipeline->is_initialized = true;
+    return pipeline;
+}
+
+static void bench_pipeline_destroy(NexusContext* ctx, NexusPipeline* pipeline) {
+    for (size_t i = 0; i < pipeline->component_count; i++) {
+        pipeline->components[i]->component = NULL;
+    }
+    sps_pipeline_destroy(ctx, pipeline);
+}
+
+// Runs every input through the pipeline BENCH_ROUNDS times; returns items/s
+static double bench_run(NexusContext* ctx, NexusPipeline* pipeline, size_t batch,
+                        NexusDataStream** inputs, NexusDataStream** outputs, bool* ok) {
+    double start = spec_now_ms();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (size_t i = 0; i < BENCH_ITEMS; i += batch) {
+            for (size_t j = i; j < i + batch; j++) {
+                inputs[j]->position = 0;
+                sps_stream_clear(outputs[j]);
+            }
+
+            NexusResult result = batch == 1
+                ? sps_pipeline_execute(ctx, pipeline, inputs[i], outputs[i])
+                : sps_pipeline_execute_batch(ctx, pipeline, &inputs[i], &outputs[i], batch);
+            if (result != NEXUS_SUCCESS) {
+                *ok = false;
+            }
+        }
+    }
+    double elapsed = spec_now_ms() - start;
+    return (double)BENCH_ITEMS * BENCH_ROUNDS / elapsed * 1000.0;
+}
+
+static uint64_t bench_checksum(NexusDataStream** streams) {
+    uint64_t hash = 1469598103934665603ull;
+    for (size_t i = 0; i < BENCH_ITEMS; i++) {
+        const unsigned char* data = (const unsigned char*)streams[i]->data;
+        for (size_t j = 0; j < streams[i]->size; j++) {
+            hash = (hash ^ data[j]) * 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
+spec_result_t spec_sps_batch_throughput(void) {
+    NexusConfig context_config = {0};
+    context_config.log_level = NEXUS_LOG_ERROR;
+    NexusContext* ctx = nexus_create_context(&context_config);
+    SPEC_ASSERT(ctx != NULL, "Context creation failed");
+
+    NexusPipelineComponentConfig stage_configs[BENCH_STAGES];
+    NexusPipelineComponentConfig* stages[BENCH_STAGES];
+    memset(stage_configs, 0, sizeof(stage_configs));
+    for (int i = 0; i < BENCH_STAGES; i++) {
+        stage_configs[i].component_id = bench_stage_ids[i];
+        stages[i] = &stage_configs[i];
+    }
+
+    NexusPipelineConfig config = {0};
+    config.pipeline_id = "batch_bench";
+    config.components = stages;
+    config.component_count = BENCH_STAGES;
+    config.input_format = "binary";
+    config.output_format = "binary";
+
+    uint32_t seed = 12345u;
+    for (int s = 0; s < BENCH_STAGES; s++) {
+        for (size_t i = 0; i < (1u << BENCH_TABLE_BITS); i++) {
+            seed = seed * 1103515245u + 12345u;
+            bench_tables[s][i] = (uint16_t)(seed >> 16);
+        }
+    }
+
+    static NexusDataStream* inputs[BENCH_ITEMS];
+    static NexusDataStream* outputs[BENCH_ITEMS];
+    unsigned char item[BENCH_ITEM_SIZE];
+    for (size_t i = 0; i < BENCH_ITEMS; i++) {
+        for (size_t j = 0; j < BENCH_ITEM_SIZE; j++) {
+            seed = seed * 1103515245u + 12345u;
+            item[j] = (unsigned char)(seed >> 16);
+        }
+        inputs[i] = sps_stream_create_from_data(item, BENCH_ITEM_SIZE, "binary");
+        outputs[i] = sps_stream_create(BENCH_ITEM_SIZE);
+        SPEC_ASSERT(inputs[i] && outputs[i], "Stream creation failed");
+    }
+
+    NexusPipeline* batched = bench_pipeline_create(ctx, &config, true);
+    NexusPipeline* per_item = bench_pipeline_create(ctx, &config, false);
+    SPEC_ASSERT(batched && per_item, "Pipeline creation failed");
+
+    // Warm up the stream rings, then take the one-at-a-time result as reference
+    bool ok = true;
+    bench_run(ctx, batched, BENCH_MAX_BATCH, inputs, outputs, &ok);
+    bench_run(ctx, per_item, BENCH_MAX_BATCH, inputs, outputs, &ok);
+    bench_run(ctx, batched, 1, inputs, outputs, &ok);
+    uint64_t reference = bench_checksum(outputs);
+
+    size_t batch_sizes[] = { 1, 16, BENCH_MAX_BATCH };
+    double single_rate = 0.0;
+    printf("\n");
+    for (size_t b = 0; b < sizeof(batch_sizes) / sizeof(batch_sizes[0]); b++) {
+        double rate = bench_run(ctx, batched, batch_sizes[b], inputs, outputs, &ok);
+        SPEC_EXPECT_EQ(bench_checksum(outputs), reference);
+        if (b == 0) {
+            single_rate = rate;
+        }
+        printf("      batch %3zu: %8.0f items/s (%.2fx)\n", batch_sizes[b], rate, rate / single_rate);
+    }
+
+    double fallback_rate = bench_run(ctx, per_item, BENCH_MAX_BATCH, inputs, outputs, &ok);
+    SPEC_EXPECT_EQ(bench_checksum(outputs), reference);
+    printf("      batch %3d, per-item fallback: %8.0f items/s (%.2fx)\n      ",
+           BENCH_MAX_BATCH, fallback_rate, fallback_rate / single_rate);
+    SPEC_ASSERT(ok, "Pipeline execution failed");
+
+    bench_pipeline_destroy(ctx, batched);
+    bench_pipeline_destroy(ctx, per_item);
+    for (size_t i = 0; i < BENCH_ITEMS; i++) {
+        sps_stream_destroy(inputs[i]);
+        sps_stream_destroy(outputs[i]);
+    }
+    nexus_destroy_context(ctx);
+    return SPEC_PASS;
+}
+
+spec_result_t spec_sps_batch_chunked_input(void) {
+    NexusConfig context_config = {0};
+    context_config.log_level = NEXUS_LOG_ERROR;
+    NexusContext* ctx = nexus_create_context(&context_config);
+    SPEC_ASSERT(ctx != NULL, "Context creation failed");
+
+    NexusPipelineComponentConfig stage_configs[BENCH_STAGES];
+    NexusPipelineComponentConfig* stages[BENCH_STAGES];
+    memset(stage_configs, 0, sizeof(stage_configs));
+    for (int i = 0; i < BENCH_STAGES; i++) {
+        stage_configs[i].component_id = bench_stage_ids[i];
+        stages[i] = &stage_configs[i];
+    }
+
+    NexusPipelineConfig config = {0};
+    config.pipeline_id = "chunked_bench";
+    config.components = stages;
+    config.component_count = BENCH_STAGES;
+    config.input_format = "binary";
+    config.output_format = "binary";
+
+    NexusPipeline* pipeline = bench_pipeline_create(ctx, &config, true);
+    SPEC_ASSERT(pipeline != NULL, "Pipeline creation failed");
+
+    // The same item, contiguous and spread over four chunks
+    unsigned char item[BENCH_ITEM_SIZE];
+    for (size_t j = 0; j < BENCH_ITEM_SIZE; j++) {
+        item[j] = (unsigned char)(j * 7u + 3u);
+    }
+    NexusDataStream* contiguous = sps_stream_create_from_data(item, BENCH_ITEM_SIZE, "binary");
+    NexusDataStream* chunked[2];
+    NexusDataStream* outputs[3];
+    for (size_t i = 0; i < 2; i++) {
+        chunked[i] = sps_stream_create_chunked(BENCH_ITEM_SIZE / 4);
+        SPEC_ASSERT(chunked[i] != NULL, "Chunked stream creation failed");
+        for (size_t part = 0; part < 4; part++) {
+            SPEC_EXPECT_EQ(sps_stream_write(chunked[i], item + part * (BENCH_ITEM_SIZE / 4),
+                                            BENCH_ITEM_SIZE / 4), NEXUS_SUCCESS);
+        }
+        SPEC_ASSERT(chunked[i]->data == NULL, "Input is not spread over several chunks");
+        chunked[i]->position = 0;
+    }
+    for (size_t i = 0; i < 3; i++) {
+        outputs[i] = sps_stream_create(BENCH_ITEM_SIZE);
+        SPEC_ASSERT(outputs[i] != NULL, "Stream creation failed");
+    }
+
+    SPEC_EXPECT_EQ(sps_pipeline_execute(ctx, pipeline, contiguous, outputs[0]), NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(sps_pipeline_execute(ctx, pipeline, chunked[0], outputs[1]), NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(sps_pipeline_execute_batch(ctx, pipeline, &chunked[1], &outputs[2], 1), NEXUS_SUCCESS);
+    for (size_t i = 1; i < 3; i++) {
+        SPEC_EXPECT_EQ(outputs[i]->size, (size_t)BENCH_ITEM_SIZE);
+        SPEC_ASSERT(memcmp(outputs[i]->data, outputs[0]->data, BENCH_ITEM_SIZE) == 0,
+                    "Chunked input gave a different result");
+    }
+
+    bench_pipeline_destroy(ctx, pipeline);
+    sps_stream_destroy(contiguous);
+    for (size_t i = 0; i < 2; i++) {
+        sps_stream_destroy(chunked[i]);
+    }
+    for (size_t i = 0; i < 3; i++) {
+        sps_stream_destroy(outputs[i]);
+    }
+    nexus_destroy_context(ctx);
+    return SPEC_PASS;
+}
+
+int main() {
+    etps_init();
+
+    spec_suite_t* suite = spec_suite_create("SPS_Batch_Performance_Specs");
+
+    spec_add_test(suite, "Pipeline throughput for batch sizes 1, 16 and 256", spec_sps_batch_throughput);
+    spec_add_test(suite, "Chunked inputs are flattened before the first stage", spec_sps_batch_chunked_input);
+
+    int result = spec_suite_run(suite);
+
+    spec_suite_destroy(suite);
+    etps_shutdown();
+
+    return result;
+}
@@ -0,0 +1,315 @@
+/**
+ * @file sps_parallel_spec.c
+ * @brief Dependency-Parallel Single-Pass Pipeline Performance Specifications
+ *
+ * Runs a diamond-shaped pipeline (one source, eight independent branches,
+ * one join that reads all branch outputs) with one worker and with a
+ * worker per branch. Checks that the schedule has three levels, that both
+ * runs produce the same output, and reports the measured speedup next to
+ * the parallelism available from the critical path. A second run makes
+ * half the branches fail and checks that every failure reaches the error
+ * handler on the calling thread, in pipeline order.
+ */
+
+#include "../spec_runner.c"
+#include "nlink/spsystem/sps_parallel.h"
+#include "nlink/spsystem/sps_pipeline.h"
+#include "nlink/spsystem/sps_stream.h"
+#include <pthread.h>
+#include <stdint.h>
+
+#define BENCH_BRANCHES 8
+#define BENCH_COMPONENTS (BENCH_BRANCHES + 2)
+#define BENCH_ITEM_SIZE 4096
+#define BENCH_BRANCH_ROUNDS 400
+#define BENCH_RUNS 8
+
+static char bench_ids[BENCH_COMPONENTS][24];
+
+static NexusResult bench_reserve(NexusDataStream* output, size_t size) {
+    if (output->capacity < size) {
+        return sps_stream_resize(output, size);
+    }
+    return NEXUS_SUCCESS;
+}
+
+// Source and join copy their input
+static NexusResult bench_copy_process(NexusPipelineComponent* component,
+                                      NexusDataStream* input,
+                                      NexusDataStream* output) {
+    (void)component;
+    size_t bytes = input->size - input->position;
+    NexusResult result = bench_reserve(output, bytes);
+    if (result != NEXUS_SUCCESS) {
+        return result;
+    }
+
+    memcpy(output->data, (const char*)input->data + input->position, bytes);
+    input->position += bytes;
+    output->size = bytes;
+    output->position = 0;
+    return NEXUS_SUCCESS;
+}
+
+// Each branch mixes every byte with its own index for a fixed number of rounds
+static NexusResult bench_branch_process(NexusPipelineComponent* component,
+                                        NexusDataStream* input,
+                                        NexusDataStream* output) {
+    uint32_t salt = (uint32_t)(component->component_id[7] - '0') * 2654435761u;
+    size_t bytes = input->size - input->position;
+    NexusResult result = bench_reserve(output, bytes);
+    if (result != NEXUS_SUCCESS) {
+        return result;
+    }
+
+    const unsigned char* in = (const unsigned char*)input->data + input->position;
+    unsigned char* out = (unsigned char*)output->data;
+    for (size_t i = 0; i < bytes; i++) {
+        uint32_t h = in[i] ^ salt ^ (uint32_t)i;
+        for (int r = 0; r < BENCH_BRANCH_ROUNDS; r++) {
+            h = h * 1103515245u + 12345u;
+            h ^= h >> 15;
+        }
+        out[i] = (unsigned char)h;
+    }
+
+    input->position += bytes;
+    output->size = bytes;
+    output->position = 0;
+    return NEXUS_SUCCESS;
+}
+
+// Odd branches fail in the failure spec
+static NexusResult bench_failing_process(NexusPipelineComponent* component,
+                                         NexusDataStream* input,
+                                         NexusDataStream* output) {
+    if ((component->component_id[7] - '0') % 2 == 1) {
+        return NEXUS_IO_ERROR;
+    }
+    return bench_branch_process(component, input, output);
+}
+
+// Stands in for a loaded component library; components run in-process
+static int bench_component_placeholder;
+
+static NexusPipeline* bench_pipeline_create(NexusContext* ctx, NexusPipelineConfig* config) {
+    NexusPipeline* pipeline = sps_pipeline_create(ctx, config);
+    if (!pipeline) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < pipeline->component_count; i++) {
+        NexusPipelineComponent* component = pipeline->components[i];
+        component->component = (NexusComponent*)&bench_component_placeholder;
+        component->process_func = strncmp(component->component_id, "branch_", 7) == 0
+            ? bench_branch_process : bench_copy_process;
+        component->is_initialized = true;
+    }
+    pipeline->is_initialized = true;
+    return pipeline;
+}
+
+static void bench_pipeline_destroy(NexusContext* ctx, NexusPipeline* pipeline) {
+    for (size_t i = 0; i < pipeline->component_count; i++) {
+        pipeline->components[i]->component = NULL;
+    }
+    sps_pipeline_destroy(ctx, pipeline);
+}
+
+// Runs the input BENCH_RUNS times; returns the mean wall time in ms
+static double bench_run(NexusParallelExecution* execution, NexusDataStream* input,
+                        NexusDataStream* output, bool* ok) {
+    double start = spec_now_ms();
+    for (int run = 0; run < BENCH_RUNS; run++) {
+        input->position = 0;
+        if (sps_parallel_execute(execution, input, output) != NEXUS_SUCCESS) {
+            *ok = false;
+        }
+    }
+    return (spec_now_ms() - start) / BENCH_RUNS;
+}
+
+// source <- branch_0..7 <- join; the configuration is static because the
+// pipeline keeps pointing at it
+static NexusPipeline* bench_diamond_create(NexusContext* ctx, bool allow_partial_processing) {
+    static const char* source_dep[1];
+    static const char* join_deps[BENCH_BRANCHES];
+    static NexusPipelineComponentConfig component_configs[BENCH_COMPONENTS];
+    static NexusPipelineComponentConfig* components[BENCH_COMPONENTS];
+    static NexusPipelineConfig config;
+    memset(component_configs, 0, sizeof(component_configs));
+
+    snprintf(bench_ids[0], sizeof(bench_ids[0]), "source");
+    source_dep[0] = bench_ids[0];
+    for (int b = 0; b < BENCH_BRANCHES; b++) {
+        snprintf(bench_ids[b + 1], sizeof(bench_ids[b + 1]), "branch_%d", b);
+        join_deps[b] = bench_ids[b + 1];
+        component_configs[b + 1].dependencies = source_dep;
+        component_configs[b + 1].dependency_count = 1;
+    }
+    snprintf(bench_ids[BENCH_COMPONENTS - 1], sizeof(bench_ids[0]), "join");
+    component_configs[BENCH_COMPONENTS - 1].dependencies = join_deps;
+    component_configs[BENCH_COMPONENTS - 1].dependency_count = BENCH_BRANCHES;
+
+    for (int i = 0; i < BENCH_COMPONENTS; i++) {
+        component_configs[i].component_id = bench_ids[i];
+        components[i] = &component_configs[i];
+    }
+
+    memset(&config, 0, sizeof(config));
+    config.pipeline_id = "parallel_bench";
+    config.components = components;
+    config.component_count = BENCH_COMPONENTS;
+    config.input_format = "binary";
+    config.output_format = "binary";
+    config.allow_partial_processing = allow_partial_processing;
+
+    return bench_pipeline_create(ctx, &config);
+}
+
+// Fills an item with reproducible noise
+static void bench_fill_item(unsigned char* item) {
+    uint32_t seed = 12345u;
+    for (size_t i = 0; i < BENCH_ITEM_SIZE; i++) {
+        seed = seed * 1103515245u + 12345u;
+        item[i] = (unsigned char)(seed >> 16);
+    }
+}
+
+spec_result_t spec_sps_parallel_diamond(void) {
+    NexusConfig context_config = {0};
+    context_config.log_level = NEXUS_LOG_ERROR;
+    NexusContext* ctx = nexus_create_context(&context_config);
+    SPEC_ASSERT(ctx != NULL, "Context creation failed");
+
+    NexusPipeline* pipeline = bench_diamond_create(ctx, false);
+    SPEC_ASSERT(pipeline != NULL, "Pipeline creation failed");
+    SPEC_ASSERT(pipeline->schedule != NULL, "Pipeline has no schedule");
+    SPEC_EXPECT_EQ(pipeline->schedule->level_count, 3);
+    SPEC_EXPECT_EQ(pipeline->schedule->max_level_width, BENCH_BRANCHES);
+
+    unsigned char item[BENCH_ITEM_SIZE];
+    bench_fill_item(item);
+    NexusDataStream* input = sps_stream_create_from_data(item, BENCH_ITEM_SIZE, "binary");
+    NexusDataStream* serial_output = sps_stream_create(BENCH_ITEM_SIZE);
+    NexusDataStream* parallel_output = sps_stream_create(BENCH_ITEM_SIZE);
+    SPEC_ASSERT(input && serial_output && parallel_output, "Stream creation failed");
+
+    NexusParallelExecution* serial = sps_parallel_start(ctx, pipeline, 1);
+    SPEC_ASSERT(serial != NULL, "Serial execution start failed");
+    bool ok = true;
+    bench_run(serial, input, serial_output, &ok);
+    double serial_ms = bench_run(serial, input, serial_output, &ok);
+    sps_parallel_destroy(serial);
+
+    NexusParallelExecution* parallel = sps_parallel_start(ctx, pipeline, BENCH_BRANCHES);
+    SPEC_ASSERT(parallel != NULL, "Parallel execution start failed");
+    bench_run(parallel, input, parallel_output, &ok);
+    double parallel_ms = bench_run(parallel, input, parallel_output, &ok);
+    SPEC_ASSERT(ok, "Pipeline execution failed");
+
+    // The join reads the branch outputs concatenated in declaration order
+    SPEC_EXPECT_EQ(serial_output->size, (size_t)BENCH_ITEM_SIZE * BENCH_BRANCHES);
+    SPEC_EXPECT_EQ(parallel_output->size, serial_output->size);
+    SPEC_ASSERT(memcmp(serial_output->data, parallel_output->data, serial_output->size) == 0,
+                "Parallel output differs from serial output");
+
+    NexusParallelStats stats;
+    SPEC_EXPECT_EQ(sps_parallel_get_stats(parallel, &stats), NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(stats.level_count, 3);
+    SPEC_ASSERT(stats.critical_path_ms <= stats.total_work_ms, "Critical path exceeds total work");
+
+    printf("\n      %zu components, %zu levels, widest %zu\n",
+           stats.component_count, stats.level_count, stats.max_level_width);
+    printf("      work %.2f ms, critical path %.2f ms, available parallelism %.2fx\n",
+           stats.total_work_ms, stats.critical_path_ms, stats.parallelism);
+    printf("      1 worker: %.2f ms, %zu workers: %.2f ms (%.2fx, %zu steals)\n      ",
+           serial_ms, stats.worker_count, parallel_ms, serial_ms / parallel_ms, stats.steals);
+
+    sps_parallel_destroy(parallel);
+    bench_pipeline_destroy(ctx, pipeline);
+    sps_stream_destroy(input);
+    sps_stream_destroy(serial_output);
+    sps_stream_destroy(parallel_output);
+    nexus_destroy_context(ctx);
+    return SPEC_PASS;
+}
+
+static pthread_t bench_caller;
+static size_t bench_error_calls;
+static size_t bench_errors_off_caller;
+static char bench_error_ids[BENCH_BRANCHES][24];
+
+static void bench_error_handler(NexusPipeline* pipeline, NexusResult result,
+                                const char* component_id, const char* message) {
+    (void)pipeline;
+    (void)result;
+    (void)message;
+    if (!pthread_equal(pthread_self(), bench_caller)) {
+        bench_errors_off_caller++;
+    }
+    if (bench_error_calls < BENCH_BRANCHES) {
+        snprintf(bench_error_ids[bench_error_calls], sizeof(bench_error_ids[0]), "%s", component_id);
+    }
+    bench_error_calls++;
+}
+
+spec_result_t spec_sps_parallel_failures(void) {
+    NexusConfig context_config = {0};
+    context_config.log_level = NEXUS_LOG_ERROR;
+    NexusContext* ctx = nexus_create_context(&context_config);
+    SPEC_ASSERT(ctx != NULL, "Context creation failed");
+
+    // Partial processing lets every branch run, so four fail at once
+    NexusPipeline* pipeline = bench_diamond_create(ctx, true);
+    SPEC_ASSERT(pipeline != NULL, "Pipeline creation failed");
+    for (int b = 0; b < BENCH_BRANCHES; b++) {
+        pipeline->components[b + 1]->process_func = bench_failing_process;
+    }
+    sps_pipeline_set_error_handler(pipeline, bench_error_handler);
+
+    unsigned char item[BENCH_ITEM_SIZE];
+    bench_fill_item(item);
+    NexusDataStream* input = sps_stream_create_from_data(item, BENCH_ITEM_SIZE, "binary");
+    NexusDataStream* output = sps_stream_create(BENCH_ITEM_SIZE);
+    SPEC_ASSERT(input && output, "Stream creation failed");
+
+    NexusParallelExecution* execution = sps_parallel_start(ctx, pipeline, BENCH_BRANCHES);
+    SPEC_ASSERT(execution != NULL, "Parallel execution start failed");
+
+    bench_caller = pthread_self();
+    bench_error_calls = 0;
+    bench_errors_off_caller = 0;
+    SPEC_EXPECT_EQ(sps_parallel_execute(execution, input, output), NEXUS_IO_ERROR);
+
+    SPEC_EXPECT_EQ(bench_error_calls, (size_t)(BENCH_BRANCHES / 2));
+    SPEC_EXPECT_EQ(bench_errors_off_caller, (size_t)0);
+    for (int k = 0; k < BENCH_BRANCHES / 2; k++) {
+        char expected[24];
+        snprintf(expected, sizeof(expected), "branch_%d", 2 * k + 1);
+        SPEC_EXPECT_STR_EQ(bench_error_ids[k], expected);
+    }
+
+    sps_parallel_destroy(execution);
+    bench_pipeline_destroy(ctx, pipeline);
+    sps_stream_destroy(input);
+    sps_stream_destroy(output);
+    nexus_destroy_context(ctx);
+    return SPEC_PASS;
+}
+
+int main() {
+    etps_init();
+
+    spec_suite_t* suite = spec_suite_create("SPS_Parallel_Performance_Specs");
+
+    spec_add_test(suite, "Diamond pipeline with one worker and one worker per branch", spec_sps_parallel_diamond);
+    spec_add_test(suite, "Failing branches are reported on the calling thread", spec_sps_parallel_failures);
+
+    int result = spec_suite_run(suite);
+
+    spec_suite_destroy(suite);
+    etps_shutdown();
+
+    return result;
+}
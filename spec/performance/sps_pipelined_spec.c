@@ -0,0 +1,275 @@
+/**
+ * @file sps_pipelined_spec.c
+ * @brief Pipelined Single-Pass Pipeline Performance Specifications
+ *
+ * Streams 2000 small items through a four-stage pipeline with one worker
+ * per stage, submitting from a producer thread while the main thread
+ * collects results. One stage does extra work on every seventh item so
+ * stages drift apart. Every result must come back in submission order
+ * with the value all four stages imply, and once the producer finishes
+ * the results run dry and every stage has seen every item. A second spec
+ * destroys an execution with items still in flight.
+ */
+
+#include "../spec_runner.c"
+#include "nlink/spsystem/sps_pipelined.h"
+#include "nlink/spsystem/sps_pipeline.h"
+#include "nlink/spsystem/sps_stream.h"
+#include <pthread.h>
+#include <stdint.h>
+
+#define BENCH_STAGES 4
+#define BENCH_ITEMS 2000
+#define BENCH_SLOW_ROUNDS 20000
+#define BENCH_QUEUE_CAPACITY 8
+
+static const char* bench_stage_ids[BENCH_STAGES] = { "stage_0", "stage_1", "stage_2", "stage_3" };
+
+// What stage s makes of a value
+static uint32_t bench_stage_value(uint32_t value, int stage) {
+    return value * 3u + (uint32_t)stage + 1u;
+}
+
+static NexusResult bench_stage_process(NexusPipelineComponent* component,
+                                       NexusDataStream* input,
+                                       NexusDataStream* output) {
+    int stage = component->component_id[6] - '0';
+    uint32_t value;
+    if (input->size - input->position < sizeof(value)) {
+        return NEXUS_INVALID_PARAMETER;
+    }
+    memcpy(&value, (const char*)input->data + input->position, sizeof(value));
+    input->position += sizeof(value);
+
+    // Stage 2 is slow on every seventh item
+    if (stage == 2 && value % 7 == 0) {
+        volatile uint32_t h = value;
+        for (int r = 0; r < BENCH_SLOW_ROUNDS; r++) {
+            h = h * 1103515245u + 12345u;
+        }
+    }
+
+    value = bench_stage_value(value, stage);
+    if (output->capacity < sizeof(value)) {
+        NexusResult result = sps_stream_resize(output, sizeof(value));
+        if (result != NEXUS_SUCCESS) {
+            return result;
+        }
+    }
+    memcpy(output->data, &value, sizeof(value));
+    output->size = sizeof(value);
+    output->position = 0;
+    return NEXUS_SUCCESS;
+}
+
+// Stands in for a loaded component library; components run in-process
+static int bench_component_placeholder;
+
+static NexusPipeline* bench_pipeline_create(NexusContext* ctx, NexusPipelineConfig* config,
+                                            NexusPipelineComponentConfig* component_configs,
+                                            NexusPipelineComponentConfig** components) {
+    memset(component_configs, 0, BENCH_STAGES * sizeof(NexusPipelineComponentConfig));
+    for (int i = 0; i < BENCH_STAGES; i++) {
+        component_configs[i].component_id = bench_stage_ids[i];
+        components[i] = &component_configs[i];
+    }
+
+    memset(config, 0, sizeof(*config));
+    config->pipeline_id = "pipelined_bench";
+    config->components = components;
+    config->component_count = BENCH_STAGES;
+    config->input_format = "binary";
+    config->output_format = "binary";
+
+    NexusPipeline* pipeline = sps_pipeline_create(ctx, config);
+    if (!pipeline) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < pipeline->component_count; i++) {
+        NexusPipelineComponent* component = pipeline->components[i];
+        component->component = (NexusComponent*)&bench_component_placeholder;
+        component->process_func = bench_stage_process;
+        component->is_initialized = true;
+    }
+    pipeline->is_initialized = true;
+    return pipeline;
+}
+
+static void bench_pipeline_destroy(NexusContext* ctx, NexusPipeline* pipeline) {
+    for (size_t i = 0; i < pipeline->component_count; i++) {
+        pipeline->components[i]->component = NULL;
+    }
+    sps_pipeline_destroy(ctx, pipeline);
+}
+
+typedef struct {
+    NexusPipelinedExecution* execution;
+    NexusDataStream** inputs;
+    NexusDataStream** outputs;
+    size_t count;
+    bool ok;
+} BenchProducer;
+
+static void* bench_producer_run(void* arg) {
+    BenchProducer* producer = (BenchProducer*)arg;
+    for (size_t i = 0; i < producer->count; i++) {
+        if (sps_pipelined_submit(producer->execution, producer->inputs[i],
+                                 producer->outputs[i]) != NEXUS_SUCCESS) {
+            producer->ok = false;
+            break;
+        }
+    }
+    sps_pipelined_finish(producer->execution);
+    return NULL;
+}
+
+spec_result_t spec_sps_pipelined_order(void) {
+    NexusConfig context_config = {0};
+    context_config.log_level = NEXUS_LOG_ERROR;
+    NexusContext* ctx = nexus_create_context(&context_config);
+    SPEC_ASSERT(ctx != NULL, "Context creation failed");
+
+    NexusPipelineConfig config;
+    NexusPipelineComponentConfig component_configs[BENCH_STAGES];
+    NexusPipelineComponentConfig* components[BENCH_STAGES];
+    NexusPipeline* pipeline = bench_pipeline_create(ctx, &config, component_configs, components);
+    SPEC_ASSERT(pipeline != NULL, "Pipeline creation failed");
+
+    static NexusDataStream* inputs[BENCH_ITEMS];
+    static NexusDataStream* outputs[BENCH_ITEMS];
+    for (uint32_t i = 0; i < BENCH_ITEMS; i++) {
+        inputs[i] = sps_stream_create_from_data(&i, sizeof(i), "binary");
+        outputs[i] = sps_stream_create(sizeof(uint32_t));
+        SPEC_ASSERT(inputs[i] && outputs[i], "Stream creation failed");
+    }
+
+    NexusPipelinedExecution* execution = sps_pipelined_start(ctx, pipeline, BENCH_QUEUE_CAPACITY);
+    SPEC_ASSERT(execution != NULL, "Pipelined execution start failed");
+    SPEC_EXPECT_EQ(sps_pipelined_get_stage_count(execution), (size_t)BENCH_STAGES);
+
+    BenchProducer producer = { execution, inputs, outputs, BENCH_ITEMS, true };
+    pthread_t producer_thread;
+    double start = spec_now_ms();
+    SPEC_ASSERT(pthread_create(&producer_thread, NULL, bench_producer_run, &producer) == 0,
+                "Producer thread start failed");
+
+    size_t received = 0, out_of_order = 0, wrong_values = 0, failures = 0;
+    NexusDataStream* input;
+    NexusDataStream* output;
+    NexusResult item_result;
+    while (sps_pipelined_next(execution, &input, &output, &item_result) == NEXUS_SUCCESS) {
+        if (received >= BENCH_ITEMS || input != inputs[received] || output != outputs[received]) {
+            out_of_order++;
+        } else {
+            uint32_t expected = (uint32_t)received;
+            for (int s = 0; s < BENCH_STAGES; s++) {
+                expected = bench_stage_value(expected, s);
+            }
+            uint32_t value = 0;
+            if (output->size == sizeof(value)) {
+                memcpy(&value, output->data, sizeof(value));
+            }
+            if (value != expected) {
+                wrong_values++;
+            }
+        }
+        if (item_result != NEXUS_SUCCESS) {
+            failures++;
+        }
+        received++;
+    }
+    double elapsed = spec_now_ms() - start;
+    pthread_join(producer_thread, NULL);
+
+    SPEC_ASSERT(producer.ok, "Submission failed");
+    SPEC_EXPECT_EQ(received, (size_t)BENCH_ITEMS);
+    SPEC_EXPECT_EQ(out_of_order, (size_t)0);
+    SPEC_EXPECT_EQ(wrong_values, (size_t)0);
+    SPEC_EXPECT_EQ(failures, (size_t)0);
+
+    // Drained and finished: no more results, and submissions are refused
+    SPEC_EXPECT_EQ(sps_pipelined_next(execution, NULL, NULL, NULL), NEXUS_NOT_FOUND);
+    SPEC_EXPECT_EQ(sps_pipelined_submit(execution, inputs[0], outputs[0]), NEXUS_INVALID_OPERATION);
+
+    printf("\n      %d items through %d stages: %.2f ms (%.1f us each)\n",
+           BENCH_ITEMS, BENCH_STAGES, elapsed, elapsed * 1e3 / BENCH_ITEMS);
+    for (size_t s = 0; s < BENCH_STAGES; s++) {
+        NexusPipelinedStageStats stats;
+        SPEC_EXPECT_EQ(sps_pipelined_get_stage_stats(execution, s, &stats), NEXUS_SUCCESS);
+        SPEC_EXPECT_EQ(stats.items_processed, (size_t)BENCH_ITEMS);
+        SPEC_EXPECT_EQ(stats.queue_depth, (size_t)0);
+        SPEC_ASSERT(stats.max_queue_depth <= stats.queue_capacity, "Queue overfilled");
+        printf("      %s: busy %.2f ms, starved %.2f ms, blocked %.2f ms, max depth %zu/%zu\n",
+               stats.component_id, stats.busy_ms, stats.input_stall_ms, stats.output_stall_ms,
+               stats.max_queue_depth, stats.queue_capacity);
+    }
+    printf("      ");
+
+    sps_pipelined_destroy(execution);
+    bench_pipeline_destroy(ctx, pipeline);
+    for (size_t i = 0; i < BENCH_ITEMS; i++) {
+        sps_stream_destroy(inputs[i]);
+        sps_stream_destroy(outputs[i]);
+    }
+    nexus_destroy_context(ctx);
+    return SPEC_PASS;
+}
+
+spec_result_t spec_sps_pipelined_destroy_in_flight(void) {
+    NexusConfig context_config = {0};
+    context_config.log_level = NEXUS_LOG_ERROR;
+    NexusContext* ctx = nexus_create_context(&context_config);
+    SPEC_ASSERT(ctx != NULL, "Context creation failed");
+
+    NexusPipelineConfig config;
+    NexusPipelineComponentConfig component_configs[BENCH_STAGES];
+    NexusPipelineComponentConfig* components[BENCH_STAGES];
+    NexusPipeline* pipeline = bench_pipeline_create(ctx, &config, component_configs, components);
+    SPEC_ASSERT(pipeline != NULL, "Pipeline creation failed");
+
+    NexusDataStream* inputs[BENCH_QUEUE_CAPACITY];
+    NexusDataStream* outputs[BENCH_QUEUE_CAPACITY];
+    for (uint32_t i = 0; i < BENCH_QUEUE_CAPACITY; i++) {
+        inputs[i] = sps_stream_create_from_data(&i, sizeof(i), "binary");
+        outputs[i] = sps_stream_create(sizeof(uint32_t));
+        SPEC_ASSERT(inputs[i] && outputs[i], "Stream creation failed");
+    }
+
+    // Destroy collects or discards whatever is still queued and joins every worker
+    NexusPipelinedExecution* execution = sps_pipelined_start(ctx, pipeline, BENCH_QUEUE_CAPACITY);
+    SPEC_ASSERT(execution != NULL, "Pipelined execution start failed");
+    for (size_t i = 0; i < BENCH_QUEUE_CAPACITY; i++) {
+        SPEC_EXPECT_EQ(sps_pipelined_submit(execution, inputs[i], outputs[i]), NEXUS_SUCCESS);
+    }
+    sps_pipelined_destroy(execution);
+
+    // An execution started and destroyed without items shuts down as well
+    execution = sps_pipelined_start(ctx, pipeline, 0);
+    SPEC_ASSERT(execution != NULL, "Second pipelined execution start failed");
+    sps_pipelined_destroy(execution);
+
+    bench_pipeline_destroy(ctx, pipeline);
+    for (size_t i = 0; i < BENCH_QUEUE_CAPACITY; i++) {
+        sps_stream_destroy(inputs[i]);
+        sps_stream_destroy(outputs[i]);
+    }
+    nexus_destroy_context(ctx);
+    return SPEC_PASS;
+}
+
+int main() {
+    etps_init();
+
+    spec_suite_t* suite = spec_suite_create("SPS_Pipelined_Performance_Specs");
+
+    spec_add_test(suite, "Items leave a four-stage pipeline in submission order", spec_sps_pipelined_order);
+    spec_add_test(suite, "Destroy with items in flight", spec_sps_pipelined_destroy_in_flight);
+
+    int result = spec_suite_run(suite);
+
+    spec_suite_destroy(suite);
+    etps_shutdown();
+
+    return result;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file stream_metadata_spec.c
+ * @brief Stream Metadata Performance Specifications
+ *
+ * Tags a stream with 4, 16 and 32 metadata entries and measures lookups
+ * by string key, lookups by interned key, and a clone/recycle round trip.
+ * The 4-tag case stays inline; the others spill into the hashed index.
+ */
+
+#include "../spec_runner.c"
+#include "nlink/spsystem/sps_stream.h"
+#include "nlink/core/symbols/intern.h"
+
+#define BENCH_MAX_TAGS 32
+#define BENCH_LOOKUPS 2000000
+#define BENCH_CLONES 200000
+
+static double bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+spec_result_t spec_stream_metadata_lookup(void) {
+    static char keys[BENCH_MAX_TAGS][32];
+    const char* interned[BENCH_MAX_TAGS];
+    size_t tag_counts[] = { 4, 16, BENCH_MAX_TAGS };
+
+    for (size_t i = 0; i < BENCH_MAX_TAGS; i++) {
+        snprintf(keys[i], sizeof(keys[i]), "message.tag.%zu", i);
+        interned[i] = nexus_intern(keys[i]);
+        SPEC_ASSERT(interned[i] != NULL, "Interning failed");
+    }
+
+    printf("\n");
+    for (size_t t = 0; t < sizeof(tag_counts) / sizeof(tag_counts[0]); t++) {
+        size_t tags = tag_counts[t];
+        NexusDataStream* stream = sps_stream_create(0);
+        SPEC_ASSERT(stream != NULL, "Stream creation failed");
+        for (size_t i = 0; i < tags; i++) {
+            SPEC_EXPECT_EQ(sps_stream_set_metadata(stream, keys[i], (void*)(i + 1), NULL), NEXUS_SUCCESS);
+        }
+
+        size_t hits = 0;
+        double start = bench_now_ns();
+        for (size_t n = 0; n < BENCH_LOOKUPS; n++) {
+            hits += sps_stream_get_metadata(stream, keys[n % tags]) != NULL;
+        }
+        double by_key = (bench_now_ns() - start) / BENCH_LOOKUPS;
+
+        start = bench_now_ns();
+        for (size_t n = 0; n < BENCH_LOOKUPS; n++) {
+            hits += sps_stream_get_metadata_interned(stream, interned[n % tags]) != NULL;
+        }
+        double by_interned = (bench_now_ns() - start) / BENCH_LOOKUPS;
+        SPEC_EXPECT_EQ(hits, (size_t)BENCH_LOOKUPS * 2);
+
+        start = bench_now_ns();
+        for (size_t n = 0; n < BENCH_CLONES; n++) {
+            NexusDataStream* clone = sps_stream_clone(stream);
+            SPEC_ASSERT(clone != NULL, "Clone failed");
+            SPEC_ASSERT(sps_stream_get_metadata_interned(clone, interned[tags - 1]) == (void*)tags,
+                        "Clone lost metadata");
+            sps_stream_destroy(clone);
+        }
+        double clone_ns = (bench_now_ns() - start) / BENCH_CLONES;
+
+        printf("      %2zu tags: %6.1f ns/lookup, %6.1f ns/interned lookup, %7.1f ns/clone\n",
+               tags, by_key, by_interned, clone_ns);
+
+        sps_stream_recycle(stream);
+        SPEC_ASSERT(sps_stream_get_metadata(stream, keys[0]) == NULL, "Recycle kept metadata");
+        sps_stream_destroy(stream);
+    }
+    printf("      ");
+
+    return SPEC_PASS;
+}
+
+int main() {
+    etps_init();
+
+    spec_suite_t* suite = spec_suite_create("Stream_Metadata_Performance_Specs");
+
+    spec_add_test(suite, "Metadata lookup and clone cost for 4, 16 and 32 tags", spec_stream_metadata_lookup);
+
+    int result = spec_suite_run(suite);
+
+    spec_suite_destroy(suite);
+    etps_shutdown();
+
+    return result;
+}
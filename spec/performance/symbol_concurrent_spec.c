@@ -0,0 +1,132 @@
+/**
+ * @file symbol_concurrent_spec.c
+ * @brief Concurrent Symbol Resolution Performance Specifications
+ *
+ * Measures nexus_resolve_symbol throughput on a registry in concurrent
+ * mode with 1 to 32 reader threads, while a writer keeps publishing new
+ * table versions.
+ */
+
+#include "../spec_runner.c"
+#include "nlink/core/symbols/concurrent_symbols.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+
+#define BENCH_SYMBOLS 10000
+#define BENCH_RESOLVES_PER_THREAD 500000
+#define BENCH_MAX_THREADS 32
+
+typedef struct {
+    NexusSymbolRegistry* registry;
+    size_t failures;
+} bench_reader_t;
+
+static atomic_bool bench_writer_stop;
+
+static void* bench_reader(void* arg) {
+    bench_reader_t* reader = (bench_reader_t*)arg;
+    char name[64];
+    uint32_t seed = (uint32_t)(uintptr_t)arg;
+
+    for (size_t i = 0; i < BENCH_RESOLVES_PER_THREAD; i++) {
+        seed = seed * 1103515245u + 12345u;
+        uint32_t id = (seed >> 8) % BENCH_SYMBOLS;
+        snprintf(name, sizeof(name), "symbol_%u", id);
+        if (nexus_resolve_symbol(reader->registry, name) != (void*)(uintptr_t)(id + 1)) {
+            reader->failures++;
+        }
+    }
+
+    return NULL;
+}
+
+// Keeps adding and removing a churn symbol so readers race with publication
+static void* bench_writer(void* arg) {
+    NexusSymbolRegistry* registry = (NexusSymbolRegistry*)arg;
+    while (!atomic_load(&bench_writer_stop)) {
+        nexus_symbol_table_add(&registry->imported, "churn", (void*)0x1, NEXUS_SYMBOL_FUNCTION, "writer");
+        nexus_symbol_table_remove(&registry->imported, "churn");
+    }
+    return NULL;
+}
+
+spec_result_t spec_symbol_concurrent_resolve_scaling(void) {
+    NexusSymbolRegistry* registry = nexus_init_symbol_registry();
+    SPEC_ASSERT(registry != NULL, "Registry creation failed");
+    SPEC_EXPECT_EQ(nexus_symbol_registry_enable_concurrent(registry), NEXUS_SUCCESS);
+
+    char name[64];
+    nexus_symbol_table_begin_update(&registry->exported);
+    for (size_t i = 0; i < BENCH_SYMBOLS; i++) {
+        snprintf(name, sizeof(name), "symbol_%zu", i);
+        SPEC_EXPECT_EQ(nexus_symbol_table_add(&registry->exported, name, (void*)(uintptr_t)(i + 1),
+                                              NEXUS_SYMBOL_FUNCTION, "bench"), NEXUS_SUCCESS);
+    }
+    nexus_symbol_table_end_update(&registry->exported);
+
+    double single_thread_rate = 0.0;
+    printf("\n");
+
+    for (int threads = 1; threads <= BENCH_MAX_THREADS; threads *= 2) {
+        pthread_t workers[BENCH_MAX_THREADS];
+        bench_reader_t readers[BENCH_MAX_THREADS];
+        pthread_t writer;
+
+        atomic_store(&bench_writer_stop, false);
+        pthread_create(&writer, NULL, bench_writer, registry);
+
+        double start = spec_now_ms();
+        for (int t = 0; t < threads; t++) {
+            readers[t].registry = registry;
+            readers[t].failures = 0;
+            pthread_create(&workers[t], NULL, bench_reader, &readers[t]);
+        }
+
+        size_t failures = 0;
+        for (int t = 0; t < threads; t++) {
+            pthread_join(workers[t], NULL);
+            failures += readers[t].failures;
+        }
+        double elapsed = spec_now_ms() - start;
+
+        atomic_store(&bench_writer_stop, true);
+        pthread_join(writer, NULL);
+
+        double rate = (double)threads * BENCH_RESOLVES_PER_THREAD / elapsed / 1000.0;
+        if (threads == 1) {
+            single_thread_rate = rate;
+        }
+        printf("      %2d threads: %8.2f M resolves/s (%.2fx)\n",
+               threads, rate, rate / single_thread_rate);
+
+        SPEC_EXPECT_EQ(failures, 0);
+    }
+    printf("      ");
+
+    // Every resolve is counted exactly once across the stripes
+    size_t total = 0;
+    for (size_t i = 0; i < registry->exported.size; i++) {
+        total += (size_t)nexus_symbol_get_ref_count(&registry->exported.symbols[i]);
+    }
+    SPEC_EXPECT_EQ(total, (size_t)BENCH_RESOLVES_PER_THREAD * (2 * BENCH_MAX_THREADS - 1));
+
+    nexus_cleanup_symbol_registry(registry);
+    return SPEC_PASS;
+}
+
+int main() {
+    etps_init();
+
+    spec_suite_t* suite = spec_suite_create("Symbol_Concurrent_Performance_Specs");
+
+    spec_add_test(suite, "Concurrent resolve scaling (1-32 threads)", spec_symbol_concurrent_resolve_scaling);
+
+    int result = spec_suite_run(suite);
+
+    spec_suite_destroy(suite);
+    nexus_intern_cleanup();
+    etps_shutdown();
+
+    return result;
+}
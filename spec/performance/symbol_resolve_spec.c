@@ -0,0 +1,122 @@
+/**
+ * @file symbol_resolve_spec.c
+ * @brief Symbol Registry Resolution Performance Specifications
+ *
+ * Resolves 1M names against a three-tier registry holding 100k symbols
+ * per table (exported, imported, global), mixing hits in every tier
+ * with misses.
+ */
+
+#include "../spec_runner.c"
+#include "nlink/core/symbols/nexus_symbols.h"
+#include <stdint.h>
+
+#define BENCH_SYMBOLS_PER_TABLE 100000
+#define BENCH_RESOLVE_COUNT 1000000
+
+static NexusResult bench_fill_table(NexusSymbolTable* table, const char* prefix, uintptr_t base) {
+    char name[64];
+    for (size_t i = 0; i < BENCH_SYMBOLS_PER_TABLE; i++) {
+        snprintf(name, sizeof(name), "%s_symbol_%zu", prefix, i);
+        NexusResult result = nexus_symbol_table_add(table, name, (void*)(base + i),
+                                                    NEXUS_SYMBOL_FUNCTION, "bench_component");
+        if (result != NEXUS_SUCCESS) {
+            return result;
+        }
+    }
+    return NEXUS_SUCCESS;
+}
+
+spec_result_t spec_symbol_resolve_1m_against_100k(void) {
+    NexusSymbolRegistry* registry = nexus_init_symbol_registry();
+    SPEC_ASSERT(registry != NULL, "Registry creation failed");
+
+    SPEC_EXPECT_EQ(bench_fill_table(&registry->exported, "exp", 0x100000), NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(bench_fill_table(&registry->imported, "imp", 0x200000), NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(bench_fill_table(&registry->global, "glb", 0x300000), NEXUS_SUCCESS);
+
+    // Pre-build the query names so the timed loop measures resolution only
+    static const char* prefixes[] = { "exp", "imp", "glb", "missing" };
+    char (*queries)[64] = malloc((size_t)BENCH_RESOLVE_COUNT * sizeof(*queries));
+    SPEC_ASSERT(queries != NULL, "Query allocation failed");
+
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < BENCH_RESOLVE_COUNT; i++) {
+        seed = seed * 1103515245u + 12345u;
+        snprintf(queries[i], sizeof(queries[i]), "%s_symbol_%u",
+                 prefixes[i & 3], (seed >> 8) % BENCH_SYMBOLS_PER_TABLE);
+    }
+
+    size_t hits = 0;
+    double start = spec_now_ms();
+    for (size_t i = 0; i < BENCH_RESOLVE_COUNT; i++) {
+        if (nexus_resolve_symbol(registry, queries[i])) {
+            hits++;
+        }
+    }
+    double elapsed = spec_now_ms() - start;
+
+    printf("\n      %d resolves in %.2f ms (%.1f ns/resolve, %zu hits)\n      ",
+           BENCH_RESOLVE_COUNT, elapsed, elapsed * 1e6 / BENCH_RESOLVE_COUNT, hits);
+
+    free(queries);
+
+    // Three of every four queries target an existing symbol
+    SPEC_EXPECT_EQ(hits, (size_t)BENCH_RESOLVE_COUNT / 4 * 3);
+
+    // Priority: exported shadows imported shadows global
+    nexus_symbol_table_add(&registry->global, "shadowed", (void*)0x1, NEXUS_SYMBOL_FUNCTION, "g");
+    nexus_symbol_table_add(&registry->imported, "shadowed", (void*)0x2, NEXUS_SYMBOL_FUNCTION, "i");
+    SPEC_ASSERT(nexus_resolve_symbol(registry, "shadowed") == (void*)0x2, "Imported must shadow global");
+    nexus_symbol_table_add(&registry->exported, "shadowed", (void*)0x3, NEXUS_SYMBOL_FUNCTION, "e");
+    SPEC_ASSERT(nexus_resolve_symbol(registry, "shadowed") == (void*)0x3, "Exported must shadow imported");
+
+    nexus_cleanup_symbol_registry(registry);
+    return SPEC_PASS;
+}
+
+spec_result_t spec_symbol_remove_keeps_index_consistent(void) {
+    NexusSymbolRegistry* registry = nexus_init_symbol_registry();
+    SPEC_ASSERT(registry != NULL, "Registry creation failed");
+
+    SPEC_EXPECT_EQ(bench_fill_table(&registry->exported, "exp", 0x100000), NEXUS_SUCCESS);
+
+    char name[64];
+    double start = spec_now_ms();
+    for (size_t i = 0; i < BENCH_SYMBOLS_PER_TABLE; i += 2) {
+        snprintf(name, sizeof(name), "exp_symbol_%zu", i);
+        SPEC_EXPECT_EQ(nexus_symbol_table_remove(&registry->exported, name), NEXUS_SUCCESS);
+    }
+    double elapsed = spec_now_ms() - start;
+    printf("\n      %d removes in %.2f ms\n      ", BENCH_SYMBOLS_PER_TABLE / 2, elapsed);
+
+    for (size_t i = 0; i < BENCH_SYMBOLS_PER_TABLE; i++) {
+        snprintf(name, sizeof(name), "exp_symbol_%zu", i);
+        void* address = nexus_resolve_symbol(registry, name);
+        if (i % 2 == 0) {
+            SPEC_ASSERT(address == NULL, "Removed symbol still resolves");
+        } else {
+            SPEC_ASSERT(address == (void*)(0x100000 + i), "Surviving symbol lost after remove");
+        }
+    }
+
+    nexus_cleanup_symbol_registry(registry);
+    return SPEC_PASS;
+}
+
+int main() {
+    etps_init();
+
+    spec_suite_t* suite = spec_suite_create("Symbol_Resolve_Performance_Specs");
+
+    spec_add_test(suite, "Resolve 1M names against 100k-symbol tables", spec_symbol_resolve_1m_against_100k);
+    spec_add_test(suite, "Remove keeps hash index consistent", spec_symbol_remove_keeps_index_consistent);
+
+    int result = spec_suite_run(suite);
+
+    spec_suite_destroy(suite);
+    nexus_intern_cleanup();
+    etps_shutdown();
+
+    return result;
+}
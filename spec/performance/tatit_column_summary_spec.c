@@ -0,0 +1,167 @@
+/**
+ * @file tatit_column_summary_spec.c
+ * @brief TATIT Columnar Numeric Summary Performance Specifications
+ *
+ * Summarizes 8M doubles through the boxed nlink_numerical_summary, with
+ * items pointing into the column in shuffled order as boxed values
+ * scattered over the heap would, and through nlink_summarize_column_f64
+ * serially and on the thread pool. Results are checked against a long
+ * double reference. A second spec times the float and int64 columns and
+ * the percentile path, and checks the compensated sum on a series that
+ * a naive sum gets wrong.
+ */
+
+#include "../spec_runner.c"
+#include "nlink/core/tatit/aggregation.h"
+#include <math.h>
+#include <stdint.h>
+
+#define BENCH_VALUES (8u << 20)
+#define BENCH_SMALL_VALUES 10000001
+
+static uint64_t bench_next(uint64_t* seed) {
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 7;
+    *seed ^= *seed << 17;
+    return *seed;
+}
+
+static bool bench_close(double actual, long double expected, double tolerance) {
+    return fabsl((long double)actual - expected) <= tolerance * fabsl(expected) + tolerance;
+}
+
+spec_result_t spec_tatit_column_vs_boxed(void) {
+    double* values = malloc(BENCH_VALUES * sizeof(double));
+    void** boxed = malloc(BENCH_VALUES * sizeof(void*));
+    SPEC_ASSERT(values != NULL && boxed != NULL, "Allocation failed");
+
+    uint64_t seed = 0x9E3779B97F4A7C15ull;
+    for (size_t i = 0; i < BENCH_VALUES; i++) {
+        values[i] = 1e6 + (double)(bench_next(&seed) % 1000000) / 1000.0;
+        boxed[i] = &values[i];
+    }
+    for (size_t i = BENCH_VALUES - 1; i > 0; i--) {
+        size_t j = bench_next(&seed) % (i + 1);
+        void* swap = boxed[i];
+        boxed[i] = boxed[j];
+        boxed[j] = swap;
+    }
+
+    long double sum = 0.0L;
+    for (size_t i = 0; i < BENCH_VALUES; i++) {
+        sum += values[i];
+    }
+    long double mean = sum / BENCH_VALUES;
+    long double deviations = 0.0L;
+    for (size_t i = 0; i < BENCH_VALUES; i++) {
+        deviations += (values[i] - mean) * (values[i] - mean);
+    }
+
+    double start = spec_now_ms();
+    nlink_aggregation_result* boxed_result = nlink_numerical_summary(boxed, BENCH_VALUES);
+    double boxed_ms = spec_now_ms() - start;
+    SPEC_ASSERT(boxed_result != NULL, "Boxed summary failed");
+
+    nlink_column_summary_config config = { NULL, NULL, 0, false, SIZE_MAX };
+    nlink_column_summary serial;
+    start = spec_now_ms();
+    SPEC_ASSERT(nlink_summarize_column_f64(values, BENCH_VALUES, &config, &serial), "Column summary failed");
+    double serial_ms = spec_now_ms() - start;
+
+    config.parallel_threshold = 0;
+    nlink_column_summary parallel;
+    start = spec_now_ms();
+    SPEC_ASSERT(nlink_summarize_column_f64(values, BENCH_VALUES, &config, &parallel), "Column summary failed");
+    double parallel_ms = spec_now_ms() - start;
+
+    SPEC_ASSERT(bench_close(serial.sum, sum, 1e-15), "Serial sum is inaccurate");
+    SPEC_ASSERT(bench_close(parallel.sum, sum, 1e-15), "Parallel sum is inaccurate");
+    SPEC_ASSERT(bench_close(serial.variance, deviations / BENCH_VALUES, 1e-12), "Variance is inaccurate");
+    SPEC_ASSERT(bench_close(parallel.variance, deviations / BENCH_VALUES, 1e-12), "Parallel variance is inaccurate");
+    SPEC_ASSERT(serial.min == *(double*)boxed_result->min && serial.max == *(double*)boxed_result->max,
+                "Min/max differ from the boxed path");
+
+    printf("\n      %u doubles\n", BENCH_VALUES);
+    printf("      boxed (min/max/sum/mean):     %.2f ms, sum error %.3Le\n",
+           boxed_ms, fabsl(boxed_result->numeric_sum - sum));
+    printf("      column serial (+variance):    %.2f ms, sum error %.3Le\n",
+           serial_ms, fabsl(serial.sum - sum));
+    printf("      column on pool (+variance):   %.2f ms\n      ", parallel_ms);
+
+    free(boxed_result->min);
+    free(boxed_result->max);
+    free(boxed_result->average);
+    nlink_aggregation_result_free(boxed_result);
+    free(values);
+    free(boxed);
+    return SPEC_PASS;
+}
+
+spec_result_t spec_tatit_column_types_and_percentiles(void) {
+    float* floats = malloc(BENCH_VALUES * sizeof(float));
+    int64_t* integers = malloc(BENCH_VALUES * sizeof(int64_t));
+    double* ones = malloc(BENCH_SMALL_VALUES * sizeof(double));
+    SPEC_ASSERT(floats != NULL && integers != NULL && ones != NULL, "Allocation failed");
+
+    uint64_t seed = 0xD1B54A32D192ED03ull;
+    for (size_t i = 0; i < BENCH_VALUES; i++) {
+        integers[i] = (int64_t)(bench_next(&seed) % 2000001) - 1000000;
+        floats[i] = (float)integers[i] / 8.0f;
+    }
+
+    nlink_column_summary summary;
+    double start = spec_now_ms();
+    SPEC_ASSERT(nlink_summarize_column_f32(floats, BENCH_VALUES, NULL, &summary), "Float summary failed");
+    double float_ms = spec_now_ms() - start;
+
+    start = spec_now_ms();
+    SPEC_ASSERT(nlink_summarize_column_i64(integers, BENCH_VALUES, NULL, &summary), "Integer summary failed");
+    double integer_ms = spec_now_ms() - start;
+    SPEC_ASSERT(summary.min >= -1000000.0 && summary.max <= 1000000.0, "Integer range is wrong");
+
+    // Uniform over [-1e6, 1e6]: quartiles near -5e5, 0 and 5e5
+    const double percentiles[] = { 0.0, 25.0, 50.0, 75.0, 100.0 };
+    double percentile_values[5];
+    nlink_column_summary_config config = { percentiles, percentile_values, 5, true, 0 };
+    start = spec_now_ms();
+    SPEC_ASSERT(nlink_summarize_column_i64(integers, BENCH_VALUES, &config, &summary), "Percentiles failed");
+    double percentile_ms = spec_now_ms() - start;
+    SPEC_EXPECT_EQ(percentile_values[0], summary.min);
+    SPEC_EXPECT_EQ(percentile_values[4], summary.max);
+    SPEC_ASSERT(fabs(percentile_values[2]) < 2000.0, "Median is off");
+    SPEC_ASSERT(fabs(percentile_values[1] + 500000.0) < 2000.0 && fabs(percentile_values[3] - 500000.0) < 2000.0,
+                "Quartiles are off");
+
+    // A naive sum of 1e16 followed by 1e7 ones never moves off 1e16
+    ones[0] = 1e16;
+    for (size_t i = 1; i < BENCH_SMALL_VALUES; i++) {
+        ones[i] = 1.0;
+    }
+    SPEC_ASSERT(nlink_summarize_column_f64(ones, BENCH_SMALL_VALUES, NULL, &summary), "Column summary failed");
+    SPEC_EXPECT_EQ(summary.sum, 1e16 + (BENCH_SMALL_VALUES - 1));
+
+    printf("\n      %u floats: %.2f ms, %u int64: %.2f ms\n", BENCH_VALUES, float_ms, BENCH_VALUES, integer_ms);
+    printf("      int64 with 5 percentiles: %.2f ms\n      ", percentile_ms);
+
+    free(floats);
+    free(integers);
+    free(ones);
+    return SPEC_PASS;
+}
+
+int main() {
+    etps_init();
+
+    spec_suite_t* suite = spec_suite_create("TATIT_Column_Summary_Performance_Specs");
+
+    spec_add_test(suite, "Columnar vs boxed summary of 8M doubles", spec_tatit_column_vs_boxed);
+    spec_add_test(suite, "Float/int64 columns, percentiles and compensated sums",
+                  spec_tatit_column_types_and_percentiles);
+
+    int result = spec_suite_run(suite);
+
+    spec_suite_destroy(suite);
+    etps_shutdown();
+
+    return result;
+}
@@ -0,0 +1,196 @@
+/**
+ * @file tatit_group_by_spec.c
+ * @brief TATIT Group-By Performance Specifications
+ *
+ * Groups 2M records by a value-compared key drawn from 200k values,
+ * serially and in four partitions, and checks both against a counting
+ * reference: every group complete, items in input order, groups in order
+ * of first appearance. A second spec groups by pointer key through the
+ * legacy nlink_group_by with 50k distinct keys, which the fixed
+ * 1024-slot table could not handle.
+ */
+
+#include "../spec_runner.c"
+#include "nlink/core/tatit/aggregation.h"
+#include <stdint.h>
+
+#define BENCH_ITEMS 2000000
+#define BENCH_KEYS 200000
+#define BENCH_PARTITIONS 4
+#define BENCH_LEGACY_ITEMS 200000
+#define BENCH_LEGACY_KEYS 50000
+
+typedef struct bench_record {
+    uint64_t key;
+    uint64_t index;
+} bench_record;
+
+static void* bench_record_key(void* item, void* context) {
+    (void)context;
+    return &((bench_record*)item)->key;
+}
+
+static size_t bench_key_hash(const void* key, void* context) {
+    (void)context;
+    uint64_t h = *(const uint64_t*)key;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    return (size_t)h;
+}
+
+static bool bench_key_equal(const void* a, const void* b, void* context) {
+    (void)context;
+    return *(const uint64_t*)a == *(const uint64_t*)b;
+}
+
+// Checks a grouping of records against per-key counts and first appearances
+static bool bench_grouping_valid(const nlink_grouping* grouping, bench_record* records, size_t count) {
+    size_t* sizes = calloc(BENCH_KEYS, sizeof(size_t));
+    size_t* first = malloc(BENCH_KEYS * sizeof(size_t));
+    bool valid = sizes != NULL && first != NULL && grouping->item_count == count &&
+                 grouping->offsets[grouping->group_count] == count;
+
+    for (size_t i = 0; valid && i < count; i++) {
+        if (sizes[records[i].key]++ == 0) {
+            first[records[i].key] = i;
+        }
+    }
+
+    size_t previous_first = 0;
+    for (size_t g = 0; valid && g < grouping->group_count; g++) {
+        uint64_t key = *(uint64_t*)grouping->keys[g];
+        size_t begin = grouping->offsets[g];
+        size_t end = grouping->offsets[g + 1];
+        valid = end - begin == sizes[key] && (g == 0 || first[key] > previous_first);
+        previous_first = first[key];
+
+        for (size_t i = begin; valid && i < end; i++) {
+            bench_record* record = grouping->items[i];
+            valid = record->key == key && (i == begin || record->index > ((bench_record*)grouping->items[i - 1])->index);
+        }
+    }
+
+    free(sizes);
+    free(first);
+    return valid;
+}
+
+spec_result_t spec_tatit_group_by_keys(void) {
+    bench_record* records = malloc(BENCH_ITEMS * sizeof(bench_record));
+    void** items = malloc(BENCH_ITEMS * sizeof(void*));
+    bool* seen = calloc(BENCH_KEYS, sizeof(bool));
+    SPEC_ASSERT(records != NULL && items != NULL && seen != NULL, "Allocation failed");
+
+    size_t distinct = 0;
+    uint64_t seed = 0x2545F4914F6CDD1Dull;
+    for (size_t i = 0; i < BENCH_ITEMS; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        records[i].key = seed % BENCH_KEYS;
+        records[i].index = i;
+        items[i] = &records[i];
+        if (!seen[records[i].key]) {
+            seen[records[i].key] = true;
+            distinct++;
+        }
+    }
+    free(seen);
+
+    nlink_group_by_config config = {
+        .key_fn = bench_record_key,
+        .hash_fn = bench_key_hash,
+        .equal_fn = bench_key_equal,
+        .context = NULL,
+        .expected_groups = 0,
+        .partitions = 1
+    };
+
+    double start = spec_now_ms();
+    nlink_grouping* serial = nlink_group_by_keys(items, BENCH_ITEMS, &config);
+    double serial_ms = spec_now_ms() - start;
+    SPEC_ASSERT(serial != NULL, "Serial group-by failed");
+
+    config.partitions = BENCH_PARTITIONS;
+    start = spec_now_ms();
+    nlink_grouping* partitioned = nlink_group_by_keys(items, BENCH_ITEMS, &config);
+    double partitioned_ms = spec_now_ms() - start;
+    SPEC_ASSERT(partitioned != NULL, "Partitioned group-by failed");
+
+    SPEC_EXPECT_EQ(serial->group_count, distinct);
+    SPEC_ASSERT(bench_grouping_valid(serial, records, BENCH_ITEMS), "Serial grouping is wrong");
+    SPEC_EXPECT_EQ(partitioned->group_count, serial->group_count);
+    SPEC_ASSERT(memcmp(partitioned->items, serial->items, BENCH_ITEMS * sizeof(void*)) == 0 &&
+                memcmp(partitioned->offsets, serial->offsets, (serial->group_count + 1) * sizeof(size_t)) == 0,
+                "Partitioned grouping differs from serial");
+
+    printf("\n      %d items, %zu distinct keys\n", BENCH_ITEMS, distinct);
+    printf("      serial: %.2f ms\n", serial_ms);
+    printf("      %d partitions: %.2f ms\n      ", BENCH_PARTITIONS, partitioned_ms);
+
+    nlink_grouping_free(serial);
+    nlink_grouping_free(partitioned);
+    free(records);
+    free(items);
+    return SPEC_PASS;
+}
+
+static void* bench_pointer_key(void* item, void* context) {
+    return (char*)context + *(uint64_t*)item;
+}
+
+spec_result_t spec_tatit_group_by_legacy(void) {
+    uint64_t* values = malloc(BENCH_LEGACY_ITEMS * sizeof(uint64_t));
+    void** items = malloc(BENCH_LEGACY_ITEMS * sizeof(void*));
+    char* key_space = malloc(BENCH_LEGACY_KEYS);
+    SPEC_ASSERT(values != NULL && items != NULL && key_space != NULL, "Allocation failed");
+
+    for (size_t i = 0; i < BENCH_LEGACY_ITEMS; i++) {
+        values[i] = (i * 7919) % BENCH_LEGACY_KEYS;
+        items[i] = &values[i];
+    }
+
+    size_t num_groups = 0;
+    double start = spec_now_ms();
+    void*** groups = nlink_group_by(items, BENCH_LEGACY_ITEMS, bench_pointer_key, key_space, &num_groups);
+    double elapsed = spec_now_ms() - start;
+
+    SPEC_ASSERT(groups != NULL, "Legacy group-by failed");
+    SPEC_EXPECT_EQ(num_groups, (size_t)BENCH_LEGACY_KEYS);
+
+    size_t total = 0;
+    for (size_t g = 0; g < num_groups; g++) {
+        for (size_t i = 0; groups[g][i] != NULL; i++) {
+            total++;
+        }
+        free(groups[g]);
+    }
+    SPEC_ASSERT(groups[num_groups] == NULL, "Group array is not NULL-terminated");
+    SPEC_EXPECT_EQ(total, (size_t)BENCH_LEGACY_ITEMS);
+    free(groups);
+
+    printf("\n      %d items, %d pointer keys: %.2f ms\n      ",
+           BENCH_LEGACY_ITEMS, BENCH_LEGACY_KEYS, elapsed);
+
+    free(values);
+    free(items);
+    free(key_space);
+    return SPEC_PASS;
+}
+
+int main() {
+    etps_init();
+
+    spec_suite_t* suite = spec_suite_create("TATIT_Group_By_Performance_Specs");
+
+    spec_add_test(suite, "Value-keyed grouping, serial and partitioned", spec_tatit_group_by_keys);
+    spec_add_test(suite, "Legacy pointer-keyed group-by with 50k keys", spec_tatit_group_by_legacy);
+
+    int result = spec_suite_run(suite);
+
+    spec_suite_destroy(suite);
+    etps_shutdown();
+
+    return result;
+}
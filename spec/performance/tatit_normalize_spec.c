@@ -0,0 +1,267 @@
+/**
+ * @file tatit_normalize_spec.c
+ * @brief TATIT Normalization Performance Specifications
+ *
+ * Normalizes 8M doubles per element through nlink_normalize, as
+ * nlink_normalize_array used to, and through nlink_normalize_into into a
+ * caller buffer and in place, checking that all three agree. A second
+ * spec checks z-scores against a long double reference and normalizes a
+ * row-major matrix of feature vectors column by column, matching
+ * nlink_normalize_into on each column. The last spec holds the two to
+ * the same answer on NaN entries, including one in the first row, and on
+ * constant columns with and without NaN.
+ */
+
+#include "../spec_runner.c"
+#include "nlink/core/tatit/transformation.h"
+#include <math.h>
+#include <stdint.h>
+
+#define BENCH_VALUES (8u << 20)
+#define BENCH_ROWS 250000
+#define BENCH_COLUMNS 32
+#define BENCH_ROUNDS 3
+#define EDGE_ROWS 64
+#define EDGE_COLUMNS 6
+
+static uint64_t bench_next(uint64_t* seed) {
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 7;
+    *seed ^= *seed << 17;
+    return *seed;
+}
+
+spec_result_t spec_tatit_normalize_fused(void) {
+    double* values = malloc(BENCH_VALUES * sizeof(double));
+    double* per_element = malloc(BENCH_VALUES * sizeof(double));
+    double* fused = malloc(BENCH_VALUES * sizeof(double));
+    SPEC_ASSERT(values != NULL && per_element != NULL && fused != NULL, "Allocation failed");
+
+    uint64_t seed = 0x9E3779B97F4A7C15ull;
+    for (size_t i = 0; i < BENCH_VALUES; i++) {
+        values[i] = (double)(bench_next(&seed) % 2000001) / 7.0 - 1e5;
+    }
+
+    double per_element_ms = 0, fused_ms = 0;
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        double start = spec_now_ms();
+        double min = values[0], max = values[0];
+        for (size_t i = 1; i < BENCH_VALUES; i++) {
+            min = values[i] < min ? values[i] : min;
+            max = values[i] > max ? values[i] : max;
+        }
+        for (size_t i = 0; i < BENCH_VALUES; i++) {
+            per_element[i] = nlink_normalize(values[i], min, max, -1.0, 1.0);
+        }
+        per_element_ms += spec_now_ms() - start;
+
+        start = spec_now_ms();
+        SPEC_ASSERT(nlink_normalize_into(values, fused, BENCH_VALUES, NLINK_NORMALIZE_MIN_MAX, -1.0, 1.0),
+                    "Normalize into buffer failed");
+        fused_ms += spec_now_ms() - start;
+    }
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < BENCH_VALUES; i++) {
+        if (fabs(fused[i] - per_element[i]) > 1e-12) {
+            mismatches++;
+        }
+    }
+    SPEC_EXPECT_EQ(mismatches, (size_t)0);
+
+    double start = spec_now_ms();
+    SPEC_ASSERT(nlink_normalize_into(values, values, BENCH_VALUES, NLINK_NORMALIZE_MIN_MAX, -1.0, 1.0),
+                "In-place normalize failed");
+    double in_place_ms = spec_now_ms() - start;
+    SPEC_ASSERT(memcmp(values, fused, BENCH_VALUES * sizeof(double)) == 0, "In-place result differs");
+
+    printf("\n      %u doubles into [-1, 1], mean of %d rounds\n", BENCH_VALUES, BENCH_ROUNDS);
+    printf("      per element:    %.2f ms\n", per_element_ms / BENCH_ROUNDS);
+    printf("      caller buffer:  %.2f ms\n", fused_ms / BENCH_ROUNDS);
+    printf("      in place:       %.2f ms\n      ", in_place_ms);
+
+    free(values);
+    free(per_element);
+    free(fused);
+    return SPEC_PASS;
+}
+
+spec_result_t spec_tatit_normalize_z_score_and_matrix(void) {
+    double* values = malloc(BENCH_VALUES * sizeof(double));
+    double* matrix = malloc((size_t)BENCH_ROWS * BENCH_COLUMNS * sizeof(double));
+    double* column = malloc(BENCH_ROWS * sizeof(double));
+    SPEC_ASSERT(values != NULL && matrix != NULL && column != NULL, "Allocation failed");
+
+    // Far from zero, where naive sums of squares cancel
+    uint64_t seed = 0xD1B54A32D192ED03ull;
+    for (size_t i = 0; i < BENCH_VALUES; i++) {
+        values[i] = 1e9 + (double)(bench_next(&seed) % 1000000) / 1000.0;
+    }
+    long double mean = 0.0L, deviations = 0.0L;
+    for (size_t i = 0; i < BENCH_VALUES; i++) {
+        mean += values[i];
+    }
+    mean /= BENCH_VALUES;
+    for (size_t i = 0; i < BENCH_VALUES; i++) {
+        deviations += (values[i] - mean) * (values[i] - mean);
+    }
+    long double deviation = sqrtl(deviations / BENCH_VALUES);
+    double expected_first = (double)((values[0] - mean) / deviation);
+
+    double start = spec_now_ms();
+    SPEC_ASSERT(nlink_normalize_into(values, values, BENCH_VALUES, NLINK_NORMALIZE_Z_SCORE, 0.0, 0.0),
+                "Z-score normalize failed");
+    double z_score_ms = spec_now_ms() - start;
+    SPEC_ASSERT(fabs(values[0] - expected_first) < 1e-9, "Z-score is inaccurate");
+
+    // Column c spans [0, c]; column 0 is constant and maps to the mid-point
+    for (size_t r = 0; r < BENCH_ROWS; r++) {
+        for (size_t c = 0; c < BENCH_COLUMNS; c++) {
+            matrix[r * BENCH_COLUMNS + c] = (double)(bench_next(&seed) % 1001) / 1000.0 * c;
+        }
+    }
+    double* normalized = malloc((size_t)BENCH_ROWS * BENCH_COLUMNS * sizeof(double));
+    SPEC_ASSERT(normalized != NULL, "Allocation failed");
+
+    double matrix_ms = 0;
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        start = spec_now_ms();
+        SPEC_ASSERT(nlink_normalize_matrix(matrix, normalized, BENCH_ROWS, BENCH_COLUMNS,
+                                           NLINK_NORMALIZE_MIN_MAX, 0.0, 1.0), "Matrix normalize failed");
+        matrix_ms += spec_now_ms() - start;
+    }
+
+    size_t mismatches = 0;
+    for (size_t c = 0; c < BENCH_COLUMNS; c++) {
+        for (size_t r = 0; r < BENCH_ROWS; r++) {
+            column[r] = matrix[r * BENCH_COLUMNS + c];
+        }
+        nlink_normalize_into(column, column, BENCH_ROWS, NLINK_NORMALIZE_MIN_MAX, 0.0, 1.0);
+        for (size_t r = 0; r < BENCH_ROWS; r++) {
+            if (normalized[r * BENCH_COLUMNS + c] != column[r]) {
+                mismatches++;
+            }
+        }
+    }
+    SPEC_EXPECT_EQ(mismatches, (size_t)0);
+    SPEC_EXPECT_EQ(normalized[0], 0.5);
+
+    start = spec_now_ms();
+    SPEC_ASSERT(nlink_normalize_matrix(matrix, matrix, BENCH_ROWS, BENCH_COLUMNS,
+                                       NLINK_NORMALIZE_Z_SCORE, 0.0, 0.0), "Matrix z-score failed");
+    double matrix_z_ms = spec_now_ms() - start;
+    for (size_t r = 0; r < BENCH_ROWS; r++) {
+        column[r] = matrix[r * BENCH_COLUMNS + BENCH_COLUMNS - 1];
+    }
+    double sum = 0.0, squares = 0.0;
+    for (size_t r = 0; r < BENCH_ROWS; r++) {
+        sum += column[r];
+        squares += column[r] * column[r];
+    }
+    SPEC_ASSERT(fabs(sum / BENCH_ROWS) < 1e-9 && fabs(squares / BENCH_ROWS - 1.0) < 1e-9,
+                "Matrix z-scores are not standardized");
+    SPEC_EXPECT_EQ(matrix[0], 0.0);
+
+    printf("\n      %u doubles to z-scores in place: %.2f ms\n", BENCH_VALUES, z_score_ms);
+    printf("      %d x %d matrix: min/max %.2f ms (mean of %d), z-score in place %.2f ms\n      ",
+           BENCH_ROWS, BENCH_COLUMNS, matrix_ms / BENCH_ROUNDS, BENCH_ROUNDS, matrix_z_ms);
+
+    free(values);
+    free(matrix);
+    free(normalized);
+    free(column);
+    return SPEC_PASS;
+}
+
+// Equal, or both NaN
+static bool bench_same(double actual, double expected) {
+    if (isnan(expected)) {
+        return isnan(actual);
+    }
+    return fabs(actual - expected) <= 1e-12 * fmax(1.0, fabs(expected));
+}
+
+// Normalize a matrix and each of its columns alone; count the cells that differ
+static size_t bench_matrix_mismatches(const double* matrix, const bool* compared,
+                                      nlink_normalize_mode mode, double target_min, double target_max) {
+    double normalized[EDGE_ROWS * EDGE_COLUMNS];
+    double column[EDGE_ROWS];
+    if (!nlink_normalize_matrix(matrix, normalized, EDGE_ROWS, EDGE_COLUMNS, mode, target_min, target_max)) {
+        return SIZE_MAX;
+    }
+
+    size_t mismatches = 0;
+    for (size_t c = 0; c < EDGE_COLUMNS; c++) {
+        if (!compared[c]) {
+            continue;
+        }
+        for (size_t r = 0; r < EDGE_ROWS; r++) {
+            column[r] = matrix[r * EDGE_COLUMNS + c];
+        }
+        nlink_normalize_into(column, column, EDGE_ROWS, mode, target_min, target_max);
+        for (size_t r = 0; r < EDGE_ROWS; r++) {
+            if (!bench_same(normalized[r * EDGE_COLUMNS + c], column[r])) {
+                mismatches++;
+            }
+        }
+    }
+    return mismatches;
+}
+
+spec_result_t spec_tatit_normalize_matrix_nan_and_constant(void) {
+    double matrix[EDGE_ROWS * EDGE_COLUMNS];
+    uint64_t seed = 0xA0761D6478BD642Full;
+
+    // 0: NaN in the first row, 1: scattered NaN, 2: constant with NaN,
+    // 3: all NaN, 4: constant far from zero, 5: spread far from zero
+    for (size_t r = 0; r < EDGE_ROWS; r++) {
+        double* row = matrix + r * EDGE_COLUMNS;
+        double spread = (double)(bench_next(&seed) % 100000) / 100.0;
+        row[0] = r == 0 ? NAN : spread;
+        row[1] = r % 5 == 2 ? NAN : -spread;
+        row[2] = r % 3 == 0 ? NAN : 3.0;
+        row[3] = NAN;
+        row[4] = 1e9 + 0.5;
+        row[5] = 1e9 + spread;
+    }
+
+    // Min/max on every column; z-scores only where the column has no NaN,
+    // since a NaN in the statistics is unspecified for both
+    static const bool every_column[EDGE_COLUMNS] = { true, true, true, true, true, true };
+    static const bool finite_columns[EDGE_COLUMNS] = { false, false, false, false, true, true };
+    SPEC_EXPECT_EQ(bench_matrix_mismatches(matrix, every_column, NLINK_NORMALIZE_MIN_MAX, -1.0, 1.0),
+                   (size_t)0);
+    SPEC_EXPECT_EQ(bench_matrix_mismatches(matrix, every_column, NLINK_NORMALIZE_MIN_MAX, 0.0, 0.0),
+                   (size_t)0);
+    SPEC_EXPECT_EQ(bench_matrix_mismatches(matrix, finite_columns, NLINK_NORMALIZE_Z_SCORE, 0.0, 0.0),
+                   (size_t)0);
+
+    // Spot checks: the first row's NaN stays NaN without poisoning its column,
+    // and a constant column maps every entry, NaN included, to the mid-point
+    double normalized[EDGE_ROWS * EDGE_COLUMNS];
+    SPEC_ASSERT(nlink_normalize_matrix(matrix, normalized, EDGE_ROWS, EDGE_COLUMNS,
+                                       NLINK_NORMALIZE_MIN_MAX, -1.0, 1.0), "Matrix normalize failed");
+    SPEC_ASSERT(isnan(normalized[0]), "NaN input did not stay NaN");
+    SPEC_ASSERT(!isnan(normalized[EDGE_COLUMNS]), "NaN in the first row poisoned its column");
+    SPEC_EXPECT_EQ(normalized[2], 0.0);
+    SPEC_EXPECT_EQ(normalized[3], 0.0);
+    return SPEC_PASS;
+}
+
+int main() {
+    etps_init();
+
+    spec_suite_t* suite = spec_suite_create("TATIT_Normalize_Performance_Specs");
+
+    spec_add_test(suite, "Per-element vs fused normalize of 8M doubles", spec_tatit_normalize_fused);
+    spec_add_test(suite, "Z-scores and row-major matrix normalize", spec_tatit_normalize_z_score_and_matrix);
+    spec_add_test(suite, "Matrix and column normalize agree on NaN and constant columns",
+                  spec_tatit_normalize_matrix_nan_and_constant);
+
+    int result = spec_suite_run(suite);
+
+    spec_suite_destroy(suite);
+    etps_shutdown();
+
+    return result;
+}
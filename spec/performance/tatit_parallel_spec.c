@@ -0,0 +1,230 @@
+/**
+ * @file tatit_parallel_spec.c
+ * @brief TATIT Parallel Map/Filter/Fold and Sort Performance Specifications
+ *
+ * Runs a map -> filter -> fold chain over 4M items three ways: through
+ * the serial nlink_map, nlink_filter and nlink_fold, which build an
+ * array per step; through nlink_map_parallel and nlink_filter_parallel
+ * into a caller buffer and an arena; and fused into one pass by
+ * nlink_map_filter_fold. All must agree, and the parallel filter must
+ * keep input order. A second spec sorts 2M items with nlink_sort and
+ * nlink_sort_parallel, including chunk counts that leave odd runs, and
+ * exercises nlink_transform_array_parallel's release and abort paths.
+ */
+
+#include "../spec_runner.c"
+#include "nlink/core/tatit/abstraction.h"
+#include "nlink/core/tatit/transformation.h"
+#include <stdint.h>
+
+#define BENCH_ITEMS 4000000
+#define BENCH_SORT_ITEMS 2000000
+#define BENCH_BOXES 200000
+#define BENCH_FAIL_AT 123457
+
+static uint64_t bench_next(uint64_t* seed) {
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 7;
+    *seed ^= *seed << 17;
+    return *seed;
+}
+
+// Items are integers carried in the pointer, never 0
+static void* bench_triple(void* item, void* context) {
+    (void)context;
+    return (void*)((uintptr_t)item * 3);
+}
+
+static bool bench_keep(void* item, void* context) {
+    (void)context;
+    return (uintptr_t)item % 7 != 0;
+}
+
+static void* bench_add(void* accumulator, void* item, void* context) {
+    (void)context;
+    return (void*)((uintptr_t)accumulator + (uintptr_t)item);
+}
+
+static int bench_compare(void* a, void* b, void* context) {
+    (void)context;
+    return (uintptr_t)a < (uintptr_t)b ? -1 : (uintptr_t)a > (uintptr_t)b;
+}
+
+spec_result_t spec_tatit_parallel_map_filter_fold(void) {
+    void** items = malloc(BENCH_ITEMS * sizeof(void*));
+    void** mapped = malloc(BENCH_ITEMS * sizeof(void*));
+    SPEC_ASSERT(items != NULL && mapped != NULL, "Allocation failed");
+
+    uint64_t seed = 0x9E3779B97F4A7C15ull;
+    for (size_t i = 0; i < BENCH_ITEMS; i++) {
+        items[i] = (void*)(uintptr_t)(bench_next(&seed) % 1000000 + 1);
+    }
+
+    size_t mapped_count = 0, kept_count = 0;
+    double start = spec_now_ms();
+    void** serial_mapped = nlink_map(items, BENCH_ITEMS, bench_triple, NULL, &mapped_count);
+    void** serial_kept = nlink_filter(serial_mapped, mapped_count, bench_keep, NULL, &kept_count);
+    uintptr_t serial_sum = (uintptr_t)nlink_fold(serial_kept, kept_count, NULL, bench_add, NULL);
+    double serial_ms = spec_now_ms() - start;
+    SPEC_ASSERT(serial_mapped != NULL && serial_kept != NULL, "Serial chain failed");
+
+    NlinkArena arena;
+    nlink_arena_init(&arena, 0);
+    nlink_parallel_config config = { 0 };
+    config.arena = &arena;
+
+    size_t parallel_kept = 0;
+    start = spec_now_ms();
+    SPEC_ASSERT(nlink_map_parallel(items, BENCH_ITEMS, bench_triple, NULL, mapped, &config) == mapped,
+                "Parallel map failed");
+    void** kept = nlink_filter_parallel(mapped, BENCH_ITEMS, bench_keep, NULL, NULL, &parallel_kept, &config);
+    SPEC_ASSERT(kept != NULL, "Parallel filter failed");
+    nlink_fused_ops sum_ops = { NULL, NULL, bench_add, bench_add, NULL, NULL };
+    uintptr_t parallel_sum = (uintptr_t)nlink_map_filter_fold(kept, parallel_kept, NULL, &sum_ops, &config);
+    double parallel_ms = spec_now_ms() - start;
+
+    SPEC_EXPECT_EQ(parallel_kept, kept_count);
+    SPEC_ASSERT(memcmp(kept, serial_kept, kept_count * sizeof(void*)) == 0, "Parallel filter changed the order");
+    SPEC_EXPECT_EQ(parallel_sum, serial_sum);
+
+    nlink_fused_ops ops = { bench_triple, bench_keep, bench_add, NULL, NULL, NULL };
+    start = spec_now_ms();
+    uintptr_t fused_serial = (uintptr_t)nlink_map_filter_fold(items, BENCH_ITEMS, NULL, &ops, &config);
+    double fused_serial_ms = spec_now_ms() - start;
+
+    ops.combine_fn = bench_add;
+    start = spec_now_ms();
+    uintptr_t fused_parallel = (uintptr_t)nlink_map_filter_fold(items, BENCH_ITEMS, NULL, &ops, &config);
+    double fused_parallel_ms = spec_now_ms() - start;
+
+    SPEC_EXPECT_EQ(fused_serial, serial_sum);
+    SPEC_EXPECT_EQ(fused_parallel, serial_sum);
+
+    // In place, and below the cutoff on the calling thread
+    size_t small_kept = 0;
+    SPEC_EXPECT_EQ(nlink_parallel_chunk_count(1000, NULL), (size_t)1);
+    SPEC_ASSERT(nlink_filter_parallel(mapped, 1000, bench_keep, NULL, mapped, &small_kept, NULL) == mapped,
+                "In-place filter failed");
+    SPEC_ASSERT(memcmp(mapped, serial_kept, small_kept * sizeof(void*)) == 0, "In-place filter is wrong");
+
+    printf("\n      %d items, %zu chunks on %zu workers\n", BENCH_ITEMS,
+           nlink_parallel_chunk_count(BENCH_ITEMS, NULL), nlink_thread_pool_worker_count(nlink_thread_pool_shared()));
+    printf("      serial map/filter/fold:        %.2f ms\n", serial_ms);
+    printf("      parallel into buffer/arena:    %.2f ms\n", parallel_ms);
+    printf("      fused, serial:                 %.2f ms\n", fused_serial_ms);
+    printf("      fused, parallel:               %.2f ms\n      ", fused_parallel_ms);
+
+    nlink_arena_destroy(&arena);
+    free(serial_mapped);
+    free(serial_kept);
+    free(items);
+    free(mapped);
+    return SPEC_PASS;
+}
+
+static void* bench_box_increment(void* item, void* context) {
+    (void)context;
+    uint64_t* box = malloc(sizeof(uint64_t));
+    if (box != NULL) {
+        *box = *(uint64_t*)item + 1;
+    }
+    return box;
+}
+
+static void* bench_box_fail(void* item, void* context) {
+    return *(uint64_t*)item == *(uint64_t*)context ? NULL : bench_box_increment(item, NULL);
+}
+
+spec_result_t spec_tatit_parallel_sort_and_transform(void) {
+    void** serial = malloc(BENCH_SORT_ITEMS * sizeof(void*));
+    void** parallel = malloc(BENCH_SORT_ITEMS * sizeof(void*));
+    void** odd = malloc(BENCH_SORT_ITEMS * sizeof(void*));
+    SPEC_ASSERT(serial != NULL && parallel != NULL && odd != NULL, "Allocation failed");
+
+    uint64_t seed = 0xD1B54A32D192ED03ull;
+    for (size_t i = 0; i < BENCH_SORT_ITEMS; i++) {
+        serial[i] = (void*)(uintptr_t)(bench_next(&seed) % 100000000 + 1);
+    }
+    memcpy(parallel, serial, BENCH_SORT_ITEMS * sizeof(void*));
+    memcpy(odd, serial, BENCH_SORT_ITEMS * sizeof(void*));
+
+    double start = spec_now_ms();
+    nlink_sort(serial, BENCH_SORT_ITEMS, bench_compare, NULL);
+    double serial_ms = spec_now_ms() - start;
+
+    start = spec_now_ms();
+    SPEC_ASSERT(nlink_sort_parallel(parallel, BENCH_SORT_ITEMS, bench_compare, NULL, NULL), "Parallel sort failed");
+    double parallel_ms = spec_now_ms() - start;
+    SPEC_ASSERT(memcmp(serial, parallel, BENCH_SORT_ITEMS * sizeof(void*)) == 0, "Parallel sort differs");
+
+    // Seven chunks: merge rounds with a leftover run and split merges
+    nlink_parallel_config config = { 0 };
+    config.chunk_size = BENCH_SORT_ITEMS / 7 + 1;
+    SPEC_EXPECT_EQ(nlink_parallel_chunk_count(BENCH_SORT_ITEMS, &config), (size_t)7);
+    SPEC_ASSERT(nlink_sort_parallel(odd, BENCH_SORT_ITEMS, bench_compare, NULL, &config), "Parallel sort failed");
+    SPEC_ASSERT(memcmp(serial, odd, BENCH_SORT_ITEMS * sizeof(void*)) == 0, "Seven-chunk sort differs");
+
+    // Transform boxes, releasing the originals; then abort part way through
+    void** boxes = malloc(BENCH_BOXES * sizeof(void*));
+    void** results = malloc(BENCH_BOXES * sizeof(void*));
+    SPEC_ASSERT(boxes != NULL && results != NULL, "Allocation failed");
+    for (size_t i = 0; i < BENCH_BOXES; i++) {
+        boxes[i] = malloc(sizeof(uint64_t));
+        SPEC_ASSERT(boxes[i] != NULL, "Allocation failed");
+        *(uint64_t*)boxes[i] = i;
+    }
+
+    nlink_transform_config transform = { 0 };
+    transform.transform_fn = bench_box_increment;
+    transform.preserve_original = false;
+    config.chunk_size = BENCH_BOXES / 5;
+    start = spec_now_ms();
+    SPEC_ASSERT(nlink_transform_array_parallel(boxes, BENCH_BOXES, &transform, results, &config) == results,
+                "Parallel transform failed");
+    double transform_ms = spec_now_ms() - start;
+    size_t wrong = 0;
+    for (size_t i = 0; i < BENCH_BOXES; i++) {
+        wrong += *(uint64_t*)results[i] != i + 1;
+    }
+    SPEC_EXPECT_EQ(wrong, (size_t)0);
+
+    uint64_t fail_at = BENCH_FAIL_AT + 1;
+    transform.transform_fn = bench_box_fail;
+    transform.context = &fail_at;
+    transform.abort_on_error = true;
+    SPEC_ASSERT(nlink_transform_array_parallel(results, BENCH_BOXES, &transform, boxes, &config) == NULL,
+                "Aborted transform reported success");
+    for (size_t i = 0; i < BENCH_BOXES; i++) {
+        wrong += *(uint64_t*)results[i] != i + 1;
+        free(results[i]);
+    }
+    SPEC_EXPECT_EQ(wrong, (size_t)0);
+
+    printf("\n      %d items: nlink_sort %.2f ms, nlink_sort_parallel %.2f ms\n",
+           BENCH_SORT_ITEMS, serial_ms, parallel_ms);
+    printf("      %d boxes transformed and released in 5 chunks: %.2f ms\n      ", BENCH_BOXES, transform_ms);
+
+    free(boxes);
+    free(results);
+    free(serial);
+    free(parallel);
+    free(odd);
+    return SPEC_PASS;
+}
+
+int main() {
+    etps_init();
+
+    spec_suite_t* suite = spec_suite_create("TATIT_Parallel_Performance_Specs");
+
+    spec_add_test(suite, "Serial, parallel and fused map/filter/fold of 4M items",
+                  spec_tatit_parallel_map_filter_fold);
+    spec_add_test(suite, "Parallel sort and transform", spec_tatit_parallel_sort_and_transform);
+
+    int result = spec_suite_run(suite);
+
+    spec_suite_destroy(suite);
+    etps_shutdown();
+
+    return result;
+}
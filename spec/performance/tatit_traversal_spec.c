@@ -0,0 +1,173 @@
+/**
+ * @file tatit_traversal_spec.c
+ * @brief TATIT Graph Traversal Performance Specifications
+ *
+ * Walks a 100k-node graph with four out-edges per node, half of them
+ * back into already-seen territory, by DFS and BFS. Each walk runs once
+ * with the pointer-keyed visited set and once with the dense-ID bitset,
+ * and the results are checked against each other. A second spec times
+ * nlink_traversal_visited and nlink_traversal_get_result over every
+ * node of a finished walk.
+ */
+
+#include "../spec_runner.c"
+#include "nlink/core/tatit/traversal.h"
+#include <stdint.h>
+
+#define BENCH_NODES 100000
+#define BENCH_EDGES 4
+
+typedef struct bench_node {
+    size_t id;
+    struct bench_node* adjacent[BENCH_EDGES];
+} bench_node;
+
+static bench_node* bench_graph_create(void) {
+    bench_node* nodes = calloc(BENCH_NODES, sizeof(bench_node));
+    if (nodes == NULL) {
+        return NULL;
+    }
+
+    uint64_t seed = 88172645463325252ull;
+    for (size_t i = 0; i < BENCH_NODES; i++) {
+        nodes[i].id = i;
+        // Two forward edges keep everything reachable, two random ones revisit
+        nodes[i].adjacent[0] = &nodes[(i + 1) % BENCH_NODES];
+        nodes[i].adjacent[1] = &nodes[(i * 2 + 1) % BENCH_NODES];
+        for (int e = 2; e < BENCH_EDGES; e++) {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            nodes[i].adjacent[e] = &nodes[seed % BENCH_NODES];
+        }
+    }
+
+    return nodes;
+}
+
+static void* bench_get_adjacent(void* node, size_t index, void* context) {
+    (void)context;
+    return ((bench_node*)node)->adjacent[index];
+}
+
+static size_t bench_adjacent_count(void* node, void* context) {
+    (void)node;
+    (void)context;
+    return BENCH_EDGES;
+}
+
+static size_t bench_node_id(void* node, void* context) {
+    (void)context;
+    return ((bench_node*)node)->id;
+}
+
+static void* bench_visit(void* node, void* context) {
+    (void)context;
+    return (void*)(uintptr_t)(((bench_node*)node)->id + 1);
+}
+
+static bool bench_same_order(const nlink_traversal_result* a, const nlink_traversal_result* b) {
+    if (a->count != b->count) {
+        return false;
+    }
+    for (size_t i = 0; i < a->count; i++) {
+        if (a->nodes[i] != b->nodes[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+spec_result_t spec_tatit_graph_traversal(void) {
+    bench_node* nodes = bench_graph_create();
+    SPEC_ASSERT(nodes != NULL, "Graph allocation failed");
+
+    double start = spec_now_ms();
+    nlink_traversal_result* dfs = nlink_traverse_graph_dfs(
+        nodes, bench_get_adjacent, bench_adjacent_count, bench_visit, NULL);
+    double dfs_ms = spec_now_ms() - start;
+
+    start = spec_now_ms();
+    nlink_traversal_result* dfs_dense = nlink_traverse_graph_dfs_dense(
+        nodes, bench_get_adjacent, bench_adjacent_count, bench_visit, bench_node_id, BENCH_NODES, NULL);
+    double dfs_dense_ms = spec_now_ms() - start;
+
+    start = spec_now_ms();
+    nlink_traversal_result* bfs = nlink_traverse_graph_bfs(
+        nodes, bench_get_adjacent, bench_adjacent_count, bench_visit, NULL);
+    double bfs_ms = spec_now_ms() - start;
+
+    start = spec_now_ms();
+    nlink_traversal_result* bfs_dense = nlink_traverse_graph_bfs_dense(
+        nodes, bench_get_adjacent, bench_adjacent_count, bench_visit, bench_node_id, BENCH_NODES, NULL);
+    double bfs_dense_ms = spec_now_ms() - start;
+
+    SPEC_ASSERT(dfs != NULL && dfs_dense != NULL && bfs != NULL && bfs_dense != NULL, "Traversal failed");
+    SPEC_EXPECT_EQ(dfs->count, (size_t)BENCH_NODES);
+    SPEC_EXPECT_EQ(bfs->count, (size_t)BENCH_NODES);
+    SPEC_ASSERT(bench_same_order(dfs, dfs_dense), "Dense DFS order differs");
+    SPEC_ASSERT(bench_same_order(bfs, bfs_dense), "Dense BFS order differs");
+
+    // An ID outside the declared range fails the dense walk
+    SPEC_ASSERT(nlink_traverse_graph_bfs_dense(nodes, bench_get_adjacent, bench_adjacent_count,
+                                               bench_visit, bench_node_id, BENCH_NODES / 2, NULL) == NULL,
+                "Out-of-range ID accepted");
+
+    printf("\n      %d nodes, %d edges each\n", BENCH_NODES, BENCH_EDGES);
+    printf("      DFS: %.2f ms pointer set, %.2f ms bitset\n", dfs_ms, dfs_dense_ms);
+    printf("      BFS: %.2f ms pointer set, %.2f ms bitset\n      ", bfs_ms, bfs_dense_ms);
+
+    nlink_traversal_result_free(dfs);
+    nlink_traversal_result_free(dfs_dense);
+    nlink_traversal_result_free(bfs);
+    nlink_traversal_result_free(bfs_dense);
+    free(nodes);
+    return SPEC_PASS;
+}
+
+spec_result_t spec_tatit_result_lookup(void) {
+    bench_node* nodes = bench_graph_create();
+    SPEC_ASSERT(nodes != NULL, "Graph allocation failed");
+
+    nlink_traversal_result* result = nlink_traverse_graph_bfs(
+        nodes, bench_get_adjacent, bench_adjacent_count, bench_visit, NULL);
+    SPEC_ASSERT(result != NULL, "Traversal failed");
+
+    size_t mismatches = 0;
+    double start = spec_now_ms();
+    for (size_t i = 0; i < BENCH_NODES; i++) {
+        if (!nlink_traversal_visited(result, &nodes[i]) ||
+            nlink_traversal_get_result(result, &nodes[i]) != (void*)(uintptr_t)(i + 1)) {
+            mismatches++;
+        }
+    }
+    double elapsed = spec_now_ms() - start;
+
+    SPEC_EXPECT_EQ(mismatches, (size_t)0);
+    bench_node outside = { 0 };
+    SPEC_ASSERT(!nlink_traversal_visited(result, &outside), "Unvisited node reported as visited");
+    SPEC_ASSERT(nlink_traversal_get_result(result, &outside) == NULL, "Unvisited node has a result");
+
+    printf("\n      %d visited + get_result lookups: %.2f ms (%.1f ns each)\n      ",
+           BENCH_NODES, elapsed, elapsed * 1e6 / (2.0 * BENCH_NODES));
+
+    nlink_traversal_result_free(result);
+    free(nodes);
+    return SPEC_PASS;
+}
+
+int main() {
+    etps_init();
+
+    spec_suite_t* suite = spec_suite_create("TATIT_Traversal_Performance_Specs");
+
+    spec_add_test(suite, "Graph DFS/BFS with pointer and bitset visited sets", spec_tatit_graph_traversal);
+    spec_add_test(suite, "Visited and result lookups on a finished traversal", spec_tatit_result_lookup);
+
+    int result = spec_suite_run(suite);
+
+    spec_suite_destroy(suite);
+    etps_shutdown();
+
+    return result;
+}
@@ -0,0 +1,219 @@
+/**
+ * @file tatit_tree_stream_spec.c
+ * @brief TATIT Streaming Tree Traversal Performance Specifications
+ *
+ * Walks a random 1M-node tree three ways: a recursive pre-order walk of
+ * the kind nlink_ast_traverse used, nlink_traverse_tree collecting every
+ * result, and nlink_traverse_tree_stream emitting results through a
+ * callback with a reused workspace. A second spec streams a 1M-deep
+ * chain, which a recursive walk cannot finish on a default stack, and
+ * checks that stopping early ends the walk at once.
+ */
+
+#include "../spec_runner.c"
+#include "nlink/core/tatit/traversal.h"
+#include <stdint.h>
+
+#define BENCH_NODES 1000000
+#define BENCH_MAX_CHILDREN 8
+#define BENCH_ROUNDS 3
+#define BENCH_STOP_AFTER 1000
+
+typedef struct bench_node {
+    uint32_t id;
+    uint32_t child_count;
+    struct bench_node** children;
+} bench_node;
+
+typedef struct bench_tree {
+    bench_node* nodes;
+    bench_node** edges;
+} bench_tree;
+
+// Node i's parent is a random earlier node; chain makes it always i - 1
+static bool bench_tree_create(bench_tree* tree, bool chain) {
+    tree->nodes = calloc(BENCH_NODES, sizeof(bench_node));
+    tree->edges = malloc(BENCH_NODES * sizeof(bench_node*));
+    uint32_t* parents = malloc(BENCH_NODES * sizeof(uint32_t));
+    if (tree->nodes == NULL || tree->edges == NULL || parents == NULL) {
+        free(parents);
+        return false;
+    }
+
+    uint64_t seed = 2463534242ull;
+    for (uint32_t i = 1; i < BENCH_NODES; i++) {
+        do {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            parents[i] = chain ? i - 1 : (uint32_t)(seed % i);
+        } while (!chain && tree->nodes[parents[i]].child_count == BENCH_MAX_CHILDREN);
+        tree->nodes[parents[i]].child_count++;
+    }
+
+    // Lay children out contiguously, CSR style
+    size_t offset = 0;
+    for (uint32_t i = 0; i < BENCH_NODES; i++) {
+        tree->nodes[i].id = i;
+        tree->nodes[i].children = tree->edges + offset;
+        offset += tree->nodes[i].child_count;
+        tree->nodes[i].child_count = 0;
+    }
+    for (uint32_t i = 1; i < BENCH_NODES; i++) {
+        bench_node* parent = &tree->nodes[parents[i]];
+        parent->children[parent->child_count++] = &tree->nodes[i];
+    }
+
+    free(parents);
+    return true;
+}
+
+static void bench_tree_free(bench_tree* tree) {
+    free(tree->nodes);
+    free(tree->edges);
+}
+
+static void* bench_get_child(void* node, size_t index, void* context) {
+    (void)context;
+    return ((bench_node*)node)->children[index];
+}
+
+static size_t bench_child_count(void* node, void* context) {
+    (void)context;
+    return ((bench_node*)node)->child_count;
+}
+
+static void* bench_visit(void* node, void* context) {
+    (void)context;
+    return (void*)(uintptr_t)((bench_node*)node)->id;
+}
+
+typedef struct bench_sum {
+    uint64_t sum;
+    size_t count;
+    size_t limit;
+} bench_sum;
+
+static bool bench_emit(void* node, void* result, void* context) {
+    bench_sum* sum = context;
+    (void)node;
+    sum->sum += (uintptr_t)result;
+    return ++sum->count < sum->limit;
+}
+
+static void bench_recursive(bench_node* node, bench_sum* sum) {
+    sum->sum += (uintptr_t)bench_visit(node, NULL);
+    sum->count++;
+    for (uint32_t i = 0; i < node->child_count; i++) {
+        bench_recursive(node->children[i], sum);
+    }
+}
+
+static nlink_traversal_config bench_config(void) {
+    nlink_traversal_config config = {
+        .order = NLINK_TRAVERSAL_PRE_ORDER,
+        .visitor = bench_visit,
+        .get_child = bench_get_child,
+        .get_child_count = bench_child_count,
+        .should_traverse = NULL,
+        .context = NULL,
+        .collect_results = true
+    };
+    return config;
+}
+
+spec_result_t spec_tatit_stream_wide_tree(void) {
+    bench_tree tree;
+    SPEC_ASSERT(bench_tree_create(&tree, false), "Tree allocation failed");
+
+    const uint64_t expected = (uint64_t)BENCH_NODES * (BENCH_NODES - 1) / 2;
+    nlink_traversal_config config = bench_config();
+    nlink_traversal_workspace workspace;
+    SPEC_ASSERT(nlink_traversal_workspace_init(&workspace, 0), "Workspace init failed");
+
+    double recursive_ms = 0, collect_ms = 0, stream_ms = 0;
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        bench_sum sum = { 0, 0, SIZE_MAX };
+        double start = spec_now_ms();
+        bench_recursive(tree.nodes, &sum);
+        recursive_ms += spec_now_ms() - start;
+        SPEC_EXPECT_EQ(sum.sum, expected);
+
+        start = spec_now_ms();
+        nlink_traversal_result* result = nlink_traverse_tree(tree.nodes, &config);
+        collect_ms += spec_now_ms() - start;
+        SPEC_ASSERT(result != NULL, "Collecting traversal failed");
+        SPEC_EXPECT_EQ(result->count, (size_t)BENCH_NODES);
+        nlink_traversal_result_free(result);
+
+        sum = (bench_sum){ 0, 0, SIZE_MAX };
+        start = spec_now_ms();
+        nlink_traversal_status status = nlink_traverse_tree_stream(
+            tree.nodes, &config, &workspace, bench_emit, &sum);
+        stream_ms += spec_now_ms() - start;
+        SPEC_ASSERT(status == NLINK_TRAVERSAL_COMPLETE, "Streaming traversal did not complete");
+        SPEC_EXPECT_EQ(sum.sum, expected);
+    }
+
+    printf("\n      %d nodes, up to %d children, mean of %d rounds\n",
+           BENCH_NODES, BENCH_MAX_CHILDREN, BENCH_ROUNDS);
+    printf("      recursive walk:     %.2f ms\n", recursive_ms / BENCH_ROUNDS);
+    printf("      collected results:  %.2f ms\n", collect_ms / BENCH_ROUNDS);
+    printf("      streamed, reused:   %.2f ms (workspace peak %zu frames)\n      ",
+           stream_ms / BENCH_ROUNDS, workspace.capacity);
+
+    nlink_traversal_workspace_free(&workspace);
+    bench_tree_free(&tree);
+    return SPEC_PASS;
+}
+
+spec_result_t spec_tatit_stream_deep_chain(void) {
+    bench_tree tree;
+    SPEC_ASSERT(bench_tree_create(&tree, true), "Tree allocation failed");
+
+    nlink_traversal_config config = bench_config();
+    nlink_traversal_workspace workspace;
+    SPEC_ASSERT(nlink_traversal_workspace_init(&workspace, 0), "Workspace init failed");
+
+    // Post-order keeps the whole chain on the workspace stack
+    config.order = NLINK_TRAVERSAL_POST_ORDER;
+    bench_sum sum = { 0, 0, SIZE_MAX };
+    double start = spec_now_ms();
+    nlink_traversal_status status = nlink_traverse_tree_stream(
+        tree.nodes, &config, &workspace, bench_emit, &sum);
+    double deep_ms = spec_now_ms() - start;
+    SPEC_ASSERT(status == NLINK_TRAVERSAL_COMPLETE, "Deep traversal did not complete");
+    SPEC_EXPECT_EQ(sum.count, (size_t)BENCH_NODES);
+
+    // Early termination stops within the first BENCH_STOP_AFTER nodes
+    config.order = NLINK_TRAVERSAL_PRE_ORDER;
+    sum = (bench_sum){ 0, 0, BENCH_STOP_AFTER };
+    start = spec_now_ms();
+    status = nlink_traverse_tree_stream(tree.nodes, &config, &workspace, bench_emit, &sum);
+    double stop_ms = spec_now_ms() - start;
+    SPEC_ASSERT(status == NLINK_TRAVERSAL_STOPPED, "Traversal was not stopped");
+    SPEC_EXPECT_EQ(sum.count, (size_t)BENCH_STOP_AFTER);
+
+    printf("\n      %d-deep chain, post-order: %.2f ms\n", BENCH_NODES, deep_ms);
+    printf("      stopped after %d nodes: %.3f ms\n      ", BENCH_STOP_AFTER, stop_ms);
+
+    nlink_traversal_workspace_free(&workspace);
+    bench_tree_free(&tree);
+    return SPEC_PASS;
+}
+
+int main() {
+    etps_init();
+
+    spec_suite_t* suite = spec_suite_create("TATIT_Tree_Stream_Performance_Specs");
+
+    spec_add_test(suite, "1M-node tree: recursive, collected and streamed", spec_tatit_stream_wide_tree);
+    spec_add_test(suite, "1M-deep chain and early termination", spec_tatit_stream_deep_chain);
+
+    int result = spec_suite_run(suite);
+
+    spec_suite_destroy(suite);
+    etps_shutdown();
+
+    return result;
+}
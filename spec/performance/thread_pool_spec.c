@@ -0,0 +1,164 @@
+/**
+ * @file thread_pool_spec.c
+ * @brief Thread Pool Task Throughput Performance Specifications
+ *
+ * Measures how many fine-grained tasks per second the pool sustains in
+ * two shapes: recursive fork-join, where tasks spawn and wait for their
+ * own children (the deque and stealing path), and a flat batch submitted
+ * from outside the pool (the shared queue path). Fork-join runs with and
+ * without work stealing; without it every child stays on the worker that
+ * made it.
+ */
+
+#include "../spec_runner.c"
+#include "nlink/core/threading/thread_pool.h"
+#include <stdint.h>
+
+#define BENCH_LEAVES (1u << 16)
+#define BENCH_FLAT_TASKS 200000
+#define BENCH_LEAF_WORK 64
+
+static uint64_t bench_leaf(uint64_t index) {
+    uint64_t h = index;
+    for (int r = 0; r < BENCH_LEAF_WORK; r++) {
+        h = h * 6364136223846793005ull + 1442695040888963407ull;
+    }
+    return h >> 32;
+}
+
+typedef struct bench_range {
+    nlink_thread_pool_t* pool;
+    uint64_t begin;
+    uint64_t end;
+    uint64_t sum;
+} bench_range;
+
+// Splits its range in two subtasks until one leaf is left
+static void bench_fork_join(void* arg) {
+    bench_range* range = (bench_range*)arg;
+    if (range->end - range->begin == 1) {
+        range->sum = bench_leaf(range->begin);
+        return;
+    }
+
+    uint64_t mid = range->begin + (range->end - range->begin) / 2;
+    bench_range left = { range->pool, range->begin, mid, 0 };
+    bench_range right = { range->pool, mid, range->end, 0 };
+
+    nlink_task_group_t group;
+    nlink_task_group_init(&group);
+    nlink_thread_pool_submit(range->pool, bench_fork_join, &left, &group);
+    nlink_thread_pool_submit(range->pool, bench_fork_join, &right, &group);
+    nlink_thread_pool_wait(range->pool, &group);
+
+    range->sum = left.sum + right.sum;
+}
+
+static void bench_flat_task(void* arg) {
+    _Atomic uint64_t* sum = (_Atomic uint64_t*)arg;
+    atomic_fetch_add_explicit(sum, 1, memory_order_relaxed);
+}
+
+static uint64_t bench_expected_sum(void) {
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < BENCH_LEAVES; i++) {
+        sum += bench_leaf(i);
+    }
+    return sum;
+}
+
+// Runs one fork-join tree; returns tasks per second
+static double bench_fork_join_rate(nlink_thread_pool_t* pool, uint64_t expected, bool* ok) {
+    bench_range root = { pool, 0, BENCH_LEAVES, 0 };
+    nlink_task_group_t group;
+    nlink_task_group_init(&group);
+
+    double start = spec_now_ms();
+    nlink_thread_pool_submit(pool, bench_fork_join, &root, &group);
+    nlink_thread_pool_wait(pool, &group);
+    double elapsed = spec_now_ms() - start;
+
+    if (root.sum != expected) {
+        *ok = false;
+    }
+    // A binary tree with BENCH_LEAVES leaves has 2 * BENCH_LEAVES - 1 nodes
+    return (2.0 * BENCH_LEAVES - 1) / (elapsed / 1000.0);
+}
+
+spec_result_t spec_thread_pool_fork_join(void) {
+    uint64_t expected = bench_expected_sum();
+    bool ok = true;
+
+    nlink_thread_pool_config_t config = nlink_thread_pool_default_config();
+    nlink_thread_pool_t* stealing = nlink_thread_pool_create(&config);
+    SPEC_ASSERT(stealing != NULL, "Pool creation failed");
+    bench_fork_join_rate(stealing, expected, &ok);
+    double stealing_rate = bench_fork_join_rate(stealing, expected, &ok);
+
+    nlink_thread_pool_stats_t stats;
+    SPEC_ASSERT(nlink_thread_pool_get_stats(stealing, &stats), "Stats unavailable");
+    SPEC_EXPECT_EQ(stats.tasks_executed, stats.tasks_submitted);
+    nlink_thread_pool_destroy(stealing);
+
+    config.enable_work_stealing = false;
+    nlink_thread_pool_t* local = nlink_thread_pool_create(&config);
+    SPEC_ASSERT(local != NULL, "Pool creation failed");
+    bench_fork_join_rate(local, expected, &ok);
+    double local_rate = bench_fork_join_rate(local, expected, &ok);
+    nlink_thread_pool_destroy(local);
+
+    SPEC_ASSERT(ok, "Fork-join sum differs from the serial sum");
+
+    printf("\n      %u workers, %u leaves\n", stats.worker_count, BENCH_LEAVES);
+    printf("      stealing: %.2f M tasks/s (%llu steals, %llu parks)\n",
+           stealing_rate / 1e6, (unsigned long long)stats.steals, (unsigned long long)stats.parks);
+    printf("      no stealing: %.2f M tasks/s\n      ", local_rate / 1e6);
+
+    return SPEC_PASS;
+}
+
+spec_result_t spec_thread_pool_flat_batch(void) {
+    nlink_thread_pool_config_t config = nlink_thread_pool_default_config();
+    nlink_thread_pool_t* pool = nlink_thread_pool_create(&config);
+    SPEC_ASSERT(pool != NULL, "Pool creation failed");
+
+    _Atomic uint64_t sum = 0;
+    nlink_task_group_t group;
+    nlink_task_group_init(&group);
+
+    double start = spec_now_ms();
+    for (int i = 0; i < BENCH_FLAT_TASKS; i++) {
+        nlink_thread_pool_submit(pool, bench_flat_task, &sum, &group);
+    }
+    nlink_thread_pool_wait(pool, &group);
+    double elapsed = spec_now_ms() - start;
+
+    SPEC_EXPECT_EQ(atomic_load(&sum), (uint64_t)BENCH_FLAT_TASKS);
+
+    nlink_thread_pool_stats_t stats;
+    SPEC_ASSERT(nlink_thread_pool_get_stats(pool, &stats), "Stats unavailable");
+    SPEC_EXPECT_EQ(stats.tasks_submitted + stats.tasks_inline, (uint64_t)BENCH_FLAT_TASKS);
+
+    printf("\n      %d external tasks: %.2f M tasks/s (%llu run by the submitter)\n      ",
+           BENCH_FLAT_TASKS, BENCH_FLAT_TASKS / (elapsed / 1000.0) / 1e6,
+           (unsigned long long)stats.tasks_inline);
+
+    nlink_thread_pool_destroy(pool);
+    return SPEC_PASS;
+}
+
+int main() {
+    etps_init();
+
+    spec_suite_t* suite = spec_suite_create("Thread_Pool_Performance_Specs");
+
+    spec_add_test(suite, "Fork-join task throughput with and without stealing", spec_thread_pool_fork_join);
+    spec_add_test(suite, "Flat batch submitted from outside the pool", spec_thread_pool_flat_batch);
+
+    int result = spec_suite_run(suite);
+
+    spec_suite_destroy(suite);
+    etps_shutdown();
+
+    return result;
+}
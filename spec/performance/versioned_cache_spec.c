@@ -0,0 +1,182 @@
+/**
+ * @file versioned_cache_spec.c
+ * @brief Versioned Symbol Resolution Cache Performance Specifications
+ *
+ * Resolves one (name, constraint, component) tuple 1M times against a
+ * registry of 10k versioned symbols, so all but the first call are
+ * answered from the cache. A second spec checks that each kind of
+ * registry change bumps the generation and that the next resolution
+ * sees it: a new exported symbol, a new global symbol, a new dependency
+ * and the first registration of a name that was cached as missing. A
+ * third spec adds symbols and dependencies from one thread while another
+ * resolves, which only holds up because both take the registry lock.
+ */
+
+#include "../spec_runner.c"
+#include "nlink/core/symbols/nexus_versioned_symbols.h"
+#include <pthread.h>
+#include <stdint.h>
+
+#define BENCH_SYMBOLS 10000
+#define BENCH_RESOLVE_COUNT 1000000
+
+spec_result_t spec_versioned_cache_hot_tuple(void) {
+    VersionedSymbolRegistry* registry = nexus_versioned_registry_create();
+    SPEC_ASSERT(registry != NULL, "Registry creation failed");
+
+    char name[64];
+    for (size_t i = 0; i < BENCH_SYMBOLS; i++) {
+        snprintf(name, sizeof(name), "bench_symbol_%zu", i);
+        versioned_symbol_table_add(&registry->exported, name, "1.2.0", (void*)(uintptr_t)(0x1000 + i),
+                                   VSYMBOL_FUNCTION, "bench_lib", 0);
+    }
+
+    void* target = (void*)(uintptr_t)(0x1000 + BENCH_SYMBOLS - 1);
+    size_t mismatches = 0;
+    double start = spec_now_ms();
+    for (size_t i = 0; i < BENCH_RESOLVE_COUNT; i++) {
+        if (nexus_resolve_versioned_symbol(registry, "bench_symbol_9999", "^1.0.0", "bench_app") != target) {
+            mismatches++;
+        }
+    }
+    double elapsed = spec_now_ms() - start;
+
+    uint64_t hits, misses;
+    nexus_versioned_cache_get_stats(registry, &hits, &misses);
+    SPEC_EXPECT_EQ(mismatches, (size_t)0);
+    SPEC_EXPECT_EQ(misses, (uint64_t)1);
+    SPEC_EXPECT_EQ(hits, (uint64_t)(BENCH_RESOLVE_COUNT - 1));
+
+    printf("\n      %d resolutions against %d symbols: %.2f ms (%.1f ns each)\n      ",
+           BENCH_RESOLVE_COUNT, BENCH_SYMBOLS, elapsed, elapsed * 1e6 / BENCH_RESOLVE_COUNT);
+
+    nexus_versioned_registry_free(registry);
+    return SPEC_PASS;
+}
+
+spec_result_t spec_versioned_cache_invalidation(void) {
+    VersionedSymbolRegistry* registry = nexus_versioned_registry_create();
+    SPEC_ASSERT(registry != NULL, "Registry creation failed");
+
+    void* v1 = (void*)(uintptr_t)0x100;
+    void* v1_5 = (void*)(uintptr_t)0x150;
+    void* pinned = (void*)(uintptr_t)0x120;
+    void* fallback = (void*)(uintptr_t)0x900;
+    uint64_t hits, misses;
+
+    versioned_symbol_table_add(&registry->exported, "render", "1.0.0", v1, VSYMBOL_FUNCTION, "lib_a", 0);
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "render", "^1.0.0", "app") == v1, "Initial resolution");
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "render", "^1.0.0", "app") == v1, "Cached resolution");
+    nexus_versioned_cache_get_stats(registry, &hits, &misses);
+    SPEC_EXPECT_EQ(hits, (uint64_t)1);
+    SPEC_EXPECT_EQ(misses, (uint64_t)1);
+
+    // A better exported match replaces the cached one
+    uint64_t generation = nexus_versioned_registry_generation(registry);
+    versioned_symbol_table_add(&registry->exported, "render", "1.5.0", v1_5, VSYMBOL_FUNCTION, "lib_b", 10);
+    SPEC_ASSERT(nexus_versioned_registry_generation(registry) != generation, "Exported add kept the generation");
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "render", "^1.0.0", "app") == v1_5,
+                "Stale resolution after an exported add");
+    nexus_versioned_cache_get_stats(registry, &hits, &misses);
+    SPEC_EXPECT_EQ(misses, (uint64_t)2);
+
+    // A direct dependency outranks symbol priority
+    generation = nexus_versioned_registry_generation(registry);
+    versioned_symbol_table_add(&registry->exported, "render", "1.2.0", pinned, VSYMBOL_FUNCTION, "lib_c", 0);
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "render", "^1.0.0", "app") == v1_5, "Priority order");
+    nexus_add_component_dependency(registry, "app", "lib_c", "^1.0.0", false);
+    SPEC_ASSERT(nexus_versioned_registry_generation(registry) != generation, "Dependency kept the generation");
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "render", "^1.0.0", "app") == pinned,
+                "Stale resolution after a dependency was added");
+
+    // Other requesting components keep their own entries
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "render", "^1.0.0", "tool") == v1_5,
+                "Dependency leaked into another component");
+
+    // A cached failure is retried once the name appears in the global table
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "log", NULL, "app") == NULL, "Missing symbol resolved");
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "log", NULL, "app") == NULL, "Cached miss resolved");
+    generation = nexus_versioned_registry_generation(registry);
+    versioned_symbol_table_add(&registry->global, "log", "2.0.0", fallback, VSYMBOL_FUNCTION, "core", 0);
+    SPEC_ASSERT(nexus_versioned_registry_generation(registry) != generation, "Global add kept the generation");
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "log", NULL, "app") == fallback,
+                "Cached failure survived a global add");
+
+    // The imported table is outside resolution and leaves the cache alone
+    generation = nexus_versioned_registry_generation(registry);
+    versioned_symbol_table_add(&registry->imported, "render", "9.0.0", NULL, VSYMBOL_FUNCTION, "app", 0);
+    SPEC_EXPECT_EQ(nexus_versioned_registry_generation(registry), generation);
+
+    // Clearing drops every entry and the counters
+    nexus_versioned_cache_clear(registry);
+    nexus_versioned_cache_get_stats(registry, &hits, &misses);
+    SPEC_EXPECT_EQ(hits + misses, (uint64_t)0);
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "render", "^1.0.0", "app") == pinned,
+                "Resolution after clear");
+    nexus_versioned_cache_get_stats(registry, &hits, &misses);
+    SPEC_EXPECT_EQ(misses, (uint64_t)1);
+
+    nexus_versioned_registry_free(registry);
+    return SPEC_PASS;
+}
+
+#define CONCURRENT_ADDS 2000
+
+static void* concurrent_adder(void* arg) {
+    VersionedSymbolRegistry* registry = arg;
+    char name[64], component[64];
+
+    for (int i = 0; i < CONCURRENT_ADDS; i++) {
+        snprintf(name, sizeof(name), "grow_%d", i);
+        snprintf(component, sizeof(component), "lib_%d", i);
+        versioned_symbol_table_add(&registry->exported, name, "1.0.0", (void*)(uintptr_t)(i + 1),
+                                   VSYMBOL_FUNCTION, component, 0);
+        versioned_symbol_table_add(&registry->global, name, "1.0.0", (void*)(uintptr_t)(i + 1),
+                                   VSYMBOL_FUNCTION, component, 0);
+        nexus_add_component_dependency(registry, "app", component, "^1.0.0", (i & 1) != 0);
+    }
+    return NULL;
+}
+
+spec_result_t spec_versioned_cache_concurrent_add(void) {
+    VersionedSymbolRegistry* registry = nexus_versioned_registry_create();
+    SPEC_ASSERT(registry != NULL, "Registry creation failed");
+
+    pthread_t adder;
+    SPEC_ASSERT(pthread_create(&adder, NULL, concurrent_adder, registry) == 0, "Thread creation failed");
+
+    // Resolve while the tables and the dependency list grow underneath
+    char name[64];
+    for (int i = 0; i < CONCURRENT_ADDS; i++) {
+        snprintf(name, sizeof(name), "grow_%d", i % 64);
+        void* address = nexus_resolve_versioned_symbol(registry, name, "^1.0.0", "app");
+        SPEC_ASSERT(address == NULL || address == (void*)(uintptr_t)(i % 64 + 1), "Wrong address");
+    }
+    pthread_join(adder, NULL);
+
+    SPEC_EXPECT_EQ(registry->exported.size, (size_t)CONCURRENT_ADDS);
+    SPEC_EXPECT_EQ(registry->global.size, (size_t)CONCURRENT_ADDS);
+    SPEC_EXPECT_EQ(registry->deps_count, (size_t)CONCURRENT_ADDS);
+    SPEC_ASSERT(nexus_resolve_versioned_symbol(registry, "grow_1999", "^1.0.0", "app") ==
+                (void*)(uintptr_t)CONCURRENT_ADDS, "Last symbol unresolved");
+
+    nexus_versioned_registry_free(registry);
+    return SPEC_PASS;
+}
+
+int main() {
+    etps_init();
+
+    spec_suite_t* suite = spec_suite_create("Versioned_Cache_Performance_Specs");
+
+    spec_add_test(suite, "1M resolutions of one tuple through the cache", spec_versioned_cache_hot_tuple);
+    spec_add_test(suite, "Registry changes invalidate cached resolutions", spec_versioned_cache_invalidation);
+    spec_add_test(suite, "Additions race resolution under the registry lock", spec_versioned_cache_concurrent_add);
+
+    int result = spec_suite_run(suite);
+
+    spec_suite_destroy(suite);
+    etps_shutdown();
+
+    return result;
+}
@@ -52,6 +52,13 @@ typedef struct {
 // Global current test pointer for assertions
 static spec_test_t* spec_current_test = NULL;
 
+// Monotonic wall-clock time in milliseconds, for timing inside a spec
+double spec_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
 // Create spec suite
 spec_suite_t* spec_suite_create(const char* name) {
     spec_suite_t* suite = calloc(1, sizeof(spec_suite_t));
@@ -5,6 +5,7 @@
 
 #include "spec_runner.c"
 #include "nlink/core/etps/telemetry.h"
+#include "nlink/core/etps/semverx_etps.h"
 
 // Test: ETPS initialization
 spec_result_t spec_etps_init(void) {
@@ -59,6 +60,88 @@ spec_result_t spec_shannon_entropy_validation(void) {
     return SPEC_PASS;
 }
 
+// Record one event with a known id
+static void emit_test_event(etps_context_t* ctx, const char* event_id) {
+    etps_semverx_event_t event;
+    memset(&event, 0, sizeof(event));
+    snprintf(event.event_id, sizeof(event.event_id), "%s", event_id);
+    event.compatibility_result = COMPAT_ALLOWED;
+    etps_emit_semverx_event(ctx, &event);
+}
+
+// Read a whole exported document; the caller frees it
+static char* read_json_file(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) return NULL;
+    
+    char* text = calloc(1, 65536);
+    if (text) {
+        fread(text, 1, 65535, file);
+    }
+    fclose(file);
+    return text;
+}
+
+// The document lists etps_version, event_count, then events, and the
+// count matches the events written
+static spec_result_t check_events_json(const char* text, size_t expected) {
+    SPEC_ASSERT(text != NULL, "Exported file missing");
+    
+    const char* version = strstr(text, "\"etps_version\"");
+    const char* count = strstr(text, "\"event_count\": ");
+    const char* events = strstr(text, "\"events\": [");
+    SPEC_ASSERT(version && count && events, "Exported fields missing");
+    SPEC_ASSERT(version < count && count < events, "Exported fields out of order");
+    SPEC_EXPECT_EQ(strtoul(count + strlen("\"event_count\": "), NULL, 10), expected);
+    
+    size_t ids = 0;
+    for (const char* id = strstr(text, "\"event_id\""); id; id = strstr(id + 1, "\"event_id\"")) {
+        ids++;
+    }
+    SPEC_EXPECT_EQ(ids, expected);
+    
+    size_t length = strlen(text);
+    SPEC_ASSERT(length >= 4 && strcmp(text + length - 4, "]\n}\n") == 0,
+                "Exported document not closed");
+    return SPEC_PASS;
+}
+
+// Test: JSON export keeps its field layout, synchronous and appended
+spec_result_t spec_etps_export_json_layout(void) {
+    const char* export_path = "etps_spec_export.json";
+    const char* flush_path = "etps_spec_flush.json";
+    
+    etps_context_t* ctx = etps_context_create("export_test");
+    SPEC_ASSERT(ctx != NULL, "Context creation failed");
+    
+    emit_test_event(ctx, "export-1");
+    emit_test_event(ctx, "export-2");
+    SPEC_EXPECT_EQ(etps_export_events_json(ctx, export_path), 0);
+    
+    char* text = read_json_file(export_path);
+    spec_result_t result = check_events_json(text, 2);
+    free(text);
+    remove(export_path);
+    if (result != SPEC_PASS) {
+        etps_context_destroy(ctx);
+        return result;
+    }
+    
+    // The second flush appends to the first and updates event_count
+    SPEC_EXPECT_EQ(etps_flush_events_async(ctx, flush_path), 0);
+    emit_test_event(ctx, "flush-3");
+    SPEC_EXPECT_EQ(etps_flush_events_async(ctx, flush_path), 0);
+    etps_flush_wait();
+    
+    text = read_json_file(flush_path);
+    result = check_events_json(text, 3);
+    free(text);
+    remove(flush_path);
+    
+    etps_context_destroy(ctx);
+    return result;
+}
+
 // Main spec runner
 int main() {
     // Initialize ETPS
@@ -73,6 +156,7 @@ int main() {
     spec_add_test(suite, "ETPS GUID generation", spec_etps_guid_generation);
     spec_add_test(suite, "ETPS logging functionality", spec_etps_logging);
     spec_add_test(suite, "Shannon entropy validation", spec_shannon_entropy_validation);
+    spec_add_test(suite, "ETPS JSON export layout", spec_etps_export_json_layout);
     
     // Run tests
     int result = spec_suite_run(suite);
@@ -0,0 +1,395 @@
+/**
+ * @file nlink_pipeline_spec.c
+ * @brief Size-Aware Pipeline Buffer Unit Specifications
+ */
+
+#include "../spec_runner.c"
+#include "nlink/core/pipeline/nlink_pipeline.h"
+#include <stdint.h>
+
+#define PIPELINE_SPEC_BYTES 5000
+
+// Doubles the payload: every byte is written twice
+static size_t spec_double_size(size_t input_size, void* user_data) {
+    (void)user_data;
+    return input_size * 2;
+}
+
+static NexusResult spec_double_stage(const void* input, size_t input_size,
+                                     void* output, size_t output_capacity,
+                                     size_t* output_size, void* user_data) {
+    (void)user_data;
+    *output_size = input_size * 2;
+    if (*output_size > output_capacity) {
+        return NEXUS_PARTIAL_SUCCESS;
+    }
+
+    const unsigned char* in = (const unsigned char*)input;
+    unsigned char* out = (unsigned char*)output;
+    for (size_t i = 0; i < input_size; i++) {
+        out[2 * i] = in[i];
+        out[2 * i + 1] = in[i];
+    }
+    return NEXUS_SUCCESS;
+}
+
+// Keeps every other byte, undoing spec_double_stage
+static NexusResult spec_halve_stage(const void* input, size_t input_size,
+                                    void* output, size_t output_capacity,
+                                    size_t* output_size, void* user_data) {
+    (void)user_data;
+    *output_size = input_size / 2;
+    if (*output_size > output_capacity) {
+        return NEXUS_PARTIAL_SUCCESS;
+    }
+
+    const unsigned char* in = (const unsigned char*)input;
+    unsigned char* out = (unsigned char*)output;
+    for (size_t i = 0; i < *output_size; i++) {
+        out[i] = in[2 * i];
+    }
+    return NEXUS_SUCCESS;
+}
+
+// Counts data[0] up to 3, one step per run
+static NexusResult spec_step_stage(void* data, size_t size, NlinkStageChanges* changes, void* user_data) {
+    (void)size;
+    (void)user_data;
+    unsigned char* bytes = (unsigned char*)data;
+    if (bytes[0] < 3) {
+        bytes[0]++;
+        nlink_stage_changes_mark(changes, 0, 1);
+    }
+    return NEXUS_SUCCESS;
+}
+
+// Copies data[0] into data[1]
+static NexusResult spec_follow_stage(void* data, size_t size, NlinkStageChanges* changes, void* user_data) {
+    (void)size;
+    (void)user_data;
+    unsigned char* bytes = (unsigned char*)data;
+    if (bytes[1] != bytes[0]) {
+        bytes[1] = bytes[0];
+        nlink_stage_changes_mark(changes, 1, 1);
+    }
+    return NEXUS_SUCCESS;
+}
+
+static NexusResult spec_idle_stage(void* data, size_t size, NlinkStageChanges* changes, void* user_data) {
+    (void)data;
+    (void)size;
+    (void)changes;
+    (void)user_data;
+    return NEXUS_SUCCESS;
+}
+
+// Rewrites data[2] every run, but reports a hash so unchanged content is recognized
+static NexusResult spec_rehash_stage(void* data, size_t size, NlinkStageChanges* changes, void* user_data) {
+    (void)user_data;
+    unsigned char* bytes = (unsigned char*)data;
+    bytes[2] = (unsigned char)(bytes[0] * 2);
+    nlink_stage_changes_mark(changes, 2, 1);
+
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    nlink_stage_changes_set_hash(changes, hash);
+    return NEXUS_SUCCESS;
+}
+
+// Legacy stage: sums all config.stage_buffer_size bytes of its input
+static NexusResult spec_legacy_sum_stage(void* input, void* output, void* user_data) {
+    size_t buffer_size = *(const size_t*)user_data;
+    const unsigned char* in = (const unsigned char*)input;
+    uint64_t sum = 0;
+    for (size_t i = 0; i < buffer_size; i++) {
+        sum += in[i];
+    }
+    memset(output, 0, buffer_size);
+    memcpy(output, &sum, sizeof(sum));
+    return NEXUS_SUCCESS;
+}
+
+static void pipeline_spec_fill(unsigned char* bytes, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        bytes[i] = (unsigned char)(i * 13 + 5);
+    }
+}
+
+spec_result_t spec_single_pass_keeps_large_outputs(void) {
+    static unsigned char input[PIPELINE_SPEC_BYTES];
+    static unsigned char output[PIPELINE_SPEC_BYTES * 2];
+    NexusConfig context_config = {0};
+    context_config.log_level = NEXUS_LOG_ERROR;
+    NexusContext* ctx = nexus_create_context(&context_config);
+    SPEC_ASSERT(ctx != NULL, "Context creation failed");
+    pipeline_spec_fill(input, sizeof(input));
+
+    NlinkPipelineConfig config = nlink_pipeline_default_config();
+    config.mode = NLINK_PIPELINE_MODE_SINGLE_PASS;
+    NlinkPipeline* pipeline = nlink_pipeline_create(ctx, &config);
+    SPEC_ASSERT(pipeline != NULL, "Pipeline creation failed");
+
+    // The second stage declares no size, so it has to ask for a bigger buffer
+    SPEC_EXPECT_EQ(nlink_pipeline_add_sized_stage(pipeline, "double", spec_double_stage,
+                                                  spec_double_size, NULL), NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(nlink_pipeline_add_sized_stage(pipeline, "double_again", spec_double_stage,
+                                                  NULL, NULL), NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(nlink_pipeline_add_sized_stage(pipeline, "halve", spec_halve_stage,
+                                                  NULL, NULL), NEXUS_SUCCESS);
+
+    size_t output_size = 0;
+    SPEC_EXPECT_EQ(nlink_pipeline_execute_sized(pipeline, input, sizeof(input),
+                                                output, sizeof(output), &output_size),
+                   NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(output_size, (size_t)PIPELINE_SPEC_BYTES * 2);
+    for (size_t i = 0; i < sizeof(input); i++) {
+        SPEC_ASSERT(output[2 * i] == input[i] && output[2 * i + 1] == input[i],
+                    "Output was truncated or corrupted");
+    }
+
+    // Once the arena has seen the workload, further runs do not allocate
+    size_t blocks = pipeline->arena.block_allocations;
+    for (int run = 0; run < 4; run++) {
+        SPEC_EXPECT_EQ(nlink_pipeline_execute_sized(pipeline, input, sizeof(input),
+                                                    output, sizeof(output), &output_size),
+                       NEXUS_SUCCESS);
+    }
+    SPEC_ASSERT(pipeline->arena.block_allocations <= blocks + 1,
+                "Arena kept allocating after the first execution");
+    blocks = pipeline->arena.block_allocations;
+    SPEC_EXPECT_EQ(nlink_pipeline_execute_sized(pipeline, input, sizeof(input),
+                                                output, sizeof(output), &output_size),
+                   NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(pipeline->arena.block_allocations, blocks);
+
+    // A short output buffer reports the size it needs
+    SPEC_EXPECT_EQ(nlink_pipeline_execute_sized(pipeline, input, sizeof(input),
+                                                output, 100, &output_size),
+                   NEXUS_PARTIAL_SUCCESS);
+    SPEC_EXPECT_EQ(output_size, (size_t)PIPELINE_SPEC_BYTES * 2);
+
+    nlink_pipeline_destroy(pipeline);
+    nexus_destroy_context(ctx);
+    return SPEC_PASS;
+}
+
+spec_result_t spec_single_pass_pads_short_legacy_input(void) {
+    NexusConfig context_config = {0};
+    context_config.log_level = NEXUS_LOG_ERROR;
+    NexusContext* ctx = nexus_create_context(&context_config);
+    SPEC_ASSERT(ctx != NULL, "Context creation failed");
+
+    NlinkPipelineConfig config = nlink_pipeline_default_config();
+    config.mode = NLINK_PIPELINE_MODE_SINGLE_PASS;
+    NlinkPipeline* pipeline = nlink_pipeline_create(ctx, &config);
+    SPEC_ASSERT(pipeline != NULL, "Pipeline creation failed");
+    SPEC_EXPECT_EQ(nlink_pipeline_add_stage(pipeline, "sum", spec_legacy_sum_stage,
+                                            &config.stage_buffer_size), NEXUS_SUCCESS);
+
+    // Heap-allocated to its exact size, so reading past it is caught
+    size_t input_size = 16;
+    unsigned char* input = (unsigned char*)malloc(input_size);
+    unsigned char* output = (unsigned char*)malloc(config.stage_buffer_size);
+    SPEC_ASSERT(input && output, "Buffer allocation failed");
+    pipeline_spec_fill(input, input_size);
+    uint64_t expected = 0;
+    for (size_t i = 0; i < input_size; i++) {
+        expected += input[i];
+    }
+
+    // The legacy stage reads stage_buffer_size bytes; everything past the payload is zero
+    size_t output_size = 0;
+    SPEC_EXPECT_EQ(nlink_pipeline_execute_sized(pipeline, input, input_size,
+                                                output, config.stage_buffer_size, &output_size),
+                   NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(output_size, config.stage_buffer_size);
+    uint64_t sum = 0;
+    memcpy(&sum, output, sizeof(sum));
+    SPEC_EXPECT_EQ(sum, expected);
+
+    free(input);
+    free(output);
+    nlink_pipeline_destroy(pipeline);
+    nexus_destroy_context(ctx);
+    return SPEC_PASS;
+}
+
+spec_result_t spec_multi_pass_sizes_state_from_payload(void) {
+    static unsigned char input[PIPELINE_SPEC_BYTES];
+    static unsigned char output[PIPELINE_SPEC_BYTES];
+    NexusConfig context_config = {0};
+    context_config.log_level = NEXUS_LOG_ERROR;
+    NexusContext* ctx = nexus_create_context(&context_config);
+    SPEC_ASSERT(ctx != NULL, "Context creation failed");
+    pipeline_spec_fill(input, sizeof(input));
+
+    NlinkPipelineConfig config = nlink_pipeline_default_config();
+    config.mode = NLINK_PIPELINE_MODE_MULTI_PASS;
+    NlinkPipeline* pipeline = nlink_pipeline_create(ctx, &config);
+    SPEC_ASSERT(pipeline != NULL, "Pipeline creation failed");
+
+    // Doubling then halving is the identity, so the pipeline converges
+    SPEC_EXPECT_EQ(nlink_pipeline_add_sized_stage(pipeline, "double", spec_double_stage,
+                                                  spec_double_size, NULL), NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(nlink_pipeline_add_sized_stage(pipeline, "halve", spec_halve_stage,
+                                                  NULL, NULL), NEXUS_SUCCESS);
+
+    size_t output_size = 0;
+    SPEC_EXPECT_EQ(nlink_pipeline_execute_sized(pipeline, input, sizeof(input),
+                                                output, sizeof(output), &output_size),
+                   NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(output_size, (size_t)PIPELINE_SPEC_BYTES);
+    SPEC_ASSERT(memcmp(output, input, sizeof(input)) == 0, "Multi-pass output differs");
+
+    unsigned iterations = 0;
+    SPEC_EXPECT_EQ(nlink_pipeline_get_stats(pipeline, &iterations, NULL, NULL, 0), NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(iterations, 2u);
+    SPEC_ASSERT(pipeline->pass_capacity[0] >= PIPELINE_SPEC_BYTES,
+                "Ping-pong buffers were not sized from the payload");
+
+    // The ping-pong buffers are reused by the next execution
+    void* first = pipeline->pass_buffers[0];
+    SPEC_EXPECT_EQ(nlink_pipeline_execute_sized(pipeline, input, sizeof(input),
+                                                output, sizeof(output), &output_size),
+                   NEXUS_SUCCESS);
+    SPEC_ASSERT(pipeline->pass_buffers[0] == first, "Ping-pong buffers were reallocated");
+
+    nlink_pipeline_destroy(pipeline);
+    nexus_destroy_context(ctx);
+    return SPEC_PASS;
+}
+
+spec_result_t spec_tracked_stages_converge_on_reported_changes(void) {
+    unsigned char state[PIPELINE_SPEC_BYTES] = {0};
+    unsigned char output[PIPELINE_SPEC_BYTES];
+    NexusConfig context_config = {0};
+    context_config.log_level = NEXUS_LOG_ERROR;
+    NexusContext* ctx = nexus_create_context(&context_config);
+    SPEC_ASSERT(ctx != NULL, "Context creation failed");
+
+    NlinkPipelineConfig config = nlink_pipeline_default_config();
+    config.mode = NLINK_PIPELINE_MODE_MULTI_PASS;
+    config.enable_worklist = true;
+    NlinkPipeline* pipeline = nlink_pipeline_create(ctx, &config);
+    SPEC_ASSERT(pipeline != NULL, "Pipeline creation failed");
+
+    SPEC_EXPECT_EQ(nlink_pipeline_add_tracked_stage(pipeline, "step", spec_step_stage, NULL), NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(nlink_pipeline_add_tracked_stage(pipeline, "follow", spec_follow_stage, NULL), NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(nlink_pipeline_add_tracked_stage(pipeline, "idle", spec_idle_stage, NULL), NEXUS_SUCCESS);
+
+    size_t output_size = 0;
+    SPEC_EXPECT_EQ(nlink_pipeline_execute_sized(pipeline, state, sizeof(state),
+                                                output, sizeof(output), &output_size),
+                   NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(output_size, sizeof(state));
+    SPEC_ASSERT(output[0] == 3 && output[1] == 3, "Tracked stages produced the wrong state");
+    SPEC_EXPECT_EQ(pipeline->last_dirty_bytes, (size_t)6);
+
+    // Three changing iterations, then one in which nothing changes
+    unsigned iterations = 0;
+    NlinkPipelineStageStats stats[3];
+    SPEC_EXPECT_EQ(nlink_pipeline_get_stats(pipeline, &iterations, NULL, stats, 3), NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(iterations, 4u);
+    SPEC_EXPECT_EQ(stats[0].runs, 4u);
+    SPEC_EXPECT_EQ(stats[0].skipped, 0u);
+
+    // follow changed the state last, so it checks its own output once more;
+    // idle already saw the final state when the last iteration starts
+    SPEC_EXPECT_EQ(stats[1].runs, 4u);
+    SPEC_EXPECT_EQ(stats[1].skipped, 0u);
+    SPEC_EXPECT_EQ(stats[2].runs, 3u);
+    SPEC_EXPECT_EQ(stats[2].skipped, 1u);
+
+    nlink_pipeline_destroy(pipeline);
+    nexus_destroy_context(ctx);
+    return SPEC_PASS;
+}
+
+spec_result_t spec_worklist_reruns_self_changing_stage(void) {
+    unsigned char state[PIPELINE_SPEC_BYTES] = {0};
+    unsigned char output[PIPELINE_SPEC_BYTES];
+    NexusConfig context_config = {0};
+    context_config.log_level = NEXUS_LOG_ERROR;
+    NexusContext* ctx = nexus_create_context(&context_config);
+    SPEC_ASSERT(ctx != NULL, "Context creation failed");
+
+    NlinkPipelineConfig config = nlink_pipeline_default_config();
+    config.mode = NLINK_PIPELINE_MODE_MULTI_PASS;
+    config.enable_worklist = true;
+    NlinkPipeline* pipeline = nlink_pipeline_create(ctx, &config);
+    SPEC_ASSERT(pipeline != NULL, "Pipeline creation failed");
+
+    // step feeds only itself; nothing after it changes the state
+    SPEC_EXPECT_EQ(nlink_pipeline_add_tracked_stage(pipeline, "step", spec_step_stage, NULL), NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(nlink_pipeline_add_tracked_stage(pipeline, "idle", spec_idle_stage, NULL), NEXUS_SUCCESS);
+
+    SPEC_EXPECT_EQ(nlink_pipeline_execute_sized(pipeline, state, sizeof(state),
+                                                output, sizeof(output), NULL),
+                   NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(output[0], 3);
+
+    unsigned iterations = 0;
+    NlinkPipelineStageStats stats[2];
+    SPEC_EXPECT_EQ(nlink_pipeline_get_stats(pipeline, &iterations, NULL, stats, 2), NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(iterations, 4u);
+    SPEC_EXPECT_EQ(stats[0].runs, 4u);
+    SPEC_EXPECT_EQ(stats[1].runs, 3u);
+    SPEC_EXPECT_EQ(stats[1].skipped, 1u);
+
+    nlink_pipeline_destroy(pipeline);
+    nexus_destroy_context(ctx);
+    return SPEC_PASS;
+}
+
+spec_result_t spec_tracked_hash_detects_rewritten_state(void) {
+    unsigned char state[PIPELINE_SPEC_BYTES] = {0};
+    unsigned char output[PIPELINE_SPEC_BYTES];
+    NexusConfig context_config = {0};
+    context_config.log_level = NEXUS_LOG_ERROR;
+    NexusContext* ctx = nexus_create_context(&context_config);
+    SPEC_ASSERT(ctx != NULL, "Context creation failed");
+
+    NlinkPipelineConfig config = nlink_pipeline_default_config();
+    config.mode = NLINK_PIPELINE_MODE_MULTI_PASS;
+    NlinkPipeline* pipeline = nlink_pipeline_create(ctx, &config);
+    SPEC_ASSERT(pipeline != NULL, "Pipeline creation failed");
+
+    // rehash marks its byte on every run; only the hash shows it is a fixed point
+    SPEC_EXPECT_EQ(nlink_pipeline_add_tracked_stage(pipeline, "step", spec_step_stage, NULL), NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(nlink_pipeline_add_tracked_stage(pipeline, "rehash", spec_rehash_stage, NULL), NEXUS_SUCCESS);
+
+    SPEC_EXPECT_EQ(nlink_pipeline_execute_sized(pipeline, state, sizeof(state),
+                                                output, sizeof(output), NULL),
+                   NEXUS_SUCCESS);
+    SPEC_ASSERT(output[0] == 3 && output[2] == 6, "Tracked stages produced the wrong state");
+
+    unsigned iterations = 0;
+    SPEC_EXPECT_EQ(nlink_pipeline_get_stats(pipeline, &iterations, NULL, NULL, 0), NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(iterations, 4u);
+
+    nlink_pipeline_destroy(pipeline);
+    nexus_destroy_context(ctx);
+    return SPEC_PASS;
+}
+
+int main() {
+    etps_init();
+
+    spec_suite_t* suite = spec_suite_create("NLink_Pipeline_Specs");
+
+    spec_add_test(suite, "Single-pass outputs larger than 1 KiB are kept whole", spec_single_pass_keeps_large_outputs);
+    spec_add_test(suite, "Short inputs are padded for a legacy first stage", spec_single_pass_pads_short_legacy_input);
+    spec_add_test(suite, "Multi-pass state buffers are sized from the payload", spec_multi_pass_sizes_state_from_payload);
+    spec_add_test(suite, "Tracked stages converge on reported changes", spec_tracked_stages_converge_on_reported_changes);
+    spec_add_test(suite, "The worklist reruns a stage that changed its own input", spec_worklist_reruns_self_changing_stage);
+    spec_add_test(suite, "Tracked stage hashes recognize rewritten state", spec_tracked_hash_detects_rewritten_state);
+
+    int result = spec_suite_run(suite);
+
+    spec_suite_destroy(suite);
+    etps_shutdown();
+
+    return result;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file sps_stream_spec.c
+ * @brief Chunked and Mapped Data Stream Unit Specifications
+ */
+
+#include "../spec_runner.c"
+#include "nlink/spsystem/sps_stream.h"
+
+#define STREAM_SPEC_BYTES 1000
+#define STREAM_SPEC_FILE "/tmp/nlink_sps_stream_spec.bin"
+
+static void stream_spec_fill(unsigned char* bytes, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        bytes[i] = (unsigned char)(i * 7 + 3);
+    }
+}
+
+spec_result_t spec_chunked_append_keeps_chunks(void) {
+    unsigned char bytes[STREAM_SPEC_BYTES];
+    unsigned char out[STREAM_SPEC_BYTES];
+    stream_spec_fill(bytes, sizeof(bytes));
+
+    NexusDataStream* stream = sps_stream_create_chunked(64);
+    SPEC_ASSERT(stream != NULL, "Chunked stream creation failed");
+
+    for (size_t i = 0; i < STREAM_SPEC_BYTES; i += 100) {
+        SPEC_EXPECT_EQ(sps_stream_write(stream, bytes + i, 100), NEXUS_SUCCESS);
+    }
+    SPEC_EXPECT_EQ(stream->size, (size_t)STREAM_SPEC_BYTES);
+
+    // Several chunks, so the payload is not addressable as one buffer
+    NexusStreamSegment segments[32];
+    size_t count = sps_stream_get_segments(stream, segments, 32);
+    SPEC_ASSERT(count > 1, "Expected more than one chunk");
+    SPEC_ASSERT(stream->data == NULL, "Scattered stream exposed a data pointer");
+
+    size_t bytes_read = 0;
+    stream->position = 0;
+    SPEC_EXPECT_EQ(sps_stream_read(stream, out, sizeof(out), &bytes_read), NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(bytes_read, (size_t)STREAM_SPEC_BYTES);
+    SPEC_ASSERT(memcmp(out, bytes, sizeof(bytes)) == 0, "Read back different bytes");
+
+    SPEC_EXPECT_EQ(sps_stream_flatten(stream), NEXUS_SUCCESS);
+    SPEC_ASSERT(stream->data != NULL, "Flattened stream has no data pointer");
+    SPEC_ASSERT(memcmp(stream->data, bytes, sizeof(bytes)) == 0, "Flatten changed the bytes");
+
+    sps_stream_destroy(stream);
+    return SPEC_PASS;
+}
+
+spec_result_t spec_chunked_clone_copies_on_write(void) {
+    unsigned char bytes[STREAM_SPEC_BYTES];
+    unsigned char out[STREAM_SPEC_BYTES];
+    stream_spec_fill(bytes, sizeof(bytes));
+
+    NexusDataStream* stream = sps_stream_create_chunked(64);
+    SPEC_ASSERT(stream != NULL, "Chunked stream creation failed");
+    SPEC_EXPECT_EQ(sps_stream_write(stream, bytes, sizeof(bytes)), NEXUS_SUCCESS);
+
+    NexusDataStream* clone = sps_stream_clone(stream);
+    SPEC_ASSERT(clone != NULL, "Clone failed");
+
+    // Both share the payload until one side writes
+    NexusStreamSegment original_segment;
+    NexusStreamSegment clone_segment;
+    sps_stream_get_segments(stream, &original_segment, 1);
+    sps_stream_get_segments(clone, &clone_segment, 1);
+    SPEC_ASSERT(original_segment.base == clone_segment.base, "Clone copied the payload");
+
+    clone->position = 10;
+    SPEC_EXPECT_EQ(sps_stream_write(clone, "patch", 5), NEXUS_SUCCESS);
+    clone->position = clone->size;
+    SPEC_EXPECT_EQ(sps_stream_write(clone, "tail", 4), NEXUS_SUCCESS);
+
+    size_t bytes_read = 0;
+    stream->position = 0;
+    sps_stream_read(stream, out, sizeof(out), &bytes_read);
+    SPEC_ASSERT(memcmp(out, bytes, sizeof(bytes)) == 0, "Original changed by a write to its clone");
+    SPEC_EXPECT_EQ(stream->size, (size_t)STREAM_SPEC_BYTES);
+
+    clone->position = 10;
+    sps_stream_read(clone, out, 5, &bytes_read);
+    SPEC_ASSERT(memcmp(out, "patch", 5) == 0, "Clone lost its overwrite");
+    SPEC_EXPECT_EQ(clone->size, (size_t)STREAM_SPEC_BYTES + 4);
+
+    sps_stream_destroy(stream);
+    sps_stream_destroy(clone);
+    return SPEC_PASS;
+}
+
+spec_result_t spec_mapped_stream_is_zero_copy(void) {
+    unsigned char bytes[STREAM_SPEC_BYTES];
+    stream_spec_fill(bytes, sizeof(bytes));
+
+    FILE* f = fopen(STREAM_SPEC_FILE, "wb");
+    SPEC_ASSERT(f != NULL, "Could not write fixture");
+    fwrite(bytes, 1, sizeof(bytes), f);
+    fclose(f);
+
+    NexusResult result = NEXUS_SUCCESS;
+    NexusDataStream* stream = sps_stream_create_from_file(STREAM_SPEC_FILE, "binary", &result);
+    SPEC_ASSERT(stream != NULL, "Mapping the fixture failed");
+    SPEC_EXPECT_EQ(result, NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(stream->backing, NEXUS_STREAM_MAPPED);
+    SPEC_ASSERT(memcmp(stream->data, bytes, sizeof(bytes)) == 0, "Mapped bytes differ from the file");
+
+    NexusDataStream* clone = sps_stream_clone(stream);
+    SPEC_ASSERT(clone != NULL && clone->data == stream->data, "Clone did not share the mapping");
+
+    // The first write moves the clone onto a private buffer
+    clone->position = 0;
+    SPEC_EXPECT_EQ(sps_stream_write(clone, "X", 1), NEXUS_SUCCESS);
+    SPEC_EXPECT_EQ(clone->backing, NEXUS_STREAM_CONTIGUOUS);
+    SPEC_ASSERT(((unsigned char*)stream->data)[0] == bytes[0], "Write reached the mapping");
+    SPEC_ASSERT(((unsigned char*)clone->data)[0] == 'X', "Clone lost its write");
+
+    sps_stream_destroy(stream);
+    sps_stream_destroy(clone);
+    remove(STREAM_SPEC_FILE);
+
+    SPEC_ASSERT(sps_stream_create_from_file("/tmp/nlink_sps_stream_missing.bin", NULL, &result) == NULL,
+                "Mapped a missing file");
+    SPEC_EXPECT_EQ(result, NEXUS_FILE_NOT_FOUND);
+    return SPEC_PASS;
+}
+
+int main() {
+    etps_init();
+
+    spec_suite_t* suite = spec_suite_create("SPS_Stream_Specs");
+
+    spec_add_test(suite, "Chunked appends keep existing chunks in place", spec_chunked_append_keeps_chunks);
+    spec_add_test(suite, "Chunked clones copy on write", spec_chunked_clone_copies_on_write);
+    spec_add_test(suite, "Mapped streams share the file mapping", spec_mapped_stream_is_zero_copy);
+
+    int result = spec_suite_run(suite);
+
+    spec_suite_destroy(suite);
+    etps_shutdown();
+
+    return result;
+}
@@ -253,7 +253,7 @@
      /* Get and display execution statistics */
      unsigned iterations;
      double execution_time_ms;
-     nlink_pipeline_get_stats(data->pipeline, &iterations, &execution_time_ms);
+     nlink_pipeline_get_stats(data->pipeline, &iterations, &execution_time_ms, NULL, 0);
      
      nexus_log(ctx, NEXUS_LOG_INFO, "Pipeline executed successfully in %.2f ms with %u iteration(s)",
               execution_time_ms, iterations);
@@ -15,8 +15,10 @@
 #include <unistd.h>
 #include <errno.h>
 #include <stdarg.h>
+#include <pthread.h>
 
 #include "nlink/core/etps/etps_telemetry.h"
+#include "nlink/core/threading/thread_pool.h"
 
 // =============================================================================
 // Global ETPS State
@@ -26,6 +28,13 @@ static bool g_etps_initialized = false;
 static etps_semverx_event_t* g_event_buffer = NULL;
 static size_t g_event_count = 0;
 static size_t g_event_capacity = 1000;
+static pthread_mutex_t g_event_mutex = PTHREAD_MUTEX_INITIALIZER;   // Guards the event buffer
+
+// Flushes handed to the shared thread pool and not yet written
+typedef struct etps_flush_target etps_flush_target_t;
+static nlink_task_group_t g_flush_group;
+static pthread_mutex_t g_flush_mutex = PTHREAD_MUTEX_INITIALIZER;   // Guards the flush targets
+static etps_flush_target_t* g_flush_targets = NULL;
 
 // =============================================================================
 // Safe String Utilities (eliminates all strncpy warnings)
@@ -105,6 +114,8 @@ void etps_generate_iso8601_timestamp(char* buffer, size_t max_len) {
 // Core ETPS Functions
 // =============================================================================
 
+static void flush_targets_free(void);
+
 int etps_init(void) {
     if (g_etps_initialized) return 0;
     
@@ -115,6 +126,7 @@ int etps_init(void) {
     }
     
     g_event_count = 0;
+    nlink_task_group_init(&g_flush_group);
     g_etps_initialized = true;
     printf("[ETPS_INFO] ETPS system initialized\n");
     return 0;
@@ -123,6 +135,9 @@ int etps_init(void) {
 void etps_shutdown(void) {
     if (!g_etps_initialized) return;
     
+    etps_flush_wait();
+    flush_targets_free();
+    
     if (g_event_buffer) {
         free(g_event_buffer);
         g_event_buffer = NULL;
@@ -311,10 +326,12 @@ compatibility_result_t etps_validate_component_compatibility(
 void etps_emit_semverx_event(etps_context_t* ctx, const etps_semverx_event_t* event) {
     if (!ctx || !event || !g_etps_initialized) return;
     
+    pthread_mutex_lock(&g_event_mutex);
     if (g_event_count < g_event_capacity) {
         memcpy(&g_event_buffer[g_event_count], event, sizeof(etps_semverx_event_t));
         g_event_count++;
     }
+    pthread_mutex_unlock(&g_event_mutex);
     
     printf("\n=== ETPS SemVerX Event ===\n");
     printf("Event ID: %s\n", event->event_id);
@@ -494,22 +511,303 @@ int etps_validate_project_compatibility(const char* project_path) {
     return (result == COMPAT_DENIED) ? 1 : 0;
 }
 
+// =============================================================================
+// Event Export
+// =============================================================================
+
+static void write_json_string(FILE* file, const char* value) {
+    fputc('"', file);
+    for (const unsigned char* c = (const unsigned char*)value; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(file, "\\%c", *c);
+        } else if (*c < 0x20) {
+            fprintf(file, "\\u%04x", *c);
+        } else {
+            fputc(*c, file);
+        }
+    }
+    fputc('"', file);
+}
+
+static void write_component_json(FILE* file, const char* key, const semverx_component_t* component) {
+    fprintf(file, "      \"%s\": { \"name\": ", key);
+    write_json_string(file, component->name);
+    fprintf(file, ", \"version\": ");
+    write_json_string(file, component->version);
+    fprintf(file, ", \"range_state\": \"%s\" },\n", etps_range_state_to_string(component->range_state));
+}
+
+// Widest event_count an appended document reserves: SIZE_MAX in decimal
+#define ETPS_EVENT_COUNT_WIDTH 20
+
+// Write event_count padded with spaces to a fixed width, so an append can
+// rewrite it in place; the padding is JSON whitespace
+static void write_padded_event_count(FILE* file, size_t count) {
+    fprintf(file, "%-*zu", ETPS_EVENT_COUNT_WIDTH, count);
+}
+
+// Open the document. With count_offset set, event_count is padded and its
+// position stored so appends can update it.
+static void write_events_header(FILE* file, size_t count, long* count_offset) {
+    fprintf(file, "{\n");
+    fprintf(file, "  \"etps_version\": \"1.0.0\",\n");
+    fprintf(file, "  \"event_count\": ");
+    if (count_offset) {
+        *count_offset = ftell(file);
+        write_padded_event_count(file, count);
+    } else {
+        fprintf(file, "%zu", count);
+    }
+    fprintf(file, ",\n");
+    fprintf(file, "  \"events\": [");
+}
+
+static void write_event_json(FILE* file, const etps_semverx_event_t* event, bool first) {
+    fprintf(file, "%s\n    {\n      \"event_id\": ", first ? "" : ",");
+    write_json_string(file, event->event_id);
+    fprintf(file, ",\n      \"timestamp\": ");
+    write_json_string(file, event->timestamp);
+    fprintf(file, ",\n");
+    write_component_json(file, "source", &event->source_component);
+    write_component_json(file, "target", &event->target_component);
+    fprintf(file, "      \"result\": \"%s\",\n",
+            etps_compatibility_result_to_string(event->compatibility_result));
+    fprintf(file, "      \"severity\": %d,\n", event->severity);
+    fprintf(file, "      \"recommendation\": ");
+    write_json_string(file, event->migration_recommendation);
+    fprintf(file, "\n    }");
+}
+
+static void write_events_trailer(FILE* file, size_t count) {
+    fprintf(file, "%s]\n", count > 0 ? "\n  " : "");
+    fprintf(file, "}\n");
+}
+
+static int close_events_file(FILE* file) {
+    int result = ferror(file) ? -1 : 0;
+    if (fclose(file) != 0) {
+        result = -1;
+    }
+    return result;
+}
+
+static int write_events_json(const char* output_path, const etps_semverx_event_t* events, size_t count) {
+    FILE* file = fopen(output_path, "w");
+    if (!file) {
+        fprintf(stderr, "[ETPS_ERROR] Failed to create file: %s\n", output_path);
+        return -1;
+    }
+    
+    write_events_header(file, count, NULL);
+    for (size_t i = 0; i < count; i++) {
+        write_event_json(file, &events[i], i == 0);
+    }
+    write_events_trailer(file, count);
+    return close_events_file(file);
+}
+
 int etps_export_events_json(etps_context_t* ctx, const char* output_path) {
     if (!ctx || !output_path || !g_etps_initialized) return -1;
     
-    FILE* file = fopen(output_path, "w");
+    // Write from a copy so emitters are not held up by file I/O
+    pthread_mutex_lock(&g_event_mutex);
+    size_t count = g_event_count;
+    etps_semverx_event_t* events = malloc((count ? count : 1) * sizeof(etps_semverx_event_t));
+    if (events) {
+        memcpy(events, g_event_buffer, count * sizeof(etps_semverx_event_t));
+    }
+    pthread_mutex_unlock(&g_event_mutex);
+    
+    if (!events) {
+        fprintf(stderr, "[ETPS_ERROR] Failed to allocate export buffer\n");
+        return -1;
+    }
+    
+    int result = write_events_json(output_path, events, count);
+    free(events);
+    
+    if (result == 0) {
+        printf("[ETPS_INFO] Exported %zu events to %s\n", count, output_path);
+    }
+    return result;
+}
+
+// A flushed buffer waiting to be written
+typedef struct etps_flush_batch {
+    etps_semverx_event_t* events;
+    size_t count;
+    struct etps_flush_batch* next;
+} etps_flush_batch_t;
+
+// Every flush to one path appends to the same document, one pool task at a time
+struct etps_flush_target {
+    char* output_path;
+    etps_flush_batch_t* pending;        // Batches not yet written, oldest first
+    etps_flush_batch_t* pending_tail;
+    bool task_queued;                   // A flush task owns the fields below
+    bool started;                       // The document was created since etps_init
+    long count_offset;                  // Where the padded event_count value starts
+    long trailer_offset;                // Where the closing of the events array starts
+    size_t event_count;                 // Events in the document
+    etps_flush_target_t* next;
+};
+
+// Find or add the target for a path; the caller holds g_flush_mutex
+static etps_flush_target_t* flush_target_get(const char* output_path) {
+    for (etps_flush_target_t* target = g_flush_targets; target; target = target->next) {
+        if (strcmp(target->output_path, output_path) == 0) {
+            return target;
+        }
+    }
+    
+    etps_flush_target_t* target = calloc(1, sizeof(etps_flush_target_t));
+    if (!target) return NULL;
+    target->output_path = strdup(output_path);
+    if (!target->output_path) {
+        free(target);
+        return NULL;
+    }
+    target->next = g_flush_targets;
+    g_flush_targets = target;
+    return target;
+}
+
+static void flush_targets_free(void) {
+    pthread_mutex_lock(&g_flush_mutex);
+    while (g_flush_targets) {
+        etps_flush_target_t* next = g_flush_targets->next;
+        free(g_flush_targets->output_path);
+        free(g_flush_targets);
+        g_flush_targets = next;
+    }
+    pthread_mutex_unlock(&g_flush_mutex);
+}
+
+// Write batches into a target's document: the first write creates it, later
+// ones overwrite its trailer and event_count so the file stays one valid
+// JSON document
+static int append_events_json(etps_flush_target_t* target, const etps_flush_batch_t* batches) {
+    FILE* file = fopen(target->output_path, target->started ? "r+" : "w");
     if (!file) {
-        fprintf(stderr, "[ETPS_ERROR] Failed to create file: %s\n", output_path);
+        fprintf(stderr, "[ETPS_ERROR] Failed to open file: %s\n", target->output_path);
         return -1;
     }
     
-    fprintf(file, "{\n");
-    fprintf(file, "  \"etps_version\": \"1.0.0\",\n");
-    fprintf(file, "  \"event_count\": %zu,\n", g_event_count);
-    fprintf(file, "  \"events\": []\n");
-    fprintf(file, "}\n");
+    if (!target->started) {
+        target->event_count = 0;
+        write_events_header(file, 0, &target->count_offset);
+    } else if (fseek(file, target->trailer_offset, SEEK_SET) != 0) {
+        fclose(file);
+        return -1;
+    }
+    
+    for (const etps_flush_batch_t* batch = batches; batch; batch = batch->next) {
+        for (size_t i = 0; i < batch->count; i++) {
+            write_event_json(file, &batch->events[i], target->event_count == 0);
+            target->event_count++;
+        }
+    }
+    // The new trailer is never shorter than the one it replaces
+    target->trailer_offset = ftell(file);
+    write_events_trailer(file, target->event_count);
+    
+    bool counted = target->count_offset >= 0 &&
+                   fseek(file, target->count_offset, SEEK_SET) == 0;
+    if (counted) {
+        write_padded_event_count(file, target->event_count);
+    }
+    
+    int result = close_events_file(file);
+    // After a failed write, the next flush starts a new document
+    target->started = result == 0 && counted && target->trailer_offset >= 0;
+    return target->started ? 0 : -1;
+}
+
+// Pool task: write a target's batches in flush order until none are left.
+// Batches flushed while a write is in progress are merged into the next one.
+static void flush_target_run(void* arg) {
+    etps_flush_target_t* target = (etps_flush_target_t*)arg;
+    
+    pthread_mutex_lock(&g_flush_mutex);
+    while (target->pending) {
+        etps_flush_batch_t* batches = target->pending;
+        target->pending = NULL;
+        target->pending_tail = NULL;
+        pthread_mutex_unlock(&g_flush_mutex);
+        
+        size_t count = 0;
+        for (etps_flush_batch_t* batch = batches; batch; batch = batch->next) {
+            count += batch->count;
+        }
+        if (append_events_json(target, batches) != 0) {
+            fprintf(stderr, "[ETPS_ERROR] Failed to flush %zu events to %s\n", count, target->output_path);
+        }
+        while (batches) {
+            etps_flush_batch_t* next = batches->next;
+            free(batches->events);
+            free(batches);
+            batches = next;
+        }
+        
+        pthread_mutex_lock(&g_flush_mutex);
+    }
+    target->task_queued = false;
+    pthread_mutex_unlock(&g_flush_mutex);
+}
+
+int etps_flush_events_async(etps_context_t* ctx, const char* output_path) {
+    if (!ctx || !output_path || !g_etps_initialized) return -1;
+    
+    pthread_mutex_lock(&g_flush_mutex);
+    etps_flush_target_t* target = flush_target_get(output_path);
+    pthread_mutex_unlock(&g_flush_mutex);
+    
+    etps_flush_batch_t* batch = calloc(1, sizeof(etps_flush_batch_t));
+    etps_semverx_event_t* spare = calloc(g_event_capacity, sizeof(etps_semverx_event_t));
+    if (!target || !batch || !spare) {
+        free(batch);
+        free(spare);
+        fprintf(stderr, "[ETPS_ERROR] Failed to allocate flush buffer\n");
+        return -1;
+    }
     
-    fclose(file);
-    printf("[ETPS_INFO] Exported %zu events to %s\n", g_event_count, output_path);
+    // Swap buffers: the batch takes the recorded events, emitters continue in the spare
+    pthread_mutex_lock(&g_event_mutex);
+    batch->events = g_event_buffer;
+    batch->count = g_event_count;
+    g_event_buffer = spare;
+    g_event_count = 0;
+    pthread_mutex_unlock(&g_event_mutex);
+    
+    // Queue the batch behind earlier flushes to the same path; a task already
+    // draining that path picks it up
+    pthread_mutex_lock(&g_flush_mutex);
+    if (target->pending_tail) {
+        target->pending_tail->next = batch;
+    } else {
+        target->pending = batch;
+    }
+    target->pending_tail = batch;
+    bool submit = !target->task_queued;
+    target->task_queued = true;
+    pthread_mutex_unlock(&g_flush_mutex);
+    
+    if (!submit) return 0;
+    
+    nlink_thread_pool_t* pool = nlink_thread_pool_shared();
+    if (!pool) {
+        flush_target_run(target);
+        return 0;
+    }
+    
+    nlink_thread_pool_submit(pool, flush_target_run, target, &g_flush_group);
     return 0;
 }
+
+void etps_flush_wait(void) {
+    // A shared pool that shut down ran its queued flushes before it went away
+    nlink_thread_pool_t* pool = nlink_thread_pool_shared_current();
+    if (pool) {
+        nlink_thread_pool_wait(pool, &g_flush_group);
+    }
+}
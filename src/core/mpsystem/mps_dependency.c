@@ -14,44 +14,476 @@
 #include <string.h>
 #include <stdlib.h>
 
+// Marks a node Tarjan's algorithm has not reached yet
+#define MPS_UNVISITED ((size_t)-1)
+
+// Find a node by component ID
+static size_t find_node(const NexusMPSDependencyGraph* graph, const char* component_id) {
+    for (size_t i = 0; i < graph->node_count; i++) {
+        if (strcmp(graph->nodes[i].component_id, component_id) == 0) {
+            return i;
+        }
+    }
+    return MPS_UNVISITED;
+}
+
+// Append an edge along which data flows from source to target
+static void add_edge(NexusMPSDependencyGraph* graph,
+                     size_t source_idx,
+                     size_t target_idx,
+                     const NexusComponentConnection* connection) {
+    NexusMPSDependencyEdge* edge = &graph->edges[graph->edge_count++];
+    edge->source_idx = source_idx;
+    edge->target_idx = target_idx;
+    edge->direction = connection->direction;
+    edge->data_format = connection->data_format;
+    edge->optional = connection->optional;
+}
+
 // Create a dependency graph from multi-pass component metadata
-NexusMPSDependencyGraph* mps_create_dependency_graph(NexusContext* ctx, 
+NexusMPSDependencyGraph* mps_create_dependency_graph(NexusContext* ctx,
                                                     const NexusMPSConfig* config) {
-    // TODO: Implementation
-    return NULL;
+    if (!ctx || !config) {
+        return NULL;
+    }
+
+    NexusMPSDependencyGraph* graph = (NexusMPSDependencyGraph*)calloc(1, sizeof(NexusMPSDependencyGraph));
+    if (!graph) {
+        return NULL;
+    }
+    graph->config = config;
+
+    // A bidirectional connection becomes two edges
+    graph->nodes = (NexusMPSDependencyNode*)calloc(config->component_count + 1, sizeof(NexusMPSDependencyNode));
+    graph->edges = (NexusMPSDependencyEdge*)calloc(config->connection_count * 2 + 1, sizeof(NexusMPSDependencyEdge));
+    if (!graph->nodes || !graph->edges) {
+        mps_free_dependency_graph(graph);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < config->component_count; i++) {
+        NexusMPSComponentConfig* component = config->components[i];
+        if (find_node(graph, component->component_id) != MPS_UNVISITED) {
+            nexus_log(ctx, NEXUS_LOG_ERROR, "Duplicate component '%s' in pipeline", component->component_id);
+            mps_free_dependency_graph(graph);
+            return NULL;
+        }
+
+        NexusMPSDependencyNode* node = &graph->nodes[graph->node_count++];
+        node->component_id = component->component_id;
+        node->config = component;
+        node->supports_reentrance = component->supports_reentrance;
+        node->component_group = -1;
+    }
+
+    for (size_t i = 0; i < config->connection_count; i++) {
+        const NexusComponentConnection* connection = config->connections[i];
+        size_t source = find_node(graph, connection->source_id);
+        size_t target = find_node(graph, connection->target_id);
+        if (source == MPS_UNVISITED || target == MPS_UNVISITED) {
+            nexus_log(ctx, NEXUS_LOG_ERROR, "Connection '%s' -> '%s' references an unknown component",
+                     connection->source_id, connection->target_id);
+            mps_free_dependency_graph(graph);
+            return NULL;
+        }
+
+        // Edges point the way data flows
+        if (connection->direction != NEXUS_DIRECTION_BACKWARD) {
+            add_edge(graph, source, target, connection);
+        }
+        if (connection->direction != NEXUS_DIRECTION_FORWARD) {
+            add_edge(graph, target, source, connection);
+        }
+    }
+
+    // Per-node edge lists
+    for (size_t i = 0; i < graph->edge_count; i++) {
+        graph->nodes[graph->edges[i].source_idx].outgoing_count++;
+        graph->nodes[graph->edges[i].target_idx].incoming_count++;
+    }
+
+    for (size_t i = 0; i < graph->node_count; i++) {
+        NexusMPSDependencyNode* node = &graph->nodes[i];
+        node->incoming_edges = (size_t*)malloc((node->incoming_count + 1) * sizeof(size_t));
+        node->outgoing_edges = (size_t*)malloc((node->outgoing_count + 1) * sizeof(size_t));
+        if (!node->incoming_edges || !node->outgoing_edges) {
+            mps_free_dependency_graph(graph);
+            return NULL;
+        }
+        node->incoming_count = 0;
+        node->outgoing_count = 0;
+    }
+
+    for (size_t i = 0; i < graph->edge_count; i++) {
+        NexusMPSDependencyNode* source = &graph->nodes[graph->edges[i].source_idx];
+        NexusMPSDependencyNode* target = &graph->nodes[graph->edges[i].target_idx];
+        source->outgoing_edges[source->outgoing_count++] = i;
+        target->incoming_edges[target->incoming_count++] = i;
+    }
+
+    nexus_log(ctx, NEXUS_LOG_DEBUG, "Created dependency graph with %zu nodes and %zu edges",
+             graph->node_count, graph->edge_count);
+
+    return graph;
 }
 
-// Resolve bidirectional dependencies
-NexusResult mps_resolve_bidirectional_dependencies(NexusContext* ctx, 
+// Whether a group is cyclic: more than one node, or a node feeding itself
+static bool group_has_cycles(const NexusMPSDependencyGraph* graph,
+                             const size_t* nodes,
+                             size_t count) {
+    if (count > 1) {
+        return true;
+    }
+
+    const NexusMPSDependencyNode* node = &graph->nodes[nodes[0]];
+    for (size_t i = 0; i < node->outgoing_count; i++) {
+        if (graph->edges[node->outgoing_edges[i]].target_idx == nodes[0]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static int compare_indices(const void* a, const void* b) {
+    size_t left = *(const size_t*)a;
+    size_t right = *(const size_t*)b;
+    return (left > right) - (left < right);
+}
+
+// Find strongly connected components (for cycle detection)
+NexusResult mps_find_strongly_connected_components(NexusContext* ctx,
                                                   NexusMPSDependencyGraph* graph,
-                                                  NexusExecutionGroup*** execution_groups,
+                                                  size_t** node_order,
+                                                  size_t** group_offsets,
                                                   size_t* group_count) {
-    // TODO: Implementation
+    if (!ctx || !graph || !node_order || !group_offsets || !group_count) {
+        return NEXUS_INVALID_PARAMETER;
+    }
+
+    size_t n = graph->node_count;
+
+    // Tarjan's algorithm with an explicit call stack, so deep graphs
+    // cannot overflow the thread stack
+    size_t* index = (size_t*)malloc((n + 1) * sizeof(size_t));
+    size_t* lowlink = (size_t*)malloc((n + 1) * sizeof(size_t));
+    size_t* next_edge = (size_t*)malloc((n + 1) * sizeof(size_t));
+    size_t* call_stack = (size_t*)malloc((n + 1) * sizeof(size_t));
+    size_t* scc_stack = (size_t*)malloc((n + 1) * sizeof(size_t));
+    bool* on_stack = (bool*)calloc(n + 1, sizeof(bool));
+    size_t* order = (size_t*)malloc((n + 1) * sizeof(size_t));
+    size_t* offsets = (size_t*)malloc((n + 1) * sizeof(size_t));
+
+    if (!index || !lowlink || !next_edge || !call_stack || !scc_stack || !on_stack || !order || !offsets) {
+        free(index);
+        free(lowlink);
+        free(next_edge);
+        free(call_stack);
+        free(scc_stack);
+        free(on_stack);
+        free(order);
+        free(offsets);
+        return NEXUS_OUT_OF_MEMORY;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        index[i] = MPS_UNVISITED;
+    }
+
+    size_t next_index = 0;
+    size_t scc_top = 0;
+    size_t emitted = 0;     // Nodes written to order
+    size_t groups = 0;
+
+    for (size_t root = 0; root < n; root++) {
+        if (index[root] != MPS_UNVISITED) {
+            continue;
+        }
+
+        size_t call_top = 0;
+        call_stack[call_top++] = root;
+        index[root] = lowlink[root] = next_index++;
+        next_edge[root] = 0;
+        scc_stack[scc_top++] = root;
+        on_stack[root] = true;
+
+        while (call_top > 0) {
+            size_t v = call_stack[call_top - 1];
+            NexusMPSDependencyNode* node = &graph->nodes[v];
+
+            if (next_edge[v] < node->outgoing_count) {
+                size_t w = graph->edges[node->outgoing_edges[next_edge[v]++]].target_idx;
+                if (index[w] == MPS_UNVISITED) {
+                    // Descend into w
+                    index[w] = lowlink[w] = next_index++;
+                    next_edge[w] = 0;
+                    scc_stack[scc_top++] = w;
+                    on_stack[w] = true;
+                    call_stack[call_top++] = w;
+                } else if (on_stack[w] && index[w] < lowlink[v]) {
+                    lowlink[v] = index[w];
+                }
+                continue;
+            }
+
+            // All of v's edges are done; v roots a component if nothing
+            // below it reached further up
+            if (lowlink[v] == index[v]) {
+                offsets[groups++] = emitted;
+                size_t w;
+                do {
+                    w = scc_stack[--scc_top];
+                    on_stack[w] = false;
+                    order[emitted++] = w;
+                } while (w != v);
+            }
+
+            call_top--;
+            if (call_top > 0) {
+                size_t parent = call_stack[call_top - 1];
+                if (lowlink[v] < lowlink[parent]) {
+                    lowlink[parent] = lowlink[v];
+                }
+            }
+        }
+    }
+    offsets[groups] = emitted;
+
+    // Tarjan emits components in reverse topological order; flip them and
+    // put each component's nodes in node order
+    size_t* topo_order = index;        // Reuse scratch arrays
+    size_t* topo_offsets = lowlink;
+    size_t written = 0;
+    for (size_t g = 0; g < groups; g++) {
+        size_t source = groups - 1 - g;
+        size_t begin = offsets[source];
+        size_t count = offsets[source + 1] - begin;
+
+        topo_offsets[g] = written;
+        memcpy(&topo_order[written], &order[begin], count * sizeof(size_t));
+        qsort(&topo_order[written], count, sizeof(size_t), compare_indices);
+        for (size_t i = 0; i < count; i++) {
+            graph->nodes[topo_order[written + i]].component_group = (int)g;
+        }
+        written += count;
+    }
+    topo_offsets[groups] = written;
+
+    free(next_edge);
+    free(call_stack);
+    free(scc_stack);
+    free(on_stack);
+    free(order);
+    free(offsets);
+
+    *node_order = topo_order;
+    *group_offsets = topo_offsets;
+    *group_count = groups;
     return NEXUS_SUCCESS;
 }
 
-// Find strongly connected components (for cycle detection)
-NexusResult mps_find_strongly_connected_components(NexusContext* ctx,
+// Resolve bidirectional dependencies
+NexusResult mps_resolve_bidirectional_dependencies(NexusContext* ctx,
                                                   NexusMPSDependencyGraph* graph,
-                                                  NexusComponent*** components,
-                                                  size_t** component_counts,
+                                                  NexusExecutionGroup*** execution_groups,
                                                   size_t* group_count) {
-    // TODO: Implementation
+    if (!ctx || !graph || !execution_groups || !group_count) {
+        return NEXUS_INVALID_PARAMETER;
+    }
+
+    size_t* node_order = NULL;
+    size_t* group_offsets = NULL;
+    size_t groups = 0;
+    NexusResult result = mps_find_strongly_connected_components(ctx, graph, &node_order, &group_offsets, &groups);
+    if (result != NEXUS_SUCCESS) {
+        return result;
+    }
+
+    // Level of each group: one past the deepest group feeding it. Groups
+    // are in topological order, so every predecessor is already done.
+    size_t* levels = (size_t*)calloc(groups + 1, sizeof(size_t));
+    NexusExecutionGroup** resolved = (NexusExecutionGroup**)calloc(groups + 1, sizeof(NexusExecutionGroup*));
+    if (!levels || !resolved) {
+        free(levels);
+        free(resolved);
+        free(node_order);
+        free(group_offsets);
+        return NEXUS_OUT_OF_MEMORY;
+    }
+
+    for (size_t g = 0; g < groups; g++) {
+        for (size_t i = group_offsets[g]; i < group_offsets[g + 1]; i++) {
+            NexusMPSDependencyNode* node = &graph->nodes[node_order[i]];
+            for (size_t e = 0; e < node->incoming_count; e++) {
+                size_t source_group = (size_t)graph->nodes[graph->edges[node->incoming_edges[e]].source_idx].component_group;
+                if (source_group != g && levels[source_group] + 1 > levels[g]) {
+                    levels[g] = levels[source_group] + 1;
+                }
+            }
+        }
+    }
+
+    size_t max_level = 0;
+    for (size_t g = 0; g < groups; g++) {
+        if (levels[g] > max_level) {
+            max_level = levels[g];
+        }
+    }
+
+    // Bucket groups by level: count each level, prefix-sum the counts into
+    // offsets, then fill in group order so each level keeps it
+    size_t* level_offsets = (size_t*)calloc(max_level + 2, sizeof(size_t));
+    size_t* by_level = (size_t*)malloc((groups + 1) * sizeof(size_t));
+    if (!level_offsets || !by_level) {
+        free(level_offsets);
+        free(by_level);
+        free(levels);
+        free(resolved);
+        free(node_order);
+        free(group_offsets);
+        return NEXUS_OUT_OF_MEMORY;
+    }
+
+    for (size_t g = 0; g < groups; g++) {
+        level_offsets[levels[g] + 1]++;
+    }
+    for (size_t level = 0; level <= max_level; level++) {
+        level_offsets[level + 1] += level_offsets[level];
+    }
+    for (size_t g = 0; g < groups; g++) {
+        by_level[level_offsets[levels[g]]++] = g;
+    }
+    free(level_offsets);
+
+    // Emit groups level by level; that order is still topological.
+    // Nodes are renumbered to the emitted group order.
+    size_t emitted = 0;
+    for (size_t b = 0; b < groups; b++) {
+        size_t g = by_level[b];
+        size_t level = levels[g];
+        size_t begin = group_offsets[g];
+        size_t count = group_offsets[g + 1] - begin;
+        NexusExecutionGroup* group = (NexusExecutionGroup*)calloc(1, sizeof(NexusExecutionGroup));
+        const char** ids = (const char**)malloc(count * sizeof(const char*));
+        if (!group || !ids) {
+            free(group);
+            free(ids);
+            mps_free_execution_groups(resolved, emitted);
+            free(by_level);
+            free(levels);
+            free(node_order);
+            free(group_offsets);
+            return NEXUS_OUT_OF_MEMORY;
+        }
+
+        bool forward_only = true;
+        for (size_t i = 0; i < count; i++) {
+            NexusMPSDependencyNode* node = &graph->nodes[node_order[begin + i]];
+            ids[i] = node->component_id;
+            node->component_group = (int)emitted;
+            for (size_t e = 0; e < node->incoming_count; e++) {
+                if (graph->edges[node->incoming_edges[e]].direction != NEXUS_DIRECTION_FORWARD) {
+                    forward_only = false;
+                }
+            }
+        }
+
+        group->component_ids = ids;
+        group->component_count = count;
+        group->has_cycles = group_has_cycles(graph, &node_order[begin], count);
+        group->is_forward_only = forward_only && !group->has_cycles;
+        group->level = level;
+        resolved[emitted++] = group;
+    }
+
+    free(by_level);
+    free(levels);
+    free(node_order);
+    free(group_offsets);
+
+    nexus_log(ctx, NEXUS_LOG_DEBUG, "Resolved %zu execution groups over %zu levels",
+             emitted, groups > 0 ? max_level + 1 : 0);
+
+    *execution_groups = resolved;
+    *group_count = emitted;
     return NEXUS_SUCCESS;
 }
 
 // Check for issues in graph that would prevent execution
 NexusResult mps_validate_dependency_graph(NexusContext* ctx, NexusMPSDependencyGraph* graph) {
-    // TODO: Implementation
-    return NEXUS_SUCCESS;
+    if (!ctx || !graph) {
+        return NEXUS_INVALID_PARAMETER;
+    }
+
+    size_t* node_order = NULL;
+    size_t* group_offsets = NULL;
+    size_t groups = 0;
+    NexusResult result = mps_find_strongly_connected_components(ctx, graph, &node_order, &group_offsets, &groups);
+    if (result != NEXUS_SUCCESS) {
+        return result;
+    }
+
+    bool allow_cycles = graph->config && graph->config->allow_cycles;
+    for (size_t g = 0; g < groups && result == NEXUS_SUCCESS; g++) {
+        size_t begin = group_offsets[g];
+        size_t count = group_offsets[g + 1] - begin;
+        if (!group_has_cycles(graph, &node_order[begin], count)) {
+            continue;
+        }
+
+        if (!allow_cycles) {
+            nexus_log(ctx, NEXUS_LOG_ERROR, "Cycle through component '%s' but cycles are not allowed",
+                     graph->nodes[node_order[begin]].component_id);
+            result = NEXUS_DEPENDENCY_CYCLE;
+            break;
+        }
+
+        // Components in a cycle run once per iteration
+        for (size_t i = begin; i < begin + count; i++) {
+            NexusMPSDependencyNode* node = &graph->nodes[node_order[i]];
+            if (!node->supports_reentrance) {
+                nexus_log(ctx, NEXUS_LOG_ERROR, "Component '%s' is part of a cycle but does not support reentrance",
+                         node->component_id);
+                result = NEXUS_INVALID_CONFIGURATION;
+                break;
+            }
+        }
+    }
+
+    free(node_order);
+    free(group_offsets);
+    return result;
 }
 
 // Free dependency graph resources
 void mps_free_dependency_graph(NexusMPSDependencyGraph* graph) {
-    // TODO: Implementation
+    if (!graph) {
+        return;
+    }
+
+    if (graph->nodes) {
+        for (size_t i = 0; i < graph->node_count; i++) {
+            free(graph->nodes[i].incoming_edges);
+            free(graph->nodes[i].outgoing_edges);
+        }
+        free(graph->nodes);
+    }
+
+    free(graph->edges);
+    free(graph);
 }
 
 // Free execution group resources
 void mps_free_execution_groups(NexusExecutionGroup** groups, size_t group_count) {
-    // TODO: Implementation
+    if (!groups) {
+        return;
+    }
+
+    // Component IDs belong to the pipeline configuration
+    for (size_t i = 0; i < group_count; i++) {
+        if (groups[i]) {
+            free(groups[i]->component_ids);
+            free(groups[i]);
+        }
+    }
+    free(groups);
 }
@@ -13,82 +13,291 @@
  #include "nlink/core/common/nexus_core.h"
  #include <string.h>
  #include <stdlib.h>
+ #include <stdio.h>
+ #include <time.h>
+ 
+ // Internal structure for component lifecycle data
+ typedef struct {
+     NexusMPSComponentLifecycle lifecycle;
+     NexusMPSPipelineComponent* component;
+ } ComponentLifecycleData;
+ 
+ // Get the lifecycle data for a component
+ static ComponentLifecycleData* get_lifecycle_data(NexusMPSPipelineComponent* component) {
+     return component ? (ComponentLifecycleData*)component->component_state : NULL;
+ }
+ 
+ static double lifecycle_now_ms(void) {
+     struct timespec ts;
+     clock_gettime(CLOCK_MONOTONIC, &ts);
+     return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+ }
  
  // Register lifecycle hooks for a component
- NexusResult mps_register_component_lifecycle(NexusContext* ctx, 
+ NexusResult mps_register_component_lifecycle(NexusContext* ctx,
                                             NexusMPSPipelineComponent* component,
                                             NexusMPSComponentLifecycle* lifecycle) {
-     // TODO: Implementation
+     if (!ctx || !component || !lifecycle) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+ 
+     nexus_log(ctx, NEXUS_LOG_DEBUG, "Registering lifecycle hooks for component '%s'",
+              component->component_id);
+ 
+     ComponentLifecycleData* existing_data = get_lifecycle_data(component);
+     if (existing_data) {
+         existing_data->lifecycle = *lifecycle;
+         return NEXUS_SUCCESS;
+     }
+ 
+     ComponentLifecycleData* data = (ComponentLifecycleData*)malloc(sizeof(ComponentLifecycleData));
+     if (!data) {
+         nexus_log(ctx, NEXUS_LOG_ERROR, "Failed to allocate lifecycle data");
+         return NEXUS_OUT_OF_MEMORY;
+     }
+ 
+     data->lifecycle = *lifecycle;
+     data->component = component;
+ 
+     // Store in component state; freed with the pipeline
+     component->component_state = data;
+ 
      return NEXUS_SUCCESS;
  }
  
  // Call initialization hook for a component
  NexusResult mps_component_initialize(NexusContext* ctx, NexusMPSPipelineComponent* component) {
-     // TODO: Implementation
+     if (!ctx || !component) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+ 
+     if (component->is_initialized) {
+         nexus_log(ctx, NEXUS_LOG_WARNING, "Component '%s' already initialized",
+                  component->component_id);
+         return NEXUS_SUCCESS;
+     }
+ 
+     nexus_log(ctx, NEXUS_LOG_DEBUG, "Initializing component '%s'", component->component_id);
+ 
+     ComponentLifecycleData* data = get_lifecycle_data(component);
+     if (data && data->lifecycle.init_func) {
+         NexusResult result = data->lifecycle.init_func(component, data->lifecycle.user_data);
+         if (result != NEXUS_SUCCESS) {
+             nexus_log(ctx, NEXUS_LOG_ERROR, "Initialization failed for component '%s': %d",
+                      component->component_id, result);
+             return result;
+         }
+     }
+ 
+     component->is_initialized = true;
+     component->execution_count = 0;
+ 
      return NEXUS_SUCCESS;
  }
  
  // Call execution hook for a component
- NexusResult mps_component_execute(NexusContext* ctx, 
+ NexusResult mps_component_execute(NexusContext* ctx,
                                   NexusMPSPipelineComponent* component,
                                   NexusMPSDataStream* input,
                                   NexusMPSDataStream* output,
                                   int iteration) {
-     // TODO: Implementation
-     return NEXUS_SUCCESS;
+     if (!ctx || !component || !input || !output) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+ 
+     if (!component->is_initialized) {
+         nexus_log(ctx, NEXUS_LOG_ERROR, "Component '%s' not initialized", component->component_id);
+         return NEXUS_COMPONENT_NOT_INITIALIZED;
+     }
+ 
+     // The execution hook sees the iteration; otherwise use the plain processing function
+     ComponentLifecycleData* data = get_lifecycle_data(component);
+     double start = lifecycle_now_ms();
+     NexusResult result;
+ 
+     if (data && data->lifecycle.exec_func) {
+         result = data->lifecycle.exec_func(component, input, output, iteration, data->lifecycle.user_data);
+     } else if (component->process_func) {
+         result = component->process_func(component, input, output);
+     } else {
+         nexus_log(ctx, NEXUS_LOG_ERROR, "No processing function available for component '%s'",
+                  component->component_id);
+         return NEXUS_SYMBOL_NOT_FOUND;
+     }
+ 
+     component->last_execution_time_ms = lifecycle_now_ms() - start;
+     component->last_result = result;
+     component->execution_count++;
+ 
+     if (result != NEXUS_SUCCESS) {
+         nexus_log(ctx, NEXUS_LOG_ERROR, "Execution failed for component '%s' in iteration %d: %d",
+                  component->component_id, iteration, result);
+     }
+ 
+     return result;
  }
  
  // Call iteration end hook for a component
- NexusResult mps_component_end_iteration(NexusContext* ctx, 
+ NexusResult mps_component_end_iteration(NexusContext* ctx,
                                         NexusMPSPipelineComponent* component,
                                         int iteration) {
-     // TODO: Implementation
-     return NEXUS_SUCCESS;
+     if (!ctx || !component) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+ 
+     ComponentLifecycleData* data = get_lifecycle_data(component);
+     if (!data || !data->lifecycle.iter_end_func) {
+         return NEXUS_SUCCESS;
+     }
+ 
+     NexusResult result = data->lifecycle.iter_end_func(component, iteration, data->lifecycle.user_data);
+     if (result != NEXUS_SUCCESS) {
+         nexus_log(ctx, NEXUS_LOG_ERROR, "Iteration end failed for component '%s' in iteration %d: %d",
+                  component->component_id, iteration, result);
+     }
+ 
+     return result;
  }
  
  // Call termination hook for a component
  NexusResult mps_component_terminate(NexusContext* ctx, NexusMPSPipelineComponent* component) {
-     // TODO: Implementation
+     if (!ctx || !component) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+ 
+     if (!component->is_initialized) {
+         nexus_log(ctx, NEXUS_LOG_WARNING, "Component '%s' not initialized", component->component_id);
+         return NEXUS_SUCCESS;
+     }
+ 
+     nexus_log(ctx, NEXUS_LOG_DEBUG, "Terminating component '%s'", component->component_id);
+ 
+     ComponentLifecycleData* data = get_lifecycle_data(component);
+     if (data && data->lifecycle.term_func) {
+         NexusResult result = data->lifecycle.term_func(component, data->lifecycle.user_data);
+         if (result != NEXUS_SUCCESS) {
+             nexus_log(ctx, NEXUS_LOG_ERROR, "Termination failed for component '%s': %d",
+                      component->component_id, result);
+             return result;
+         }
+     }
+ 
+     component->is_initialized = false;
+ 
      return NEXUS_SUCCESS;
  }
  
  // Call abort hook for a component
  NexusResult mps_component_abort(NexusContext* ctx, NexusMPSPipelineComponent* component) {
-     // TODO: Implementation
+     if (!ctx || !component) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+ 
+     if (!component->is_initialized) {
+         nexus_log(ctx, NEXUS_LOG_WARNING, "Component '%s' not initialized", component->component_id);
+         return NEXUS_SUCCESS;
+     }
+ 
+     nexus_log(ctx, NEXUS_LOG_DEBUG, "Aborting component '%s'", component->component_id);
+ 
+     // Fall back to the termination hook if no abort hook is registered
+     ComponentLifecycleData* data = get_lifecycle_data(component);
+     NexusMPSComponentTermFunc hook = NULL;
+     if (data) {
+         hook = data->lifecycle.abort_func ? data->lifecycle.abort_func : data->lifecycle.term_func;
+     }
+ 
+     if (hook) {
+         NexusResult result = hook(component, data->lifecycle.user_data);
+         if (result != NEXUS_SUCCESS) {
+             nexus_log(ctx, NEXUS_LOG_ERROR, "Abort failed for component '%s': %d",
+                      component->component_id, result);
+             return result;
+         }
+     }
+ 
+     component->is_initialized = false;
+ 
      return NEXUS_SUCCESS;
  }
  
  // Handle error during pipeline execution
- NexusResult mps_handle_pipeline_error(NexusContext* ctx, 
+ NexusResult mps_handle_pipeline_error(NexusContext* ctx,
                                       NexusMPSPipeline* pipeline,
                                       NexusResult error,
                                       const char* component_id,
                                       int iteration) {
-     // TODO: Implementation
-     return NEXUS_SUCCESS;
+     if (!ctx || !pipeline) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+ 
+     nexus_log(ctx, NEXUS_LOG_ERROR, "Pipeline error: component '%s' failed with result %d in iteration %d",
+              component_id ? component_id : "unknown", error, iteration);
+ 
+     char message[256];
+     snprintf(message, sizeof(message), "Component '%s' failed with result %d in iteration %d",
+             component_id ? component_id : "unknown", error, iteration);
+ 
+     if (pipeline->error_handler) {
+         pipeline->error_handler(pipeline, error, component_id, message);
+     }
+ 
+     return error;
  }
  
  // Save component state for resuming later
  NexusResult mps_component_save_state(NexusContext* ctx,
                                      NexusMPSPipelineComponent* component,
                                      const char* state_path) {
-     // TODO: Implementation
-     return NEXUS_SUCCESS;
+     if (!ctx || !component || !state_path) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+ 
+     ComponentLifecycleData* data = get_lifecycle_data(component);
+     if (!data || !data->lifecycle.save_state_func) {
+         nexus_log(ctx, NEXUS_LOG_DEBUG, "Component '%s' has no state to save", component->component_id);
+         return NEXUS_SUCCESS;
+     }
+ 
+     return data->lifecycle.save_state_func(component, state_path, data->lifecycle.user_data);
  }
  
  // Load component state for resuming
  NexusResult mps_component_load_state(NexusContext* ctx,
                                      NexusMPSPipelineComponent* component,
                                      const char* state_path) {
-     // TODO: Implementation
-     return NEXUS_SUCCESS;
+     if (!ctx || !component || !state_path) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+ 
+     ComponentLifecycleData* data = get_lifecycle_data(component);
+     if (!data || !data->lifecycle.load_state_func) {
+         nexus_log(ctx, NEXUS_LOG_DEBUG, "Component '%s' has no state to load", component->component_id);
+         return NEXUS_SUCCESS;
+     }
+ 
+     return data->lifecycle.load_state_func(component, state_path, data->lifecycle.user_data);
  }
  
  // Create a pipeline checkpoint (all component states)
  NexusResult mps_pipeline_create_checkpoint(NexusContext* ctx,
                                            NexusMPSPipeline* pipeline,
                                            const char* checkpoint_dir) {
-     // TODO: Implementation
+     if (!ctx || !pipeline || !checkpoint_dir) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+ 
+     char path[512];
+     for (size_t i = 0; i < pipeline->component_count; i++) {
+         NexusMPSPipelineComponent* component = pipeline->components[i];
+         snprintf(path, sizeof(path), "%s/%s.state", checkpoint_dir, component->component_id);
+ 
+         NexusResult result = mps_component_save_state(ctx, component, path);
+         if (result != NEXUS_SUCCESS) {
+             return result;
+         }
+     }
+ 
      return NEXUS_SUCCESS;
  }
  
@@ -96,7 +305,20 @@
  NexusResult mps_pipeline_restore_checkpoint(NexusContext* ctx,
                                             NexusMPSPipeline* pipeline,
                                             const char* checkpoint_dir) {
-     // TODO: Implementation
+     if (!ctx || !pipeline || !checkpoint_dir) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+ 
+     char path[512];
+     for (size_t i = 0; i < pipeline->component_count; i++) {
+         NexusMPSPipelineComponent* component = pipeline->components[i];
+         snprintf(path, sizeof(path), "%s/%s.state", checkpoint_dir, component->component_id);
+ 
+         NexusResult result = mps_component_load_state(ctx, component, path);
+         if (result != NEXUS_SUCCESS) {
+             return result;
+         }
+     }
+ 
      return NEXUS_SUCCESS;
  }
- 
\ No newline at end of file
@@ -14,33 +14,700 @@
 #include "nlink/mpsystem/mps_lifecycle.h"
 #include "nlink/core/common/nexus_core.h"
 #include "nlink/core/common/nexus_loader.h"
+#include "nlink/core/threading/thread_pool.h"
 #include <string.h>
 #include <stdlib.h>
+#include <stdio.h>
+#include <stdatomic.h>
+#include <time.h>
+
+// Result of running one execution group
+typedef struct MPSGroupOutcome {
+    NexusResult result;             // First failure, or NEXUS_SUCCESS
+    const char* failed_component;   // Component that failed
+    int iterations;                 // Passes over the group
+    int executions;                 // Component executions
+    int skipped;                    // Executions the worklist skipped
+} MPSGroupOutcome;
+
+// Level schedule, built when the pipeline is created
+typedef struct MPSExecutionState {
+    size_t** group_members;         // Component indices of each group, in node order
+    size_t* map_index;              // Per component, its index in the pipeline's stream map
+    size_t* level_offsets;          // Groups [level_offsets[l], level_offsets[l + 1]) form level l
+    size_t level_count;
+    size_t* group_of;               // Per component, its group index
+    size_t* source_offsets;         // Per component, start of its slice in sources (component_count + 1)
+    size_t* sources;                // Components feeding each component, grouped by target
+    int* changed_pass;              // Per component, last pass of its group that changed its output
+    int* ran_pass;                  // Per component, last pass of its group it ran in
+    MPSGroupOutcome* outcomes;      // One per group, written by whoever runs it
+    NexusMPSDataStream* input;      // Pipeline input of the current execution
+
+    // Current parallel level; the calling thread takes part in every level
+    NexusContext* ctx;
+    size_t level_end;
+    atomic_size_t next_group;
+} MPSExecutionState;
+
+// Forward declarations for internal functions
+static NexusResult build_execution_state(NexusContext* ctx, NexusMPSPipeline* pipeline);
+static void destroy_execution_state(NexusMPSPipeline* pipeline);
+
+static double pipeline_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+// Find a component's index (equal to its node index in the dependency graph)
+static size_t find_component_index(const NexusMPSPipeline* pipeline, const char* component_id) {
+    for (size_t i = 0; i < pipeline->component_count; i++) {
+        if (strcmp(pipeline->components[i]->component_id, component_id) == 0) {
+            return i;
+        }
+    }
+    return pipeline->component_count;
+}
 
 // Create a new multi-pass pipeline from configuration
 NexusMPSPipeline* mps_pipeline_create(NexusContext* ctx, NexusMPSConfig* config) {
-    // TODO: Implementation
-    return NULL;
+    if (!ctx || !config) {
+        return NULL;
+    }
+
+    if (mps_validate_pipeline_config(ctx, config) != NEXUS_SUCCESS) {
+        nexus_log(ctx, NEXUS_LOG_ERROR, "Invalid multi-pass pipeline configuration");
+        return NULL;
+    }
+
+    NexusMPSPipeline* pipeline = (NexusMPSPipeline*)calloc(1, sizeof(NexusMPSPipeline));
+    if (!pipeline) {
+        return NULL;
+    }
+
+    pipeline->pipeline_id = config->pipeline_id;
+    pipeline->config = config;
+    pipeline->max_iterations = config->max_iteration_count;
+
+    // Condense the dependency graph into execution groups
+    pipeline->graph = mps_create_dependency_graph(ctx, config);
+    if (!pipeline->graph ||
+        mps_validate_dependency_graph(ctx, pipeline->graph) != NEXUS_SUCCESS ||
+        mps_resolve_bidirectional_dependencies(ctx, pipeline->graph, &pipeline->groups,
+                                               &pipeline->group_count) != NEXUS_SUCCESS) {
+        mps_pipeline_destroy(ctx, pipeline);
+        return NULL;
+    }
+
+    // One component per configured component, each with its own output stream
+    pipeline->components = (NexusMPSPipelineComponent**)calloc(config->component_count + 1,
+                                                               sizeof(NexusMPSPipelineComponent*));
+    if (!pipeline->components) {
+        mps_pipeline_destroy(ctx, pipeline);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < config->component_count; i++) {
+        NexusMPSComponentConfig* comp_config = config->components[i];
+        NexusMPSPipelineComponent* component = (NexusMPSPipelineComponent*)calloc(1, sizeof(NexusMPSPipelineComponent));
+        if (!component) {
+            mps_pipeline_destroy(ctx, pipeline);
+            return NULL;
+        }
+        pipeline->components[pipeline->component_count++] = component;
+
+        component->component_id = comp_config->component_id;
+        component->supports_reentrance = comp_config->supports_reentrance;
+        component->max_passes = comp_config->max_passes;
+        component->last_result = NEXUS_SUCCESS;
+        component->input = mps_stream_create(0);
+        component->output = mps_stream_create_double_buffered(0);
+        if (!component->input || !component->output) {
+            mps_pipeline_destroy(ctx, pipeline);
+            return NULL;
+        }
+    }
+
+    // Every edge carries its source's output
+    pipeline->streams = mps_stream_map_create(pipeline->graph->edge_count);
+    if (!pipeline->streams) {
+        mps_pipeline_destroy(ctx, pipeline);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < pipeline->graph->edge_count; i++) {
+        const NexusMPSDependencyEdge* edge = &pipeline->graph->edges[i];
+        NexusMPSPipelineComponent* source = pipeline->components[edge->source_idx];
+        NexusMPSPipelineComponent* target = pipeline->components[edge->target_idx];
+        if (mps_stream_map_add(pipeline->streams, source->component_id, target->component_id,
+                               source->output) != NEXUS_SUCCESS) {
+            mps_pipeline_destroy(ctx, pipeline);
+            return NULL;
+        }
+    }
+
+    // Index once so that workers only ever read the map
+    if (mps_stream_map_build_index(pipeline->streams) != NEXUS_SUCCESS ||
+        build_execution_state(ctx, pipeline) != NEXUS_SUCCESS) {
+        mps_pipeline_destroy(ctx, pipeline);
+        return NULL;
+    }
+
+    pipeline->stats.component_count = (int)pipeline->component_count;
+    for (size_t g = 0; g < pipeline->group_count; g++) {
+        if (pipeline->groups[g]->has_cycles) {
+            pipeline->stats.cycle_count++;
+        }
+        if ((int)pipeline->groups[g]->component_count > pipeline->stats.max_group_size) {
+            pipeline->stats.max_group_size = (int)pipeline->groups[g]->component_count;
+        }
+    }
+
+    nexus_log(ctx, NEXUS_LOG_INFO,
+             "Created multi-pass pipeline '%s' with %zu components in %zu groups over %zu levels",
+             pipeline->pipeline_id ? pipeline->pipeline_id : "unnamed", pipeline->component_count,
+             pipeline->group_count, pipeline->execution_state->level_count);
+
+    return pipeline;
+}
+
+// Resolve group members and the level schedule
+static NexusResult build_execution_state(NexusContext* ctx, NexusMPSPipeline* pipeline) {
+    MPSExecutionState* state = (MPSExecutionState*)calloc(1, sizeof(MPSExecutionState));
+    if (!state) {
+        return NEXUS_OUT_OF_MEMORY;
+    }
+    pipeline->execution_state = state;
+
+    size_t groups = pipeline->group_count;
+    state->group_members = (size_t**)calloc(groups + 1, sizeof(size_t*));
+    state->map_index = (size_t*)malloc((pipeline->component_count + 1) * sizeof(size_t));
+    state->outcomes = (MPSGroupOutcome*)calloc(groups + 1, sizeof(MPSGroupOutcome));
+    state->level_offsets = (size_t*)calloc(groups + 2, sizeof(size_t));
+    if (!state->group_members || !state->map_index || !state->outcomes || !state->level_offsets) {
+        return NEXUS_OUT_OF_MEMORY;
+    }
+
+    // Sources of every component, for the worklist
+    size_t components = pipeline->component_count;
+    const NexusMPSDependencyGraph* graph = pipeline->graph;
+    state->group_of = (size_t*)calloc(components + 1, sizeof(size_t));
+    state->source_offsets = (size_t*)calloc(components + 2, sizeof(size_t));
+    state->sources = (size_t*)malloc((graph->edge_count + 1) * sizeof(size_t));
+    state->changed_pass = (int*)calloc(components + 1, sizeof(int));
+    state->ran_pass = (int*)calloc(components + 1, sizeof(int));
+    if (!state->group_of || !state->source_offsets || !state->sources ||
+        !state->changed_pass || !state->ran_pass) {
+        return NEXUS_OUT_OF_MEMORY;
+    }
+
+    for (size_t e = 0; e < graph->edge_count; e++) {
+        state->source_offsets[graph->edges[e].target_idx + 2]++;
+    }
+    for (size_t i = 0; i < components; i++) {
+        state->source_offsets[i + 2] += state->source_offsets[i + 1];
+    }
+    for (size_t e = 0; e < graph->edge_count; e++) {
+        state->sources[state->source_offsets[graph->edges[e].target_idx + 1]++] = graph->edges[e].source_idx;
+    }
+
+    for (size_t i = 0; i < pipeline->component_count; i++) {
+        state->map_index[i] = mps_stream_map_component_index(pipeline->streams,
+                                                             pipeline->components[i]->component_id);
+    }
+
+    for (size_t g = 0; g < groups; g++) {
+        NexusExecutionGroup* group = pipeline->groups[g];
+        state->group_members[g] = (size_t*)malloc((group->component_count + 1) * sizeof(size_t));
+        if (!state->group_members[g]) {
+            return NEXUS_OUT_OF_MEMORY;
+        }
+
+        for (size_t i = 0; i < group->component_count; i++) {
+            size_t index = find_component_index(pipeline, group->component_ids[i]);
+            if (index == pipeline->component_count) {
+                nexus_log(ctx, NEXUS_LOG_ERROR, "Execution group refers to unknown component '%s'",
+                         group->component_ids[i]);
+                return NEXUS_NOT_FOUND;
+            }
+            state->group_members[g][i] = index;
+            state->group_of[index] = g;
+        }
+    }
+
+    // Groups arrive sorted by level
+    for (size_t g = 0; g < groups; g++) {
+        if (g == 0 || pipeline->groups[g]->level != pipeline->groups[g - 1]->level) {
+            state->level_offsets[state->level_count++] = g;
+        }
+    }
+    state->level_offsets[state->level_count] = groups;
+
+    return NEXUS_SUCCESS;
+}
+
+// Load a component library and resolve its processing function
+static NexusResult load_component(NexusContext* ctx,
+                                  NexusMPSPipelineComponent* component,
+                                  bool optional) {
+    char path[256];
+    snprintf(path, sizeof(path), "components/%s/lib%s.so",
+            component->component_id, component->component_id);
+
+    component->component = nexus_load_component(ctx, path, component->component_id);
+    if (!component->component) {
+        if (optional) {
+            nexus_log(ctx, NEXUS_LOG_WARNING, "Optional component '%s' could not be loaded",
+                     component->component_id);
+            return NEXUS_SUCCESS;
+        }
+        nexus_log(ctx, NEXUS_LOG_ERROR, "Failed to load component '%s'", component->component_id);
+        return NEXUS_COMPONENT_LOAD_FAILED;
+    }
+
+    char process_symbol[256];
+    snprintf(process_symbol, sizeof(process_symbol), "%s_process", component->component_id);
+    component->process_func = (NexusMPSProcessFunc)nexus_resolve_component_symbol(
+        ctx, component->component, process_symbol
+    );
+
+    if (!component->process_func && !optional) {
+        nexus_log(ctx, NEXUS_LOG_ERROR, "Failed to resolve processing function for component '%s'",
+                 component->component_id);
+        return NEXUS_SYMBOL_NOT_FOUND;
+    }
+
+    return NEXUS_SUCCESS;
 }
 
 // Initialize all components in the multi-pass pipeline
 NexusResult mps_pipeline_initialize(NexusContext* ctx, NexusMPSPipeline* pipeline) {
-    // TODO: Implementation
+    if (!ctx || !pipeline) {
+        return NEXUS_INVALID_PARAMETER;
+    }
+
+    if (pipeline->is_initialized) {
+        return NEXUS_SUCCESS;
+    }
+
+    for (size_t i = 0; i < pipeline->component_count; i++) {
+        NexusMPSPipelineComponent* component = pipeline->components[i];
+        bool optional = pipeline->config->components[i]->optional;
+
+        // Components may be supplied in-process with a processing function already set
+        if (!component->component && !component->process_func) {
+            NexusResult result = load_component(ctx, component, optional);
+            if (result != NEXUS_SUCCESS) {
+                return result;
+            }
+
+            // An optional component that did not load stays uninitialized
+            // and is passed through at execution time
+            if (!component->process_func) {
+                continue;
+            }
+        }
+
+        if (!component->is_initialized) {
+            NexusResult result = mps_component_initialize(ctx, component);
+            if (result != NEXUS_SUCCESS && !optional) {
+                return result;
+            }
+        }
+    }
+
+    pipeline->is_initialized = true;
     return NEXUS_SUCCESS;
 }
 
+// Run one component: gather the published outputs feeding it, then write
+// a new pass into its output
+static NexusResult run_component(NexusContext* ctx,
+                                 NexusMPSPipeline* pipeline,
+                                 size_t component_index,
+                                 NexusMPSDataStreamMap* streams,
+                                 int iteration) {
+    MPSExecutionState* state = pipeline->execution_state;
+    NexusMPSPipelineComponent* component = pipeline->components[component_index];
+
+    // The cached index is only valid for the pipeline's own map
+    size_t map_index = streams == pipeline->streams
+        ? state->map_index[component_index]
+        : mps_stream_map_component_index(streams, component->component_id);
+
+    MPSStreamMapEntry* const* incoming = NULL;
+    size_t incoming_count = mps_stream_map_incoming(streams, map_index, &incoming);
+
+    // Sources read the pipeline input; a single connection is read in
+    // place; several are concatenated in connection order
+    NexusResult result = NEXUS_SUCCESS;
+    NexusMPSDataStream view;
+    NexusMPSDataStream* input = &view;
+    if (incoming_count == 0) {
+        mps_stream_view_published(state->input, &view);
+    } else if (incoming_count == 1) {
+        mps_stream_view_published(incoming[0]->stream, &view);
+    } else {
+        input = component->input;
+        mps_stream_clear(input);
+        for (size_t i = 0; i < incoming_count && result == NEXUS_SUCCESS; i++) {
+            mps_stream_view_published(incoming[i]->stream, &view);
+            if (view.size > 0) {
+                result = mps_stream_write(input, view.data, view.size);
+            }
+        }
+        input->position = 0;
+    }
+
+    if (result != NEXUS_SUCCESS) {
+        return result;
+    }
+
+    mps_stream_clear(component->output);
+
+    // Skipped optional components hand their input on unchanged, as SPS does
+    if (!component->is_initialized && pipeline->config->components[component_index]->optional) {
+        return input->size > 0 ? mps_stream_write(component->output, input->data, input->size)
+                               : NEXUS_SUCCESS;
+    }
+
+    return mps_component_execute(ctx, component, input, component->output, iteration);
+}
+
+// Whether a member of a cyclic group has to run again: some member feeding
+// it published a changed output in the previous pass. Sources outside the
+// group do not change while the group iterates.
+static bool member_inputs_changed(const MPSExecutionState* state,
+                                  size_t component_index,
+                                  size_t group_index,
+                                  int iteration) {
+    for (size_t s = state->source_offsets[component_index];
+         s < state->source_offsets[component_index + 1]; s++) {
+        size_t source = state->sources[s];
+        if (state->group_of[source] == group_index && state->changed_pass[source] == iteration - 1) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Run a group: once if acyclic, otherwise passes to a fixed point. Within
+// a pass every member reads what the others published in the pass before.
+static NexusResult run_group(NexusContext* ctx,
+                             NexusMPSPipeline* pipeline,
+                             size_t group_index,
+                             NexusMPSDataStreamMap* streams,
+                             MPSGroupOutcome* outcome) {
+    NexusExecutionGroup* group = pipeline->groups[group_index];
+    MPSExecutionState* state = pipeline->execution_state;
+    const size_t* members = state->group_members[group_index];
+    NexusMPSPipelineComponent** components = pipeline->components;
+
+    // Source lists describe the pipeline's own connections only
+    bool worklist = pipeline->enable_worklist && group->has_cycles && streams == pipeline->streams;
+
+    memset(outcome, 0, sizeof(*outcome));
+    outcome->result = NEXUS_SUCCESS;
+
+    // A cycle starts from empty outputs, not from the previous execution
+    if (group->has_cycles) {
+        for (size_t i = 0; i < group->component_count; i++) {
+            mps_stream_clear(components[members[i]]->output);
+            mps_stream_publish(components[members[i]]->output);
+            state->changed_pass[members[i]] = -1;
+            state->ran_pass[members[i]] = -1;
+        }
+    }
+
+    for (int iteration = 0; ; iteration++) {
+        if (group->has_cycles) {
+            if (pipeline->max_iterations > 0 && iteration >= pipeline->max_iterations) {
+                nexus_log(ctx, NEXUS_LOG_WARNING,
+                         "Group of '%s' did not converge within %d iterations",
+                         components[members[0]]->component_id, pipeline->max_iterations);
+                break;
+            }
+
+            bool pass_limit = false;
+            for (size_t i = 0; i < group->component_count; i++) {
+                NexusMPSPipelineComponent* component = components[members[i]];
+                if (component->max_passes > 0 && iteration >= component->max_passes) {
+                    nexus_log(ctx, NEXUS_LOG_WARNING,
+                             "Component '%s' reached its limit of %d passes before converging",
+                             component->component_id, component->max_passes);
+                    pass_limit = true;
+                    break;
+                }
+            }
+            if (pass_limit) {
+                break;
+            }
+        }
+
+        for (size_t i = 0; i < group->component_count; i++) {
+            if (worklist && iteration > 0 &&
+                !member_inputs_changed(state, members[i], group_index, iteration)) {
+                outcome->skipped++;
+                continue;
+            }
+
+            NexusResult result = run_component(ctx, pipeline, members[i], streams, iteration);
+            outcome->executions++;
+            state->ran_pass[members[i]] = iteration;
+            if (result != NEXUS_SUCCESS) {
+                outcome->result = result;
+                outcome->failed_component = components[members[i]]->component_id;
+                outcome->iterations = iteration + 1;
+                return result;
+            }
+        }
+
+        // Fixed point: no member would change what its readers see. A
+        // skipped member keeps its published output.
+        bool converged = iteration > 0;
+        for (size_t i = 0; i < group->component_count; i++) {
+            if (worklist && state->ran_pass[members[i]] != iteration) {
+                continue;
+            }
+
+            NexusMPSDataStream* output = components[members[i]]->output;
+            if ((converged || worklist) && !mps_stream_is_unchanged(output)) {
+                converged = false;
+                state->changed_pass[members[i]] = iteration;
+            }
+            mps_stream_publish(output);
+        }
+
+        for (size_t i = 0; i < group->component_count; i++) {
+            if (worklist && state->ran_pass[members[i]] != iteration) {
+                continue;
+            }
+
+            NexusResult result = mps_component_end_iteration(ctx, components[members[i]], iteration);
+            if (result != NEXUS_SUCCESS) {
+                outcome->result = result;
+                outcome->failed_component = components[members[i]]->component_id;
+                outcome->iterations = iteration + 1;
+                return result;
+            }
+        }
+
+        outcome->iterations = iteration + 1;
+        if (!group->has_cycles || converged) {
+            break;
+        }
+    }
+
+    return NEXUS_SUCCESS;
+}
+
+// Run the groups of the current level until none are left
+static void run_level_groups(NexusMPSPipeline* pipeline) {
+    MPSExecutionState* state = pipeline->execution_state;
+    for (;;) {
+        size_t g = atomic_fetch_add_explicit(&state->next_group, 1, memory_order_relaxed);
+        if (g >= state->level_end) {
+            break;
+        }
+        run_group(state->ctx, pipeline, g, pipeline->streams, &state->outcomes[g]);
+    }
+}
+
+// Pool task: joins the caller on the current level
+static void level_task(void* arg) {
+    run_level_groups((NexusMPSPipeline*)arg);
+}
+
+// Shared-pool tasks that join the caller on a level of the given width
+static size_t level_helpers(const NexusMPSPipeline* pipeline, const nlink_thread_pool_t* pool,
+                            size_t width) {
+    size_t helpers = nlink_thread_pool_worker_count(pool);
+    if (pipeline->worker_count > 0 && pipeline->worker_count - 1 < helpers) {
+        helpers = pipeline->worker_count - 1;
+    }
+    return helpers < width - 1 ? helpers : width - 1;
+}
+
+// Run one level, spreading its groups over the shared pool if it has several
+static void run_level(NexusContext* ctx, NexusMPSPipeline* pipeline, size_t level) {
+    MPSExecutionState* state = pipeline->execution_state;
+    size_t begin = state->level_offsets[level];
+    size_t end = state->level_offsets[level + 1];
+
+    nlink_thread_pool_t* pool = NULL;
+    size_t helpers = 0;
+    if (end - begin > 1 && pipeline->worker_count != 1) {
+        pool = nlink_thread_pool_shared();
+        helpers = pool ? level_helpers(pipeline, pool, end - begin) : 0;
+    }
+
+    if (helpers == 0) {
+        for (size_t g = begin; g < end; g++) {
+            run_group(ctx, pipeline, g, pipeline->streams, &state->outcomes[g]);
+        }
+        return;
+    }
+
+    // Helpers and the caller take groups until none are left
+    state->ctx = ctx;
+    state->level_end = end;
+    atomic_store_explicit(&state->next_group, begin, memory_order_relaxed);
+
+    nlink_task_group_t tasks;
+    nlink_task_group_init(&tasks);
+    for (size_t i = 0; i < helpers; i++) {
+        nlink_thread_pool_submit(pool, level_task, pipeline, &tasks);
+    }
+    run_level_groups(pipeline);
+    nlink_thread_pool_wait(pool, &tasks);
+}
+
+// Add a group's counts to the pipeline statistics
+static void merge_outcome(NexusMPSPipeline* pipeline, const MPSGroupOutcome* outcome, bool cyclic) {
+    pipeline->stats.total_iterations += outcome->iterations;
+    pipeline->stats.total_component_executions += outcome->executions;
+    pipeline->stats.skipped_component_executions += outcome->skipped;
+    if (cyclic && outcome->iterations > pipeline->current_iteration) {
+        pipeline->current_iteration = outcome->iterations;
+    }
+}
+
 // Execute the multi-pass pipeline with input data
-NexusResult mps_pipeline_execute(NexusContext* ctx, 
-                               NexusMPSPipeline* pipeline, 
-                               NexusMPSDataStream* input, 
+NexusResult mps_pipeline_execute(NexusContext* ctx,
+                               NexusMPSPipeline* pipeline,
+                               NexusMPSDataStream* input,
                                NexusMPSDataStream* output) {
-    // TODO: Implementation
-    return NEXUS_SUCCESS;
+    if (!ctx || !pipeline) {
+        return NEXUS_INVALID_PARAMETER;
+    }
+
+    if (!pipeline->is_initialized) {
+        NexusResult result = mps_pipeline_initialize(ctx, pipeline);
+        if (result != NEXUS_SUCCESS) {
+            return result;
+        }
+    }
+
+    MPSExecutionState* state = pipeline->execution_state;
+    double start = pipeline_now_ms();
+    state->input = input;
+    pipeline->current_iteration = 1;
+
+    NexusResult final_result = NEXUS_SUCCESS;
+    for (size_t level = 0; level < state->level_count; level++) {
+        run_level(ctx, pipeline, level);
+
+        // Groups of a level are merged and reported in group order
+        bool failed = false;
+        for (size_t g = state->level_offsets[level]; g < state->level_offsets[level + 1]; g++) {
+            MPSGroupOutcome* outcome = &state->outcomes[g];
+            merge_outcome(pipeline, outcome, pipeline->groups[g]->has_cycles);
+
+            if (outcome->result != NEXUS_SUCCESS) {
+                mps_handle_pipeline_error(ctx, pipeline, outcome->result,
+                                          outcome->failed_component, outcome->iterations - 1);
+                if (final_result == NEXUS_SUCCESS) {
+                    final_result = outcome->result;
+                }
+                failed = true;
+            }
+        }
+
+        if (failed && !pipeline->config->allow_partial_processing) {
+            break;
+        }
+    }
+
+    state->input = NULL;
+
+    // Components without outgoing connections are the pipeline's outputs
+    if (output && (final_result == NEXUS_SUCCESS || pipeline->config->allow_partial_processing)) {
+        for (size_t g = 0; g < pipeline->group_count; g++) {
+            for (size_t i = 0; i < pipeline->groups[g]->component_count; i++) {
+                size_t index = state->group_members[g][i];
+                NexusMPSDataStream result_stream;
+                mps_stream_view_published(pipeline->components[index]->output, &result_stream);
+                if (pipeline->graph->nodes[index].outgoing_count == 0 && result_stream.size > 0) {
+                    NexusResult result = mps_stream_write(output, result_stream.data, result_stream.size);
+                    if (result != NEXUS_SUCCESS && final_result == NEXUS_SUCCESS) {
+                        final_result = result;
+                    }
+                }
+            }
+        }
+    }
+
+    pipeline->stats.total_execution_time_ms += pipeline_now_ms() - start;
+    if (pipeline->stats.total_iterations > 0) {
+        pipeline->stats.avg_iteration_time_ms =
+            pipeline->stats.total_execution_time_ms / pipeline->stats.total_iterations;
+    }
+
+    return final_result;
+}
+
+// Free the level schedule
+static void destroy_execution_state(NexusMPSPipeline* pipeline) {
+    MPSExecutionState* state = pipeline->execution_state;
+    if (!state) {
+        return;
+    }
+
+    if (state->group_members) {
+        for (size_t g = 0; g < pipeline->group_count; g++) {
+            free(state->group_members[g]);
+        }
+        free(state->group_members);
+    }
+    free(state->map_index);
+    free(state->group_of);
+    free(state->source_offsets);
+    free(state->sources);
+    free(state->changed_pass);
+    free(state->ran_pass);
+    free(state->outcomes);
+    free(state->level_offsets);
+    free(state);
+    pipeline->execution_state = NULL;
 }
 
 // Clean up multi-pass pipeline resources
 void mps_pipeline_destroy(NexusContext* ctx, NexusMPSPipeline* pipeline) {
-    // TODO: Implementation
+    if (!ctx || !pipeline) {
+        return;
+    }
+
+    nexus_log(ctx, NEXUS_LOG_INFO, "Destroying multi-pass pipeline '%s'",
+             pipeline->pipeline_id ? pipeline->pipeline_id : "unnamed");
+
+    destroy_execution_state(pipeline);
+
+    if (pipeline->components) {
+        for (size_t i = 0; i < pipeline->component_count; i++) {
+            NexusMPSPipelineComponent* component = pipeline->components[i];
+            if (component->is_initialized) {
+                mps_component_terminate(ctx, component);
+            }
+            if (component->component) {
+                nexus_unload_component(ctx, component->component);
+            }
+
+            // Lifecycle hooks registered with mps_register_component_lifecycle
+            free(component->component_state);
+            mps_stream_destroy(component->input);
+            mps_stream_destroy(component->output);
+            free(component);
+        }
+        free(pipeline->components);
+    }
+
+    mps_stream_map_destroy(pipeline->streams);
+    mps_free_execution_groups(pipeline->groups, pipeline->group_count);
+    mps_free_dependency_graph(pipeline->graph);
+
+    // Note: We don't free pipeline->config since it's owned by the caller
+    free(pipeline);
 }
 
 // Execute a specific component group in the pipeline
@@ -48,19 +715,58 @@ NexusResult mps_pipeline_execute_group(NexusContext* ctx,
                                       NexusMPSPipeline* pipeline,
                                       NexusExecutionGroup* group,
                                       NexusMPSDataStreamMap* streams) {
-    // TODO: Implementation
-    return NEXUS_SUCCESS;
+    if (!ctx || !pipeline || !group || !streams) {
+        return NEXUS_INVALID_PARAMETER;
+    }
+
+    size_t group_index = pipeline->group_count;
+    for (size_t g = 0; g < pipeline->group_count; g++) {
+        if (pipeline->groups[g] == group) {
+            group_index = g;
+            break;
+        }
+    }
+    if (group_index == pipeline->group_count) {
+        return NEXUS_NOT_FOUND;
+    }
+
+    if (!pipeline->is_initialized) {
+        NexusResult result = mps_pipeline_initialize(ctx, pipeline);
+        if (result != NEXUS_SUCCESS) {
+            return result;
+        }
+    }
+
+    double start = pipeline_now_ms();
+    MPSGroupOutcome outcome;
+    NexusResult result = run_group(ctx, pipeline, group_index, streams, &outcome);
+    merge_outcome(pipeline, &outcome, group->has_cycles);
+    pipeline->stats.total_execution_time_ms += pipeline_now_ms() - start;
+    if (pipeline->stats.total_iterations > 0) {
+        pipeline->stats.avg_iteration_time_ms =
+            pipeline->stats.total_execution_time_ms / pipeline->stats.total_iterations;
+    }
+
+    if (result != NEXUS_SUCCESS) {
+        mps_handle_pipeline_error(ctx, pipeline, result, outcome.failed_component, outcome.iterations - 1);
+    }
+
+    return result;
 }
 
 // Get a component from the pipeline by ID
 NexusMPSPipelineComponent* mps_pipeline_get_component(NexusMPSPipeline* pipeline, const char* component_id) {
-    // TODO: Implementation
-    return NULL;
+    if (!pipeline || !component_id) {
+        return NULL;
+    }
+
+    size_t index = find_component_index(pipeline, component_id);
+    return index < pipeline->component_count ? pipeline->components[index] : NULL;
 }
 
 // Add a component to the pipeline dynamically
-NexusResult mps_pipeline_add_component(NexusContext* ctx, 
-                                      NexusMPSPipeline* pipeline, 
+NexusResult mps_pipeline_add_component(NexusContext* ctx,
+                                      NexusMPSPipeline* pipeline,
                                       const char* component_id,
                                       const char* version_constraint) {
     // TODO: Implementation
@@ -68,8 +774,8 @@ NexusResult mps_pipeline_add_component(NexusContext* ctx,
 }
 
 // Remove a component from the pipeline dynamically
-NexusResult mps_pipeline_remove_component(NexusContext* ctx, 
-                                         NexusMPSPipeline* pipeline, 
+NexusResult mps_pipeline_remove_component(NexusContext* ctx,
+                                         NexusMPSPipeline* pipeline,
                                          const char* component_id) {
     // TODO: Implementation
     return NEXUS_SUCCESS;
@@ -97,15 +803,35 @@ NexusResult mps_pipeline_remove_connection(NexusContext* ctx,
 
 // Set pipeline-level error handler
 void mps_pipeline_set_error_handler(NexusMPSPipeline* pipeline, NexusMPSPipelineErrorHandler handler) {
-    // TODO: Implementation
+    if (pipeline) {
+        pipeline->error_handler = handler;
+    }
 }
 
 // Set pipeline iteration limit
 void mps_pipeline_set_iteration_limit(NexusMPSPipeline* pipeline, int max_iterations) {
-    // TODO: Implementation
+    if (pipeline) {
+        pipeline->max_iterations = max_iterations > 0 ? max_iterations : 0;
+    }
+}
+
+// Set the number of threads used to run independent groups
+void mps_pipeline_set_worker_count(NexusMPSPipeline* pipeline, size_t worker_count) {
+    if (pipeline) {
+        pipeline->worker_count = worker_count;
+    }
+}
+
+// Enable or disable the worklist for cyclic groups
+void mps_pipeline_set_worklist(NexusMPSPipeline* pipeline, bool enable) {
+    if (pipeline) {
+        pipeline->enable_worklist = enable;
+    }
 }
 
 // Get pipeline execution statistics
 void mps_pipeline_get_stats(NexusMPSPipeline* pipeline, NexusMPSPipelineStats* stats) {
-    // TODO: Implementation
+    if (pipeline && stats) {
+        *stats = pipeline->stats;
+    }
 }
@@ -11,51 +11,497 @@
 
  #include "nlink/mpsystem/mps_stream.h"
  #include "nlink/core/common/nexus_core.h"
+ #include "nlink/core/symbols/intern.h"
  #include <string.h>
  #include <stdlib.h>
  
+ // Forward declarations for helper functions
+ static NexusResult ensure_stream_capacity(NexusMPSDataStream* stream, size_t required_size);
+ static NexusResult collect_streams(const NexusMPSDataStreamMap* map,
+                                    const char* component_id,
+                                    bool as_source,
+                                    NexusMPSDataStream*** streams,
+                                    char*** peer_ids,
+                                    size_t* count);
+ 
  // Create a new multi-pass data stream
  NexusMPSDataStream* mps_stream_create(size_t initial_capacity) {
-     // TODO: Implementation
-     return NULL;
+     // Use a minimum size to avoid frequent resizing
+     if (initial_capacity < 128) {
+         initial_capacity = 128;
+     }
+ 
+     NexusMPSDataStream* stream = (NexusMPSDataStream*)calloc(1, sizeof(NexusMPSDataStream));
+     if (!stream) {
+         return NULL;
+     }
+ 
+     stream->data = malloc(initial_capacity);
+     if (!stream->data) {
+         free(stream);
+         return NULL;
+     }
+ 
+     stream->capacity = initial_capacity;
+     stream->owns_data = true;
+     stream->state = MPS_STREAM_EMPTY;
+ 
+     return stream;
+ }
+ 
+ // Create a double-buffered multi-pass data stream
+ NexusMPSDataStream* mps_stream_create_double_buffered(size_t initial_capacity) {
+     NexusMPSDataStream* stream = mps_stream_create(initial_capacity);
+     if (!stream) {
+         return NULL;
+     }
+ 
+     stream->published_data = malloc(stream->capacity);
+     if (!stream->published_data) {
+         mps_stream_destroy(stream);
+         return NULL;
+     }
+     stream->published_capacity = stream->capacity;
+     stream->double_buffered = true;
+ 
+     return stream;
  }
  
  // Create a multi-pass data stream from existing data
  NexusMPSDataStream* mps_stream_create_from_data(const void* data, size_t size, const char* format) {
-     // TODO: Implementation
-     return NULL;
+     if (!data || size == 0) {
+         return NULL;
+     }
+ 
+     NexusMPSDataStream* stream = mps_stream_create(size);
+     if (!stream) {
+         return NULL;
+     }
+ 
+     memcpy(stream->data, data, size);
+     stream->size = size;
+     stream->state = MPS_STREAM_READY;
+ 
+     if (format) {
+         stream->format = strdup(format);
+     }
+ 
+     return stream;
  }
  
  // Resize a multi-pass data stream
  NexusResult mps_stream_resize(NexusMPSDataStream* stream, size_t new_capacity) {
-     // TODO: Implementation
+     if (!stream || new_capacity < stream->size) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+ 
+     if (new_capacity == stream->capacity) {
+         return NEXUS_SUCCESS;
+     }
+ 
+     // A borrowed buffer is copied into one the stream owns
+     void* new_data;
+     if (stream->owns_data) {
+         new_data = realloc(stream->data, new_capacity);
+     } else {
+         new_data = malloc(new_capacity);
+         if (new_data && stream->size > 0) {
+             memcpy(new_data, stream->data, stream->size);
+         }
+     }
+     if (!new_data) {
+         return NEXUS_OUT_OF_MEMORY;
+     }
+ 
+     stream->data = new_data;
+     stream->capacity = new_capacity;
+     stream->owns_data = true;
+ 
      return NEXUS_SUCCESS;
  }
  
+ // Ensure a stream has enough capacity
+ static NexusResult ensure_stream_capacity(NexusMPSDataStream* stream, size_t required_size) {
+     if (stream->capacity >= required_size && stream->owns_data) {
+         return NEXUS_SUCCESS;
+     }
+ 
+     // Grow by 1.5x or to the required size, whichever is larger
+     size_t new_capacity = stream->capacity * 3 / 2;
+     if (new_capacity < required_size) {
+         new_capacity = required_size;
+     }
+ 
+     return mps_stream_resize(stream, new_capacity);
+ }
+ 
  // Write data to a multi-pass stream
  NexusResult mps_stream_write(NexusMPSDataStream* stream, const void* data, size_t size) {
-     // TODO: Implementation
+     if (!stream || !data || size == 0) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+ 
+     NexusResult result = ensure_stream_capacity(stream, stream->position + size);
+     if (result != NEXUS_SUCCESS) {
+         return result;
+     }
+ 
+     memcpy((char*)stream->data + stream->position, data, size);
+     stream->position += size;
+     if (stream->position > stream->size) {
+         stream->size = stream->position;
+     }
+ 
+     stream->state = MPS_STREAM_READY;
+     stream->has_content_hash = false;
+ 
      return NEXUS_SUCCESS;
  }
  
  // Read data from a multi-pass stream
  NexusResult mps_stream_read(NexusMPSDataStream* stream, void* buffer, size_t size, size_t* bytes_read) {
-     // TODO: Implementation
+     if (!stream || !buffer || size == 0) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+ 
+     size_t available = stream->size - stream->position;
+     size_t to_read = size < available ? size : available;
+ 
+     if (to_read > 0) {
+         memcpy(buffer, (char*)stream->data + stream->position, to_read);
+         stream->position += to_read;
+     }
+ 
+     if (stream->position == stream->size && stream->size > 0) {
+         stream->state = MPS_STREAM_CONSUMED;
+     }
+ 
+     if (bytes_read) {
+         *bytes_read = to_read;
+     }
+ 
+     // Return success even if we read fewer bytes than requested
+     return NEXUS_SUCCESS;
+ }
+ 
+ // Publish what was written to a double-buffered stream
+ NexusResult mps_stream_publish(NexusMPSDataStream* stream) {
+     if (!stream || !stream->double_buffered || !stream->owns_data) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+ 
+     // Swap buffers; the old published buffer becomes the next write side
+     void* data = stream->published_data;
+     size_t capacity = stream->published_capacity;
+     stream->published_data = stream->data;
+     stream->published_size = stream->size;
+     stream->published_capacity = stream->capacity;
+     stream->published_hash = stream->content_hash;
+     stream->published_has_hash = stream->has_content_hash;
+     stream->data = data;
+     stream->capacity = capacity;
+     stream->has_content_hash = false;
+ 
+     stream->size = 0;
+     stream->position = 0;
+     stream->state = MPS_STREAM_EMPTY;
+     stream->generation++;
+ 
      return NEXUS_SUCCESS;
  }
  
+ // Get a read-only view of what readers should see
+ void mps_stream_view_published(const NexusMPSDataStream* stream, NexusMPSDataStream* view) {
+     if (!view) {
+         return;
+     }
+ 
+     memset(view, 0, sizeof(*view));
+     if (stream) {
+         view->data = stream->double_buffered ? stream->published_data : stream->data;
+         view->size = stream->double_buffered ? stream->published_size : stream->size;
+         view->capacity = view->size;
+         view->format = stream->format;
+         view->generation = stream->generation;
+     }
+     view->state = view->size > 0 ? MPS_STREAM_READY : MPS_STREAM_EMPTY;
+ }
+ 
+ // Check whether the write side holds the same bytes as the published buffer
+ bool mps_stream_is_unchanged(const NexusMPSDataStream* stream) {
+     if (!stream || !stream->double_buffered) {
+         return false;
+     }
+ 
+     if (stream->size != stream->published_size) {
+         return false;
+     }
+     if (stream->has_content_hash && stream->published_has_hash) {
+         return stream->content_hash == stream->published_hash;
+     }
+     return stream->size == 0 || memcmp(stream->data, stream->published_data, stream->size) == 0;
+ }
+ 
+ // Report the content hash of what was written
+ void mps_stream_set_content_hash(NexusMPSDataStream* stream, uint64_t hash) {
+     if (stream) {
+         stream->content_hash = hash;
+         stream->has_content_hash = true;
+     }
+ }
+ 
  // Create a stream map for multi-pass systems
  NexusMPSDataStreamMap* mps_stream_map_create(size_t initial_capacity) {
-     // TODO: Implementation
+     if (initial_capacity < 8) {
+         initial_capacity = 8;
+     }
+ 
+     NexusMPSDataStreamMap* map = (NexusMPSDataStreamMap*)calloc(1, sizeof(NexusMPSDataStreamMap));
+     if (!map) {
+         return NULL;
+     }
+ 
+     map->slot_count = 1;
+     while (map->slot_count < initial_capacity * 2) {
+         map->slot_count <<= 1;
+     }
+ 
+     map->entries = (MPSStreamMapEntry*)calloc(initial_capacity, sizeof(MPSStreamMapEntry));
+     map->component_ids = (const char**)calloc(initial_capacity, sizeof(const char*));
+     map->component_slots = (size_t*)calloc(map->slot_count, sizeof(size_t));
+     if (!map->entries || !map->component_ids || !map->component_slots) {
+         mps_stream_map_destroy(map);
+         return NULL;
+     }
+     map->capacity = initial_capacity;
+     map->component_capacity = initial_capacity;
+ 
+     return map;
+ }
+ 
+ // Find the slot holding an interned component ID, or the empty slot where it belongs
+ static size_t find_component_slot(const NexusMPSDataStreamMap* map, const char* interned) {
+     size_t mask = map->slot_count - 1;
+     size_t slot = (size_t)nexus_intern_hash_of(interned) & mask;
+     while (map->component_slots[slot] != 0 &&
+            map->component_ids[map->component_slots[slot] - 1] != interned) {
+         slot = (slot + 1) & mask;
+     }
+     return slot;
+ }
+ 
+ // Get the component index of an interned ID, numbering it if new
+ static NexusResult intern_component(NexusMPSDataStreamMap* map, const char* interned, size_t* index) {
+     size_t slot = find_component_slot(map, interned);
+     if (map->component_slots[slot] != 0) {
+         *index = map->component_slots[slot] - 1;
+         return NEXUS_SUCCESS;
+     }
+ 
+     if (map->component_count == map->component_capacity) {
+         size_t new_capacity = map->component_capacity * 2;
+         const char** ids = (const char**)realloc(map->component_ids, new_capacity * sizeof(const char*));
+         if (!ids) {
+             return NEXUS_OUT_OF_MEMORY;
+         }
+         map->component_ids = ids;
+         map->component_capacity = new_capacity;
+     }
+ 
+     // Keep the table at most half full
+     if ((map->component_count + 1) * 2 > map->slot_count) {
+         size_t new_slot_count = map->slot_count * 2;
+         size_t* slots = (size_t*)calloc(new_slot_count, sizeof(size_t));
+         if (!slots) {
+             return NEXUS_OUT_OF_MEMORY;
+         }
+         free(map->component_slots);
+         map->component_slots = slots;
+         map->slot_count = new_slot_count;
+         for (size_t i = 0; i < map->component_count; i++) {
+             map->component_slots[find_component_slot(map, map->component_ids[i])] = i + 1;
+         }
+         slot = find_component_slot(map, interned);
+     }
+ 
+     *index = map->component_count;
+     map->component_ids[map->component_count++] = interned;
+     map->component_slots[slot] = *index + 1;
+     return NEXUS_SUCCESS;
+ }
+ 
+ // Get the component index of a component ID
+ size_t mps_stream_map_component_index(const NexusMPSDataStreamMap* map, const char* component_id) {
+     if (!map || !component_id) {
+         return map ? map->component_count : 0;
+     }
+ 
+     // Never-interned IDs cannot be in the map
+     const char* interned = nexus_intern_lookup(component_id);
+     if (!interned) {
+         return map->component_count;
+     }
+ 
+     size_t slot = find_component_slot(map, interned);
+     return map->component_slots[slot] != 0 ? map->component_slots[slot] - 1 : map->component_count;
+ }
+ 
+ // Build one side of the adjacency index with a counting sort
+ static NexusResult build_adjacency(NexusMPSDataStreamMap* map,
+                                    bool by_source,
+                                    size_t** offsets_out,
+                                    MPSStreamMapEntry*** slice_out) {
+     size_t* offsets = (size_t*)calloc(map->component_count + 1, sizeof(size_t));
+     MPSStreamMapEntry** slice = (MPSStreamMapEntry**)malloc((map->count + 1) * sizeof(MPSStreamMapEntry*));
+     if (!offsets || !slice) {
+         free(offsets);
+         free(slice);
+         return NEXUS_OUT_OF_MEMORY;
+     }
+ 
+     for (size_t i = 0; i < map->count; i++) {
+         const MPSStreamMapEntry* entry = &map->entries[i];
+         offsets[(by_source ? entry->source_index : entry->target_index) + 1]++;
+     }
+     for (size_t c = 0; c < map->component_count; c++) {
+         offsets[c + 1] += offsets[c];
+     }
+ 
+     // Stable fill keeps insertion order within each slice; offsets[c]
+     // walks to the end of slice c and is shifted back afterwards
+     for (size_t i = 0; i < map->count; i++) {
+         MPSStreamMapEntry* entry = &map->entries[i];
+         slice[offsets[by_source ? entry->source_index : entry->target_index]++] = entry;
+     }
+     for (size_t c = map->component_count; c > 0; c--) {
+         offsets[c] = offsets[c - 1];
+     }
+     offsets[0] = 0;
+ 
+     free(*offsets_out);
+     free(*slice_out);
+     *offsets_out = offsets;
+     *slice_out = slice;
+     return NEXUS_SUCCESS;
+ }
+ 
+ // Rebuild the adjacency index after entries were added
+ NexusResult mps_stream_map_build_index(NexusMPSDataStreamMap* map) {
+     if (!map) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+ 
+     if (map->index_valid) {
+         return NEXUS_SUCCESS;
+     }
+ 
+     NexusResult result = build_adjacency(map, true, &map->outgoing_offsets, &map->outgoing);
+     if (result == NEXUS_SUCCESS) {
+         result = build_adjacency(map, false, &map->incoming_offsets, &map->incoming);
+     }
+ 
+     map->index_valid = result == NEXUS_SUCCESS;
+     return result;
+ }
+ 
+ // Get the connections leaving a component, without allocating
+ size_t mps_stream_map_outgoing(const NexusMPSDataStreamMap* map,
+                                size_t component_index,
+                                MPSStreamMapEntry* const** entries) {
+     // Queries only read; a stale index may point into moved entries
+     if (!map || !entries || component_index >= map->component_count || !map->index_valid) {
+         return 0;
+     }
+ 
+     *entries = &map->outgoing[map->outgoing_offsets[component_index]];
+     return map->outgoing_offsets[component_index + 1] - map->outgoing_offsets[component_index];
+ }
+ 
+ // Get the connections entering a component, without allocating
+ size_t mps_stream_map_incoming(const NexusMPSDataStreamMap* map,
+                                size_t component_index,
+                                MPSStreamMapEntry* const** entries) {
+     if (!map || !entries || component_index >= map->component_count || !map->index_valid) {
+         return 0;
+     }
+ 
+     *entries = &map->incoming[map->incoming_offsets[component_index]];
+     return map->incoming_offsets[component_index + 1] - map->incoming_offsets[component_index];
+ }
+ 
+ // Find the entry for a connection by walking the source's outgoing slice
+ static MPSStreamMapEntry* find_entry(const NexusMPSDataStreamMap* map,
+                                      const char* source_id,
+                                      const char* target_id) {
+     size_t source = mps_stream_map_component_index(map, source_id);
+     const char* target = nexus_intern_lookup(target_id);
+     if (source == map->component_count || !target) {
+         return NULL;
+     }
+ 
+     MPSStreamMapEntry* const* entries = NULL;
+     size_t count = mps_stream_map_outgoing(map, source, &entries);
+     for (size_t i = 0; i < count; i++) {
+         if (entries[i]->key.target_id == target) {
+             return entries[i];
+         }
+     }
      return NULL;
  }
  
- // Add a stream to the map
- NexusResult mps_stream_map_add(NexusMPSDataStreamMap* map, 
-                               const char* source_id, 
-                               const char* target_id, 
+ // Add a stream to the map; the map refers to the stream but does not own it
+ NexusResult mps_stream_map_add(NexusMPSDataStreamMap* map,
+                               const char* source_id,
+                               const char* target_id,
                                NexusMPSDataStream* stream) {
-     // TODO: Implementation
+     if (!map || !source_id || !target_id || !stream) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+ 
+     const char* source = nexus_intern(source_id);
+     const char* target = nexus_intern(target_id);
+     if (!source || !target) {
+         return NEXUS_OUT_OF_MEMORY;
+     }
+ 
+     // Replace an existing connection; compares pointers only, so adding
+     // does not force an index rebuild
+     for (size_t i = 0; i < map->count; i++) {
+         if (map->entries[i].key.source_id == source && map->entries[i].key.target_id == target) {
+             map->entries[i].stream = stream;
+             return NEXUS_SUCCESS;
+         }
+     }
+ 
+     size_t source_index, target_index;
+     NexusResult result = intern_component(map, source, &source_index);
+     if (result == NEXUS_SUCCESS) {
+         result = intern_component(map, target, &target_index);
+     }
+     if (result != NEXUS_SUCCESS) {
+         return result;
+     }
+ 
+     if (map->count == map->capacity) {
+         size_t new_capacity = map->capacity * 2;
+         MPSStreamMapEntry* entries = (MPSStreamMapEntry*)realloc(map->entries, new_capacity * sizeof(MPSStreamMapEntry));
+         if (!entries) {
+             return NEXUS_OUT_OF_MEMORY;
+         }
+         map->entries = entries;
+         map->capacity = new_capacity;
+     }
+ 
+     MPSStreamMapEntry* entry = &map->entries[map->count++];
+     entry->key.source_id = source;
+     entry->key.target_id = target;
+     entry->stream = stream;
+     entry->source_index = source_index;
+     entry->target_index = target_index;
+ 
+     // Entries may have moved; queries find nothing until the index is rebuilt
+     map->index_valid = false;
+ 
      return NEXUS_SUCCESS;
  }
  
@@ -63,8 +509,55 @@
  NexusMPSDataStream* mps_stream_map_get(const NexusMPSDataStreamMap* map,
                                        const char* source_id,
                                        const char* target_id) {
-     // TODO: Implementation
-     return NULL;
+     if (!map || !source_id || !target_id) {
+         return NULL;
+     }
+ 
+     MPSStreamMapEntry* entry = find_entry(map, source_id, target_id);
+     return entry ? entry->stream : NULL;
+ }
+ 
+ // Copy one component's connections into arrays allocated for the caller
+ static NexusResult collect_streams(const NexusMPSDataStreamMap* map,
+                                    const char* component_id,
+                                    bool as_source,
+                                    NexusMPSDataStream*** streams,
+                                    char*** peer_ids,
+                                    size_t* count) {
+     if (!map || !component_id || !streams || !count) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+     if (!map->index_valid) {
+         return NEXUS_INVALID_OPERATION;
+     }
+ 
+     MPSStreamMapEntry* const* entries = NULL;
+     size_t index = mps_stream_map_component_index(map, component_id);
+     size_t matches = as_source ? mps_stream_map_outgoing(map, index, &entries)
+                                : mps_stream_map_incoming(map, index, &entries);
+ 
+     *streams = (NexusMPSDataStream**)malloc((matches + 1) * sizeof(NexusMPSDataStream*));
+     char** ids = (char**)malloc((matches + 1) * sizeof(char*));
+     if (!*streams || !ids) {
+         free(*streams);
+         free(ids);
+         *streams = NULL;
+         return NEXUS_OUT_OF_MEMORY;
+     }
+ 
+     for (size_t i = 0; i < matches; i++) {
+         (*streams)[i] = entries[i]->stream;
+         ids[i] = (char*)(as_source ? entries[i]->key.target_id : entries[i]->key.source_id);
+     }
+ 
+     if (peer_ids) {
+         *peer_ids = ids;
+     } else {
+         free(ids);
+     }
+     *count = matches;
+ 
+     return NEXUS_SUCCESS;
  }
  
  // Get all streams for a component (as source)
@@ -73,8 +566,7 @@
                                         NexusMPSDataStream*** streams,
                                         char*** target_ids,
                                         size_t* count) {
-     // TODO: Implementation
-     return NEXUS_SUCCESS;
+     return collect_streams(map, source_id, true, streams, target_ids, count);
  }
  
  // Get all streams for a component (as target)
@@ -83,52 +575,160 @@
                                         NexusMPSDataStream*** streams,
                                         char*** source_ids,
                                         size_t* count) {
-     // TODO: Implementation
-     return NEXUS_SUCCESS;
+     return collect_streams(map, target_id, false, streams, source_ids, count);
  }
  
  // Clear all streams in the map
  void mps_stream_map_clear(NexusMPSDataStreamMap* map) {
-     // TODO: Implementation
+     if (!map) {
+         return;
+     }
+ 
+     for (size_t i = 0; i < map->count; i++) {
+         mps_stream_clear(map->entries[i].stream);
+     }
  }
  
- // Free stream map resources
+ // Free stream map resources (the streams themselves belong to their owners)
  void mps_stream_map_destroy(NexusMPSDataStreamMap* map) {
-     // TODO: Implementation
+     if (!map) {
+         return;
+     }
+ 
+     // IDs are interned and live until nexus_intern_cleanup()
+     free(map->entries);
+     free(map->component_ids);
+     free(map->component_slots);
+     free(map->outgoing_offsets);
+     free(map->outgoing);
+     free(map->incoming_offsets);
+     free(map->incoming);
+     free(map);
  }
  
  // Clone a multi-pass stream
  NexusMPSDataStream* mps_stream_clone(const NexusMPSDataStream* stream) {
-     // TODO: Implementation
-     return NULL;
+     if (!stream) {
+         return NULL;
+     }
+ 
+     NexusMPSDataStream* clone = mps_stream_create(stream->capacity);
+     if (!clone) {
+         return NULL;
+     }
+ 
+     if (stream->size > 0) {
+         memcpy(clone->data, stream->data, stream->size);
+     }
+     clone->size = stream->size;
+     clone->position = stream->position;
+     clone->state = stream->state;
+     clone->generation = stream->generation;
+     clone->content_hash = stream->content_hash;
+     clone->has_content_hash = stream->has_content_hash;
+ 
+     if (stream->double_buffered) {
+         clone->published_data = malloc(stream->published_capacity);
+         if (!clone->published_data) {
+             mps_stream_destroy(clone);
+             return NULL;
+         }
+         if (stream->published_size > 0) {
+             memcpy(clone->published_data, stream->published_data, stream->published_size);
+         }
+         clone->published_size = stream->published_size;
+         clone->published_capacity = stream->published_capacity;
+         clone->published_hash = stream->published_hash;
+         clone->published_has_hash = stream->published_has_hash;
+         clone->double_buffered = true;
+     }
+ 
+     if (stream->format) {
+         clone->format = strdup(stream->format);
+         if (!clone->format) {
+             mps_stream_destroy(clone);
+             return NULL;
+         }
+     }
+ 
+     // Metadata values are shared by reference, as in sps_stream_clone
+     if (nexus_metadata_copy(&clone->metadata, &stream->metadata) != NEXUS_SUCCESS) {
+         mps_stream_destroy(clone);
+         return NULL;
+     }
+ 
+     return clone;
  }
  
  // Get stream metadata
  void* mps_stream_get_metadata(const NexusMPSDataStream* stream, const char* key) {
-     // TODO: Implementation
-     return NULL;
+     if (!stream || !key) {
+         return NULL;
+     }
+ 
+     return nexus_metadata_get(&stream->metadata, key);
+ }
+ 
+ // Get stream metadata by an interned key
+ void* mps_stream_get_metadata_interned(const NexusMPSDataStream* stream, const char* interned_key) {
+     if (!stream || !interned_key) {
+         return NULL;
+     }
+ 
+     return nexus_metadata_get_interned(&stream->metadata, interned_key);
  }
  
  // Set stream metadata
- NexusResult mps_stream_set_metadata(NexusMPSDataStream* stream, 
-                                    const char* key, 
-                                    void* value, 
+ NexusResult mps_stream_set_metadata(NexusMPSDataStream* stream,
+                                    const char* key,
+                                    void* value,
                                     MPSStreamMetadataFreeFunc free_func) {
-     // TODO: Implementation
-     return NEXUS_SUCCESS;
+     if (!stream || !key) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+ 
+     return nexus_metadata_set(&stream->metadata, key, value, free_func);
  }
  
  // Clear a stream (reset position but keep capacity)
  void mps_stream_clear(NexusMPSDataStream* stream) {
-     // TODO: Implementation
+     if (!stream) {
+         return;
+     }
+ 
+     stream->position = 0;
+     stream->size = 0;
+     stream->state = MPS_STREAM_EMPTY;
+     stream->has_content_hash = false;
  }
  
  // Reset a stream to initial state
  void mps_stream_reset(NexusMPSDataStream* stream) {
-     // TODO: Implementation
+     if (!stream) {
+         return;
+     }
+ 
+     mps_stream_clear(stream);
+ 
+     nexus_metadata_clear(&stream->metadata);
+     stream->published_size = 0;
+     stream->published_has_hash = false;
+     stream->generation = 0;
  }
  
  // Free stream resources
  void mps_stream_destroy(NexusMPSDataStream* stream) {
-     // TODO: Implementation
- }
\ No newline at end of file
+     if (!stream) {
+         return;
+     }
+ 
+     if (stream->data && stream->owns_data) {
+         free(stream->data);
+     }
+     free(stream->published_data);
+     free((void*)stream->format);
+ 
+     nexus_metadata_destroy(&stream->metadata);
+ 
+     free(stream);
+ }
@@ -173,16 +173,75 @@ nlink_ast_node* nlink_ast_node_transform(nlink_ast_node* node,
     return (nlink_ast_node*)transform(node, context);
 }
 
-void nlink_ast_traverse(nlink_ast_node* root, nlink_consumer_fn visit, void* context) {
-    if (root == NULL || visit == NULL) {
-        return;
+static void* ast_get_child(void* node, size_t index, void* context) {
+    (void)context;
+    return ((nlink_ast_node*)node)->children[index];
+}
+
+static size_t ast_get_child_count(void* node, void* context) {
+    (void)context;
+    return ((nlink_ast_node*)node)->child_count;
+}
+
+static void* ast_identity(void* node, void* context) {
+    (void)context;
+    return node;
+}
+
+/**
+ * Visitor of an AST traversal, called from the stream's emit callback
+ */
+typedef struct {
+    nlink_consumer_fn consume;
+    nlink_traversal_control_fn control;
+    void* context;
+} ast_visit_context;
+
+static bool ast_emit(void* node, void* result, void* context) {
+    ast_visit_context* visit = context;
+    (void)result;
+    
+    if (visit->control != NULL) {
+        return visit->control(node, visit->context);
     }
     
-    // Visit this node
-    visit(root, context);
+    visit->consume(node, visit->context);
+    return true;
+}
+
+static nlink_traversal_status ast_traverse(nlink_ast_node* root,
+                                           ast_visit_context* visit,
+                                           nlink_traversal_workspace* workspace) {
+    nlink_traversal_config config = {
+        .order = NLINK_TRAVERSAL_PRE_ORDER,
+        .visitor = ast_identity,
+        .get_child = ast_get_child,
+        .get_child_count = ast_get_child_count,
+        .should_traverse = NULL,
+        .context = NULL,
+        .collect_results = false
+    };
+    
+    return nlink_traverse_tree_stream(root, &config, workspace, ast_emit, visit);
+}
+
+nlink_traversal_status nlink_ast_traverse(nlink_ast_node* root, nlink_consumer_fn visit, void* context) {
+    if (root == NULL || visit == NULL) {
+        return NLINK_TRAVERSAL_FAILED;
+    }
     
-    // Visit all children
-    for (size_t i = 0; i < root->child_count; i++) {
-        nlink_ast_traverse(root->children[i], visit, context);
+    ast_visit_context visit_context = { visit, NULL, context };
+    return ast_traverse(root, &visit_context, NULL);
+}
+
+nlink_traversal_status nlink_ast_traverse_until(nlink_ast_node* root,
+                                                nlink_traversal_control_fn visit,
+                                                void* context,
+                                                nlink_traversal_workspace* workspace) {
+    if (root == NULL || visit == NULL) {
+        return NLINK_TRAVERSAL_FAILED;
     }
+    
+    ast_visit_context visit_context = { NULL, visit, context };
+    return ast_traverse(root, &visit_context, workspace);
 }
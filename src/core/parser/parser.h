@@ -15,6 +15,7 @@
 #include "../tactic/tactic.h"
 #include "../type/type.h"
 #include "../tokenizer/tokenizer.h"
+#include "nlink/core/tatit/traversal.h"
 
 /**
  * Node type for abstract syntax trees
@@ -127,10 +128,29 @@ nlink_ast_node* nlink_ast_node_transform(nlink_ast_node* node,
 
 /**
  * Traverse an AST with a visitor function
+ *
+ * Visits nodes in pre-order using an explicit stack, so tree depth is
+ * not limited by the call stack.
+ *
  * @param root Root node
  * @param visit Visitor function
  * @param context Visitor context
+ * @return NLINK_TRAVERSAL_COMPLETE, or NLINK_TRAVERSAL_FAILED if the
+ *         arguments are invalid or the traversal workspace cannot grow
  */
-void nlink_ast_traverse(nlink_ast_node* root, nlink_consumer_fn visit, void* context);
+nlink_traversal_status nlink_ast_traverse(nlink_ast_node* root, nlink_consumer_fn visit, void* context);
+
+/**
+ * Traverse an AST in pre-order until the visitor returns false
+ * @param root Root node
+ * @param visit Visitor function; returning false ends the traversal
+ * @param context Visitor context
+ * @param workspace Reusable traversal workspace, or NULL for a temporary one
+ * @return Whether the traversal completed, was stopped, or failed
+ */
+nlink_traversal_status nlink_ast_traverse_until(nlink_ast_node* root,
+                                                nlink_traversal_control_fn visit,
+                                                void* context,
+                                                nlink_traversal_workspace* workspace);
 
 #endif /* NLINK_PARSER_H */
@@ -14,6 +14,7 @@
 
 #include "cli/parser_interface.h"
 #include "core/config.h"
+#include "nlink/core/threading/thread_pool.h"
 #include <getopt.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -272,6 +273,23 @@ nlink_cli_result_t nlink_cli_execute(nlink_cli_context_t *context,
 // CLI COMMAND EXECUTION IMPLEMENTATIONS
 // =============================================================================
 
+/**
+ * @brief Size the shared thread pool from a validated configuration
+ *
+ * Pipelines, minimization and telemetry all run on the shared pool, so it
+ * must be created from the thread_pool section before anything uses it.
+ */
+static void nlink_cli_apply_thread_pool_config(nlink_cli_context_t *context,
+                                               const nlink_pkg_config_t *config) {
+  if (nlink_thread_pool_shared_init(&config->thread_pool)) {
+    NLINK_CLI_VERBOSE(context, "Shared thread pool started with %d workers",
+                      config->thread_pool.worker_count);
+  } else {
+    NLINK_CLI_WARNING(context, "Shared thread pool already running; "
+                               "configured sizing not applied");
+  }
+}
+
 nlink_cli_result_t
 nlink_cli_execute_config_check(nlink_cli_context_t *context) {
   NLINK_CLI_VERBOSE(context,
@@ -319,6 +337,8 @@ nlink_cli_execute_config_check(nlink_cli_context_t *context) {
     return NLINK_CLI_ERROR_VALIDATION_FAILED;
   }
 
+  nlink_cli_apply_thread_pool_config(context, &config);
+
   // Display comprehensive configuration summary
   nlink_cli_display_config_summary(&config, context->json_output_format);
 
@@ -402,6 +422,8 @@ nlink_cli_execute_threading_validation(nlink_cli_context_t *context) {
         config.thread_pool.stack_size_kb);
   }
 
+  nlink_cli_apply_thread_pool_config(context, &config);
+
   // Display threading analysis with performance projections
   nlink_cli_display_threading_analysis(&config);
 
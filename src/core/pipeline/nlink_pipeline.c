@@ -11,6 +11,9 @@
 #include <string.h>
 #include <time.h>
 
+/* Buffer size assumed for stages that declare no sizes */
+#define NLINK_PIPELINE_DEFAULT_STAGE_BUFFER 1024
+
 NlinkPipelineConfig nlink_pipeline_default_config(void) {
     NlinkPipelineConfig config;
     config.mode = NLINK_PIPELINE_MODE_AUTO;
@@ -18,6 +21,9 @@ NlinkPipelineConfig nlink_pipeline_default_config(void) {
     config.enable_caching = true;
     config.max_iterations = 10;  /* Default to 10 iterations max */
     config.schema_path = NULL;
+    config.stage_buffer_size = NLINK_PIPELINE_DEFAULT_STAGE_BUFFER;
+    config.arena_block_size = NLINK_ARENA_DEFAULT_BLOCK_SIZE;
+    config.enable_worklist = false;
     return config;
 }
 
@@ -42,6 +48,11 @@ NlinkPipeline* nlink_pipeline_create(NexusContext* ctx, const NlinkPipelineConfi
     } else {
         pipeline->config = nlink_pipeline_default_config();
     }
+    if (pipeline->config.stage_buffer_size == 0) {
+        pipeline->config.stage_buffer_size = NLINK_PIPELINE_DEFAULT_STAGE_BUFFER;
+    }
+    
+    nlink_arena_init(&pipeline->arena, pipeline->config.arena_block_size);
     
     /* Start with auto mode, will be determined during execution */
     pipeline->active_mode = NLINK_PIPELINE_MODE_AUTO;
@@ -53,16 +64,15 @@ NlinkPipeline* nlink_pipeline_create(NexusContext* ctx, const NlinkPipelineConfi
     return pipeline;
 }
 
-NexusResult nlink_pipeline_add_stage(NlinkPipeline* pipeline, 
-                                    const char* name,
-                                    NlinkPipelineStageFunc func,
-                                    void* user_data) {
-    if (!pipeline || !name || !func) {
-        return NEXUS_INVALID_PARAMETER;
-    }
-    
+static NexusResult append_stage(NlinkPipeline* pipeline,
+                                const char* name,
+                                NlinkPipelineStageFunc func,
+                                NlinkPipelineSizedStageFunc sized_func,
+                                NlinkPipelineStageSizeFunc size_func,
+                                NlinkPipelineTrackedStageFunc tracked_func,
+                                void* user_data) {
     /* Create new stage */
-    NlinkPipelineStage* stage = (NlinkPipelineStage*)malloc(sizeof(NlinkPipelineStage));
+    NlinkPipelineStage* stage = (NlinkPipelineStage*)calloc(1, sizeof(NlinkPipelineStage));
     if (!stage) {
         nexus_log(pipeline->ctx, NEXUS_LOG_ERROR, "Failed to allocate pipeline stage");
         return NEXUS_OUT_OF_MEMORY;
@@ -76,6 +86,9 @@ NexusResult nlink_pipeline_add_stage(NlinkPipeline* pipeline,
     }
     
     stage->func = func;
+    stage->sized_func = sized_func;
+    stage->size_func = size_func;
+    stage->tracked_func = tracked_func;
     stage->user_data = user_data;
     stage->next = NULL;
     
@@ -96,113 +109,480 @@ NexusResult nlink_pipeline_add_stage(NlinkPipeline* pipeline,
     return NEXUS_SUCCESS;
 }
 
-static NexusResult execute_single_pass(NlinkPipeline* pipeline, void* input, void* output) {
-    NexusContext* ctx = pipeline->ctx;
-    NlinkPipelineStage* current = pipeline->first_stage;
-    void* stage_input = input;
-    void* stage_output = NULL;
-    NexusResult result = NEXUS_SUCCESS;
+NexusResult nlink_pipeline_add_stage(NlinkPipeline* pipeline, 
+                                    const char* name,
+                                    NlinkPipelineStageFunc func,
+                                    void* user_data) {
+    if (!pipeline || !name || !func) {
+        return NEXUS_INVALID_PARAMETER;
+    }
     
-    /* Only need a middle buffer if we have more than one stage */
-    if (pipeline->stage_count > 1) {
-        stage_output = malloc(1024);  /* Simplified: would use appropriate buffer size in real impl */
-        if (!stage_output) {
-            nexus_log(ctx, NEXUS_LOG_ERROR, "Failed to allocate stage output buffer");
-            return NEXUS_OUT_OF_MEMORY;
+    return append_stage(pipeline, name, func, NULL, NULL, NULL, user_data);
+}
+
+NexusResult nlink_pipeline_add_sized_stage(NlinkPipeline* pipeline,
+                                          const char* name,
+                                          NlinkPipelineSizedStageFunc func,
+                                          NlinkPipelineStageSizeFunc size_func,
+                                          void* user_data) {
+    if (!pipeline || !name || !func) {
+        return NEXUS_INVALID_PARAMETER;
+    }
+    
+    return append_stage(pipeline, name, NULL, func, size_func, NULL, user_data);
+}
+
+NexusResult nlink_pipeline_add_tracked_stage(NlinkPipeline* pipeline,
+                                            const char* name,
+                                            NlinkPipelineTrackedStageFunc func,
+                                            void* user_data) {
+    if (!pipeline || !name || !func) {
+        return NEXUS_INVALID_PARAMETER;
+    }
+    
+    return append_stage(pipeline, name, NULL, NULL, NULL, func, user_data);
+}
+
+void nlink_stage_changes_mark(NlinkStageChanges* changes, size_t offset, size_t length) {
+    if (!changes || length == 0) {
+        return;
+    }
+    
+    size_t end = offset + length;
+    
+    /* Extend the last range when the new one touches it */
+    if (changes->range_count > 0) {
+        NlinkDirtyRange* last = &changes->ranges[changes->range_count - 1];
+        size_t last_end = last->offset + last->length;
+        if ((offset <= last_end && end >= last->offset) ||
+            changes->range_count == NLINK_STAGE_MAX_DIRTY_RANGES) {
+            size_t start = offset < last->offset ? offset : last->offset;
+            last->length = (end > last_end ? end : last_end) - start;
+            last->offset = start;
+            return;
         }
-    } else {
-        stage_output = output;  /* Single stage, output directly to final output */
     }
     
-    /* Process each stage */
-    while (current && result == NEXUS_SUCCESS) {
-        nexus_log(ctx, NEXUS_LOG_DEBUG, "Executing stage '%s'", current->name);
-        
-        /* Last stage outputs directly to the final output */
-        void* current_output = current->next ? stage_output : output;
-        
-        /* Execute the stage */
-        result = current->func(stage_input, current_output, current->user_data);
-        
+    changes->ranges[changes->range_count].offset = offset;
+    changes->ranges[changes->range_count].length = length;
+    changes->range_count++;
+}
+
+void nlink_stage_changes_set_hash(NlinkStageChanges* changes, uint64_t hash) {
+    if (changes) {
+        changes->hash = hash;
+        changes->has_hash = true;
+    }
+}
+
+/* Where the last stage of a chain writes its output */
+typedef struct StageTarget {
+    void** data;                    /* Output buffer */
+    size_t* capacity;               /* Capacity of *data */
+    bool growable;                  /* Whether *data may be realloc'd */
+} StageTarget;
+
+static NexusResult grow_target(StageTarget* target, size_t size) {
+    if (*target->capacity >= size) {
+        return NEXUS_SUCCESS;
+    }
+
+    size_t capacity = *target->capacity * 2;
+    if (capacity < size) {
+        capacity = size;
+    }
+
+    void* data = realloc(*target->data, capacity);
+    if (!data) {
+        return NEXUS_OUT_OF_MEMORY;
+    }
+
+    *target->data = data;
+    *target->capacity = capacity;
+    return NEXUS_SUCCESS;
+}
+
+/* Upper bound on a stage's output, used to size its first attempt */
+static size_t stage_declared_size(const NlinkPipeline* pipeline,
+                                  const NlinkPipelineStage* stage,
+                                  size_t input_size) {
+    size_t buffer_size = pipeline->config.stage_buffer_size;
+
+    if (stage->func) {
+        return buffer_size;
+    }
+    if (stage->tracked_func) {
+        return input_size;
+    }
+    if (stage->size_func) {
+        return stage->size_func(input_size, stage->user_data);
+    }
+    return input_size > buffer_size ? input_size : buffer_size;
+}
+
+/* Stages without sizes read stage_buffer_size bytes: zero what the payload doesn't cover */
+static void pad_for_stage(const NlinkPipeline* pipeline, const NlinkPipelineStage* stage,
+                          void* buffer, size_t size) {
+    size_t buffer_size = pipeline->config.stage_buffer_size;
+
+    if (stage && stage->func && size < buffer_size) {
+        memset((unsigned char*)buffer + size, 0, buffer_size - size);
+    }
+}
+
+static NexusResult run_stage(const NlinkPipeline* pipeline, const NlinkPipelineStage* stage,
+                             const void* input, size_t input_size,
+                             void* output, size_t capacity, size_t* output_size) {
+    if (stage->func) {
+        *output_size = pipeline->config.stage_buffer_size;
+        return stage->func((void*)input, output, stage->user_data);
+    }
+    
+    /* Outside the incremental engine a tracked stage edits a copy of its input */
+    if (stage->tracked_func) {
+        NlinkStageChanges changes;
+        changes.range_count = 0;
+        changes.has_hash = false;
+        if (output != input) {
+            memcpy(output, input, input_size);
+        }
+        *output_size = input_size;
+        return stage->tracked_func(output, input_size, &changes, stage->user_data);
+    }
+
+    *output_size = 0;
+    return stage->sized_func(input, input_size, output, capacity, output_size, stage->user_data);
+}
+
+/*
+ * Run every stage once. Intermediate outputs are carved from the arena; the
+ * last stage writes straight into the target when its declared size fits
+ * (or the target can grow) and into the arena otherwise.
+ */
+static NexusResult run_stage_chain(NlinkPipeline* pipeline,
+                                   const void* input, size_t input_size,
+                                   StageTarget* target, size_t* output_size,
+                                   unsigned iteration) {
+    NexusContext* ctx = pipeline->ctx;
+    const void* data = input;
+    size_t size = input_size;
+
+    for (NlinkPipelineStage* current = pipeline->first_stage; current; current = current->next) {
+        bool last = current->next == NULL;
+        size_t capacity = stage_declared_size(pipeline, current, size);
+        size_t reserve = capacity;
+        bool direct = last && (target->growable || capacity <= *target->capacity);
+        void* out;
+        NexusResult result;
+
+        if (iteration) {
+            nexus_log(ctx, NEXUS_LOG_DEBUG, "Iteration %u: Executing stage '%s'",
+                      iteration, current->name);
+        } else {
+            nexus_log(ctx, NEXUS_LOG_DEBUG, "Executing stage '%s'", current->name);
+        }
+
+        if (direct) {
+            if (target->growable && grow_target(target, capacity) != NEXUS_SUCCESS) {
+                nexus_log(ctx, NEXUS_LOG_ERROR, "Failed to grow output buffer to %zu bytes", capacity);
+                return NEXUS_OUT_OF_MEMORY;
+            }
+            out = *target->data;
+            capacity = *target->capacity;
+        } else {
+            if (!last && current->next->func &&
+                reserve < pipeline->config.stage_buffer_size) {
+                reserve = pipeline->config.stage_buffer_size;
+            }
+            out = nlink_arena_alloc(&pipeline->arena, reserve);
+            if (!out) {
+                nexus_log(ctx, NEXUS_LOG_ERROR, "Failed to allocate stage output buffer");
+                return NEXUS_OUT_OF_MEMORY;
+            }
+        }
+
+        size_t produced = 0;
+        result = run_stage(pipeline, current, data, size, out, capacity, &produced);
+        current->last_runs++;
+
+        /* The stage asked for a bigger buffer: grow it and run the stage again */
+        while (result == NEXUS_PARTIAL_SUCCESS && produced > capacity) {
+            nexus_log(ctx, NEXUS_LOG_DEBUG, "Stage '%s' needs %zu output bytes, had %zu",
+                      current->name, produced, capacity);
+
+            if (direct && target->growable) {
+                if (grow_target(target, produced) != NEXUS_SUCCESS) {
+                    return NEXUS_OUT_OF_MEMORY;
+                }
+                out = *target->data;
+                capacity = *target->capacity;
+            } else {
+                if (direct) {
+                    direct = false;
+                    out = nlink_arena_alloc(&pipeline->arena, produced);
+                } else {
+                    out = nlink_arena_grow(&pipeline->arena, out, reserve, produced);
+                }
+                if (!out) {
+                    nexus_log(ctx, NEXUS_LOG_ERROR, "Failed to allocate stage output buffer");
+                    return NEXUS_OUT_OF_MEMORY;
+                }
+                reserve = capacity = produced;
+            }
+
+            result = run_stage(pipeline, current, data, size, out, capacity, &produced);
+        }
+
         if (result != NEXUS_SUCCESS) {
-            nexus_log(ctx, NEXUS_LOG_ERROR, "Stage '%s' failed with result %d", 
-                      current->name, result);
-            break;
+            if (iteration) {
+                nexus_log(ctx, NEXUS_LOG_ERROR, "Stage '%s' failed with result %d in iteration %u",
+                          current->name, result, iteration);
+            } else {
+                nexus_log(ctx, NEXUS_LOG_ERROR, "Stage '%s' failed with result %d",
+                          current->name, result);
+            }
+            return result;
         }
-        
-        /* Prepare for next stage */
-        if (current->next) {
-            stage_input = stage_output;
+
+        if (!last) {
+            pad_for_stage(pipeline, current->next, out, produced);
         }
-        
-        current = current->next;
+
+        data = out;
+        size = produced;
     }
-    
-    /* Clean up intermediate buffer */
-    if (pipeline->stage_count > 1 && stage_output != output) {
-        free(stage_output);
+
+    if (data != *target->data) {
+        if (size > *target->capacity) {
+            *output_size = size;
+            return NEXUS_PARTIAL_SUCCESS;
+        }
+        memcpy(*target->data, data, size);
+    }
+
+    *output_size = size;
+    return NEXUS_SUCCESS;
+}
+
+static NexusResult execute_single_pass(NlinkPipeline* pipeline,
+                                       const void* input, size_t input_size,
+                                       void* output, size_t output_capacity,
+                                       size_t* output_size) {
+    StageTarget target = { &output, &output_capacity, false };
+    size_t buffer_size = pipeline->config.stage_buffer_size;
+
+    /* A legacy first stage reads stage_buffer_size bytes: hand it a padded copy */
+    if (pipeline->first_stage->func && input_size < buffer_size) {
+        void* padded = nlink_arena_alloc(&pipeline->arena, buffer_size);
+        if (!padded) {
+            nexus_log(pipeline->ctx, NEXUS_LOG_ERROR, "Failed to allocate stage input buffer");
+            return NEXUS_OUT_OF_MEMORY;
+        }
+        memcpy(padded, input, input_size);
+        pad_for_stage(pipeline, pipeline->first_stage, padded, input_size);
+        input = padded;
+    }
+
+    NexusResult result = run_stage_chain(pipeline, input, input_size, &target, output_size, 0);
+
+    if (result == NEXUS_PARTIAL_SUCCESS) {
+        nexus_log(pipeline->ctx, NEXUS_LOG_WARNING,
+                  "Pipeline output needs %zu bytes, output buffer holds %zu",
+                  *output_size, output_capacity);
     }
-    
     return result;
 }
 
-static NexusResult execute_multi_pass(NlinkPipeline* pipeline, void* input, void* output) {
+/* Whether every stage reports its changes */
+static bool all_stages_tracked(const NlinkPipeline* pipeline) {
+    for (const NlinkPipelineStage* stage = pipeline->first_stage; stage; stage = stage->next) {
+        if (!stage->tracked_func) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Multi-pass over change-tracking stages. The stages edit one state buffer
+ * in place; an iteration in which none of them changed anything is a
+ * fixed point, so convergence costs O(reported changes) rather than a
+ * comparison of the whole state. change_count advances whenever a stage
+ * changes the state, which lets the worklist skip stages that already saw
+ * the current state. A stage is stamped with the count it ran against, so
+ * one that changed the state runs again on its own output.
+ */
+static NexusResult execute_incremental(NlinkPipeline* pipeline,
+                                       const void* input, size_t input_size,
+                                       void* output, size_t output_capacity,
+                                       size_t* output_size) {
     NexusContext* ctx = pipeline->ctx;
     NexusResult result = NEXUS_SUCCESS;
     unsigned iterations = 0;
     bool converged = false;
+    uint64_t change_count = 1;
+    bool hash_known = false;
+    uint64_t state_hash = 0;
+    StageTarget state = { &pipeline->pass_buffers[0], &pipeline->pass_capacity[0], true };
     
-    /* Create two buffers for ping-pong processing */
-    void* buffer_a = malloc(1024);  /* Simplified: would use appropriate buffer size in real impl */
-    void* buffer_b = malloc(1024);
-    
-    if (!buffer_a || !buffer_b) {
+    if (grow_target(&state, input_size ? input_size : 1) != NEXUS_SUCCESS) {
         nexus_log(ctx, NEXUS_LOG_ERROR, "Failed to allocate processing buffers");
-        free(buffer_a);
-        free(buffer_b);
         return NEXUS_OUT_OF_MEMORY;
     }
+    memcpy(pipeline->pass_buffers[0], input, input_size);
     
-    /* Initialize buffer_a with input data */
-    memcpy(buffer_a, input, 1024);  /* Simplified; would use actual size */
+    /* Every stage starts out needing a run */
+    for (NlinkPipelineStage* stage = pipeline->first_stage; stage; stage = stage->next) {
+        stage->ran_at_change = 0;
+    }
     
-    /* Process until convergence or max iterations */
     while (!converged && iterations < pipeline->config.max_iterations) {
         iterations++;
-        void* source = (iterations % 2 == 1) ? buffer_a : buffer_b;
-        void* target = (iterations % 2 == 1) ? buffer_b : buffer_a;
+        bool changed_any = false;
         
-        /* Process each stage */
-        NlinkPipelineStage* current = pipeline->first_stage;
-        while (current && result == NEXUS_SUCCESS) {
-            nexus_log(ctx, NEXUS_LOG_DEBUG, "Iteration %u: Executing stage '%s'", 
+        for (NlinkPipelineStage* current = pipeline->first_stage; current; current = current->next) {
+            if (pipeline->config.enable_worklist && current->ran_at_change == change_count) {
+                current->last_skipped++;
+                continue;
+            }
+            
+            nexus_log(ctx, NEXUS_LOG_DEBUG, "Iteration %u: Executing stage '%s'",
                       iterations, current->name);
             
-            result = current->func(source, target, current->user_data);
+            /* A stage that changes the state has not seen its own output yet */
+            uint64_t seen = change_count;
+            NlinkStageChanges changes;
+            changes.range_count = 0;
+            changes.has_hash = false;
+            result = current->tracked_func(pipeline->pass_buffers[0], input_size,
+                                           &changes, current->user_data);
+            current->last_runs++;
             
             if (result != NEXUS_SUCCESS) {
-                nexus_log(ctx, NEXUS_LOG_ERROR, "Stage '%s' failed with result %d in iteration %u", 
+                nexus_log(ctx, NEXUS_LOG_ERROR, "Stage '%s' failed with result %d in iteration %u",
                           current->name, result, iterations);
                 break;
             }
             
-            current = current->next;
+            /* A reported hash settles whether the marked bytes really changed */
+            bool changed = changes.range_count > 0;
+            if (changes.has_hash) {
+                changed = !hash_known || changes.hash != state_hash;
+                state_hash = changes.hash;
+                hash_known = true;
+            } else if (changed) {
+                hash_known = false;
+            }
+            
+            for (size_t i = 0; i < changes.range_count; i++) {
+                pipeline->last_dirty_bytes += changes.ranges[i].length;
+            }
+            
+            if (changed) {
+                change_count++;
+                changed_any = true;
+            }
+            current->ran_at_change = seen;
         }
         
-        /* Check for convergence (simplified: would use actual comparison) */
-        if (iterations > 1) {
-            /* Compare source and target to detect convergence */
-            if (memcmp(source, target, 1024) == 0) {
-                converged = true;
-                nexus_log(ctx, NEXUS_LOG_INFO, "Pipeline converged after %u iterations", iterations);
-            }
+        if (result != NEXUS_SUCCESS) {
+            break;
+        }
+        
+        if (!changed_any) {
+            converged = true;
+            nexus_log(ctx, NEXUS_LOG_INFO, "Pipeline converged after %u iterations", iterations);
+        }
+    }
+    
+    if (result == NEXUS_SUCCESS) {
+        *output_size = input_size;
+        if (input_size > output_capacity) {
+            nexus_log(ctx, NEXUS_LOG_WARNING,
+                      "Pipeline output needs %zu bytes, output buffer holds %zu",
+                      input_size, output_capacity);
+            result = NEXUS_PARTIAL_SUCCESS;
+        } else {
+            memcpy(output, pipeline->pass_buffers[0], input_size);
+        }
+        
+        if (!converged) {
+            nexus_log(ctx, NEXUS_LOG_WARNING, "Pipeline reached maximum iterations (%u) without converging",
+                      pipeline->config.max_iterations);
+        }
+    }
+    
+    pipeline->last_iterations = iterations;
+    
+    return result;
+}
+
+static NexusResult execute_multi_pass(NlinkPipeline* pipeline,
+                                      const void* input, size_t input_size,
+                                      void* output, size_t output_capacity,
+                                      size_t* output_size) {
+    NexusContext* ctx = pipeline->ctx;
+    NexusResult result = NEXUS_SUCCESS;
+    unsigned iterations = 0;
+    bool converged = false;
+    size_t sizes[2] = { input_size, 0 };
+    unsigned current = 0;
+    size_t minimum = input_size > pipeline->config.stage_buffer_size ?
+                     input_size : pipeline->config.stage_buffer_size;
+    
+    if (all_stages_tracked(pipeline)) {
+        return execute_incremental(pipeline, input, input_size, output, output_capacity, output_size);
+    }
+    
+    /* Ping-pong state buffers are kept across executions and only ever grow */
+    for (unsigned i = 0; i < 2; i++) {
+        StageTarget target = { &pipeline->pass_buffers[i], &pipeline->pass_capacity[i], true };
+        if (grow_target(&target, minimum) != NEXUS_SUCCESS) {
+            nexus_log(ctx, NEXUS_LOG_ERROR, "Failed to allocate processing buffers");
+            return NEXUS_OUT_OF_MEMORY;
+        }
+    }
+    
+    memcpy(pipeline->pass_buffers[0], input, input_size);
+    pad_for_stage(pipeline, pipeline->first_stage, pipeline->pass_buffers[0], input_size);
+    
+    /* Process until convergence or max iterations */
+    while (!converged && iterations < pipeline->config.max_iterations) {
+        iterations++;
+        unsigned next = 1 - current;
+        StageTarget target = { &pipeline->pass_buffers[next], &pipeline->pass_capacity[next], true };
+        
+        /* Intermediates of the previous iteration are dead */
+        nlink_arena_reset(&pipeline->arena);
+        
+        result = run_stage_chain(pipeline, pipeline->pass_buffers[current], sizes[current],
+                                 &target, &sizes[next], iterations);
+        if (result != NEXUS_SUCCESS) {
+            break;
+        }
+        
+        /* Check for convergence */
+        if (iterations > 1 && sizes[current] == sizes[next] &&
+            memcmp(pipeline->pass_buffers[current], pipeline->pass_buffers[next], sizes[next]) == 0) {
+            converged = true;
+            nexus_log(ctx, NEXUS_LOG_INFO, "Pipeline converged after %u iterations", iterations);
         }
+        
+        pad_for_stage(pipeline, pipeline->first_stage, pipeline->pass_buffers[next], sizes[next]);
+        current = next;
     }
     
     /* Copy final result to output */
     if (result == NEXUS_SUCCESS) {
-        void* final_buffer = (iterations % 2 == 0) ? buffer_a : buffer_b;
-        memcpy(output, final_buffer, 1024);  /* Simplified; would use actual size */
+        *output_size = sizes[current];
+        if (sizes[current] > output_capacity) {
+            nexus_log(ctx, NEXUS_LOG_WARNING,
+                      "Pipeline output needs %zu bytes, output buffer holds %zu",
+                      sizes[current], output_capacity);
+            result = NEXUS_PARTIAL_SUCCESS;
+        } else {
+            memcpy(output, pipeline->pass_buffers[current], sizes[current]);
+        }
         
         if (!converged) {
             nexus_log(ctx, NEXUS_LOG_WARNING, "Pipeline reached maximum iterations (%u) without converging",
@@ -213,14 +593,22 @@ static NexusResult execute_multi_pass(NlinkPipeline* pipeline, void* input, void
     /* Store iteration count for statistics */
     pipeline->last_iterations = iterations;
     
-    /* Clean up */
-    free(buffer_a);
-    free(buffer_b);
-    
     return result;
 }
 
 NexusResult nlink_pipeline_execute(NlinkPipeline* pipeline, void* input, void* output) {
+    if (!pipeline) {
+        return NEXUS_INVALID_PARAMETER;
+    }
+    
+    return nlink_pipeline_execute_sized(pipeline, input, pipeline->config.stage_buffer_size,
+                                        output, pipeline->config.stage_buffer_size, NULL);
+}
+
+NexusResult nlink_pipeline_execute_sized(NlinkPipeline* pipeline,
+                                        const void* input, size_t input_size,
+                                        void* output, size_t output_capacity,
+                                        size_t* output_size) {
     if (!pipeline || !input || !output) {
         return NEXUS_INVALID_PARAMETER;
     }
@@ -228,6 +616,11 @@ NexusResult nlink_pipeline_execute(NlinkPipeline* pipeline, void* input, void* o
     NexusContext* ctx = pipeline->ctx;
     NexusResult result;
     struct timespec start, end;
+    size_t produced = 0;
+    
+    if (output_size) {
+        *output_size = 0;
+    }
     
     /* Check if we have any stages */
     if (!pipeline->first_stage) {
@@ -248,14 +641,23 @@ NexusResult nlink_pipeline_execute(NlinkPipeline* pipeline, void* input, void* o
     /* Start timing */
     clock_gettime(CLOCK_MONOTONIC, &start);
     
+    /* Buffers from the previous execution are dead */
+    nlink_arena_reset(&pipeline->arena);
+    
+    pipeline->last_dirty_bytes = 0;
+    for (NlinkPipelineStage* stage = pipeline->first_stage; stage; stage = stage->next) {
+        stage->last_runs = 0;
+        stage->last_skipped = 0;
+    }
+    
     /* Execute the pipeline based on the active mode */
     if (pipeline->active_mode == NLINK_PIPELINE_MODE_SINGLE_PASS) {
         nexus_log(ctx, NEXUS_LOG_INFO, "Executing pipeline in single-pass mode");
-        result = execute_single_pass(pipeline, input, output);
+        result = execute_single_pass(pipeline, input, input_size, output, output_capacity, &produced);
         pipeline->last_iterations = 1;  /* Always one iteration in single-pass mode */
     } else {
         nexus_log(ctx, NEXUS_LOG_INFO, "Executing pipeline in multi-pass mode");
-        result = execute_multi_pass(pipeline, input, output);
+        result = execute_multi_pass(pipeline, input, input_size, output, output_capacity, &produced);
     }
     
     /* End timing */
@@ -265,6 +667,11 @@ NexusResult nlink_pipeline_execute(NlinkPipeline* pipeline, void* input, void* o
     double time_ms = (end.tv_sec - start.tv_sec) * 1000.0 + 
                     (end.tv_nsec - start.tv_nsec) / 1000000.0;
     pipeline->last_execution_time_ms = time_ms;
+    pipeline->last_output_size = produced;
+    
+    if (output_size) {
+        *output_size = produced;
+    }
     
     nexus_log(ctx, NEXUS_LOG_INFO, "Pipeline execution completed in %.2f ms with %u iteration(s)",
               time_ms, pipeline->last_iterations);
@@ -282,7 +689,9 @@ NlinkPipelineMode nlink_pipeline_get_mode(const NlinkPipeline* pipeline) {
 
 NexusResult nlink_pipeline_get_stats(const NlinkPipeline* pipeline, 
                                    unsigned* iterations,
-                                   double* execution_time_ms) {
+                                   double* execution_time_ms,
+                                   NlinkPipelineStageStats* stage_stats,
+                                   size_t stage_stats_count) {
     if (!pipeline) {
         return NEXUS_INVALID_PARAMETER;
     }
@@ -295,6 +704,15 @@ NexusResult nlink_pipeline_get_stats(const NlinkPipeline* pipeline,
         *execution_time_ms = pipeline->last_execution_time_ms;
     }
     
+    if (stage_stats) {
+        const NlinkPipelineStage* stage = pipeline->first_stage;
+        for (size_t i = 0; i < stage_stats_count && stage; i++, stage = stage->next) {
+            stage_stats[i].name = stage->name;
+            stage_stats[i].runs = stage->last_runs;
+            stage_stats[i].skipped = stage->last_skipped;
+        }
+    }
+    
     return NEXUS_SUCCESS;
 }
 
@@ -312,6 +730,10 @@ void nlink_pipeline_destroy(NlinkPipeline* pipeline) {
         current = next;
     }
     
+    nlink_arena_destroy(&pipeline->arena);
+    free(pipeline->pass_buffers[0]);
+    free(pipeline->pass_buffers[1]);
+    
     /* Free the pipeline itself */
     free(pipeline);
-}
\ No newline at end of file
+}
\ No newline at end of file
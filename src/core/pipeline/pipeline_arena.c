@@ -0,0 +1,156 @@
+/**
+ * @file pipeline_arena.c
+ * @brief Bump arena for per-execution pipeline buffers
+ *
+ * Each block is one malloc holding the block header followed by its
+ * aligned payload. Filled blocks are chained through prev so a reset can
+ * release them.
+ *
+ * Copyright © 2025 OBINexus Computing
+ */
+
+#include "nlink/core/pipeline/pipeline_arena.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+static size_t align_up(size_t size) {
+    return (size + NLINK_ARENA_ALIGNMENT - 1) & ~(size_t)(NLINK_ARENA_ALIGNMENT - 1);
+}
+
+static NlinkArenaBlock* block_create(NlinkArena* arena, size_t capacity) {
+    NlinkArenaBlock* block = (NlinkArenaBlock*)malloc(sizeof(NlinkArenaBlock) +
+                                                      capacity + NLINK_ARENA_ALIGNMENT);
+    if (!block) {
+        return NULL;
+    }
+
+    uintptr_t start = (uintptr_t)(block + 1);
+    start = (start + NLINK_ARENA_ALIGNMENT - 1) & ~(uintptr_t)(NLINK_ARENA_ALIGNMENT - 1);
+
+    block->prev = NULL;
+    block->capacity = capacity;
+    block->used = 0;
+    block->data = (unsigned char*)start;
+    arena->block_allocations++;
+    return block;
+}
+
+static void free_blocks(NlinkArenaBlock* block) {
+    while (block) {
+        NlinkArenaBlock* prev = block->prev;
+        free(block);
+        block = prev;
+    }
+}
+
+void nlink_arena_init(NlinkArena* arena, size_t block_size) {
+    if (!arena) {
+        return;
+    }
+
+    memset(arena, 0, sizeof(NlinkArena));
+    arena->block_size = block_size ? block_size : NLINK_ARENA_DEFAULT_BLOCK_SIZE;
+}
+
+void* nlink_arena_alloc(NlinkArena* arena, size_t size) {
+    if (!arena) {
+        return NULL;
+    }
+
+    size_t needed = align_up(size ? size : 1);
+    NlinkArenaBlock* block = arena->current;
+
+    if (!block || block->capacity - block->used < needed) {
+        size_t block_size = arena->block_size ? arena->block_size : NLINK_ARENA_DEFAULT_BLOCK_SIZE;
+        /* Double with each block so a run needs O(log n) of them */
+        if (block && block->capacity > block_size) {
+            block_size = block->capacity;
+        }
+        if (block) {
+            block_size *= 2;
+        }
+        if (block_size < needed) {
+            block_size = needed;
+        }
+
+        NlinkArenaBlock* fresh = block_create(arena, block_size);
+        if (!fresh) {
+            return NULL;
+        }
+        fresh->prev = block;
+        arena->current = block = fresh;
+    }
+
+    void* ptr = block->data + block->used;
+    block->used += needed;
+    arena->used += needed;
+    return ptr;
+}
+
+void* nlink_arena_grow(NlinkArena* arena, void* ptr, size_t old_size, size_t new_size) {
+    if (!arena) {
+        return NULL;
+    }
+    if (!ptr) {
+        return nlink_arena_alloc(arena, new_size);
+    }
+    if (new_size <= old_size) {
+        return ptr;
+    }
+
+    NlinkArenaBlock* block = arena->current;
+    size_t old_aligned = align_up(old_size ? old_size : 1);
+    size_t new_aligned = align_up(new_size);
+
+    /* Last allocation of the current block: extend it where it is */
+    if (block && (unsigned char*)ptr + old_aligned == block->data + block->used &&
+        block->capacity - (block->used - old_aligned) >= new_aligned) {
+        block->used += new_aligned - old_aligned;
+        arena->used += new_aligned - old_aligned;
+        return ptr;
+    }
+
+    void* grown = nlink_arena_alloc(arena, new_size);
+    if (grown) {
+        memcpy(grown, ptr, old_size);
+    }
+    return grown;
+}
+
+void nlink_arena_reset(NlinkArena* arena) {
+    if (!arena || !arena->current) {
+        return;
+    }
+
+    if (arena->used > arena->high_water) {
+        arena->high_water = arena->used;
+    }
+    arena->used = 0;
+
+    NlinkArenaBlock* block = arena->current;
+    if (!block->prev && block->capacity >= arena->high_water) {
+        block->used = 0;
+        return;
+    }
+
+    /* Several blocks were needed: replace them with one that fits them all */
+    size_t capacity = arena->block_size ? arena->block_size : NLINK_ARENA_DEFAULT_BLOCK_SIZE;
+    if (capacity < arena->high_water) {
+        capacity = arena->high_water;
+    }
+
+    free_blocks(block);
+    arena->current = block_create(arena, capacity);
+}
+
+void nlink_arena_destroy(NlinkArena* arena) {
+    if (!arena) {
+        return;
+    }
+
+    free_blocks(arena->current);
+    arena->current = NULL;
+    arena->used = 0;
+    arena->high_water = 0;
+}
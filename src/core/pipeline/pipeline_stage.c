@@ -7,110 +7,217 @@
 #include "nlink/core/pipeline/pipeline_stage.h"
 #include "nlink/core/common/nexus_error.h"
 #include <stdlib.h>
+#include <string.h>
 
-// Context for composed stages
-typedef struct {
-    PipelineStage first;
-    PipelineStage second;
-} ComposedStageContext;
+// Smallest heap or arena allocation for a chain's entries
+#define STAGE_CHAIN_MIN_CAPACITY 8
 
-// Implementation of composed stage execution
-static NexusResult composed_stage_execute(NexusContext* ctx, NexusBuffer* buffer, void* state) {
-    ComposedStageContext* composed = (ComposedStageContext*)state;
-    
-    // Execute first stage
-    NexusResult result = composed->first(ctx, buffer);
+static NexusResult chain_error(NexusErrorCode code, const char* message) {
+    nexus_error* error = nexus_error_create(code, message, __FILE__, __LINE__);
+    return nexus_error_result(error, NULL);
+}
+
+// Make room for count more entries
+static NexusResult chain_reserve(StageChain* chain, size_t count) {
+    if (chain->capacity - chain->count >= count) {
+        return nexus_success(NULL, NULL);
+    }
+
+    // Caller storage is fixed
+    if (!chain->owns_entries && !chain->arena) {
+        return chain_error(NEXUS_ERROR_OUT_OF_MEMORY, "Stage chain storage is full");
+    }
+
+    size_t capacity = chain->capacity ? chain->capacity * 2 : STAGE_CHAIN_MIN_CAPACITY;
+    while (capacity - chain->count < count) {
+        capacity *= 2;
+    }
+
+    StageChainEntry* entries;
+    if (chain->arena) {
+        entries = (StageChainEntry*)nlink_arena_grow(chain->arena, chain->entries,
+                                                     chain->capacity * sizeof(StageChainEntry),
+                                                     capacity * sizeof(StageChainEntry));
+    } else {
+        entries = (StageChainEntry*)realloc(chain->entries, capacity * sizeof(StageChainEntry));
+    }
+    if (entries == NULL) {
+        return chain_error(NEXUS_ERROR_OUT_OF_MEMORY, "Failed to grow stage chain");
+    }
+
+    chain->entries = entries;
+    chain->capacity = capacity;
+    return nexus_success(NULL, NULL);
+}
+
+void stage_chain_init(StageChain* chain, StageChainEntry* storage, size_t capacity) {
+    if (chain == NULL) {
+        return;
+    }
+
+    chain->entries = storage;
+    chain->count = 0;
+    chain->capacity = storage != NULL ? capacity : 0;
+    chain->arena = NULL;
+    chain->owns_entries = storage == NULL;
+}
+
+void stage_chain_init_arena(StageChain* chain, NlinkArena* arena) {
+    if (chain == NULL) {
+        return;
+    }
+
+    stage_chain_init(chain, NULL, 0);
+    chain->arena = arena;
+    chain->owns_entries = false;
+}
+
+NexusResult stage_chain_push(StageChain* chain, PipelineStage stage) {
+    if (chain == NULL || stage == NULL) {
+        return chain_error(NEXUS_ERROR_INVALID_ARGUMENT, "Invalid stage chain or stage");
+    }
+
+    NexusResult result = chain_reserve(chain, 1);
     if (result.status != NEXUS_STATUS_SUCCESS) {
         return result;
     }
-    
-    // Execute second stage
-    return composed->second(ctx, buffer);
+
+    StageChainEntry* entry = &chain->entries[chain->count++];
+    entry->stage = stage;
+    entry->execute = NULL;
+    entry->internal_state = NULL;
+    return result;
 }
 
-// Wrapper for stateful stage execution
-static NexusResult stateful_stage_wrapper(NexusContext* ctx, NexusBuffer* buffer, void* state) {
-    StatefulStage* stage = (StatefulStage*)state;
-    return stage->execute(ctx, buffer, stage->internal_state);
+NexusResult stage_chain_push_stateful(StageChain* chain, const StatefulStage* stage) {
+    if (chain == NULL || stage == NULL || stage->execute == NULL) {
+        return chain_error(NEXUS_ERROR_INVALID_ARGUMENT, "Invalid stage chain or stateful stage");
+    }
+
+    NexusResult result = chain_reserve(chain, 1);
+    if (result.status != NEXUS_STATUS_SUCCESS) {
+        return result;
+    }
+
+    StageChainEntry* entry = &chain->entries[chain->count++];
+    entry->stage = NULL;
+    entry->execute = stage->execute;
+    entry->internal_state = stage->internal_state;
+    return result;
 }
 
-// Context for folded stages
-typedef struct {
-    PipelineStage* stages;
-    size_t count;
-} FoldedStageContext;
+NexusResult stage_chain_append(StageChain* chain, const StageChain* other) {
+    if (chain == NULL || other == NULL) {
+        return chain_error(NEXUS_ERROR_INVALID_ARGUMENT, "Invalid stage chain");
+    }
 
-// Implementation of folded stage execution
-static NexusResult folded_stage_execute(NexusContext* ctx, NexusBuffer* buffer, void* state) {
-    FoldedStageContext* folded = (FoldedStageContext*)state;
-    
-    for (size_t i = 0; i < folded->count; i++) {
-        NexusResult result = folded->stages[i](ctx, buffer);
-        if (result.status != NEXUS_STATUS_SUCCESS) {
-            return result;
-        }
+    // Appending a chain to itself: its entries may move while growing
+    size_t count = other->count;
+    NexusResult result = chain_reserve(chain, count);
+    if (result.status != NEXUS_STATUS_SUCCESS) {
+        return result;
     }
-    
-    return nexus_success(NULL, NULL);
+
+    memcpy(&chain->entries[chain->count], other->entries, count * sizeof(StageChainEntry));
+    chain->count += count;
+    return result;
 }
 
-// Static storage for composed stages (this is a simplification)
-static ComposedStageContext composed_contexts[32];
-static size_t composed_context_count = 0;
+NexusResult compose(StageChain* chain, PipelineStage a, PipelineStage b) {
+    if (chain == NULL || a == NULL || b == NULL) {
+        return chain_error(NEXUS_ERROR_INVALID_ARGUMENT, "Invalid stages to compose");
+    }
 
-// Static storage for folded stages (this is a simplification)
-static FoldedStageContext folded_contexts[16];
-static size_t folded_context_count = 0;
+    NexusResult result = chain_reserve(chain, 2);
+    if (result.status != NEXUS_STATUS_SUCCESS) {
+        return result;
+    }
+
+    stage_chain_push(chain, a);
+    return stage_chain_push(chain, b);
+}
 
-PipelineStage compose(PipelineStage a, PipelineStage b) {
-    if (a == NULL || b == NULL) {
-        return NULL;
+NexusResult fold(StageChain* chain, PipelineStage* stages, size_t count) {
+    if (chain == NULL || (stages == NULL && count > 0)) {
+        return chain_error(NEXUS_ERROR_INVALID_ARGUMENT, "Invalid stages to fold");
     }
-    
-    // In a real implementation, this would use dynamic allocation
-    if (composed_context_count >= 32) {
-        return NULL;  // No more space
+
+    NexusResult result = chain_reserve(chain, count);
+    for (size_t i = 0; i < count && result.status == NEXUS_STATUS_SUCCESS; i++) {
+        result = stage_chain_push(chain, stages[i]);
     }
-    
-    ComposedStageContext* context = &composed_contexts[composed_context_count++];
-    context->first = a;
-    context->second = b;
-    
-    // Create a static function that captures the context
-    // In a real implementation, this would be dynamically created
-    return (PipelineStage)composed_stage_execute;
+    return result;
 }
 
-PipelineStage fold(PipelineStage* stages, size_t count) {
-    if (stages == NULL || count == 0) {
-        return NULL;
+NexusResult stage_chain_compose(StageChain* chain, const StageChain* a, const StageChain* b) {
+    if (chain == NULL || a == NULL || b == NULL) {
+        return chain_error(NEXUS_ERROR_INVALID_ARGUMENT, "Invalid chains to compose");
     }
-    
-    // Special case for single stage
-    if (count == 1) {
-        return stages[0];
+
+    NexusResult result = chain_reserve(chain, a->count + b->count);
+    if (result.status != NEXUS_STATUS_SUCCESS) {
+        return result;
     }
-    
-    // In a real implementation, this would use dynamic allocation
-    if (folded_context_count >= 16) {
-        return NULL;  // No more space
+
+    // Both counts are read before either append, in case chain is a or b
+    size_t b_count = b->count;
+    result = stage_chain_append(chain, a);
+    if (result.status == NEXUS_STATUS_SUCCESS) {
+        memmove(&chain->entries[chain->count],
+                b == chain ? chain->entries : b->entries,
+                b_count * sizeof(StageChainEntry));
+        chain->count += b_count;
     }
-    
-    FoldedStageContext* context = &folded_contexts[folded_context_count++];
-    context->stages = malloc(count * sizeof(PipelineStage));
-    if (context->stages == NULL) {
-        return NULL;
+    return result;
+}
+
+NexusResult stage_chain_fold(StageChain* chain, const StageChain* chains, size_t count) {
+    if (chain == NULL || (chains == NULL && count > 0)) {
+        return chain_error(NEXUS_ERROR_INVALID_ARGUMENT, "Invalid chains to fold");
     }
-    
-    // Copy the stages
+
+    size_t total = 0;
     for (size_t i = 0; i < count; i++) {
-        context->stages[i] = stages[i];
+        total += chains[i].count;
     }
-    context->count = count;
-    
-    // Create a static function that captures the context
-    // In a real implementation, this would be dynamically created
-    return (PipelineStage)folded_stage_execute;
+
+    NexusResult result = chain_reserve(chain, total);
+    for (size_t i = 0; i < count && result.status == NEXUS_STATUS_SUCCESS; i++) {
+        result = stage_chain_append(chain, &chains[i]);
+    }
+    return result;
+}
+
+NexusResult stage_chain_execute(const StageChain* chain, NexusContext* ctx, NexusBuffer* buffer) {
+    if (chain == NULL) {
+        return chain_error(NEXUS_ERROR_INVALID_ARGUMENT, "Invalid stage chain");
+    }
+
+    const StageChainEntry* entry = chain->entries;
+    const StageChainEntry* end = entry + chain->count;
+    for (; entry < end; entry++) {
+        NexusResult result = entry->stage != NULL
+            ? entry->stage(ctx, buffer)
+            : entry->execute(ctx, buffer, entry->internal_state);
+        if (result.status != NEXUS_STATUS_SUCCESS) {
+            return result;
+        }
+    }
+
+    return nexus_success(NULL, NULL);
+}
+
+void stage_chain_destroy(StageChain* chain) {
+    if (chain == NULL) {
+        return;
+    }
+
+    if (chain->owns_entries) {
+        free(chain->entries);
+        chain->entries = NULL;
+        chain->capacity = 0;
+    }
+    chain->count = 0;
 }
 
 StatefulStage create_stateful_stage(
@@ -154,4 +261,4 @@ void free_stateful_stage(
     
     stage->internal_state = NULL;
     stage->execute = NULL;
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -3,171 +3,356 @@
 // Author: Nnamdi Michael Okpala
 
 
-#include "nlink/core/versioning/nexus_lazy_versioned.h"
-#include "nlink/core/versioning/nexus_version.h"
-#include "nlink/core/versioning/lazy_versioned.h"
+#include "nlink/core/semverx/nexus_lazy_versioned.h"
+#include "nlink/core/semverx/nexus_version.h"
+#include "nlink/core/semverx/lazy_versioned.h"
+#include "nlink/core/symbols/intern.h"
+#include <stdatomic.h>
 
+// Unload idle components after five minutes; the loader installs the handle registry
+NexusVersionedLazyConfig nexus_versioned_lazy_config = {
+    .auto_unload = true,
+    .unload_timeout_sec = 300
+};
+NexusHandleRegistry* nexus_handle_registry = NULL;
 
-// Enhanced implementation of nexus_check_unused_versioned_libraries
-// This implementation properly tracks component usage and performs unloading
-// when components have been unused for a specified timeout period
+// Usage record lifecycle
+enum {
+    NEXUS_USAGE_ACTIVE,     // Loaded; symbols may be pinned
+    NEXUS_USAGE_EVICTING,   // Chosen for unloading; new pins are refused
+    NEXUS_USAGE_EVICTED     // Unloaded; reactivated by nexus_component_usage_register
+};
 
+struct NexusComponentUsage {
+    const char* component_id;   // Interned component ID
+    void* handle;               // Library handle from the handle registry
+    _Atomic(time_t) last_used;  // Time of the latest use, 0 if never used
+    atomic_long live_refs;      // Outstanding pins
+    atomic_int state;           // NEXUS_USAGE_*
+    atomic_bool scheduled;      // Whether the record is in (or entering) the idle queue
+    time_t deadline;            // Idle-queue key, guarded by idle_mutex
+    bool queued;                // In the idle queue, guarded by idle_mutex
+};
+
+// Idle queue: a binary min-heap of records ordered by deadline. Touches
+// only update last_used, so a popped deadline may be stale; it is then
+// pushed back with the deadline implied by the current last_used.
+static NexusComponentUsage** idle_heap = NULL;
+static size_t idle_heap_count = 0;
+static size_t idle_heap_capacity = 0;
+
+// Every record ever registered, for lookup by component ID
+static NexusComponentUsage** usage_records = NULL;
+static size_t usage_record_count = 0;
+static size_t usage_record_capacity = 0;
+
+static pthread_mutex_t idle_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void idle_heap_swap(size_t a, size_t b) {
+    NexusComponentUsage* tmp = idle_heap[a];
+    idle_heap[a] = idle_heap[b];
+    idle_heap[b] = tmp;
+}
+
+// Caller holds idle_mutex
+static bool idle_heap_push(NexusComponentUsage* usage, time_t deadline) {
+    if (idle_heap_count == idle_heap_capacity) {
+        size_t new_capacity = idle_heap_capacity ? idle_heap_capacity * 2 : 64;
+        NexusComponentUsage** grown = (NexusComponentUsage**)realloc(
+            idle_heap, new_capacity * sizeof(NexusComponentUsage*));
+        if (!grown) {
+            return false;
+        }
+        idle_heap = grown;
+        idle_heap_capacity = new_capacity;
+    }
+    
+    usage->deadline = deadline;
+    usage->queued = true;
+    size_t i = idle_heap_count++;
+    idle_heap[i] = usage;
+    while (i > 0 && idle_heap[(i - 1) / 2]->deadline > idle_heap[i]->deadline) {
+        idle_heap_swap(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+    return true;
+}
+
+// Caller holds idle_mutex and has checked that the heap is not empty
+static NexusComponentUsage* idle_heap_pop(void) {
+    NexusComponentUsage* top = idle_heap[0];
+    top->queued = false;
+    idle_heap[0] = idle_heap[--idle_heap_count];
+    
+    size_t i = 0;
+    for (;;) {
+        size_t left = 2 * i + 1;
+        size_t smallest = i;
+        if (left < idle_heap_count && idle_heap[left]->deadline < idle_heap[smallest]->deadline) {
+            smallest = left;
+        }
+        if (left + 1 < idle_heap_count && idle_heap[left + 1]->deadline < idle_heap[smallest]->deadline) {
+            smallest = left + 1;
+        }
+        if (smallest == i) {
+            break;
+        }
+        idle_heap_swap(i, smallest);
+        i = smallest;
+    }
+    return top;
+}
+
+// Earliest time a component last used at last_used may be unloaded
+static time_t idle_deadline(time_t last_used) {
+    return last_used + nexus_versioned_lazy_config.unload_timeout_sec + 1;
+}
+
+// Caller holds idle_mutex
+static NexusComponentUsage* usage_find_locked(const char* interned_id) {
+    for (size_t i = 0; i < usage_record_count; i++) {
+        if (usage_records[i]->component_id == interned_id) {
+            return usage_records[i];
+        }
+    }
+    return NULL;
+}
+
+NexusComponentUsage* nexus_component_usage_register(const char* component_id, void* handle) {
+    const char* interned_id = component_id ? nexus_intern(component_id) : NULL;
+    if (!interned_id) {
+        return NULL;
+    }
+    
+    pthread_mutex_lock(&idle_mutex);
+    
+    NexusComponentUsage* usage = usage_find_locked(interned_id);
+    if (!usage) {
+        if (usage_record_count == usage_record_capacity) {
+            size_t new_capacity = usage_record_capacity ? usage_record_capacity * 2 : 64;
+            NexusComponentUsage** grown = (NexusComponentUsage**)realloc(
+                usage_records, new_capacity * sizeof(NexusComponentUsage*));
+            if (!grown) {
+                pthread_mutex_unlock(&idle_mutex);
+                return NULL;
+            }
+            usage_records = grown;
+            usage_record_capacity = new_capacity;
+        }
+        
+        usage = (NexusComponentUsage*)calloc(1, sizeof(NexusComponentUsage));
+        if (!usage) {
+            pthread_mutex_unlock(&idle_mutex);
+            return NULL;
+        }
+        usage->component_id = interned_id;
+        usage_records[usage_record_count++] = usage;
+    }
+    
+    // A component is only queued once it has been used
+    usage->handle = handle;
+    atomic_store(&usage->last_used, 0);
+    atomic_store(&usage->live_refs, 0);
+    atomic_store(&usage->state, NEXUS_USAGE_ACTIVE);
+    atomic_store(&usage->scheduled, false);
+    
+    pthread_mutex_unlock(&idle_mutex);
+    return usage;
+}
+
+NexusComponentUsage* nexus_component_usage_find(const char* component_id) {
+    const char* interned_id = component_id ? nexus_intern_lookup(component_id) : NULL;
+    if (!interned_id) {
+        return NULL;
+    }
+    
+    pthread_mutex_lock(&idle_mutex);
+    NexusComponentUsage* usage = usage_find_locked(interned_id);
+    pthread_mutex_unlock(&idle_mutex);
+    return usage;
+}
+
+void nexus_component_usage_touch(NexusComponentUsage* usage) {
+    if (!usage) return;
+    
+    time_t now = time(NULL);
+    atomic_store_explicit(&usage->last_used, now, memory_order_relaxed);
+    
+    // First use since registration: enter the idle queue
+    if (!atomic_load_explicit(&usage->scheduled, memory_order_relaxed) &&
+        !atomic_exchange(&usage->scheduled, true)) {
+        pthread_mutex_lock(&idle_mutex);
+        if (!usage->queued && !idle_heap_push(usage, idle_deadline(now))) {
+            atomic_store(&usage->scheduled, false);
+        }
+        pthread_mutex_unlock(&idle_mutex);
+    }
+}
+
+bool nexus_component_usage_acquire(NexusComponentUsage* usage) {
+    if (!usage) return false;
+    
+    // Pairs with the state/live_refs check in usage_begin_eviction
+    atomic_fetch_add(&usage->live_refs, 1);
+    if (atomic_load(&usage->state) != NEXUS_USAGE_ACTIVE) {
+        atomic_fetch_sub(&usage->live_refs, 1);
+        return false;
+    }
+    
+    nexus_component_usage_touch(usage);
+    return true;
+}
+
+void nexus_component_usage_release(NexusComponentUsage* usage) {
+    if (!usage) return;
+    
+    nexus_component_usage_touch(usage);
+    atomic_fetch_sub(&usage->live_refs, 1);
+}
+
+long nexus_component_usage_live_refs(const NexusComponentUsage* usage) {
+    return usage ? atomic_load(&((NexusComponentUsage*)usage)->live_refs) : 0;
+}
+
+bool nexus_component_usage_active(const NexusComponentUsage* usage) {
+    return usage && atomic_load(&((NexusComponentUsage*)usage)->state) == NEXUS_USAGE_ACTIVE;
+}
+
+// Claim an idle component for unloading; fails if it is pinned
+static bool usage_begin_eviction(NexusComponentUsage* usage) {
+    int expected = NEXUS_USAGE_ACTIVE;
+    if (!atomic_compare_exchange_strong(&usage->state, &expected, NEXUS_USAGE_EVICTING)) {
+        return false;
+    }
+    
+    if (atomic_load(&usage->live_refs) != 0) {
+        atomic_store(&usage->state, NEXUS_USAGE_ACTIVE);
+        return false;
+    }
+    return true;
+}
+
+void nexus_component_usage_cleanup(void) {
+    pthread_mutex_lock(&idle_mutex);
+    
+    for (size_t i = 0; i < usage_record_count; i++) {
+        free(usage_records[i]);
+    }
+    free(usage_records);
+    free(idle_heap);
+    usage_records = NULL;
+    usage_record_count = 0;
+    usage_record_capacity = 0;
+    idle_heap = NULL;
+    idle_heap_count = 0;
+    idle_heap_capacity = 0;
+    
+    pthread_mutex_unlock(&idle_mutex);
+}
+
+// Unload component libraries that have been idle for longer than the
+// configured timeout. Only components whose idle deadline has passed are
+// examined. Resolvers touch and pin components through atomics; the
+// registry lock is held only while each evicted component's entries are
+// dropped, and the handle registry mutex only to unlink each evicted handle.
 void nexus_check_unused_versioned_libraries(VersionedSymbolRegistry* registry) {
     if (!registry || !nexus_versioned_lazy_config.auto_unload) {
         return;  // Early return if registry is NULL or auto_unload is disabled
     }
     
-    // Get current time for timeout calculations
-    time_t now = time(NULL);
-    
-    // Get handle registry information (assuming we have access to it)
-    extern NexusHandleRegistry* nexus_handle_registry;
     if (!nexus_handle_registry) {
         return;  // Early return if handle registry is not initialized
     }
     
-    // Lock the handle registry for thread safety
-    pthread_mutex_lock(&nexus_handle_registry->mutex);
-    
-    printf("Checking for unused libraries in versioned context...\n");
-    
-    // Track libraries to unload (we can't modify the registry while iterating)
-    void** libs_to_unload = NULL;
-    char** paths_to_unload = NULL;
-    size_t unload_count = 0;
+    time_t now = time(NULL);
+    NexusComponentUsage** victims = NULL;
+    size_t victim_count = 0;
+    size_t victim_capacity = 0;
     
-    // First pass: identify libraries for potential unloading
-    for (size_t i = 0; i < nexus_handle_registry->count; i++) {
-        void* handle = nexus_handle_registry->handles[i];
-        const char* path = nexus_handle_registry->paths[i];
-        const char* component_id = nexus_handle_registry->components[i];
-        bool can_unload = true;
-        time_t last_used_time = 0;
+    // Pop expired deadlines; components touched or pinned since are requeued
+    pthread_mutex_lock(&idle_mutex);
+    while (idle_heap_count > 0 && idle_heap[0]->deadline <= now) {
+        NexusComponentUsage* usage = idle_heap_pop();
+        time_t last_used = atomic_load_explicit(&usage->last_used, memory_order_relaxed);
         
-        // Check if any symbols from this component are still in use
-        for (size_t j = 0; j < registry->exported.size; j++) {
-            VersionedSymbol* symbol = &registry->exported.symbols[j];
-            
-            if (strcmp(symbol->component_id, component_id) == 0) {
-                // If symbol is still referenced, we can't unload
-                if (symbol->ref_count > 0) {
-                    can_unload = false;
-                    break;
-                }
-                
-                // Track the most recent usage time
-                if (symbol->last_used > last_used_time) {
-                    last_used_time = symbol->last_used;
-                }
-            }
+        // Stale entry from a touch that raced with an earlier unload
+        if (atomic_load(&usage->state) == NEXUS_USAGE_EVICTED) {
+            continue;
         }
         
-        // Check if component has been unused for longer than the timeout
-        if (can_unload && 
-            last_used_time > 0 && 
-            (now - last_used_time) > nexus_versioned_lazy_config.unload_timeout_sec) {
-            
-            // Add to unload list
-            unload_count++;
-            libs_to_unload = (void**)realloc(libs_to_unload, unload_count * sizeof(void*));
-            paths_to_unload = (char**)realloc(paths_to_unload, unload_count * sizeof(char*));
-            
-            if (!libs_to_unload || !paths_to_unload) {
-                // Memory allocation failure
-                free(libs_to_unload);
-                free(paths_to_unload);
-                pthread_mutex_unlock(&nexus_handle_registry->mutex);
-                return;
+        if (idle_deadline(last_used) > now) {
+            idle_heap_push(usage, idle_deadline(last_used));
+            continue;
+        }
+        
+        if (!usage_begin_eviction(usage)) {
+            idle_heap_push(usage, idle_deadline(now));
+            continue;
+        }
+        
+        if (victim_count == victim_capacity) {
+            size_t new_capacity = victim_capacity ? victim_capacity * 2 : 8;
+            NexusComponentUsage** grown = (NexusComponentUsage**)realloc(
+                victims, new_capacity * sizeof(NexusComponentUsage*));
+            if (!grown) {
+                // Try again on the next check
+                atomic_store(&usage->state, NEXUS_USAGE_ACTIVE);
+                idle_heap_push(usage, now + 1);
+                break;
             }
-            
-            libs_to_unload[unload_count - 1] = handle;
-            paths_to_unload[unload_count - 1] = strdup(path);
-            
-            printf("Component '%s' will be unloaded (unused for %ld seconds)\n", 
-                   component_id, (now - last_used_time));
+            victims = grown;
+            victim_capacity = new_capacity;
         }
+        
+        atomic_store(&usage->scheduled, false);
+        victims[victim_count++] = usage;
+        
+        printf("Component '%s' will be unloaded (unused for %ld seconds)\n", 
+               usage->component_id, (long)(now - last_used));
     }
+    pthread_mutex_unlock(&idle_mutex);
     
-    // Second pass: unload identified libraries
-    if (unload_count > 0) {
-        printf("Unloading %zu unused libraries\n", unload_count);
+    if (victim_count == 0) {
+        free(victims);
+        return;
+    }
+    
+    // Drop what the evicted components provide or import from every table;
+    // each drop also invalidates cached resolutions that point at them
+    for (size_t i = 0; i < victim_count; i++) {
+        nexus_versioned_registry_drop_component(registry, victims[i]->component_id);
+    }
+    
+    for (size_t i = 0; i < victim_count; i++) {
+        NexusComponentUsage* usage = victims[i];
         
-        for (size_t i = 0; i < unload_count; i++) {
-            void* handle = libs_to_unload[i];
-            
-            // Find index in registry
-            size_t registry_index = SIZE_MAX;
-            for (size_t j = 0; j < nexus_handle_registry->count; j++) {
-                if (nexus_handle_registry->handles[j] == handle) {
-                    registry_index = j;
-                    break;
-                }
-            }
-            
-            if (registry_index != SIZE_MAX) {
-                // Get component ID before we remove it from registry
-                const char* component_id = nexus_handle_registry->components[registry_index];
-                
-                // Remove symbols from this component in exported table
-                for (size_t j = 0; j < registry->exported.size; j++) {
-                    VersionedSymbol* symbol = &registry->exported.symbols[j];
-                    
-                    if (strcmp(symbol->component_id, component_id) == 0) {
-                        // Mark for removal (will be cleaned up later)
-                        // In a real implementation, we'd need to handle this more efficiently
-                        free(symbol->name);
-                        free(symbol->version);
-                        free(symbol->component_id);
-                        symbol->name = NULL;
-                        symbol->address = NULL;
-                    }
-                }
-                
-                // Unload the library
-                dlclose(handle);
-                
-                // Remove from handle registry by swapping with the last element
-                free(nexus_handle_registry->paths[registry_index]);
-                free(nexus_handle_registry->components[registry_index]);
-                
-                if (registry_index < nexus_handle_registry->count - 1) {
-                    // Not the last element, swap with last
-                    nexus_handle_registry->handles[registry_index] = 
-                        nexus_handle_registry->handles[nexus_handle_registry->count - 1];
-                    nexus_handle_registry->paths[registry_index] = 
-                        nexus_handle_registry->paths[nexus_handle_registry->count - 1];
-                    nexus_handle_registry->components[registry_index] = 
-                        nexus_handle_registry->components[nexus_handle_registry->count - 1];
-                }
-                
-                // Decrease registry count
-                nexus_handle_registry->count--;
+        // Unlink the handle; swap the last entry into its place
+        pthread_mutex_lock(&nexus_handle_registry->mutex);
+        for (size_t j = 0; j < nexus_handle_registry->count; j++) {
+            if (nexus_handle_registry->handles[j] != usage->handle) {
+                continue;
             }
             
-            free(paths_to_unload[i]);
+            size_t last = nexus_handle_registry->count - 1;
+            free(nexus_handle_registry->paths[j]);
+            free(nexus_handle_registry->components[j]);
+            nexus_handle_registry->handles[j] = nexus_handle_registry->handles[last];
+            nexus_handle_registry->paths[j] = nexus_handle_registry->paths[last];
+            nexus_handle_registry->components[j] = nexus_handle_registry->components[last];
+            nexus_handle_registry->count--;
+            break;
         }
+        pthread_mutex_unlock(&nexus_handle_registry->mutex);
         
-        // Compact the exported symbols table to remove NULL entries
-        size_t write_index = 0;
-        for (size_t i = 0; i < registry->exported.size; i++) {
-            if (registry->exported.symbols[i].name != NULL) {
-                if (i != write_index) {
-                    registry->exported.symbols[write_index] = registry->exported.symbols[i];
-                }
-                write_index++;
-            }
+        if (usage->handle) {
+            dlclose(usage->handle);
+            usage->handle = NULL;
         }
-        registry->exported.size = write_index;
+        atomic_store(&usage->state, NEXUS_USAGE_EVICTED);
     }
     
-    // Clean up temporary arrays
-    free(libs_to_unload);
-    free(paths_to_unload);
-    
-    pthread_mutex_unlock(&nexus_handle_registry->mutex);
-    
-    printf("Library unloading complete. %zu libraries remain loaded.\n", 
-           nexus_handle_registry->count);
+    printf("Unloaded %zu unused libraries\n", victim_count);
+    free(victims);
 }
 
 // Utility to print version information for a symbol
@@ -210,6 +395,18 @@ void nexus_track_symbol_usage_versioned(
 ) {
     if (!registry || !symbol_name || !using_component) return;
     
+    // Refresh the providing component's idle deadline
+    pthread_mutex_lock(&registry->lock);
+    for (size_t i = 0; i < registry->exported.size; i++) {
+        VersionedSymbol* symbol = &registry->exported.symbols[i];
+        if (symbol->name && strcmp(symbol->name, symbol_name) == 0 &&
+            (!version || strcmp(symbol->version, version) == 0)) {
+            nexus_component_usage_touch(symbol->usage);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&registry->lock);
+    
     printf("[VERSIONED SYMBOL USAGE] Component '%s' is using symbol '%s'", 
            using_component, symbol_name);
     
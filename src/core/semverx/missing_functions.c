@@ -12,46 +12,8 @@
  #include "nlink/core/common/result.h"
  #include "nlink/core/common/nexus_core.h"
  
- /* Global configuration for versioned lazy loading */
- typedef struct {
-     bool auto_unload;                  /* Whether to automatically unload unused libraries */
-     time_t unload_timeout_sec;         /* Timeout in seconds for unloading unused libraries */
-     bool track_usage;                  /* Whether to track usage of symbols */
- } NexusVersionedLazyConfig;
- 
- /* Global configuration instance */
- static NexusVersionedLazyConfig g_nexus_versioned_lazy_config = {
-     .auto_unload = true,
-     .unload_timeout_sec = 300,  // 5 minutes default
-     .track_usage = true
- };
- 
- /**
-  * @brief Get the versioned lazy loading configuration
-  * 
-  * @return Pointer to the configuration structure
-  */
- NexusVersionedLazyConfig* nexus_versioned_lazy_config(void) {
-     return &g_nexus_versioned_lazy_config;
- }
- 
- /**
-  * @brief Handle registry for dynamically loaded components
-  * 
-  * This is a placeholder implementation that should be replaced with
-  * the actual implementation from the design documents.
-  * 
-  * @param ctx The NexusLink context
-  * @return NexusResult Result code
-  */
- NexusResult nexus_handle_registry(NexusContext* ctx) {
-     if (!ctx) {
-         return NEXUS_INVALID_PARAMETER;
-     }
-     
-     // Placeholder implementation
-     return NEXUS_SUCCESS;
- }
+ /* The versioned lazy loading configuration and handle registry are
+  * defined in lazy_versioned.c (see nlink/core/semverx/lazy_versioned.h) */
  
  /**
   * @brief Command implementation for stats command
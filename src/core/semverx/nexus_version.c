@@ -1,4 +1,4 @@
-#include "nlink/core/versioning/nexus_version.h"
+#include "nlink/core/semverx/nexus_version.h"
 
 /**
  * Parse a version string into a NexusVersion structure
@@ -102,8 +102,8 @@ int nexus_version_compare(const NexusVersion* a, const NexusVersion* b) {
     if (a->prerelease && !b->prerelease) return -1;  // Prerelease comes before release
     if (!a->prerelease && b->prerelease) return 1;   // Release comes after prerelease
     
-    // Both have prerelease, compare them lexically
-    return strcmp(a->prerelease, b->prerelease);
+    // Both have prerelease, compare them identifier by identifier
+    return semver_prerelease_compare(a->prerelease, b->prerelease);
 }
 
 /**
@@ -169,61 +169,142 @@ NexusVersionConstraint* nexus_version_constraint_parse(const char* constraint_st
 }
 
 /**
- * Check if a version satisfies a constraint
+ * Pack a version into its 64-bit integer form
  * 
- * @param version The version to check
- * @param constraint The constraint to check against
- * @return true if the version satisfies the constraint, false otherwise
+ * @param version The version to pack
+ * @param packed Receives the packed version; wildcard versions pack to 0
+ * @return true if the packed form is exact, false if it is lossy
  */
-bool nexus_version_satisfies(const NexusVersion* version, const NexusVersionConstraint* constraint) {
-    if (!version || !constraint || !constraint->version) return false;
+bool nexus_version_pack(const NexusVersion* version, SemVerPacked* packed) {
+    if (!version || version->major < 0) {
+        *packed = 0;
+        return true;
+    }
+    
+    bool exact;
+    *packed = semver_pack_parts(version->major, version->minor, version->patch, version->prerelease, &exact);
+    return exact;
+}
+
+/**
+ * Compile a constraint into packed version ranges
+ * 
+ * @param constraint The constraint to compile
+ * @param compiled Receives the compiled ranges
+ * @return true on success, false if the constraint is invalid
+ */
+bool nexus_version_constraint_compile(const NexusVersionConstraint* constraint, SemVerConstraint* compiled) {
+    if (!constraint || !constraint->version || !compiled) return false;
     
-    // Handle wildcard constraint
-    if (constraint->op == NEXUS_VERSION_OP_ANY) return true;
+    const NexusVersion* base = constraint->version;
+    SemVerPacked version;
+    bool exact = nexus_version_pack(base, &version);
+    SemVerRange range = { 0, SEMVER_PACKED_MAX };
     
-    // Compare according to operator
-    int comparison = nexus_version_compare(version, constraint->version);
+    compiled->exact = true;
     
     switch (constraint->op) {
+        case NEXUS_VERSION_OP_ANY:
+            break;
+        
         case NEXUS_VERSION_OP_EQ:
-            return comparison == 0;
+            range.min = version;
+            range.max = version;
+            break;
         
         case NEXUS_VERSION_OP_GT:
-            return comparison > 0;
+            if (version == SEMVER_PACKED_MAX) {
+                compiled->count = 0;
+                compiled->exact = exact;
+                return true;
+            }
+            range.min = version + 1;
+            break;
         
         case NEXUS_VERSION_OP_GE:
-            return comparison >= 0;
+            range.min = version;
+            break;
         
         case NEXUS_VERSION_OP_LT:
-            return comparison < 0;
+            if (version == 0) {
+                compiled->count = 0;
+                compiled->exact = exact;
+                return true;
+            }
+            range.max = version - 1;
+            break;
         
         case NEXUS_VERSION_OP_LE:
-            return comparison <= 0;
+            range.max = version;
+            break;
         
         case NEXUS_VERSION_OP_CARET:
-            // ^1.2.3 means >=1.2.3 <2.0.0
-            if (version->major != constraint->version->major) return false;
-            if (constraint->version->major == 0) {
-                // For 0.x.y, only allow exact minor version
-                if (version->minor != constraint->version->minor) return false;
-                // For 0.0.z, only allow exact patch version
-                if (constraint->version->minor == 0) {
-                    return version->patch >= constraint->version->patch;
-                } else {
-                    return version->patch >= constraint->version->patch;
-                }
-            }
-            return (comparison >= 0);
+            // ^1.2.3 means >=1.2.3 <2.0.0; ^0.2.3 means >=0.2.3 <0.3.0
+            range.min = version;
+            range.max = base->major == 0
+                ? semver_pack_parts(0, base->minor, 0xFFFF, NULL, NULL)
+                : semver_pack_parts(base->major, 0xFFFF, 0xFFFF, NULL, NULL);
+            break;
         
         case NEXUS_VERSION_OP_TILDE:
             // ~1.2.3 means >=1.2.3 <1.3.0
-            if (version->major != constraint->version->major) return false;
-            if (version->minor != constraint->version->minor) return false;
-            return version->patch >= constraint->version->patch;
+            range.min = version;
+            range.max = semver_pack_parts(base->major, base->minor, 0xFFFF, NULL, NULL);
+            break;
         
         default:
             return false;
     }
+    
+    compiled->count = 1;
+    compiled->exact = exact;
+    compiled->ranges[0] = range;
+    return true;
+}
+
+/**
+ * Check if a version satisfies a constraint
+ * 
+ * @param version The version to check
+ * @param constraint The constraint to check against
+ * @return true if the version satisfies the constraint, false otherwise
+ */
+bool nexus_version_satisfies(const NexusVersion* version, const NexusVersionConstraint* constraint) {
+    if (!version || !constraint) return false;
+    
+    SemVerConstraint compiled;
+    if (!nexus_version_constraint_compile(constraint, &compiled)) return false;
+    
+    SemVerPacked packed;
+    if (compiled.exact && nexus_version_pack(version, &packed)) {
+        return semver_constraint_matches(&compiled, packed);
+    }
+    
+    // Lossy packing: compare the versions themselves
+    const NexusVersion* base = constraint->version;
+    int cmp = nexus_version_compare(version, base);
+    
+    switch (constraint->op) {
+        case NEXUS_VERSION_OP_ANY:
+            return true;
+        case NEXUS_VERSION_OP_EQ:
+            return cmp == 0;
+        case NEXUS_VERSION_OP_GT:
+            return cmp > 0;
+        case NEXUS_VERSION_OP_GE:
+            return cmp >= 0;
+        case NEXUS_VERSION_OP_LT:
+            return cmp < 0;
+        case NEXUS_VERSION_OP_LE:
+            return cmp <= 0;
+        case NEXUS_VERSION_OP_CARET:
+            return cmp >= 0 && version->major == base->major &&
+                   (base->major != 0 || version->minor == base->minor);
+        case NEXUS_VERSION_OP_TILDE:
+            return cmp >= 0 && version->major == base->major && version->minor == base->minor;
+        default:
+            return false;
+    }
 }
 
 /**
@@ -2,7 +2,8 @@
 // Semantic versioning implementation for NexusLink
 // Author: Nnamdi Michael Okpala
 
-#include "nlink/core/versioning/semver.h"
+#include "nlink/core/semverx/semver.h"
+#include <errno.h>
 
 
 // Parse a semantic version string into components
@@ -91,77 +92,484 @@ int semver_compare(const SemVer* a, const SemVer* b) {
     
     // If both have pre-release versions, compare them
     if (a->prerelease && b->prerelease) {
-        return strcmp(a->prerelease, b->prerelease);
+        return semver_prerelease_compare(a->prerelease, b->prerelease);
     }
     
     // Build metadata doesn't affect version precedence
     return 0;
 }
 
-// Check if a version satisfies a constraint
-bool semver_satisfies(const char* version, const char* constraint) {
-    // Parse both versions
-    SemVer* ver = semver_parse(version);
-    if (!ver) return false;
-    
-    // Handle special constraints
-    if (strcmp(constraint, "*") == 0 || 
-        strcmp(constraint, "latest") == 0) {
-        semver_free(ver);
+// A version as written, before packing
+typedef struct {
+    unsigned long long components[3];
+    int parts;                  // Numeric components present; 3 if there is a prerelease
+    const char* prerelease;     // Points into the scanned string, NULL for a release
+    size_t prerelease_length;
+    bool wildcard;              // "*" or "latest", below every other version
+} SemVerScan;
+
+// One comparator of a constraint: operator and bound
+typedef struct {
+    char op[3];
+    bool any;                   // "*", "x" or "latest"; bound is unused
+    SemVerScan bound;
+} SemVerComparator;
+
+// Prerelease tags that pack exactly; first letters are distinct and in
+// the same order as the tags themselves
+static const char* const semver_exact_tags[] = { "alpha", "beta", "dev", "pre", "rc" };
+
+static bool semver_is_numeric(const char* identifier, size_t length) {
+    if (length == 0) return false;
+    for (size_t i = 0; i < length; i++) {
+        if (!isdigit((unsigned char)identifier[i])) return false;
+    }
+    return true;
+}
+
+// Numeric identifiers compare by value, others in ASCII order, and a
+// numeric identifier sorts below an alphanumeric one
+static int semver_identifier_compare(const char* a, size_t a_length, const char* b, size_t b_length) {
+    bool a_numeric = semver_is_numeric(a, a_length);
+    bool b_numeric = semver_is_numeric(b, b_length);
+    
+    if (a_numeric != b_numeric) return a_numeric ? -1 : 1;
+    
+    if (a_numeric) {
+        while (a_length > 1 && *a == '0') { a++; a_length--; }
+        while (b_length > 1 && *b == '0') { b++; b_length--; }
+        if (a_length != b_length) return a_length < b_length ? -1 : 1;
+    }
+    
+    size_t common = a_length < b_length ? a_length : b_length;
+    int cmp = memcmp(a, b, common);
+    if (cmp != 0) return cmp < 0 ? -1 : 1;
+    if (a_length != b_length) return a_length < b_length ? -1 : 1;
+    return 0;
+}
+
+// Compare dot-separated prerelease identifiers; a prefix sorts first
+static int semver_prerelease_compare_n(const char* a, size_t a_length, const char* b, size_t b_length) {
+    size_t i = 0, j = 0;
+    
+    for (;;) {
+        if (i >= a_length || j >= b_length) {
+            if (i >= a_length && j >= b_length) return 0;
+            return i >= a_length ? -1 : 1;
+        }
+        
+        size_t a_end = i, b_end = j;
+        while (a_end < a_length && a[a_end] != '.') a_end++;
+        while (b_end < b_length && b[b_end] != '.') b_end++;
+        
+        int cmp = semver_identifier_compare(a + i, a_end - i, b + j, b_end - j);
+        if (cmp != 0) return cmp;
+        
+        i = a_end + 1;
+        j = b_end + 1;
+    }
+}
+
+int semver_prerelease_compare(const char* a, const char* b) {
+    return semver_prerelease_compare_n(a, strlen(a), b, strlen(b));
+}
+
+// Full-precision comparison of two scanned versions
+static int semver_scan_compare(const SemVerScan* a, const SemVerScan* b) {
+    if (a->wildcard || b->wildcard) {
+        return (a->wildcard && b->wildcard) ? 0 : (a->wildcard ? -1 : 1);
+    }
+    
+    for (int i = 0; i < 3; i++) {
+        if (a->components[i] != b->components[i]) {
+            return a->components[i] < b->components[i] ? -1 : 1;
+        }
+    }
+    
+    if (!a->prerelease || !b->prerelease) {
+        return (!a->prerelease && !b->prerelease) ? 0 : (a->prerelease ? -1 : 1);
+    }
+    return semver_prerelease_compare_n(a->prerelease, a->prerelease_length,
+                                       b->prerelease, b->prerelease_length);
+}
+
+// Compare the first parts components only ("1.2" against 1.2.x)
+static int semver_scan_compare_prefix(const SemVerScan* version, const SemVerScan* bound, int parts) {
+    if (version->wildcard) return -1;
+    
+    for (int i = 0; i < parts; i++) {
+        if (version->components[i] != bound->components[i]) {
+            return version->components[i] < bound->components[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+// Prerelease ordinal: 5 bits of tag and 11 bits of numeric identifier
+// plus one (0 when there is none). Exact for a single numeric identifier,
+// or for one of semver_exact_tags optionally followed by a numeric
+// identifier; any other prerelease gets an approximate ordinal and
+// *exact is cleared.
+static uint64_t semver_prerelease_ordinal(const char* prerelease, size_t length, bool* exact) {
+    if (!prerelease) return SEMVER_RELEASE_ORDINAL;
+    
+    size_t first_end = 0;
+    while (first_end < length && prerelease[first_end] != '.') first_end++;
+    
+    uint64_t tag = 0;
+    const char* number = NULL;
+    size_t number_length = 0;
+    bool is_exact;
+    
+    if (semver_is_numeric(prerelease, first_end)) {
+        number = prerelease;
+        number_length = first_end;
+        is_exact = first_end == length;
+    } else {
+        if (isalpha((unsigned char)prerelease[0])) {
+            tag = (uint64_t)(tolower((unsigned char)prerelease[0]) - 'a' + 1);
+        }
+        
+        is_exact = false;
+        for (size_t i = 0; i < sizeof(semver_exact_tags) / sizeof(semver_exact_tags[0]); i++) {
+            if (strlen(semver_exact_tags[i]) == first_end &&
+                memcmp(semver_exact_tags[i], prerelease, first_end) == 0) {
+                is_exact = true;
+                break;
+            }
+        }
+        
+        if (first_end < length) {
+            number = prerelease + first_end + 1;
+            number_length = 0;
+            while (first_end + 1 + number_length < length && number[number_length] != '.') number_length++;
+            is_exact = is_exact && first_end + 1 + number_length == length &&
+                       semver_is_numeric(number, number_length);
+        }
+    }
+    
+    uint64_t value = 0;
+    if (number) {
+        for (size_t i = 0; i < number_length && isdigit((unsigned char)number[i]); i++) {
+            value = value * 10 + (uint64_t)(number[i] - '0');
+            if (value >= 0x7FF) {
+                value = 0x7FF;
+                is_exact = false;
+            }
+        }
+        value++;
+        if (value > 0x7FF) value = 0x7FF;
+    }
+    
+    if (!is_exact) *exact = false;
+    return (tag << 11) | value;
+}
+
+static uint64_t semver_clamp_component(unsigned long long value, bool* exact) {
+    if (value > 0xFFFF) {
+        *exact = false;
+        return 0xFFFF;
+    }
+    return (uint64_t)value;
+}
+
+static SemVerPacked semver_pack_ordinal(unsigned long long major, unsigned long long minor,
+                                        unsigned long long patch, uint64_t ordinal, bool* exact) {
+    return (semver_clamp_component(major, exact) << 48) |
+           (semver_clamp_component(minor, exact) << 32) |
+           (semver_clamp_component(patch, exact) << 16) |
+           ordinal;
+}
+
+SemVerPacked semver_pack_parts(long major, long minor, long patch, const char* prerelease, bool* exact) {
+    bool is_exact = major >= 0 && minor >= 0 && patch >= 0;
+    uint64_t ordinal = semver_prerelease_ordinal(prerelease, prerelease ? strlen(prerelease) : 0, &is_exact);
+    SemVerPacked packed = semver_pack_ordinal(major < 0 ? 0 : (unsigned long long)major,
+                                              minor < 0 ? 0 : (unsigned long long)minor,
+                                              patch < 0 ? 0 : (unsigned long long)patch,
+                                              ordinal, &is_exact);
+    if (exact) *exact = is_exact;
+    return packed;
+}
+
+// Pack a scanned version; returns false if the packed form is lossy
+static bool semver_scan_pack(const SemVerScan* scan, SemVerPacked* packed) {
+    bool exact = true;
+    
+    if (scan->wildcard) {
+        *packed = 0;  // Below every ordinal a real version can have
         return true;
     }
     
-    // Handle range constraints (simplified)
-    char* constraint_copy = strdup(constraint);
-    char* operator = constraint_copy;
+    uint64_t ordinal = semver_prerelease_ordinal(scan->prerelease, scan->prerelease_length, &exact);
+    *packed = semver_pack_ordinal(scan->components[0], scan->components[1], scan->components[2],
+                                  ordinal, &exact);
+    return exact;
+}
+
+// Parse "major[.minor[.patch]][-prerelease][+build]" starting at *cursor.
+// Stops at whitespace, '|' or the end of the string. Components that do
+// not fit in 64 bits are rejected.
+static bool semver_scan_version(const char** cursor, SemVerScan* scan) {
+    const char* p = *cursor;
+    int count = 0;
     
-    // Find the version part
-    while (*operator && !isdigit(*operator) && *operator != '*') operator++;
+    memset(scan, 0, sizeof(*scan));
     
-    // Extract the operator
-    char op_type[3] = {0};
-    if (operator > constraint_copy) {
-        size_t op_len = operator - constraint_copy;
-        if (op_len > 2) op_len = 2;
-        strncpy(op_type, constraint_copy, op_len);
+    while (count < 3) {
+        if (!isdigit((unsigned char)*p)) {
+            // "1.x" and "1.*" leave the remaining components open
+            if (count > 0 && (*p == 'x' || *p == 'X' || *p == '*')) {
+                p++;
+                break;
+            }
+            return false;
+        }
+        
+        char* end;
+        errno = 0;
+        scan->components[count++] = strtoull(p, &end, 10);
+        if (errno == ERANGE) return false;
+        p = end;
+        
+        if (*p != '.') break;
+        p++;
     }
     
-    // Parse the constraint version
-    SemVer* cons = semver_parse(operator);
-    if (!cons) {
-        free(constraint_copy);
-        semver_free(ver);
+    if (*p == '-') {
+        scan->prerelease = ++p;
+        while (*p && *p != '+' && *p != '|' && !isspace((unsigned char)*p)) p++;
+        scan->prerelease_length = (size_t)(p - scan->prerelease);
+    }
+    
+    // Build metadata does not affect precedence
+    if (*p == '+') {
+        while (*p && *p != '|' && !isspace((unsigned char)*p)) p++;
+    }
+    
+    if (*p && *p != '|' && !isspace((unsigned char)*p)) return false;
+    
+    scan->parts = scan->prerelease ? 3 : count;
+    *cursor = p;
+    return true;
+}
+
+// Scan a whole version string; "*" and "latest" are the wildcard version
+static bool semver_scan_string(const char* version, SemVerScan* scan) {
+    if (strcmp(version, "*") == 0 || strcmp(version, "latest") == 0) {
+        memset(scan, 0, sizeof(*scan));
+        scan->wildcard = true;
+        return true;
+    }
+    
+    const char* cursor = version;
+    return semver_scan_version(&cursor, scan) && *cursor == '\0';
+}
+
+bool semver_pack(const char* version, SemVerPacked* packed) {
+    if (!version || !packed) return false;
+    
+    SemVerScan scan;
+    return semver_scan_string(version, &scan) && semver_scan_pack(&scan, packed);
+}
+
+static bool semver_is_any(const char* p) {
+    if (*p == '*' || *p == 'x' || *p == 'X') {
+        p++;
+    } else if (strncmp(p, "latest", 6) == 0) {
+        p += 6;
+    } else {
+        return false;
+    }
+    return *p == '\0' || *p == '|' || isspace((unsigned char)*p);
+}
+
+// Parse one comparator starting at *cursor
+static bool semver_scan_comparator(const char** cursor, SemVerComparator* comparator) {
+    const char* p = *cursor;
+    
+    memset(comparator->op, 0, sizeof(comparator->op));
+    if (*p == '^' || *p == '~' || *p == '=') {
+        comparator->op[0] = *p++;
+    } else if (*p == '>' || *p == '<') {
+        comparator->op[0] = *p++;
+        if (*p == '=') comparator->op[1] = *p++;
+    }
+    while (isspace((unsigned char)*p)) p++;
+    
+    comparator->any = semver_is_any(p);
+    if (comparator->any) {
+        p += (*p == 'l') ? 6 : 1;
+    } else if (!semver_scan_version(&p, &comparator->bound)) {
         return false;
     }
     
-    // Do the comparison based on operator
-    bool result = false;
-    int cmp = semver_compare(ver, cons);
-    
-    if (op_type[0] == 0 || strcmp(op_type, "=") == 0) {
-        // Exact match
-        result = (cmp == 0);
-    } else if (strcmp(op_type, ">") == 0) {
-        result = (cmp > 0);
-    } else if (strcmp(op_type, ">=") == 0) {
-        result = (cmp >= 0);
-    } else if (strcmp(op_type, "<") == 0) {
-        result = (cmp < 0);
-    } else if (strcmp(op_type, "<=") == 0) {
-        result = (cmp <= 0);
-    } else if (strcmp(op_type, "^") == 0) {
-        // Compatible with: same major version, greater than or equal to specified version
-        result = (ver->major == cons->major && cmp >= 0);
-    } else if (strcmp(op_type, "~") == 0) {
-        // Compatible with: same major.minor version, greater than or equal to specified version
-        result = (ver->major == cons->major && ver->minor == cons->minor && cmp >= 0);
-    }
-    
-    free(constraint_copy);
-    semver_free(ver);
-    semver_free(cons);
-    
-    return result;
+    *cursor = p;
+    return true;
+}
+
+// Intersect a comparator into a packed range; returns false if its bound
+// does not pack exactly
+static bool semver_compile_comparator(const SemVerComparator* comparator, SemVerRange* range) {
+    SemVerRange term = { 0, SEMVER_PACKED_MAX };
+    const char* op = comparator->op;
+    bool exact = true;
+    
+    if (!comparator->any) {
+        SemVerPacked version;
+        exact = semver_scan_pack(&comparator->bound, &version);
+        
+        uint64_t major = version >> 48;
+        uint64_t minor = (version >> 32) & 0xFFFF;
+        int parts = comparator->bound.parts;
+        
+        // Upper bound of the versions a partial version stands for ("1.2" -> 1.2.*)
+        SemVerPacked partial_max = version;
+        if (parts == 1) {
+            partial_max = semver_pack_ordinal(major, 0xFFFF, 0xFFFF, SEMVER_RELEASE_ORDINAL, &exact);
+        } else if (parts == 2) {
+            partial_max = semver_pack_ordinal(major, minor, 0xFFFF, SEMVER_RELEASE_ORDINAL, &exact);
+        }
+        
+        if (op[0] == 0 || (op[0] == '=' && op[1] == 0)) {
+            term.min = version;
+            term.max = partial_max;
+        } else if (op[0] == '>' && op[1] == 0) {
+            if (partial_max == SEMVER_PACKED_MAX) {
+                term.min = 1;  // Nothing is above the maximum version
+                term.max = 0;
+            } else {
+                term.min = partial_max + 1;
+            }
+        } else if (op[0] == '>') {
+            term.min = version;
+        } else if (op[0] == '<' && op[1] == 0) {
+            if (version == 0) {
+                term.min = 1;  // Nothing is below the lowest version
+                term.max = 0;
+            } else {
+                term.max = version - 1;
+            }
+        } else if (op[0] == '<') {
+            term.max = partial_max;
+        } else if (op[0] == '^') {
+            // Same major version, at least the given version
+            term.min = version;
+            term.max = semver_pack_ordinal(major, 0xFFFF, 0xFFFF, SEMVER_RELEASE_ORDINAL, &exact);
+        } else {
+            // Same major.minor version, at least the given version
+            term.min = version;
+            term.max = semver_pack_ordinal(major, minor, 0xFFFF, SEMVER_RELEASE_ORDINAL, &exact);
+        }
+    }
+    
+    if (term.min > range->min) range->min = term.min;
+    if (term.max < range->max) range->max = term.max;
+    return exact;
+}
+
+// Same rules as semver_compile_comparator, on the full-precision form
+static bool semver_comparator_matches(const SemVerComparator* comparator, const SemVerScan* version) {
+    if (comparator->any) return true;
+    
+    const SemVerScan* bound = &comparator->bound;
+    const char* op = comparator->op;
+    int parts = bound->parts;
+    int cmp = semver_scan_compare(version, bound);
+    
+    // Partial bounds stand for every version with the same prefix
+    int partial_cmp = parts < 3 ? semver_scan_compare_prefix(version, bound, parts) : cmp;
+    bool same_major = !version->wildcard && version->components[0] == bound->components[0];
+    bool same_minor = same_major && version->components[1] == bound->components[1];
+    
+    if (op[0] == 0 || (op[0] == '=' && op[1] == 0)) return cmp >= 0 && partial_cmp == 0 && (parts < 3 || cmp == 0);
+    if (op[0] == '>' && op[1] == 0) return partial_cmp > 0;
+    if (op[0] == '>') return cmp >= 0;
+    if (op[0] == '<' && op[1] == 0) return cmp < 0;
+    if (op[0] == '<') return partial_cmp <= 0;
+    if (op[0] == '^') return cmp >= 0 && same_major;
+    return cmp >= 0 && same_minor;
+}
+
+// Evaluate a constraint that compiled without error against a version
+// that does not pack exactly, or vice versa
+static bool semver_satisfies_exact(const SemVerScan* version, const char* constraint) {
+    const char* p = constraint;
+    
+    for (;;) {
+        bool match = true;
+        
+        while (isspace((unsigned char)*p)) p++;
+        while (*p && *p != '|') {
+            SemVerComparator comparator;
+            if (!semver_scan_comparator(&p, &comparator)) return false;
+            match = match && semver_comparator_matches(&comparator, version);
+            while (isspace((unsigned char)*p)) p++;
+        }
+        
+        if (match) return true;
+        if (*p == '\0') return false;
+        p += 2;
+    }
+}
+
+// Check if a version satisfies a constraint
+bool semver_satisfies(const char* version, const char* constraint) {
+    if (!version || !constraint) return false;
+    
+    SemVerScan scan;
+    SemVerConstraint compiled;
+    if (!semver_scan_string(version, &scan) ||
+        !semver_constraint_compile(constraint, &compiled)) {
+        return false;
+    }
+    
+    SemVerPacked packed;
+    if (compiled.exact && semver_scan_pack(&scan, &packed)) {
+        return semver_constraint_matches(&compiled, packed);
+    }
+    
+    return semver_satisfies_exact(&scan, constraint);
+}
+
+bool semver_constraint_compile(const char* constraint, SemVerConstraint* compiled) {
+    if (!constraint || !compiled) return false;
+    
+    compiled->count = 0;
+    compiled->exact = true;
+    const char* p = constraint;
+    
+    for (;;) {
+        SemVerRange range = { 0, SEMVER_PACKED_MAX };
+        
+        // Comparators up to the next "||" are intersected
+        while (isspace((unsigned char)*p)) p++;
+        while (*p && *p != '|') {
+            SemVerComparator comparator;
+            if (!semver_scan_comparator(&p, &comparator)) return false;
+            if (!semver_compile_comparator(&comparator, &range)) {
+                compiled->exact = false;
+            }
+            while (isspace((unsigned char)*p)) p++;
+        }
+        
+        // Drop alternatives that can never match; past SEMVER_MAX_RANGES the
+        // ranges no longer cover the constraint, so leave it to the
+        // full-precision path
+        if (range.min <= range.max) {
+            if (compiled->count == SEMVER_MAX_RANGES) {
+                compiled->exact = false;
+            } else {
+                compiled->ranges[compiled->count++] = range;
+            }
+        }
+        
+        if (*p == '\0') break;
+        if (p[1] != '|') return false;
+        p += 2;
+    }
+    
+    return true;
 }
 
 // Free a semantic version structure
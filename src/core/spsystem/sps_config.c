@@ -117,6 +117,21 @@
                  // Parse optional flag
                  comp_config->optional = nexus_json_get_bool(comp_obj, "optional", false);
                  
+                 // Parse dependencies
+                 NexusJsonArray* deps_array = nexus_json_get_array(comp_obj, "dependencies");
+                 size_t dep_count = deps_array ? nexus_json_array_size(deps_array) : 0;
+                 if (dep_count > 0) {
+                     comp_config->dependencies = (const char**)calloc(dep_count, sizeof(char*));
+                     if (comp_config->dependencies) {
+                         for (size_t j = 0; j < dep_count; j++) {
+                             const char* dep_id = nexus_json_array_get_string(deps_array, j);
+                             if (dep_id) {
+                                 comp_config->dependencies[comp_config->dependency_count++] = strdup(dep_id);
+                             }
+                         }
+                     }
+                 }
+                 
                  // Parse component-specific configuration
                  NexusJsonObject* comp_config_obj = nexus_json_get_object(comp_obj, "config");
                  if (comp_config_obj && config->component_config_creator) {
@@ -266,6 +281,11 @@
      free((void*)config->component_id);
      free((void*)config->version_constraint);
      
+     for (size_t i = 0; i < config->dependency_count; i++) {
+         free((void*)config->dependencies[i]);
+     }
+     free((void*)config->dependencies);
+     
      // Free component-specific config using provided destructor
      if (config->component_config && destructor) {
          destructor(config->component_config);
@@ -335,6 +355,16 @@
              
              nexus_json_set_bool(comp_obj, "optional", comp_config->optional);
              
+             if (comp_config->dependency_count > 0) {
+                 NexusJsonArray* deps_array = nexus_json_create_array();
+                 if (deps_array) {
+                     for (size_t j = 0; j < comp_config->dependency_count; j++) {
+                         nexus_json_array_append_string(deps_array, comp_config->dependencies[j]);
+                     }
+                     nexus_json_set_array(comp_obj, "dependencies", deps_array);
+                 }
+             }
+             
              // TODO: Handle component-specific config serialization
              // This would require cooperation with the config creator/destructor
              
@@ -359,4 +389,4 @@
      }
      
      return result;
- }
\ No newline at end of file
+ }
\ No newline at end of file
@@ -110,26 +110,42 @@
          nexus_log(ctx, NEXUS_LOG_DEBUG, "Added node for component '%s'", comp_config->component_id);
      }
      
-     // Now that we have all nodes, establish dependencies
-     // In a real system, this would load each component and query its dependencies
-     // For simplicity, we'll just establish linear dependencies for now
+     // Components either all declare their dependencies or none do; in the
+     // latter case each one consumes the output of the one before it
+     bool declared = false;
+     for (size_t i = 0; i < graph->node_count; i++) {
+         NexusPipelineComponentConfig* comp_config = (NexusPipelineComponentConfig*)graph->nodes[i]->metadata;
+         if (comp_config->dependencies) {
+             declared = true;
+             break;
+         }
+     }
+     
      for (size_t i = 0; i < graph->node_count; i++) {
          NexusDependencyNode* node = graph->nodes[i];
+         NexusPipelineComponentConfig* comp_config = (NexusPipelineComponentConfig*)node->metadata;
          
-         // For demonstration, create dependencies between adjacent components
-         if (i > 0) {
-             // This component depends on the previous one
-             node->dependencies = (const char**)calloc(1, sizeof(char*));
-             if (!node->dependencies) {
-                 nexus_log(ctx, NEXUS_LOG_ERROR, "Failed to allocate dependencies array");
-                 return NEXUS_OUT_OF_MEMORY;
-             }
-             
+         size_t dep_count = declared ? comp_config->dependency_count : (i > 0 ? 1 : 0);
+         if (dep_count == 0) {
+             continue;
+         }
+         
+         node->dependencies = (const char**)calloc(dep_count, sizeof(char*));
+         if (!node->dependencies) {
+             nexus_log(ctx, NEXUS_LOG_ERROR, "Failed to allocate dependencies array");
+             return NEXUS_OUT_OF_MEMORY;
+         }
+         
+         if (declared) {
+             memcpy(node->dependencies, comp_config->dependencies, dep_count * sizeof(char*));
+         } else {
              node->dependencies[0] = graph->nodes[i-1]->component_id;
-             node->dependency_count = 1;
-             
+         }
+         node->dependency_count = dep_count;
+         
+         for (size_t j = 0; j < dep_count; j++) {
              nexus_log(ctx, NEXUS_LOG_DEBUG, "Component '%s' depends on '%s'", 
-                      node->component_id, node->dependencies[0]);
+                      node->component_id, node->dependencies[j]);
          }
      }
      
@@ -205,12 +221,8 @@
          }
      }
      
-     // Reverse the array to get dependency order (not reverse topological order)
-     for (size_t i = 0; i < sorted_count / 2; i++) {
-         const char* temp = sorted[i];
-         sorted[i] = sorted[sorted_count - i - 1];
-         sorted[sorted_count - i - 1] = temp;
-     }
+     // visit_node appends a node after its dependencies, so sorted is
+     // already in dependency order
      
      // Set output
      *ordered_components = sorted;
@@ -298,48 +310,286 @@
   * Detect cycles in the dependency graph
   */
  static NexusResult detect_cycles(NexusContext* ctx, NexusDependencyGraph* graph) {
-     // Reset visited flags
+     // Building a schedule visits every node once and fails on a cycle
+     NexusDependencySchedule* schedule = NULL;
+     NexusResult result = sps_build_dependency_schedule(ctx, graph, NULL, 0, &schedule);
+     sps_free_dependency_schedule(schedule);
+     return result;
+ }
+ 
+ /**
+  * Find the position of a component in a schedule order
+  */
+ static size_t find_order_index(const char** order, size_t order_count, const char* component_id) {
+     for (size_t i = 0; i < order_count; i++) {
+         if (order[i] && strcmp(order[i], component_id) == 0) {
+             return i;
+         }
+     }
+     return order_count;
+ }
+ 
+ /**
+  * Find a graph node by component ID
+  */
+ static NexusDependencyNode* find_node(NexusDependencyGraph* graph, const char* component_id) {
      for (size_t i = 0; i < graph->node_count; i++) {
-         graph->nodes[i]->visited = false;
-         graph->nodes[i]->temporary_mark = false;
+         if (strcmp(graph->nodes[i]->component_id, component_id) == 0) {
+             return graph->nodes[i];
+         }
+     }
+     return NULL;
+ }
+ 
+ /**
+  * Derive dependents, levels and level sets from a schedule's dependency
+  * edges (Kahn's algorithm)
+  */
+ static NexusResult finish_schedule(NexusContext* ctx, NexusDependencySchedule* schedule,
+                                   const char** order) {
+     size_t n = schedule->node_count;
+     size_t edge_count = schedule->dependency_offsets[n];
+     
+     schedule->dependent_offsets = (size_t*)calloc(n + 1, sizeof(size_t));
+     schedule->dependents = (size_t*)malloc((edge_count ? edge_count : 1) * sizeof(size_t));
+     schedule->levels = (size_t*)calloc(n ? n : 1, sizeof(size_t));
+     size_t* ready = (size_t*)malloc((n ? n : 1) * sizeof(size_t));
+     size_t* queue = (size_t*)malloc((n ? n : 1) * sizeof(size_t));
+     
+     if (!schedule->dependent_offsets || !schedule->dependents || !schedule->levels || !ready || !queue) {
+         free(ready);
+         free(queue);
+         return NEXUS_OUT_OF_MEMORY;
      }
      
-     // Check each node for cycles
-     for (size_t i = 0; i < graph->node_count; i++) {
-         if (!graph->nodes[i]->visited) {
-             // Use DFS to detect cycles
-             graph->nodes[i]->temporary_mark = true;
-             
-             for (size_t j = 0; j < graph->nodes[i]->dependency_count; j++) {
-                 const char* dep_id = graph->nodes[i]->dependencies[j];
-                 
-                 for (size_t k = 0; k < graph->node_count; k++) {
-                     if (strcmp(graph->nodes[k]->component_id, dep_id) == 0) {
-                         if (graph->nodes[k]->temporary_mark) {
-                             nexus_log(ctx, NEXUS_LOG_ERROR, 
-                                     "Dependency cycle detected: %s -> %s",
-                                     graph->nodes[i]->component_id, dep_id);
-                             return NEXUS_DEPENDENCY_CYCLE;
-                         }
-                         
-                         if (!graph->nodes[k]->visited) {
-                             NexusResult result = detect_cycles(ctx, graph);
-                             if (result != NEXUS_SUCCESS) {
-                                 return result;
-                             }
-                         }
-                     }
-                 }
+     // Invert the edges; visiting nodes in order keeps each dependent list sorted
+     for (size_t e = 0; e < edge_count; e++) {
+         schedule->dependent_offsets[schedule->dependencies[e] + 1]++;
+     }
+     for (size_t i = 0; i < n; i++) {
+         schedule->dependent_offsets[i + 1] += schedule->dependent_offsets[i];
+     }
+     memcpy(ready, schedule->dependent_offsets, n * sizeof(size_t));
+     for (size_t i = 0; i < n; i++) {
+         for (size_t e = schedule->dependency_offsets[i]; e < schedule->dependency_offsets[i + 1]; e++) {
+             schedule->dependents[ready[schedule->dependencies[e]]++] = i;
+         }
+     }
+     
+     // Peel off ready nodes, pushing each dependent one level above its deepest dependency
+     size_t head = 0;
+     size_t tail = 0;
+     for (size_t i = 0; i < n; i++) {
+         ready[i] = schedule->dependency_offsets[i + 1] - schedule->dependency_offsets[i];
+         if (ready[i] == 0) {
+             queue[tail++] = i;
+         }
+     }
+     
+     size_t max_level = 0;
+     while (head < tail) {
+         size_t node = queue[head++];
+         for (size_t e = schedule->dependent_offsets[node]; e < schedule->dependent_offsets[node + 1]; e++) {
+             size_t dependent = schedule->dependents[e];
+             if (schedule->levels[dependent] < schedule->levels[node] + 1) {
+                 schedule->levels[dependent] = schedule->levels[node] + 1;
+             }
+             if (--ready[dependent] == 0) {
+                 queue[tail++] = dependent;
+             }
+         }
+         if (schedule->levels[node] > max_level) {
+             max_level = schedule->levels[node];
+         }
+     }
+     
+     free(queue);
+     
+     if (tail < n) {
+         for (size_t i = 0; i < n; i++) {
+             if (ready[i] > 0) {
+                 nexus_log(ctx, NEXUS_LOG_ERROR, "Dependency cycle detected involving component '%s'",
+                          order[i]);
+                 break;
+             }
+         }
+         free(ready);
+         return NEXUS_DEPENDENCY_CYCLE;
+     }
+     free(ready);
+     
+     // Group nodes by level
+     schedule->level_count = n > 0 ? max_level + 1 : 0;
+     schedule->level_offsets = (size_t*)calloc(schedule->level_count + 1, sizeof(size_t));
+     schedule->level_nodes = (size_t*)malloc((n ? n : 1) * sizeof(size_t));
+     if (!schedule->level_offsets || !schedule->level_nodes) {
+         return NEXUS_OUT_OF_MEMORY;
+     }
+     
+     for (size_t i = 0; i < n; i++) {
+         schedule->level_offsets[schedule->levels[i] + 1]++;
+     }
+     for (size_t l = 0; l < schedule->level_count; l++) {
+         size_t width = schedule->level_offsets[l + 1];
+         if (width > schedule->max_level_width) {
+             schedule->max_level_width = width;
+         }
+         schedule->level_offsets[l + 1] += schedule->level_offsets[l];
+     }
+     
+     size_t* cursor = (size_t*)malloc((schedule->level_count ? schedule->level_count : 1) * sizeof(size_t));
+     if (!cursor) {
+         return NEXUS_OUT_OF_MEMORY;
+     }
+     memcpy(cursor, schedule->level_offsets, schedule->level_count * sizeof(size_t));
+     for (size_t i = 0; i < n; i++) {
+         schedule->level_nodes[cursor[schedule->levels[i]]++] = i;
+     }
+     free(cursor);
+     
+     return NEXUS_SUCCESS;
+ }
+ 
+ /**
+  * Build an execution schedule from a dependency graph
+  */
+ NexusResult sps_build_dependency_schedule(NexusContext* ctx,
+                                          NexusDependencyGraph* graph,
+                                          const char** order,
+                                          size_t order_count,
+                                          NexusDependencySchedule** schedule) {
+     if (!ctx || !graph || !schedule) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+     
+     *schedule = NULL;
+     
+     // Default to the graph's own node order
+     const char** graph_order = NULL;
+     if (!order) {
+         order_count = graph->node_count;
+         graph_order = (const char**)malloc((order_count ? order_count : 1) * sizeof(char*));
+         if (!graph_order) {
+             return NEXUS_OUT_OF_MEMORY;
+         }
+         for (size_t i = 0; i < order_count; i++) {
+             graph_order[i] = graph->nodes[i]->component_id;
+         }
+         order = graph_order;
+     }
+     
+     NexusDependencySchedule* result_schedule = 
+         (NexusDependencySchedule*)calloc(1, sizeof(NexusDependencySchedule));
+     if (!result_schedule) {
+         free(graph_order);
+         return NEXUS_OUT_OF_MEMORY;
+     }
+     result_schedule->node_count = order_count;
+     
+     // Count resolvable edges, then fill them in
+     result_schedule->dependency_offsets = (size_t*)calloc(order_count + 1, sizeof(size_t));
+     NexusResult result = result_schedule->dependency_offsets ? NEXUS_SUCCESS : NEXUS_OUT_OF_MEMORY;
+     
+     for (size_t i = 0; result == NEXUS_SUCCESS && i < order_count; i++) {
+         NexusDependencyNode* node = order[i] ? find_node(graph, order[i]) : NULL;
+         size_t resolved = 0;
+         for (size_t j = 0; node && j < node->dependency_count; j++) {
+             if (find_order_index(order, order_count, node->dependencies[j]) < order_count) {
+                 resolved++;
+             }
+         }
+         result_schedule->dependency_offsets[i + 1] = result_schedule->dependency_offsets[i] + resolved;
+     }
+     
+     if (result == NEXUS_SUCCESS) {
+         size_t edge_count = result_schedule->dependency_offsets[order_count];
+         result_schedule->dependencies = (size_t*)malloc((edge_count ? edge_count : 1) * sizeof(size_t));
+         if (!result_schedule->dependencies) {
+             result = NEXUS_OUT_OF_MEMORY;
+         }
+     }
+     
+     for (size_t i = 0; result == NEXUS_SUCCESS && i < order_count; i++) {
+         NexusDependencyNode* node = order[i] ? find_node(graph, order[i]) : NULL;
+         size_t edge = result_schedule->dependency_offsets[i];
+         for (size_t j = 0; node && j < node->dependency_count; j++) {
+             size_t index = find_order_index(order, order_count, node->dependencies[j]);
+             if (index < order_count) {
+                 result_schedule->dependencies[edge++] = index;
              }
-             
-             graph->nodes[i]->temporary_mark = false;
-             graph->nodes[i]->visited = true;
          }
      }
      
+     if (result == NEXUS_SUCCESS) {
+         result = finish_schedule(ctx, result_schedule, order);
+     }
+     
+     free(graph_order);
+     
+     if (result != NEXUS_SUCCESS) {
+         sps_free_dependency_schedule(result_schedule);
+         return result;
+     }
+     
+     nexus_log(ctx, NEXUS_LOG_DEBUG, 
+              "Schedule for %zu components has %zu levels, widest level %zu",
+              result_schedule->node_count, result_schedule->level_count, 
+              result_schedule->max_level_width);
+     
+     *schedule = result_schedule;
      return NEXUS_SUCCESS;
  }
  
+ /**
+  * Create a schedule in which each node depends on the one before it
+  */
+ NexusDependencySchedule* sps_create_sequential_schedule(size_t node_count) {
+     NexusDependencySchedule* schedule = 
+         (NexusDependencySchedule*)calloc(1, sizeof(NexusDependencySchedule));
+     if (!schedule) {
+         return NULL;
+     }
+     
+     schedule->node_count = node_count;
+     schedule->dependency_offsets = (size_t*)calloc(node_count + 1, sizeof(size_t));
+     schedule->dependencies = (size_t*)malloc((node_count ? node_count : 1) * sizeof(size_t));
+     if (!schedule->dependency_offsets || !schedule->dependencies) {
+         sps_free_dependency_schedule(schedule);
+         return NULL;
+     }
+     
+     for (size_t i = 1; i < node_count; i++) {
+         schedule->dependencies[i - 1] = i - 1;
+         schedule->dependency_offsets[i + 1] = i;
+     }
+     
+     // A chain cannot have a cycle, so this only fails when out of memory
+     if (finish_schedule(NULL, schedule, NULL) != NEXUS_SUCCESS) {
+         sps_free_dependency_schedule(schedule);
+         return NULL;
+     }
+     
+     return schedule;
+ }
+ 
+ /**
+  * Free an execution schedule
+  */
+ void sps_free_dependency_schedule(NexusDependencySchedule* schedule) {
+     if (!schedule) {
+         return;
+     }
+     
+     free(schedule->dependency_offsets);
+     free(schedule->dependencies);
+     free(schedule->dependent_offsets);
+     free(schedule->dependents);
+     free(schedule->levels);
+     free(schedule->level_offsets);
+     free(schedule->level_nodes);
+     free(schedule);
+ }
+ 
  /**
   * Check if there are any missing dependencies
   */
@@ -463,4 +713,4 @@
      
      // Free the graph itself
      free(graph);
- }
\ No newline at end of file
+ }
\ No newline at end of file
@@ -0,0 +1,568 @@
+/**
+ * @file sps_parallel.c
+ * @brief Dependency-parallel execution for single-pass systems
+ *
+ * Every schedule node carries a count of dependencies still running. The
+ * task that finishes a node decrements the counts of its dependents and
+ * submits the ones that reach zero to the thread pool, whose workers keep
+ * those submissions on their own deque; a chain of components therefore
+ * tends to stay on one worker while siblings are stolen by idle ones.
+ *
+ * Copyright © 2025 OBINexus Computing
+ */
+
+ #include "nlink/spsystem/sps_parallel.h"
+ #include "nlink/spsystem/sps_lifecycle.h"
+ #include "nlink/core/common/nexus_core.h"
+ #include "nlink/core/threading/thread_pool.h"
+ #include <pthread.h>
+ #include <stdatomic.h>
+ #include <stdint.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <time.h>
+
+ /**
+  * A schedule node: one component and the streams around it
+  */
+ typedef struct ParallelNode {
+     NexusParallelExecution* execution;
+     size_t index;
+     NexusPipelineComponent* component;
+     bool active;                         // Loaded and initialized; otherwise passes its input through
+     bool writes_output;                  // Only sink: writes the caller's output directly
+     size_t consumers;                    // Nodes reading this node's result
+     atomic_size_t pending;               // Dependencies still to complete
+     NexusDataStream* output;             // Owned output stream
+     NexusDataStream* merged;             // Owned fan-in stream, for nodes with several dependencies
+     NexusDataStream view;                // Read-only alias of a shared input
+     NexusDataStream* result;             // Stream holding this node's output once it completed
+     NexusResult failure;                 // Failed result, reported once the execution drained
+     double work_ms;                      // Time spent in the component
+ } ParallelNode;
+
+ struct NexusParallelExecution {
+     NexusContext* ctx;
+     NexusPipeline* pipeline;
+     const NexusDependencySchedule* schedule;
+     ParallelNode* nodes;
+     size_t node_count;
+     size_t root_count;
+     size_t* sinks;                       // Nodes nothing depends on, in pipeline order
+     size_t sink_count;
+     nlink_thread_pool_t* pool;
+     bool owns_pool;                      // False when running on the shared pool
+     nlink_task_group_t group;            // Node tasks of the running execution
+     char* stream_format;                 // Format of root outputs
+     NexusDataStream* input;              // Streams of the running execution
+     NexusDataStream* output;
+     atomic_bool cancelled;               // A component failed and partial processing is off
+     NexusResult first_failure;
+     pthread_mutex_t mutex;               // Guards first_failure
+     NexusParallelStats stats;
+ };
+
+ /* Forward declarations for internal functions */
+ static void run_node(void* arg);
+ static NexusResult prepare_nodes(NexusParallelExecution* execution);
+ static NexusResult assemble_output(NexusParallelExecution* execution);
+ static void compute_stats(NexusParallelExecution* execution, double wall_ms, uint64_t steals);
+ static double now_ms(void);
+
+ /**
+  * Pool counter of stolen tasks
+  */
+ static uint64_t pool_steals(const nlink_thread_pool_t* pool) {
+     nlink_thread_pool_stats_t stats;
+     return nlink_thread_pool_get_stats(pool, &stats) ? stats.steals : 0;
+ }
+
+ /**
+  * Start executing a pipeline on a thread pool
+  */
+ NexusParallelExecution* sps_parallel_start(NexusContext* ctx,
+                                           NexusPipeline* pipeline,
+                                           size_t worker_count) {
+     if (!ctx || !pipeline) {
+         return NULL;
+     }
+
+     if (!pipeline->schedule || pipeline->schedule->node_count != pipeline->component_count) {
+         nexus_log(ctx, NEXUS_LOG_ERROR, "Pipeline has no schedule for its components");
+         return NULL;
+     }
+
+     if (!pipeline->is_initialized) {
+         NexusResult result = sps_pipeline_initialize(ctx, pipeline);
+         if (result != NEXUS_SUCCESS) {
+             nexus_log(ctx, NEXUS_LOG_ERROR, "Failed to initialize pipeline: %d", result);
+             return NULL;
+         }
+     }
+
+     const NexusDependencySchedule* schedule = pipeline->schedule;
+
+     NexusParallelExecution* execution = (NexusParallelExecution*)calloc(1, sizeof(NexusParallelExecution));
+     if (!execution) {
+         return NULL;
+     }
+
+     execution->ctx = ctx;
+     execution->pipeline = pipeline;
+     execution->schedule = schedule;
+     execution->node_count = schedule->node_count;
+     execution->first_failure = NEXUS_SUCCESS;
+     nlink_task_group_init(&execution->group);
+
+     if (worker_count == 0) {
+         execution->pool = nlink_thread_pool_shared();
+     } else {
+         // More workers than the widest level can never all be busy
+         if (worker_count > schedule->max_level_width) {
+             worker_count = schedule->max_level_width > 0 ? schedule->max_level_width : 1;
+         }
+         nlink_thread_pool_config_t pool_config = nlink_thread_pool_default_config();
+         pool_config.worker_count = (uint32_t)worker_count;
+         execution->pool = nlink_thread_pool_create(&pool_config);
+         execution->owns_pool = true;
+     }
+
+     size_t n = execution->node_count;
+     execution->nodes = (ParallelNode*)calloc(n ? n : 1, sizeof(ParallelNode));
+     execution->sinks = (size_t*)calloc(n ? n : 1, sizeof(size_t));
+     execution->stream_format = strdup(pipeline->config && pipeline->config->input_format ?
+                                       pipeline->config->input_format : "binary");
+
+     if (!execution->pool || !execution->nodes || !execution->sinks || !execution->stream_format ||
+         pthread_mutex_init(&execution->mutex, NULL) != 0) {
+         if (execution->owns_pool) {
+             nlink_thread_pool_destroy(execution->pool);
+         }
+         free(execution->nodes);
+         free(execution->sinks);
+         free(execution->stream_format);
+         free(execution);
+         nexus_log(ctx, NEXUS_LOG_ERROR, "Failed to allocate parallel execution");
+         return NULL;
+     }
+
+     // Wire nodes to components and count who reads what
+     for (size_t i = 0; i < n; i++) {
+         ParallelNode* node = &execution->nodes[i];
+         node->execution = execution;
+         node->index = i;
+         node->component = pipeline->components[i];
+         node->active = node->component->is_initialized && node->component->component;
+         node->consumers = schedule->dependent_offsets[i + 1] - schedule->dependent_offsets[i];
+
+         if (schedule->dependency_offsets[i + 1] == schedule->dependency_offsets[i]) {
+             execution->root_count++;
+         }
+         if (node->consumers == 0) {
+             execution->sinks[execution->sink_count++] = i;
+         }
+     }
+
+     // A single active sink can produce the pipeline output itself
+     if (execution->sink_count == 1 && execution->nodes[execution->sinks[0]].active) {
+         execution->nodes[execution->sinks[0]].writes_output = true;
+     }
+
+     nexus_log(ctx, NEXUS_LOG_INFO,
+              "Running %zu components in %zu levels on %s pool of %zu workers",
+              n, schedule->level_count, execution->owns_pool ? "a private" : "the shared",
+              nlink_thread_pool_worker_count(execution->pool));
+
+     return execution;
+ }
+
+ /**
+  * Run one input through the pipeline
+  */
+ NexusResult sps_parallel_execute(NexusParallelExecution* execution,
+                                 NexusDataStream* input,
+                                 NexusDataStream* output) {
+     if (!execution || !input || !output) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+
+     // Components address input data directly; give a chunked input one buffer
+     NexusResult result = sps_stream_flatten(input);
+     if (result != NEXUS_SUCCESS) {
+         return result;
+     }
+
+     double start = now_ms();
+     uint64_t steals_before = pool_steals(execution->pool);
+     execution->input = input;
+     execution->output = output;
+
+     result = prepare_nodes(execution);
+     if (result != NEXUS_SUCCESS) {
+         nexus_log(execution->ctx, NEXUS_LOG_ERROR, "Failed to allocate component streams");
+         return result;
+     }
+
+     if (execution->node_count == 0) {
+         return NEXUS_SUCCESS;
+     }
+
+     // Roots start the cascade; every other node is submitted by its last dependency
+     const NexusDependencySchedule* schedule = execution->schedule;
+     size_t root_end = schedule->level_offsets[1];
+     for (size_t i = 0; i < root_end; i++) {
+         nlink_thread_pool_submit(execution->pool, run_node,
+                                  &execution->nodes[schedule->level_nodes[i]], &execution->group);
+     }
+     nlink_thread_pool_wait(execution->pool, &execution->group);
+
+     // Report failures from the calling thread, in pipeline order, so error
+     // handlers never run concurrently
+     for (size_t i = 0; i < execution->node_count; i++) {
+         ParallelNode* node = &execution->nodes[i];
+         if (node->failure != NEXUS_SUCCESS) {
+             sps_handle_pipeline_error(execution->ctx, execution->pipeline, node->failure,
+                                      node->component->component_id);
+         }
+     }
+
+     pthread_mutex_lock(&execution->mutex);
+     result = execution->first_failure;
+     pthread_mutex_unlock(&execution->mutex);
+
+     if (!atomic_load(&execution->cancelled)) {
+         NexusResult assemble_result = assemble_output(execution);
+         if (result == NEXUS_SUCCESS) {
+             result = assemble_result;
+         }
+     }
+
+     compute_stats(execution, now_ms() - start, pool_steals(execution->pool) - steals_before);
+
+     execution->input = NULL;
+     execution->output = NULL;
+     return result;
+ }
+
+ /**
+  * Reset per-execution node state and size the owned streams for the input
+  */
+ static NexusResult prepare_nodes(NexusParallelExecution* execution) {
+     const NexusDependencySchedule* schedule = execution->schedule;
+     size_t capacity = execution->input->capacity > 0 ? execution->input->capacity : 4096;
+
+     for (size_t i = 0; i < execution->node_count; i++) {
+         ParallelNode* node = &execution->nodes[i];
+         size_t dependency_count = schedule->dependency_offsets[i + 1] - schedule->dependency_offsets[i];
+
+         NexusDataStream** owned[2] = { NULL, NULL };
+         if (node->active && !node->writes_output) {
+             owned[0] = &node->output;
+         }
+         if (dependency_count > 1) {
+             owned[1] = &node->merged;
+         }
+
+         for (size_t k = 0; k < 2; k++) {
+             if (!owned[k]) {
+                 continue;
+             }
+             if (!*owned[k]) {
+                 *owned[k] = sps_stream_create(capacity);
+                 if (!*owned[k]) {
+                     return NEXUS_OUT_OF_MEMORY;
+                 }
+             } else if ((*owned[k])->capacity < capacity) {
+                 sps_stream_clear(*owned[k]);
+                 NexusResult result = sps_stream_resize(*owned[k], capacity);
+                 if (result != NEXUS_SUCCESS) {
+                     return result;
+                 }
+             }
+         }
+
+         atomic_store(&node->pending, dependency_count);
+         node->result = NULL;
+         node->failure = NEXUS_SUCCESS;
+         node->work_ms = 0.0;
+     }
+
+     atomic_store(&execution->cancelled, false);
+
+     pthread_mutex_lock(&execution->mutex);
+     execution->first_failure = NEXUS_SUCCESS;
+     pthread_mutex_unlock(&execution->mutex);
+     return NEXUS_SUCCESS;
+ }
+
+ /**
+  * Point a view at the unread part of a stream
+  */
+ static NexusDataStream* make_view(NexusDataStream* view, const NexusDataStream* source) {
+     nexus_metadata_destroy(&view->metadata);
+     memset(view, 0, sizeof(NexusDataStream));
+     view->data = (char*)source->data + source->position;
+     view->size = source->size - source->position;
+     view->capacity = view->size;
+     view->format = source->format;
+     view->owns_data = false;
+     view->backing = NEXUS_STREAM_CONTIGUOUS;
+     return view;
+ }
+
+ /**
+  * Find the stream a node reads, merging its dependencies' outputs if it has several
+  */
+ static NexusResult node_input(NexusParallelExecution* execution, size_t index, NexusDataStream** input) {
+     const NexusDependencySchedule* schedule = execution->schedule;
+     ParallelNode* node = &execution->nodes[index];
+     size_t first = schedule->dependency_offsets[index];
+     size_t count = schedule->dependency_offsets[index + 1] - first;
+
+     if (count == 0) {
+         *input = execution->root_count > 1 ? make_view(&node->view, execution->input) : execution->input;
+         return NEXUS_SUCCESS;
+     }
+
+     if (count == 1) {
+         ParallelNode* dependency = &execution->nodes[schedule->dependencies[first]];
+         *input = dependency->consumers > 1 ? make_view(&node->view, dependency->result) : dependency->result;
+         return NEXUS_SUCCESS;
+     }
+
+     // Fan-in: concatenate in declaration order so the result does not depend on timing
+     sps_stream_recycle(node->merged);
+     node->merged->format = "binary";
+     for (size_t e = first; e < first + count; e++) {
+         const NexusDataStream* source = execution->nodes[schedule->dependencies[e]].result;
+         if (source->size > source->position) {
+             NexusResult result = sps_stream_write(node->merged, (const char*)source->data + source->position,
+                                                   source->size - source->position);
+             if (result != NEXUS_SUCCESS) {
+                 return result;
+             }
+         }
+     }
+     node->merged->position = 0;
+
+     *input = node->merged;
+     return NEXUS_SUCCESS;
+ }
+
+ /**
+  * Run one node's component
+  */
+ static NexusResult execute_node(NexusParallelExecution* execution, size_t index) {
+     ParallelNode* node = &execution->nodes[index];
+     NexusPipelineComponent* component = node->component;
+
+     NexusDataStream* input = NULL;
+     NexusResult result = node_input(execution, index, &input);
+     if (result != NEXUS_SUCCESS) {
+         // Only merging fails; dependents see what was merged
+         node->result = node->merged;
+         return result;
+     }
+
+     // Components that were not loaded pass their input through
+     if (!node->active) {
+         node->result = input;
+         return NEXUS_SUCCESS;
+     }
+
+     NexusDataStream* target = node->writes_output ? execution->output : node->output;
+     if (target != execution->output) {
+         sps_stream_recycle(target);
+         target->format = execution->schedule->levels[index] == 0 ? execution->stream_format : "binary";
+     }
+
+     // In-place components edit their own copy; their input may be shared
+     if (component->process_in_place) {
+         result = sps_stream_copy_data(target, input);
+         input = target;
+     }
+
+     double start = now_ms();
+     if (result == NEXUS_SUCCESS) {
+         result = sps_component_execute(execution->ctx, component, input, target);
+     }
+     node->work_ms = now_ms() - start;
+
+     component->last_execution_time_ms = node->work_ms;
+     component->last_result = result;
+
+     // The output is read from the start by whoever consumes it
+     if (target != execution->output) {
+         target->position = 0;
+     }
+     node->result = target;
+     return result;
+ }
+
+ /**
+  * Pool task: run a node, then submit the dependents it was holding back
+  */
+ static void run_node(void* arg) {
+     ParallelNode* node = (ParallelNode*)arg;
+     NexusParallelExecution* execution = node->execution;
+     const NexusDependencySchedule* schedule = execution->schedule;
+     size_t index = node->index;
+
+     if (!atomic_load(&execution->cancelled)) {
+         NexusResult result = execute_node(execution, index);
+         if (result != NEXUS_SUCCESS) {
+             node->failure = result;
+
+             pthread_mutex_lock(&execution->mutex);
+             if (execution->first_failure == NEXUS_SUCCESS) {
+                 execution->first_failure = result;
+             }
+             pthread_mutex_unlock(&execution->mutex);
+
+             // Stop dispatching if not allowing partial processing
+             if (!execution->pipeline->config->allow_partial_processing) {
+                 nexus_log(execution->ctx, NEXUS_LOG_ERROR,
+                          "Stopping pipeline execution due to component failure");
+                 atomic_store(&execution->cancelled, true);
+             }
+         }
+     }
+
+     // Skipped nodes still release their dependents so the group drains
+     for (size_t e = schedule->dependent_offsets[index]; e < schedule->dependent_offsets[index + 1]; e++) {
+         ParallelNode* dependent = &execution->nodes[schedule->dependents[e]];
+         if (atomic_fetch_sub(&dependent->pending, 1) == 1) {
+             nlink_thread_pool_submit(execution->pool, run_node, dependent, &execution->group);
+         }
+     }
+ }
+
+ /**
+  * Concatenate the sinks' outputs into the caller's output, unless the
+  * only sink wrote there directly
+  */
+ static NexusResult assemble_output(NexusParallelExecution* execution) {
+     NexusDataStream* output = execution->output;
+     if (execution->sink_count == 1 && execution->nodes[execution->sinks[0]].result == output) {
+         return NEXUS_SUCCESS;
+     }
+
+     if (execution->sink_count == 1) {
+         return sps_stream_copy_data(output, execution->nodes[execution->sinks[0]].result);
+     }
+
+     sps_stream_clear(output);
+     for (size_t i = 0; i < execution->sink_count; i++) {
+         const NexusDataStream* source = execution->nodes[execution->sinks[i]].result;
+         if (source->size > source->position) {
+             NexusResult result = sps_stream_write(output, (const char*)source->data + source->position,
+                                                   source->size - source->position);
+             if (result != NEXUS_SUCCESS) {
+                 return result;
+             }
+         }
+     }
+     output->position = 0;
+
+     return NEXUS_SUCCESS;
+ }
+
+ /**
+  * Measure total work against the critical path
+  */
+ static void compute_stats(NexusParallelExecution* execution, double wall_ms, uint64_t steals) {
+     const NexusDependencySchedule* schedule = execution->schedule;
+     NexusParallelStats* stats = &execution->stats;
+
+     stats->component_count = execution->node_count;
+     stats->level_count = schedule->level_count;
+     stats->max_level_width = schedule->max_level_width;
+     stats->worker_count = nlink_thread_pool_worker_count(execution->pool);
+     stats->total_work_ms = 0.0;
+     stats->critical_path_ms = 0.0;
+     stats->wall_ms = wall_ms;
+     stats->steals = (size_t)steals;
+
+     // Level order is a topological order; finish[i] is the longest chain ending at i
+     double* finish = (double*)calloc(execution->node_count ? execution->node_count : 1, sizeof(double));
+     for (size_t k = 0; k < execution->node_count; k++) {
+         size_t i = schedule->level_nodes[k];
+         double work = execution->nodes[i].work_ms;
+         stats->total_work_ms += work;
+
+         if (!finish) {
+             continue;
+         }
+         double longest = 0.0;
+         for (size_t e = schedule->dependency_offsets[i]; e < schedule->dependency_offsets[i + 1]; e++) {
+             if (finish[schedule->dependencies[e]] > longest) {
+                 longest = finish[schedule->dependencies[e]];
+             }
+         }
+         finish[i] = longest + work;
+         if (finish[i] > stats->critical_path_ms) {
+             stats->critical_path_ms = finish[i];
+         }
+     }
+     free(finish);
+
+     stats->parallelism = stats->critical_path_ms > 0.0 ?
+                          stats->total_work_ms / stats->critical_path_ms : 1.0;
+ }
+
+ /**
+  * Get the parallelism report for the last execution
+  */
+ NexusResult sps_parallel_get_stats(const NexusParallelExecution* execution,
+                                   NexusParallelStats* stats) {
+     if (!execution || !stats) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+
+     *stats = execution->stats;
+     return NEXUS_SUCCESS;
+ }
+
+ /**
+  * Stop a private pool and free the execution
+  */
+ void sps_parallel_destroy(NexusParallelExecution* execution) {
+     if (!execution) {
+         return;
+     }
+
+     // Only a private pool is stopped; the shared one outlives the execution
+     if (execution->owns_pool) {
+         nlink_thread_pool_destroy(execution->pool);
+     }
+
+     for (size_t i = 0; i < execution->node_count; i++) {
+         ParallelNode* node = &execution->nodes[i];
+         // Formats point at execution-owned or static strings
+         if (node->output) {
+             node->output->format = NULL;
+             sps_stream_destroy(node->output);
+         }
+         if (node->merged) {
+             node->merged->format = NULL;
+             sps_stream_destroy(node->merged);
+         }
+         nexus_metadata_destroy(&node->view.metadata);
+     }
+
+     pthread_mutex_destroy(&execution->mutex);
+
+     free(execution->nodes);
+     free(execution->sinks);
+     free(execution->stream_format);
+     free(execution);
+ }
+
+ /**
+  * Monotonic time in milliseconds
+  */
+ static double now_ms(void) {
+     struct timespec ts;
+     clock_gettime(CLOCK_MONOTONIC, &ts);
+     return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+ }
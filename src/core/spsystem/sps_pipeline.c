@@ -22,14 +22,29 @@
  static NexusResult initialize_components(NexusContext* ctx, NexusPipeline* pipeline);
  static NexusResult execute_component(NexusContext* ctx, 
                                      NexusPipelineComponent* component,
-                                     NexusDataStream* input,
-                                     NexusDataStream* output);
+                                     NexusDataStream** inputs,
+                                     NexusDataStream** outputs,
+                                     size_t count);
+ static NexusResult execute_stages(NexusContext* ctx, 
+                                  NexusPipeline* pipeline, 
+                                  NexusDataStream** inputs, 
+                                  NexusDataStream** outputs,
+                                  size_t count);
  static NexusResult terminate_components(NexusContext* ctx, NexusPipeline* pipeline);
  static void default_error_handler(NexusPipeline* pipeline, 
                                   NexusResult result, 
                                   const char* component_id, 
                                   const char* message);
  static NexusResult abort_components(NexusContext* ctx, NexusPipeline* pipeline);
+ static NexusResult prepare_stream_ring(NexusPipeline* pipeline, 
+                                       NexusDataStream** inputs, 
+                                       size_t count);
+ static void destroy_stream_ring(NexusPipeline* pipeline);
+ static void recycle_stream_batch(NexusPipeline* pipeline, 
+                                 NexusDataStream** streams, 
+                                 size_t count, 
+                                 bool first_output);
+ static NexusResult copy_stream_batch(NexusDataStream** dst, NexusDataStream** src, size_t count);
  
  /**
   * Create a new pipeline from configuration
@@ -131,10 +146,29 @@
          pipeline->components[pipeline->component_count++] = component;
      }
      
+     // Keep the dependency edges for parallel execution, indexed like components
+     const char** component_ids = (const char**)calloc(
+         pipeline->component_count ? pipeline->component_count : 1, sizeof(char*)
+     );
+     if (component_ids) {
+         for (size_t i = 0; i < pipeline->component_count; i++) {
+             component_ids[i] = pipeline->components[i]->component_id;
+         }
+         result = sps_build_dependency_schedule(ctx, graph, component_ids, 
+                                                pipeline->component_count, &pipeline->schedule);
+         free(component_ids);
+     }
+     
      // Clean up
      free(ordered_components);
      sps_free_dependency_graph(graph);
      
+     if (!pipeline->schedule) {
+         nexus_log(ctx, NEXUS_LOG_ERROR, "Failed to build component schedule");
+         sps_pipeline_destroy(ctx, pipeline);
+         return NULL;
+     }
+     
      nexus_log(ctx, NEXUS_LOG_INFO, "Created pipeline with %zu components", 
               pipeline->component_count);
      
@@ -234,6 +268,13 @@
              ctx, component->component, process_symbol
          );
          
+         // The batched variant is optional
+         snprintf(process_symbol, sizeof(process_symbol), "%s_process_batch", 
+                 component->component_id);
+         component->process_batch_func = (NexusProcessBatchFunc)nexus_resolve_component_symbol(
+             ctx, component->component, process_symbol
+         );
+         
          if (!component->process_func) {
              nexus_log(ctx, NEXUS_LOG_ERROR, 
                       "Failed to resolve processing function for component '%s'", 
@@ -305,13 +346,14 @@
  }
  
  /**
-  * Execute a component
+  * Execute a component over a batch of input/output stream pairs
   */
  static NexusResult execute_component(NexusContext* ctx, 
                                      NexusPipelineComponent* component,
-                                     NexusDataStream* input,
-                                     NexusDataStream* output) {
-     if (!component || !input || !output) {
+                                     NexusDataStream** inputs,
+                                     NexusDataStream** outputs,
+                                     size_t count) {
+     if (!component || !inputs || !outputs) {
          return NEXUS_INVALID_PARAMETER;
      }
      
@@ -320,14 +362,25 @@
          return NEXUS_SUCCESS;
      }
      
-     nexus_log(ctx, NEXUS_LOG_DEBUG, "Executing component '%s'", component->component_id);
+     nexus_log(ctx, NEXUS_LOG_DEBUG, "Executing component '%s' on %zu item(s)", 
+              component->component_id, count);
      
      // Record start time
      struct timespec start, end;
      clock_gettime(CLOCK_MONOTONIC, &start);
      
-     // Execute the component
-     NexusResult result = sps_component_execute(ctx, component, input, output);
+     // Execute the component, falling back to the per-item callback
+     NexusResult result = NEXUS_SUCCESS;
+     if (component->process_batch_func) {
+         result = component->process_batch_func(component, inputs, outputs, count);
+     } else {
+         for (size_t i = 0; i < count; i++) {
+             NexusResult item_result = sps_component_execute(ctx, component, inputs[i], outputs[i]);
+             if (item_result != NEXUS_SUCCESS && result == NEXUS_SUCCESS) {
+                 result = item_result;
+             }
+         }
+     }
      
      // Record end time
      clock_gettime(CLOCK_MONOTONIC, &end);
@@ -352,6 +405,21 @@
      return result;
  }
  
+ /**
+  * Make sure the pipeline is initialized before execution
+  */
+ static NexusResult ensure_initialized(NexusContext* ctx, NexusPipeline* pipeline) {
+     if (pipeline->is_initialized) {
+         return NEXUS_SUCCESS;
+     }
+     
+     NexusResult result = sps_pipeline_initialize(ctx, pipeline);
+     if (result != NEXUS_SUCCESS) {
+         nexus_log(ctx, NEXUS_LOG_ERROR, "Failed to initialize pipeline: %d", result);
+     }
+     return result;
+ }
+ 
  /**
   * Execute the pipeline with input data
   */
@@ -363,59 +431,130 @@
          return NEXUS_INVALID_PARAMETER;
      }
      
+     // Components address input data directly; give a chunked input one buffer
+     NexusResult flatten_result = sps_stream_flatten(input);
+     if (flatten_result != NEXUS_SUCCESS) {
+         return flatten_result;
+     }
+     
      nexus_log(ctx, NEXUS_LOG_INFO, "Executing pipeline '%s'", 
               pipeline->pipeline_id ? pipeline->pipeline_id : "unnamed");
      
      // Make sure pipeline is initialized
-     if (!pipeline->is_initialized) {
-         NexusResult result = sps_pipeline_initialize(ctx, pipeline);
-         if (result != NEXUS_SUCCESS) {
-             nexus_log(ctx, NEXUS_LOG_ERROR, "Failed to initialize pipeline: %d", result);
-             return result;
-         }
+     NexusResult result = ensure_initialized(ctx, pipeline);
+     if (result != NEXUS_SUCCESS) {
+         return result;
      }
      
      // Record start time
      struct timespec start, end;
      clock_gettime(CLOCK_MONOTONIC, &start);
      
-     // Create intermediate streams for component communication
-     NexusDataStream** streams = NULL;
+     // A single execution is a batch of one
+     result = execute_stages(ctx, pipeline, &input, &output, 1);
      
-     if (pipeline->component_count > 1) {
-         streams = (NexusDataStream**)calloc(pipeline->component_count - 1, sizeof(NexusDataStream*));
-         if (!streams) {
-             nexus_log(ctx, NEXUS_LOG_ERROR, "Failed to allocate intermediate streams");
-             return NEXUS_OUT_OF_MEMORY;
+     // Record end time
+     clock_gettime(CLOCK_MONOTONIC, &end);
+     
+     // Calculate execution time
+     double elapsed_ms = (end.tv_sec - start.tv_sec) * 1000.0 + 
+                       (end.tv_nsec - start.tv_nsec) / 1000000.0;
+     
+     nexus_log(ctx, NEXUS_LOG_INFO, 
+              "Pipeline executed in %.2f ms", elapsed_ms);
+     
+     return result;
+ }
+ 
+ /**
+  * Execute the pipeline over a batch of inputs
+  */
+ NexusResult sps_pipeline_execute_batch(NexusContext* ctx, 
+                                       NexusPipeline* pipeline, 
+                                       NexusDataStream** inputs, 
+                                       NexusDataStream** outputs,
+                                       size_t count) {
+     if (!ctx || !pipeline || !inputs || !outputs) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+     
+     for (size_t i = 0; i < count; i++) {
+         if (!inputs[i] || !outputs[i]) {
+             return NEXUS_INVALID_PARAMETER;
          }
-         
-         // Initialize intermediate streams
-         for (size_t i = 0; i < pipeline->component_count - 1; i++) {
-             streams[i] = sps_stream_create(input->capacity > 0 ? input->capacity : 4096);
-             if (!streams[i]) {
-                 // Free already allocated streams
-                 for (size_t j = 0; j < i; j++) {
-                     sps_stream_destroy(streams[j]);
-                 }
-                 free(streams);
-                 
-                 nexus_log(ctx, NEXUS_LOG_ERROR, "Failed to create intermediate stream %zu", i);
-                 return NEXUS_OUT_OF_MEMORY;
-             }
-             
-             // Set format based on component outputs/inputs
-             if (i == 0 && pipeline->config->input_format) {
-                 streams[i]->format = strdup(pipeline->config->input_format);
-             } else {
-                 // In a real system, we'd determine this from component metadata
-                 streams[i]->format = strdup("binary");
-             }
+     }
+     
+     // Components address input data directly; give chunked inputs one buffer
+     for (size_t i = 0; i < count; i++) {
+         NexusResult flatten_result = sps_stream_flatten(inputs[i]);
+         if (flatten_result != NEXUS_SUCCESS) {
+             return flatten_result;
+         }
+     }
+     
+     if (count == 0) {
+         return NEXUS_SUCCESS;
+     }
+     
+     nexus_log(ctx, NEXUS_LOG_INFO, "Executing pipeline '%s' on %zu inputs", 
+              pipeline->pipeline_id ? pipeline->pipeline_id : "unnamed", count);
+     
+     // Make sure pipeline is initialized
+     NexusResult result = ensure_initialized(ctx, pipeline);
+     if (result != NEXUS_SUCCESS) {
+         return result;
+     }
+     
+     // Record start time
+     struct timespec start, end;
+     clock_gettime(CLOCK_MONOTONIC, &start);
+     
+     result = execute_stages(ctx, pipeline, inputs, outputs, count);
+     
+     // Record end time
+     clock_gettime(CLOCK_MONOTONIC, &end);
+     
+     // Calculate execution time
+     double elapsed_ms = (end.tv_sec - start.tv_sec) * 1000.0 + 
+                       (end.tv_nsec - start.tv_nsec) / 1000000.0;
+     
+     nexus_log(ctx, NEXUS_LOG_INFO, 
+              "Pipeline executed %zu inputs in %.2f ms", count, elapsed_ms);
+     
+     return result;
+ }
+ 
+ /**
+  * Run every component over the batch, one component at a time
+  */
+ static NexusResult execute_stages(NexusContext* ctx, 
+                                  NexusPipeline* pipeline, 
+                                  NexusDataStream** inputs, 
+                                  NexusDataStream** outputs,
+                                  size_t count) {
+     // Intermediate streams come from the pipeline's ring; they are only
+     // (re)allocated on first use or when the inputs outgrow them
+     NexusResult result = prepare_stream_ring(pipeline, inputs, count);
+     if (result != NEXUS_SUCCESS) {
+         nexus_log(ctx, NEXUS_LOG_ERROR, "Failed to allocate intermediate streams");
+         return result;
+     }
+     
+     // Find the last runnable component; it writes to the pipeline outputs
+     size_t last_active = pipeline->component_count;
+     for (size_t i = pipeline->component_count; i > 0; i--) {
+         NexusPipelineComponent* component = pipeline->components[i - 1];
+         if (component->is_initialized && component->component) {
+             last_active = i - 1;
+             break;
          }
      }
      
      // Process each component
-     NexusResult result = NEXUS_SUCCESS;
      NexusResult final_result = NEXUS_SUCCESS;
+     NexusDataStream** current = inputs;  // Streams holding the latest data
+     size_t ring_next = 0;                // Ring slot not holding current
+     bool first_output = true;
      
      for (size_t i = 0; i < pipeline->component_count; i++) {
          NexusPipelineComponent* component = pipeline->components[i];
@@ -425,28 +564,57 @@
              continue;
          }
          
-         // Determine input/output streams
-         NexusDataStream* comp_input;
-         NexusDataStream* comp_output;
-         
-         if (i == 0) {
-             // First component uses pipeline input
-             comp_input = input;
-         } else {
-             // Use previous intermediate stream
-             comp_input = streams[i-1];
-         }
+         bool is_last = (i == last_active);
+         NexusDataStream** comp_inputs;
+         NexusDataStream** comp_outputs;
          
-         if (i == pipeline->component_count - 1) {
-             // Last component outputs to pipeline output
-             comp_output = output;
+         if (component->process_in_place) {
+             // Edit the current streams directly. The caller's inputs are never
+             // modified, and the last component must end up in the outputs.
+             NexusDataStream** target = current;
+             if (is_last && current != outputs) {
+                 target = outputs;
+             } else if (current == inputs) {
+                 target = pipeline->stream_ring[ring_next];
+                 recycle_stream_batch(pipeline, target, count, first_output);
+             }
+             
+             if (target != current) {
+                 result = copy_stream_batch(target, current, count);
+                 if (result != NEXUS_SUCCESS) {
+                     nexus_log(ctx, NEXUS_LOG_ERROR, "Failed to forward streams to component '%s'",
+                              component->component_id);
+                     final_result = result;
+                     break;
+                 }
+                 if (target != outputs) {
+                     ring_next ^= 1;
+                 }
+             }
+             
+             comp_inputs = target;
+             comp_outputs = target;
+         } else if (is_last) {
+             comp_inputs = current;
+             comp_outputs = outputs;
          } else {
-             // Output to intermediate stream
-             comp_output = streams[i];
+             comp_inputs = current;
+             comp_outputs = pipeline->stream_ring[ring_next];
+             recycle_stream_batch(pipeline, comp_outputs, count, first_output);
+             ring_next ^= 1;
          }
+         first_output = false;
          
          // Execute component
-         result = execute_component(ctx, component, comp_input, comp_output);
+         result = execute_component(ctx, component, comp_inputs, comp_outputs, count);
+         
+         // The outputs become the next component's inputs, read from the start
+         current = comp_outputs;
+         if (current != outputs) {
+             for (size_t j = 0; j < count; j++) {
+                 current[j]->position = 0;
+             }
+         }
          
          if (result != NEXUS_SUCCESS) {
              // Handle error
@@ -465,32 +633,123 @@
              } else {
                  nexus_log(ctx, NEXUS_LOG_WARNING, 
                           "Continuing pipeline execution despite component failure");
-                 result = NEXUS_SUCCESS; // Reset result to allow continued execution
              }
          }
      }
      
-     // Record end time
-     clock_gettime(CLOCK_MONOTONIC, &end);
+     return final_result;
+ }
+ 
+ /**
+  * Make sure the intermediate stream ring has a stream per input, each large
+  * enough for that input
+  */
+ static NexusResult prepare_stream_ring(NexusPipeline* pipeline, 
+                                       NexusDataStream** inputs, 
+                                       size_t count) {
+     // A single component reads the inputs and writes the outputs directly
+     if (pipeline->component_count < 2) {
+         return NEXUS_SUCCESS;
+     }
      
-     // Calculate execution time
-     double elapsed_ms = (end.tv_sec - start.tv_sec) * 1000.0 + 
-                       (end.tv_nsec - start.tv_nsec) / 1000000.0;
+     if (!pipeline->stream_format) {
+         pipeline->stream_format = strdup(pipeline->config->input_format ?
+                                          pipeline->config->input_format : "binary");
+         if (!pipeline->stream_format) {
+             return NEXUS_OUT_OF_MEMORY;
+         }
+     }
      
-     nexus_log(ctx, NEXUS_LOG_INFO, 
-              "Pipeline executed in %.2f ms", elapsed_ms);
+     if (pipeline->stream_ring_size < count) {
+         for (size_t slot = 0; slot < 2; slot++) {
+             NexusDataStream** ring = (NexusDataStream**)realloc(pipeline->stream_ring[slot], 
+                                                                 count * sizeof(NexusDataStream*));
+             if (!ring) {
+                 return NEXUS_OUT_OF_MEMORY;
+             }
+             memset(ring + pipeline->stream_ring_size, 0, 
+                    (count - pipeline->stream_ring_size) * sizeof(NexusDataStream*));
+             pipeline->stream_ring[slot] = ring;
+         }
+         pipeline->stream_ring_size = count;
+     }
+     
+     for (size_t slot = 0; slot < 2; slot++) {
+         for (size_t i = 0; i < count; i++) {
+             size_t capacity = inputs[i]->capacity > 0 ? inputs[i]->capacity : 4096;
+             NexusDataStream* stream = pipeline->stream_ring[slot][i];
+             if (!stream) {
+                 stream = sps_stream_create(capacity);
+                 if (!stream) {
+                     return NEXUS_OUT_OF_MEMORY;
+                 }
+                 pipeline->stream_ring[slot][i] = stream;
+             } else if (stream->capacity < capacity) {
+                 sps_stream_clear(stream);
+                 NexusResult result = sps_stream_resize(stream, capacity);
+                 if (result != NEXUS_SUCCESS) {
+                     return result;
+                 }
+             }
+         }
+     }
      
-     // Clean up intermediate streams
-     if (streams) {
-         for (size_t i = 0; i < pipeline->component_count - 1; i++) {
-             if (streams[i]) {
-                 sps_stream_destroy(streams[i]);
+     return NEXUS_SUCCESS;
+ }
+ 
+ /**
+  * Free the intermediate stream ring
+  */
+ static void destroy_stream_ring(NexusPipeline* pipeline) {
+     for (size_t slot = 0; slot < 2; slot++) {
+         if (!pipeline->stream_ring[slot]) {
+             continue;
+         }
+         
+         for (size_t i = 0; i < pipeline->stream_ring_size; i++) {
+             NexusDataStream* stream = pipeline->stream_ring[slot][i];
+             if (stream) {
+                 // Formats point at pipeline-owned strings
+                 stream->format = NULL;
+                 sps_stream_destroy(stream);
              }
          }
-         free(streams);
+         
+         free(pipeline->stream_ring[slot]);
+         pipeline->stream_ring[slot] = NULL;
+     }
+     pipeline->stream_ring_size = 0;
+     
+     free(pipeline->stream_format);
+     pipeline->stream_format = NULL;
+ }
+ 
+ /**
+  * Recycle a ring slot's streams before a component writes them
+  */
+ static void recycle_stream_batch(NexusPipeline* pipeline, 
+                                 NexusDataStream** streams, 
+                                 size_t count, 
+                                 bool first_output) {
+     for (size_t i = 0; i < count; i++) {
+         sps_stream_recycle(streams[i]);
+         streams[i]->format = first_output ? pipeline->stream_format : "binary";
+     }
+ }
+ 
+ /**
+  * Copy the data of each source stream into the matching destination,
+  * growing it if needed
+  */
+ static NexusResult copy_stream_batch(NexusDataStream** dst, NexusDataStream** src, size_t count) {
+     for (size_t i = 0; i < count; i++) {
+         NexusResult result = sps_stream_copy_data(dst[i], src[i]);
+         if (result != NEXUS_SUCCESS) {
+             return result;
+         }
      }
      
-     return final_result == NEXUS_SUCCESS ? result : final_result;
+     return NEXUS_SUCCESS;
  }
  
  /**
@@ -526,6 +785,11 @@
          free(pipeline->components);
      }
      
+     // Free the intermediate stream ring
+     destroy_stream_ring(pipeline);
+     
+     sps_free_dependency_schedule(pipeline->schedule);
+     
      // Note: We don't free pipeline->config since it's owned by the caller
      
      // Free pipeline structure
@@ -635,6 +899,15 @@
      return NULL;
  }
  
+ /**
+  * Replace the schedule after the component list changed
+  */
+ static void reset_schedule(NexusPipeline* pipeline) {
+     // Without dependency metadata for the new list, fall back to running in order
+     sps_free_dependency_schedule(pipeline->schedule);
+     pipeline->schedule = sps_create_sequential_schedule(pipeline->component_count);
+ }
+ 
  /**
   * Add a component to the pipeline dynamically
   */
@@ -709,6 +982,7 @@
      // Add to the pipeline
      pipeline->components[insert_idx] = component;
      pipeline->component_count++;
+     reset_schedule(pipeline);
      
      nexus_log(ctx, NEXUS_LOG_INFO, "Added component '%s' to pipeline", component_id);
      
@@ -736,6 +1010,13 @@
              ctx, component->component, process_symbol
          );
          
+         // The batched variant is optional
+         snprintf(process_symbol, sizeof(process_symbol), "%s_process_batch", 
+                 component_id);
+         component->process_batch_func = (NexusProcessBatchFunc)nexus_resolve_component_symbol(
+             ctx, component->component, process_symbol
+         );
+         
          if (!component->process_func) {
              nexus_log(ctx, NEXUS_LOG_ERROR, 
                       "Failed to resolve processing function for component '%s'", 
@@ -815,6 +1096,7 @@
      // Update count and NULL the last slot
      pipeline->component_count--;
      pipeline->components[pipeline->component_count] = NULL;
+     reset_schedule(pipeline);
      
      nexus_log(ctx, NEXUS_LOG_INFO, "Removed component '%s' from pipeline", 
               component_id);
@@ -822,6 +1104,25 @@
      return NEXUS_SUCCESS;
  }
  
+ /**
+  * Mark a component as processing in place
+  */
+ NexusResult sps_pipeline_set_component_in_place(NexusPipeline* pipeline,
+                                                const char* component_id,
+                                                bool in_place) {
+     if (!pipeline || !component_id) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+     
+     NexusPipelineComponent* component = sps_pipeline_get_component(pipeline, component_id);
+     if (!component) {
+         return NEXUS_NOT_FOUND;
+     }
+     
+     component->process_in_place = in_place;
+     return NEXUS_SUCCESS;
+ }
+ 
  /**
   * Set pipeline-level error handler
   */
@@ -831,4 +1132,4 @@
      }
      
      pipeline->error_handler = handler ? handler : default_error_handler;
- }
\ No newline at end of file
+ }
\ No newline at end of file
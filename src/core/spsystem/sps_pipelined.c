@@ -0,0 +1,733 @@
+/**
+ * @file sps_pipelined.c
+ * @brief Pipelined multi-threaded execution for single-pass systems
+ *
+ * Each loaded component runs on its own worker. Items travel between
+ * workers as job handles through bounded SPSC rings; a job carries the
+ * caller's input and output streams plus two intermediate streams it
+ * ping-pongs between stages, exactly like sequential execution does.
+ * Since every ring is FIFO and every stage has one worker, items leave
+ * the last ring in submission order.
+ *
+ * Copyright © 2025 OBINexus Computing
+ */
+
+ #include "nlink/spsystem/sps_pipelined.h"
+ #include "nlink/spsystem/sps_lifecycle.h"
+ #include "nlink/core/common/nexus_core.h"
+ #include <pthread.h>
+ #include <stdatomic.h>
+ #include <stdint.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <time.h>
+ #include <unistd.h>
+ 
+ /* Polls before a blocked ring operation goes to sleep */
+ #define PIPELINED_SPIN_LIMIT 2048
+ 
+ /* Keeps ring indices written by different threads on separate cache lines */
+ #define PIPELINED_CACHE_LINE 64
+ 
+ /**
+  * An item in flight
+  */
+ typedef struct PipelinedJob {
+     NexusDataStream* input;              // Caller's input
+     NexusDataStream* output;             // Caller's output
+     NexusDataStream* current;            // Stream holding the latest data
+     NexusDataStream* scratch[2];         // Intermediate streams, created on first use
+     size_t scratch_next;                 // Scratch stream not holding current
+     NexusResult result;                  // First component failure
+ } PipelinedJob;
+ 
+ /**
+  * Bounded single-producer/single-consumer ring of jobs
+  *
+  * Operations poll first and then sleep on the condition variable; the
+  * other side only takes the mutex when someone is sleeping.
+  */
+ typedef struct PipelinedRing {
+     atomic_size_t head;                  // Next slot to read
+     char head_pad[PIPELINED_CACHE_LINE - sizeof(atomic_size_t)];
+     atomic_size_t tail;                  // Next slot to write
+     char tail_pad[PIPELINED_CACHE_LINE - sizeof(atomic_size_t)];
+     atomic_bool closed;                  // Producer is done
+     atomic_int sleepers;
+     int spin_limit;                      // Polls before sleeping
+     size_t mask;
+     PipelinedJob** slots;
+     pthread_mutex_t mutex;
+     pthread_cond_t cond;
+ } PipelinedRing;
+ 
+ /**
+  * A worker running one component
+  */
+ typedef struct PipelinedStage {
+     NexusPipelinedExecution* execution;
+     NexusPipelineComponent* component;
+     PipelinedRing* input;
+     PipelinedRing* output;
+     bool is_first;                       // Writes the first intermediate stream
+     bool is_last;                        // Writes the caller's output
+     pthread_t thread;
+     atomic_size_t items;
+     atomic_size_t max_depth;
+     atomic_uint_least64_t busy_ns;
+     atomic_uint_least64_t input_stall_ns;
+     atomic_uint_least64_t output_stall_ns;
+ } PipelinedStage;
+ 
+ struct NexusPipelinedExecution {
+     NexusContext* ctx;
+     NexusPipeline* pipeline;
+     PipelinedStage* stages;
+     size_t stage_count;
+     size_t threads_started;
+     PipelinedRing* rings;                // stage_count + 1 rings: submit, between stages, results
+     PipelinedRing free_jobs;             // Jobs returned by the consumer
+     PipelinedJob* jobs;
+     size_t job_count;
+     size_t queue_capacity;
+     char* stream_format;                 // Format of the first intermediate stream
+     bool finished;
+ };
+ 
+ /* Forward declarations for internal functions */
+ static NexusResult ring_init(PipelinedRing* ring, size_t capacity, int spin_limit);
+ static void ring_destroy(PipelinedRing* ring);
+ static bool ring_try_push(PipelinedRing* ring, PipelinedJob* job);
+ static PipelinedJob* ring_try_pop(PipelinedRing* ring);
+ static void ring_push(PipelinedRing* ring, PipelinedJob* job);
+ static PipelinedJob* ring_pop(PipelinedRing* ring);
+ static void ring_close(PipelinedRing* ring);
+ static bool ring_has_space(PipelinedRing* ring);
+ static void* stage_worker(void* arg);
+ static void run_stage(PipelinedStage* stage, PipelinedJob* job);
+ static uint64_t now_ns(void);
+ 
+ /**
+  * Round a queue capacity up to a power of two
+  */
+ static size_t round_capacity(size_t capacity) {
+     size_t rounded = 1;
+     while (rounded < capacity) {
+         rounded <<= 1;
+     }
+     return rounded;
+ }
+ 
+ /**
+  * Start workers for a pipeline
+  */
+ NexusPipelinedExecution* sps_pipelined_start(NexusContext* ctx,
+                                             NexusPipeline* pipeline,
+                                             size_t queue_capacity) {
+     if (!ctx || !pipeline) {
+         return NULL;
+     }
+     
+     if (!pipeline->is_initialized) {
+         NexusResult result = sps_pipeline_initialize(ctx, pipeline);
+         if (result != NEXUS_SUCCESS) {
+             nexus_log(ctx, NEXUS_LOG_ERROR, "Failed to initialize pipeline: %d", result);
+             return NULL;
+         }
+     }
+     
+     NexusPipelinedExecution* execution = (NexusPipelinedExecution*)calloc(1, sizeof(NexusPipelinedExecution));
+     if (!execution) {
+         return NULL;
+     }
+     
+     execution->ctx = ctx;
+     execution->pipeline = pipeline;
+     execution->queue_capacity = round_capacity(queue_capacity > 0 ? 
+                                                queue_capacity : SPS_PIPELINED_DEFAULT_QUEUE_CAPACITY);
+     
+     // Only loaded components get a stage, as in sequential execution
+     for (size_t i = 0; i < pipeline->component_count; i++) {
+         if (pipeline->components[i]->is_initialized && pipeline->components[i]->component) {
+             execution->stage_count++;
+         }
+     }
+     
+     // Enough jobs to fill every ring and every stage without waiting on the pool
+     execution->job_count = (execution->stage_count + 1) * execution->queue_capacity + 
+                            execution->stage_count + 1;
+     
+     execution->stages = (PipelinedStage*)calloc(execution->stage_count + 1, sizeof(PipelinedStage));
+     execution->rings = (PipelinedRing*)calloc(execution->stage_count + 1, sizeof(PipelinedRing));
+     execution->jobs = (PipelinedJob*)calloc(execution->job_count, sizeof(PipelinedJob));
+     execution->stream_format = strdup(pipeline->config && pipeline->config->input_format ?
+                                       pipeline->config->input_format : "binary");
+     
+     // Polling only pays off when the other side runs on another CPU
+     int spin_limit = sysconf(_SC_NPROCESSORS_ONLN) > 1 ? PIPELINED_SPIN_LIMIT : 0;
+     
+     bool ok = execution->stages && execution->rings && execution->jobs && execution->stream_format;
+     size_t rings_ready = 0;
+     while (ok && rings_ready <= execution->stage_count) {
+         ok = ring_init(&execution->rings[rings_ready], execution->queue_capacity, spin_limit) == NEXUS_SUCCESS;
+         if (ok) {
+             rings_ready++;
+         }
+     }
+     bool free_ready = ok && ring_init(&execution->free_jobs, 
+                                       round_capacity(execution->job_count), spin_limit) == NEXUS_SUCCESS;
+     if (!free_ready) {
+         for (size_t i = 0; i < rings_ready; i++) {
+             ring_destroy(&execution->rings[i]);
+         }
+         free(execution->stages);
+         free(execution->rings);
+         free(execution->jobs);
+         free(execution->stream_format);
+         free(execution);
+         nexus_log(ctx, NEXUS_LOG_ERROR, "Failed to allocate pipelined execution");
+         return NULL;
+     }
+     
+     for (size_t i = 0; i < execution->job_count; i++) {
+         ring_try_push(&execution->free_jobs, &execution->jobs[i]);
+     }
+     
+     // Wire stages to their rings in pipeline order
+     size_t stage_index = 0;
+     for (size_t i = 0; i < pipeline->component_count; i++) {
+         NexusPipelineComponent* component = pipeline->components[i];
+         if (!component->is_initialized || !component->component) {
+             continue;
+         }
+         
+         PipelinedStage* stage = &execution->stages[stage_index];
+         stage->execution = execution;
+         stage->component = component;
+         stage->input = &execution->rings[stage_index];
+         stage->output = &execution->rings[stage_index + 1];
+         stage->is_first = (stage_index == 0);
+         stage->is_last = (stage_index == execution->stage_count - 1);
+         stage_index++;
+     }
+     
+     // Stage workers block on their rings for the whole execution, so they
+     // get dedicated threads; as shared-pool tasks they would hold pool
+     // workers indefinitely and deadlock once stages outnumber workers
+     for (size_t i = 0; i < execution->stage_count; i++) {
+         if (pthread_create(&execution->stages[i].thread, NULL, stage_worker, &execution->stages[i]) != 0) {
+             nexus_log(ctx, NEXUS_LOG_ERROR, "Failed to start worker for component '%s'",
+                      execution->stages[i].component->component_id);
+             sps_pipelined_destroy(execution);
+             return NULL;
+         }
+         execution->threads_started++;
+     }
+     
+     nexus_log(ctx, NEXUS_LOG_INFO, "Started pipelined execution of '%s' with %zu stages", 
+              pipeline->pipeline_id ? pipeline->pipeline_id : "unnamed", execution->stage_count);
+     
+     return execution;
+ }
+ 
+ /**
+  * Submit an input for processing
+  */
+ NexusResult sps_pipelined_submit(NexusPipelinedExecution* execution,
+                                 NexusDataStream* input,
+                                 NexusDataStream* output) {
+     if (!execution || !input || !output) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+     
+     if (execution->finished) {
+         return NEXUS_INVALID_OPERATION;
+     }
+     
+     // Components address input data directly; give chunked inputs one buffer
+     NexusResult result = sps_stream_flatten(input);
+     if (result != NEXUS_SUCCESS) {
+         return result;
+     }
+     
+     PipelinedJob* job = ring_pop(&execution->free_jobs);
+     job->input = input;
+     job->output = output;
+     job->current = input;
+     job->scratch_next = 0;
+     job->result = NEXUS_SUCCESS;
+     
+     // Blocks while the first stage is backed up
+     ring_push(&execution->rings[0], job);
+     return NEXUS_SUCCESS;
+ }
+ 
+ /**
+  * Hand a completed job back to the caller
+  */
+ static void take_job(NexusPipelinedExecution* execution,
+                      PipelinedJob* job,
+                      NexusDataStream** input,
+                      NexusDataStream** output,
+                      NexusResult* item_result) {
+     if (input) {
+         *input = job->input;
+     }
+     if (output) {
+         *output = job->output;
+     }
+     if (item_result) {
+         *item_result = job->result;
+     }
+     
+     job->input = NULL;
+     job->output = NULL;
+     job->current = NULL;
+     ring_try_push(&execution->free_jobs, job);
+ }
+ 
+ /**
+  * Wait for the next completed item
+  */
+ NexusResult sps_pipelined_next(NexusPipelinedExecution* execution,
+                               NexusDataStream** input,
+                               NexusDataStream** output,
+                               NexusResult* item_result) {
+     if (!execution) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+     
+     PipelinedJob* job = ring_pop(&execution->rings[execution->stage_count]);
+     if (!job) {
+         return NEXUS_NOT_FOUND;
+     }
+     
+     take_job(execution, job, input, output, item_result);
+     return NEXUS_SUCCESS;
+ }
+ 
+ /**
+  * Run a set of inputs through the pipeline from the calling thread
+  */
+ NexusResult sps_pipelined_execute(NexusPipelinedExecution* execution,
+                                  NexusDataStream** inputs,
+                                  NexusDataStream** outputs,
+                                  size_t count) {
+     if (!execution || !inputs || !outputs) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+     
+     if (execution->finished) {
+         return NEXUS_INVALID_OPERATION;
+     }
+     
+     PipelinedRing* first = &execution->rings[0];
+     PipelinedRing* results = &execution->rings[execution->stage_count];
+     NexusResult final_result = NEXUS_SUCCESS;
+     size_t submitted = 0;
+     size_t completed = 0;
+     
+     while (completed < count) {
+         // Submit until the first stage is backed up
+         while (submitted < count && ring_has_space(first)) {
+             NexusResult result = sps_pipelined_submit(execution, inputs[submitted], outputs[submitted]);
+             if (result != NEXUS_SUCCESS) {
+                 return result;
+             }
+             submitted++;
+         }
+         
+         // Block for a result only when nothing more can be submitted; with
+         // the first stage full, one is on its way
+         PipelinedJob* job = ring_try_pop(results);
+         if (!job && (submitted == count || !ring_has_space(first))) {
+             job = ring_pop(results);
+         }
+         
+         if (job) {
+             NexusResult item_result;
+             take_job(execution, job, NULL, NULL, &item_result);
+             if (item_result != NEXUS_SUCCESS && final_result == NEXUS_SUCCESS) {
+                 final_result = item_result;
+             }
+             completed++;
+         }
+     }
+     
+     return final_result;
+ }
+ 
+ /**
+  * Signal that no more inputs will be submitted
+  */
+ void sps_pipelined_finish(NexusPipelinedExecution* execution) {
+     if (!execution || execution->finished) {
+         return;
+     }
+     
+     execution->finished = true;
+     ring_close(&execution->rings[0]);
+ }
+ 
+ /**
+  * Get the number of stages
+  */
+ size_t sps_pipelined_get_stage_count(const NexusPipelinedExecution* execution) {
+     return execution ? execution->stage_count : 0;
+ }
+ 
+ /**
+  * Get statistics for a stage
+  */
+ NexusResult sps_pipelined_get_stage_stats(const NexusPipelinedExecution* execution,
+                                          size_t stage,
+                                          NexusPipelinedStageStats* stats) {
+     if (!execution || !stats || stage >= execution->stage_count) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+     
+     PipelinedStage* s = &execution->stages[stage];
+     size_t tail = atomic_load_explicit(&s->input->tail, memory_order_relaxed);
+     size_t head = atomic_load_explicit(&s->input->head, memory_order_relaxed);
+     
+     stats->component_id = s->component->component_id;
+     stats->items_processed = atomic_load_explicit(&s->items, memory_order_relaxed);
+     stats->queue_depth = tail > head ? tail - head : 0;
+     stats->max_queue_depth = atomic_load_explicit(&s->max_depth, memory_order_relaxed);
+     stats->queue_capacity = execution->queue_capacity;
+     stats->busy_ms = atomic_load_explicit(&s->busy_ns, memory_order_relaxed) / 1e6;
+     stats->input_stall_ms = atomic_load_explicit(&s->input_stall_ns, memory_order_relaxed) / 1e6;
+     stats->output_stall_ms = atomic_load_explicit(&s->output_stall_ns, memory_order_relaxed) / 1e6;
+     return NEXUS_SUCCESS;
+ }
+ 
+ /**
+  * Stop the workers and free the execution
+  */
+ void sps_pipelined_destroy(NexusPipelinedExecution* execution) {
+     if (!execution) {
+         return;
+     }
+     
+     sps_pipelined_finish(execution);
+     
+     // A worker that never started closes its output on its behalf so the
+     // rest of the chain still drains
+     for (size_t i = execution->threads_started; i < execution->stage_count; i++) {
+         ring_close(execution->stages[i].output);
+     }
+     
+     // Discard results nobody collected so blocked workers can finish
+     if (execution->threads_started == execution->stage_count) {
+         while (ring_pop(&execution->rings[execution->stage_count])) {
+         }
+     }
+     
+     for (size_t i = 0; i < execution->threads_started; i++) {
+         pthread_join(execution->stages[i].thread, NULL);
+     }
+     
+     for (size_t i = 0; i < execution->job_count; i++) {
+         for (size_t j = 0; j < 2; j++) {
+             NexusDataStream* stream = execution->jobs[i].scratch[j];
+             if (stream) {
+                 // Formats point at execution-owned strings
+                 stream->format = NULL;
+                 sps_stream_destroy(stream);
+             }
+         }
+     }
+     
+     for (size_t i = 0; i <= execution->stage_count; i++) {
+         ring_destroy(&execution->rings[i]);
+     }
+     ring_destroy(&execution->free_jobs);
+     
+     free(execution->stages);
+     free(execution->rings);
+     free(execution->jobs);
+     free(execution->stream_format);
+     free(execution);
+ }
+ 
+ /**
+  * Worker loop for one stage
+  */
+ static void* stage_worker(void* arg) {
+     PipelinedStage* stage = (PipelinedStage*)arg;
+     
+     for (;;) {
+         uint64_t wait_start = now_ns();
+         
+         // Depth seen on arrival, including the item about to be taken
+         size_t depth = atomic_load_explicit(&stage->input->tail, memory_order_relaxed) - 
+                        atomic_load_explicit(&stage->input->head, memory_order_relaxed);
+         
+         PipelinedJob* job = ring_pop(stage->input);
+         uint64_t work_start = now_ns();
+         atomic_fetch_add_explicit(&stage->input_stall_ns, work_start - wait_start, memory_order_relaxed);
+         
+         if (!job) {
+             break;
+         }
+         
+         if (depth > atomic_load_explicit(&stage->max_depth, memory_order_relaxed)) {
+             atomic_store_explicit(&stage->max_depth, depth, memory_order_relaxed);
+         }
+         
+         run_stage(stage, job);
+         uint64_t work_end = now_ns();
+         atomic_fetch_add_explicit(&stage->busy_ns, work_end - work_start, memory_order_relaxed);
+         atomic_fetch_add_explicit(&stage->items, 1, memory_order_relaxed);
+         
+         // Blocks while the next stage is backed up
+         ring_push(stage->output, job);
+         atomic_fetch_add_explicit(&stage->output_stall_ns, now_ns() - work_end, memory_order_relaxed);
+     }
+     
+     ring_close(stage->output);
+     return NULL;
+ }
+ 
+ /**
+  * Get the job's next intermediate stream, ready to be written
+  */
+ static NexusDataStream* take_scratch(PipelinedStage* stage, PipelinedJob* job) {
+     NexusDataStream* stream = job->scratch[job->scratch_next];
+     size_t capacity = job->input->capacity > 0 ? job->input->capacity : 4096;
+     
+     if (!stream) {
+         stream = sps_stream_create(capacity);
+         if (!stream) {
+             return NULL;
+         }
+         job->scratch[job->scratch_next] = stream;
+     }
+     
+     sps_stream_recycle(stream);
+     stream->format = stage->is_first ? stage->execution->stream_format : "binary";
+     job->scratch_next ^= 1;
+     return stream;
+ }
+ 
+ /**
+  * Run a stage's component on a job
+  */
+ static void run_stage(PipelinedStage* stage, PipelinedJob* job) {
+     NexusPipelinedExecution* execution = stage->execution;
+     NexusPipelineComponent* component = stage->component;
+     
+     // An item stops at its first failure unless partial processing is allowed
+     if (job->result != NEXUS_SUCCESS && !execution->pipeline->config->allow_partial_processing) {
+         return;
+     }
+     
+     NexusDataStream* comp_input = job->current;
+     NexusDataStream* comp_output;
+     NexusResult result = NEXUS_SUCCESS;
+     
+     if (component->process_in_place) {
+         // Edit the current stream directly, never the caller's input
+         NexusDataStream* target = job->current;
+         if (stage->is_last && job->current != job->output) {
+             target = job->output;
+         } else if (job->current == job->input) {
+             target = take_scratch(stage, job);
+             if (!target) {
+                 result = NEXUS_OUT_OF_MEMORY;
+             }
+         }
+         
+         if (result == NEXUS_SUCCESS && target != job->current) {
+             result = sps_stream_copy_data(target, job->current);
+         }
+         
+         comp_input = target;
+         comp_output = target;
+     } else if (stage->is_last) {
+         comp_output = job->output;
+     } else {
+         comp_output = take_scratch(stage, job);
+         if (!comp_output) {
+             result = NEXUS_OUT_OF_MEMORY;
+         }
+     }
+     
+     if (result == NEXUS_SUCCESS) {
+         result = sps_component_execute(execution->ctx, component, comp_input, comp_output);
+         component->last_result = result;
+         
+         // The output becomes the next stage's input, read from the start
+         job->current = comp_output;
+         if (job->current != job->output) {
+             job->current->position = 0;
+         }
+     }
+     
+     if (result != NEXUS_SUCCESS) {
+         sps_handle_pipeline_error(execution->ctx, execution->pipeline, result, component->component_id);
+         if (job->result == NEXUS_SUCCESS) {
+             job->result = result;
+         }
+     }
+ }
+ 
+ /**
+  * Initialize a ring with a power-of-two capacity
+  */
+ static NexusResult ring_init(PipelinedRing* ring, size_t capacity, int spin_limit) {
+     ring->slots = (PipelinedJob**)calloc(capacity, sizeof(PipelinedJob*));
+     if (!ring->slots) {
+         return NEXUS_OUT_OF_MEMORY;
+     }
+     
+     atomic_init(&ring->head, 0);
+     atomic_init(&ring->tail, 0);
+     atomic_init(&ring->closed, false);
+     atomic_init(&ring->sleepers, 0);
+     ring->spin_limit = spin_limit;
+     ring->mask = capacity - 1;
+     pthread_mutex_init(&ring->mutex, NULL);
+     pthread_cond_init(&ring->cond, NULL);
+     return NEXUS_SUCCESS;
+ }
+ 
+ /**
+  * Free a ring
+  */
+ static void ring_destroy(PipelinedRing* ring) {
+     if (!ring->slots) {
+         return;
+     }
+     
+     pthread_mutex_destroy(&ring->mutex);
+     pthread_cond_destroy(&ring->cond);
+     free(ring->slots);
+     ring->slots = NULL;
+ }
+ 
+ /**
+  * Wake the other side if it went to sleep
+  */
+ static void ring_wake(PipelinedRing* ring) {
+     // Pairs with the sleeper's increment: either it sees our update when it
+     // rechecks, or we see it sleeping
+     if (atomic_load(&ring->sleepers) > 0) {
+         pthread_mutex_lock(&ring->mutex);
+         pthread_cond_broadcast(&ring->cond);
+         pthread_mutex_unlock(&ring->mutex);
+     }
+ }
+ 
+ static bool ring_has_space(PipelinedRing* ring) {
+     return atomic_load(&ring->tail) - atomic_load(&ring->head) <= ring->mask;
+ }
+ 
+ static bool ring_has_item(PipelinedRing* ring) {
+     return atomic_load(&ring->tail) != atomic_load(&ring->head) || atomic_load(&ring->closed);
+ }
+ 
+ static inline void cpu_relax(void) {
+ #if defined(__x86_64__) || defined(__i386__)
+     __builtin_ia32_pause();
+ #elif defined(__aarch64__)
+     __asm__ __volatile__("yield");
+ #endif
+ }
+ 
+ /**
+  * Wait until ready() holds, polling first and then sleeping
+  */
+ static void ring_wait(PipelinedRing* ring, bool (*ready)(PipelinedRing*)) {
+     for (int spin = 0; spin < ring->spin_limit; spin++) {
+         if (ready(ring)) {
+             return;
+         }
+         cpu_relax();
+     }
+     
+     pthread_mutex_lock(&ring->mutex);
+     atomic_fetch_add(&ring->sleepers, 1);
+     while (!ready(ring)) {
+         pthread_cond_wait(&ring->cond, &ring->mutex);
+     }
+     atomic_fetch_sub(&ring->sleepers, 1);
+     pthread_mutex_unlock(&ring->mutex);
+ }
+ 
+ /**
+  * Push a job if there is room (producer side)
+  */
+ static bool ring_try_push(PipelinedRing* ring, PipelinedJob* job) {
+     size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+     size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+     if (tail - head > ring->mask) {
+         return false;
+     }
+     
+     ring->slots[tail & ring->mask] = job;
+     atomic_store(&ring->tail, tail + 1);
+     ring_wake(ring);
+     return true;
+ }
+ 
+ /**
+  * Pop a job if one is ready (consumer side)
+  */
+ static PipelinedJob* ring_try_pop(PipelinedRing* ring) {
+     size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+     size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+     if (head == tail) {
+         return NULL;
+     }
+     
+     PipelinedJob* job = ring->slots[head & ring->mask];
+     atomic_store(&ring->head, head + 1);
+     ring_wake(ring);
+     return job;
+ }
+ 
+ /**
+  * Push a job, waiting for room
+  */
+ static void ring_push(PipelinedRing* ring, PipelinedJob* job) {
+     while (!ring_try_push(ring, job)) {
+         ring_wait(ring, ring_has_space);
+     }
+ }
+ 
+ /**
+  * Pop a job, waiting for one; NULL once the ring is closed and empty
+  */
+ static PipelinedJob* ring_pop(PipelinedRing* ring) {
+     for (;;) {
+         PipelinedJob* job = ring_try_pop(ring);
+         if (job) {
+             return job;
+         }
+         
+         if (atomic_load(&ring->closed)) {
+             // Anything pushed before the close is visible now
+             return ring_try_pop(ring);
+         }
+         
+         ring_wait(ring, ring_has_item);
+     }
+ }
+ 
+ /**
+  * Mark a ring as having no more items (producer side)
+  */
+ static void ring_close(PipelinedRing* ring) {
+     atomic_store(&ring->closed, true);
+     ring_wake(ring);
+ }
+ 
+ /**
+  * Monotonic time in nanoseconds
+  */
+ static uint64_t now_ns(void) {
+     struct timespec ts;
+     clock_gettime(CLOCK_MONOTONIC, &ts);
+     return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+ }
@@ -12,10 +12,64 @@
  #include "nlink/core/common/nexus_core.h"
  #include <string.h>
  #include <stdlib.h>
+ #include <stdatomic.h>
+ #include <errno.h>
+ #include <fcntl.h>
+ #include <unistd.h>
+ #include <sys/mman.h>
+ #include <sys/stat.h>
+ 
+ #define SPS_STREAM_DEFAULT_CHUNK (64 * 1024)
+ #define SPS_STREAM_MAX_CHUNK (64 * 1024 * 1024)
+ 
+ /**
+  * Reference-counted chunk of a chunked stream. Clones share chunks; a
+  * chunk is only written in place while a single stream holds it.
+  */
+ typedef struct NexusStreamChunk {
+     atomic_size_t refs;
+     size_t capacity;
+     unsigned char bytes[];
+ } NexusStreamChunk;
+ 
+ /**
+  * A stream's view of a chunk. Streams sharing a chunk may each use a
+  * different prefix of it.
+  */
+ typedef struct NexusStreamSlice {
+     NexusStreamChunk* chunk;
+     size_t length;
+ } NexusStreamSlice;
+ 
+ struct NexusStreamChunks {
+     NexusStreamSlice* slices;
+     size_t count;
+     size_t slots;
+     size_t chunk_size;
+     size_t cursor_index;    // Slice of the last lookup, for sequential access
+     size_t cursor_start;    // Stream offset of that slice
+ };
+ 
+ struct NexusStreamMapping {
+     atomic_size_t refs;
+     void* address;
+     size_t length;
+ };
  
  /* Forward declarations for helper functions */
  static NexusResult ensure_stream_capacity(NexusDataStream* stream, size_t required_size);
- static void free_metadata_entry(StreamMetadataEntry* entry);
+ static void release_chunk(NexusStreamChunk* chunk);
+ static void release_slices(NexusStreamChunks* chunks, size_t from);
+ static NexusResult push_chunk(NexusStreamChunks* chunks, size_t capacity);
+ static void sync_chunked_view(NexusDataStream* stream);
+ static NexusResult append_chunked(NexusDataStream* stream, const void* data, size_t size);
+ static NexusResult write_chunked(NexusDataStream* stream, const void* data, size_t size);
+ static size_t locate_chunk(const NexusStreamChunks* chunks, size_t offset, size_t* start);
+ static void remember_chunk(NexusStreamChunks* chunks, size_t offset);
+ static void read_chunked(const NexusStreamChunks* chunks, size_t offset, void* buffer, size_t size);
+ static void release_mapping(NexusStreamMapping* mapping);
+ static NexusDataStream* share_payload(const NexusDataStream* stream);
+ static NexusResult detach_mapping(NexusDataStream* stream, size_t capacity);
  
  /**
   * Create a new data stream
@@ -43,7 +97,6 @@
      stream->size = 0;
      stream->position = 0;
      stream->format = NULL;
-     stream->metadata = NULL;
      stream->owns_data = true;
      
      return stream;
@@ -74,6 +127,118 @@
      return stream;
  }
  
+ /**
+  * Create a chunked data stream
+  */
+ NexusDataStream* sps_stream_create_chunked(size_t chunk_size) {
+     if (chunk_size == 0) {
+         chunk_size = SPS_STREAM_DEFAULT_CHUNK;
+     }
+     
+     NexusDataStream* stream = (NexusDataStream*)calloc(1, sizeof(NexusDataStream));
+     if (!stream) {
+         return NULL;
+     }
+     
+     stream->chunks = (NexusStreamChunks*)calloc(1, sizeof(NexusStreamChunks));
+     if (!stream->chunks) {
+         free(stream);
+         return NULL;
+     }
+     
+     // Chunks are allocated on the first write
+     stream->chunks->chunk_size = chunk_size;
+     stream->backing = NEXUS_STREAM_CHUNKED;
+     stream->owns_data = false;
+     
+     return stream;
+ }
+ 
+ /**
+  * Create a data stream backed by a read-only mapping of a file
+  */
+ NexusDataStream* sps_stream_create_from_file(const char* path, const char* format, NexusResult* result) {
+     NexusResult status = NEXUS_SUCCESS;
+     NexusDataStream* stream = NULL;
+     NexusStreamMapping* mapping = NULL;
+     void* address = MAP_FAILED;
+     size_t length = 0;
+     
+     if (!path) {
+         status = NEXUS_INVALID_PARAMETER;
+         goto done;
+     }
+     
+     int fd = open(path, O_RDONLY | O_CLOEXEC);
+     if (fd < 0) {
+         status = errno == ENOENT ? NEXUS_FILE_NOT_FOUND : NEXUS_IO_ERROR;
+         goto done;
+     }
+     
+     struct stat info;
+     if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+         close(fd);
+         status = NEXUS_IO_ERROR;
+         goto done;
+     }
+     
+     length = (size_t)info.st_size;
+     if (length > 0) {
+         address = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+     }
+     close(fd);
+     
+     if (length > 0 && address == MAP_FAILED) {
+         status = NEXUS_IO_ERROR;
+         goto done;
+     }
+     
+     // Nothing to map for an empty file; hand out an ordinary stream
+     if (length == 0) {
+         stream = sps_stream_create(0);
+     } else {
+ #ifdef MADV_SEQUENTIAL
+         madvise(address, length, MADV_SEQUENTIAL);
+ #endif
+         mapping = (NexusStreamMapping*)malloc(sizeof(NexusStreamMapping));
+         stream = mapping ? (NexusDataStream*)calloc(1, sizeof(NexusDataStream)) : NULL;
+     }
+     
+     if (!stream) {
+         status = NEXUS_OUT_OF_MEMORY;
+         goto done;
+     }
+     
+     if (mapping) {
+         atomic_init(&mapping->refs, 1);
+         mapping->address = address;
+         mapping->length = length;
+         
+         stream->data = address;
+         stream->size = length;
+         stream->capacity = length;
+         stream->backing = NEXUS_STREAM_MAPPED;
+         stream->mapping = mapping;
+         stream->owns_data = false;
+         mapping = NULL;
+         address = MAP_FAILED;
+     }
+     
+     if (format) {
+         stream->format = strdup(format);
+     }
+     
+ done:
+     if (address != MAP_FAILED) {
+         munmap(address, length);
+     }
+     free(mapping);
+     if (result) {
+         *result = status;
+     }
+     return stream;
+ }
+ 
  /**
   * Resize a data stream
   */
@@ -87,6 +252,25 @@
          return NEXUS_INVALID_PARAMETER;
      }
      
+     if (stream->backing == NEXUS_STREAM_MAPPED) {
+         return detach_mapping(stream, new_capacity);
+     }
+     
+     if (stream->backing == NEXUS_STREAM_CHUNKED) {
+         // Chunks never shrink; reserve the missing space as a new tail chunk
+         if (new_capacity <= stream->capacity) {
+             return NEXUS_SUCCESS;
+         }
+         
+         NexusResult result = push_chunk(stream->chunks, new_capacity - stream->size);
+         if (result != NEXUS_SUCCESS) {
+             return result;
+         }
+         
+         sync_chunked_view(stream);
+         return NEXUS_SUCCESS;
+     }
+     
      // Don't resize if not needed
      if (new_capacity == stream->capacity) {
          return NEXUS_SUCCESS;
@@ -136,6 +320,19 @@
          return NEXUS_INVALID_PARAMETER;
      }
      
+     if (stream->backing == NEXUS_STREAM_CHUNKED) {
+         return write_chunked(stream, data, size);
+     }
+     
+     // The mapping is read-only; take a private copy first
+     if (stream->backing == NEXUS_STREAM_MAPPED) {
+         size_t end = stream->position + size;
+         NexusResult result = detach_mapping(stream, end > stream->size ? end : stream->size);
+         if (result != NEXUS_SUCCESS) {
+             return result;
+         }
+     }
+     
      // If writing at the end, grow the stream
      size_t end_pos = stream->position + size;
      if (end_pos > stream->capacity) {
@@ -166,7 +363,7 @@
      }
      
      // Calculate how many bytes we can read
-     size_t available = stream->size - stream->position;
+     size_t available = stream->position < stream->size ? stream->size - stream->position : 0;
      size_t to_read = size;
      
      if (available < to_read) {
@@ -175,7 +372,12 @@
      
      // Copy data to the buffer
      if (to_read > 0) {
-         memcpy(buffer, (char*)stream->data + stream->position, to_read);
+         if (stream->backing == NEXUS_STREAM_CHUNKED) {
+             read_chunked(stream->chunks, stream->position, buffer, to_read);
+             remember_chunk(stream->chunks, stream->position + to_read);
+         } else {
+             memcpy(buffer, (char*)stream->data + stream->position, to_read);
+         }
          stream->position += to_read;
      }
      
@@ -189,91 +391,149 @@
  }
  
  /**
-  * Get stream metadata
+  * List the contiguous pieces of a stream's payload
   */
- void* sps_stream_get_metadata(const NexusDataStream* stream, const char* key) {
-     if (!stream || !key) {
-         return NULL;
+ size_t sps_stream_get_segments(const NexusDataStream* stream,
+                               NexusStreamSegment* segments,
+                               size_t max_segments) {
+     if (!stream || stream->size == 0) {
+         return 0;
      }
      
-     // Search for the key in the metadata linked list
-     StreamMetadataEntry* entry = stream->metadata;
-     while (entry) {
-         if (strcmp(entry->key, key) == 0) {
-             return entry->value;
+     if (stream->backing != NEXUS_STREAM_CHUNKED) {
+         if (segments && max_segments > 0) {
+             segments[0].base = stream->data;
+             segments[0].length = stream->size;
          }
-         entry = entry->next;
+         return 1;
      }
      
-     return NULL;
+     const NexusStreamChunks* chunks = stream->chunks;
+     size_t count = 0;
+     for (size_t i = 0; i < chunks->count; i++) {
+         if (chunks->slices[i].length == 0) {
+             continue;
+         }
+         if (segments && count < max_segments) {
+             segments[count].base = chunks->slices[i].chunk->bytes;
+             segments[count].length = chunks->slices[i].length;
+         }
+         count++;
+     }
+     
+     return count;
  }
  
  /**
-  * Set stream metadata
+  * Make a stream's payload contiguous
   */
- NexusResult sps_stream_set_metadata(NexusDataStream* stream, const char* key, void* value, StreamMetadataFreeFunc free_func) {
-     if (!stream || !key) {
+ NexusResult sps_stream_flatten(NexusDataStream* stream) {
+     if (!stream) {
          return NEXUS_INVALID_PARAMETER;
      }
      
-     // Check if the key already exists
-     StreamMetadataEntry* entry = stream->metadata;
-     while (entry) {
-         if (strcmp(entry->key, key) == 0) {
-             // Free old value if we have a free function
-             if (entry->value && entry->free_func) {
-                 entry->free_func(entry->value);
-             }
-             
-             // Update the entry
-             entry->value = value;
-             entry->free_func = free_func;
-             return NEXUS_SUCCESS;
-         }
-         entry = entry->next;
+     if (stream->backing != NEXUS_STREAM_CHUNKED || stream->data || stream->size == 0) {
+         return NEXUS_SUCCESS;
      }
      
-     // Create a new entry
-     StreamMetadataEntry* new_entry = (StreamMetadataEntry*)malloc(sizeof(StreamMetadataEntry));
-     if (!new_entry) {
+     NexusStreamChunk* chunk = (NexusStreamChunk*)malloc(sizeof(NexusStreamChunk) + stream->size);
+     if (!chunk) {
          return NEXUS_OUT_OF_MEMORY;
      }
+     atomic_init(&chunk->refs, 1);
+     chunk->capacity = stream->size;
+     read_chunked(stream->chunks, 0, chunk->bytes, stream->size);
      
-     // Initialize the entry
-     new_entry->key = strdup(key);
-     if (!new_entry->key) {
-         free(new_entry);
-         return NEXUS_OUT_OF_MEMORY;
+     NexusStreamChunks* chunks = stream->chunks;
+     release_slices(chunks, 0);
+     chunks->slices[0].chunk = chunk;
+     chunks->slices[0].length = stream->size;
+     chunks->count = 1;
+     
+     sync_chunked_view(stream);
+     return NEXUS_SUCCESS;
+ }
+ 
+ /**
+  * Replace a stream's data with a copy of another stream's data
+  */
+ NexusResult sps_stream_copy_data(NexusDataStream* dst, const NexusDataStream* src) {
+     if (!dst || !src || dst == src) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+     
+     sps_stream_clear(dst);
+     
+     if (dst->backing == NEXUS_STREAM_CHUNKED) {
+         NexusResult result = NEXUS_SUCCESS;
+         
+         // Append piece by piece, without flattening the source
+         if (src->backing == NEXUS_STREAM_CHUNKED) {
+             for (size_t i = 0; i < src->chunks->count && result == NEXUS_SUCCESS; i++) {
+                 const NexusStreamSlice* slice = &src->chunks->slices[i];
+                 if (slice->length > 0) {
+                     result = append_chunked(dst, slice->chunk->bytes, slice->length);
+                 }
+             }
+         } else if (src->size > 0) {
+             result = append_chunked(dst, src->data, src->size);
+         }
+         
+         dst->position = 0;
+         return result;
      }
      
-     new_entry->value = value;
-     new_entry->free_func = free_func;
+     if (dst->capacity < src->size) {
+         NexusResult result = sps_stream_resize(dst, src->size);
+         if (result != NEXUS_SUCCESS) {
+             return result;
+         }
+     }
      
-     // Add to the head of the list
-     new_entry->next = stream->metadata;
-     stream->metadata = new_entry;
+     if (src->size > 0) {
+         if (src->backing == NEXUS_STREAM_CHUNKED) {
+             read_chunked(src->chunks, 0, dst->data, src->size);
+         } else {
+             memcpy(dst->data, src->data, src->size);
+         }
+     }
+     dst->size = src->size;
+     dst->position = 0;
      
      return NEXUS_SUCCESS;
  }
  
  /**
-  * Free metadata entry
+  * Get stream metadata
   */
- static void free_metadata_entry(StreamMetadataEntry* entry) {
-     if (!entry) {
-         return;
+ void* sps_stream_get_metadata(const NexusDataStream* stream, const char* key) {
+     if (!stream || !key) {
+         return NULL;
      }
      
-     // Free key
-     free(entry->key);
+     return nexus_metadata_get(&stream->metadata, key);
+ }
+ 
+ /**
+  * Get stream metadata by an interned key
+  */
+ void* sps_stream_get_metadata_interned(const NexusDataStream* stream, const char* interned_key) {
+     if (!stream || !interned_key) {
+         return NULL;
+     }
      
-     // Free value if we have a free function
-     if (entry->value && entry->free_func) {
-         entry->free_func(entry->value);
+     return nexus_metadata_get_interned(&stream->metadata, interned_key);
+ }
+ 
+ /**
+  * Set stream metadata
+  */
+ NexusResult sps_stream_set_metadata(NexusDataStream* stream, const char* key, void* value, StreamMetadataFreeFunc free_func) {
+     if (!stream || !key) {
+         return NEXUS_INVALID_PARAMETER;
      }
      
-     // Free the entry itself
-     free(entry);
+     return nexus_metadata_set(&stream->metadata, key, value, free_func);
  }
  
  /**
@@ -287,6 +547,42 @@
      // Reset position and size, but keep the buffer
      stream->position = 0;
      stream->size = 0;
+     
+     // A mapping cannot be written; the stream continues as an empty buffer
+     if (stream->backing == NEXUS_STREAM_MAPPED) {
+         release_mapping(stream->mapping);
+         stream->mapping = NULL;
+         stream->data = NULL;
+         stream->capacity = 0;
+         stream->owns_data = true;
+         stream->backing = NEXUS_STREAM_CONTIGUOUS;
+     }
+     
+     // Keep the first chunk for the next writer unless a clone still reads it
+     if (stream->backing == NEXUS_STREAM_CHUNKED) {
+         NexusStreamChunks* chunks = stream->chunks;
+         size_t keep = chunks->count > 0 && atomic_load(&chunks->slices[0].chunk->refs) == 1 ? 1 : 0;
+         release_slices(chunks, keep);
+         chunks->count = keep;
+         if (keep) {
+             chunks->slices[0].length = 0;
+         }
+         sync_chunked_view(stream);
+     }
+ }
+ 
+ /**
+  * Prepare a stream for reuse
+  */
+ void sps_stream_recycle(NexusDataStream* stream) {
+     if (!stream) {
+         return;
+     }
+     
+     sps_stream_clear(stream);
+     
+     // Drop metadata left by the previous user
+     nexus_metadata_clear(&stream->metadata);
  }
  
  /**
@@ -317,18 +613,20 @@
          free(stream->data);
      }
      
+     if (stream->chunks) {
+         release_slices(stream->chunks, 0);
+         free(stream->chunks->slices);
+         free(stream->chunks);
+     }
+     release_mapping(stream->mapping);
+     
      // Free the format string
      if (stream->format) {
          free((void*)stream->format);
      }
      
      // Free metadata entries
-     StreamMetadataEntry* entry = stream->metadata;
-     while (entry) {
-         StreamMetadataEntry* next = entry->next;
-         free_metadata_entry(entry);
-         entry = next;
-     }
+     nexus_metadata_destroy(&stream->metadata);
      
      // Free the stream itself
      free(stream);
@@ -342,14 +640,24 @@
          return NULL;
      }
      
-     // Create a new stream with the same capacity
-     NexusDataStream* clone = sps_stream_create(stream->capacity);
-     if (!clone) {
-         return NULL;
+     NexusDataStream* clone;
+     if (stream->backing == NEXUS_STREAM_CONTIGUOUS) {
+         // Create a new stream with the same capacity
+         clone = sps_stream_create(stream->capacity);
+         if (!clone) {
+             return NULL;
+         }
+         
+         // Copy data
+         if (stream->size > 0) {
+             memcpy(clone->data, stream->data, stream->size);
+         }
+     } else {
+         clone = share_payload(stream);
+         if (!clone) {
+             return NULL;
+         }
      }
-     
-     // Copy data
-     memcpy(clone->data, stream->data, stream->size);
      clone->size = stream->size;
      clone->position = stream->position;
      
@@ -362,15 +670,343 @@
          }
      }
      
-     // Copy metadata
-     StreamMetadataEntry* entry = stream->metadata;
-     while (entry) {
-         // Deep copy would require knowing how to clone the values
-         // For now, we'll just copy the references
-         // In a real implementation, we'd need a way to clone metadata values
-         sps_stream_set_metadata(clone, entry->key, entry->value, entry->free_func);
-         entry = entry->next;
+     // Copy metadata; the values stay owned by the original
+     if (nexus_metadata_copy(&clone->metadata, &stream->metadata) != NEXUS_SUCCESS) {
+         sps_stream_destroy(clone);
+         return NULL;
+     }
+     
+     return clone;
+ }
+ 
+ /**
+  * Drop a reference to a chunk
+  */
+ static void release_chunk(NexusStreamChunk* chunk) {
+     if (chunk && atomic_fetch_sub_explicit(&chunk->refs, 1, memory_order_acq_rel) == 1) {
+         free(chunk);
+     }
+ }
+ 
+ /**
+  * Drop the chunks of slices [from, count)
+  */
+ static void release_slices(NexusStreamChunks* chunks, size_t from) {
+     for (size_t i = from; i < chunks->count; i++) {
+         release_chunk(chunks->slices[i].chunk);
+         chunks->slices[i].chunk = NULL;
+     }
+     chunks->count = from < chunks->count ? from : chunks->count;
+     chunks->cursor_index = 0;
+     chunks->cursor_start = 0;
+ }
+ 
+ /**
+  * Append an empty, unshared chunk
+  */
+ static NexusResult push_chunk(NexusStreamChunks* chunks, size_t capacity) {
+     if (chunks->count == chunks->slots) {
+         size_t slots = chunks->slots ? chunks->slots * 2 : 8;
+         NexusStreamSlice* slices = (NexusStreamSlice*)realloc(chunks->slices, slots * sizeof(NexusStreamSlice));
+         if (!slices) {
+             return NEXUS_OUT_OF_MEMORY;
+         }
+         chunks->slices = slices;
+         chunks->slots = slots;
+     }
+     
+     NexusStreamChunk* chunk = (NexusStreamChunk*)malloc(sizeof(NexusStreamChunk) + capacity);
+     if (!chunk) {
+         return NEXUS_OUT_OF_MEMORY;
+     }
+     atomic_init(&chunk->refs, 1);
+     chunk->capacity = capacity;
+     
+     chunks->slices[chunks->count].chunk = chunk;
+     chunks->slices[chunks->count].length = 0;
+     chunks->count++;
+     return NEXUS_SUCCESS;
+ }
+ 
+ /**
+  * Whether the stream may write into a slice's chunk in place
+  */
+ static bool slice_is_private(const NexusStreamSlice* slice) {
+     return atomic_load_explicit(&slice->chunk->refs, memory_order_acquire) == 1;
+ }
+ 
+ /**
+  * Point data/capacity of a chunked stream at its current chunks
+  */
+ static void sync_chunked_view(NexusDataStream* stream) {
+     NexusStreamChunks* chunks = stream->chunks;
+     
+     // Zero-length tail chunks don't break contiguity
+     size_t used = chunks->count;
+     while (used > 1 && chunks->slices[used - 1].length == 0) {
+         used--;
+     }
+     stream->data = used == 1 ? chunks->slices[0].chunk->bytes : NULL;
+     
+     // Writable without allocating: the room left in an unshared tail
+     stream->capacity = stream->size;
+     if (chunks->count > 0) {
+         const NexusStreamSlice* tail = &chunks->slices[chunks->count - 1];
+         if (slice_is_private(tail)) {
+             stream->capacity += tail->chunk->capacity - tail->length;
+         }
+     }
+ }
+ 
+ /**
+  * Find the slice holding a stream offset
+  *
+  * Returns the slice index and stores its stream offset in @p start.
+  * Offsets at or past the end map to the slice count.
+  */
+ static size_t locate_chunk(const NexusStreamChunks* chunks, size_t offset, size_t* start) {
+     size_t index = 0;
+     size_t base = 0;
+     
+     // Sequential access resumes from the last slice looked up
+     if (chunks->cursor_index < chunks->count && chunks->cursor_start <= offset) {
+         index = chunks->cursor_index;
+         base = chunks->cursor_start;
+     }
+     
+     while (index < chunks->count && offset >= base + chunks->slices[index].length) {
+         base += chunks->slices[index].length;
+         index++;
+     }
+     
+     *start = base;
+     return index;
+ }
+ 
+ /**
+  * Remember the slice holding an offset for the next lookup
+  */
+ static void remember_chunk(NexusStreamChunks* chunks, size_t offset) {
+     size_t start;
+     size_t index = locate_chunk(chunks, offset, &start);
+     if (index < chunks->count) {
+         chunks->cursor_index = index;
+         chunks->cursor_start = start;
+     }
+ }
+ 
+ /**
+  * Copy bytes out of a chunked stream
+  */
+ static void read_chunked(const NexusStreamChunks* chunks, size_t offset, void* buffer, size_t size) {
+     size_t start;
+     size_t index = locate_chunk(chunks, offset, &start);
+     unsigned char* out = (unsigned char*)buffer;
+     
+     while (size > 0 && index < chunks->count) {
+         const NexusStreamSlice* slice = &chunks->slices[index];
+         size_t skip = offset - start;
+         size_t n = slice->length - skip;
+         if (n > size) {
+             n = size;
+         }
+         
+         memcpy(out, slice->chunk->bytes + skip, n);
+         out += n;
+         offset += n;
+         size -= n;
+         start += slice->length;
+         index++;
+     }
+ }
+ 
+ /**
+  * Append bytes to a chunked stream; NULL data appends zeros
+  */
+ static NexusResult append_chunked(NexusDataStream* stream, const void* data, size_t size) {
+     NexusStreamChunks* chunks = stream->chunks;
+     const unsigned char* in = (const unsigned char*)data;
+     
+     while (size > 0) {
+         NexusStreamSlice* tail = chunks->count > 0 ? &chunks->slices[chunks->count - 1] : NULL;
+         
+         // A shared tail is frozen at this stream's length; start a new chunk
+         if (!tail || tail->length == tail->chunk->capacity || !slice_is_private(tail)) {
+             // Grow chunk sizes with the stream to bound the chunk count
+             size_t capacity = stream->size < SPS_STREAM_MAX_CHUNK ? stream->size : SPS_STREAM_MAX_CHUNK;
+             if (capacity < chunks->chunk_size) {
+                 capacity = chunks->chunk_size;
+             }
+             if (capacity < size) {
+                 capacity = size;
+             }
+             
+             NexusResult result = push_chunk(chunks, capacity);
+             if (result != NEXUS_SUCCESS) {
+                 sync_chunked_view(stream);
+                 return result;
+             }
+             tail = &chunks->slices[chunks->count - 1];
+         }
+         
+         size_t n = tail->chunk->capacity - tail->length;
+         if (n > size) {
+             n = size;
+         }
+         
+         if (in) {
+             memcpy(tail->chunk->bytes + tail->length, in, n);
+             in += n;
+         } else {
+             memset(tail->chunk->bytes + tail->length, 0, n);
+         }
+         tail->length += n;
+         stream->size += n;
+         size -= n;
+     }
+     
+     sync_chunked_view(stream);
+     return NEXUS_SUCCESS;
+ }
+ 
+ /**
+  * Write at the current position of a chunked stream
+  *
+  * Overwritten chunks that are shared with a clone are copied first;
+  * bytes past the end are appended.
+  */
+ static NexusResult write_chunked(NexusDataStream* stream, const void* data, size_t size) {
+     NexusStreamChunks* chunks = stream->chunks;
+     const unsigned char* in = (const unsigned char*)data;
+     NexusResult result;
+     
+     // Writing past the end leaves a zero-filled gap
+     if (stream->position > stream->size) {
+         result = append_chunked(stream, NULL, stream->position - stream->size);
+         if (result != NEXUS_SUCCESS) {
+             return result;
+         }
+     }
+     
+     size_t start;
+     size_t index = locate_chunk(chunks, stream->position, &start);
+     while (size > 0 && index < chunks->count) {
+         NexusStreamSlice* slice = &chunks->slices[index];
+         
+         if (!slice_is_private(slice)) {
+             NexusStreamChunk* copy = (NexusStreamChunk*)malloc(sizeof(NexusStreamChunk) + slice->length);
+             if (!copy) {
+                 return NEXUS_OUT_OF_MEMORY;
+             }
+             atomic_init(&copy->refs, 1);
+             copy->capacity = slice->length;
+             memcpy(copy->bytes, slice->chunk->bytes, slice->length);
+             release_chunk(slice->chunk);
+             slice->chunk = copy;
+         }
+         
+         size_t skip = stream->position - start;
+         size_t n = slice->length - skip;
+         if (n > size) {
+             n = size;
+         }
+         
+         memcpy(slice->chunk->bytes + skip, in, n);
+         in += n;
+         size -= n;
+         stream->position += n;
+         start += slice->length;
+         index++;
+     }
+     
+     if (size > 0) {
+         result = append_chunked(stream, in, size);
+         if (result != NEXUS_SUCCESS) {
+             return result;
+         }
+         stream->position += size;
+     }
+     
+     remember_chunk(chunks, stream->position);
+     sync_chunked_view(stream);
+     return NEXUS_SUCCESS;
+ }
+ 
+ /**
+  * Drop a reference to a file mapping
+  */
+ static void release_mapping(NexusStreamMapping* mapping) {
+     if (mapping && atomic_fetch_sub_explicit(&mapping->refs, 1, memory_order_acq_rel) == 1) {
+         munmap(mapping->address, mapping->length);
+         free(mapping);
+     }
+ }
+ 
+ /**
+  * Turn a mapped stream into a contiguous one holding a private copy
+  */
+ static NexusResult detach_mapping(NexusDataStream* stream, size_t capacity) {
+     if (capacity < 128) {
+         capacity = 128;
+     }
+     
+     void* data = malloc(capacity);
+     if (!data) {
+         return NEXUS_OUT_OF_MEMORY;
+     }
+     memcpy(data, stream->data, stream->size);
+     
+     release_mapping(stream->mapping);
+     stream->mapping = NULL;
+     stream->data = data;
+     stream->capacity = capacity;
+     stream->owns_data = true;
+     stream->backing = NEXUS_STREAM_CONTIGUOUS;
+     
+     return NEXUS_SUCCESS;
+ }
+ 
+ /**
+  * Create a stream sharing the payload of a chunked or mapped stream
+  */
+ static NexusDataStream* share_payload(const NexusDataStream* stream) {
+     NexusDataStream* clone = (NexusDataStream*)calloc(1, sizeof(NexusDataStream));
+     if (!clone) {
+         return NULL;
+     }
+     clone->backing = stream->backing;
+     clone->size = stream->size;
+     
+     if (stream->backing == NEXUS_STREAM_MAPPED) {
+         atomic_fetch_add_explicit(&stream->mapping->refs, 1, memory_order_relaxed);
+         clone->mapping = stream->mapping;
+         clone->data = stream->data;
+         clone->capacity = stream->capacity;
+         return clone;
+     }
+     
+     const NexusStreamChunks* source = stream->chunks;
+     NexusStreamChunks* chunks = (NexusStreamChunks*)calloc(1, sizeof(NexusStreamChunks));
+     NexusStreamSlice* slices = source->count > 0
+         ? (NexusStreamSlice*)malloc(source->count * sizeof(NexusStreamSlice))
+         : NULL;
+     if (!chunks || (source->count > 0 && !slices)) {
+         free(slices);
+         free(chunks);
+         free(clone);
+         return NULL;
+     }
+     
+     for (size_t i = 0; i < source->count; i++) {
+         atomic_fetch_add_explicit(&source->slices[i].chunk->refs, 1, memory_order_relaxed);
+         slices[i] = source->slices[i];
      }
+     chunks->slices = slices;
+     chunks->count = source->count;
+     chunks->slots = source->count;
+     chunks->chunk_size = source->chunk_size;
+     clone->chunks = chunks;
      
+     sync_chunked_view(clone);
      return clone;
- }
\ No newline at end of file
+ }
@@ -0,0 +1,468 @@
+/**
+ * @file concurrent_symbols.c
+ * @brief Lock-free read path for the NexusLink symbol registry
+ *
+ * Readers announce the global epoch they entered in, then read the table's
+ * published snapshot without taking any lock. Writers serialize on a
+ * per-table recursive mutex, copy the table into a fresh snapshot and swap
+ * it in; the old snapshot is stamped with the next epoch and freed once
+ * every active reader has announced an epoch at least that new.
+ *
+ * Reference counters live in cache-line blocks of NEXUS_REF_BLOCK_SIZE
+ * symbols per stripe. Each thread increments only its own stripe, and the
+ * blocks never move, so snapshots share them with the writer table.
+ *
+ * Copyright © 2025 OBINexus Computing
+ */
+
+ #include "nlink/core/symbols/concurrent_symbols.h"
+ #include <pthread.h>
+ #include <stdatomic.h>
+ #include <stdlib.h>
+ #include <string.h>
+
+ #define NEXUS_CACHE_LINE 64
+ #define NEXUS_REF_BLOCK_SIZE (NEXUS_CACHE_LINE / sizeof(uint32_t))
+
+ struct NexusSymbolRefCounter {
+     _Atomic uint32_t value;
+ };
+
+ // One row per stripe, one cache line per row
+ typedef struct NexusSymbolRefBlock {
+     _Alignas(NEXUS_CACHE_LINE)
+     struct NexusSymbolRefCounter counts[NEXUS_SYMBOL_REF_STRIPES][NEXUS_REF_BLOCK_SIZE];
+     size_t used;
+     struct NexusSymbolRefBlock* next;
+ } NexusSymbolRefBlock;
+
+ // Immutable copy of a table as seen by readers
+ typedef struct NexusSymbolSnapshot {
+     NexusSymbolTable table;
+     uint64_t retire_epoch;
+     struct NexusSymbolSnapshot* next_retired;
+ } NexusSymbolSnapshot;
+
+ struct NexusSymbolTableSync {
+     pthread_mutex_t writer_lock;                 // Recursive, for nested updates
+     _Atomic(NexusSymbolSnapshot*) published;
+     NexusSymbolSnapshot* retired;
+     NexusSymbolRefBlock* blocks;
+     int update_depth;
+     bool changed;
+ };
+
+ // Per-thread reader state, padded so readers never share a cache line
+ typedef struct NexusEpochRecord {
+     _Alignas(NEXUS_CACHE_LINE) _Atomic uint64_t active_epoch;  // 0 when quiescent
+     atomic_bool in_use;
+     unsigned nesting;
+     unsigned stripe;
+     struct NexusEpochRecord* next;
+ } NexusEpochRecord;
+
+ static _Atomic uint64_t epoch_global = 1;
+ static _Atomic(NexusEpochRecord*) epoch_records = NULL;
+ static atomic_uint epoch_next_stripe = 0;
+ static atomic_uint epoch_anonymous_readers = 0;
+ static pthread_key_t epoch_key;
+ static pthread_once_t epoch_key_once = PTHREAD_ONCE_INIT;
+ static _Thread_local NexusEpochRecord* epoch_self = NULL;
+ static _Thread_local unsigned epoch_anonymous_nesting = 0;
+
+ /*---------------------------------------------------------------------------*/
+ /* Epoch tracking                                                            */
+ /*---------------------------------------------------------------------------*/
+
+ // Thread exit: hand the record back for reuse by a future thread
+ static void epoch_record_release(void* data) {
+     NexusEpochRecord* record = (NexusEpochRecord*)data;
+     record->nesting = 0;
+     atomic_store(&record->active_epoch, 0);
+     atomic_store(&record->in_use, false);
+ }
+
+ static void epoch_key_create(void) {
+     pthread_key_create(&epoch_key, epoch_record_release);
+ }
+
+ static NexusEpochRecord* epoch_record_self(void) {
+     if (epoch_self) {
+         return epoch_self;
+     }
+
+     pthread_once(&epoch_key_once, epoch_key_create);
+
+     // Reuse a record left behind by an exited thread
+     NexusEpochRecord* record = atomic_load(&epoch_records);
+     for (; record; record = record->next) {
+         bool expected = false;
+         if (atomic_compare_exchange_strong(&record->in_use, &expected, true)) {
+             break;
+         }
+     }
+
+     if (!record) {
+         record = (NexusEpochRecord*)aligned_alloc(NEXUS_CACHE_LINE, sizeof(NexusEpochRecord));
+         if (!record) {
+             return NULL;
+         }
+
+         memset(record, 0, sizeof(NexusEpochRecord));
+         atomic_store(&record->in_use, true);
+         record->stripe = atomic_fetch_add(&epoch_next_stripe, 1) % NEXUS_SYMBOL_REF_STRIPES;
+
+         NexusEpochRecord* head = atomic_load(&epoch_records);
+         do {
+             record->next = head;
+         } while (!atomic_compare_exchange_weak(&epoch_records, &head, record));
+     }
+
+     pthread_setspecific(epoch_key, record);
+     epoch_self = record;
+     return record;
+ }
+
+ void nexus_symbol_read_lock(void) {
+     NexusEpochRecord* record = epoch_record_self();
+     if (!record) {
+         // No record available: block all reclamation while we read
+         if (epoch_anonymous_nesting++ == 0) {
+             atomic_fetch_add(&epoch_anonymous_readers, 1);
+         }
+         return;
+     }
+
+     if (record->nesting++ == 0) {
+         // Sequentially consistent store orders the announcement before
+         // the snapshot loads that follow it
+         atomic_store(&record->active_epoch, atomic_load(&epoch_global));
+     }
+ }
+
+ void nexus_symbol_read_unlock(void) {
+     if (epoch_anonymous_nesting > 0) {
+         if (--epoch_anonymous_nesting == 0) {
+             atomic_fetch_sub(&epoch_anonymous_readers, 1);
+         }
+         return;
+     }
+
+     NexusEpochRecord* record = epoch_self;
+     if (record && record->nesting > 0 && --record->nesting == 0) {
+         atomic_store_explicit(&record->active_epoch, 0, memory_order_release);
+     }
+ }
+
+ // Oldest epoch any reader may still be using; UINT64_MAX if none
+ static uint64_t epoch_min_active(void) {
+     if (atomic_load(&epoch_anonymous_readers) > 0) {
+         return 0;
+     }
+
+     uint64_t min_epoch = UINT64_MAX;
+     for (NexusEpochRecord* record = atomic_load(&epoch_records); record; record = record->next) {
+         uint64_t epoch = atomic_load(&record->active_epoch);
+         if (epoch != 0 && epoch < min_epoch) {
+             min_epoch = epoch;
+         }
+     }
+
+     return min_epoch;
+ }
+
+ /*---------------------------------------------------------------------------*/
+ /* Snapshots                                                                 */
+ /*---------------------------------------------------------------------------*/
+
+ static NexusSymbolSnapshot* snapshot_create(const NexusSymbolTable* table) {
+     NexusSymbolSnapshot* snapshot = (NexusSymbolSnapshot*)calloc(1, sizeof(NexusSymbolSnapshot));
+     if (!snapshot) {
+         return NULL;
+     }
+
+     size_t symbol_count = table->size ? table->size : 1;
+     snapshot->table.symbols = (NexusSymbol*)malloc(symbol_count * sizeof(NexusSymbol));
+     snapshot->table.index = (uint64_t*)malloc(table->index_capacity * sizeof(uint64_t));
+     if (!snapshot->table.symbols || !snapshot->table.index) {
+         free(snapshot->table.symbols);
+         free(snapshot->table.index);
+         free(snapshot);
+         return NULL;
+     }
+
+     memcpy(snapshot->table.symbols, table->symbols, table->size * sizeof(NexusSymbol));
+     memcpy(snapshot->table.index, table->index, table->index_capacity * sizeof(uint64_t));
+     snapshot->table.size = table->size;
+     snapshot->table.capacity = table->size;
+     snapshot->table.index_capacity = table->index_capacity;
+     snapshot->table.sync = NULL;
+
+     return snapshot;
+ }
+
+ static void snapshot_free(NexusSymbolSnapshot* snapshot) {
+     free(snapshot->table.symbols);
+     free(snapshot->table.index);
+     free(snapshot);
+ }
+
+ // Free retired snapshots no reader can still see. Caller holds writer_lock.
+ static void sync_reclaim(struct NexusSymbolTableSync* sync) {
+     uint64_t min_epoch = epoch_min_active();
+     NexusSymbolSnapshot** link = &sync->retired;
+
+     while (*link) {
+         NexusSymbolSnapshot* snapshot = *link;
+         if (snapshot->retire_epoch <= min_epoch) {
+             *link = snapshot->next_retired;
+             snapshot_free(snapshot);
+         } else {
+             link = &snapshot->next_retired;
+         }
+     }
+ }
+
+ // Publish the writer table as a new snapshot. Caller holds writer_lock.
+ static void sync_publish(NexusSymbolTable* table) {
+     struct NexusSymbolTableSync* sync = table->sync;
+
+     NexusSymbolSnapshot* snapshot = snapshot_create(table);
+     if (!snapshot) {
+         // Keep serving the previous snapshot; retry on the next update
+         return;
+     }
+
+     NexusSymbolSnapshot* old = atomic_exchange(&sync->published, snapshot);
+     if (old) {
+         old->retire_epoch = atomic_fetch_add(&epoch_global, 1) + 1;
+         old->next_retired = sync->retired;
+         sync->retired = old;
+     }
+
+     sync->changed = false;
+     sync_reclaim(sync);
+ }
+
+ /*---------------------------------------------------------------------------*/
+ /* Striped reference counters                                                */
+ /*---------------------------------------------------------------------------*/
+
+ static struct NexusSymbolRefCounter* sync_alloc_counters(struct NexusSymbolTableSync* sync) {
+     NexusSymbolRefBlock* block = sync->blocks;
+     if (!block || block->used == NEXUS_REF_BLOCK_SIZE) {
+         block = (NexusSymbolRefBlock*)aligned_alloc(NEXUS_CACHE_LINE, sizeof(NexusSymbolRefBlock));
+         if (!block) {
+             return NULL;
+         }
+
+         memset(block, 0, sizeof(NexusSymbolRefBlock));
+         block->next = sync->blocks;
+         sync->blocks = block;
+     }
+
+     return &block->counts[0][block->used++];
+ }
+
+ void nexus_symbol_ref_acquire(NexusSymbol* symbol) {
+     if (!symbol) {
+         return;
+     }
+
+     if (!symbol->ref_counters) {
+         symbol->ref_count++;
+         return;
+     }
+
+     NexusEpochRecord* record = epoch_record_self();
+     unsigned stripe = record ? record->stripe : 0;
+     atomic_fetch_add_explicit(&symbol->ref_counters[stripe * NEXUS_REF_BLOCK_SIZE].value,
+                               1, memory_order_relaxed);
+ }
+
+ int nexus_symbol_get_ref_count(const NexusSymbol* symbol) {
+     if (!symbol) {
+         return 0;
+     }
+
+     int count = symbol->ref_count;
+     if (symbol->ref_counters) {
+         for (size_t stripe = 0; stripe < NEXUS_SYMBOL_REF_STRIPES; stripe++) {
+             count += (int)atomic_load_explicit(
+                 &symbol->ref_counters[stripe * NEXUS_REF_BLOCK_SIZE].value,
+                 memory_order_relaxed);
+         }
+     }
+
+     return count;
+ }
+
+ /*---------------------------------------------------------------------------*/
+ /* Table mode switching and writer hooks                                     */
+ /*---------------------------------------------------------------------------*/
+
+ NexusResult nexus_symbol_table_enable_concurrent(NexusSymbolTable* table) {
+     if (!table) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+
+     if (table->sync) {
+         return NEXUS_SUCCESS;
+     }
+
+     struct NexusSymbolTableSync* sync =
+         (struct NexusSymbolTableSync*)calloc(1, sizeof(struct NexusSymbolTableSync));
+     if (!sync) {
+         return NEXUS_OUT_OF_MEMORY;
+     }
+
+     pthread_mutexattr_t attr;
+     pthread_mutexattr_init(&attr);
+     pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+     pthread_mutex_init(&sync->writer_lock, &attr);
+     pthread_mutexattr_destroy(&attr);
+
+     // Existing counts stay in ref_count; new uses go to the stripes
+     for (size_t i = 0; i < table->size; i++) {
+         table->symbols[i].ref_counters = sync_alloc_counters(sync);
+         if (!table->symbols[i].ref_counters) {
+             for (size_t j = 0; j < i; j++) {
+                 table->symbols[j].ref_counters = NULL;
+             }
+             table->sync = sync;
+             nexus_symbol_table_disable_concurrent(table);
+             return NEXUS_OUT_OF_MEMORY;
+         }
+     }
+
+     table->sync = sync;
+
+     pthread_mutex_lock(&sync->writer_lock);
+     sync_publish(table);
+     pthread_mutex_unlock(&sync->writer_lock);
+
+     if (!atomic_load(&sync->published)) {
+         nexus_symbol_table_disable_concurrent(table);
+         return NEXUS_OUT_OF_MEMORY;
+     }
+
+     return NEXUS_SUCCESS;
+ }
+
+ NexusResult nexus_symbol_registry_enable_concurrent(NexusSymbolRegistry* registry) {
+     if (!registry) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+
+     NexusResult result = nexus_symbol_table_enable_concurrent(&registry->exported);
+     if (result == NEXUS_SUCCESS) {
+         result = nexus_symbol_table_enable_concurrent(&registry->imported);
+     }
+     if (result == NEXUS_SUCCESS) {
+         result = nexus_symbol_table_enable_concurrent(&registry->global);
+     }
+
+     return result;
+ }
+
+ void nexus_symbol_table_disable_concurrent(NexusSymbolTable* table) {
+     if (!table || !table->sync) {
+         return;
+     }
+
+     struct NexusSymbolTableSync* sync = table->sync;
+
+     // Fold striped counts back into the plain counter
+     for (size_t i = 0; i < table->size; i++) {
+         NexusSymbol* symbol = &table->symbols[i];
+         if (symbol->ref_counters) {
+             symbol->ref_count = nexus_symbol_get_ref_count(symbol);
+             symbol->ref_counters = NULL;
+         }
+     }
+
+     NexusSymbolSnapshot* published = atomic_exchange(&sync->published, NULL);
+     if (published) {
+         snapshot_free(published);
+     }
+
+     while (sync->retired) {
+         NexusSymbolSnapshot* next = sync->retired->next_retired;
+         snapshot_free(sync->retired);
+         sync->retired = next;
+     }
+
+     while (sync->blocks) {
+         NexusSymbolRefBlock* next = sync->blocks->next;
+         free(sync->blocks);
+         sync->blocks = next;
+     }
+
+     pthread_mutex_destroy(&sync->writer_lock);
+     free(sync);
+     table->sync = NULL;
+ }
+
+ void nexus_symbol_table_begin_update(NexusSymbolTable* table) {
+     if (!table || !table->sync) {
+         return;
+     }
+
+     pthread_mutex_lock(&table->sync->writer_lock);
+     table->sync->update_depth++;
+ }
+
+ void nexus_symbol_table_end_update(NexusSymbolTable* table) {
+     if (!table || !table->sync) {
+         return;
+     }
+
+     struct NexusSymbolTableSync* sync = table->sync;
+     if (--sync->update_depth == 0 && sync->changed) {
+         sync_publish(table);
+     }
+
+     pthread_mutex_unlock(&sync->writer_lock);
+ }
+
+ NexusResult nexus_symbol_table_attach_counters(NexusSymbolTable* table, NexusSymbol* symbol) {
+     if (!table || !symbol) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+
+     symbol->ref_counters = NULL;
+     if (!table->sync) {
+         return NEXUS_SUCCESS;
+     }
+
+     symbol->ref_counters = sync_alloc_counters(table->sync);
+     if (!symbol->ref_counters) {
+         return NEXUS_OUT_OF_MEMORY;
+     }
+
+     table->sync->changed = true;
+     return NEXUS_SUCCESS;
+ }
+
+ void nexus_symbol_table_mark_changed(NexusSymbolTable* table) {
+     if (table && table->sync) {
+         table->sync->changed = true;
+     }
+ }
+
+ NexusSymbol* nexus_symbol_table_find_published(NexusSymbolTable* table, const char* name, uint64_t hash) {
+     if (!table || !name) {
+         return NULL;
+     }
+
+     if (!table->sync) {
+         return nexus_symbol_table_find_hashed(table, name, hash);
+     }
+
+     NexusSymbolSnapshot* snapshot = atomic_load(&table->sync->published);
+     if (!snapshot) {
+         return NULL;
+     }
+
+     return nexus_symbol_table_find_hashed(&snapshot->table, name, hash);
+ }
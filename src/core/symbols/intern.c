@@ -0,0 +1,208 @@
+/**
+ * @file intern.c
+ * @brief Process-wide string intern pool for NexusLink
+ *
+ * The pool is an open-addressing table of entry pointers. Insertions are
+ * serialized by a mutex; lookups are lock-free. When the table grows, the
+ * new table is published atomically and the old one is retired (kept alive
+ * until cleanup) so concurrent readers never touch freed memory.
+ *
+ * Copyright © 2025 OBINexus Computing
+ */
+
+ #include "nlink/core/symbols/intern.h"
+ #include <pthread.h>
+ #include <stdatomic.h>
+ #include <stdlib.h>
+ #include <string.h>
+
+ #define NEXUS_INTERN_INITIAL_CAPACITY 1024
+
+ // Interned string with its header; the public pointer is &entry->str
+ typedef struct NexusInternEntry {
+     uint64_t hash;
+     size_t length;
+     char str[];
+ } NexusInternEntry;
+
+ typedef struct NexusInternTable {
+     size_t capacity;                      // Always a power of two
+     struct NexusInternTable* retired;     // Older tables kept for readers
+     _Atomic(NexusInternEntry*) slots[];
+ } NexusInternTable;
+
+ static _Atomic(NexusInternTable*) intern_table = NULL;
+ static size_t intern_count = 0;
+ static pthread_mutex_t intern_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+ // FNV-1a, with 0 reserved so callers can use it as "no hash"
+ uint64_t nexus_intern_hash(const char* str) {
+     uint64_t hash = 14695981039346656037ULL;
+     if (!str) {
+         return hash;
+     }
+
+     for (const unsigned char* p = (const unsigned char*)str; *p; p++) {
+         hash ^= *p;
+         hash *= 1099511628211ULL;
+     }
+
+     return hash ? hash : 1;
+ }
+
+ static NexusInternTable* intern_table_create(size_t capacity) {
+     NexusInternTable* table = (NexusInternTable*)calloc(1, sizeof(NexusInternTable) +
+                                     capacity * sizeof(_Atomic(NexusInternEntry*)));
+     if (!table) {
+         return NULL;
+     }
+
+     table->capacity = capacity;
+     return table;
+ }
+
+ // Probe for str; returns the entry or NULL. Lock-free.
+ static NexusInternEntry* intern_table_probe(NexusInternTable* table,
+                                             const char* str,
+                                             uint64_t hash) {
+     size_t mask = table->capacity - 1;
+     for (size_t i = (size_t)hash & mask;; i = (i + 1) & mask) {
+         NexusInternEntry* entry = atomic_load_explicit(&table->slots[i], memory_order_acquire);
+         if (!entry) {
+             return NULL;
+         }
+         if (entry->hash == hash && strcmp(entry->str, str) == 0) {
+             return entry;
+         }
+     }
+ }
+
+ static void intern_table_place(NexusInternTable* table, NexusInternEntry* entry) {
+     size_t mask = table->capacity - 1;
+     size_t i = (size_t)entry->hash & mask;
+     while (atomic_load_explicit(&table->slots[i], memory_order_relaxed)) {
+         i = (i + 1) & mask;
+     }
+     atomic_store_explicit(&table->slots[i], entry, memory_order_release);
+ }
+
+ // Grow the table to keep the load factor under 1/2. Caller holds intern_mutex.
+ static NexusInternTable* intern_table_grow(NexusInternTable* table) {
+     size_t new_capacity = table ? table->capacity * 2 : NEXUS_INTERN_INITIAL_CAPACITY;
+     NexusInternTable* grown = intern_table_create(new_capacity);
+     if (!grown) {
+         return NULL;
+     }
+
+     if (table) {
+         for (size_t i = 0; i < table->capacity; i++) {
+             NexusInternEntry* entry = atomic_load_explicit(&table->slots[i], memory_order_relaxed);
+             if (entry) {
+                 intern_table_place(grown, entry);
+             }
+         }
+         grown->retired = table;
+     }
+
+     atomic_store_explicit(&intern_table, grown, memory_order_release);
+     return grown;
+ }
+
+ const char* nexus_intern_lookup(const char* str) {
+     if (!str) {
+         return NULL;
+     }
+
+     NexusInternTable* table = atomic_load_explicit(&intern_table, memory_order_acquire);
+     if (!table) {
+         return NULL;
+     }
+
+     NexusInternEntry* entry = intern_table_probe(table, str, nexus_intern_hash(str));
+     return entry ? entry->str : NULL;
+ }
+
+ const char* nexus_intern(const char* str) {
+     if (!str) {
+         return NULL;
+     }
+
+     uint64_t hash = nexus_intern_hash(str);
+
+     // Fast path: already interned
+     NexusInternTable* table = atomic_load_explicit(&intern_table, memory_order_acquire);
+     if (table) {
+         NexusInternEntry* entry = intern_table_probe(table, str, hash);
+         if (entry) {
+             return entry->str;
+         }
+     }
+
+     pthread_mutex_lock(&intern_mutex);
+
+     // Re-check under the lock; another writer may have won the race
+     table = atomic_load_explicit(&intern_table, memory_order_relaxed);
+     if (table) {
+         NexusInternEntry* entry = intern_table_probe(table, str, hash);
+         if (entry) {
+             pthread_mutex_unlock(&intern_mutex);
+             return entry->str;
+         }
+     }
+
+     if (!table || (intern_count + 1) * 2 > table->capacity) {
+         table = intern_table_grow(table);
+         if (!table) {
+             pthread_mutex_unlock(&intern_mutex);
+             return NULL;
+         }
+     }
+
+     size_t length = strlen(str);
+     NexusInternEntry* entry = (NexusInternEntry*)malloc(sizeof(NexusInternEntry) + length + 1);
+     if (!entry) {
+         pthread_mutex_unlock(&intern_mutex);
+         return NULL;
+     }
+
+     entry->hash = hash;
+     entry->length = length;
+     memcpy(entry->str, str, length + 1);
+
+     intern_table_place(table, entry);
+     intern_count++;
+
+     pthread_mutex_unlock(&intern_mutex);
+     return entry->str;
+ }
+
+ uint64_t nexus_intern_hash_of(const char* interned) {
+     if (!interned) {
+         return nexus_intern_hash(NULL);
+     }
+
+     const NexusInternEntry* entry =
+         (const NexusInternEntry*)(interned - offsetof(NexusInternEntry, str));
+     return entry->hash;
+ }
+
+ void nexus_intern_cleanup(void) {
+     pthread_mutex_lock(&intern_mutex);
+
+     NexusInternTable* table = atomic_exchange(&intern_table, NULL);
+     if (table) {
+         // The newest table references every live entry
+         for (size_t i = 0; i < table->capacity; i++) {
+             free(atomic_load_explicit(&table->slots[i], memory_order_relaxed));
+         }
+     }
+
+     while (table) {
+         NexusInternTable* retired = table->retired;
+         free(table);
+         table = retired;
+     }
+
+     intern_count = 0;
+     pthread_mutex_unlock(&intern_mutex);
+ }
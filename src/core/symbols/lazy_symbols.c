@@ -0,0 +1,334 @@
+/**
+ * @file lazy_symbols.c
+ * @brief dlopen-backed lazy binding for the NexusLink symbol registry
+ *
+ * Works like a PLT. Stub i is a fixed-size code block that jumps through
+ * slot i of nexus_lazy_got. The slot initially points back into the stub,
+ * at a path that pushes i and enters the resolve trampoline. The
+ * trampoline saves the argument registers, calls nexus_lazy_bind_stub()
+ * (dlopen + dlsym + registry patch), stores the real address in the slot,
+ * restores the registers and tail-jumps to the real function. Afterwards
+ * the stub is a single indirect jump.
+ *
+ * Copyright © 2025 OBINexus Computing
+ */
+
+ #include "nlink/core/symbols/lazy_symbols.h"
+ #include "nlink/core/symbols/concurrent_symbols.h"
+ #include <dlfcn.h>
+ #include <pthread.h>
+ #include <stdatomic.h>
+
+ #define NEXUS_LAZY_STR_(x) #x
+ #define NEXUS_LAZY_STR(x) NEXUS_LAZY_STR_(x)
+
+ // Binding state of one stub
+ typedef struct NexusLazyBinding {
+     const char* name;            // Interned registry name
+     const char* library_symbol;  // Interned dlsym name
+     const char* library_path;    // Interned library path
+     NexusSymbolTable* table;     // Table to patch, NULL once detached
+     void* address;               // Real address once bound
+ } NexusLazyBinding;
+
+ // Library loaded by lazy binding, keyed by interned path
+ typedef struct NexusLazyLibrary {
+     const char* path;
+     void* handle;
+ } NexusLazyLibrary;
+
+ static NexusLazyBinding lazy_bindings[NEXUS_LAZY_MAX_STUBS];
+ static size_t lazy_stub_count = 0;
+ static size_t lazy_bound_count = 0;
+ static NexusLazyLibrary* lazy_libraries = NULL;
+ static size_t lazy_library_count = 0;
+ static size_t lazy_library_capacity = 0;
+ static pthread_mutex_t lazy_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+ #if defined(__x86_64__) && defined(__ELF__)
+
+ #define NEXUS_LAZY_HAVE_STUBS 1
+
+ // Each stub is 32 bytes: endbr64, jmp *got[i], then the bind path at
+ // offset 10 (endbr64, push i, jmp trampoline). endbr64 is a NOP on CPUs
+ // without CET.
+ #define NEXUS_LAZY_STUB_SIZE 32
+ #define NEXUS_LAZY_BIND_OFFSET 10
+
+ __attribute__((visibility("hidden"))) _Atomic(void*) nexus_lazy_got[NEXUS_LAZY_MAX_STUBS];
+ __attribute__((visibility("hidden"))) void* nexus_lazy_bind_stub(size_t index);
+ extern char nexus_lazy_stubs[];
+
+ __asm__(
+     "    .text\n"
+     "    .p2align 5\n"
+     "    .globl nexus_lazy_stubs\n"
+     "    .hidden nexus_lazy_stubs\n"
+     "    .type nexus_lazy_stubs, @function\n"
+     "nexus_lazy_stubs:\n"
+     "    .set nexus_lazy_index, 0\n"
+     "    .rept " NEXUS_LAZY_STR(NEXUS_LAZY_MAX_STUBS) "\n"
+     "    .byte 0xf3, 0x0f, 0x1e, 0xfa\n"
+     "    jmp *nexus_lazy_got+8*nexus_lazy_index(%rip)\n"
+     "    .byte 0xf3, 0x0f, 0x1e, 0xfa\n"
+     "    pushq $nexus_lazy_index\n"
+     "    jmp nexus_lazy_trampoline\n"
+     "    .p2align 5\n"
+     "    .set nexus_lazy_index, nexus_lazy_index + 1\n"
+     "    .endr\n"
+     "    .size nexus_lazy_stubs, . - nexus_lazy_stubs\n"
+     "\n"
+     // Stack on entry: stub index, then the caller's return address
+     "    .p2align 4\n"
+     "    .type nexus_lazy_trampoline, @function\n"
+     "nexus_lazy_trampoline:\n"
+     "    pushq %rbp\n"
+     "    movq %rsp, %rbp\n"
+     "    pushq %rdi\n"
+     "    pushq %rsi\n"
+     "    pushq %rdx\n"
+     "    pushq %rcx\n"
+     "    pushq %r8\n"
+     "    pushq %r9\n"
+     "    pushq %rax\n"
+     "    subq $128, %rsp\n"
+     "    movdqu %xmm0, 0(%rsp)\n"
+     "    movdqu %xmm1, 16(%rsp)\n"
+     "    movdqu %xmm2, 32(%rsp)\n"
+     "    movdqu %xmm3, 48(%rsp)\n"
+     "    movdqu %xmm4, 64(%rsp)\n"
+     "    movdqu %xmm5, 80(%rsp)\n"
+     "    movdqu %xmm6, 96(%rsp)\n"
+     "    movdqu %xmm7, 112(%rsp)\n"
+     "    movq 8(%rbp), %rdi\n"
+     "    call nexus_lazy_bind_stub@PLT\n"
+     "    movq %rax, %r11\n"
+     "    movdqu 0(%rsp), %xmm0\n"
+     "    movdqu 16(%rsp), %xmm1\n"
+     "    movdqu 32(%rsp), %xmm2\n"
+     "    movdqu 48(%rsp), %xmm3\n"
+     "    movdqu 64(%rsp), %xmm4\n"
+     "    movdqu 80(%rsp), %xmm5\n"
+     "    movdqu 96(%rsp), %xmm6\n"
+     "    movdqu 112(%rsp), %xmm7\n"
+     "    addq $128, %rsp\n"
+     "    popq %rax\n"
+     "    popq %r9\n"
+     "    popq %r8\n"
+     "    popq %rcx\n"
+     "    popq %rdx\n"
+     "    popq %rsi\n"
+     "    popq %rdi\n"
+     "    popq %rbp\n"
+     "    addq $8, %rsp\n"
+     "    jmp *%r11\n"
+     "    .size nexus_lazy_trampoline, . - nexus_lazy_trampoline\n"
+ );
+
+ static void* lazy_stub_address(size_t index) {
+     return nexus_lazy_stubs + index * NEXUS_LAZY_STUB_SIZE;
+ }
+
+ #endif
+
+ // dlopen a component library once. Caller holds lazy_mutex.
+ static void* lazy_library_open(const char* path) {
+     for (size_t i = 0; i < lazy_library_count; i++) {
+         if (lazy_libraries[i].path == path) {
+             return lazy_libraries[i].handle;
+         }
+     }
+
+     if (lazy_library_count == lazy_library_capacity) {
+         size_t new_capacity = lazy_library_capacity ? lazy_library_capacity * 2 : 16;
+         NexusLazyLibrary* grown = (NexusLazyLibrary*)realloc(lazy_libraries,
+                                                              new_capacity * sizeof(NexusLazyLibrary));
+         if (!grown) {
+             return NULL;
+         }
+         lazy_libraries = grown;
+         lazy_library_capacity = new_capacity;
+     }
+
+     void* handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+     if (!handle) {
+         return NULL;
+     }
+
+     lazy_libraries[lazy_library_count].path = path;
+     lazy_libraries[lazy_library_count].handle = handle;
+     lazy_library_count++;
+     return handle;
+ }
+
+ // Point the registry entry at the real address. Caller holds lazy_mutex.
+ static void lazy_patch_table(NexusLazyBinding* binding, void* stub) {
+     NexusSymbolTable* table = binding->table;
+     if (!table) {
+         return;
+     }
+
+     nexus_symbol_table_begin_update(table);
+     NexusSymbol* symbol = nexus_symbol_table_find_hashed(table, binding->name,
+                                                          nexus_intern_hash_of(binding->name));
+     if (symbol && symbol->address == stub) {
+         symbol->address = binding->address;
+         nexus_symbol_table_mark_changed(table);
+     }
+     nexus_symbol_table_end_update(table);
+ }
+
+ // Bind one lazy symbol; returns its real address or NULL. Caller holds lazy_mutex.
+ static void* lazy_bind(NexusLazyBinding* binding, void* stub) {
+     if (binding->address) {
+         return binding->address;
+     }
+
+     void* handle = lazy_library_open(binding->library_path);
+     if (!handle) {
+         return NULL;
+     }
+
+     void* address = dlsym(handle, binding->library_symbol);
+     if (!address) {
+         return NULL;
+     }
+
+     binding->address = address;
+     lazy_bound_count++;
+     lazy_patch_table(binding, stub);
+     return address;
+ }
+
+ #ifdef NEXUS_LAZY_HAVE_STUBS
+
+ // Called from the trampoline on the first call through stub @p index
+ void* nexus_lazy_bind_stub(size_t index) {
+     pthread_mutex_lock(&lazy_mutex);
+
+     NexusLazyBinding* binding = &lazy_bindings[index];
+     void* address = lazy_bind(binding, lazy_stub_address(index));
+     if (!address) {
+         // Like the dynamic linker, there is no caller to report this to
+         const char* error = dlerror();
+         fprintf(stderr, "nexus: lazy binding of '%s' from '%s' failed: %s\n",
+                 binding->library_symbol, binding->library_path,
+                 error ? error : "symbol not found");
+         abort();
+     }
+
+     atomic_store_explicit(&nexus_lazy_got[index], address, memory_order_release);
+
+     pthread_mutex_unlock(&lazy_mutex);
+     return address;
+ }
+
+ #endif
+
+ NexusResult nexus_symbol_table_add_lazy(NexusSymbolTable* table,
+                                         const char* name,
+                                         const char* library_symbol,
+                                         const char* component_id,
+                                         const char* library_path) {
+     if (!table || !name || !component_id || !library_path) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+
+     const char* interned_name = nexus_intern(name);
+     const char* interned_symbol = nexus_intern(library_symbol ? library_symbol : name);
+     const char* interned_path = nexus_intern(library_path);
+     if (!interned_name || !interned_symbol || !interned_path) {
+         return NEXUS_OUT_OF_MEMORY;
+     }
+
+     pthread_mutex_lock(&lazy_mutex);
+
+     if (lazy_stub_count == NEXUS_LAZY_MAX_STUBS) {
+         pthread_mutex_unlock(&lazy_mutex);
+         return NEXUS_OUT_OF_MEMORY;
+     }
+
+     size_t index = lazy_stub_count++;
+     NexusLazyBinding* binding = &lazy_bindings[index];
+     binding->name = interned_name;
+     binding->library_symbol = interned_symbol;
+     binding->library_path = interned_path;
+     binding->table = table;
+     binding->address = NULL;
+
+ #ifdef NEXUS_LAZY_HAVE_STUBS
+     void* address = lazy_stub_address(index);
+     atomic_store_explicit(&nexus_lazy_got[index],
+                           (char*)address + NEXUS_LAZY_BIND_OFFSET,
+                           memory_order_release);
+ #else
+     // No stubs on this target: bind now, before the symbol is visible
+     binding->table = NULL;
+     void* address = lazy_bind(binding, NULL);
+     binding->table = table;
+     if (!address) {
+         lazy_stub_count--;
+         pthread_mutex_unlock(&lazy_mutex);
+         return NEXUS_NOT_FOUND;
+     }
+ #endif
+
+     pthread_mutex_unlock(&lazy_mutex);
+
+     return nexus_symbol_table_add(table, interned_name, address, NEXUS_SYMBOL_FUNCTION, component_id);
+ }
+
+ bool nexus_lazy_is_unbound_stub(const void* address) {
+ #ifdef NEXUS_LAZY_HAVE_STUBS
+     const char* stub = (const char*)address;
+     if (stub < nexus_lazy_stubs ||
+         stub >= nexus_lazy_stubs + (size_t)NEXUS_LAZY_MAX_STUBS * NEXUS_LAZY_STUB_SIZE) {
+         return false;
+     }
+
+     size_t index = (size_t)(stub - nexus_lazy_stubs) / NEXUS_LAZY_STUB_SIZE;
+     pthread_mutex_lock(&lazy_mutex);
+     bool unbound = index < lazy_stub_count && !lazy_bindings[index].address;
+     pthread_mutex_unlock(&lazy_mutex);
+     return unbound;
+ #else
+     (void)address;
+     return false;
+ #endif
+ }
+
+ void nexus_lazy_get_stats(size_t* stubs, size_t* bound, size_t* libraries) {
+     pthread_mutex_lock(&lazy_mutex);
+     if (stubs) *stubs = lazy_stub_count;
+     if (bound) *bound = lazy_bound_count;
+     if (libraries) *libraries = lazy_library_count;
+     pthread_mutex_unlock(&lazy_mutex);
+ }
+
+ void nexus_lazy_detach_table(NexusSymbolTable* table) {
+     pthread_mutex_lock(&lazy_mutex);
+     for (size_t i = 0; i < lazy_stub_count; i++) {
+         if (lazy_bindings[i].table == table) {
+             lazy_bindings[i].table = NULL;
+         }
+     }
+     pthread_mutex_unlock(&lazy_mutex);
+ }
+
+ void nexus_lazy_cleanup(void) {
+     pthread_mutex_lock(&lazy_mutex);
+
+     for (size_t i = 0; i < lazy_library_count; i++) {
+         dlclose(lazy_libraries[i].handle);
+     }
+     free(lazy_libraries);
+     lazy_libraries = NULL;
+     lazy_library_count = 0;
+     lazy_library_capacity = 0;
+
+     memset(lazy_bindings, 0, lazy_stub_count * sizeof(NexusLazyBinding));
+     lazy_stub_count = 0;
+     lazy_bound_count = 0;
+
+     pthread_mutex_unlock(&lazy_mutex);
+ }
@@ -0,0 +1,233 @@
+/**
+ * @file metadata_store.c
+ * @brief Key/value metadata keyed by interned strings
+ *
+ * Small stores are a linear scan over the inline entries with pointer
+ * comparisons. Once the inline entries are used up, every entry is
+ * indexed by an open-addressing table (linear probing, load factor at most
+ * one half) built from the precomputed intern hashes.
+ *
+ * Copyright © 2025 OBINexus Computing
+ */
+
+ #include "nlink/core/symbols/metadata_store.h"
+ #include "nlink/core/symbols/intern.h"
+ #include <stdlib.h>
+ #include <string.h>
+
+ #define NEXUS_METADATA_MIN_SLOTS 32
+
+ // Find the slot holding an interned key, or the empty slot where it belongs
+ static size_t find_slot(const NexusMetadataStore* store, const char* interned_key) {
+     size_t mask = store->index_slots - 1;
+     size_t slot = (size_t)nexus_intern_hash_of(interned_key) & mask;
+     while (store->index[slot] != 0 &&
+            nexus_metadata_entry_at(store, store->index[slot] - 1)->key != interned_key) {
+         slot = (slot + 1) & mask;
+     }
+     return slot;
+ }
+
+ // Rebuild the index with room for at least twice the entry count
+ static NexusResult rebuild_index(NexusMetadataStore* store, size_t entries) {
+     size_t slots = store->index_slots ? store->index_slots : NEXUS_METADATA_MIN_SLOTS;
+     while (slots < entries * 2) {
+         slots *= 2;
+     }
+
+     if (slots != store->index_slots) {
+         uint32_t* index = (uint32_t*)malloc(slots * sizeof(uint32_t));
+         if (!index) {
+             return NEXUS_OUT_OF_MEMORY;
+         }
+         free(store->index);
+         store->index = index;
+         store->index_slots = slots;
+     }
+
+     memset(store->index, 0, store->index_slots * sizeof(uint32_t));
+     for (size_t i = 0; i < store->count; i++) {
+         size_t slot = find_slot(store, nexus_metadata_entry_at(store, i)->key);
+         store->index[slot] = (uint32_t)(i + 1);
+     }
+     return NEXUS_SUCCESS;
+ }
+
+ // Find the entry for an interned key
+ static NexusMetadataEntry* find_entry(const NexusMetadataStore* store, const char* interned_key) {
+     if (store->count <= NEXUS_METADATA_INLINE) {
+         for (size_t i = 0; i < store->count; i++) {
+             if (store->inline_entries[i].key == interned_key) {
+                 return (NexusMetadataEntry*)&store->inline_entries[i];
+             }
+         }
+         return NULL;
+     }
+
+     uint32_t position = store->index[find_slot(store, interned_key)];
+     return position ? nexus_metadata_entry_at(store, position - 1) : NULL;
+ }
+
+ // Initialize an empty store
+ void nexus_metadata_init(NexusMetadataStore* store) {
+     if (store) {
+         memset(store, 0, sizeof(*store));
+     }
+ }
+
+ // Look up a value by an interned key
+ void* nexus_metadata_get_interned(const NexusMetadataStore* store, const char* interned_key) {
+     if (!store || !interned_key) {
+         return NULL;
+     }
+
+     NexusMetadataEntry* entry = find_entry(store, interned_key);
+     return entry ? entry->value : NULL;
+ }
+
+ // Look up a value by key
+ void* nexus_metadata_get(const NexusMetadataStore* store, const char* key) {
+     if (!store || !key || store->count == 0) {
+         return NULL;
+     }
+
+     // A key that was never interned was never set
+     const char* interned_key = nexus_intern_lookup(key);
+     return interned_key ? nexus_metadata_get_interned(store, interned_key) : NULL;
+ }
+
+ // Set a value, replacing and freeing any previous one
+ NexusResult nexus_metadata_set(NexusMetadataStore* store,
+                               const char* key,
+                               void* value,
+                               NexusMetadataFreeFunc free_func) {
+     if (!store || !key) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+
+     const char* interned_key = nexus_intern(key);
+     if (!interned_key) {
+         return NEXUS_OUT_OF_MEMORY;
+     }
+
+     NexusMetadataEntry* entry = find_entry(store, interned_key);
+     if (entry) {
+         if (entry->value && entry->free_func && entry->value != value) {
+             entry->free_func(entry->value);
+         }
+         entry->value = value;
+         entry->free_func = free_func;
+         return NEXUS_SUCCESS;
+     }
+
+     size_t position = store->count;
+     if (position >= NEXUS_METADATA_INLINE) {
+         size_t spilled = position - NEXUS_METADATA_INLINE;
+         if (spilled == store->spill_capacity) {
+             size_t capacity = store->spill_capacity ? store->spill_capacity * 2 : NEXUS_METADATA_INLINE;
+             NexusMetadataEntry* spill = (NexusMetadataEntry*)realloc(store->spill,
+                                                                      capacity * sizeof(NexusMetadataEntry));
+             if (!spill) {
+                 return NEXUS_OUT_OF_MEMORY;
+             }
+             store->spill = spill;
+             store->spill_capacity = capacity;
+         }
+
+         // The index covers all entries; (re)build it when spilling or when full
+         if (position == NEXUS_METADATA_INLINE || (position + 1) * 2 > store->index_slots) {
+             NexusResult result = rebuild_index(store, position + 1);
+             if (result != NEXUS_SUCCESS) {
+                 return result;
+             }
+         }
+     }
+
+     entry = nexus_metadata_entry_at(store, position);
+     entry->key = interned_key;
+     entry->value = value;
+     entry->free_func = free_func;
+     store->count++;
+
+     if (store->count > NEXUS_METADATA_INLINE) {
+         store->index[find_slot(store, interned_key)] = (uint32_t)store->count;
+     }
+     return NEXUS_SUCCESS;
+ }
+
+ // Copy every entry of one store into an empty store
+ NexusResult nexus_metadata_copy(NexusMetadataStore* dst, const NexusMetadataStore* src) {
+     if (!dst || !src || dst->count != 0) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+
+     size_t inline_count = src->count < NEXUS_METADATA_INLINE ? src->count : NEXUS_METADATA_INLINE;
+     size_t spilled = src->count - inline_count;
+
+     if (spilled > 0) {
+         if (dst->spill_capacity < spilled) {
+             NexusMetadataEntry* spill = (NexusMetadataEntry*)realloc(dst->spill,
+                                                                      src->spill_capacity * sizeof(NexusMetadataEntry));
+             if (!spill) {
+                 return NEXUS_OUT_OF_MEMORY;
+             }
+             dst->spill = spill;
+             dst->spill_capacity = src->spill_capacity;
+         }
+
+         // Same entry positions, so the source index can be copied verbatim
+         if (dst->index_slots != src->index_slots) {
+             uint32_t* index = (uint32_t*)realloc(dst->index, src->index_slots * sizeof(uint32_t));
+             if (!index) {
+                 return NEXUS_OUT_OF_MEMORY;
+             }
+             dst->index = index;
+             dst->index_slots = src->index_slots;
+         }
+         memcpy(dst->index, src->index, src->index_slots * sizeof(uint32_t));
+         memcpy(dst->spill, src->spill, spilled * sizeof(NexusMetadataEntry));
+     }
+     memcpy(dst->inline_entries, src->inline_entries, inline_count * sizeof(NexusMetadataEntry));
+     dst->count = src->count;
+
+     // The source keeps ownership of the values
+     for (size_t i = 0; i < dst->count; i++) {
+         nexus_metadata_entry_at(dst, i)->free_func = NULL;
+     }
+     return NEXUS_SUCCESS;
+ }
+
+ // Remove every entry, freeing owned values
+ void nexus_metadata_clear(NexusMetadataStore* store) {
+     if (!store) {
+         return;
+     }
+
+     for (size_t i = 0; i < store->count; i++) {
+         NexusMetadataEntry* entry = nexus_metadata_entry_at(store, i);
+         if (entry->value && entry->free_func) {
+             entry->free_func(entry->value);
+         }
+     }
+
+     // A small store never touched its index; a spilled one is at most half full
+     if (store->count > NEXUS_METADATA_INLINE) {
+         memset(store->index, 0, store->index_slots * sizeof(uint32_t));
+     }
+     store->count = 0;
+ }
+
+ // Remove every entry and release all storage
+ void nexus_metadata_destroy(NexusMetadataStore* store) {
+     if (!store) {
+         return;
+     }
+
+     nexus_metadata_clear(store);
+     free(store->spill);
+     free(store->index);
+     store->spill = NULL;
+     store->spill_capacity = 0;
+     store->index = NULL;
+     store->index_slots = 0;
+ }
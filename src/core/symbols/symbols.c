@@ -10,12 +10,112 @@
  */
 
  #include "nlink/core/symbols/nexus_symbols.h"
+ #include "nlink/core/symbols/concurrent_symbols.h"
+ #include "nlink/core/symbols/lazy_symbols.h"
  #include <stdio.h>
  #include <stdlib.h>
  #include <string.h>
+ #include <stdint.h>
  
  // Constants for symbol tables
  #define NEXUS_DEFAULT_TABLE_SIZE 64
+ #define NEXUS_MIN_INDEX_SIZE 16
+ 
+ // Index slot packing: upper 32 bits of the name hash, lower 32 bits position + 1
+ #define NEXUS_SLOT_TAG(hash) ((hash) & 0xFFFFFFFF00000000ULL)
+ #define NEXUS_SLOT_POS(slot) ((size_t)((slot) & 0xFFFFFFFFULL) - 1)
+ #define NEXUS_SLOT_MAKE(hash, pos) (NEXUS_SLOT_TAG(hash) | (uint64_t)((pos) + 1))
+ 
+ // Index size for a given symbol capacity (load factor <= 1/2)
+ static size_t symbol_index_size_for(size_t capacity) {
+     size_t slots = NEXUS_MIN_INDEX_SIZE;
+     while (slots < capacity * 2) {
+         slots <<= 1;
+     }
+     return slots;
+ }
+ 
+ static void symbol_index_insert(uint64_t* index, size_t index_capacity,
+                                 uint64_t hash, size_t pos) {
+     size_t mask = index_capacity - 1;
+     size_t i = (size_t)hash & mask;
+     while (index[i]) {
+         i = (i + 1) & mask;
+     }
+     index[i] = NEXUS_SLOT_MAKE(hash, pos);
+ }
+ 
+ // Rebuild the hash index so it matches the current symbol capacity
+ static bool symbol_index_rebuild(NexusSymbolTable* table) {
+     size_t index_capacity = symbol_index_size_for(table->capacity);
+     uint64_t* index = (uint64_t*)calloc(index_capacity, sizeof(uint64_t));
+     if (!index) {
+         return false;
+     }
+     
+     for (size_t i = 0; i < table->size; i++) {
+         symbol_index_insert(index, index_capacity, table->symbols[i].hash, i);
+     }
+     
+     free(table->index);
+     table->index = index;
+     table->index_capacity = index_capacity;
+     return true;
+ }
+ 
+ // Find the index slot for a name, or SIZE_MAX if absent
+ static size_t symbol_index_find_slot(const NexusSymbolTable* table,
+                                      const char* name,
+                                      uint64_t hash) {
+     if (!table->index) {
+         return SIZE_MAX;
+     }
+     
+     size_t mask = table->index_capacity - 1;
+     uint64_t tag = NEXUS_SLOT_TAG(hash);
+     for (size_t i = (size_t)hash & mask; table->index[i]; i = (i + 1) & mask) {
+         uint64_t slot = table->index[i];
+         if (NEXUS_SLOT_TAG(slot) != tag) {
+             continue;
+         }
+         
+         const NexusSymbol* symbol = &table->symbols[NEXUS_SLOT_POS(slot)];
+         if (symbol->hash == hash &&
+             (symbol->name == name || strcmp(symbol->name, name) == 0)) {
+             return i;
+         }
+     }
+     
+     return SIZE_MAX;
+ }
+ 
+ // Find the index slot that points at a given symbol position
+ static size_t symbol_index_slot_of(const NexusSymbolTable* table, size_t pos) {
+     size_t mask = table->index_capacity - 1;
+     size_t i = (size_t)table->symbols[pos].hash & mask;
+     while (NEXUS_SLOT_POS(table->index[i]) != pos) {
+         i = (i + 1) & mask;
+     }
+     return i;
+ }
+ 
+ // Remove a slot with backward-shift deletion (no tombstones)
+ static void symbol_index_erase(NexusSymbolTable* table, size_t slot) {
+     size_t mask = table->index_capacity - 1;
+     uint64_t* index = table->index;
+     size_t hole = slot;
+     
+     for (size_t i = (slot + 1) & mask; index[i]; i = (i + 1) & mask) {
+         size_t home = (size_t)table->symbols[NEXUS_SLOT_POS(index[i])].hash & mask;
+         // Shift the entry back if the hole lies between its home and its slot
+         if (((i - home) & mask) >= ((i - hole) & mask)) {
+             index[hole] = index[i];
+             hole = i;
+         }
+     }
+     
+     index[hole] = 0;
+ }
  
  // Initialize a symbol table
  void nexus_symbol_table_init(NexusSymbolTable* table, size_t initial_capacity) {
@@ -23,16 +123,24 @@
          return;
      }
      
+     table->size = 0;
+     table->index = NULL;
+     table->index_capacity = 0;
+     
      table->symbols = (NexusSymbol*)malloc(initial_capacity * sizeof(NexusSymbol));
      if (!table->symbols) {
          // In case of allocation failure, set capacity to 0
          table->capacity = 0;
-         table->size = 0;
          return;
      }
      
      table->capacity = initial_capacity;
-     table->size = 0;
+     
+     if (!symbol_index_rebuild(table)) {
+         free(table->symbols);
+         table->symbols = NULL;
+         table->capacity = 0;
+     }
  }
  
  // Initialize a symbol registry
@@ -53,16 +161,12 @@
      return registry;
  }
  
- // Add a symbol to a symbol table
- NexusResult nexus_symbol_table_add(NexusSymbolTable* table, 
-                                   const char* name, 
-                                   void* address, 
-                                   NexusSymbolType type, 
-                                   const char* component_id) {
-     if (!table || !name || !component_id) {
-         return NEXUS_INVALID_PARAMETER;
-     }
-     
+ // Add a symbol; caller holds the table's writer lock in concurrent mode
+ static NexusResult symbol_table_add_unlocked(NexusSymbolTable* table, 
+                                              const char* name, 
+                                              void* address, 
+                                              NexusSymbolType type, 
+                                              const char* component_id) {
      // Check if we need to resize
      if (table->size >= table->capacity) {
          // Double the capacity
@@ -81,73 +185,122 @@
          table->capacity = new_capacity;
      }
      
-     // Add the new symbol
-     NexusSymbol* symbol = &table->symbols[table->size++];
-     symbol->name = strdup(name);
-     if (!symbol->name) {
-         table->size--; // Revert the size increase
+     // Keep the index sized for the symbol array
+     if (table->index_capacity < symbol_index_size_for(table->capacity) &&
+         !symbol_index_rebuild(table)) {
          return NEXUS_OUT_OF_MEMORY;
      }
      
-     symbol->address = address;
-     symbol->type = type;
+     // Names and component IDs are interned, so they are never freed here
+     const char* interned_name = nexus_intern(name);
+     const char* interned_component = nexus_intern(component_id);
+     if (!interned_name || !interned_component) {
+         return NEXUS_OUT_OF_MEMORY;
+     }
      
-     symbol->component_id = strdup(component_id);
-     if (!symbol->component_id) {
-         free(symbol->name);
-         table->size--; // Revert the size increase
+     // Add the new symbol
+     size_t pos = table->size;
+     NexusSymbol* symbol = &table->symbols[pos];
+     if (nexus_symbol_table_attach_counters(table, symbol) != NEXUS_SUCCESS) {
          return NEXUS_OUT_OF_MEMORY;
      }
      
+     table->size++;
+     symbol->name = interned_name;
+     symbol->hash = nexus_intern_hash_of(interned_name);
+     symbol->address = address;
+     symbol->type = type;
+     symbol->component_id = interned_component;
      symbol->ref_count = 0;
      
+     symbol_index_insert(table->index, table->index_capacity, symbol->hash, pos);
+     
      return NEXUS_SUCCESS;
  }
  
- // Find a symbol in a symbol table
- NexusSymbol* nexus_symbol_table_find(NexusSymbolTable* table, const char* name) {
+ // Add a symbol to a symbol table
+ NexusResult nexus_symbol_table_add(NexusSymbolTable* table, 
+                                   const char* name, 
+                                   void* address, 
+                                   NexusSymbolType type, 
+                                   const char* component_id) {
+     if (!table || !name || !component_id) {
+         return NEXUS_INVALID_PARAMETER;
+     }
+     
+     nexus_symbol_table_begin_update(table);
+     NexusResult result = symbol_table_add_unlocked(table, name, address, type, component_id);
+     nexus_symbol_table_end_update(table);
+     
+     return result;
+ }
+ 
+ // Find a symbol in a symbol table using a precomputed hash
+ NexusSymbol* nexus_symbol_table_find_hashed(NexusSymbolTable* table, const char* name, uint64_t hash) {
      if (!table || !name) {
          return NULL;
      }
      
-     for (size_t i = 0; i < table->size; i++) {
-         if (strcmp(table->symbols[i].name, name) == 0) {
-             return &table->symbols[i];
-         }
+     size_t slot = symbol_index_find_slot(table, name, hash);
+     if (slot == SIZE_MAX) {
+         return NULL;
      }
      
-     return NULL;
+     return &table->symbols[NEXUS_SLOT_POS(table->index[slot])];
  }
  
- // Resolve a symbol using the three-tier registry
- void* nexus_resolve_symbol(NexusSymbolRegistry* registry, const char* name) {
-     if (!registry || !name) {
+ // Find a symbol in a symbol table
+ NexusSymbol* nexus_symbol_table_find(NexusSymbolTable* table, const char* name) {
+     if (!table || !name) {
          return NULL;
      }
      
-     // First check the exported table (highest priority)
-     NexusSymbol* symbol = nexus_symbol_table_find(&registry->exported, name);
-     if (symbol) {
-         symbol->ref_count++; // Track usage
-         return symbol->address;
+     return nexus_symbol_table_find_hashed(table, name, nexus_intern_hash(name));
+ }
+ 
+ // Resolve through the three tiers in priority order, optionally checking the type
+ static void* symbol_registry_resolve(NexusSymbolRegistry* registry,
+                                      const char* name,
+                                      bool check_type,
+                                      NexusSymbolType expected_type) {
+     // Exported has the highest priority, then imported, then global
+     NexusSymbolTable* tiers[3] = { &registry->exported, &registry->imported, &registry->global };
+     bool concurrent = registry->exported.sync || registry->imported.sync || registry->global.sync;
+     
+     // Hash once for all three tiers
+     uint64_t hash = nexus_intern_hash(name);
+     void* address = NULL;
+     
+     if (concurrent) {
+         nexus_symbol_read_lock();
+     }
+     
+     for (int i = 0; i < 3; i++) {
+         NexusSymbol* symbol = concurrent
+             ? nexus_symbol_table_find_published(tiers[i], name, hash)
+             : nexus_symbol_table_find_hashed(tiers[i], name, hash);
+         
+         if (symbol && (!check_type || symbol->type == expected_type)) {
+             nexus_symbol_ref_acquire(symbol); // Track usage
+             address = symbol->address;
+             break;
+         }
      }
      
-     // Then check the imported table
-     symbol = nexus_symbol_table_find(&registry->imported, name);
-     if (symbol) {
-         symbol->ref_count++; // Track usage
-         return symbol->address;
+     if (concurrent) {
+         nexus_symbol_read_unlock();
      }
      
-     // Finally check the global table
-     symbol = nexus_symbol_table_find(&registry->global, name);
-     if (symbol) {
-         symbol->ref_count++; // Track usage
-         return symbol->address;
+     return address;
+ }
+ 
+ // Resolve a symbol using the three-tier registry
+ void* nexus_resolve_symbol(NexusSymbolRegistry* registry, const char* name) {
+     if (!registry || !name) {
+         return NULL;
      }
      
-     // Symbol not found
-     return NULL;
+     return symbol_registry_resolve(registry, name, false, NEXUS_SYMBOL_UNKNOWN);
  }
  
  // Remove a symbol from a table
@@ -156,25 +309,34 @@
          return NEXUS_INVALID_PARAMETER;
      }
      
-     for (size_t i = 0; i < table->size; i++) {
-         if (strcmp(table->symbols[i].name, name) == 0) {
-             // Free allocated memory
-             free(table->symbols[i].name);
-             free(table->symbols[i].component_id);
-             
-             // Move the last element to this position (if not already the last)
-             if (i < table->size - 1) {
-                 table->symbols[i] = table->symbols[table->size - 1];
-             }
-             
-             // Reduce size
-             table->size--;
-             
-             return NEXUS_SUCCESS;
-         }
+     nexus_symbol_table_begin_update(table);
+     
+     size_t slot = symbol_index_find_slot(table, name, nexus_intern_hash(name));
+     if (slot == SIZE_MAX) {
+         nexus_symbol_table_end_update(table);
+         return NEXUS_NOT_FOUND;
+     }
+     
+     size_t pos = NEXUS_SLOT_POS(table->index[slot]);
+     size_t last = table->size - 1;
+     
+     symbol_index_erase(table, slot);
+     
+     // Move the last element to this position (if not already the last)
+     if (pos < last) {
+         table->index[symbol_index_slot_of(table, last)] =
+             NEXUS_SLOT_MAKE(table->symbols[last].hash, pos);
+         table->symbols[pos] = table->symbols[last];
      }
      
-     return NEXUS_NOT_FOUND;
+     // Reduce size
+     table->size--;
+     
+     // Readers keep seeing the removed symbol until the next snapshot is published
+     nexus_symbol_table_mark_changed(table);
+     nexus_symbol_table_end_update(table);
+     
+     return NEXUS_SUCCESS;
  }
  
  // Count used symbols in a table
@@ -185,7 +347,7 @@
      
      size_t count = 0;
      for (size_t i = 0; i < table->size; i++) {
-         if (table->symbols[i].ref_count > 0) {
+         if (nexus_symbol_get_ref_count(&table->symbols[i]) > 0) {
              count++;
          }
      }
@@ -225,19 +387,24 @@
          return;
      }
      
-     // Free all symbol strings
-     for (size_t i = 0; i < table->size; i++) {
-         free(table->symbols[i].name);
-         free(table->symbols[i].component_id);
-     }
+     // Unbound lazy stubs must not patch a freed table
+     nexus_lazy_detach_table(table);
+     
+     // Drop snapshots and striped counters first
+     nexus_symbol_table_disable_concurrent(table);
+     
+     // Symbol strings are interned and owned by the intern pool
      
-     // Free the symbols array
+     // Free the symbols array and its index
      free(table->symbols);
+     free(table->index);
      
      // Reset table state
      table->symbols = NULL;
      table->size = 0;
      table->capacity = 0;
+     table->index = NULL;
+     table->index_capacity = 0;
  }
  
  // Cleanup a symbol registry
@@ -264,29 +431,8 @@
          return NULL;
      }
      
-     // First check exported table
-     NexusSymbol* symbol = nexus_symbol_table_find(&registry->exported, name);
-     if (symbol && symbol->type == expected_type) {
-         symbol->ref_count++;
-         return symbol->address;
-     }
-     
-     // Then check imported table
-     symbol = nexus_symbol_table_find(&registry->imported, name);
-     if (symbol && symbol->type == expected_type) {
-         symbol->ref_count++;
-         return symbol->address;
-     }
-     
-     // Finally check global table
-     symbol = nexus_symbol_table_find(&registry->global, name);
-     if (symbol && symbol->type == expected_type) {
-         symbol->ref_count++;
-         return symbol->address;
-     }
-     
-     // Symbol not found or type mismatch
-     return NULL;
+     // A tier whose symbol has the wrong type falls through to the next tier
+     return symbol_registry_resolve(registry, name, true, expected_type);
  }
  
  // Context-aware symbol resolution
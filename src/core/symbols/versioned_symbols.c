@@ -3,12 +3,173 @@
 // Author: Nnamdi Michael Okpala
 
 #include "nlink/core/symbols/nexus_versioned_symbols.h"
+#include "nlink/core/symbols/intern.h"
+#include "nlink/core/semverx/lazy_versioned.h"
+
+// Resolution cache sizing
+#define NEXUS_VERSIONED_CACHE_SIZE 1024
+#define NEXUS_VERSIONED_CACHE_PROBES 8
+
+// Initial slot count of a table's per-component entry lists
+#define NEXUS_VERSIONED_COMPONENT_SLOTS 16
 
 // Initialize a versioned symbol table
 void versioned_symbol_table_init(VersionedSymbolTable* table, size_t initial_capacity) {
     table->symbols = (VersionedSymbol*)malloc(initial_capacity * sizeof(VersionedSymbol));
     table->capacity = initial_capacity;
     table->size = 0;
+    table->generation = 0;
+    table->lock = NULL;
+    table->components = NULL;
+    table->component_capacity = 0;
+    table->component_count = 0;
+    table->dropped = 0;
+}
+
+// Entry list slot of an interned component ID: the slot holding it, or
+// the empty slot it would go in
+static VersionedComponentEntries* table_component_slot(VersionedComponentEntries* slots,
+                                                       size_t capacity,
+                                                       const char* component_id) {
+    size_t mask = capacity - 1;
+    size_t i = (size_t)nexus_intern_hash_of(component_id) & mask;
+    while (slots[i].component_id && slots[i].component_id != component_id) {
+        i = (i + 1) & mask;
+    }
+    return &slots[i];
+}
+
+// Entry list of an interned component ID, or NULL if it has none
+static VersionedComponentEntries* table_component_find(VersionedSymbolTable* table,
+                                                       const char* component_id) {
+    if (!table->components) {
+        return NULL;
+    }
+    VersionedComponentEntries* slot = table_component_slot(table->components,
+                                                           table->component_capacity,
+                                                           component_id);
+    return slot->component_id ? slot : NULL;
+}
+
+// Record that entry index belongs to a component; caller holds the table's lock.
+// An entry that cannot be recorded is still resolvable but is not dropped
+// with its component.
+static void table_component_add(VersionedSymbolTable* table,
+                                const char* component_id,
+                                size_t index) {
+    const char* interned = nexus_intern(component_id);
+    if (!interned) {
+        return;
+    }
+    
+    // Keep the slot array at most 3/4 full
+    if ((table->component_count + 1) * 4 > table->component_capacity * 3) {
+        size_t new_capacity = table->component_capacity ?
+            table->component_capacity * 2 : NEXUS_VERSIONED_COMPONENT_SLOTS;
+        VersionedComponentEntries* grown = (VersionedComponentEntries*)calloc(
+            new_capacity, sizeof(VersionedComponentEntries));
+        if (!grown) {
+            return;
+        }
+        for (size_t i = 0; i < table->component_capacity; i++) {
+            if (table->components[i].component_id) {
+                *table_component_slot(grown, new_capacity,
+                                      table->components[i].component_id) = table->components[i];
+            }
+        }
+        free(table->components);
+        table->components = grown;
+        table->component_capacity = new_capacity;
+    }
+    
+    VersionedComponentEntries* list = table_component_slot(table->components,
+                                                           table->component_capacity,
+                                                           interned);
+    if (!list->component_id) {
+        list->component_id = interned;
+        table->component_count++;
+    }
+    
+    if (list->count == list->capacity) {
+        size_t new_capacity = list->capacity ? list->capacity * 2 : 4;
+        size_t* grown = (size_t*)realloc(list->entries, new_capacity * sizeof(size_t));
+        if (!grown) {
+            return;
+        }
+        list->entries = grown;
+        list->capacity = new_capacity;
+    }
+    list->entries[list->count++] = index;
+}
+
+// Remove dropped entries and renumber the component lists to match;
+// caller holds the table's lock
+static void table_compact(VersionedSymbolTable* table) {
+    size_t* moved_to = (size_t*)malloc(table->size * sizeof(size_t));
+    if (!moved_to) {
+        return;  // Dropped entries stay until the next compaction
+    }
+    
+    size_t write_index = 0;
+    for (size_t i = 0; i < table->size; i++) {
+        if (!table->symbols[i].name) {
+            moved_to[i] = SIZE_MAX;
+            continue;
+        }
+        if (i != write_index) {
+            table->symbols[write_index] = table->symbols[i];
+        }
+        moved_to[i] = write_index++;
+    }
+    
+    for (size_t i = 0; i < table->component_capacity; i++) {
+        VersionedComponentEntries* list = &table->components[i];
+        size_t kept = 0;
+        for (size_t j = 0; j < list->count; j++) {
+            if (moved_to[list->entries[j]] != SIZE_MAX) {
+                list->entries[kept++] = moved_to[list->entries[j]];
+            }
+        }
+        list->count = kept;
+    }
+    
+    table->size = write_index;
+    table->dropped = 0;
+    free(moved_to);
+}
+
+// Drop a component's entries from one table; caller holds the table's lock
+static void table_drop_component(VersionedSymbolTable* table, const char* component_id) {
+    VersionedComponentEntries* list = table_component_find(table, component_id);
+    if (!list || list->count == 0) {
+        return;
+    }
+    
+    // Entries shared with another component's list may already be gone
+    for (size_t i = 0; i < list->count; i++) {
+        VersionedSymbol* symbol = &table->symbols[list->entries[i]];
+        if (!symbol->name) {
+            continue;
+        }
+        free(symbol->name);
+        free(symbol->version);
+        free(symbol->component_id);
+        symbol->name = NULL;
+        symbol->version = NULL;
+        symbol->component_id = NULL;
+        symbol->usage = NULL;
+        table->dropped++;
+    }
+    list->count = 0;
+    
+    // Compact once dropped entries make up half the table, so each drop
+    // costs O(1) amortized
+    if (table->dropped * 2 > table->size) {
+        table_compact(table);
+    }
+    
+    // Invalidates cached resolutions (and any VersionedSymbol* into this table)
+    table->generation++;
 }
 
 // Create a new versioned symbol registry
@@ -19,23 +180,33 @@ VersionedSymbolRegistry* nexus_versioned_registry_create() {
     versioned_symbol_table_init(&registry->global, 64);
     versioned_symbol_table_init(&registry->imported, 128);
     versioned_symbol_table_init(&registry->exported, 128);
+    registry->global.lock = &registry->lock;
+    registry->imported.lock = &registry->lock;
+    registry->exported.lock = &registry->lock;
     
     // Initialize dependency tracking
     registry->dependencies = NULL;
     registry->deps_count = 0;
     registry->deps_capacity = 0;
+    registry->deps_generation = 0;
+    
+    // The resolution cache allocates its slots on first use
+    memset(&registry->cache, 0, sizeof(registry->cache));
+    pthread_mutex_init(&registry->lock, NULL);
     
     return registry;
 }
 
-// Add a symbol to a versioned table
-void versioned_symbol_table_add(VersionedSymbolTable* table, 
-                               const char* name, 
-                               const char* version,
-                               void* address, 
-                               VersionedSymbolType type, 
-                               const char* component_id,
-                               int priority) {
+// Add a symbol to a versioned table; caller holds the table's lock.
+// provider_id, if set, names a second component the entry is dropped with.
+static void table_add_locked(VersionedSymbolTable* table,
+                             const char* name,
+                             const char* version,
+                             void* address,
+                             VersionedSymbolType type,
+                             const char* component_id,
+                             const char* provider_id,
+                             int priority) {
     // Resize if needed
     if (table->size >= table->capacity) {
         table->capacity *= 2;
@@ -47,11 +218,64 @@ void versioned_symbol_table_add(VersionedSymbolTable* table,
     VersionedSymbol* symbol = &table->symbols[table->size++];
     symbol->name = strdup(name);
     symbol->version = version ? strdup(version) : strdup("1.0.0"); // Default version
+    
+    // Versions that do not parse or do not pack exactly are matched with
+    // semver_satisfies() instead of by packed key
+    symbol->packed_version = 0;
+    symbol->packed_exact = semver_pack(symbol->version, &symbol->packed_version);
     symbol->address = address;
     symbol->type = type;
     symbol->component_id = strdup(component_id);
     symbol->priority = priority;
     symbol->ref_count = 0;
+    
+    // Components loaded through the lazy loader have a usage record
+    symbol->usage = nexus_component_usage_find(component_id);
+    
+    table_component_add(table, component_id, table->size - 1);
+    if (provider_id && strcmp(provider_id, component_id) != 0) {
+        table_component_add(table, provider_id, table->size - 1);
+    }
+    
+    // Invalidates cached resolutions (and any VersionedSymbol* into this table)
+    table->generation++;
+}
+
+// Add a symbol to a versioned table
+void versioned_symbol_table_add(VersionedSymbolTable* table, 
+                               const char* name, 
+                               const char* version,
+                               void* address, 
+                               VersionedSymbolType type, 
+                               const char* component_id,
+                               int priority) {
+    if (table->lock) {
+        pthread_mutex_lock(table->lock);
+    }
+    table_add_locked(table, name, version, address, type, component_id, NULL, priority);
+    if (table->lock) {
+        pthread_mutex_unlock(table->lock);
+    }
+}
+
+// Drop a component's entries from every table of the registry
+void nexus_versioned_registry_drop_component(VersionedSymbolRegistry* registry,
+                                            const char* component_id) {
+    if (!registry || !component_id) {
+        return;
+    }
+    
+    // A component ID that was never interned has no entries
+    const char* interned = nexus_intern_lookup(component_id);
+    if (!interned) {
+        return;
+    }
+    
+    pthread_mutex_lock(&registry->lock);
+    table_drop_component(&registry->exported, interned);
+    table_drop_component(&registry->global, interned);
+    table_drop_component(&registry->imported, interned);
+    pthread_mutex_unlock(&registry->lock);
 }
 
 // Find all symbols with a given name in a table
@@ -61,7 +285,7 @@ size_t versioned_symbol_table_find_all(VersionedSymbolTable* table,
     // Count matching symbols
     size_t count = 0;
     for (size_t i = 0; i < table->size; i++) {
-        if (strcmp(table->symbols[i].name, name) == 0) {
+        if (table->symbols[i].name && strcmp(table->symbols[i].name, name) == 0) {
             count++;
         }
     }
@@ -77,7 +301,7 @@ size_t versioned_symbol_table_find_all(VersionedSymbolTable* table,
     // Fill the array
     size_t index = 0;
     for (size_t i = 0; i < table->size; i++) {
-        if (strcmp(table->symbols[i].name, name) == 0) {
+        if (table->symbols[i].name && strcmp(table->symbols[i].name, name) == 0) {
             (*results)[index++] = &table->symbols[i];
         }
     }
@@ -91,6 +315,8 @@ void nexus_add_component_dependency(VersionedSymbolRegistry* registry,
                                    const char* depends_on_id,
                                    const char* version_constraint,
                                    bool optional) {
+    pthread_mutex_lock(&registry->lock);
+    
     // Initialize or resize dependencies array if needed
     if (registry->dependencies == NULL) {
         registry->deps_capacity = 16;
@@ -108,7 +334,18 @@ void nexus_add_component_dependency(VersionedSymbolRegistry* registry,
     dep->from_id = strdup(component_id);
     dep->to_id = strdup(depends_on_id);
     dep->version_req = version_constraint ? strdup(version_constraint) : strdup("*");
+    
+    // An invalid requirement compiles to an empty constraint that nothing satisfies
+    if (!semver_constraint_compile(dep->version_req, &dep->constraint)) {
+        dep->constraint.count = 0;
+        dep->constraint.exact = true;
+    }
     dep->optional = optional;
+    
+    // Dependency changes alter priorities and constraints of cached resolutions
+    registry->deps_generation++;
+    
+    pthread_mutex_unlock(&registry->lock);
 }
 
 // Get a component's dependencies
@@ -171,26 +408,138 @@ const char* find_version_constraint(VersionedSymbolRegistry* registry,
     return NULL;
 }
 
-// The core context-aware symbol resolution function
-void* nexus_resolve_versioned_symbol(VersionedSymbolRegistry* registry,
-                                    const char* name,
-                                    const char* version_constraint,
-                                    const char* requesting_component) {
+// Dependency record behind find_version_constraint(), for its compiled form
+static const ComponentDependency* find_dependency(VersionedSymbolRegistry* registry,
+                                                  const char* component_id,
+                                                  const char* dependency_id) {
+    for (size_t i = 0; i < registry->deps_count; i++) {
+        ComponentDependency* dep = &registry->dependencies[i];
+        if (strcmp(dep->from_id, component_id) == 0 && 
+            strcmp(dep->to_id, dependency_id) == 0) {
+            return dep;
+        }
+    }
+    return NULL;
+}
+
+// Match by packed key when both sides pack exactly, otherwise by the
+// full-precision comparison
+static bool symbol_satisfies(const VersionedSymbol* symbol,
+                             const SemVerConstraint* compiled,
+                             const char* constraint) {
+    if (compiled->exact && symbol->packed_exact) {
+        return semver_constraint_matches(compiled, symbol->packed_version);
+    }
+    return semver_satisfies(symbol->version, constraint);
+}
+
+// Current registry generation. Each component counter only grows, so the
+// sum changes whenever any of them does. Starts at 1 so 0 never matches.
+uint64_t nexus_versioned_registry_generation(const VersionedSymbolRegistry* registry) {
+    return 1 + registry->exported.generation +
+               registry->global.generation +
+               registry->deps_generation;
+}
+
+static bool cache_key_equal(const char* cached, const char* key) {
+    if (cached == key) {
+        return true;
+    }
+    return cached && key && strcmp(cached, key) == 0;
+}
+
+static uint64_t cache_key_hash(const char* name,
+                               const char* constraint,
+                               const char* component) {
+    const uint64_t mix = 0x9E3779B97F4A7C15ULL;
+    uint64_t hash = nexus_intern_hash(name);
+    hash = (hash ^ (constraint ? nexus_intern_hash(constraint) : 0)) * mix;
+    hash = (hash ^ (component ? nexus_intern_hash(component) : 0)) * mix;
+    return hash;
+}
+
+// Find the cache slot for a key. Sets *found if it holds a current entry;
+// otherwise returns the slot to (re)fill, or NULL if the cache is unavailable.
+static VersionedResolutionEntry* cache_lookup(VersionedResolutionCache* cache,
+                                              uint64_t key_hash,
+                                              uint64_t generation,
+                                              const char* name,
+                                              const char* constraint,
+                                              const char* component,
+                                              bool* found) {
+    *found = false;
+    
+    if (!cache->entries) {
+        cache->entries = (VersionedResolutionEntry*)calloc(NEXUS_VERSIONED_CACHE_SIZE,
+                                                           sizeof(VersionedResolutionEntry));
+        if (!cache->entries) {
+            return NULL;
+        }
+        cache->capacity = NEXUS_VERSIONED_CACHE_SIZE;
+    }
+    
+    size_t mask = cache->capacity - 1;
+    size_t home = (size_t)key_hash & mask;
+    VersionedResolutionEntry* reusable = NULL;
+    
+    // Bounded probe window; entries from older generations count as free
+    for (size_t i = 0; i < NEXUS_VERSIONED_CACHE_PROBES; i++) {
+        VersionedResolutionEntry* entry = &cache->entries[(home + i) & mask];
+        
+        if (!entry->name || entry->generation != generation) {
+            if (!reusable) {
+                reusable = entry;
+            }
+            continue;
+        }
+        
+        if (entry->key_hash == key_hash &&
+            cache_key_equal(entry->name, name) &&
+            cache_key_equal(entry->constraint, constraint) &&
+            cache_key_equal(entry->component, component)) {
+            *found = true;
+            return entry;
+        }
+    }
+    
+    // Window full of live entries: evict the home slot
+    return reusable ? reusable : &cache->entries[home];
+}
+
+// Pin the symbol's component for the caller, who releases symbol->usage
+// once done with the address. Symbols of components that are not lazily
+// loaded need no pin. Fails once the component is being unloaded.
+static bool symbol_pin(VersionedSymbol* symbol) {
+    return !symbol->usage || nexus_component_usage_acquire(symbol->usage);
+}
+
+// Full search: best exported match by effective priority, then global fallback
+// (constraint is NULL when any version is acceptable; compiled is its
+// compiled form)
+static VersionedSymbol* resolve_versioned_uncached(VersionedSymbolRegistry* registry,
+                                                   const char* name,
+                                                   const char* constraint,
+                                                   const SemVerConstraint* compiled,
+                                                   const char* requesting_component,
+                                                   bool* from_exported,
+                                                   int* priority) {
     VersionedSymbol* best_match = NULL;
     int best_priority = -1;
     
     // First check the exported table (usually highest priority)
-    VersionedSymbol** exported_symbols;
-    size_t exported_count = versioned_symbol_table_find_all(&registry->exported, 
-                                                          name, 
-                                                          &exported_symbols);
-    
-    // Filter and find best match from exported symbols
-    for (size_t i = 0; i < exported_count; i++) {
-        VersionedSymbol* symbol = exported_symbols[i];
+    for (size_t i = 0; i < registry->exported.size; i++) {
+        VersionedSymbol* symbol = &registry->exported.symbols[i];
+        if (!symbol->name || strcmp(symbol->name, name) != 0) {
+            continue;
+        }
+        
+        // Components being unloaded no longer provide symbols
+        if (symbol->usage && !nexus_component_usage_active(symbol->usage)) {
+            continue;
+        }
         
         // Check version constraint if specified
-        if (version_constraint && !semver_satisfies(symbol->version, version_constraint)) {
+        if (constraint && !symbol_satisfies(symbol, compiled, constraint)) {
             continue;
         }
         
@@ -204,10 +553,9 @@ void* nexus_resolve_versioned_symbol(VersionedSymbolRegistry* registry,
         }
         
         // If we have a direct dependency with a version constraint, check that
-        const char* specific_constraint = find_version_constraint(registry, 
-                                                                requesting_component, 
-                                                                symbol->component_id);
-        if (specific_constraint && !semver_satisfies(symbol->version, specific_constraint)) {
+        const ComponentDependency* dep = find_dependency(registry, requesting_component,
+                                                         symbol->component_id);
+        if (dep && !symbol_satisfies(symbol, &dep->constraint, dep->version_req)) {
             continue; // Skip this symbol if it doesn't satisfy the specific constraint
         }
         
@@ -217,82 +565,179 @@ void* nexus_resolve_versioned_symbol(VersionedSymbolRegistry* registry,
         }
     }
     
-    // Free the results array
-    if (exported_count > 0) {
-        free(exported_symbols);
+    if (best_match) {
+        *from_exported = true;
+        *priority = best_priority;
+        return best_match;
     }
     
-    // If we found a match in exported, use it
-    if (best_match) {
+    // Check the global table as fallback
+    for (size_t i = 0; i < registry->global.size; i++) {
+        VersionedSymbol* symbol = &registry->global.symbols[i];
+        if (!symbol->name || strcmp(symbol->name, name) != 0) {
+            continue;
+        }
+        
+        // Components being unloaded no longer provide symbols
+        if (symbol->usage && !nexus_component_usage_active(symbol->usage)) {
+            continue;
+        }
+        
+        // Check version constraint if specified
+        if (constraint && !symbol_satisfies(symbol, compiled, constraint)) {
+            continue;
+        }
+        
+        if (symbol->priority > best_priority) {
+            best_match = symbol;
+            best_priority = symbol->priority;
+        }
+    }
+    
+    *from_exported = false;
+    *priority = best_priority;
+    return best_match;
+}
+
+// Resolve through the cache, falling back to the full search on a miss.
+// Caller holds registry->lock and releases the pin on the returned
+// symbol's usage record.
+static VersionedSymbol* resolve_versioned(VersionedSymbolRegistry* registry,
+                                          const char* name,
+                                          const char* version_constraint,
+                                          const char* requesting_component) {
+    VersionedResolutionCache* cache = &registry->cache;
+    uint64_t generation = nexus_versioned_registry_generation(registry);
+    uint64_t key_hash = cache_key_hash(name, version_constraint, requesting_component);
+    
+    bool found;
+    VersionedResolutionEntry* entry = cache_lookup(cache, key_hash, generation, name,
+                                                   version_constraint, requesting_component,
+                                                   &found);
+    // A cached symbol whose component is being unloaded is searched for again
+    if (found && (!entry->symbol || symbol_pin(entry->symbol))) {
+        cache->hits++;
+        if (entry->symbol) {
+            entry->symbol->ref_count++; // Track usage
+        }
+        return entry->symbol;
+    }
+    
+    cache->misses++;
+    
+    bool from_exported = false;
+    int priority = -1;
+    VersionedSymbol* best_match = NULL;
+    
+    // Compile the caller's constraint once for the whole search; one that
+    // does not compile cannot be satisfied
+    SemVerConstraint compiled;
+    if (!version_constraint || semver_constraint_compile(version_constraint, &compiled)) {
+        best_match = resolve_versioned_uncached(registry, name, version_constraint, &compiled,
+                                                requesting_component,
+                                                &from_exported, &priority);
+    }
+    
+    // The component may have started unloading since the search
+    bool unloading = best_match && !symbol_pin(best_match);
+    if (unloading) {
+        best_match = NULL;
+    }
+    
+    if (best_match && from_exported) {
         best_match->ref_count++; // Track usage
         
-        // Add to imported table for the requesting component if not already there
+        // Add to imported table for the requesting component if not already there.
+        // The imported table does not take part in resolution, so this does not
+        // change the registry generation.
         bool already_imported = false;
         for (size_t i = 0; i < registry->imported.size; i++) {
             VersionedSymbol* sym = &registry->imported.symbols[i];
-            if (strcmp(sym->name, name) == 0 && 
+            if (sym->name && strcmp(sym->name, name) == 0 && 
                 strcmp(sym->component_id, requesting_component) == 0) {
                 already_imported = true;
                 break;
             }
         }
         
+        // The entry is dropped with either the requester or the provider
         if (!already_imported) {
-            versioned_symbol_table_add(&registry->imported, name, best_match->version, 
-                                      best_match->address, best_match->type, 
-                                      requesting_component, 0);
+            table_add_locked(&registry->imported, name, best_match->version,
+                             best_match->address, best_match->type,
+                             requesting_component, best_match->component_id, 0);
         }
         
         printf("Resolved '%s' version '%s' from component '%s' (priority: %d)\n",
-               name, best_match->version, best_match->component_id, best_priority);
+               name, best_match->version, best_match->component_id, priority);
+    } else if (best_match) {
+        best_match->ref_count++; // Track usage
         
-        return best_match->address;
+        printf("Resolved '%s' version '%s' from global table (priority: %d)\n",
+               name, best_match->version, priority);
+    } else {
+        // Symbol not found with the given constraints
+        printf("Failed to resolve symbol '%s' with constraint '%s' for component '%s'\n", 
+               name, version_constraint ? version_constraint : "any", requesting_component);
     }
     
-    // Check the global table as fallback
-    VersionedSymbol** global_symbols;
-    size_t global_count = versioned_symbol_table_find_all(&registry->global, 
-                                                        name, 
-                                                        &global_symbols);
-    
-    // Find best match from global symbols
-    best_match = NULL;
-    best_priority = -1;
-    
-    for (size_t i = 0; i < global_count; i++) {
-        VersionedSymbol* symbol = global_symbols[i];
-        
-        // Check version constraint if specified
-        if (version_constraint && !semver_satisfies(symbol->version, version_constraint)) {
-            continue;
-        }
+    // Remember the outcome, including failures, until the registry changes
+    if (entry && !unloading) {
+        const char* interned_name = nexus_intern(name);
+        const char* interned_constraint = version_constraint ? nexus_intern(version_constraint) : NULL;
+        const char* interned_component = nexus_intern(requesting_component);
         
-        if (symbol->priority > best_priority) {
-            best_match = symbol;
-            best_priority = symbol->priority;
+        if (interned_name && interned_component &&
+            (interned_constraint || !version_constraint)) {
+            entry->name = interned_name;
+            entry->constraint = interned_constraint;
+            entry->component = interned_component;
+            entry->key_hash = key_hash;
+            entry->generation = generation;
+            entry->symbol = best_match;
         }
     }
     
-    // Free the results array
-    if (global_count > 0) {
-        free(global_symbols);
+    return best_match;
+}
+
+// The core context-aware symbol resolution function
+void* nexus_resolve_versioned_symbol(VersionedSymbolRegistry* registry,
+                                    const char* name,
+                                    const char* version_constraint,
+                                    const char* requesting_component) {
+    NexusComponentUsage* pin = NULL;
+    void* address = nexus_resolve_versioned_symbol_pinned(registry, name, version_constraint,
+                                                          requesting_component, &pin);
+    nexus_versioned_symbol_release(pin);
+    return address;
+}
+
+// Resolve and keep the providing component loaded until the pin is released
+void* nexus_resolve_versioned_symbol_pinned(VersionedSymbolRegistry* registry,
+                                           const char* name,
+                                           const char* version_constraint,
+                                           const char* requesting_component,
+                                           struct NexusComponentUsage** pin) {
+    if (pin) {
+        *pin = NULL;
     }
-    
-    // If we found a match in global, use it
-    if (best_match) {
-        best_match->ref_count++; // Track usage
-        
-        printf("Resolved '%s' version '%s' from global table (priority: %d)\n",
-               name, best_match->version, best_priority);
-        
-        return best_match->address;
+    if (!registry || !name || !requesting_component || !pin) {
+        return NULL;
     }
     
-    // Symbol not found with the given constraints
-    printf("Failed to resolve symbol '%s' with constraint '%s' for component '%s'\n", 
-           name, version_constraint ? version_constraint : "any", requesting_component);
+    pthread_mutex_lock(&registry->lock);
+    VersionedSymbol* symbol = resolve_versioned(registry, name, version_constraint,
+                                                requesting_component);
+    void* address = symbol ? symbol->address : NULL;
+    *pin = symbol ? symbol->usage : NULL;
+    pthread_mutex_unlock(&registry->lock);
     
-    return NULL;
+    return address;
+}
+
+// Drop a pin taken by nexus_resolve_versioned_symbol_pinned()
+void nexus_versioned_symbol_release(struct NexusComponentUsage* pin) {
+    nexus_component_usage_release(pin);
 }
 
 // Same as above but with additional type safety
@@ -301,64 +746,54 @@ void* nexus_resolve_versioned_symbol_typed(VersionedSymbolRegistry* registry,
                                           const char* version_constraint,
                                           VersionedSymbolType expected_type,
                                           const char* requesting_component) {
-    // First resolve the symbol
-    void* address = nexus_resolve_versioned_symbol(registry, name, version_constraint, 
-                                                 requesting_component);
+    if (!registry || !name || !requesting_component) {
+        return NULL;
+    }
     
-    if (!address) {
+    pthread_mutex_lock(&registry->lock);
+    VersionedSymbol* symbol = resolve_versioned(registry, name, version_constraint,
+                                                requesting_component);
+    if (!symbol) {
+        pthread_mutex_unlock(&registry->lock);
         return NULL; // Symbol not found
     }
     
-    // Now verify the type
-    VersionedSymbol** exported_symbols;
-    size_t exported_count = versioned_symbol_table_find_all(&registry->exported, 
-                                                          name, 
-                                                          &exported_symbols);
-    
-    for (size_t i = 0; i < exported_count; i++) {
-        VersionedSymbol* symbol = exported_symbols[i];
-        if (symbol->address == address) {
-            if (symbol->type != expected_type) {
-                printf("Type mismatch for symbol '%s': expected %d, got %d\n",
-                       name, expected_type, symbol->type);
-                free(exported_symbols);
-                return NULL;
-            }
-            free(exported_symbols);
-            return address;
-        }
-    }
+    // The resolved symbol carries its type, so no second lookup is needed
+    VersionedSymbolType type = symbol->type;
+    void* address = symbol->address;
+    NexusComponentUsage* pin = symbol->usage;
+    pthread_mutex_unlock(&registry->lock);
+    nexus_versioned_symbol_release(pin);
     
-    // If not found in exported, check global
-    if (exported_count > 0) {
-        free(exported_symbols);
+    if (type != expected_type) {
+        printf("Type mismatch for symbol '%s': expected %d, got %d\n",
+               name, expected_type, type);
+        return NULL;
     }
     
-    VersionedSymbol** global_symbols;
-    size_t global_count = versioned_symbol_table_find_all(&registry->global, 
-                                                        name, 
-                                                        &global_symbols);
-    
-    for (size_t i = 0; i < global_count; i++) {
-        VersionedSymbol* symbol = global_symbols[i];
-        if (symbol->address == address) {
-            if (symbol->type != expected_type) {
-                printf("Type mismatch for symbol '%s': expected %d, got %d\n",
-                       name, expected_type, symbol->type);
-                free(global_symbols);
-                return NULL;
-            }
-            free(global_symbols);
-            return address;
-        }
+    return address;
+}
+
+// Get resolution cache hit/miss counters
+void nexus_versioned_cache_get_stats(const VersionedSymbolRegistry* registry,
+                                    uint64_t* hits,
+                                    uint64_t* misses) {
+    if (hits) {
+        *hits = registry ? registry->cache.hits : 0;
     }
-    
-    if (global_count > 0) {
-        free(global_symbols);
+    if (misses) {
+        *misses = registry ? registry->cache.misses : 0;
+    }
+}
+
+// Drop every cached resolution and reset the counters
+void nexus_versioned_cache_clear(VersionedSymbolRegistry* registry) {
+    if (!registry) {
+        return;
     }
     
-    // This should not happen if the symbol was found
-    return address;
+    free(registry->cache.entries);
+    memset(&registry->cache, 0, sizeof(registry->cache));
 }
 
 // Detect version conflicts in dependencies
@@ -372,11 +807,15 @@ bool nexus_detect_version_conflicts(VersionedSymbolRegistry* registry,
     // Find all symbols that have multiple versions
     for (size_t i = 0; i < registry->exported.size; i++) {
         VersionedSymbol* symbol = &registry->exported.symbols[i];
+        if (!symbol->name) {
+            continue;  // Dropped entry
+        }
         
         // Skip already processed symbols
         bool already_processed = false;
         for (size_t j = 0; j < i; j++) {
-            if (strcmp(registry->exported.symbols[j].name, symbol->name) == 0) {
+            if (registry->exported.symbols[j].name &&
+                strcmp(registry->exported.symbols[j].name, symbol->name) == 0) {
                 already_processed = true;
                 break;
             }
@@ -517,6 +956,9 @@ char* nexus_generate_dependency_graph(VersionedSymbolRegistry* registry) {
     // Also collect components from exported symbols
     for (size_t i = 0; i < registry->exported.size; i++) {
         VersionedSymbol* symbol = &registry->exported.symbols[i];
+        if (!symbol->name) {
+            continue;  // Dropped entry
+        }
         
         // Check if component_id is already in the list
         bool found = false;
@@ -578,6 +1020,17 @@ void versioned_symbol_table_free(VersionedSymbolTable* table) {
     table->symbols = NULL;
     table->size = 0;
     table->capacity = 0;
+    table->generation++;
+    
+    // Component IDs are interned; only the index arrays are owned here
+    for (size_t i = 0; i < table->component_capacity; i++) {
+        free(table->components[i].entries);
+    }
+    free(table->components);
+    table->components = NULL;
+    table->component_capacity = 0;
+    table->component_count = 0;
+    table->dropped = 0;
 }
 
 // Free a versioned symbol registry
@@ -594,5 +1047,9 @@ void nexus_versioned_registry_free(VersionedSymbolRegistry* registry) {
     }
     free(registry->dependencies);
     
+    // Cached keys are interned; only the slot array is owned here
+    free(registry->cache.entries);
+    
+    pthread_mutex_destroy(&registry->lock);
     free(registry);
 }
\ No newline at end of file
@@ -7,6 +7,8 @@
 #include "nlink/core/tactic/abstraction.h"
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
 #include <assert.h>
 
 void** nlink_map(void** items, size_t count, nlink_map_fn map_func, 
@@ -219,4 +221,449 @@ void** nlink_clone_array(void** items, size_t count) {
     memcpy(result, items, count * sizeof(void*));
     
     return result;
+}
+
+/**
+ * Parallel primitives
+ */
+
+// Fewest items worth a chunk of their own when chunking automatically
+#define PARALLEL_MIN_CHUNK 4096
+#define PARALLEL_TASKS_PER_WORKER 4
+
+// How often a chunk checks whether another chunk has already failed
+#define PARALLEL_CANCEL_INTERVAL 1024
+
+typedef struct parallel_task {
+    nlink_range_fn fn;
+    void* context;
+    size_t chunk;
+    size_t begin;
+    size_t end;
+} parallel_task;
+
+static nlink_thread_pool_t* parallel_pool(const nlink_parallel_config* config) {
+    return config != NULL && config->pool != NULL ? config->pool : nlink_thread_pool_shared();
+}
+
+// First item of a chunk; chunk sizes differ by at most one
+static size_t parallel_chunk_begin(size_t count, size_t chunks, size_t chunk) {
+    size_t remainder = count % chunks;
+    return chunk * (count / chunks) + (chunk < remainder ? chunk : remainder);
+}
+
+static void parallel_task_run(void* arg) {
+    parallel_task* task = (parallel_task*)arg;
+    task->fn(task->chunk, task->begin, task->end, task->context);
+}
+
+// Run one pool task per entry of tasks, or run them in order without a pool
+static void parallel_run_tasks(nlink_thread_pool_t* pool, nlink_task_fn fn,
+                               void* tasks, size_t task_size, size_t task_count) {
+    if (pool == NULL || task_count == 1) {
+        for (size_t i = 0; i < task_count; i++) {
+            fn((char*)tasks + i * task_size);
+        }
+        return;
+    }
+    
+    nlink_task_group_t group;
+    nlink_task_group_init(&group);
+    for (size_t i = 0; i < task_count; i++) {
+        nlink_thread_pool_submit(pool, fn, (char*)tasks + i * task_size, &group);
+    }
+    nlink_thread_pool_wait(pool, &group);
+}
+
+// Output buffer: the caller's, else the arena's, else malloc'd and owned by the caller
+static void** parallel_output(void** output, size_t count, const nlink_parallel_config* config, bool* owned) {
+    *owned = false;
+    if (output != NULL) {
+        return output;
+    }
+    if (count > SIZE_MAX / sizeof(void*)) {
+        return NULL;
+    }
+    if (config != NULL && config->arena != NULL) {
+        return nlink_arena_alloc(config->arena, count * sizeof(void*));
+    }
+    
+    *owned = true;
+    return malloc(count * sizeof(void*));
+}
+
+size_t nlink_parallel_chunk_count(size_t count, const nlink_parallel_config* config) {
+    size_t cutoff = NLINK_PARALLEL_DEFAULT_CUTOFF;
+    if (config != NULL && config->serial_cutoff > 0) {
+        cutoff = config->serial_cutoff;
+    }
+    if (count < 2 || count < cutoff) {
+        return 1;
+    }
+    
+    nlink_thread_pool_t* pool = parallel_pool(config);
+    if (pool == NULL) {
+        return 1;
+    }
+    
+    size_t chunks;
+    if (config != NULL && config->chunk_size > 0) {
+        chunks = count / config->chunk_size + (count % config->chunk_size != 0);
+    } else {
+        chunks = nlink_thread_pool_worker_count(pool) * PARALLEL_TASKS_PER_WORKER;
+        if (chunks > count / PARALLEL_MIN_CHUNK) {
+            chunks = count / PARALLEL_MIN_CHUNK;
+        }
+    }
+    
+    return chunks > 1 ? chunks : 1;
+}
+
+size_t nlink_parallel_for(size_t count, nlink_range_fn fn, void* context,
+                          const nlink_parallel_config* config) {
+    if (fn == NULL || count == 0) {
+        return 0;
+    }
+    
+    size_t chunks = nlink_parallel_chunk_count(count, config);
+    parallel_task* tasks = chunks > 1 ? malloc(chunks * sizeof(parallel_task)) : NULL;
+    if (tasks == NULL) {
+        // Same chunks, in order, on the calling thread
+        for (size_t c = 0; c < chunks; c++) {
+            fn(c, parallel_chunk_begin(count, chunks, c), parallel_chunk_begin(count, chunks, c + 1), context);
+        }
+        return chunks;
+    }
+    
+    for (size_t c = 0; c < chunks; c++) {
+        tasks[c].fn = fn;
+        tasks[c].context = context;
+        tasks[c].chunk = c;
+        tasks[c].begin = parallel_chunk_begin(count, chunks, c);
+        tasks[c].end = parallel_chunk_begin(count, chunks, c + 1);
+    }
+    
+    parallel_run_tasks(parallel_pool(config), parallel_task_run, tasks, sizeof(parallel_task), chunks);
+    free(tasks);
+    return chunks;
+}
+
+typedef struct map_job {
+    void** items;
+    void** output;
+    nlink_map_fn map_func;
+    void* context;
+    atomic_bool failed;
+} map_job;
+
+static void map_range(size_t chunk, size_t begin, size_t end, void* context) {
+    map_job* job = (map_job*)context;
+    (void)chunk;
+    
+    for (size_t i = begin; i < end; i++) {
+        if ((i - begin) % PARALLEL_CANCEL_INTERVAL == 0 &&
+            atomic_load_explicit(&job->failed, memory_order_relaxed)) {
+            return;
+        }
+        
+        void* item = job->items[i];
+        void* mapped = job->map_func(item, job->context);
+        job->output[i] = mapped;
+        
+        // A NULL result for a non-NULL item fails the whole map, as in nlink_map
+        if (mapped == NULL && item != NULL) {
+            atomic_store_explicit(&job->failed, true, memory_order_relaxed);
+            return;
+        }
+    }
+}
+
+void** nlink_map_parallel(void** items, size_t count, nlink_map_fn map_func,
+                          void* context, void** output, const nlink_parallel_config* config) {
+    if (items == NULL || map_func == NULL || count == 0) {
+        return NULL;
+    }
+    
+    bool owned;
+    output = parallel_output(output, count, config, &owned);
+    if (output == NULL) {
+        return NULL;
+    }
+    
+    map_job job = { items, output, map_func, context, false };
+    nlink_parallel_for(count, map_range, &job, config);
+    
+    if (atomic_load(&job.failed)) {
+        if (owned) {
+            free(output);
+        }
+        return NULL;
+    }
+    return output;
+}
+
+typedef struct filter_job {
+    void** items;
+    void** output;
+    nlink_filter_fn filter_func;
+    void* context;
+    size_t* counts;
+} filter_job;
+
+// Compact a chunk's matches to the start of its own output range
+static void filter_range(size_t chunk, size_t begin, size_t end, void* context) {
+    filter_job* job = (filter_job*)context;
+    size_t kept = begin;
+    
+    for (size_t i = begin; i < end; i++) {
+        void* item = job->items[i];
+        if (job->filter_func(item, job->context)) {
+            job->output[kept++] = item;
+        }
+    }
+    
+    job->counts[chunk] = kept - begin;
+}
+
+void** nlink_filter_parallel(void** items, size_t count, nlink_filter_fn filter_func,
+                             void* context, void** output, size_t* result_size,
+                             const nlink_parallel_config* config) {
+    if (result_size != NULL) {
+        *result_size = 0;
+    }
+    if (items == NULL || filter_func == NULL || count == 0) {
+        return NULL;
+    }
+    
+    size_t chunks = nlink_parallel_chunk_count(count, config);
+    size_t single_count;
+    size_t* counts = chunks > 1 ? malloc(chunks * sizeof(size_t)) : &single_count;
+    
+    bool owned;
+    void** result = counts != NULL ? parallel_output(output, count, config, &owned) : NULL;
+    if (result == NULL) {
+        if (counts != &single_count) {
+            free(counts);
+        }
+        return NULL;
+    }
+    
+    filter_job job = { items, result, filter_func, context, counts };
+    nlink_parallel_for(count, filter_range, &job, config);
+    
+    // Each chunk's matches move down to the prefix sum of the counts before it.
+    // Destinations never pass the next chunk's start, so this runs in chunk order.
+    size_t total = counts[0];
+    for (size_t c = 1; c < chunks; c++) {
+        size_t begin = parallel_chunk_begin(count, chunks, c);
+        if (counts[c] > 0 && begin != total) {
+            memmove(result + total, result + begin, counts[c] * sizeof(void*));
+        }
+        total += counts[c];
+    }
+    
+    if (counts != &single_count) {
+        free(counts);
+    }
+    if (result_size != NULL) {
+        *result_size = total;
+    }
+    return result;
+}
+
+typedef struct sort_job {
+    void** items;
+    nlink_compare_fn compare;
+    void* context;
+} sort_job;
+
+static void sort_range(size_t chunk, size_t begin, size_t end, void* context) {
+    sort_job* job = (sort_job*)context;
+    (void)chunk;
+    nlink_sort(job->items + begin, end - begin, job->compare, job->context);
+}
+
+/**
+ * One part of a merge of the sorted runs src[begin, middle) and
+ * src[middle, end): writes merged positions [out_begin, out_end) of dst.
+ */
+typedef struct sort_merge_task {
+    void** src;
+    void** dst;
+    size_t begin;
+    size_t middle;
+    size_t end;
+    size_t out_begin;
+    size_t out_end;
+    nlink_compare_fn compare;
+    void* context;
+} sort_merge_task;
+
+// Items of the left run among the first position merged outputs; ties go left
+static size_t sort_merge_split(const sort_merge_task* task, size_t position) {
+    void** left = task->src + task->begin;
+    void** right = task->src + task->middle;
+    size_t left_count = task->middle - task->begin;
+    size_t right_count = task->end - task->middle;
+    
+    size_t low = position > right_count ? position - right_count : 0;
+    size_t high = position < left_count ? position : left_count;
+    while (low < high) {
+        size_t i = low + (high - low) / 2;
+        if (task->compare(left[i], right[position - i - 1], task->context) <= 0) {
+            low = i + 1;
+        } else {
+            high = i;
+        }
+    }
+    return low;
+}
+
+static void sort_merge_run(void* arg) {
+    sort_merge_task* task = (sort_merge_task*)arg;
+    size_t first = task->out_begin - task->begin;
+    size_t last = task->out_end - task->begin;
+    
+    size_t i = task->begin + sort_merge_split(task, first);
+    size_t j = task->middle + (first - (i - task->begin));
+    size_t i_end = task->begin + sort_merge_split(task, last);
+    size_t j_end = task->middle + (last - (i_end - task->begin));
+    
+    void** out = task->dst + task->out_begin;
+    while (i < i_end && j < j_end) {
+        if (task->compare(task->src[i], task->src[j], task->context) <= 0) {
+            *out++ = task->src[i++];
+        } else {
+            *out++ = task->src[j++];
+        }
+    }
+    while (i < i_end) {
+        *out++ = task->src[i++];
+    }
+    while (j < j_end) {
+        *out++ = task->src[j++];
+    }
+}
+
+bool nlink_sort_parallel(void** items, size_t count, nlink_compare_fn compare,
+                         void* context, const nlink_parallel_config* config) {
+    if (items == NULL || compare == NULL) {
+        return false;
+    }
+    
+    size_t chunks = nlink_parallel_chunk_count(count, config);
+    if (chunks == 1) {
+        nlink_sort(items, count, compare, context);
+        return true;
+    }
+    
+    bool owned;
+    void** scratch = parallel_output(NULL, count, config, &owned);
+    sort_merge_task* tasks = malloc(chunks * sizeof(sort_merge_task));
+    if (scratch == NULL || tasks == NULL) {
+        if (owned) {
+            free(scratch);
+        }
+        free(tasks);
+        return false;
+    }
+    
+    sort_job job = { items, compare, context };
+    nlink_parallel_for(count, sort_range, &job, config);
+    
+    // Merge adjacent runs, doubling their width each round. Rounds with
+    // fewer merges than chunks split each merge at co-ranked positions so
+    // the final merges still spread over the pool.
+    nlink_thread_pool_t* pool = parallel_pool(config);
+    void** src = items;
+    void** dst = scratch;
+    for (size_t width = 1; width < chunks; width *= 2) {
+        size_t merges = (chunks + 2 * width - 1) / (2 * width);
+        size_t parts = chunks / merges;
+        size_t task_count = 0;
+        
+        for (size_t run = 0; run < chunks; run += 2 * width) {
+            size_t begin = parallel_chunk_begin(count, chunks, run);
+            size_t middle = parallel_chunk_begin(count, chunks, run + width < chunks ? run + width : chunks);
+            size_t end = parallel_chunk_begin(count, chunks, run + 2 * width < chunks ? run + 2 * width : chunks);
+            
+            for (size_t part = 0; part < parts; part++) {
+                sort_merge_task* task = &tasks[task_count++];
+                task->src = src;
+                task->dst = dst;
+                task->begin = begin;
+                task->middle = middle;
+                task->end = end;
+                task->out_begin = begin + parallel_chunk_begin(end - begin, parts, part);
+                task->out_end = begin + parallel_chunk_begin(end - begin, parts, part + 1);
+                task->compare = compare;
+                task->context = context;
+            }
+        }
+        
+        parallel_run_tasks(pool, sort_merge_run, tasks, sizeof(sort_merge_task), task_count);
+        void** swap = src;
+        src = dst;
+        dst = swap;
+    }
+    
+    if (src != items) {
+        memcpy(items, src, count * sizeof(void*));
+    }
+    
+    free(tasks);
+    if (owned) {
+        free(scratch);
+    }
+    return true;
+}
+
+static void* fused_fold(void** items, size_t begin, size_t end, void* accumulator,
+                        const nlink_fused_ops* ops) {
+    for (size_t i = begin; i < end; i++) {
+        void* item = items[i];
+        if (ops->map_fn != NULL) {
+            item = ops->map_fn(item, ops->context);
+        }
+        if (ops->filter_fn != NULL && !ops->filter_fn(item, ops->context)) {
+            continue;
+        }
+        accumulator = ops->fold_fn(accumulator, item, ops->context);
+    }
+    return accumulator;
+}
+
+typedef struct fused_job {
+    void** items;
+    const nlink_fused_ops* ops;
+    void** partials;
+} fused_job;
+
+static void fused_range(size_t chunk, size_t begin, size_t end, void* context) {
+    fused_job* job = (fused_job*)context;
+    job->partials[chunk] = fused_fold(job->items, begin, end, job->ops->identity, job->ops);
+}
+
+void* nlink_map_filter_fold(void** items, size_t count, void* initial,
+                            const nlink_fused_ops* ops, const nlink_parallel_config* config) {
+    if (items == NULL || ops == NULL || ops->fold_fn == NULL || count == 0) {
+        return initial;
+    }
+    
+    size_t chunks = ops->combine_fn != NULL ? nlink_parallel_chunk_count(count, config) : 1;
+    void** partials = chunks > 1 ? malloc(chunks * sizeof(void*)) : NULL;
+    if (partials == NULL) {
+        return fused_fold(items, 0, count, initial, ops);
+    }
+    
+    fused_job job = { items, ops, partials };
+    nlink_parallel_for(count, fused_range, &job, config);
+    
+    void* accumulator = initial;
+    for (size_t c = 0; c < chunks; c++) {
+        accumulator = ops->combine_fn(accumulator, partials[c], ops->context);
+    }
+    
+    free(partials);
+    return accumulator;
 }
\ No newline at end of file
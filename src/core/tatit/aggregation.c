@@ -5,11 +5,17 @@
  */
 
 #include "nlink/core/tactic/aggregation.h"
+#include "nlink/core/threading/thread_pool.h"
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
 #include <math.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define COLUMN_SIMD_SSE2 1
+#endif
+
 // Default comparison function for generic pointers
 static int default_compare(const void* a, const void* b) {
     if (a < b) return -1;
@@ -206,128 +212,447 @@ void nlink_aggregation_result_free(nlink_aggregation_result* result) {
     free(result);
 }
 
-// Hash table entry for group_by
+/**
+ * Group table: open addressing with linear probing over (hash, group)
+ * slots. Groups are numbered in order of creation; their keys, hashes
+ * and item counts live in parallel arrays indexed by group.
+ */
+#define GROUP_EMPTY ((size_t)-1)
+#define GROUP_TABLE_MIN_CAPACITY 16
+
+// Items per shard below which partitioned grouping is not worth it
+#define GROUP_MIN_PARTITION_ITEMS 4096
+
+typedef struct {
+    size_t hash;
+    size_t group;
+} group_slot;
+
+typedef struct {
+    group_slot* slots;
+    size_t capacity;        // Power of two
+    void** keys;
+    size_t* hashes;
+    size_t* counts;
+    size_t group_count;
+    size_t group_capacity;
+} group_table;
+
+// Default key hash: Fibonacci hashing of the key pointer
+static size_t hash_pointer(const void* key, void* context) {
+    (void)context;
+    uint64_t bits = (uint64_t)(uintptr_t)key;
+    bits ^= bits >> 4;
+    return (size_t)((bits * 0x9E3779B97F4A7C15ull) >> 16);
+}
+
+static bool equal_pointer(const void* a, const void* b, void* context) {
+    (void)context;
+    return a == b;
+}
+
+static bool group_table_init(group_table* table, size_t expected_groups) {
+    size_t capacity = GROUP_TABLE_MIN_CAPACITY;
+    while (capacity < expected_groups * 2) {
+        capacity <<= 1;
+    }
+    size_t group_capacity = capacity / 2;
+    
+    table->slots = malloc(capacity * sizeof(group_slot));
+    table->keys = malloc(group_capacity * sizeof(void*));
+    table->hashes = malloc(group_capacity * sizeof(size_t));
+    table->counts = malloc(group_capacity * sizeof(size_t));
+    table->capacity = capacity;
+    table->group_count = 0;
+    table->group_capacity = group_capacity;
+    
+    if (table->slots == NULL || table->keys == NULL || table->hashes == NULL || table->counts == NULL) {
+        return false;
+    }
+    
+    for (size_t i = 0; i < capacity; i++) {
+        table->slots[i].group = GROUP_EMPTY;
+    }
+    
+    return true;
+}
+
+static void group_table_free(group_table* table) {
+    free(table->slots);
+    free(table->keys);
+    free(table->hashes);
+    free(table->counts);
+}
+
+static bool group_table_grow(group_table* table) {
+    // Grow the slot array and the per-group arrays together, keeping the load at or below one half
+    size_t capacity = table->capacity * 2;
+    group_slot* slots = malloc(capacity * sizeof(group_slot));
+    if (slots == NULL) {
+        return false;
+    }
+    
+    size_t group_capacity = capacity / 2;
+    void** keys = realloc(table->keys, group_capacity * sizeof(void*));
+    if (keys != NULL) {
+        table->keys = keys;
+    }
+    size_t* hashes = realloc(table->hashes, group_capacity * sizeof(size_t));
+    if (hashes != NULL) {
+        table->hashes = hashes;
+    }
+    size_t* counts = realloc(table->counts, group_capacity * sizeof(size_t));
+    if (counts != NULL) {
+        table->counts = counts;
+    }
+    if (keys == NULL || hashes == NULL || counts == NULL) {
+        free(slots);
+        return false;
+    }
+    
+    for (size_t i = 0; i < capacity; i++) {
+        slots[i].group = GROUP_EMPTY;
+    }
+    for (size_t group = 0; group < table->group_count; group++) {
+        size_t slot = table->hashes[group] & (capacity - 1);
+        while (slots[slot].group != GROUP_EMPTY) {
+            slot = (slot + 1) & (capacity - 1);
+        }
+        slots[slot].hash = table->hashes[group];
+        slots[slot].group = group;
+    }
+    
+    free(table->slots);
+    table->slots = slots;
+    table->capacity = capacity;
+    table->group_capacity = group_capacity;
+    
+    return true;
+}
+
+/**
+ * Find the group of a key, creating it if absent
+ * Returns GROUP_EMPTY if out of memory.
+ */
+static size_t group_table_lookup(group_table* table, void* key, size_t hash,
+                                 nlink_key_equal_fn equal_fn, void* context) {
+    size_t mask = table->capacity - 1;
+    size_t slot = hash & mask;
+    
+    while (table->slots[slot].group != GROUP_EMPTY) {
+        size_t group = table->slots[slot].group;
+        if (table->slots[slot].hash == hash && equal_fn(table->keys[group], key, context)) {
+            return group;
+        }
+        slot = (slot + 1) & mask;
+    }
+    
+    // New group
+    if (table->group_count == table->group_capacity) {
+        if (!group_table_grow(table)) {
+            return GROUP_EMPTY;
+        }
+        mask = table->capacity - 1;
+        slot = hash & mask;
+        while (table->slots[slot].group != GROUP_EMPTY) {
+            slot = (slot + 1) & mask;
+        }
+    }
+    
+    size_t group = table->group_count++;
+    table->slots[slot].hash = hash;
+    table->slots[slot].group = group;
+    table->keys[group] = key;
+    table->hashes[group] = hash;
+    table->counts[group] = 0;
+    
+    return group;
+}
+
+/**
+ * One shard of a group-by: groups items[begin, end) into its own table,
+ * recording each item's group in item_groups
+ */
 typedef struct {
-    void* key;
     void** items;
-    size_t count;
-    size_t capacity;
-} group_entry;
+    size_t begin;
+    size_t end;
+    size_t* item_groups;
+    const nlink_group_by_config* config;
+    nlink_key_hash_fn hash_fn;
+    nlink_key_equal_fn equal_fn;
+    size_t expected_groups;
+    group_table table;
+    bool ok;
+} group_shard;
 
-// Simple hash function for pointers
-static size_t hash_pointer(void* ptr) {
-    return (size_t)ptr % 1024;
+static void group_shard_run(void* arg) {
+    group_shard* shard = (group_shard*)arg;
+    const nlink_group_by_config* config = shard->config;
+    
+    shard->ok = group_table_init(&shard->table, shard->expected_groups);
+    
+    for (size_t i = shard->begin; shard->ok && i < shard->end; i++) {
+        void* key = config->key_fn(shard->items[i], config->context);
+        size_t hash = shard->hash_fn(key, config->context);
+        size_t group = group_table_lookup(&shard->table, key, hash, shard->equal_fn, config->context);
+        if (group == GROUP_EMPTY) {
+            shard->ok = false;
+            break;
+        }
+        shard->item_groups[i] = group;
+        shard->table.counts[group]++;
+    }
 }
 
-void*** nlink_group_by(void** items, size_t count, 
-                      void* (*key_fn)(void* item, void* context),
-                      void* context, size_t* num_groups) {
-    if (items == NULL || count == 0 || key_fn == NULL || num_groups == NULL) {
-        *num_groups = 0;
+static nlink_grouping* grouping_create(size_t item_count, size_t group_count) {
+    nlink_grouping* grouping = malloc(sizeof(nlink_grouping));
+    if (grouping == NULL) {
         return NULL;
     }
     
-    // Simplified implementation using a basic hash table
-    // In a real implementation, we would use a proper hash table
+    grouping->items = malloc((item_count ? item_count : 1) * sizeof(void*));
+    grouping->offsets = malloc((group_count + 1) * sizeof(size_t));
+    grouping->keys = malloc((group_count ? group_count : 1) * sizeof(void*));
+    grouping->item_count = item_count;
+    grouping->group_count = group_count;
     
-    group_entry groups[1024] = {0};  // Fixed size for simplicity
-    size_t group_count = 0;
+    if (grouping->items == NULL || grouping->offsets == NULL || grouping->keys == NULL) {
+        nlink_grouping_free(grouping);
+        return NULL;
+    }
     
-    // Group items by key
-    for (size_t i = 0; i < count; i++) {
-        void* key = key_fn(items[i], context);
-        size_t hash = hash_pointer(key);
-        
-        // Find or create group
-        if (groups[hash].key == NULL) {
-            // New group
-            groups[hash].key = key;
-            groups[hash].capacity = 16;  // Initial capacity
-            groups[hash].items = malloc(groups[hash].capacity * sizeof(void*));
-            if (groups[hash].items == NULL) {
-                // Cleanup and fail
-                for (size_t j = 0; j < 1024; j++) {
-                    free(groups[j].items);
+    return grouping;
+}
+
+void nlink_grouping_free(nlink_grouping* grouping) {
+    if (grouping == NULL) {
+        return;
+    }
+    
+    free(grouping->items);
+    free(grouping->offsets);
+    free(grouping->keys);
+    free(grouping);
+}
+
+// Scatter a shard's items to their group positions; cursors are indexed by the shard's local groups
+typedef struct {
+    void** items;
+    size_t begin;
+    size_t end;
+    const size_t* item_groups;
+    size_t* cursors;
+    void** output;
+} group_scatter;
+
+static void group_scatter_run(void* arg) {
+    group_scatter* scatter = (group_scatter*)arg;
+    
+    for (size_t i = scatter->begin; i < scatter->end; i++) {
+        scatter->output[scatter->cursors[scatter->item_groups[i]]++] = scatter->items[i];
+    }
+}
+
+// Run one task per shard, on the shared pool when there is more than one
+static void group_run_shards(void (*fn)(void*), void* shards, size_t shard_size, size_t shard_count) {
+    nlink_thread_pool_t* pool = shard_count > 1 ? nlink_thread_pool_shared() : NULL;
+    
+    if (pool == NULL) {
+        for (size_t i = 0; i < shard_count; i++) {
+            fn((char*)shards + i * shard_size);
+        }
+        return;
+    }
+    
+    nlink_task_group_t group;
+    nlink_task_group_init(&group);
+    for (size_t i = 0; i < shard_count; i++) {
+        nlink_thread_pool_submit(pool, fn, (char*)shards + i * shard_size, &group);
+    }
+    nlink_thread_pool_wait(pool, &group);
+}
+
+nlink_grouping* nlink_group_by_keys(void** items, size_t count,
+                                    const nlink_group_by_config* config) {
+    if ((items == NULL && count > 0) || config == NULL || config->key_fn == NULL ||
+        (config->hash_fn == NULL) != (config->equal_fn == NULL)) {
+        return NULL;
+    }
+    
+    // Cap the shard count so each shard has enough items to pay for its table
+    size_t shard_count = config->partitions > 1 ? config->partitions : 1;
+    if (shard_count > count / GROUP_MIN_PARTITION_ITEMS) {
+        shard_count = count / GROUP_MIN_PARTITION_ITEMS > 1 ? count / GROUP_MIN_PARTITION_ITEMS : 1;
+    }
+    
+    size_t* item_groups = malloc((count ? count : 1) * sizeof(size_t));
+    group_shard* shards = calloc(shard_count, sizeof(group_shard));
+    size_t** local_to_global = calloc(shard_count, sizeof(size_t*));
+    group_scatter* scatters = calloc(shard_count, sizeof(group_scatter));
+    group_table merged = { 0 };
+    nlink_grouping* grouping = NULL;
+    bool ok = item_groups != NULL && shards != NULL && local_to_global != NULL && scatters != NULL;
+    
+    // Group each shard into its own table
+    for (size_t i = 0; ok && i < shard_count; i++) {
+        shards[i].items = items;
+        shards[i].begin = count * i / shard_count;
+        shards[i].end = count * (i + 1) / shard_count;
+        shards[i].item_groups = item_groups;
+        shards[i].config = config;
+        shards[i].hash_fn = config->hash_fn != NULL ? config->hash_fn : hash_pointer;
+        shards[i].equal_fn = config->equal_fn != NULL ? config->equal_fn : equal_pointer;
+        shards[i].expected_groups = config->expected_groups / shard_count;
+    }
+    if (ok) {
+        group_run_shards(group_shard_run, shards, sizeof(group_shard), shard_count);
+        for (size_t i = 0; i < shard_count; i++) {
+            ok = ok && shards[i].ok;
+        }
+    }
+    
+    // Merge shard tables in shard order, so groups keep first-appearance order
+    group_table* table = shards != NULL ? &shards[0].table : NULL;
+    if (ok && shard_count > 1) {
+        ok = group_table_init(&merged, shards[0].table.group_count);
+        for (size_t i = 0; ok && i < shard_count; i++) {
+            group_table* local = &shards[i].table;
+            local_to_global[i] = malloc((local->group_count ? local->group_count : 1) * sizeof(size_t));
+            ok = local_to_global[i] != NULL;
+            for (size_t g = 0; ok && g < local->group_count; g++) {
+                size_t group = group_table_lookup(&merged, local->keys[g], local->hashes[g],
+                                                  shards[i].equal_fn, config->context);
+                if (group == GROUP_EMPTY) {
+                    ok = false;
+                    break;
                 }
-                *num_groups = 0;
-                return NULL;
-            }
-            group_count++;
-        } else if (groups[hash].key != key) {
-            // Hash collision - for simplicity we'll just fail
-            // In a real implementation, we would handle this properly
-            for (size_t j = 0; j < 1024; j++) {
-                free(groups[j].items);
+                merged.counts[group] += local->counts[g];
+                local_to_global[i][g] = group;
             }
-            *num_groups = 0;
-            return NULL;
+        }
+        table = &merged;
+    }
+    
+    if (ok) {
+        grouping = grouping_create(count, table->group_count);
+        ok = grouping != NULL;
+    }
+    
+    if (ok) {
+        // Offsets are the prefix sums of the group sizes
+        size_t offset = 0;
+        for (size_t g = 0; g < table->group_count; g++) {
+            grouping->offsets[g] = offset;
+            grouping->keys[g] = table->keys[g];
+            offset += table->counts[g];
+        }
+        grouping->offsets[table->group_count] = offset;
+        
+        // Each shard starts writing a group where the previous shards' items of that group end
+        size_t* next = malloc((table->group_count ? table->group_count : 1) * sizeof(size_t));
+        ok = next != NULL;
+        for (size_t i = 0; ok && i < shard_count; i++) {
+            group_table* local = &shards[i].table;
+            scatters[i].cursors = malloc((local->group_count ? local->group_count : 1) * sizeof(size_t));
+            ok = scatters[i].cursors != NULL;
         }
         
-        // Add item to group
-        if (groups[hash].count >= groups[hash].capacity) {
-            // Resize group
-            groups[hash].capacity *= 2;
-            void** new_items = realloc(groups[hash].items, 
-                                     groups[hash].capacity * sizeof(void*));
-            if (new_items == NULL) {
-                // Cleanup and fail
-                for (size_t j = 0; j < 1024; j++) {
-                    free(groups[j].items);
+        if (ok) {
+            memcpy(next, grouping->offsets, table->group_count * sizeof(size_t));
+            for (size_t i = 0; i < shard_count; i++) {
+                group_table* local = &shards[i].table;
+                for (size_t g = 0; g < local->group_count; g++) {
+                    size_t group = shard_count > 1 ? local_to_global[i][g] : g;
+                    scatters[i].cursors[g] = next[group];
+                    next[group] += local->counts[g];
                 }
-                *num_groups = 0;
-                return NULL;
+                scatters[i].items = items;
+                scatters[i].begin = shards[i].begin;
+                scatters[i].end = shards[i].end;
+                scatters[i].item_groups = item_groups;
+                scatters[i].output = grouping->items;
             }
-            groups[hash].items = new_items;
+            group_run_shards(group_scatter_run, scatters, sizeof(group_scatter), shard_count);
         }
-        
-        groups[hash].items[groups[hash].count++] = items[i];
+        free(next);
+    }
+    
+    // Cleanup
+    for (size_t i = 0; i < shard_count; i++) {
+        if (shards != NULL) {
+            group_table_free(&shards[i].table);
+        }
+        if (local_to_global != NULL) {
+            free(local_to_global[i]);
+        }
+        if (scatters != NULL) {
+            free(scatters[i].cursors);
+        }
+    }
+    group_table_free(&merged);
+    free(shards);
+    free(local_to_global);
+    free(scatters);
+    free(item_groups);
+    
+    if (!ok) {
+        nlink_grouping_free(grouping);
+        return NULL;
+    }
+    
+    return grouping;
+}
+
+void*** nlink_group_by(void** items, size_t count, 
+                      void* (*key_fn)(void* item, void* context),
+                      void* context, size_t* num_groups) {
+    if (num_groups == NULL) {
+        return NULL;
+    }
+    *num_groups = 0;
+    
+    if (items == NULL || count == 0 || key_fn == NULL) {
+        return NULL;
+    }
+    
+    nlink_group_by_config config = { key_fn, NULL, NULL, context, 0, 1 };
+    nlink_grouping* grouping = nlink_group_by_keys(items, count, &config);
+    if (grouping == NULL) {
+        return NULL;
     }
     
     // Create result array
-    void*** result = malloc((group_count + 1) * sizeof(void**));
+    void*** result = malloc((grouping->group_count + 1) * sizeof(void**));
     if (result == NULL) {
-        // Cleanup and fail
-        for (size_t j = 0; j < 1024; j++) {
-            free(groups[j].items);
-        }
-        *num_groups = 0;
+        nlink_grouping_free(grouping);
         return NULL;
     }
     
-    // Fill result array
-    size_t result_index = 0;
-    for (size_t i = 0; i < 1024; i++) {
-        if (groups[i].key != NULL) {
-            // Create NULL-terminated array for this group
-            void** group = malloc((groups[i].count + 1) * sizeof(void*));
-            if (group == NULL) {
-                // Cleanup and fail
-                for (size_t j = 0; j < result_index; j++) {
-                    free(result[j]);
-                }
-                for (size_t j = 0; j < 1024; j++) {
-                    free(groups[j].items);
-                }
-                free(result);
-                *num_groups = 0;
-                return NULL;
+    // Fill result array with NULL-terminated copies of each group
+    for (size_t g = 0; g < grouping->group_count; g++) {
+        size_t group_size = grouping->offsets[g + 1] - grouping->offsets[g];
+        void** group = malloc((group_size + 1) * sizeof(void*));
+        if (group == NULL) {
+            // Cleanup and fail
+            for (size_t j = 0; j < g; j++) {
+                free(result[j]);
             }
-            
-            // Copy items
-            memcpy(group, groups[i].items, groups[i].count * sizeof(void*));
-            group[groups[i].count] = NULL;  // NULL-terminate
-            
-            result[result_index++] = group;
-            
-            // Free original items array
-            free(groups[i].items);
+            free(result);
+            nlink_grouping_free(grouping);
+            return NULL;
         }
+        
+        memcpy(group, grouping->items + grouping->offsets[g], group_size * sizeof(void*));
+        group[group_size] = NULL;  // NULL-terminate
+        result[g] = group;
     }
     
     // NULL-terminate result array
-    result[result_index] = NULL;
+    result[grouping->group_count] = NULL;
     
-    *num_groups = group_count;
+    *num_groups = grouping->group_count;
+    nlink_grouping_free(grouping);
     return result;
 }
 
@@ -437,4 +762,444 @@ nlink_aggregation_result* nlink_numerical_summary(void** values, size_t count) {
     result->numeric_avg = sum / count;
     
     return result;
+}
+
+/**
+ * Columnar numeric summaries
+ *
+ * Each task folds its range into a column_partial: min, max and Kahan-
+ * compensated sums of x, (x - shift) and (x - shift)^2, where shift is
+ * the column's first value. The shifted sums keep the variance stable
+ * for data far from zero; the plain sum keeps full precision when the
+ * first value is an outlier. Partials are merged in range order. float and
+ * int64 columns are widened to double a block at a time and run through
+ * the same kernel.
+ */
+#define COLUMN_BLOCK 256
+#define COLUMN_PARALLEL_THRESHOLD (1u << 18)
+#define COLUMN_TASKS_PER_WORKER 4
+#define COLUMN_SORT_PERCENTILES 8
+
+typedef enum {
+    COLUMN_F64,
+    COLUMN_F32,
+    COLUMN_I64
+} column_type;
+
+typedef struct {
+    size_t count;
+    double min;
+    double max;
+    double sum;
+    double sum_comp;
+    double shifted;
+    double shifted_comp;
+    double squares;
+    double squares_comp;
+} column_partial;
+
+typedef struct {
+    const void* values;
+    column_type type;
+    size_t begin;
+    size_t end;
+    double shift;
+    column_partial partial;
+} column_task;
+
+static void column_partial_init(column_partial* partial) {
+    partial->count = 0;
+    partial->min = INFINITY;
+    partial->max = -INFINITY;
+    partial->sum = 0.0;
+    partial->sum_comp = 0.0;
+    partial->shifted = 0.0;
+    partial->shifted_comp = 0.0;
+    partial->squares = 0.0;
+    partial->squares_comp = 0.0;
+}
+
+static inline void kahan_add(double* sum, double* comp, double value) {
+    double y = value - *comp;
+    double t = *sum + y;
+    *comp = (t - *sum) - y;
+    *sum = t;
+}
+
+#ifdef COLUMN_SIMD_SSE2
+static inline void kahan_add_pd(__m128d* sum, __m128d* comp, __m128d value) {
+    __m128d y = _mm_sub_pd(value, *comp);
+    __m128d t = _mm_add_pd(*sum, y);
+    *comp = _mm_sub_pd(_mm_sub_pd(t, *sum), y);
+    *sum = t;
+}
+
+// Fold the two lanes of a compensated vector sum into a scalar one
+static inline void kahan_fold_pd(double* sum, double* comp, __m128d lane_sum, __m128d lane_comp) {
+    double sums[2];
+    double comps[2];
+    _mm_storeu_pd(sums, lane_sum);
+    _mm_storeu_pd(comps, lane_comp);
+    kahan_add(sum, comp, sums[0] - comps[0]);
+    kahan_add(sum, comp, sums[1] - comps[1]);
+}
+#endif
+
+static void column_kernel_f64(const double* values, size_t count, double shift, column_partial* partial) {
+    size_t i = 0;
+    
+#ifdef COLUMN_SIMD_SSE2
+    // Two independent 2-lane accumulators hide the add latency
+    if (count >= 4) {
+        __m128d min0 = _mm_set1_pd(partial->min), min1 = min0;
+        __m128d max0 = _mm_set1_pd(partial->max), max1 = max0;
+        __m128d sum0 = _mm_setzero_pd(), sum1 = sum0, sum_comp0 = sum0, sum_comp1 = sum0;
+        __m128d sh0 = sum0, sh1 = sum0, sh_comp0 = sum0, sh_comp1 = sum0;
+        __m128d sq0 = sum0, sq1 = sum0, sq_comp0 = sum0, sq_comp1 = sum0;
+        __m128d offset = _mm_set1_pd(shift);
+        
+        for (; i + 4 <= count; i += 4) {
+            __m128d a = _mm_loadu_pd(values + i);
+            __m128d b = _mm_loadu_pd(values + i + 2);
+            min0 = _mm_min_pd(min0, a);
+            min1 = _mm_min_pd(min1, b);
+            max0 = _mm_max_pd(max0, a);
+            max1 = _mm_max_pd(max1, b);
+            
+            kahan_add_pd(&sum0, &sum_comp0, a);
+            kahan_add_pd(&sum1, &sum_comp1, b);
+            
+            a = _mm_sub_pd(a, offset);
+            b = _mm_sub_pd(b, offset);
+            kahan_add_pd(&sh0, &sh_comp0, a);
+            kahan_add_pd(&sh1, &sh_comp1, b);
+            kahan_add_pd(&sq0, &sq_comp0, _mm_mul_pd(a, a));
+            kahan_add_pd(&sq1, &sq_comp1, _mm_mul_pd(b, b));
+        }
+        
+        double lanes[2];
+        _mm_storeu_pd(lanes, _mm_min_pd(min0, min1));
+        partial->min = lanes[0] < lanes[1] ? lanes[0] : lanes[1];
+        _mm_storeu_pd(lanes, _mm_max_pd(max0, max1));
+        partial->max = lanes[0] > lanes[1] ? lanes[0] : lanes[1];
+        
+        kahan_fold_pd(&partial->sum, &partial->sum_comp, sum0, sum_comp0);
+        kahan_fold_pd(&partial->sum, &partial->sum_comp, sum1, sum_comp1);
+        kahan_fold_pd(&partial->shifted, &partial->shifted_comp, sh0, sh_comp0);
+        kahan_fold_pd(&partial->shifted, &partial->shifted_comp, sh1, sh_comp1);
+        kahan_fold_pd(&partial->squares, &partial->squares_comp, sq0, sq_comp0);
+        kahan_fold_pd(&partial->squares, &partial->squares_comp, sq1, sq_comp1);
+    }
+#endif
+    
+    for (; i < count; i++) {
+        double value = values[i];
+        if (value < partial->min) {
+            partial->min = value;
+        }
+        if (value > partial->max) {
+            partial->max = value;
+        }
+        
+        double shifted = value - shift;
+        kahan_add(&partial->sum, &partial->sum_comp, value);
+        kahan_add(&partial->shifted, &partial->shifted_comp, shifted);
+        kahan_add(&partial->squares, &partial->squares_comp, shifted * shifted);
+    }
+    
+    partial->count += count;
+}
+
+// Widen values[begin, begin + count) of a float or int64 column to double
+static void column_load(const void* values, column_type type, size_t begin, size_t count, double* out) {
+    if (type == COLUMN_F32) {
+        const float* column = (const float*)values + begin;
+        for (size_t i = 0; i < count; i++) {
+            out[i] = column[i];
+        }
+    } else {
+        const int64_t* column = (const int64_t*)values + begin;
+        for (size_t i = 0; i < count; i++) {
+            out[i] = (double)column[i];
+        }
+    }
+}
+
+static double column_value(const void* values, column_type type, size_t index) {
+    switch (type) {
+        case COLUMN_F32:
+            return ((const float*)values)[index];
+        case COLUMN_I64:
+            return (double)((const int64_t*)values)[index];
+        default:
+            return ((const double*)values)[index];
+    }
+}
+
+static void column_task_run(void* arg) {
+    column_task* task = (column_task*)arg;
+    column_partial_init(&task->partial);
+    
+    if (task->type == COLUMN_F64) {
+        column_kernel_f64((const double*)task->values + task->begin, task->end - task->begin,
+                          task->shift, &task->partial);
+        return;
+    }
+    
+    double block[COLUMN_BLOCK];
+    for (size_t i = task->begin; i < task->end; i += COLUMN_BLOCK) {
+        size_t count = task->end - i < COLUMN_BLOCK ? task->end - i : COLUMN_BLOCK;
+        column_load(task->values, task->type, i, count, block);
+        column_kernel_f64(block, count, task->shift, &task->partial);
+    }
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Move the k-th smallest value to values[k], smaller ones before it and larger ones after
+static double select_kth(double* values, size_t count, size_t k) {
+    size_t low = 0;
+    size_t high = count - 1;
+    
+    while (low < high) {
+        // Median of three as pivot
+        size_t mid = low + (high - low) / 2;
+        double a = values[low], b = values[mid], c = values[high];
+        double pivot = (a < b) ? ((b < c) ? b : ((a < c) ? c : a)) : ((a < c) ? a : ((b < c) ? c : b));
+        
+        size_t i = low;
+        size_t j = high;
+        while (i <= j) {
+            while (values[i] < pivot) {
+                i++;
+            }
+            while (values[j] > pivot) {
+                j--;
+            }
+            if (i <= j) {
+                double swap = values[i];
+                values[i] = values[j];
+                values[j] = swap;
+                i++;
+                if (j == 0) {
+                    break;
+                }
+                j--;
+            }
+        }
+        
+        if (k <= j) {
+            high = j;
+        } else if (k >= i) {
+            low = i;
+        } else {
+            break;
+        }
+    }
+    
+    return values[k];
+}
+
+static bool column_percentiles(const void* values, column_type type, size_t count,
+                               const nlink_column_summary_config* config,
+                               const nlink_column_summary* summary) {
+    double* copy = malloc(count * sizeof(double));
+    if (copy == NULL) {
+        return false;
+    }
+    
+    if (type == COLUMN_F64) {
+        memcpy(copy, values, count * sizeof(double));
+    } else {
+        column_load(values, type, 0, count, copy);
+    }
+    
+    // Many percentiles amortize a full sort; a few are cheaper to select
+    bool sorted = config->percentile_count > COLUMN_SORT_PERCENTILES;
+    if (sorted) {
+        qsort(copy, count, sizeof(double), compare_doubles);
+    }
+    
+    // Visit percentiles in ascending order so each selection only searches above the last rank
+    size_t order[COLUMN_SORT_PERCENTILES];
+    for (size_t p = 0; !sorted && p < config->percentile_count; p++) {
+        size_t q = p;
+        while (q > 0 && config->percentiles[order[q - 1]] > config->percentiles[p]) {
+            order[q] = order[q - 1];
+            q--;
+        }
+        order[q] = p;
+    }
+    
+    size_t base = 0;
+    for (size_t i = 0; i < config->percentile_count; i++) {
+        size_t p = sorted ? i : order[i];
+        double position = config->percentiles[p] / 100.0 * (double)(count - 1);
+        size_t rank = (size_t)position;
+        double fraction = position - (double)rank;
+        
+        double low;
+        double high;
+        if (rank == count - 1) {
+            // The extremes are already known from the summary pass
+            low = summary->max;
+            high = low;
+        } else if (rank == 0 && fraction == 0.0) {
+            low = summary->min;
+            high = low;
+        } else if (sorted) {
+            low = copy[rank];
+            high = rank + 1 < count ? copy[rank + 1] : low;
+        } else {
+            // Values before base are no larger than any later rank
+            low = select_kth(copy + base, count - base, rank - base);
+            base = rank;
+            
+            // Everything after rank is at least low; the next rank is their minimum
+            high = low;
+            if (rank + 1 < count && fraction > 0.0) {
+                high = copy[rank + 1];
+                for (size_t j = rank + 2; j < count; j++) {
+                    if (copy[j] < high) {
+                        high = copy[j];
+                    }
+                }
+            }
+        }
+        
+        config->percentile_values[p] = low + fraction * (high - low);
+    }
+    
+    free(copy);
+    return true;
+}
+
+static bool summarize_column(const void* values, column_type type, size_t count,
+                             const nlink_column_summary_config* config,
+                             nlink_column_summary* summary) {
+    if (values == NULL || count == 0 || summary == NULL) {
+        return false;
+    }
+    
+    if (config != NULL && config->percentile_count > 0) {
+        if (config->percentiles == NULL || config->percentile_values == NULL) {
+            return false;
+        }
+        for (size_t p = 0; p < config->percentile_count; p++) {
+            if (!(config->percentiles[p] >= 0.0 && config->percentiles[p] <= 100.0)) {
+                return false;
+            }
+        }
+    }
+    
+    // Split into pool tasks only when there are at least two thresholds' worth of values
+    size_t threshold = COLUMN_PARALLEL_THRESHOLD;
+    if (config != NULL && config->parallel_threshold > 0) {
+        threshold = config->parallel_threshold;
+    }
+    
+    nlink_thread_pool_t* pool = count / threshold >= 2 ? nlink_thread_pool_shared() : NULL;
+    size_t task_count = 1;
+    if (pool != NULL) {
+        size_t max_tasks = nlink_thread_pool_worker_count(pool) * COLUMN_TASKS_PER_WORKER;
+        task_count = count / threshold;
+        if (task_count > max_tasks) {
+            task_count = max_tasks > 1 ? max_tasks : 2;
+        }
+    }
+    
+    column_task single;
+    column_task* tasks = task_count > 1 ? malloc(task_count * sizeof(column_task)) : &single;
+    if (tasks == NULL) {
+        tasks = &single;
+        task_count = 1;
+    }
+    
+    double shift = column_value(values, type, 0);
+    for (size_t t = 0; t < task_count; t++) {
+        tasks[t].values = values;
+        tasks[t].type = type;
+        tasks[t].begin = count * t / task_count;
+        tasks[t].end = count * (t + 1) / task_count;
+        tasks[t].shift = shift;
+    }
+    
+    if (task_count > 1) {
+        nlink_task_group_t group;
+        nlink_task_group_init(&group);
+        for (size_t t = 0; t < task_count; t++) {
+            nlink_thread_pool_submit(pool, column_task_run, &tasks[t], &group);
+        }
+        nlink_thread_pool_wait(pool, &group);
+    } else {
+        column_task_run(&tasks[0]);
+    }
+    
+    // Merge partials in range order
+    column_partial total;
+    column_partial_init(&total);
+    for (size_t t = 0; t < task_count; t++) {
+        const column_partial* partial = &tasks[t].partial;
+        if (partial->min < total.min) {
+            total.min = partial->min;
+        }
+        if (partial->max > total.max) {
+            total.max = partial->max;
+        }
+        kahan_add(&total.sum, &total.sum_comp, partial->sum - partial->sum_comp);
+        kahan_add(&total.shifted, &total.shifted_comp, partial->shifted - partial->shifted_comp);
+        kahan_add(&total.squares, &total.squares_comp, partial->squares - partial->squares_comp);
+        total.count += partial->count;
+    }
+    
+    if (tasks != &single) {
+        free(tasks);
+    }
+    
+    double n = (double)count;
+    double sum = total.sum - total.sum_comp;
+    double shifted_sum = total.shifted - total.shifted_comp;
+    double shifted_squares = total.squares - total.squares_comp;
+    
+    summary->count = count;
+    summary->min = total.min;
+    summary->max = total.max;
+    summary->sum = sum;
+    summary->mean = sum / n;
+    
+    // Sum of squared deviations about the mean, from the shifted moments
+    double deviations = shifted_squares - shifted_sum * shifted_sum / n;
+    if (deviations < 0.0) {
+        deviations = 0.0;
+    }
+    bool sample = config != NULL && config->sample_variance;
+    summary->variance = sample ? (count > 1 ? deviations / (n - 1.0) : 0.0) : deviations / n;
+    
+    if (config != NULL && config->percentile_count > 0) {
+        return column_percentiles(values, type, count, config, summary);
+    }
+    
+    return true;
+}
+
+bool nlink_summarize_column_f64(const double* values, size_t count,
+                                const nlink_column_summary_config* config,
+                                nlink_column_summary* summary) {
+    return summarize_column(values, COLUMN_F64, count, config, summary);
+}
+
+bool nlink_summarize_column_f32(const float* values, size_t count,
+                                const nlink_column_summary_config* config,
+                                nlink_column_summary* summary) {
+    return summarize_column(values, COLUMN_F32, count, config, summary);
+}
+
+bool nlink_summarize_column_i64(const int64_t* values, size_t count,
+                                const nlink_column_summary_config* config,
+                                nlink_column_summary* summary) {
+    return summarize_column(values, COLUMN_I64, count, config, summary);
 }
\ No newline at end of file
@@ -5,11 +5,18 @@
  */
 
 #include "nlink/core/tactic/transformation.h"
+#include "nlink/core/tactic/aggregation.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <float.h>
 #include <math.h>
+#include <stdatomic.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define NORMALIZE_SIMD_SSE2 1
+#endif
 
 nlink_transform_config* nlink_transform_config_create(nlink_transformer_fn transform_fn, 
                                                     void* context) {
@@ -148,6 +155,104 @@ void** nlink_transform_array(void** items, size_t count,
     return result;
 }
 
+typedef struct transform_job {
+    void** items;
+    void** output;
+    nlink_transform_config* config;
+    atomic_bool failed;
+} transform_job;
+
+static void transform_range(size_t chunk, size_t begin, size_t end, void* context) {
+    transform_job* job = (transform_job*)context;
+    nlink_transform_config* config = job->config;
+    (void)chunk;
+    
+    size_t i = begin;
+    for (; i < end; i++) {
+        if (config->abort_on_error && atomic_load_explicit(&job->failed, memory_order_relaxed)) {
+            break;
+        }
+        
+        void* item = job->items[i];
+        void* result = item;
+        if (config->condition_fn == NULL || config->condition_fn(item, config->context)) {
+            result = config->transform_fn(item, config->context);
+            
+            // Handle transformation error
+            if (result == NULL && item != NULL) {
+                if (config->abort_on_error) {
+                    atomic_store_explicit(&job->failed, true, memory_order_relaxed);
+                    break;
+                }
+                result = item;
+            }
+        }
+        job->output[i] = result;
+    }
+    
+    // Slots a stopped chunk never reached keep their originals, so cleanup can tell results apart
+    for (; i < end; i++) {
+        job->output[i] = job->items[i];
+    }
+}
+
+// Free the originals that were replaced by a result
+static void transform_release_range(size_t chunk, size_t begin, size_t end, void* context) {
+    transform_job* job = (transform_job*)context;
+    (void)chunk;
+    
+    for (size_t i = begin; i < end; i++) {
+        if (job->output[i] != job->items[i]) {
+            free(job->items[i]);
+        }
+    }
+}
+
+void** nlink_transform_array_parallel(void** items, size_t count,
+                                      nlink_transform_config* config, void** output,
+                                      const nlink_parallel_config* parallel) {
+    if (items == NULL || count == 0 || config == NULL || config->transform_fn == NULL ||
+        count > SIZE_MAX / sizeof(void*)) {
+        return NULL;
+    }
+    
+    bool owned = false;
+    if (output == NULL) {
+        if (parallel != NULL && parallel->arena != NULL) {
+            output = nlink_arena_alloc(parallel->arena, count * sizeof(void*));
+        } else {
+            output = malloc(count * sizeof(void*));
+            owned = true;
+        }
+        if (output == NULL) {
+            return NULL;
+        }
+    }
+    
+    transform_job job = { items, output, config, false };
+    nlink_parallel_for(count, transform_range, &job, parallel);
+    
+    if (atomic_load(&job.failed)) {
+        // Clean up as the serial path does and leave the originals in place
+        for (size_t i = 0; i < count; i++) {
+            if (!config->preserve_original && output[i] != items[i]) {
+                free(output[i]);
+            }
+        }
+        if (owned) {
+            free(output);
+        }
+        return NULL;
+    }
+    
+    // Clean up originals if not preserving
+    if (!config->preserve_original) {
+        nlink_parallel_for(count, transform_release_range, &job, parallel);
+    }
+    
+    return output;
+}
+
 void** nlink_transform_multi(void** data, nlink_transformer_fn* transforms, 
                             size_t count, void* context) {
     if (data == NULL || transforms == NULL || count == 0) {
@@ -197,17 +302,46 @@ double nlink_normalize(double value, double min, double max,
     return target_min + normalized * (target_max - target_min);
 }
 
-double* nlink_normalize_array(double* values, size_t count, 
-                             double target_min, double target_max) {
-    if (values == NULL || count == 0) {
-        return NULL;
-    }
-    
-    // Find min and max values
+/**
+ * Normalization kernels
+ *
+ * Every mode reduces to output = (value - base) * scale + target, with
+ * the constants derived once from the input's statistics.
+ */
+typedef struct {
+    double base;
+    double scale;
+    double target;
+} normalize_affine;
+
+static void normalize_min_max(const double* values, size_t count, double* min_out, double* max_out) {
     double min = DBL_MAX;
     double max = -DBL_MAX;
+    size_t i = 0;
     
-    for (size_t i = 0; i < count; i++) {
+#ifdef NORMALIZE_SIMD_SSE2
+    if (count >= 4) {
+        __m128d min0 = _mm_set1_pd(min), min1 = min0;
+        __m128d max0 = _mm_set1_pd(max), max1 = max0;
+        for (; i + 4 <= count; i += 4) {
+            __m128d a = _mm_loadu_pd(values + i);
+            __m128d b = _mm_loadu_pd(values + i + 2);
+            // The accumulator goes second so a NaN input is skipped, as below
+            min0 = _mm_min_pd(a, min0);
+            min1 = _mm_min_pd(b, min1);
+            max0 = _mm_max_pd(a, max0);
+            max1 = _mm_max_pd(b, max1);
+        }
+        
+        double lanes[2];
+        _mm_storeu_pd(lanes, _mm_min_pd(min0, min1));
+        min = lanes[0] < lanes[1] ? lanes[0] : lanes[1];
+        _mm_storeu_pd(lanes, _mm_max_pd(max0, max1));
+        max = lanes[0] > lanes[1] ? lanes[0] : lanes[1];
+    }
+#endif
+    
+    for (; i < count; i++) {
         if (values[i] < min) {
             min = values[i];
         }
@@ -216,37 +350,200 @@ double* nlink_normalize_array(double* values, size_t count,
         }
     }
     
-    // Check if range is valid
+    *min_out = min;
+    *max_out = max;
+}
+
+static normalize_affine normalize_min_max_affine(double min, double max,
+                                                 double target_min, double target_max) {
+    normalize_affine affine;
+    affine.base = min;
+    
     if (min >= max) {
-        // All values are the same, return array of mid-point in target range
-        double* result = malloc(count * sizeof(double));
-        if (result == NULL) {
-            return NULL;
-        }
-        
-        double mid = (target_min + target_max) / 2.0;
-        for (size_t i = 0; i < count; i++) {
-            result[i] = mid;
+        // All values are the same: map them to the mid-point of the target range
+        affine.scale = 0.0;
+        affine.target = (target_min + target_max) / 2.0;
+        return affine;
+    }
+    
+    // Default target range is [0, 1]
+    if (target_min == target_max) {
+        target_min = 0.0;
+        target_max = 1.0;
+    }
+    
+    affine.scale = (target_max - target_min) / (max - min);
+    affine.target = target_min;
+    return affine;
+}
+
+static inline void normalize_kahan_add(double* sum, double* comp, double value) {
+    double y = value - *comp;
+    double t = *sum + y;
+    *comp = (t - *sum) - y;
+    *sum = t;
+}
+
+static normalize_affine normalize_z_score_affine(double mean, double variance) {
+    normalize_affine affine;
+    double deviation = sqrt(variance);
+    
+    affine.base = mean;
+    affine.scale = deviation > 0.0 ? 1.0 / deviation : 0.0;
+    affine.target = 0.0;
+    return affine;
+}
+
+static void normalize_apply(const double* values, double* output, size_t count, normalize_affine affine) {
+    size_t i = 0;
+    
+    // A constant input fills the output outright, NaN entries included
+    if (affine.scale == 0.0) {
+        for (; i < count; i++) {
+            output[i] = affine.target;
         }
-        
-        return result;
+        return;
+    }
+    
+#ifdef NORMALIZE_SIMD_SSE2
+    __m128d base = _mm_set1_pd(affine.base);
+    __m128d scale = _mm_set1_pd(affine.scale);
+    __m128d target = _mm_set1_pd(affine.target);
+    for (; i + 4 <= count; i += 4) {
+        __m128d a = _mm_loadu_pd(values + i);
+        __m128d b = _mm_loadu_pd(values + i + 2);
+        a = _mm_add_pd(_mm_mul_pd(_mm_sub_pd(a, base), scale), target);
+        b = _mm_add_pd(_mm_mul_pd(_mm_sub_pd(b, base), scale), target);
+        _mm_storeu_pd(output + i, a);
+        _mm_storeu_pd(output + i + 2, b);
+    }
+#endif
+    
+    for (; i < count; i++) {
+        output[i] = (values[i] - affine.base) * affine.scale + affine.target;
+    }
+}
+
+double* nlink_normalize_array(double* values, size_t count, 
+                             double target_min, double target_max) {
+    if (values == NULL || count == 0) {
+        return NULL;
     }
     
-    // Normal case: normalize each value
     double* result = malloc(count * sizeof(double));
     if (result == NULL) {
         return NULL;
     }
     
-    // Default target range is [0, 1]
-    if (target_min == target_max) {
-        target_min = 0.0;
-        target_max = 1.0;
+    nlink_normalize_into(values, result, count, NLINK_NORMALIZE_MIN_MAX, target_min, target_max);
+    return result;
+}
+
+bool nlink_normalize_into(const double* values, double* output, size_t count,
+                          nlink_normalize_mode mode, double target_min, double target_max) {
+    if (values == NULL || output == NULL || count == 0) {
+        return false;
     }
     
-    for (size_t i = 0; i < count; i++) {
-        result[i] = nlink_normalize(values[i], min, max, target_min, target_max);
+    normalize_affine affine;
+    if (mode == NLINK_NORMALIZE_Z_SCORE) {
+        // Compensated, shifted sums keep the variance accurate far from zero
+        nlink_column_summary summary;
+        nlink_column_summary_config config = { NULL, NULL, 0, false, 0 };
+        if (!nlink_summarize_column_f64(values, count, &config, &summary)) {
+            return false;
+        }
+        affine = normalize_z_score_affine(summary.mean, summary.variance);
+    } else {
+        double min;
+        double max;
+        normalize_min_max(values, count, &min, &max);
+        affine = normalize_min_max_affine(min, max, target_min, target_max);
     }
     
-    return result;
+    normalize_apply(values, output, count, affine);
+    return true;
+}
+
+bool nlink_normalize_matrix(const double* data, double* output, size_t rows, size_t columns,
+                            nlink_normalize_mode mode, double target_min, double target_max) {
+    if (data == NULL || output == NULL || rows == 0 || columns == 0 || rows > SIZE_MAX / columns) {
+        return false;
+    }
+    
+    // Per-column affine constants and statistics in one allocation
+    double* stats = malloc(columns * 9 * sizeof(double));
+    if (stats == NULL) {
+        return false;
+    }
+    double* base = stats;
+    double* scale = stats + columns;
+    double* target = stats + columns * 2;
+    double* moments = stats + columns * 3;
+    
+    // Columns are independent, so each row's loop vectorizes across columns
+    if (mode == NLINK_NORMALIZE_Z_SCORE) {
+        // Compensated sums as nlink_summarize_column_f64 keeps them, shifted
+        // by the first row so data far from zero does not cancel
+        double* sum = moments;
+        double* sum_comp = moments + columns;
+        double* shifted = moments + columns * 2;
+        double* shifted_comp = moments + columns * 3;
+        double* squares = moments + columns * 4;
+        double* squares_comp = moments + columns * 5;
+        memcpy(base, data, columns * sizeof(double));
+        memset(moments, 0, columns * 6 * sizeof(double));
+        for (size_t r = 0; r < rows; r++) {
+            const double* row = data + r * columns;
+            for (size_t c = 0; c < columns; c++) {
+                double delta = row[c] - base[c];
+                normalize_kahan_add(&sum[c], &sum_comp[c], row[c]);
+                normalize_kahan_add(&shifted[c], &shifted_comp[c], delta);
+                normalize_kahan_add(&squares[c], &squares_comp[c], delta * delta);
+            }
+        }
+        double n = (double)rows;
+        for (size_t c = 0; c < columns; c++) {
+            double shifted_sum = shifted[c] - shifted_comp[c];
+            double deviations = (squares[c] - squares_comp[c]) - shifted_sum * shifted_sum / n;
+            normalize_affine affine = normalize_z_score_affine((sum[c] - sum_comp[c]) / n,
+                                                               deviations > 0.0 ? deviations / n : 0.0);
+            base[c] = affine.base;
+            scale[c] = affine.scale;
+            target[c] = affine.target;
+        }
+    } else {
+        // Seeded as in normalize_min_max, so a NaN entry never becomes a bound
+        double* low = moments;
+        double* high = moments + columns;
+        for (size_t c = 0; c < columns; c++) {
+            low[c] = DBL_MAX;
+            high[c] = -DBL_MAX;
+        }
+        for (size_t r = 0; r < rows; r++) {
+            const double* row = data + r * columns;
+            for (size_t c = 0; c < columns; c++) {
+                low[c] = row[c] < low[c] ? row[c] : low[c];
+                high[c] = row[c] > high[c] ? row[c] : high[c];
+            }
+        }
+        for (size_t c = 0; c < columns; c++) {
+            normalize_affine affine = normalize_min_max_affine(low[c], high[c], target_min, target_max);
+            base[c] = affine.base;
+            scale[c] = affine.scale;
+            target[c] = affine.target;
+        }
+    }
+    
+    // A constant column fills its output outright, as in normalize_apply
+    for (size_t r = 0; r < rows; r++) {
+        const double* row = data + r * columns;
+        double* out = output + r * columns;
+        for (size_t c = 0; c < columns; c++) {
+            out[c] = scale[c] == 0.0 ? target[c] : (row[c] - base[c]) * scale[c] + target[c];
+        }
+    }
+    
+    free(stats);
+    return true;
 }
\ No newline at end of file
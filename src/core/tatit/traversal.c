@@ -5,264 +5,246 @@
  */
 
 #include "nlink/core/tactic/traversal.h"
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
 
 /**
- * Queue implementation for breadth-first traversal
+ * Workspace stack and queue
+ *
+ * Depth-first orders use frames[0..count) as a stack; level order pops
+ * from head. Growth doubles the array, so a reused workspace stops
+ * allocating once it has held the largest frontier.
  */
-typedef struct node_queue_item {
-    void* node;
-    struct node_queue_item* next;
-} node_queue_item;
-
-typedef struct node_queue {
-    node_queue_item* head;
-    node_queue_item* tail;
-    size_t size;
-} node_queue;
-
-static node_queue* queue_create() {
-    node_queue* queue = malloc(sizeof(node_queue));
-    if (queue == NULL) {
-        return NULL;
+#define WORKSPACE_MIN_CAPACITY 64
+
+bool nlink_traversal_workspace_init(nlink_traversal_workspace* workspace, size_t capacity) {
+    if (workspace == NULL) {
+        return false;
     }
     
-    queue->head = NULL;
-    queue->tail = NULL;
-    queue->size = 0;
+    workspace->frames = NULL;
+    workspace->head = 0;
+    workspace->count = 0;
+    workspace->capacity = 0;
     
-    return queue;
-}
-
-static void queue_free(node_queue* queue) {
-    if (queue == NULL) {
-        return;
+    if (capacity == 0) {
+        return true;
     }
     
-    // Free all items
-    node_queue_item* item = queue->head;
-    while (item != NULL) {
-        node_queue_item* next = item->next;
-        free(item);
-        item = next;
+    workspace->frames = malloc(capacity * sizeof(nlink_traversal_frame));
+    if (workspace->frames == NULL) {
+        return false;
     }
+    workspace->capacity = capacity;
     
-    free(queue);
+    return true;
 }
 
-static bool queue_enqueue(node_queue* queue, void* node) {
-    if (queue == NULL) {
-        return false;
-    }
-    
-    node_queue_item* item = malloc(sizeof(node_queue_item));
-    if (item == NULL) {
-        return false;
+void nlink_traversal_workspace_free(nlink_traversal_workspace* workspace) {
+    if (workspace == NULL) {
+        return;
     }
     
-    item->node = node;
-    item->next = NULL;
-    
-    if (queue->tail == NULL) {
-        // Empty queue
-        queue->head = item;
-        queue->tail = item;
-    } else {
-        // Add to end
-        queue->tail->next = item;
-        queue->tail = item;
+    free(workspace->frames);
+    workspace->frames = NULL;
+    workspace->head = 0;
+    workspace->count = 0;
+    workspace->capacity = 0;
+}
+
+static bool workspace_push(nlink_traversal_workspace* workspace, void* node) {
+    if (workspace->count == workspace->capacity) {
+        // Slide a queue back over its consumed half rather than growing
+        if (workspace->head > 0 && workspace->head >= workspace->count / 2) {
+            workspace->count -= workspace->head;
+            memmove(workspace->frames, workspace->frames + workspace->head,
+                    workspace->count * sizeof(nlink_traversal_frame));
+            workspace->head = 0;
+        } else {
+            size_t capacity = workspace->capacity ? workspace->capacity * 2 : WORKSPACE_MIN_CAPACITY;
+            nlink_traversal_frame* frames = realloc(workspace->frames, capacity * sizeof(nlink_traversal_frame));
+            if (frames == NULL) {
+                return false;
+            }
+            workspace->frames = frames;
+            workspace->capacity = capacity;
+        }
     }
     
-    queue->size++;
+    workspace->frames[workspace->count].node = node;
+    workspace->frames[workspace->count].next_child = 0;
+    workspace->count++;
     
     return true;
 }
 
-static void* queue_dequeue(node_queue* queue) {
-    if (queue == NULL || queue->head == NULL) {
+/**
+ * Node-to-position map: open addressing with linear probing, keyed by
+ * node pointer. Graph traversals also use it as their visited set, with
+ * INDEX_PENDING marking nodes that are queued but not yet visited.
+ */
+#define INDEX_PENDING ((size_t)-1)
+#define INDEX_MIN_CAPACITY 16
+
+struct nlink_traversal_index {
+    void** keys;
+    size_t* values;
+    size_t capacity;   // Power of two
+    size_t count;
+};
+
+static size_t index_hash(const void* node, size_t mask) {
+    // Fibonacci hashing; the low bits of an aligned pointer carry no information
+    uint64_t key = (uint64_t)(uintptr_t)node;
+    key ^= key >> 4;
+    return (size_t)((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+}
+
+static nlink_traversal_index* index_create(size_t expected) {
+    nlink_traversal_index* index = malloc(sizeof(nlink_traversal_index));
+    if (index == NULL) {
         return NULL;
     }
     
-    node_queue_item* item = queue->head;
-    void* node = item->node;
-    
-    queue->head = item->next;
-    if (queue->head == NULL) {
-        queue->tail = NULL;
+    size_t capacity = INDEX_MIN_CAPACITY;
+    while (capacity < expected * 2) {
+        capacity <<= 1;
     }
     
-    free(item);
-    queue->size--;
-    
-    return node;
-}
-
-static bool queue_is_empty(node_queue* queue) {
-    return queue == NULL || queue->head == NULL;
-}
-
-/**
- * Stack implementation for depth-first traversal
- */
-typedef struct node_stack_item {
-    void* node;
-    struct node_stack_item* next;
-} node_stack_item;
-
-typedef struct node_stack {
-    node_stack_item* top;
-    size_t size;
-} node_stack;
-
-static node_stack* stack_create() {
-    node_stack* stack = malloc(sizeof(node_stack));
-    if (stack == NULL) {
+    index->keys = calloc(capacity, sizeof(void*));
+    index->values = malloc(capacity * sizeof(size_t));
+    if (index->keys == NULL || index->values == NULL) {
+        free(index->keys);
+        free(index->values);
+        free(index);
         return NULL;
     }
     
-    stack->top = NULL;
-    stack->size = 0;
+    index->capacity = capacity;
+    index->count = 0;
     
-    return stack;
+    return index;
 }
 
-static void stack_free(node_stack* stack) {
-    if (stack == NULL) {
+static void index_free(nlink_traversal_index* index) {
+    if (index == NULL) {
         return;
     }
     
-    // Free all items
-    node_stack_item* item = stack->top;
-    while (item != NULL) {
-        node_stack_item* next = item->next;
-        free(item);
-        item = next;
-    }
-    
-    free(stack);
+    free(index->keys);
+    free(index->values);
+    free(index);
 }
 
-static bool stack_push(node_stack* stack, void* node) {
-    if (stack == NULL) {
+static bool index_grow(nlink_traversal_index* index) {
+    size_t capacity = index->capacity * 2;
+    void** keys = calloc(capacity, sizeof(void*));
+    size_t* values = malloc(capacity * sizeof(size_t));
+    if (keys == NULL || values == NULL) {
+        free(keys);
+        free(values);
         return false;
     }
     
-    node_stack_item* item = malloc(sizeof(node_stack_item));
-    if (item == NULL) {
-        return false;
+    for (size_t i = 0; i < index->capacity; i++) {
+        if (index->keys[i] == NULL) {
+            continue;
+        }
+        size_t slot = index_hash(index->keys[i], capacity - 1);
+        while (keys[slot] != NULL) {
+            slot = (slot + 1) & (capacity - 1);
+        }
+        keys[slot] = index->keys[i];
+        values[slot] = index->values[i];
     }
     
-    item->node = node;
-    item->next = stack->top;
-    stack->top = item;
-    stack->size++;
+    free(index->keys);
+    free(index->values);
+    index->keys = keys;
+    index->values = values;
+    index->capacity = capacity;
     
     return true;
 }
 
-static void* stack_pop(node_stack* stack) {
-    if (stack == NULL || stack->top == NULL) {
+static size_t* index_find(const nlink_traversal_index* index, const void* node) {
+    if (index == NULL || node == NULL) {
         return NULL;
     }
     
-    node_stack_item* item = stack->top;
-    void* node = item->node;
-    
-    stack->top = item->next;
-    free(item);
-    stack->size--;
+    size_t mask = index->capacity - 1;
+    for (size_t slot = index_hash(node, mask); index->keys[slot] != NULL; slot = (slot + 1) & mask) {
+        if (index->keys[slot] == node) {
+            return &index->values[slot];
+        }
+    }
     
-    return node;
-}
-
-static bool stack_is_empty(node_stack* stack) {
-    return stack == NULL || stack->top == NULL;
+    return NULL;
 }
 
 /**
- * Visited node tracking
+ * Find a node's entry, adding it with the given value if absent.
+ * Sets *added when the node was new; returns NULL if out of memory.
  */
-typedef struct {
-    void** nodes;
-    size_t count;
-    size_t capacity;
-} visited_set;
-
-static visited_set* visited_set_create(size_t initial_capacity) {
-    visited_set* set = malloc(sizeof(visited_set));
-    if (set == NULL) {
+static size_t* index_insert(nlink_traversal_index* index, void* node, size_t value, bool* added) {
+    *added = false;
+    
+    // Keep the load factor at or below one half so probes stay short
+    if ((index->count + 1) * 2 > index->capacity && !index_grow(index)) {
         return NULL;
     }
     
-    set->nodes = malloc(initial_capacity * sizeof(void*));
-    if (set->nodes == NULL) {
-        free(set);
-        return NULL;
+    size_t mask = index->capacity - 1;
+    size_t slot = index_hash(node, mask);
+    while (index->keys[slot] != NULL) {
+        if (index->keys[slot] == node) {
+            return &index->values[slot];
+        }
+        slot = (slot + 1) & mask;
     }
     
-    set->count = 0;
-    set->capacity = initial_capacity;
+    index->keys[slot] = node;
+    index->values[slot] = value;
+    index->count++;
+    *added = true;
     
-    return set;
+    return &index->values[slot];
 }
 
-static void visited_set_free(visited_set* set) {
-    if (set == NULL) {
-        return;
-    }
-    
-    free(set->nodes);
-    free(set);
-}
+/**
+ * Visited set for nodes with dense integer IDs
+ */
+typedef struct {
+    uint64_t* words;
+    size_t id_count;
+} visited_bitset;
 
-static bool visited_set_contains(visited_set* set, void* node) {
-    if (set == NULL || node == NULL) {
-        return false;
-    }
-    
-    for (size_t i = 0; i < set->count; i++) {
-        if (set->nodes[i] == node) {
-            return true;
-        }
-    }
-    
-    return false;
+static bool visited_bitset_init(visited_bitset* set, size_t id_count) {
+    set->words = calloc((id_count + 63) / 64 ? (id_count + 63) / 64 : 1, sizeof(uint64_t));
+    set->id_count = id_count;
+    return set->words != NULL;
 }
 
-static bool visited_set_add(visited_set* set, void* node) {
-    if (set == NULL || node == NULL) {
+// Returns false if the ID was already set
+static bool visited_bitset_add(visited_bitset* set, size_t id) {
+    uint64_t bit = (uint64_t)1 << (id & 63);
+    uint64_t* word = &set->words[id >> 6];
+    if (*word & bit) {
         return false;
     }
-    
-    // Check if already in set
-    if (visited_set_contains(set, node)) {
-        return true;
-    }
-    
-    // Check if need to resize
-    if (set->count >= set->capacity) {
-        size_t new_capacity = set->capacity * 2;
-        void** new_nodes = realloc(set->nodes, new_capacity * sizeof(void*));
-        if (new_nodes == NULL) {
-            return false;
-        }
-        
-        set->nodes = new_nodes;
-        set->capacity = new_capacity;
-    }
-    
-    // Add to set
-    set->nodes[set->count++] = node;
-    
+    *word |= bit;
     return true;
 }
 
 /**
  * Traversal result implementation
+ *
+ * Graph traversals create the index up front and maintain it as they go;
+ * tree traversals leave it NULL and it is built on the first lookup.
  */
-static nlink_traversal_result* traversal_result_create(size_t initial_capacity) {
+static nlink_traversal_result* traversal_result_create(size_t initial_capacity, bool indexed) {
     nlink_traversal_result* result = malloc(sizeof(nlink_traversal_result));
     if (result == NULL) {
         return NULL;
@@ -270,10 +252,12 @@ static nlink_traversal_result* traversal_result_create(size_t initial_capacity)
     
     result->nodes = malloc(initial_capacity * sizeof(void*));
     result->results = malloc(initial_capacity * sizeof(void*));
+    result->index = indexed ? index_create(initial_capacity) : NULL;
     
-    if (result->nodes == NULL || result->results == NULL) {
+    if (result->nodes == NULL || result->results == NULL || (indexed && result->index == NULL)) {
         free(result->nodes);
         free(result->results);
+        index_free(result->index);
         free(result);
         return NULL;
     }
@@ -293,19 +277,31 @@ static bool traversal_result_add(nlink_traversal_result* result, void* node, voi
     if (result->count >= result->capacity) {
         size_t new_capacity = result->capacity * 2;
         void** new_nodes = realloc(result->nodes, new_capacity * sizeof(void*));
-        void** new_results = realloc(result->results, new_capacity * sizeof(void*));
-        
-        if (new_nodes == NULL || new_results == NULL) {
-            free(new_nodes);  // May be NULL, free handles that
-            free(new_results);
+        if (new_nodes == NULL) {
             return false;
         }
-        
         result->nodes = new_nodes;
+        
+        void** new_results = realloc(result->results, new_capacity * sizeof(void*));
+        if (new_results == NULL) {
+            return false;
+        }
         result->results = new_results;
         result->capacity = new_capacity;
     }
     
+    // Index the first visit; graph traversals pre-register nodes as pending
+    if (node != NULL && result->index != NULL) {
+        bool added;
+        size_t* position = index_insert(result->index, node, result->count, &added);
+        if (position == NULL) {
+            return false;
+        }
+        if (*position == INDEX_PENDING) {
+            *position = result->count;
+        }
+    }
+    
     // Add node and result
     result->nodes[result->count] = node;
     result->results[result->count] = value;
@@ -374,245 +370,172 @@ void nlink_traversal_result_free(nlink_traversal_result* result) {
     
     free(result->nodes);
     free(result->results);
+    index_free(result->index);
     free(result);
 }
 
+static bool should_visit(const nlink_traversal_config* config, void* node) {
+    return config->should_traverse == NULL || config->should_traverse(node, config->context);
+}
+
 /**
  * Pre-order traversal implementation
  */
-static nlink_traversal_result* traverse_pre_order(
+static nlink_traversal_status stream_pre_order(
     void* root,
-    nlink_traversal_config* config
+    const nlink_traversal_config* config,
+    nlink_traversal_workspace* workspace,
+    nlink_traversal_emit_fn emit,
+    void* emit_context
 ) {
-    if (root == NULL || config == NULL) {
-        return NULL;
-    }
-    
-    // Initialize result
-    nlink_traversal_result* result = traversal_result_create(16);
-    if (result == NULL) {
-        return NULL;
-    }
-    
-    // Initialize stack
-    node_stack* stack = stack_create();
-    if (stack == NULL) {
-        nlink_traversal_result_free(result);
-        return NULL;
+    if (!workspace_push(workspace, root)) {
+        return NLINK_TRAVERSAL_FAILED;
     }
     
-    // Push root node
-    stack_push(stack, root);
-    
-    // Traverse tree
-    while (!stack_is_empty(stack)) {
-        void* node = stack_pop(stack);
+    while (workspace->count > 0) {
+        void* node = workspace->frames[--workspace->count].node;
         
         // Check if we should traverse this node
-        if (config->should_traverse != NULL && !config->should_traverse(node, config->context)) {
+        if (!should_visit(config, node)) {
             continue;
         }
         
         // Visit node
         void* visit_result = config->visitor(node, config->context);
-        
-        // Collect result if requested
-        if (config->collect_results) {
-            if (!traversal_result_add(result, node, visit_result)) {
-                stack_free(stack);
-                nlink_traversal_result_free(result);
-                return NULL;
-            }
+        if (emit != NULL && !emit(node, visit_result, emit_context)) {
+            return NLINK_TRAVERSAL_STOPPED;
         }
         
         // Push children in reverse order (so they get processed in correct order)
         size_t child_count = config->get_child_count(node, config->context);
         for (size_t i = child_count; i > 0; i--) {
             void* child = config->get_child(node, i - 1, config->context);
-            if (child != NULL) {
-                stack_push(stack, child);
+            if (child != NULL && !workspace_push(workspace, child)) {
+                return NLINK_TRAVERSAL_FAILED;
             }
         }
     }
     
-    stack_free(stack);
-    return result;
+    return NLINK_TRAVERSAL_COMPLETE;
 }
 
 /**
  * Post-order traversal implementation
+ *
+ * Each frame remembers the next child to descend into; a node is visited
+ * when it has none left.
  */
-static nlink_traversal_result* traverse_post_order(
+static nlink_traversal_status stream_post_order(
     void* root,
-    nlink_traversal_config* config
+    const nlink_traversal_config* config,
+    nlink_traversal_workspace* workspace,
+    nlink_traversal_emit_fn emit,
+    void* emit_context
 ) {
-    if (root == NULL || config == NULL) {
-        return NULL;
-    }
-    
-    // Initialize result
-    nlink_traversal_result* result = traversal_result_create(16);
-    if (result == NULL) {
-        return NULL;
+    if (!should_visit(config, root)) {
+        return NLINK_TRAVERSAL_COMPLETE;
     }
-    
-    // We need two stacks for post-order traversal
-    node_stack* stack1 = stack_create();
-    node_stack* stack2 = stack_create();
-    
-    if (stack1 == NULL || stack2 == NULL) {
-        nlink_traversal_result_free(result);
-        stack_free(stack1);
-        stack_free(stack2);
-        return NULL;
+    if (!workspace_push(workspace, root)) {
+        return NLINK_TRAVERSAL_FAILED;
     }
     
-    // Push root node
-    stack_push(stack1, root);
-    
-    // Fill stack2 in post-order
-    while (!stack_is_empty(stack1)) {
-        void* node = stack_pop(stack1);
+    while (workspace->count > 0) {
+        nlink_traversal_frame* frame = &workspace->frames[workspace->count - 1];
+        size_t child_count = config->get_child_count(frame->node, config->context);
         
-        // Check if we should traverse this node
-        if (config->should_traverse != NULL && !config->should_traverse(node, config->context)) {
-            continue;
+        // Descend into the next child that should be traversed
+        void* child = NULL;
+        while (child == NULL && frame->next_child < child_count) {
+            child = config->get_child(frame->node, frame->next_child++, config->context);
+            if (child != NULL && !should_visit(config, child)) {
+                child = NULL;
+            }
         }
-        
-        stack_push(stack2, node);
-        
-        // Push children for processing
-        size_t child_count = config->get_child_count(node, config->context);
-        for (size_t i = 0; i < child_count; i++) {
-            void* child = config->get_child(node, i, config->context);
-            if (child != NULL) {
-                stack_push(stack1, child);
+        if (child != NULL) {
+            if (!workspace_push(workspace, child)) {
+                return NLINK_TRAVERSAL_FAILED;
             }
+            continue;
         }
-    }
-    
-    // Process nodes in post-order
-    while (!stack_is_empty(stack2)) {
-        void* node = stack_pop(stack2);
         
-        // Visit node
-        void* visit_result = config->visitor(node, config->context);
+        // All children done: visit node
+        void* node = frame->node;
+        workspace->count--;
         
-        // Collect result if requested
-        if (config->collect_results) {
-            if (!traversal_result_add(result, node, visit_result)) {
-                stack_free(stack1);
-                stack_free(stack2);
-                nlink_traversal_result_free(result);
-                return NULL;
-            }
+        void* visit_result = config->visitor(node, config->context);
+        if (emit != NULL && !emit(node, visit_result, emit_context)) {
+            return NLINK_TRAVERSAL_STOPPED;
         }
     }
     
-    stack_free(stack1);
-    stack_free(stack2);
-    return result;
+    return NLINK_TRAVERSAL_COMPLETE;
 }
 
 /**
  * Level-order (breadth-first) traversal implementation
  */
-static nlink_traversal_result* traverse_level_order(
+static nlink_traversal_status stream_level_order(
     void* root,
-    nlink_traversal_config* config
+    const nlink_traversal_config* config,
+    nlink_traversal_workspace* workspace,
+    nlink_traversal_emit_fn emit,
+    void* emit_context
 ) {
-    if (root == NULL || config == NULL) {
-        return NULL;
-    }
-    
-    // Initialize result
-    nlink_traversal_result* result = traversal_result_create(16);
-    if (result == NULL) {
-        return NULL;
+    if (!workspace_push(workspace, root)) {
+        return NLINK_TRAVERSAL_FAILED;
     }
     
-    // Initialize queue
-    node_queue* queue = queue_create();
-    if (queue == NULL) {
-        nlink_traversal_result_free(result);
-        return NULL;
-    }
-    
-    // Enqueue root node
-    queue_enqueue(queue, root);
-    
-    // Traverse tree
-    while (!queue_is_empty(queue)) {
-        void* node = queue_dequeue(queue);
+    while (workspace->head < workspace->count) {
+        void* node = workspace->frames[workspace->head++].node;
         
         // Check if we should traverse this node
-        if (config->should_traverse != NULL && !config->should_traverse(node, config->context)) {
+        if (!should_visit(config, node)) {
             continue;
         }
         
         // Visit node
         void* visit_result = config->visitor(node, config->context);
-        
-        // Collect result if requested
-        if (config->collect_results) {
-            if (!traversal_result_add(result, node, visit_result)) {
-                queue_free(queue);
-                nlink_traversal_result_free(result);
-                return NULL;
-            }
+        if (emit != NULL && !emit(node, visit_result, emit_context)) {
+            return NLINK_TRAVERSAL_STOPPED;
         }
         
         // Enqueue children
         size_t child_count = config->get_child_count(node, config->context);
         for (size_t i = 0; i < child_count; i++) {
             void* child = config->get_child(node, i, config->context);
-            if (child != NULL) {
-                queue_enqueue(queue, child);
+            if (child != NULL && !workspace_push(workspace, child)) {
+                return NLINK_TRAVERSAL_FAILED;
             }
         }
     }
     
-    queue_free(queue);
-    return result;
+    return NLINK_TRAVERSAL_COMPLETE;
 }
 
 /**
  * In-order traversal implementation (for binary trees)
  */
-static nlink_traversal_result* traverse_in_order(
+static nlink_traversal_status stream_in_order(
     void* root,
-    nlink_traversal_config* config
+    const nlink_traversal_config* config,
+    nlink_traversal_workspace* workspace,
+    nlink_traversal_emit_fn emit,
+    void* emit_context
 ) {
-    if (root == NULL || config == NULL) {
-        return NULL;
-    }
-    
-    // Initialize result
-    nlink_traversal_result* result = traversal_result_create(16);
-    if (result == NULL) {
-        return NULL;
-    }
-    
-    // Initialize stack
-    node_stack* stack = stack_create();
-    if (stack == NULL) {
-        nlink_traversal_result_free(result);
-        return NULL;
-    }
-    
-    // Traverse tree
     void* current = root;
     
-    while (current != NULL || !stack_is_empty(stack)) {
+    while (current != NULL || workspace->count > 0) {
         // Reach the leftmost node
         while (current != NULL) {
             // Check if we should traverse this node
-            if (config->should_traverse != NULL && !config->should_traverse(current, config->context)) {
+            if (!should_visit(config, current)) {
                 current = NULL;
                 break;
             }
             
-            stack_push(stack, current);
+            if (!workspace_push(workspace, current)) {
+                return NLINK_TRAVERSAL_FAILED;
+            }
             
             // For binary trees, we always expect left child at index 0
             if (config->get_child_count(current, config->context) > 0) {
@@ -622,22 +545,16 @@ static nlink_traversal_result* traverse_in_order(
             }
         }
         
-        if (stack_is_empty(stack)) {
+        if (workspace->count == 0) {
             break;
         }
         
-        current = stack_pop(stack);
+        current = workspace->frames[--workspace->count].node;
         
         // Visit node
         void* visit_result = config->visitor(current, config->context);
-        
-        // Collect result if requested
-        if (config->collect_results) {
-            if (!traversal_result_add(result, current, visit_result)) {
-                stack_free(stack);
-                nlink_traversal_result_free(result);
-                return NULL;
-            }
+        if (emit != NULL && !emit(current, visit_result, emit_context)) {
+            return NLINK_TRAVERSAL_STOPPED;
         }
         
         // Move to right child
@@ -649,33 +566,87 @@ static nlink_traversal_result* traverse_in_order(
         }
     }
     
-    stack_free(stack);
-    return result;
+    return NLINK_TRAVERSAL_COMPLETE;
 }
 
-nlink_traversal_result* nlink_traverse_tree(void* root, nlink_traversal_config* config) {
-    if (root == NULL || config == NULL) {
-        return NULL;
+nlink_traversal_status nlink_traverse_tree_stream(
+    void* root,
+    const nlink_traversal_config* config,
+    nlink_traversal_workspace* workspace,
+    nlink_traversal_emit_fn emit,
+    void* emit_context
+) {
+    if (root == NULL || config == NULL || config->visitor == NULL ||
+        config->get_child == NULL || config->get_child_count == NULL) {
+        return NLINK_TRAVERSAL_FAILED;
+    }
+    
+    nlink_traversal_workspace temporary;
+    if (workspace == NULL) {
+        nlink_traversal_workspace_init(&temporary, 0);
+        workspace = &temporary;
     }
+    workspace->head = 0;
+    workspace->count = 0;
     
     // Choose traversal implementation based on order
+    nlink_traversal_status status;
     switch (config->order) {
         case NLINK_TRAVERSAL_PRE_ORDER:
-            return traverse_pre_order(root, config);
+            status = stream_pre_order(root, config, workspace, emit, emit_context);
+            break;
             
         case NLINK_TRAVERSAL_POST_ORDER:
-            return traverse_post_order(root, config);
+            status = stream_post_order(root, config, workspace, emit, emit_context);
+            break;
             
         case NLINK_TRAVERSAL_LEVEL_ORDER:
-            return traverse_level_order(root, config);
+            status = stream_level_order(root, config, workspace, emit, emit_context);
+            break;
             
         case NLINK_TRAVERSAL_IN_ORDER:
-            return traverse_in_order(root, config);
+            status = stream_in_order(root, config, workspace, emit, emit_context);
+            break;
             
         default:
             // Invalid order
-            return NULL;
+            status = NLINK_TRAVERSAL_FAILED;
+            break;
+    }
+    
+    workspace->head = 0;
+    workspace->count = 0;
+    if (workspace == &temporary) {
+        nlink_traversal_workspace_free(&temporary);
     }
+    
+    return status;
+}
+
+// Emit callback that appends to a traversal result; stops only when out of memory
+static bool collect_result(void* node, void* result, void* context) {
+    return traversal_result_add((nlink_traversal_result*)context, node, result);
+}
+
+nlink_traversal_result* nlink_traverse_tree(void* root, nlink_traversal_config* config) {
+    if (root == NULL || config == NULL) {
+        return NULL;
+    }
+    
+    // Initialize result
+    nlink_traversal_result* result = traversal_result_create(16, false);
+    if (result == NULL) {
+        return NULL;
+    }
+    
+    nlink_traversal_status status = nlink_traverse_tree_stream(
+        root, config, NULL, config->collect_results ? collect_result : NULL, result);
+    if (status != NLINK_TRAVERSAL_COMPLETE) {
+        nlink_traversal_result_free(result);
+        return NULL;
+    }
+    
+    return result;
 }
 
 /**
@@ -858,12 +829,19 @@ nlink_traversal_result* nlink_traverse_linked_list(
 
 /**
  * Graph traversal
+ *
+ * Nodes are marked visited when they are first discovered, so each is
+ * queued and visited once. Without get_id the result's index doubles as
+ * the visited set; with it, a bitset over the IDs does.
  */
-nlink_traversal_result* nlink_traverse_graph_dfs(
+static nlink_traversal_result* traverse_graph(
     void* start,
     nlink_node_getter_fn get_adjacents,
     nlink_child_count_fn get_adjacent_count,
     nlink_visitor_fn visitor,
+    nlink_node_id_fn get_id,
+    size_t id_count,
+    bool breadth_first,
     void* context
 ) {
     if (start == NULL || get_adjacents == NULL || get_adjacent_count == NULL || visitor == NULL) {
@@ -871,57 +849,83 @@ nlink_traversal_result* nlink_traverse_graph_dfs(
     }
     
     // Initialize result
-    nlink_traversal_result* result = traversal_result_create(16);
+    nlink_traversal_result* result = traversal_result_create(16, true);
     if (result == NULL) {
         return NULL;
     }
     
-    // Initialize stack and visited set
-    node_stack* stack = stack_create();
-    visited_set* visited = visited_set_create(16);
+    nlink_traversal_workspace worklist;
+    nlink_traversal_workspace_init(&worklist, 0);
+    visited_bitset bitset = { NULL, 0 };
+    bool ok = get_id == NULL || visited_bitset_init(&bitset, id_count);
     
-    if (stack == NULL || visited == NULL) {
-        nlink_traversal_result_free(result);
-        stack_free(stack);
-        visited_set_free(visited);
-        return NULL;
+    // Mark and queue the start node
+    bool added = false;
+    if (ok && get_id != NULL) {
+        size_t id = get_id(start, context);
+        ok = id < id_count;
+        added = ok && visited_bitset_add(&bitset, id);
+    } else if (ok) {
+        ok = index_insert(result->index, start, INDEX_PENDING, &added) != NULL;
+    }
+    if (added) {
+        ok = workspace_push(&worklist, start);
     }
     
-    // Push start node
-    stack_push(stack, start);
-    visited_set_add(visited, start);
-    
-    // Traverse graph
-    while (!stack_is_empty(stack)) {
-        void* node = stack_pop(stack);
+    // Take the next node to visit and discover its neighbours
+    while (ok && worklist.head < worklist.count) {
+        void* node = breadth_first ? worklist.frames[worklist.head++].node : worklist.frames[--worklist.count].node;
         
         // Visit node
         void* visit_result = visitor(node, context);
-        
-        // Collect result
         if (!traversal_result_add(result, node, visit_result)) {
-            stack_free(stack);
-            visited_set_free(visited);
-            nlink_traversal_result_free(result);
-            return NULL;
+            ok = false;
+            break;
         }
         
-        // Push unvisited adjacent nodes
+        // Queue unvisited adjacent nodes
         size_t adjacent_count = get_adjacent_count(node, context);
-        for (size_t i = 0; i < adjacent_count; i++) {
+        for (size_t i = 0; ok && i < adjacent_count; i++) {
             void* adjacent = get_adjacents(node, i, context);
-            if (adjacent != NULL && !visited_set_contains(visited, adjacent)) {
-                stack_push(stack, adjacent);
-                visited_set_add(visited, adjacent);
+            if (adjacent == NULL) {
+                continue;
+            }
+            if (get_id != NULL) {
+                size_t id = get_id(adjacent, context);
+                ok = id < id_count;
+                if (ok && visited_bitset_add(&bitset, id)) {
+                    ok = workspace_push(&worklist, adjacent);
+                }
+            } else {
+                ok = index_insert(result->index, adjacent, INDEX_PENDING, &added) != NULL;
+                if (ok && added) {
+                    ok = workspace_push(&worklist, adjacent);
+                }
             }
         }
     }
     
-    stack_free(stack);
-    visited_set_free(visited);
+    nlink_traversal_workspace_free(&worklist);
+    free(bitset.words);
+    
+    if (!ok) {
+        nlink_traversal_result_free(result);
+        return NULL;
+    }
+    
     return result;
 }
 
+nlink_traversal_result* nlink_traverse_graph_dfs(
+    void* start,
+    nlink_node_getter_fn get_adjacents,
+    nlink_child_count_fn get_adjacent_count,
+    nlink_visitor_fn visitor,
+    void* context
+) {
+    return traverse_graph(start, get_adjacents, get_adjacent_count, visitor, NULL, 0, false, context);
+}
+
 nlink_traversal_result* nlink_traverse_graph_bfs(
     void* start,
     nlink_node_getter_fn get_adjacents,
@@ -929,60 +933,67 @@ nlink_traversal_result* nlink_traverse_graph_bfs(
     nlink_visitor_fn visitor,
     void* context
 ) {
-    if (start == NULL || get_adjacents == NULL || get_adjacent_count == NULL || visitor == NULL) {
-        return NULL;
-    }
-    
-    // Initialize result
-    nlink_traversal_result* result = traversal_result_create(16);
-    if (result == NULL) {
+    return traverse_graph(start, get_adjacents, get_adjacent_count, visitor, NULL, 0, true, context);
+}
+
+nlink_traversal_result* nlink_traverse_graph_dfs_dense(
+    void* start,
+    nlink_node_getter_fn get_adjacents,
+    nlink_child_count_fn get_adjacent_count,
+    nlink_visitor_fn visitor,
+    nlink_node_id_fn get_id,
+    size_t id_count,
+    void* context
+) {
+    if (get_id == NULL) {
         return NULL;
     }
     
-    // Initialize queue and visited set
-    node_queue* queue = queue_create();
-    visited_set* visited = visited_set_create(16);
-    
-    if (queue == NULL || visited == NULL) {
-        nlink_traversal_result_free(result);
-        queue_free(queue);
-        visited_set_free(visited);
+    return traverse_graph(start, get_adjacents, get_adjacent_count, visitor, get_id, id_count, false, context);
+}
+
+nlink_traversal_result* nlink_traverse_graph_bfs_dense(
+    void* start,
+    nlink_node_getter_fn get_adjacents,
+    nlink_child_count_fn get_adjacent_count,
+    nlink_visitor_fn visitor,
+    nlink_node_id_fn get_id,
+    size_t id_count,
+    void* context
+) {
+    if (get_id == NULL) {
         return NULL;
     }
     
-    // Enqueue start node
-    queue_enqueue(queue, start);
-    visited_set_add(visited, start);
-    
-    // Traverse graph
-    while (!queue_is_empty(queue)) {
-        void* node = queue_dequeue(queue);
-        
-        // Visit node
-        void* visit_result = visitor(node, context);
-        
-        // Collect result
-        if (!traversal_result_add(result, node, visit_result)) {
-            queue_free(queue);
-            visited_set_free(visited);
-            nlink_traversal_result_free(result);
-            return NULL;
+    return traverse_graph(start, get_adjacents, get_adjacent_count, visitor, get_id, id_count, true, context);
+}
+
+// Returns the position of a node's first visit, or INDEX_PENDING if it has none
+static size_t result_position(nlink_traversal_result* result, void* node) {
+    if (result->index == NULL) {
+        nlink_traversal_index* index = index_create(result->count);
+        for (size_t i = 0; index != NULL && i < result->count; i++) {
+            bool added;
+            if (result->nodes[i] != NULL && index_insert(index, result->nodes[i], i, &added) == NULL) {
+                index_free(index);
+                index = NULL;
+            }
         }
         
-        // Enqueue unvisited adjacent nodes
-        size_t adjacent_count = get_adjacent_count(node, context);
-        for (size_t i = 0; i < adjacent_count; i++) {
-            void* adjacent = get_adjacents(node, i, context);
-            if (adjacent != NULL && !visited_set_contains(visited, adjacent)) {
-                queue_enqueue(queue, adjacent);
-                visited_set_add(visited, adjacent);
+        // Without memory for an index, fall back to a scan
+        if (index == NULL) {
+            for (size_t i = 0; i < result->count; i++) {
+                if (result->nodes[i] == node) {
+                    return i;
+                }
             }
+            return INDEX_PENDING;
         }
+        result->index = index;
     }
     
-    queue_free(queue);
-    visited_set_free(visited);
-    return result;
+    const size_t* position = index_find(result->index, node);
+    return position != NULL ? *position : INDEX_PENDING;
 }
 
 bool nlink_traversal_visited(nlink_traversal_result* result, void* node) {
@@ -990,13 +1001,7 @@ bool nlink_traversal_visited(nlink_traversal_result* result, void* node) {
         return false;
     }
     
-    for (size_t i = 0; i < result->count; i++) {
-        if (result->nodes[i] == node) {
-            return true;
-        }
-    }
-    
-    return false;
+    return result_position(result, node) != INDEX_PENDING;
 }
 
 void* nlink_traversal_get_result(nlink_traversal_result* result, void* node) {
@@ -1004,11 +1009,10 @@ void* nlink_traversal_get_result(nlink_traversal_result* result, void* node) {
         return NULL;
     }
     
-    for (size_t i = 0; i < result->count; i++) {
-        if (result->nodes[i] == node) {
-            return result->results[i];
-        }
+    size_t position = result_position(result, node);
+    if (position == INDEX_PENDING) {
+        return NULL;
     }
     
-    return NULL;
+    return result->results[position];
 }
\ No newline at end of file
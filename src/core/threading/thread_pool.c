@@ -0,0 +1,855 @@
+/**
+ * @file thread_pool.c
+ * @brief Work-stealing thread pool driven by nlink_thread_pool_config_t
+ *
+ * The worker deques follow Chase-Lev as formulated for C11 atomics by
+ * Le, Pop, Cohen and Zappa Nardelli: the owner pushes and takes at the
+ * bottom without locking, thieves claim the top with a compare-and-swap,
+ * and only a take racing a steal for the last element needs the CAS.
+ * Grown buffers are kept until the pool is destroyed because a thief may
+ * still be reading the one it loaded.
+ *
+ * Task records are recycled through a per-worker free list that spills
+ * to, and refills from, a shared one, so steady-state submission does not
+ * allocate.
+ *
+ * Copyright © 2025 OBINexus Computing
+ */
+
+#define _GNU_SOURCE
+#include "nlink/core/threading/thread_pool.h"
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define POOL_CACHE_LINE 64
+#define POOL_LOCAL_TASKS_MAX 256        // Task records a worker keeps before returning half
+#define POOL_REFILL_BATCH 32            // Task records a worker takes from the shared list at once
+#define POOL_NESTED_WAIT_NS 1000000     // How often a worker blocked in a wait looks for work
+
+typedef struct pool_task {
+    nlink_task_fn fn;
+    void* arg;
+    nlink_task_group_t* group;
+    struct pool_task* next;             // Free list link
+} pool_task;
+
+typedef struct deque_buffer {
+    struct deque_buffer* retired;       // Buffer this one replaced
+    int64_t mask;
+    _Atomic(pool_task*) slots[];
+} deque_buffer;
+
+typedef struct work_deque {
+    _Alignas(POOL_CACHE_LINE) _Atomic int64_t top;       // Next element to steal
+    _Alignas(POOL_CACHE_LINE) _Atomic int64_t bottom;    // Next free slot
+    _Atomic(deque_buffer*) buffer;
+} work_deque;
+
+typedef struct pool_worker {
+    work_deque deque;
+    nlink_thread_pool_t* pool;
+    uint32_t index;
+    uint32_t seed;                      // Victim selection state
+    pool_task* free_tasks;
+    size_t free_count;
+    // Written only by the worker itself
+    _Atomic uint64_t submitted;
+    _Atomic uint64_t executed;
+    _Atomic uint64_t steals;
+    _Atomic uint64_t parks;
+    pthread_t thread;
+} pool_worker;
+
+struct nlink_thread_pool {
+    nlink_thread_pool_config_t config;
+    pool_worker* workers;
+    uint32_t worker_count;
+    uint32_t threads_started;
+    uint32_t pinned_workers;
+    int64_t idle_spin_ns;
+
+    // Shared queue for submissions from outside the pool
+    pthread_mutex_t queue_mutex;
+    pool_task** queue;
+    size_t queue_capacity;
+    size_t queue_head;
+    _Atomic size_t queue_count;
+
+    pthread_mutex_t free_mutex;
+    pool_task* free_tasks;
+
+    pthread_mutex_t park_mutex;
+    pthread_cond_t work_cond;           // Parked workers
+    pthread_cond_t done_cond;           // Threads waiting on a group
+    _Atomic int sleepers;
+    _Atomic int waiters;
+    _Atomic bool shutdown;
+
+    // Work done by threads that are not workers
+    _Atomic uint64_t external_submitted;
+    _Atomic uint64_t external_executed;
+    _Atomic uint64_t external_steals;
+    _Atomic uint64_t inline_runs;
+};
+
+static _Thread_local pool_worker* current_worker = NULL;
+static _Thread_local uint32_t external_seed = 0;
+
+static pthread_mutex_t shared_mutex = PTHREAD_MUTEX_INITIALIZER;
+static _Atomic(nlink_thread_pool_t*) shared_pool = NULL;
+
+// Owner-only counter increment; readers only need a recent value
+static void bump(_Atomic uint64_t* counter) {
+    atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + 1,
+                          memory_order_relaxed);
+}
+
+static int64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static size_t round_capacity(size_t capacity) {
+    size_t rounded = 16;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    return rounded;
+}
+
+// =============================================================================
+// Chase-Lev deque
+// =============================================================================
+
+static deque_buffer* deque_buffer_create(size_t capacity) {
+    deque_buffer* buffer = (deque_buffer*)malloc(sizeof(deque_buffer) + capacity * sizeof(pool_task*));
+    if (!buffer) {
+        return NULL;
+    }
+    buffer->retired = NULL;
+    buffer->mask = (int64_t)capacity - 1;
+    return buffer;
+}
+
+static bool deque_init(work_deque* deque, size_t capacity) {
+    deque_buffer* buffer = deque_buffer_create(round_capacity(capacity));
+    if (!buffer) {
+        return false;
+    }
+    atomic_init(&deque->top, 0);
+    atomic_init(&deque->bottom, 0);
+    atomic_init(&deque->buffer, buffer);
+    return true;
+}
+
+static void deque_destroy(work_deque* deque) {
+    deque_buffer* buffer = atomic_load_explicit(&deque->buffer, memory_order_relaxed);
+    while (buffer) {
+        deque_buffer* retired = buffer->retired;
+        free(buffer);
+        buffer = retired;
+    }
+}
+
+// Owner only: double the buffer, keeping the old one for thieves still reading it
+static deque_buffer* deque_grow(work_deque* deque, deque_buffer* old, int64_t top, int64_t bottom) {
+    deque_buffer* buffer = deque_buffer_create((size_t)(old->mask + 1) * 2);
+    if (!buffer) {
+        return NULL;
+    }
+    for (int64_t i = top; i < bottom; i++) {
+        pool_task* task = atomic_load_explicit(&old->slots[i & old->mask], memory_order_relaxed);
+        atomic_store_explicit(&buffer->slots[i & buffer->mask], task, memory_order_relaxed);
+    }
+    buffer->retired = old;
+    atomic_store_explicit(&deque->buffer, buffer, memory_order_release);
+    return buffer;
+}
+
+// Owner only
+static bool deque_push(work_deque* deque, pool_task* task) {
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    deque_buffer* buffer = atomic_load_explicit(&deque->buffer, memory_order_relaxed);
+
+    if (bottom - top > buffer->mask) {
+        buffer = deque_grow(deque, buffer, top, bottom);
+        if (!buffer) {
+            return false;
+        }
+    }
+
+    atomic_store_explicit(&buffer->slots[bottom & buffer->mask], task, memory_order_relaxed);
+    // Sequentially consistent so a parking worker either sees the task or is seen asleep
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_seq_cst);
+    return true;
+}
+
+// Owner only: newest element
+static pool_task* deque_take(work_deque* deque) {
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    deque_buffer* buffer = atomic_load_explicit(&deque->buffer, memory_order_relaxed);
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_seq_cst);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_seq_cst);
+
+    if (top > bottom) {
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_release);
+        return NULL;
+    }
+
+    pool_task* task = atomic_load_explicit(&buffer->slots[bottom & buffer->mask], memory_order_relaxed);
+    if (top == bottom) {
+        // Last element: race thieves for it
+        if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                     memory_order_seq_cst, memory_order_relaxed)) {
+            task = NULL;
+        }
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_release);
+    }
+    return task;
+}
+
+// Any thread: oldest element; *contended is set when another thread won the race
+static pool_task* deque_steal(work_deque* deque, bool* contended) {
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_seq_cst);
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_seq_cst);
+    if (top >= bottom) {
+        return NULL;
+    }
+
+    deque_buffer* buffer = atomic_load_explicit(&deque->buffer, memory_order_acquire);
+    pool_task* task = atomic_load_explicit(&buffer->slots[top & buffer->mask], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                 memory_order_seq_cst, memory_order_relaxed)) {
+        *contended = true;
+        return NULL;
+    }
+    return task;
+}
+
+static bool deque_has_work(work_deque* deque) {
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_seq_cst);
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_seq_cst);
+    return top < bottom;
+}
+
+// =============================================================================
+// Task records
+// =============================================================================
+
+static pool_task* task_alloc(nlink_thread_pool_t* pool, pool_worker* self) {
+    pool_task* task = NULL;
+
+    if (self && self->free_tasks) {
+        task = self->free_tasks;
+        self->free_tasks = task->next;
+        self->free_count--;
+        return task;
+    }
+
+    pthread_mutex_lock(&pool->free_mutex);
+    task = pool->free_tasks;
+    if (task) {
+        pool->free_tasks = task->next;
+        // Workers take a batch so the next submissions stay local
+        for (size_t i = 0; self && pool->free_tasks && i < POOL_REFILL_BATCH; i++) {
+            pool_task* spare = pool->free_tasks;
+            pool->free_tasks = spare->next;
+            spare->next = self->free_tasks;
+            self->free_tasks = spare;
+            self->free_count++;
+        }
+    }
+    pthread_mutex_unlock(&pool->free_mutex);
+
+    return task ? task : (pool_task*)malloc(sizeof(pool_task));
+}
+
+static void task_free(nlink_thread_pool_t* pool, pool_worker* self, pool_task* task) {
+    if (!self) {
+        pthread_mutex_lock(&pool->free_mutex);
+        task->next = pool->free_tasks;
+        pool->free_tasks = task;
+        pthread_mutex_unlock(&pool->free_mutex);
+        return;
+    }
+
+    task->next = self->free_tasks;
+    self->free_tasks = task;
+    if (++self->free_count <= POOL_LOCAL_TASKS_MAX) {
+        return;
+    }
+
+    // Thieves free what producers allocate; hand the surplus back
+    pool_task* first = self->free_tasks;
+    pool_task* last = first;
+    for (size_t i = 1; i < POOL_LOCAL_TASKS_MAX / 2; i++) {
+        last = last->next;
+    }
+    self->free_tasks = last->next;
+    self->free_count -= POOL_LOCAL_TASKS_MAX / 2;
+
+    pthread_mutex_lock(&pool->free_mutex);
+    last->next = pool->free_tasks;
+    pool->free_tasks = first;
+    pthread_mutex_unlock(&pool->free_mutex);
+}
+
+static void free_task_list(pool_task* task) {
+    while (task) {
+        pool_task* next = task->next;
+        free(task);
+        task = next;
+    }
+}
+
+// =============================================================================
+// Scheduling
+// =============================================================================
+
+static pool_worker* worker_of(const nlink_thread_pool_t* pool) {
+    pool_worker* self = current_worker;
+    return self && self->pool == pool ? self : NULL;
+}
+
+static void wake_worker(nlink_thread_pool_t* pool) {
+    if (atomic_load_explicit(&pool->sleepers, memory_order_seq_cst) > 0) {
+        pthread_mutex_lock(&pool->park_mutex);
+        pthread_cond_signal(&pool->work_cond);
+        pthread_mutex_unlock(&pool->park_mutex);
+    }
+}
+
+static bool queue_push(nlink_thread_pool_t* pool, pool_task* task) {
+    pthread_mutex_lock(&pool->queue_mutex);
+    size_t count = atomic_load_explicit(&pool->queue_count, memory_order_relaxed);
+    bool pushed = count < pool->queue_capacity;
+    if (pushed) {
+        pool->queue[(pool->queue_head + count) % pool->queue_capacity] = task;
+        atomic_store_explicit(&pool->queue_count, count + 1, memory_order_seq_cst);
+    }
+    pthread_mutex_unlock(&pool->queue_mutex);
+    return pushed;
+}
+
+static pool_task* queue_pop(nlink_thread_pool_t* pool) {
+    if (atomic_load_explicit(&pool->queue_count, memory_order_relaxed) == 0) {
+        return NULL;
+    }
+
+    pool_task* task = NULL;
+    pthread_mutex_lock(&pool->queue_mutex);
+    size_t count = atomic_load_explicit(&pool->queue_count, memory_order_relaxed);
+    if (count > 0) {
+        task = pool->queue[pool->queue_head];
+        pool->queue_head = (pool->queue_head + 1) % pool->queue_capacity;
+        atomic_store_explicit(&pool->queue_count, count - 1, memory_order_relaxed);
+    }
+    pthread_mutex_unlock(&pool->queue_mutex);
+    return task;
+}
+
+static uint32_t next_victim_seed(pool_worker* self) {
+    uint32_t* seed = self ? &self->seed : &external_seed;
+    if (*seed == 0) {
+        *seed = (uint32_t)(uintptr_t)seed | 1u;
+    }
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 17;
+    *seed ^= *seed << 5;
+    return *seed;
+}
+
+// Sweep the other deques from a random start until one yields or all are empty
+static pool_task* steal_task(nlink_thread_pool_t* pool, pool_worker* self) {
+    uint32_t count = pool->worker_count;
+    if (count == 0 || (self && count == 1)) {
+        return NULL;
+    }
+
+    uint32_t start = next_victim_seed(self) % count;
+    bool contended;
+    do {
+        contended = false;
+        for (uint32_t k = 0; k < count; k++) {
+            pool_worker* victim = &pool->workers[(start + k) % count];
+            if (victim == self) {
+                continue;
+            }
+            pool_task* task = deque_steal(&victim->deque, &contended);
+            if (task) {
+                if (self) {
+                    bump(&self->steals);
+                } else {
+                    atomic_fetch_add_explicit(&pool->external_steals, 1, memory_order_relaxed);
+                }
+                return task;
+            }
+        }
+    } while (contended);
+
+    return NULL;
+}
+
+static pool_task* find_task(nlink_thread_pool_t* pool, pool_worker* self) {
+    pool_task* task = NULL;
+    if (self) {
+        task = deque_take(&self->deque);
+    }
+    if (!task) {
+        task = queue_pop(pool);
+    }
+    if (!task && pool->config.enable_work_stealing) {
+        task = steal_task(pool, self);
+    }
+    return task;
+}
+
+static bool work_visible(nlink_thread_pool_t* pool, pool_worker* self) {
+    if (atomic_load_explicit(&pool->queue_count, memory_order_seq_cst) > 0) {
+        return true;
+    }
+    if (self && deque_has_work(&self->deque)) {
+        return true;
+    }
+    if (pool->config.enable_work_stealing) {
+        for (uint32_t i = 0; i < pool->worker_count; i++) {
+            if (deque_has_work(&pool->workers[i].deque)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static void finish_task(nlink_thread_pool_t* pool, nlink_task_group_t* group) {
+    if (group && atomic_fetch_sub_explicit(&group->pending, 1, memory_order_seq_cst) == 1 &&
+        atomic_load_explicit(&pool->waiters, memory_order_seq_cst) > 0) {
+        pthread_mutex_lock(&pool->park_mutex);
+        pthread_cond_broadcast(&pool->done_cond);
+        pthread_mutex_unlock(&pool->park_mutex);
+    }
+}
+
+static void run_task(nlink_thread_pool_t* pool, pool_worker* self, pool_task* task) {
+    nlink_task_fn fn = task->fn;
+    void* arg = task->arg;
+    nlink_task_group_t* group = task->group;
+
+    // Recycle first so tasks submitted by fn can reuse the record
+    task_free(pool, self, task);
+    fn(arg);
+
+    if (self) {
+        bump(&self->executed);
+    } else {
+        atomic_fetch_add_explicit(&pool->external_executed, 1, memory_order_relaxed);
+    }
+    finish_task(pool, group);
+}
+
+// Spin for the idle timeout before parking
+static pool_task* idle_spin(nlink_thread_pool_t* pool, pool_worker* self) {
+    if (pool->idle_spin_ns <= 0) {
+        return NULL;
+    }
+
+    int64_t deadline = monotonic_ns() + pool->idle_spin_ns;
+    do {
+        sched_yield();
+        pool_task* task = find_task(pool, self);
+        if (task) {
+            return task;
+        }
+    } while (!atomic_load_explicit(&pool->shutdown, memory_order_acquire) && monotonic_ns() < deadline);
+
+    return NULL;
+}
+
+static void park(nlink_thread_pool_t* pool, pool_worker* self) {
+    pthread_mutex_lock(&pool->park_mutex);
+    atomic_fetch_add_explicit(&pool->sleepers, 1, memory_order_seq_cst);
+    if (!atomic_load_explicit(&pool->shutdown, memory_order_acquire) && !work_visible(pool, self)) {
+        bump(&self->parks);
+        do {
+            pthread_cond_wait(&pool->work_cond, &pool->park_mutex);
+        } while (!atomic_load_explicit(&pool->shutdown, memory_order_acquire) && !work_visible(pool, self));
+    }
+    atomic_fetch_sub_explicit(&pool->sleepers, 1, memory_order_seq_cst);
+    pthread_mutex_unlock(&pool->park_mutex);
+}
+
+static void* worker_main(void* arg) {
+    pool_worker* self = (pool_worker*)arg;
+    nlink_thread_pool_t* pool = self->pool;
+    current_worker = self;
+
+    for (;;) {
+        pool_task* task = find_task(pool, self);
+        if (!task) {
+            task = idle_spin(pool, self);
+        }
+        if (task) {
+            run_task(pool, self, task);
+            continue;
+        }
+
+        // Own deque is empty here, so nothing is lost by leaving
+        if (atomic_load_explicit(&pool->shutdown, memory_order_acquire)) {
+            break;
+        }
+        park(pool, self);
+    }
+
+    current_worker = NULL;
+    return NULL;
+}
+
+// =============================================================================
+// Pool lifecycle
+// =============================================================================
+
+nlink_thread_pool_config_t nlink_thread_pool_default_config(void) {
+    nlink_thread_pool_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.worker_count = 0;
+    config.queue_depth = 1024;
+    config.stack_size_kb = 0;
+    config.enable_thread_affinity = false;
+    config.enable_work_stealing = true;
+    config.idle_timeout.tv_sec = 0;
+    config.idle_timeout.tv_nsec = 50000;
+    return config;
+}
+
+static bool start_worker(nlink_thread_pool_t* pool, pool_worker* worker, const cpu_set_t* allowed, int cpu_count) {
+    pthread_attr_t attr;
+    if (pthread_attr_init(&attr) != 0) {
+        return false;
+    }
+
+    if (pool->config.stack_size_kb > 0) {
+        size_t bytes = (size_t)pool->config.stack_size_kb * 1024;
+        if (bytes < (size_t)PTHREAD_STACK_MIN) {
+            bytes = PTHREAD_STACK_MIN;
+        }
+        pthread_attr_setstacksize(&attr, bytes);
+    }
+
+    bool pinned = false;
+#if defined(__linux__)
+    if (pool->config.enable_thread_affinity && allowed && cpu_count > 0) {
+        // Worker i goes to the (i mod n)-th CPU this process may run on
+        int target = (int)(worker->index % (uint32_t)cpu_count);
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, allowed) && target-- == 0) {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(cpu, &set);
+                pinned = pthread_attr_setaffinity_np(&attr, sizeof(set), &set) == 0;
+                break;
+            }
+        }
+    }
+#else
+    (void)allowed;
+    (void)cpu_count;
+#endif
+
+    int rc = pthread_create(&worker->thread, &attr, worker_main, worker);
+    pthread_attr_destroy(&attr);
+
+    if (rc != 0 && pinned) {
+        // The CPU may have gone away; run the worker unpinned
+        pinned = false;
+        rc = pthread_create(&worker->thread, NULL, worker_main, worker);
+    }
+    if (rc != 0) {
+        return false;
+    }
+
+    if (pinned) {
+        pool->pinned_workers++;
+    }
+    return true;
+}
+
+nlink_thread_pool_t* nlink_thread_pool_create(const nlink_thread_pool_config_t* config) {
+    nlink_thread_pool_t* pool = (nlink_thread_pool_t*)calloc(1, sizeof(nlink_thread_pool_t));
+    if (!pool) {
+        return NULL;
+    }
+
+    pool->config = config ? *config : nlink_thread_pool_default_config();
+    if (pool->config.worker_count == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        pool->config.worker_count = cpus > 0 ? (uint32_t)cpus : 1;
+    }
+    if (pool->config.queue_depth == 0) {
+        pool->config.queue_depth = 1;
+    }
+    pool->worker_count = pool->config.worker_count;
+    pool->idle_spin_ns = (int64_t)pool->config.idle_timeout.tv_sec * 1000000000 +
+                         pool->config.idle_timeout.tv_nsec;
+
+    pool->queue_capacity = pool->config.queue_depth;
+    pool->queue = (pool_task**)malloc(pool->queue_capacity * sizeof(pool_task*));
+    pool->workers = (pool_worker*)aligned_alloc(POOL_CACHE_LINE,
+                                                ((pool->worker_count * sizeof(pool_worker) + POOL_CACHE_LINE - 1) /
+                                                 POOL_CACHE_LINE) * POOL_CACHE_LINE);
+    if (!pool->queue || !pool->workers) {
+        free(pool->queue);
+        free(pool->workers);
+        free(pool);
+        return NULL;
+    }
+    memset(pool->workers, 0, pool->worker_count * sizeof(pool_worker));
+
+    uint32_t deques_ready = 0;
+    while (deques_ready < pool->worker_count &&
+           deque_init(&pool->workers[deques_ready].deque, pool->config.queue_depth)) {
+        deques_ready++;
+    }
+
+    bool sync_ready = deques_ready == pool->worker_count;
+    int initialized = 0;
+    if (sync_ready) {
+        sync_ready = pthread_mutex_init(&pool->queue_mutex, NULL) == 0 && ++initialized &&
+                     pthread_mutex_init(&pool->free_mutex, NULL) == 0 && ++initialized &&
+                     pthread_mutex_init(&pool->park_mutex, NULL) == 0 && ++initialized &&
+                     pthread_cond_init(&pool->work_cond, NULL) == 0 && ++initialized &&
+                     pthread_cond_init(&pool->done_cond, NULL) == 0 && ++initialized;
+    }
+
+    if (!sync_ready) {
+        if (initialized > 3) pthread_cond_destroy(&pool->work_cond);
+        if (initialized > 2) pthread_mutex_destroy(&pool->park_mutex);
+        if (initialized > 1) pthread_mutex_destroy(&pool->free_mutex);
+        if (initialized > 0) pthread_mutex_destroy(&pool->queue_mutex);
+        for (uint32_t i = 0; i < deques_ready; i++) {
+            deque_destroy(&pool->workers[i].deque);
+        }
+        free(pool->queue);
+        free(pool->workers);
+        free(pool);
+        return NULL;
+    }
+
+    cpu_set_t allowed;
+    int cpu_count = 0;
+    CPU_ZERO(&allowed);
+#if defined(__linux__)
+    if (pool->config.enable_thread_affinity && sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        cpu_count = CPU_COUNT(&allowed);
+    }
+#endif
+
+    for (uint32_t i = 0; i < pool->worker_count; i++) {
+        pool_worker* worker = &pool->workers[i];
+        worker->pool = pool;
+        worker->index = i;
+        worker->seed = (i + 1) * 2654435761u | 1u;
+
+        if (!start_worker(pool, worker, &allowed, cpu_count)) {
+            break;
+        }
+        pool->threads_started++;
+    }
+
+    // Workers that failed to start leave an empty deque behind, which is harmless
+    if (pool->threads_started == 0) {
+        nlink_thread_pool_destroy(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+void nlink_task_group_init(nlink_task_group_t* group) {
+    if (group) {
+        atomic_init(&group->pending, 0);
+    }
+}
+
+bool nlink_thread_pool_submit(nlink_thread_pool_t* pool,
+                              nlink_task_fn fn,
+                              void* arg,
+                              nlink_task_group_t* group) {
+    if (!pool || !fn) {
+        return false;
+    }
+
+    pool_worker* self = worker_of(pool);
+    if (group) {
+        atomic_fetch_add_explicit(&group->pending, 1, memory_order_relaxed);
+    }
+
+    pool_task* task = task_alloc(pool, self);
+    if (task) {
+        task->fn = fn;
+        task->arg = arg;
+        task->group = group;
+
+        bool queued = self ? deque_push(&self->deque, task) : queue_push(pool, task);
+        if (queued) {
+            if (self) {
+                bump(&self->submitted);
+            } else {
+                atomic_fetch_add_explicit(&pool->external_submitted, 1, memory_order_relaxed);
+            }
+            wake_worker(pool);
+            return true;
+        }
+        task_free(pool, self, task);
+    }
+
+    // Queue full or out of memory: the caller runs it
+    atomic_fetch_add_explicit(&pool->inline_runs, 1, memory_order_relaxed);
+    fn(arg);
+    finish_task(pool, group);
+    return true;
+}
+
+void nlink_thread_pool_wait(nlink_thread_pool_t* pool, nlink_task_group_t* group) {
+    if (!pool || !group) {
+        return;
+    }
+
+    pool_worker* self = worker_of(pool);
+    while (atomic_load_explicit(&group->pending, memory_order_acquire) > 0) {
+        pool_task* task = find_task(pool, self);
+        if (task) {
+            run_task(pool, self, task);
+            continue;
+        }
+
+        pthread_mutex_lock(&pool->park_mutex);
+        atomic_fetch_add_explicit(&pool->waiters, 1, memory_order_seq_cst);
+        if (atomic_load_explicit(&group->pending, memory_order_seq_cst) > 0) {
+            if (self) {
+                // A worker stuck here would strand work that arrives later
+                struct timespec until;
+                clock_gettime(CLOCK_REALTIME, &until);
+                until.tv_nsec += POOL_NESTED_WAIT_NS;
+                if (until.tv_nsec >= 1000000000) {
+                    until.tv_sec++;
+                    until.tv_nsec -= 1000000000;
+                }
+                pthread_cond_timedwait(&pool->done_cond, &pool->park_mutex, &until);
+            } else {
+                pthread_cond_wait(&pool->done_cond, &pool->park_mutex);
+            }
+        }
+        atomic_fetch_sub_explicit(&pool->waiters, 1, memory_order_seq_cst);
+        pthread_mutex_unlock(&pool->park_mutex);
+    }
+
+    // Pair with the decrements so the tasks' writes are visible to the caller
+    atomic_thread_fence(memory_order_acquire);
+}
+
+size_t nlink_thread_pool_worker_count(const nlink_thread_pool_t* pool) {
+    return pool ? pool->threads_started : 0;
+}
+
+bool nlink_thread_pool_get_stats(const nlink_thread_pool_t* pool, nlink_thread_pool_stats_t* stats) {
+    if (!pool || !stats) {
+        return false;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+    stats->worker_count = pool->threads_started;
+    stats->pinned_workers = pool->pinned_workers;
+    stats->tasks_submitted = atomic_load_explicit(&pool->external_submitted, memory_order_relaxed);
+    stats->tasks_executed = atomic_load_explicit(&pool->external_executed, memory_order_relaxed);
+    stats->tasks_inline = atomic_load_explicit(&pool->inline_runs, memory_order_relaxed);
+    stats->steals = atomic_load_explicit(&pool->external_steals, memory_order_relaxed);
+
+    for (uint32_t i = 0; i < pool->worker_count; i++) {
+        const pool_worker* worker = &pool->workers[i];
+        stats->tasks_submitted += atomic_load_explicit(&worker->submitted, memory_order_relaxed);
+        stats->tasks_executed += atomic_load_explicit(&worker->executed, memory_order_relaxed);
+        stats->steals += atomic_load_explicit(&worker->steals, memory_order_relaxed);
+        stats->parks += atomic_load_explicit(&worker->parks, memory_order_relaxed);
+    }
+    return true;
+}
+
+void nlink_thread_pool_destroy(nlink_thread_pool_t* pool) {
+    if (!pool) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->park_mutex);
+    atomic_store_explicit(&pool->shutdown, true, memory_order_release);
+    pthread_cond_broadcast(&pool->work_cond);
+    pthread_mutex_unlock(&pool->park_mutex);
+
+    for (uint32_t i = 0; i < pool->threads_started; i++) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+
+    // Without workers, run whatever was submitted from outside
+    pool_task* task;
+    while ((task = queue_pop(pool)) != NULL) {
+        run_task(pool, NULL, task);
+    }
+
+    // Every record is idle now and sits on one of the free lists
+    for (uint32_t i = 0; i < pool->worker_count; i++) {
+        free_task_list(pool->workers[i].free_tasks);
+        deque_destroy(&pool->workers[i].deque);
+    }
+    free_task_list(pool->free_tasks);
+
+    pthread_cond_destroy(&pool->done_cond);
+    pthread_cond_destroy(&pool->work_cond);
+    pthread_mutex_destroy(&pool->park_mutex);
+    pthread_mutex_destroy(&pool->free_mutex);
+    pthread_mutex_destroy(&pool->queue_mutex);
+
+    free(pool->queue);
+    free(pool->workers);
+    free(pool);
+}
+
+// =============================================================================
+// Shared pool
+// =============================================================================
+
+bool nlink_thread_pool_shared_init(const nlink_thread_pool_config_t* config) {
+    pthread_mutex_lock(&shared_mutex);
+    bool created = false;
+    if (!atomic_load_explicit(&shared_pool, memory_order_relaxed)) {
+        nlink_thread_pool_t* pool = nlink_thread_pool_create(config);
+        atomic_store_explicit(&shared_pool, pool, memory_order_release);
+        created = pool != NULL;
+    }
+    pthread_mutex_unlock(&shared_mutex);
+    return created;
+}
+
+nlink_thread_pool_t* nlink_thread_pool_shared(void) {
+    nlink_thread_pool_t* pool = atomic_load_explicit(&shared_pool, memory_order_acquire);
+    if (!pool) {
+        nlink_thread_pool_shared_init(NULL);
+        pool = atomic_load_explicit(&shared_pool, memory_order_acquire);
+    }
+    return pool;
+}
+
+nlink_thread_pool_t* nlink_thread_pool_shared_current(void) {
+    return atomic_load_explicit(&shared_pool, memory_order_acquire);
+}
+
+void nlink_thread_pool_shared_shutdown(void) {
+    pthread_mutex_lock(&shared_mutex);
+    nlink_thread_pool_t* pool = atomic_exchange_explicit(&shared_pool, NULL, memory_order_acq_rel);
+    pthread_mutex_unlock(&shared_mutex);
+    nlink_thread_pool_destroy(pool);
+}